@@ -151,7 +151,7 @@ AnalyzePage {
                                 enabled: _isSignIn
                                 onClicked: {
                                     var bucketName = dirCombobox.currentText;
-                                    QGroundControl.cloudManager.uploadFile(modelData["filePath"], bucketName, modelData["fileName"]);
+                                    QGroundControl.cloudManager.uploadLocalFile(modelData["filePath"], bucketName);
                                 }
                             }
                         }
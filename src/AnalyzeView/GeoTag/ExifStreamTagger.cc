@@ -0,0 +1,200 @@
+#include "ExifStreamTagger.h"
+#include "ExifParser.h"
+#include "ExifUtility.h"
+#include "GeoTagData.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+QGC_LOGGING_CATEGORY(ExifStreamTaggerLog, "AnalyzeView.ExifStreamTagger")
+
+namespace {
+
+constexpr qint64 kMaxHeaderSize = 1024 * 1024;      ///< Give up looking for EXIF after this many bytes of APPn segments
+constexpr int kMaxSegmentLength = 0xFFFF;
+
+const QByteArray kSoi("\xFF\xD8", 2);
+const QByteArray kExifIdentifier("Exif\0\0", 6);
+
+} // namespace
+
+namespace ExifStreamTagger
+{
+
+QByteArray JpegHeader::exifBuffer() const
+{
+    QByteArray buffer = kSoi;
+    if (hasExif()) {
+        buffer.append(bytes.constData() + app1Offset, app1Size);
+    }
+    return buffer;
+}
+
+bool readHeader(QIODevice &device, JpegHeader &header, QString &errorMessage)
+{
+    header = JpegHeader();
+
+    header.bytes = device.read(2);
+    if (header.bytes != kSoi) {
+        errorMessage = QStringLiteral("Not a JPEG image");
+        return false;
+    }
+
+    qint64 pos = 2;
+    while (pos < kMaxHeaderSize) {
+        const QByteArray marker = device.read(4);
+        if ((marker.size() < 4) || (static_cast<uchar>(marker[0]) != 0xFF)) {
+            break;
+        }
+
+        // EXIF is stored in an APPn segment ahead of the tables and image data
+        const uchar type = static_cast<uchar>(marker[1]);
+        if ((type < 0xE0) || (type > 0xEF)) {
+            break;
+        }
+
+        const int length = (static_cast<uchar>(marker[2]) << 8) | static_cast<uchar>(marker[3]);
+        if (length < 2) {
+            errorMessage = QStringLiteral("Corrupt JPEG segment at offset %1").arg(pos);
+            return false;
+        }
+
+        const QByteArray payload = device.read(length - 2);
+        if (payload.size() != (length - 2)) {
+            errorMessage = QStringLiteral("Truncated JPEG segment at offset %1").arg(pos);
+            return false;
+        }
+
+        header.bytes.append(marker);
+        header.bytes.append(payload);
+
+        if ((type == 0xE1) && payload.startsWith(kExifIdentifier)) {
+            header.app1Offset = pos;
+            header.app1Size = length + 2;
+            pos += length + 2;
+            break;
+        }
+
+        pos += length + 2;
+    }
+
+    header.dataOffset = pos;
+    return true;
+}
+
+QDateTime readTime(const QString &path, QString &errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        errorMessage = file.errorString();
+        return QDateTime();
+    }
+
+    JpegHeader header;
+    if (!readHeader(file, header, errorMessage)) {
+        // TIFF based formats keep their tags throughout the file
+        if (!file.seek(0)) {
+            errorMessage = file.errorString();
+            return QDateTime();
+        }
+        const QByteArray buffer = file.readAll();
+        if (!ExifUtility::isTiff(buffer)) {
+            return QDateTime();
+        }
+        errorMessage.clear();
+        return ExifParser::readTime(buffer);
+    }
+
+    if (!header.hasExif()) {
+        errorMessage = QStringLiteral("No EXIF data");
+        return QDateTime();
+    }
+
+    return ExifParser::readTime(header.exifBuffer());
+}
+
+QByteArray buildApp1(const JpegHeader &header, const GeoTagData &geotag)
+{
+    // libexif rewrites SOI + APP1 into SOI + new APP1
+    QByteArray buffer = header.exifBuffer();
+    if (!ExifParser::write(buffer, geotag)) {
+        return QByteArray();
+    }
+    return buffer.mid(kSoi.size());
+}
+
+bool writeFile(const QString &sourcePath, const QString &outputPath, const GeoTagData &geotag, QString &errorMessage)
+{
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        errorMessage = source.errorString();
+        return false;
+    }
+
+    JpegHeader header;
+    if (!readHeader(source, header, errorMessage)) {
+        return false;
+    }
+
+    QByteArray app1 = buildApp1(header, geotag);
+    if (app1.isEmpty()) {
+        errorMessage = QStringLiteral("Couldn't build EXIF segment");
+        return false;
+    }
+    if ((app1.size() - 2) > kMaxSegmentLength) {
+        errorMessage = QStringLiteral("EXIF segment too large: %1 bytes").arg(app1.size());
+        return false;
+    }
+
+    if (!source.seek(header.dataOffset)) {
+        errorMessage = source.errorString();
+        return false;
+    }
+
+    // Same layout as ExifUtility::saveToBuffer: SOI, new APP1, other leading segments, image data. Always written to a
+    // new file and renamed over the output, also when tagging in place, so a failure never leaves a half patched image.
+    QSaveFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        errorMessage = output.errorString();
+        return false;
+    }
+
+    QByteArray prefix = kSoi + app1;
+    if (header.hasExif()) {
+        prefix.append(header.bytes.constData() + kSoi.size(), header.app1Offset - kSoi.size());
+    } else {
+        prefix.append(header.bytes.constData() + kSoi.size(), header.bytes.size() - kSoi.size());
+    }
+    if (output.write(prefix) != prefix.size()) {
+        errorMessage = output.errorString();
+        output.cancelWriting();
+        return false;
+    }
+
+    QByteArray chunk(kCopyChunkSize, Qt::Uninitialized);
+    qint64 bytesRead = 0;
+    while ((bytesRead = source.read(chunk.data(), kCopyChunkSize)) > 0) {
+        if (output.write(chunk.constData(), bytesRead) != bytesRead) {
+            errorMessage = output.errorString();
+            output.cancelWriting();
+            return false;
+        }
+    }
+    if (bytesRead < 0) {
+        errorMessage = source.errorString();
+        output.cancelWriting();
+        return false;
+    }
+
+    // Release the source before the rename, it may be the file being replaced
+    source.close();
+    if (!output.commit()) {
+        errorMessage = output.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace ExifStreamTagger
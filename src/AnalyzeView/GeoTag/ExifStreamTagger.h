@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+class QIODevice;
+struct GeoTagData;
+
+/// Geotagging of image files without loading the whole image.
+///
+/// Only the leading JPEG segments up to the EXIF APP1 segment are read. Writing rebuilds just that segment: the new file
+/// is the rebuilt header followed by the untouched remainder, copied with large sequential reads and committed
+/// atomically.
+/// TIFF/DNG images are not streamed; their timestamp is read from the whole file as before.
+namespace ExifStreamTagger
+{
+    /// Leading segments of a JPEG file
+    struct JpegHeader {
+        QByteArray bytes;           ///< File contents from SOI up to dataOffset
+        qint64 app1Offset = -1;     ///< Offset of the EXIF APP1 marker, -1 when the image has none
+        qint64 app1Size = 0;        ///< Size of the EXIF APP1 segment including marker and length
+        qint64 dataOffset = 0;      ///< First byte not held in bytes
+
+        bool hasExif() const { return app1Offset >= 0; }
+        /// SOI followed by the EXIF segment, the minimal buffer libexif can load
+        QByteArray exifBuffer() const;
+    };
+
+    /// Chunk size for copying the image data which follows the header
+    constexpr qint64 kCopyChunkSize = 1024 * 1024;
+
+    /// Reads the JPEG segments preceding the image data, stopping after the EXIF APP1 segment
+    /// @return false if @p device does not contain a JPEG image
+    bool readHeader(QIODevice &device, JpegHeader &header, QString &errorMessage);
+
+    /// Reads the capture time of the image at @p path
+    QDateTime readTime(const QString &path, QString &errorMessage);
+
+    /// Builds the EXIF APP1 segment holding @p geotag, keeping the existing tags of @p header
+    QByteArray buildApp1(const JpegHeader &header, const GeoTagData &geotag);
+
+    /// Writes @p geotag into the image at @p sourcePath, saving the result to @p outputPath.
+    /// @p outputPath may equal @p sourcePath to tag in place, the original is replaced only once the new file is complete.
+    bool writeFile(const QString &sourcePath, const QString &outputPath, const GeoTagData &geotag, QString &errorMessage);
+}
@@ -1,8 +1,7 @@
 #include "GeoTagController.h"
 #include "DataFlashParser.h"
-#include "ExifParser.h"
+#include "ExifStreamTagger.h"
 #include "GeoTagImageModel.h"
-#include "QGCCompression.h"
 #include "QGCFileHelper.h"
 #include "QGCLoggingCategory.h"
 #include "ULogParser.h"
@@ -14,7 +13,6 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QMultiMap>
-#include <QtCore/QMutexLocker>
 #include <QtCore/QSet>
 
 QGC_LOGGING_CATEGORY(GeoTagControllerLog, "AnalyzeView.GeoTagController")
@@ -180,12 +178,18 @@ GeoTagController::GeoTagController(QObject *parent)
 {
     qCDebug(GeoTagControllerLog) << this;
 
+    _ioPool.setMaxThreadCount(kMaxConcurrentIo);
+
     // Connect EXIF parsing watcher signals
     (void) connect(&_exifWatcher, &QFutureWatcher<ExifResult>::progressValueChanged,
                    this, &GeoTagController::_onExifProgress);
     (void) connect(&_exifWatcher, &QFutureWatcher<ExifResult>::finished,
                    this, &GeoTagController::_onExifFinished);
 
+    // Connect log parsing watcher signals
+    (void) connect(&_logWatcher, &QFutureWatcher<LogResult>::finished,
+                   this, &GeoTagController::_onLogsFinished);
+
     // Connect tagging watcher signals
     (void) connect(&_tagWatcher, &QFutureWatcher<TagResult>::progressValueChanged,
                    this, &GeoTagController::_onTagProgress);
@@ -200,6 +204,7 @@ GeoTagController::~GeoTagController()
     // Cancel and wait for any running operations
     _cancel = true;
     _exifWatcher.waitForFinished();
+    _logWatcher.waitForFinished();
     _tagWatcher.waitForFinished();
 }
 
@@ -379,7 +384,6 @@ void GeoTagController::startTagging()
 
     // Clear previous state
     _state.clear();
-    _clearImageCache();
     _cancel = false;
 
     // Start timing and begin processing
@@ -403,6 +407,7 @@ void GeoTagController::cancelTagging()
         _tagWatcher.cancel();
     }
 
+    // Log parsing can't be interrupted, its result is dropped once it finishes
     _finishWithError(tr("Tagging cancelled"));
 }
 
@@ -448,7 +453,6 @@ void GeoTagController::_finishWithError(const QString &errorMsg)
     qCDebug(GeoTagControllerLog) << "Finishing with error:" << errorMsg;
     qCDebug(GeoTagControllerLog) << "Total processing time:" << _totalTimer.elapsed() << "ms";
 
-    _clearImageCache();
     _stage = Stage::Idle;
     _setErrorMessage(errorMsg);
     emit inProgressChanged();
@@ -459,7 +463,6 @@ void GeoTagController::_finishSuccess()
     qCDebug(GeoTagControllerLog) << "Finishing successfully";
     qCDebug(GeoTagControllerLog) << "Total processing time:" << _totalTimer.elapsed() << "ms";
 
-    _clearImageCache();
     _stage = Stage::Idle;
 
     const auto matchedCount = std::min(_state.imageIndices.count(), _state.triggerIndices.count());
@@ -495,8 +498,11 @@ void GeoTagController::_startLoadImages()
 
 void GeoTagController::_startParseExif()
 {
+    // Parse the trigger log alongside the image scan, it is consumed once the scan completes
+    _logWatcher.setFuture(QtConcurrent::run(&GeoTagController::_parseLogFile, _logFile));
+
     // Launch parallel EXIF parsing
-    QFuture<ExifResult> future = QtConcurrent::mapped(_state.imageList,
+    QFuture<ExifResult> future = QtConcurrent::mapped(&_ioPool, _state.imageList,
         [this](const QFileInfo &info) { return _parseExifForImage(info); });
 
     _exifWatcher.setFuture(future);
@@ -562,13 +568,42 @@ void GeoTagController::_onExifFinished()
 
 void GeoTagController::_startParseLogs()
 {
-    QString errorMsg;
-    if (!_parseLogs(errorMsg)) {
-        _finishWithError(errorMsg);
+    // Usually the log is parsed before the image scan finishes
+    if (_logWatcher.isFinished()) {
+        _onLogsFinished();
+    }
+}
+
+void GeoTagController::_onLogsFinished()
+{
+    if (_stage != Stage::ParsingLogs) {
         return;
     }
 
-    qCDebug(GeoTagControllerLog) << "Stage: parseLogs took" << _stageTimer.elapsed() << "ms";
+    qCDebug(GeoTagControllerLog) << "Stage: parseLogs waited" << _stageTimer.elapsed() << "ms";
+
+    if (_cancel) {
+        _finishWithError(tr("Tagging cancelled"));
+        return;
+    }
+
+    const LogResult result = _logWatcher.result();
+    if (!result.success) {
+        _finishWithError(result.errorMessage);
+        return;
+    }
+
+    _state.triggerList = result.triggers;
+    qCDebug(GeoTagControllerLog) << "Found" << _state.triggerList.count() << "camera capture events";
+
+    if (_state.imageList.count() > _state.triggerList.count()) {
+        qCDebug(GeoTagControllerLog) << "Detected missing feedback packets:"
+                                      << (_state.imageList.count() - _state.triggerList.count()) << "images without triggers";
+    } else if (_state.imageList.count() < _state.triggerList.count()) {
+        qCDebug(GeoTagControllerLog) << "Detected missing image frames:"
+                                      << (_state.triggerList.count() - _state.imageList.count()) << "triggers without images";
+    }
+
     _setProgress(kParseLogsEnd);
     _transitionTo(Stage::Calibrating);
 }
@@ -581,9 +616,6 @@ void GeoTagController::_startCalibrate()
         return;
     }
 
-    // Evict unmatched images from cache to save memory
-    _evictUnmatchedImages();
-
     qCDebug(GeoTagControllerLog) << "Stage: calibrate took" << _stageTimer.elapsed() << "ms";
     _setProgress(kCalibrateEnd);
     _transitionTo(Stage::TaggingImages);
@@ -621,7 +653,7 @@ void GeoTagController::_startTagImages()
     }
 
     // Launch parallel tagging (tagTasks copied into future)
-    QFuture<TagResult> future = QtConcurrent::mapped(tagTasks,
+    QFuture<TagResult> future = QtConcurrent::mapped(&_ioPool, tagTasks,
         [this](const TagTask &task) { return _tagImage(task); });
 
     _tagWatcher.setFuture(future);
@@ -737,16 +769,11 @@ GeoTagController::ExifResult GeoTagController::_parseExifForImage(const QFileInf
         return result;
     }
 
+    // Only the EXIF header is read, not the image data
     QString errorString;
-    const QByteArray imageBuffer = _readImageCached(imageInfo.absoluteFilePath(), &errorString);
-    if (imageBuffer.isEmpty()) {
-        result.errorMessage = tr("Geotagging failed. Couldn't open image: %1").arg(imageInfo.fileName());
-        return result;
-    }
-
-    const QDateTime imageTime = ExifParser::readTime(imageBuffer);
+    const QDateTime imageTime = ExifStreamTagger::readTime(imageInfo.absoluteFilePath(), errorString);
     if (!imageTime.isValid()) {
-        result.errorMessage = tr("Geotagging failed. Couldn't extract time from image: %1").arg(imageInfo.fileName());
+        result.errorMessage = tr("Geotagging failed. Couldn't extract time from image: %1 (%2)").arg(imageInfo.fileName(), errorString);
         return result;
     }
 
@@ -755,20 +782,20 @@ GeoTagController::ExifResult GeoTagController::_parseExifForImage(const QFileInf
     return result;
 }
 
-bool GeoTagController::_parseLogs(QString &errorMsg)
+GeoTagController::LogResult GeoTagController::_parseLogFile(const QString &logFilePath)
 {
-    _state.triggerList.clear();
+    LogResult result;
 
-    QFile logFile(_logFile);
+    QFile logFile(logFilePath);
     if (!logFile.open(QIODevice::ReadOnly)) {
-        errorMsg = tr("Geotagging failed. Couldn't open log file.");
-        return false;
+        result.errorMessage = tr("Geotagging failed. Couldn't open log file.");
+        return result;
     }
 
     const qint64 fileSize = logFile.size();
     if (fileSize == 0) {
-        errorMsg = tr("Geotagging failed. Log file is empty.");
-        return false;
+        result.errorMessage = tr("Geotagging failed. Log file is empty.");
+        return result;
     }
 
     // Memory-map the file for efficient parsing of large logs
@@ -785,32 +812,33 @@ bool GeoTagController::_parseLogs(QString &errorMsg)
         qCDebug(GeoTagControllerLog) << "Memory mapping failed, reading file into memory";
         fallbackBuffer = logFile.readAll();
         if (fallbackBuffer.isEmpty()) {
-            errorMsg = tr("Geotagging failed. Couldn't read log file.");
-            return false;
+            result.errorMessage = tr("Geotagging failed. Couldn't read log file.");
+            return result;
         }
         data = fallbackBuffer.constData();
         dataSize = fallbackBuffer.size();
     }
 
     // Auto-detect log format based on file extension
-    const QString logFileLower = _logFile.toLower();
+    const QString logFileLower = logFilePath.toLower();
     bool parseSuccess = false;
     QString errorString;
 
     if (logFileLower.endsWith(QStringLiteral(".bin"))) {
-        qCDebug(GeoTagControllerLog) << "Parsing DataFlash log:" << _logFile;
-        parseSuccess = DataFlashParser::getTagsFromLog(data, dataSize, _state.triggerList, errorString);
+        qCDebug(GeoTagControllerLog) << "Parsing DataFlash log:" << logFilePath;
+        parseSuccess = DataFlashParser::getTagsFromLog(data, dataSize, result.triggers, errorString);
     } else if (logFileLower.endsWith(QStringLiteral(".ulg"))) {
-        qCDebug(GeoTagControllerLog) << "Parsing ULog:" << _logFile;
-        parseSuccess = ULogParser::getTagsFromLog(data, dataSize, _state.triggerList, errorString);
+        qCDebug(GeoTagControllerLog) << "Parsing ULog:" << logFilePath;
+        parseSuccess = ULogParser::getTagsFromLog(data, dataSize, result.triggers, errorString);
     } else {
         // Try ULog first (PX4), then DataFlash (ArduPilot) as fallback
         qCDebug(GeoTagControllerLog) << "Unknown extension, trying ULog parser first";
-        parseSuccess = ULogParser::getTagsFromLog(data, dataSize, _state.triggerList, errorString);
+        parseSuccess = ULogParser::getTagsFromLog(data, dataSize, result.triggers, errorString);
         if (!parseSuccess) {
             qCDebug(GeoTagControllerLog) << "ULog failed, trying DataFlash parser";
             errorString.clear();
-            parseSuccess = DataFlashParser::getTagsFromLog(data, dataSize, _state.triggerList, errorString);
+            result.triggers.clear();
+            parseSuccess = DataFlashParser::getTagsFromLog(data, dataSize, result.triggers, errorString);
         }
     }
 
@@ -820,21 +848,12 @@ bool GeoTagController::_parseLogs(QString &errorMsg)
     }
 
     if (!parseSuccess) {
-        errorMsg = errorString.isEmpty() ? tr("Log parsing failed") : errorString;
-        return false;
-    }
-
-    qCDebug(GeoTagControllerLog) << "Found" << _state.triggerList.count() << "camera capture events";
-
-    if (_state.imageList.count() > _state.triggerList.count()) {
-        qCDebug(GeoTagControllerLog) << "Detected missing feedback packets:"
-                                      << (_state.imageList.count() - _state.triggerList.count()) << "images without triggers";
-    } else if (_state.imageList.count() < _state.triggerList.count()) {
-        qCDebug(GeoTagControllerLog) << "Detected missing image frames:"
-                                      << (_state.triggerList.count() - _state.imageList.count()) << "triggers without images";
+        result.errorMessage = errorString.isEmpty() ? tr("Log parsing failed") : errorString;
+        return result;
     }
 
-    return true;
+    result.success = true;
+    return result;
 }
 
 bool GeoTagController::_calibrate(QString &errorMsg)
@@ -960,26 +979,12 @@ GeoTagController::TagResult GeoTagController::_tagImage(const TagTask &task)
         return result;
     }
 
-    QString errorString;
-    QByteArray imageBuffer = _readImageCached(task.imageInfo.absoluteFilePath(), &errorString);
-    if (imageBuffer.isEmpty()) {
-        result.errorMessage = tr("Geotagging failed. Couldn't open image: %1").arg(result.fileName);
-        return result;
-    }
-
     // In preview mode, skip actual EXIF modification and file writing
     if (!task.previewMode) {
-        // Detach from cache before modifying (copy-on-write)
-        imageBuffer.detach();
-
-        if (!ExifParser::write(imageBuffer, task.geoTag)) {
-            result.errorMessage = tr("Geotagging failed. Couldn't write EXIF to image: %1").arg(result.fileName);
-            return result;
-        }
-
         const QString outputPath = QGCFileHelper::joinPath(task.outputDir, result.fileName);
-        if (!QGCFileHelper::atomicWrite(outputPath, imageBuffer)) {
-            result.errorMessage = tr("Geotagging failed. Couldn't save image: %1").arg(outputPath);
+        QString errorString;
+        if (!ExifStreamTagger::writeFile(task.imageInfo.absoluteFilePath(), outputPath, task.geoTag, errorString)) {
+            result.errorMessage = tr("Geotagging failed. Couldn't write EXIF to image: %1 (%2)").arg(result.fileName, errorString);
             return result;
         }
     }
@@ -988,65 +993,3 @@ GeoTagController::TagResult GeoTagController::_tagImage(const TagTask &task)
     result.success = true;
     return result;
 }
-
-// ============================================================================
-// Image cache methods
-// ============================================================================
-
-QByteArray GeoTagController::_readImageCached(const QString &path, QString *errorString)
-{
-    {
-        QMutexLocker locker(&_bufferMutex);
-        auto it = _imageBuffers.constFind(path);
-        if (it != _imageBuffers.constEnd()) {
-            return it.value();
-        }
-    }
-
-    // Read from disk (outside lock to allow parallel reads)
-    QString error;
-    QByteArray data = QGCCompression::readFile(path, &error);
-
-    if (data.isEmpty()) {
-        if (errorString) {
-            *errorString = error;
-        }
-        return {};
-    }
-
-    // Cache the data
-    {
-        QMutexLocker locker(&_bufferMutex);
-        _imageBuffers.insert(path, data);
-    }
-
-    return data;
-}
-
-void GeoTagController::_evictUnmatchedImages()
-{
-    QSet<QString> matchedPaths;
-    for (int idx : _state.imageIndices) {
-        if (idx < _state.imageList.count()) {
-            matchedPaths.insert(_state.imageList[idx].absoluteFilePath());
-        }
-    }
-
-    QMutexLocker locker(&_bufferMutex);
-    auto it = _imageBuffers.begin();
-    while (it != _imageBuffers.end()) {
-        if (!matchedPaths.contains(it.key())) {
-            it = _imageBuffers.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    qCDebug(GeoTagControllerLog) << "Evicted unmatched images, cache size:" << _imageBuffers.count();
-}
-
-void GeoTagController::_clearImageCache()
-{
-    QMutexLocker locker(&_bufferMutex);
-    _imageBuffers.clear();
-}
@@ -6,11 +6,10 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QFileInfoList>
 #include <QtCore/QFutureWatcher>
-#include <QtCore/QHash>
 #include <QtCore/QMap>
-#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QThreadPool>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtQmlIntegration/QtQmlIntegration>
 
@@ -44,6 +43,8 @@ CalibrationResult calibrate(const QList<qint64> &imageTimestamps,
 /// \brief Controller for GeoTagPage.qml. Supports geotagging images based on logfile camera tags.
 ///
 /// Uses async signal-based processing with QFutureWatcher for non-blocking operation.
+/// The trigger log is parsed while the image timestamps are scanned. Image access only touches the EXIF header
+/// (see ExifStreamTagger) and runs on a pool sized for I/O rather than for the CPU count.
 ///
 class GeoTagController : public QObject
 {
@@ -130,6 +131,12 @@ class GeoTagController : public QObject
         bool success = false;
     };
 
+    struct LogResult {
+        QList<GeoTagData> triggers;
+        QString errorMessage;
+        bool success = false;
+    };
+
     struct TagResult {
         int imageIndex = -1;
         QString fileName;
@@ -163,12 +170,13 @@ class GeoTagController : public QObject
     // Async stage handlers (slots for QFutureWatcher signals)
     void _onExifProgress(int value);
     void _onExifFinished();
+    void _onLogsFinished();
     void _onTagProgress(int value);
     void _onTagFinished();
 
     // Synchronous helpers (called from stage implementations)
     bool _loadImages(QString &errorMsg);
-    bool _parseLogs(QString &errorMsg);
+    static LogResult _parseLogFile(const QString &logFile);
     bool _calibrate(QString &errorMsg);
     bool _validateOutputDirectory(const QString &outputDir, QString &errorMsg);
     QList<TagTask> _buildTagTasks(const QString &outputDir, bool preview, QString &errorMsg);
@@ -177,11 +185,6 @@ class GeoTagController : public QObject
     ExifResult _parseExifForImage(const QFileInfo &imageInfo);
     TagResult _tagImage(const TagTask &task);
 
-    // Image buffer cache (thread-safe)
-    QByteArray _readImageCached(const QString &path, QString *errorString = nullptr);
-    void _evictUnmatchedImages();
-    void _clearImageCache();
-
     // QML properties
     QString _logFile;
     QString _imageDirectory;
@@ -225,21 +228,23 @@ class GeoTagController : public QObject
 
     // Async watchers for parallel stages
     QFutureWatcher<ExifResult> _exifWatcher;
+    QFutureWatcher<LogResult> _logWatcher;
     QFutureWatcher<TagResult> _tagWatcher;
 
+    /// Runs the per-image EXIF reads and writes, bounded to keep the disk streaming rather than seeking
+    QThreadPool _ioPool;
+
     ProcessingState _state;
 
     // Image model for QML display
     GeoTagImageModel *_imageModel = nullptr;
 
-    // Image buffer cache to avoid reading files twice
-    mutable QMutex _bufferMutex;
-    QHash<QString, QByteArray> _imageBuffers;
-
     // Progress calculation constants
     static constexpr double kLoadImagesEnd = 20.0;
     static constexpr double kParseExifEnd = 40.0;
     static constexpr double kParseLogsEnd = 60.0;
     static constexpr double kCalibrateEnd = 80.0;
     static constexpr double kTagImagesEnd = 100.0;
+
+    static constexpr int kMaxConcurrentIo = 4;
 };
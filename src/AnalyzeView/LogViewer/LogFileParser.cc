@@ -3,8 +3,10 @@
 #include "LogViewerDataFlashParser.h"
 #include "LogParseResultPrivate.h"
 #include "LogViewerParamMetaData.h"
+#include "LogViewerTlogParser.h"
 #include "QGCLoggingCategory.h"
 #include "LogViewerULogParser.h"
+#include "ULogStreamDecoder.h"
 
 #include <QtConcurrent/QtConcurrent>
 #include <QtCore/QFileInfo>
@@ -31,13 +33,17 @@ LogParseResult _parseFile(const QString &filePath, const ProgressCallback &progr
         return ULogParser::parseFile(filePath, progressCallback, cancelToken);
     }
 
+    if (suffix == QStringLiteral("tlog")) {
+        return TlogParser::parseFile(filePath, progressCallback, cancelToken);
+    }
+
     const QString fileTypeDescription = suffix.isEmpty()
         ? LogFileParser::tr("no extension")
         : QStringLiteral(".%1").arg(suffix);
 
     LogParseResult result;
     result.errorMessage = LogFileParser::tr(
-        "Unsupported file type (%1) for file '%2'. Expected .bin, .log, or .ulg.")
+        "Unsupported file type (%1) for file '%2'. Expected .bin, .log, .ulg, or .tlog.")
         .arg(fileTypeDescription, filePath);
     return result;
 }
@@ -152,16 +158,7 @@ void LogFileParser::_applyResult(const LogParseResult &result)
     _modeSegments = result.modeSegments;
     _dropouts = result.dropouts;
 
-    // Build mode color cache in first-appearance (chronological) order.
-    _modeColorCache.clear();
-    _modeNames.clear();
-    for (const QVariant &v : _modeSegments) {
-        const QString mode = v.toMap().value(QStringLiteral("mode")).toString();
-        if (!mode.isEmpty() && !_modeNames.contains(mode)) {
-            _modeColorCache.insert(mode, _modeColorCache.size());
-            _modeNames.append(mode);
-        }
-    }
+    _rebuildModeNames();
     _fieldSamples = result.fieldSamples;
     _sampleCount = result.sampleCount;
     _detectedVehicleType = result.detectedVehicleType;
@@ -189,8 +186,139 @@ void LogFileParser::_applyResult(const LogParseResult &result)
     emit parseCompleteChanged();
 }
 
+void LogFileParser::_rebuildModeNames()
+{
+    // Build mode color cache in first-appearance (chronological) order.
+    _modeColorCache.clear();
+    _modeNames.clear();
+    for (const QVariant &v : _modeSegments) {
+        const QString mode = v.toMap().value(QStringLiteral("mode")).toString();
+        if (!mode.isEmpty() && !_modeNames.contains(mode)) {
+            _modeColorCache.insert(mode, _modeColorCache.size());
+            _modeNames.append(mode);
+        }
+    }
+}
+
+const QHash<QString, QVector<QPointF>> &LogFileParser::_samples() const
+{
+    return _liveLog ? _liveLog->result().fieldSamples : _fieldSamples;
+}
+
+void LogFileParser::attachLiveLog(ULogStreamDecoder *decoder)
+{
+    clear();
+    if (!decoder) {
+        return;
+    }
+
+    _liveLog = decoder;
+    _liveParameterCount = 0;
+    (void) connect(decoder, &ULogStreamDecoder::updated, this, &LogFileParser::_applyLiveUpdate);
+    (void) connect(decoder, &ULogStreamDecoder::finishedChanged, this, [this]() {
+        // Keep showing the completed log after the decoder goes away. The columns are implicitly
+        // shared and no longer written, so this does not copy the samples.
+        _fieldSamples = _liveLog->result().fieldSamples;
+        _detachLiveLog();
+    });
+    (void) connect(decoder, &QObject::destroyed, this, [this]() {
+        // Destroyed while still streaming, the samples went with it. _liveLog is already null here.
+        clear();
+        emit liveChanged();
+    });
+    emit liveChanged();
+
+    _applyLiveUpdate();
+    if (decoder->finished()) {
+        _fieldSamples = decoder->result().fieldSamples;
+        _detachLiveLog();
+    }
+}
+
+void LogFileParser::_detachLiveLog()
+{
+    if (!_liveLog) {
+        return;
+    }
+
+    (void) disconnect(_liveLog, nullptr, this, nullptr);
+    _liveLog.clear();
+    emit liveChanged();
+}
+
+void LogFileParser::_applyLiveUpdate()
+{
+    if (!_liveLog) {
+        return;
+    }
+
+    // Lists are only replaced when they changed, each change signal makes the UI rebuild its view
+    const LogParseResult &result = _liveLog->result();
+    if (_availableFields != result.availableFields) {
+        _availableFields = result.availableFields;
+        emit availableFieldsChanged();
+    }
+    if (_plottableFields != result.plottableFields) {
+        _plottableFields = result.plottableFields;
+        emit plottableFieldsChanged();
+    }
+    if (_liveParameterCount != result.parameters.size() || _liveLog->finished()) {
+        _liveParameterCount = result.parameters.size();
+        _parameters = result.parameters;
+        LogViewerParamMetaData::enrichForPX4(_parameters);
+        emit parametersChanged();
+    }
+    if (_events.size() != result.events.size()) {
+        _events = result.events;
+        emit eventsChanged();
+    }
+    if (_messages.size() != result.messages.size()) {
+        _messages = result.messages;
+        emit messagesChanged();
+    }
+    if (_modeSegments != result.modeSegments) {
+        _modeSegments = result.modeSegments;
+        const QStringList oldModeNames = _modeNames;
+        _rebuildModeNames();
+        emit modeSegmentsChanged();
+        if (_modeNames != oldModeNames) {
+            emit modeNamesChanged();
+        }
+    }
+    if (_dropouts.size() != result.dropouts.size()) {
+        _dropouts = result.dropouts;
+        emit dropoutsChanged();
+    }
+    if (_detectedVehicleType != result.detectedVehicleType) {
+        _detectedVehicleType = result.detectedVehicleType;
+        emit detectedVehicleTypeChanged();
+    }
+    if (_minTimestamp != result.minTimestamp || _maxTimestamp != result.maxTimestamp) {
+        _minTimestamp = result.minTimestamp;
+        _maxTimestamp = result.maxTimestamp;
+        emit timeRangeChanged();
+    }
+    if (_sampleCount != result.sampleCount) {
+        _sampleCount = result.sampleCount;
+        emit sampleCountChanged();
+    }
+    if (_startTime != result.startTime) {
+        _startTime = result.startTime;
+        emit startTimeChanged();
+    }
+
+    if (!_parseComplete && !_availableFields.isEmpty()) {
+        _parseComplete = true;
+        emit parseCompleteChanged();
+    }
+
+    emit liveDataUpdated();
+}
+
 void LogFileParser::clear()
 {
+    _detachLiveLog();
+
     if (_parsing) {
         ++_parseRequestId;
         if (_cancelToken) {
@@ -232,8 +360,8 @@ void LogFileParser::clear()
 QVariantList LogFileParser::fieldSamples(const QString &fieldName) const
 {
     QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend()) { return output; }
+    const auto it = _samples().constFind(fieldName);
+    if (it == _samples().cend()) { return output; }
     const QVector<QPointF> &points = it.value();
     output.reserve(points.size());
     for (const QPointF &p : points) { output.append(p); }
@@ -242,8 +370,8 @@ QVariantList LogFileParser::fieldSamples(const QString &fieldName) const
 
 QVariantMap LogFileParser::fieldMinMax(const QString &fieldName) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) { return {}; }
+    const auto it = _samples().constFind(fieldName);
+    if (it == _samples().cend() || it->isEmpty()) { return {}; }
     const QVector<QPointF> &points = it.value();
     double minY = std::numeric_limits<double>::max();
     double maxY = std::numeric_limits<double>::lowest();
@@ -257,8 +385,8 @@ QVariantMap LogFileParser::fieldMinMax(const QString &fieldName) const
 QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const
 {
     QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || pixelWidth <= 0 || maxX <= minX) { return output; }
+    const auto it = _samples().constFind(fieldName);
+    if (it == _samples().cend() || pixelWidth <= 0 || maxX <= minX) { return output; }
 
     const QVector<QPointF> &points = it.value();
 
@@ -330,8 +458,8 @@ QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, doubl
 
 double LogFileParser::fieldValueAt(const QString &fieldName, double timestampSeconds) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) {
+    const auto it = _samples().constFind(fieldName);
+    if (it == _samples().cend() || it->isEmpty()) {
         return std::numeric_limits<double>::quiet_NaN();
     }
     const QVector<QPointF> &points = it.value();
@@ -419,9 +547,9 @@ QVariantMap LogFileParser::gpsCoordAt(double timestampSeconds) const
         return {};
     }
 
-    const auto latIt = _fieldSamples.constFind(_gpsLatField);
-    const auto lonIt = _fieldSamples.constFind(_gpsLonField);
-    if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
+    const auto latIt = _samples().constFind(_gpsLatField);
+    const auto lonIt = _samples().constFind(_gpsLonField);
+    if (latIt == _samples().cend() || lonIt == _samples().cend()) {
         return {};
     }
 
@@ -486,12 +614,15 @@ QVariantList LogFileParser::gpsPath() const
         { "GPS2.Lat",                              "GPS2.Lng",                              "GPS2.Alt",                               "GPS2.Status", 3 },
         // APM DataFlash — POS message (EKF-fused; no status field, 'L' type already divided by 1e7)
         { "POS.Lat",                               "POS.Lng",                               "POS.Alt",                                nullptr,       0 },
+        // MAVLink tlog — GLOBAL_POSITION_INT (EKF-fused) then GPS_RAW_INT (fix_type >= 3 = 3D fix), scaled to degrees by the parser
+        { "GLOBAL_POSITION_INT.lat",               "GLOBAL_POSITION_INT.lon",               "GLOBAL_POSITION_INT.alt",                nullptr,       0 },
+        { "GPS_RAW_INT.lat",                       "GPS_RAW_INT.lon",                       "GPS_RAW_INT.alt",                        "GPS_RAW_INT.fix_type", 3 },
     };
 
     for (const auto &c : candidates) {
-        const auto latIt = _fieldSamples.constFind(QLatin1String(c.latField));
-        const auto lonIt = _fieldSamples.constFind(QLatin1String(c.lonField));
-        if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
+        const auto latIt = _samples().constFind(QLatin1String(c.latField));
+        const auto lonIt = _samples().constFind(QLatin1String(c.lonField));
+        if (latIt == _samples().cend() || lonIt == _samples().cend()) {
             continue;
         }
 
@@ -504,8 +635,8 @@ QVariantList LogFileParser::gpsPath() const
         // Resolve optional status field (same message, same sample count as lat/lon).
         const QVector<QPointF> *statusPts = nullptr;
         if (c.statusField) {
-            const auto statusIt = _fieldSamples.constFind(QLatin1String(c.statusField));
-            if (statusIt != _fieldSamples.cend() && !statusIt.value().isEmpty()) {
+            const auto statusIt = _samples().constFind(QLatin1String(c.statusField));
+            if (statusIt != _samples().cend() && !statusIt.value().isEmpty()) {
                 statusPts = &statusIt.value();
             }
         }
@@ -546,8 +677,8 @@ QVariantList LogFileParser::gpsPath() const
             // Only cache the alt field if it actually exists and has samples;
             // otherwise the altitude chart would be shown with no data.
             const QLatin1String altField(c.altField);
-            const auto altIt = _fieldSamples.constFind(altField);
-            _gpsAltField = (altIt != _fieldSamples.cend() && !altIt.value().isEmpty()) ? altField : QLatin1String{};
+            const auto altIt = _samples().constFind(altField);
+            _gpsAltField = (altIt != _samples().cend() && !altIt.value().isEmpty()) ? altField : QLatin1String{};
             return path;
         }
 
@@ -555,7 +686,7 @@ QVariantList LogFileParser::gpsPath() const
     }
 
     qCDebug(LogFileParserLog) << "gpsPath: no GPS data found; available fields containing 'lat' or 'lon':";
-    for (auto it = _fieldSamples.cbegin(); it != _fieldSamples.cend(); ++it) {
+    for (auto it = _samples().cbegin(); it != _samples().cend(); ++it) {
         const QString &fn = it.key();
         if (fn.contains(QLatin1String("lat"), Qt::CaseInsensitive) || fn.contains(QLatin1String("lon"), Qt::CaseInsensitive)) {
             qCDebug(LogFileParserLog) << " " << fn << "samples:" << it.value().size()
@@ -2,6 +2,7 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
@@ -15,11 +16,15 @@
 #include <atomic>
 #include <memory>
 
-/// \brief Unified log file parser for both DataFlash (.bin/.log) and PX4 ULog (.ulg) files.
+class ULogStreamDecoder;
+
+Q_MOC_INCLUDE("ULogStreamDecoder.h")
+
+/// \brief Unified log file parser for DataFlash (.bin/.log), PX4 ULog (.ulg) and MAVLink telemetry (.tlog) files.
 ///
 /// Dispatches by file extension, verifies the header magic bytes match the expected
 /// format, then parses the file into a canonical set of properties that the log
-/// viewer UI consumes identically for both formats:
+/// viewer UI consumes identically for all formats:
 ///
 ///  - availableFields / plottableFields — two-level "Type.Field" hierarchy
 ///  - fieldSamples(name) — time-series (QPointF) for charting
@@ -29,6 +34,10 @@
 ///  - messages — free-text log messages
 ///  - dropouts — (ULog only) data-dropout intervals rendered as chart overlays
 ///
+/// A ULog which is still being streamed from the vehicle can be attached with attachLiveLog().
+/// The parser then reads the decoder's sample columns in place and emits liveDataUpdated()
+/// as they grow, until the decoder finishes.
+///
 class LogFileParser : public QObject
 {
     Q_OBJECT
@@ -51,6 +60,7 @@ class LogFileParser : public QObject
     Q_PROPERTY(double       maxTimestamp        READ maxTimestamp        NOTIFY timeRangeChanged)
     Q_PROPERTY(int          sampleCount         READ sampleCount         NOTIFY sampleCountChanged)
     Q_PROPERTY(QDateTime    startTime           READ startTime           NOTIFY startTimeChanged)
+    Q_PROPERTY(bool         live                READ live                NOTIFY liveChanged)
 
 public:
     explicit LogFileParser(QObject *parent = nullptr);
@@ -73,10 +83,13 @@ class LogFileParser : public QObject
     QDateTime startTime() const { return _startTime; }
     bool parsing() const { return _parsing; }
     float parseProgress() const { return _parseProgress; }
+    bool live() const { return !_liveLog.isNull(); }
 
     Q_INVOKABLE bool parseFile(const QString &filePath);
     Q_INVOKABLE void startParsingAsync(const QString &filePath);
     Q_INVOKABLE void clear();
+    /// Shows the log being decoded by `decoder`, replacing the current contents
+    Q_INVOKABLE void attachLiveLog(ULogStreamDecoder *decoder);
     Q_INVOKABLE QVariantList fieldSamples(const QString &fieldName) const;
     Q_INVOKABLE QVariantList fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const;
     Q_INVOKABLE QVariantMap  fieldMinMax(const QString &fieldName) const;
@@ -118,10 +131,17 @@ class LogFileParser : public QObject
     void parsingChanged();
     void parseProgressChanged();
     void parseFileFinished(const QString &filePath, bool ok, const QString &errorMessage);
+    void liveChanged();
+    /// New samples were appended to the fields of the attached live log
+    void liveDataUpdated();
 
 private:
     void _setParseError(const QString &error);
     void _applyResult(const struct LogParseResult &result);
+    void _applyLiveUpdate();
+    void _detachLiveLog();
+    void _rebuildModeNames();
+    const QHash<QString, QVector<QPointF>> &_samples() const;
 
     bool _parseComplete = false;
     QString _parseError;
@@ -142,6 +162,8 @@ class LogFileParser : public QObject
     bool _parsing = false;
     float _parseProgress = 0.f;
     std::shared_ptr<std::atomic<bool>> _cancelToken;
+    QPointer<ULogStreamDecoder> _liveLog;
+    qsizetype _liveParameterCount = 0;
 
     QStringList _modeNames;
     QHash<QString, int> _modeColorCache;
@@ -24,7 +24,7 @@ using ProgressCallback = std::function<void(float)>;
 using CancelToken = std::shared_ptr<std::atomic<bool>>;
 
 struct LogParseResult {
-    enum class SourceType { Unknown, PX4ULog, APMDataFlash };
+    enum class SourceType { Unknown, PX4ULog, APMDataFlash, MAVLinkTlog };
 
     bool ok = false;
     QString errorMessage;
@@ -92,6 +92,21 @@ Item {
         zoomRangeSet(minX, maxX)
     }
 
+    /// Grow the full range while a live log is being received.
+    /// A fully zoomed out chart follows the end of the log, a zoomed in one stays put.
+    /// Emits zoomRangeSet either way so derived charts pick up the new samples.
+    function extendRange(minX, maxX) {
+        if (maxX <= minX) return
+        const followTail = zoomMinX === fullMinX && zoomMaxX === fullMaxX
+        fullMinX = minX
+        fullMaxX = maxX
+        if (followTail) {
+            _applyZoomInternal(minX, maxX)
+        } else {
+            zoomRangeSet(zoomMinX, zoomMaxX)
+        }
+    }
+
     /// User-driven zoom — also emits zoomApplied for cross-chart sync.
     function applyZoomRange(minX, maxX) {
         _applyZoomInternal(minX, maxX)
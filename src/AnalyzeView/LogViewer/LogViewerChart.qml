@@ -179,6 +179,19 @@ ColumnLayout {
         _base.yAxis.max = 1
     }
 
+    // Public: called by parent when the attached live log got new samples
+    function refreshLiveData() {
+        const tracked = Object.keys(_seriesByField)
+        for (let i = 0; i < tracked.length; i++) {
+            const fr = logParser.fieldMinMax(tracked[i])
+            _fieldFullRange[tracked[i]] = (fr && fr.min !== undefined && fr.min <= fr.max) ? { min: fr.min, max: fr.max } : null
+        }
+
+        if (logParser.minTimestamp >= 0.0 && logParser.maxTimestamp > logParser.minTimestamp) {
+            _base.extendRange(logParser.minTimestamp, logParser.maxTimestamp)
+        }
+    }
+
     function _syncSeriesWithSelection() {
         const newSelection = logViewerController.selectedFields
 
@@ -44,6 +44,11 @@ void LogViewerController::openULogFile(const QString &path)
     _setLog(SourceType::ULog, path);
 }
 
+void LogViewerController::openLiveULog(const QString &name)
+{
+    _setLog(SourceType::ULog, name);
+}
+
 void LogViewerController::setPlottableFields(const QStringList &fieldNames)
 {
     _plottableFields = fieldNames;
@@ -53,6 +58,18 @@ void LogViewerController::setPlottableFields(const QStringList &fieldNames)
     _rebuildFieldRows();
 }
 
+void LogViewerController::updatePlottableFields(const QStringList &fieldNames)
+{
+    QStringList sorted = fieldNames;
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted == _plottableFields) {
+        return;
+    }
+
+    _plottableFields = sorted;
+    _rebuildFieldRows();
+}
+
 void LogViewerController::clearSelection()
 {
     if (_selectedFields.isEmpty()) {
@@ -41,7 +41,11 @@ class LogViewerController : public QObject
     Q_INVOKABLE void openTLog(const QString &path);
     Q_INVOKABLE void openBinLog(const QString &path);
     Q_INVOKABLE void openULogFile(const QString &path);
+    /// ULog streamed from the connected vehicle, `name` is shown in place of the file path
+    Q_INVOKABLE void openLiveULog(const QString &name);
     Q_INVOKABLE void setPlottableFields(const QStringList &fieldNames);
+    /// Same as setPlottableFields but keeps the selection, for a live log gaining fields
+    Q_INVOKABLE void updatePlottableFields(const QStringList &fieldNames);
     Q_INVOKABLE void clearSelection();
     Q_INVOKABLE void toggleGroupExpanded(const QString &groupName);
     Q_INVOKABLE bool isGroupExpanded(const QString &groupName) const;
@@ -29,8 +29,9 @@ Rectangle {
     property real _maxFieldRowWidth: _minFieldRowWidth
 
     readonly property real _minFieldRowWidth: ScreenTools.defaultFontPixelWidth
-    readonly property bool _isFirmwareLog: logViewerController.sourceType === LogViewerController.Bin
-                                        || logViewerController.sourceType === LogViewerController.ULog
+    readonly property bool _hasFieldData: logViewerController.sourceType === LogViewerController.Bin
+                                       || logViewerController.sourceType === LogViewerController.ULog
+                                       || (logViewerController.sourceType === LogViewerController.TLog && logParser.parseComplete)
 
     QGCPalette { id: qgcPal }
 
@@ -45,6 +46,12 @@ Rectangle {
         _applyFieldFilter()
     }
 
+    /// Called by the parent when a live log gained fields. Keeps the selection.
+    function updateGroupedFields() {
+        logViewerController.updatePlottableFields(logParser.plottableFields)
+        _applyFieldFilter()
+    }
+
     // -------------------------------------------------------------------------
     // Internal helpers
     // -------------------------------------------------------------------------
@@ -180,7 +187,7 @@ Rectangle {
         spacing: ScreenTools.defaultFontPixelHeight * 0.5
 
         QGCLabel {
-            visible: _isFirmwareLog
+            visible: _hasFieldData
             text: qsTr("Fields: %1  Parameters: %2  Events: %3")
                   .arg(logParser.plottableFields.length)
                   .arg(logParser.parameters.length)
@@ -188,7 +195,7 @@ Rectangle {
         }
 
         RowLayout {
-            visible: _isFirmwareLog
+            visible: _hasFieldData
                      && logParser.startTime
                      && !isNaN(logParser.startTime.getTime())
                      && logParser.startTime.getTime() > 0
@@ -214,7 +221,7 @@ Rectangle {
         }
 
         RowLayout {
-            visible: _isFirmwareLog
+            visible: _hasFieldData
             spacing: ScreenTools.defaultFontPixelWidth * 0.5
 
             QGCLabel {
@@ -262,7 +269,7 @@ Rectangle {
             id: _fieldsListView
             Layout.fillHeight: true
             Layout.preferredWidth: _maxFieldRowWidth + ScreenTools.defaultFontPixelWidth
-            visible: _isFirmwareLog
+            visible: _hasFieldData
             model: _filteredFieldRows
             spacing: ScreenTools.defaultFontPixelHeight * 0.25
 
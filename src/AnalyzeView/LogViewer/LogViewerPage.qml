@@ -29,6 +29,9 @@ AnalyzePage {
 
             readonly property bool isFirmwareLog: logViewerController.sourceType === LogViewerController.Bin
                                              || logViewerController.sourceType === LogViewerController.ULog
+            // Telemetry logs are replayed and also parsed for the charts
+            readonly property bool hasFieldData: isFirmwareLog
+                                             || (logViewerController.sourceType === LogViewerController.TLog && logParser.parseComplete)
 
             // Cancel any in-flight async parse before QML starts tearing down the tree.
             // Without this, the background thread can emit signals (parseProgressChanged,
@@ -92,13 +95,23 @@ AnalyzePage {
                     const lowerPath = filePath.toLowerCase()
                     if (lowerPath.endsWith(".ulg")) {
                         logViewerController.openULogFile(filePath)
-                    } else {
+                    } else if (!lowerPath.endsWith(".tlog")) {
+                        // .tlog was opened for replay before parsing
                         logViewerController.openBinLog(filePath)
                     }
                     pendingBinFile = ""
                 }
             }
 
+            Connections {
+                target: logParser
+
+                function onLiveDataUpdated() {
+                    fieldsPanel.updateGroupedFields()
+                    logViewerChart.refreshLiveData()
+                }
+            }
+
             LogReplayLinkController {
                 id: replayController
             }
@@ -137,6 +150,23 @@ AnalyzePage {
                     }
                 }
 
+                QGCButton {
+                    readonly property var _liveLog: {
+                        const activeVehicle = QGroundControl.multiVehicleManager.activeVehicle
+                        return (activeVehicle && activeVehicle.mavlinkLogManager) ? activeVehicle.mavlinkLogManager.liveLog : null
+                    }
+
+                    text: qsTr("Live log")
+                    visible: _liveLog !== null && !_liveLog.finished
+                    onClicked: {
+                        clearLoadedLogState(true)
+                        logParser.attachLiveLog(_liveLog)
+                        logViewerController.openLiveULog(qsTr("Live MAVLink log"))
+                        fieldsPanel.rebuildGroupedFields()
+                        logViewerChart.refreshBinChart()
+                    }
+                }
+
                 QGCButton {
                     text: qsTr("Clear")
                     enabled: logViewerController.hasLoadedLog
@@ -295,7 +325,7 @@ AnalyzePage {
                                 id: logViewerChart
                                 Layout.fillWidth: true
                                 Layout.fillHeight: true
-                                visible: isFirmwareLog
+                                visible: hasFieldData
                                 logParser: logParser
                                 logViewerController: logViewerController
                                 xAxisShowLocalTime: _xAxisShowLocalTime
@@ -493,6 +523,8 @@ AnalyzePage {
                         }
                         replayController.link = replayLink
                         logViewerController.openTLog(file)
+                        pendingBinFile = file
+                        logParser.startParsingAsync(file)
                     } else {
                         loadBinFile(file)
                     }
@@ -0,0 +1,197 @@
+#include "LogViewerTlogParser.h"
+
+#include "QGCMAVLink.h"
+#include "TlogIndex.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMap>
+#include <QtCore/QTimeZone>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// MAVLink positions are integers in 1e-7 degrees and millimeters, the viewer works in degrees and meters like the
+// other log formats
+struct ScaledField {
+    const char *name;
+    double scale;
+};
+
+constexpr ScaledField kScaledFields[] = {
+    { "GLOBAL_POSITION_INT.lat",            1e-7 },
+    { "GLOBAL_POSITION_INT.lon",            1e-7 },
+    { "GLOBAL_POSITION_INT.alt",            1e-3 },
+    { "GLOBAL_POSITION_INT.relative_alt",   1e-3 },
+    { "GPS_RAW_INT.lat",                    1e-7 },
+    { "GPS_RAW_INT.lon",                    1e-7 },
+    { "GPS_RAW_INT.alt",                    1e-3 },
+};
+
+double secondsSinceStart(const TlogIndex &index, const TlogIndex::Frame &frame)
+{
+    return static_cast<double>(static_cast<qint64>(frame.timeUsec - index.firstTimeUsec())) / 1e6;
+}
+
+QString fixedString(const char *text, size_t maxLength)
+{
+    return QString::fromUtf8(text, static_cast<qsizetype>(strnlen(text, maxLength)));
+}
+
+void addStatusTexts(const TlogIndex &index, uint8_t systemId, LogParseResult &result)
+{
+    mavlink_message_t message;
+    mavlink_statustext_t statusText;
+    for (const TlogIndex::Frame &frame : index.frames(MAVLINK_MSG_ID_STATUSTEXT)) {
+        if ((systemId != 0) && (index.systemId(frame) != systemId)) {
+            continue;
+        }
+        index.message(frame, message);
+        mavlink_msg_statustext_decode(&message, &statusText);
+
+        const QString text = fixedString(statusText.text, sizeof(statusText.text)).trimmed();
+        if (text.isEmpty()) {
+            continue;
+        }
+
+        const double timestampSecs = std::max(0.0, secondsSinceStart(index, frame));
+        QVariantMap msgRow;
+        msgRow[QStringLiteral("time")] = timestampSecs;
+        msgRow[QStringLiteral("text")] = text;
+        result.messages.append(msgRow);
+
+        if (statusText.severity <= MAV_SEVERITY_WARNING) {
+            QVariantMap eventRow;
+            eventRow[QStringLiteral("time")] = timestampSecs;
+            eventRow[QStringLiteral("type")] = (statusText.severity <= MAV_SEVERITY_ERROR) ? QStringLiteral("error") : QStringLiteral("warning");
+            eventRow[QStringLiteral("description")] = text;
+            result.events.append(eventRow);
+        }
+    }
+}
+
+void addParameters(const TlogIndex &index, uint8_t systemId, LogParseResult &result)
+{
+    // PX4 sends integer parameters bytewise in the float, other firmware casts them
+    const bool bytewise = QGCMAVLink::isPX4FirmwareClass(index.vehicleAutopilot());
+
+    // The last value of each parameter in the log, sorted by name
+    QMap<QString, QVariantMap> rows;
+    mavlink_message_t message;
+    mavlink_param_value_t paramValue;
+    for (const TlogIndex::Frame &frame : index.frames(MAVLINK_MSG_ID_PARAM_VALUE)) {
+        if ((systemId != 0) && (index.systemId(frame) != systemId)) {
+            continue;
+        }
+        index.message(frame, message);
+        mavlink_msg_param_value_decode(&message, &paramValue);
+
+        const QString name = fixedString(paramValue.param_id, sizeof(paramValue.param_id));
+        if (name.isEmpty()) {
+            continue;
+        }
+
+        QVariant value;
+        const bool isFloat = (paramValue.param_type == MAV_PARAM_TYPE_REAL32) || (paramValue.param_type == MAV_PARAM_TYPE_REAL64);
+        if (isFloat || !bytewise) {
+            value = isFloat ? static_cast<double>(paramValue.param_value) : static_cast<double>(static_cast<qint64>(paramValue.param_value));
+        } else {
+            mavlink_param_union_t paramUnion;
+            paramUnion.param_float = paramValue.param_value;
+            switch (paramValue.param_type) {
+            case MAV_PARAM_TYPE_UINT8:  value = paramUnion.param_uint8;  break;
+            case MAV_PARAM_TYPE_INT8:   value = paramUnion.param_int8;   break;
+            case MAV_PARAM_TYPE_UINT16: value = paramUnion.param_uint16; break;
+            case MAV_PARAM_TYPE_INT16:  value = paramUnion.param_int16;  break;
+            case MAV_PARAM_TYPE_UINT32: value = paramUnion.param_uint32; break;
+            default:                    value = paramUnion.param_int32;  break;
+            }
+        }
+
+        QVariantMap row;
+        row[QStringLiteral("name")]    = name;
+        row[QStringLiteral("value")]   = value;
+        row[QStringLiteral("isFloat")] = isFloat;
+        rows.insert(name, row);
+    }
+
+    for (const QVariantMap &row : std::as_const(rows)) {
+        result.parameters.append(row);
+    }
+}
+
+} // namespace
+
+namespace TlogParser {
+
+LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+{
+    LogParseResult result;
+
+    // Indexing reports the first half of the progress, the decoded columns complete it
+    ProgressCallback indexProgress;
+    if (progressCallback) {
+        indexProgress = [&progressCallback](float progress) { progressCallback(progress * 0.5f); };
+    }
+
+    TlogIndex index;
+    if (!index.open(filePath, indexProgress, cancelToken)) {
+        result.errorMessage = index.errorString();
+        return result;  // cancelled or failed; result.ok is false
+    }
+
+    // Telemetry logs also hold the messages of the ground station and other systems, the viewer shows the vehicle
+    const uint8_t systemId = index.vehicleSystemId();
+
+    result.sourceType = LogParseResult::SourceType::MAVLinkTlog;
+    result.availableFields = index.fieldNames(false);
+    std::sort(result.availableFields.begin(), result.availableFields.end());
+
+    QList<TlogIndex::Column> columns = index.decode(index.fieldNames(true), systemId, cancelToken);
+    if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+        return result;
+    }
+
+    for (TlogIndex::Column &column : columns) {
+        if (column.samples.isEmpty()) {
+            continue;
+        }
+        for (const ScaledField &scaledField : kScaledFields) {
+            if (column.name == QLatin1String(scaledField.name)) {
+                for (QPointF &sample : column.samples) {
+                    sample.setY(sample.y() * scaledField.scale);
+                }
+                break;
+            }
+        }
+        result.plottableFields.append(column.name);
+        result.fieldSamples.insert(column.name, std::move(column.samples));
+    }
+    std::sort(result.plottableFields.begin(), result.plottableFields.end());
+
+    addStatusTexts(index, systemId, result);
+    addParameters(index, systemId, result);
+
+    if (systemId != 0) {
+        result.detectedVehicleType = QGCMAVLink::vehicleClassToUserVisibleString(QGCMAVLink::vehicleClass(index.vehicleType()));
+    }
+
+    result.sampleCount = static_cast<int>(index.frameCount());
+    result.minTimestamp = 0.0;
+    result.maxTimestamp = static_cast<double>(index.lastTimeUsec() - index.firstTimeUsec()) / 1e6;
+
+    // Records are stamped with the ground station clock
+#ifndef QGC_NO_LOG_START_TIME
+    result.startTime = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(index.firstTimeUsec() / 1000), QTimeZone::utc());
+#endif // QGC_NO_LOG_START_TIME
+
+    if (progressCallback) {
+        progressCallback(1.f);
+    }
+
+    result.ok = true;
+    return result;
+}
+
+} // namespace TlogParser
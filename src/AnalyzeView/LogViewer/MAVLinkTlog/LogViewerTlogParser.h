@@ -0,0 +1,12 @@
+#pragma once
+
+#include "LogParseResultPrivate.h"
+
+#include <QtCore/QString>
+
+// Free-function parser for MAVLink telemetry logs (.tlog).
+// Returns a filled LogParseResult on success (result.ok == true) or an error
+// message in result.errorMessage on failure.
+namespace TlogParser {
+    LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr);
+}
@@ -0,0 +1,468 @@
+#include "TlogIndex.h"
+
+#include "QGCLoggingCategory.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(TlogIndexLog, "AnalyzeView.TlogIndex")
+
+namespace {
+
+constexpr qsizetype kHeaderLengthV1 = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+constexpr qsizetype kHeaderLengthV2 = MAVLINK_NUM_HEADER_BYTES;
+
+// A record found while resynchronizing must be within this long of the last good one
+constexpr quint64 kResyncWindowUsec = 3600ULL * 1000 * 1000;
+
+bool isV2(const uchar *frame)
+{
+    return frame[0] == MAVLINK_STX;
+}
+
+const uchar *payloadOf(const uchar *frame)
+{
+    return frame + (isV2(frame) ? kHeaderLengthV2 : kHeaderLengthV1);
+}
+
+/// The checksum covers the header after the start byte and the payload, seeded with the message's CRC extra. A
+/// message missing from the dialect cannot be checked and is treated as damaged.
+bool checksumValid(const uchar *frame, uint32_t msgId)
+{
+    const mavlink_msg_entry_t *const entry = mavlink_get_msg_entry(msgId);
+    if (!entry) {
+        return false;
+    }
+
+    const uint16_t checkedLength = static_cast<uint16_t>((isV2(frame) ? kHeaderLengthV2 : kHeaderLengthV1) - 1 + frame[1]);
+    uint16_t checksum = crc_calculate(frame + 1, checkedLength);
+    crc_accumulate(entry->crc_extra, &checksum);
+
+    const uchar *const received = frame + 1 + checkedLength;
+    return (received[0] == (checksum & 0xFF)) && (received[1] == (checksum >> 8));
+}
+
+unsigned typeSize(mavlink_message_type_t type)
+{
+    switch (type) {
+    case MAVLINK_TYPE_CHAR:
+    case MAVLINK_TYPE_UINT8_T:
+    case MAVLINK_TYPE_INT8_T:
+        return 1;
+    case MAVLINK_TYPE_UINT16_T:
+    case MAVLINK_TYPE_INT16_T:
+        return 2;
+    case MAVLINK_TYPE_UINT32_T:
+    case MAVLINK_TYPE_INT32_T:
+    case MAVLINK_TYPE_FLOAT:
+        return 4;
+    case MAVLINK_TYPE_UINT64_T:
+    case MAVLINK_TYPE_INT64_T:
+    case MAVLINK_TYPE_DOUBLE:
+        return 8;
+    }
+    return 0;
+}
+
+/// Frames of one message selected for decoding
+struct DecodeFrames {
+    QVector<double> times;
+    QVector<const uchar *> payloads;
+    QVector<uchar> payloadLengths;
+};
+
+/// Reads a little-endian wire value. MAVLink 2 drops trailing zero bytes of the payload, so a value past the end of
+/// the payload is zero.
+template<typename T>
+double readValue(const uchar *payload, unsigned payloadLength, unsigned offset)
+{
+    T value{};
+    if (offset < payloadLength) {
+        (void) memcpy(&value, payload + offset, std::min<size_t>(sizeof(T), payloadLength - offset));
+    }
+    return static_cast<double>(value);
+}
+
+template<typename T>
+void decodeColumn(const DecodeFrames &frames, unsigned offset, QVector<QPointF> &samples)
+{
+    const qsizetype count = frames.times.size();
+    samples.resize(count);
+    QPointF *const out = samples.data();
+    for (qsizetype i = 0; i < count; i++) {
+        out[i] = QPointF(frames.times[i], readValue<T>(frames.payloads[i], frames.payloadLengths[i], offset));
+    }
+}
+
+void decodeColumn(const DecodeFrames &frames, mavlink_message_type_t type, unsigned offset, QVector<QPointF> &samples)
+{
+    switch (type) {
+    case MAVLINK_TYPE_CHAR:
+    case MAVLINK_TYPE_INT8_T:   decodeColumn<int8_t>(frames, offset, samples);   break;
+    case MAVLINK_TYPE_UINT8_T:  decodeColumn<uint8_t>(frames, offset, samples);  break;
+    case MAVLINK_TYPE_UINT16_T: decodeColumn<uint16_t>(frames, offset, samples); break;
+    case MAVLINK_TYPE_INT16_T:  decodeColumn<int16_t>(frames, offset, samples);  break;
+    case MAVLINK_TYPE_UINT32_T: decodeColumn<uint32_t>(frames, offset, samples); break;
+    case MAVLINK_TYPE_INT32_T:  decodeColumn<int32_t>(frames, offset, samples);  break;
+    case MAVLINK_TYPE_UINT64_T: decodeColumn<uint64_t>(frames, offset, samples); break;
+    case MAVLINK_TYPE_INT64_T:  decodeColumn<int64_t>(frames, offset, samples);  break;
+    case MAVLINK_TYPE_FLOAT:    decodeColumn<float>(frames, offset, samples);    break;
+    case MAVLINK_TYPE_DOUBLE:   decodeColumn<double>(frames, offset, samples);   break;
+    }
+}
+
+} // namespace
+
+TlogIndex::~TlogIndex()
+{
+    close();
+}
+
+bool TlogIndex::open(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+{
+    close();
+    _errorString.clear();
+
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        _errorString = QCoreApplication::translate("LogFileParser", "Failed to open file");
+        return false;
+    }
+
+    const qint64 fileSize = _file.size();
+    if (fileSize <= 0) {
+        _errorString = QCoreApplication::translate("LogFileParser", "File is empty");
+        close();
+        return false;
+    }
+    if (fileSize > std::numeric_limits<qsizetype>::max()) {
+        _errorString = QCoreApplication::translate("LogFileParser", "File is too large to parse");
+        close();
+        return false;
+    }
+
+    _data = _file.map(0, fileSize);
+    if (!_data) {
+        _errorString = QCoreApplication::translate("LogFileParser", "Failed to memory-map file");
+        close();
+        return false;
+    }
+    _size = fileSize;
+
+    if (!_index(progressCallback, cancelToken)) {
+        close();
+        return false;
+    }
+
+    qCDebug(TlogIndexLog) << filePath << "frames" << _frameCount << "messages" << _frames.size() << "skipped bytes" << _skippedBytes;
+    return true;
+}
+
+void TlogIndex::close()
+{
+    if (_data) {
+        (void) _file.unmap(const_cast<uchar *>(_data));
+        _data = nullptr;
+    }
+    _file.close();
+    _size = 0;
+
+    _frames.clear();
+    _frameCount = 0;
+    _skippedBytes = 0;
+    _firstTimeUsec = 0;
+    _lastTimeUsec = 0;
+    _vehicleSystemId = 0;
+    _vehicleAutopilot = MAV_AUTOPILOT_INVALID;
+    _vehicleType = MAV_TYPE_GENERIC;
+}
+
+qsizetype TlogIndex::_frameLength(qint64 offset, uint32_t &msgId) const
+{
+    const qint64 available = _size - offset;
+    if (available <= 0) {
+        return 0;
+    }
+
+    const uchar *const frame = _data + offset;
+    qsizetype length = 0;
+    if (frame[0] == MAVLINK_STX) {
+        if (available < kHeaderLengthV2) {
+            return 0;
+        }
+        length = kHeaderLengthV2 + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+        if (frame[2] & MAVLINK_IFLAG_SIGNED) {
+            length += MAVLINK_SIGNATURE_BLOCK_LEN;
+        }
+        msgId = frame[7] | (frame[8] << 8) | (static_cast<uint32_t>(frame[9]) << 16);
+    } else if (frame[0] == MAVLINK_STX_MAVLINK1) {
+        if (available < kHeaderLengthV1) {
+            return 0;
+        }
+        length = kHeaderLengthV1 + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+        msgId = frame[5];
+    } else {
+        return 0;
+    }
+
+    if ((length > available) || !checksumValid(frame, msgId)) {
+        return 0;
+    }
+    return length;
+}
+
+bool TlogIndex::_index(const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+{
+    static constexpr qint64 kProgressInterval = 4 * 1024 * 1024;
+
+    qint64 nextProgress = kProgressInterval;
+    bool resyncing = false;
+    qint64 pos = 0;
+    while ((pos + kTimestampBytes) < _size) {
+        if (pos >= nextProgress) {
+            nextProgress += kProgressInterval;
+            if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (progressCallback) {
+                progressCallback(static_cast<float>(pos) / static_cast<float>(_size));
+            }
+        }
+
+        uint32_t msgId = 0;
+        const qint64 frameOffset = pos + kTimestampBytes;
+        const qsizetype length = _frameLength(frameOffset, msgId);
+        const quint64 timeUsec = qFromBigEndian<quint64>(_data + pos);
+
+        bool valid = (length > 0);
+        if (valid && resyncing) {
+            // A stray start byte with a matching checksum in the damaged bytes must still not be taken for a record
+            const quint64 lastTimeUsec = (_frameCount > 0) ? _lastTimeUsec : timeUsec;
+            valid = (timeUsec + kResyncWindowUsec >= lastTimeUsec)
+                && (timeUsec <= lastTimeUsec + kResyncWindowUsec);
+        }
+        if (!valid) {
+            // Not a record, step a byte at a time until the records line up again
+            resyncing = true;
+            _skippedBytes++;
+            pos++;
+            continue;
+        }
+        resyncing = false;
+
+        if (_frameCount == 0) {
+            _firstTimeUsec = timeUsec;
+        }
+        _lastTimeUsec = std::max(_lastTimeUsec, timeUsec);
+        _frames[msgId].append(Frame{frameOffset, timeUsec});
+        _frameCount++;
+
+        if ((msgId == MAVLINK_MSG_ID_HEARTBEAT) && (_vehicleSystemId == 0)) {
+            mavlink_message_t heartbeatMessage;
+            message(Frame{frameOffset, timeUsec}, heartbeatMessage);
+            mavlink_heartbeat_t heartbeat;
+            mavlink_msg_heartbeat_decode(&heartbeatMessage, &heartbeat);
+            if (heartbeat.autopilot != MAV_AUTOPILOT_INVALID) {
+                _vehicleSystemId = heartbeatMessage.sysid;
+                _vehicleAutopilot = static_cast<MAV_AUTOPILOT>(heartbeat.autopilot);
+                _vehicleType = static_cast<MAV_TYPE>(heartbeat.type);
+            }
+        }
+
+        pos = frameOffset + length;
+    }
+    _skippedBytes += _size - pos;
+
+    if (_frameCount == 0) {
+        _errorString = QCoreApplication::translate("LogFileParser", "File does not contain any MAVLink messages");
+        return false;
+    }
+
+    if (progressCallback) {
+        progressCallback(1.f);
+    }
+    return true;
+}
+
+QList<uint32_t> TlogIndex::messageIds() const
+{
+    QList<uint32_t> msgIds = _frames.keys();
+    std::sort(msgIds.begin(), msgIds.end());
+    return msgIds;
+}
+
+const QVector<TlogIndex::Frame> &TlogIndex::frames(uint32_t msgId) const
+{
+    static const QVector<Frame> empty;
+    const auto it = _frames.constFind(msgId);
+    return (it != _frames.cend()) ? it.value() : empty;
+}
+
+uint8_t TlogIndex::systemId(const Frame &frame) const
+{
+    const uchar *const data = _data + frame.offset;
+    return isV2(data) ? data[5] : data[3];
+}
+
+void TlogIndex::message(const Frame &frame, mavlink_message_t &message) const
+{
+    message = {};
+
+    const uchar *const data = _data + frame.offset;
+    message.magic = data[0];
+    message.len = data[1];
+    if (isV2(data)) {
+        message.incompat_flags = data[2];
+        message.compat_flags = data[3];
+        message.seq = data[4];
+        message.sysid = data[5];
+        message.compid = data[6];
+        message.msgid = data[7] | (data[8] << 8) | (static_cast<uint32_t>(data[9]) << 16);
+    } else {
+        message.seq = data[2];
+        message.sysid = data[3];
+        message.compid = data[4];
+        message.msgid = data[5];
+    }
+    (void) memcpy(_MAV_PAYLOAD_NON_CONST(&message), payloadOf(data), message.len);
+}
+
+QStringList TlogIndex::fieldNames(bool plottableOnly) const
+{
+    QStringList names;
+    for (const uint32_t msgId : messageIds()) {
+        const mavlink_message_info_t *const info = mavlink_get_message_info_by_id(msgId);
+        if (!info) {
+            continue;
+        }
+
+        const QString prefix = QLatin1String(info->name) + QLatin1Char('.');
+        for (unsigned int i = 0; i < info->num_fields; i++) {
+            const mavlink_field_info_t &field = info->fields[i];
+            const QString name = prefix + QLatin1String(field.name);
+            if (field.type == MAVLINK_TYPE_CHAR) {
+                if (!plottableOnly) {
+                    names.append(name);
+                }
+            } else if (field.array_length > 0) {
+                for (unsigned int j = 0; j < field.array_length; j++) {
+                    names.append(QStringLiteral("%1[%2]").arg(name).arg(j));
+                }
+            } else {
+                names.append(name);
+            }
+        }
+    }
+    return names;
+}
+
+QList<TlogIndex::Column> TlogIndex::decode(const QStringList &fieldNames, uint8_t systemId, const CancelToken &cancelToken) const
+{
+    struct FieldRef {
+        qsizetype column;
+        mavlink_message_type_t type;
+        unsigned offset;
+    };
+    struct Job {
+        uint32_t msgId;
+        QList<FieldRef> fields;
+    };
+
+    QHash<QString, uint32_t> msgIdByName;
+    for (auto it = _frames.cbegin(); it != _frames.cend(); ++it) {
+        const mavlink_message_info_t *const info = mavlink_get_message_info_by_id(it.key());
+        if (info) {
+            msgIdByName.insert(QLatin1String(info->name), it.key());
+        }
+    }
+
+    QList<Column> columns(fieldNames.size());
+    QList<Job> jobs;
+    QHash<uint32_t, qsizetype> jobByMsgId;
+    for (qsizetype i = 0; i < fieldNames.size(); i++) {
+        const QString &fieldName = fieldNames[i];
+        columns[i].name = fieldName;
+
+        const qsizetype dot = fieldName.indexOf(QLatin1Char('.'));
+        const auto msgIt = msgIdByName.constFind(fieldName.left(dot));
+        if ((dot < 0) || (msgIt == msgIdByName.cend())) {
+            continue;
+        }
+
+        // Split "field[i]" into the field name and array index
+        QStringView field = QStringView(fieldName).mid(dot + 1);
+        unsigned arrayIndex = 0;
+        bool arrayElement = false;
+        const qsizetype bracket = field.indexOf(QLatin1Char('['));
+        if ((bracket > 0) && field.endsWith(QLatin1Char(']'))) {
+            bool ok = false;
+            arrayIndex = field.mid(bracket + 1, field.size() - bracket - 2).toUInt(&ok);
+            if (!ok) {
+                continue;
+            }
+            arrayElement = true;
+            field = field.left(bracket);
+        }
+
+        const mavlink_message_info_t *const info = mavlink_get_message_info_by_id(msgIt.value());
+        for (unsigned int j = 0; j < info->num_fields; j++) {
+            const mavlink_field_info_t &fieldInfo = info->fields[j];
+            if (field != QLatin1String(fieldInfo.name)) {
+                continue;
+            }
+            const bool isArray = (fieldInfo.array_length > 0) && (fieldInfo.type != MAVLINK_TYPE_CHAR);
+            if ((isArray != arrayElement) || (isArray && (arrayIndex >= fieldInfo.array_length))) {
+                break;
+            }
+
+            const qsizetype jobIndex = jobByMsgId.value(msgIt.value(), jobs.size());
+            if (jobIndex == jobs.size()) {
+                jobByMsgId.insert(msgIt.value(), jobIndex);
+                jobs.append(Job{msgIt.value(), {}});
+            }
+            const mavlink_message_type_t type = fieldInfo.type;
+            columns[i].type = type;
+            jobs[jobIndex].fields.append(FieldRef{i, type, fieldInfo.wire_offset + (arrayIndex * typeSize(type))});
+            break;
+        }
+    }
+
+    // Every job writes only the columns of its own message
+    Column *const columnData = columns.data();
+    QtConcurrent::blockingMap(jobs, [this, systemId, columnData, &cancelToken](const Job &job) {
+        const QVector<Frame> &messageFrames = frames(job.msgId);
+
+        DecodeFrames selected;
+        selected.times.reserve(messageFrames.size());
+        selected.payloads.reserve(messageFrames.size());
+        selected.payloadLengths.reserve(messageFrames.size());
+        double lastTime = 0;
+        for (const Frame &frame : messageFrames) {
+            if ((systemId != 0) && (this->systemId(frame) != systemId)) {
+                continue;
+            }
+            // Charts need ascending times, a clock step backwards repeats the previous time
+            const double time = static_cast<double>(static_cast<qint64>(frame.timeUsec - _firstTimeUsec)) / 1e6;
+            lastTime = std::max(lastTime, time);
+
+            const uchar *const data = _data + frame.offset;
+            selected.times.append(lastTime);
+            selected.payloads.append(payloadOf(data));
+            selected.payloadLengths.append(data[1]);
+        }
+
+        for (const FieldRef &field : job.fields) {
+            if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+                return;
+            }
+            decodeColumn(selected, field.type, field.offset, columnData[field.column].samples);
+        }
+    });
+
+    return columns;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "LogParseResultPrivate.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/// Frame index of a MAVLink telemetry log (.tlog) for the Log Viewer.
+///
+/// A tlog is the sequence of records MAVLinkProtocol writes: a big-endian Unix time in microseconds followed by one
+/// MAVLink v1 or v2 frame as it was sent or received. open() memory-maps the file and finds every frame in a single
+/// pass, grouping the frame offsets by message id; no payload is copied. Frames whose checksum does not match are
+/// skipped as damaged bytes. decode() then reads the requested fields
+/// straight from the mapping into columns using the MAVLink message info tables, one worker per message.
+class TlogIndex
+{
+public:
+    /// One record of the log
+    struct Frame {
+        qint64  offset;     ///< Offset of the MAVLink frame in the file
+        quint64 timeUsec;   ///< Unix time the frame was logged
+    };
+
+    /// Decoded samples of one field
+    struct Column {
+        QString                 name;       ///< "MESSAGE.field", "MESSAGE.field[i]" for array elements
+        mavlink_message_type_t  type = MAVLINK_TYPE_CHAR;
+        QVector<QPointF>        samples;    ///< Seconds since the first record, value
+    };
+
+    TlogIndex() = default;
+    ~TlogIndex();
+
+    TlogIndex(const TlogIndex &) = delete;
+    TlogIndex &operator=(const TlogIndex &) = delete;
+
+    /// Maps the file and indexes its frames, replacing the previous file
+    /// @param progressCallback Called with 0..1 as the file is indexed
+    /// @return false if the file could not be mapped, holds no frames or indexing was cancelled
+    bool open(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr);
+    void close();
+
+    QString errorString() const { return _errorString; }
+    qint64 fileSize() const { return _size; }
+    qsizetype frameCount() const { return _frameCount; }
+    /// @return Bytes between records which did not hold a frame with a valid checksum, skipped while indexing
+    qint64 skippedBytes() const { return _skippedBytes; }
+    quint64 firstTimeUsec() const { return _firstTimeUsec; }
+    quint64 lastTimeUsec() const { return _lastTimeUsec; }
+
+    /// System id of the first heartbeat from an autopilot, 0 if there was none
+    uint8_t vehicleSystemId() const { return _vehicleSystemId; }
+    MAV_AUTOPILOT vehicleAutopilot() const { return _vehicleAutopilot; }
+    MAV_TYPE vehicleType() const { return _vehicleType; }
+
+    /// @return Ids of the messages in the log, in ascending order
+    QList<uint32_t> messageIds() const;
+    const QVector<Frame> &frames(uint32_t msgId) const;
+
+    uint8_t systemId(const Frame &frame) const;
+    /// Copies a frame into @p message, the payload is zero extended to the full message length so the generated
+    /// mavlink_msg_*_decode() functions can be used on it
+    void message(const Frame &frame, mavlink_message_t &message) const;
+
+    /// @return Names of all fields of the messages in the log
+    /// @param plottableOnly Skip char fields
+    QStringList fieldNames(bool plottableOnly) const;
+
+    /// Decodes fields into columns, in the order of @p fieldNames. Unknown names give an empty column.
+    /// @param systemId Only decode frames from this system, 0 for all
+    QList<Column> decode(const QStringList &fieldNames, uint8_t systemId = 0, const CancelToken &cancelToken = nullptr) const;
+
+    static constexpr qsizetype kTimestampBytes = sizeof(quint64);
+
+private:
+    bool _index(const ProgressCallback &progressCallback, const CancelToken &cancelToken);
+    qsizetype _frameLength(qint64 offset, uint32_t &msgId) const;
+
+    QFile _file;
+    const uchar *_data = nullptr;
+    qint64 _size = 0;
+    QString _errorString;
+
+    QHash<uint32_t, QVector<Frame>> _frames;
+    qsizetype _frameCount = 0;
+    qint64 _skippedBytes = 0;
+    quint64 _firstTimeUsec = 0;
+    quint64 _lastTimeUsec = 0;
+    uint8_t _vehicleSystemId = 0;
+    MAV_AUTOPILOT _vehicleAutopilot = MAV_AUTOPILOT_INVALID;
+    MAV_TYPE _vehicleType = MAV_TYPE_GENERIC;
+};
@@ -113,6 +113,73 @@ void ULogFullHandler::headerComplete()
     }
 }
 
+void ULogFullHandler::_resolveColumns(SubscriptionInfo &sub)
+{
+    sub.columnsResolved = true;
+    sub.hasTimestamp = sub.format->fieldMap().count("timestamp") > 0;
+    sub.hasUtcTime = (sub.topicName == "sensor_gps" || sub.topicName == "vehicle_gps_position")
+                     && sub.format->fieldMap().count("time_utc_usec") > 0;
+
+    // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance
+    const QString prefix = (sub.multiId > 0)
+        ? QStringLiteral("%1[%2].").arg(QString::fromStdString(sub.topicName)).arg(sub.multiId)
+        : QString::fromStdString(sub.topicName) + QLatin1Char('.');
+
+    for (const auto &field : sub.format->fields()) {
+        // Skip padding fields and the timestamp itself
+        if (field->name().rfind("_padding", 0) == 0) {
+            continue;
+        }
+        if (field->name() == "timestamp") {
+            continue;
+        }
+        if (!field->definitionResolved()) {
+            continue;
+        }
+
+        FieldColumn column;
+        column.field = field;
+        column.name = prefix + QString::fromStdString(field->name());
+        column.plottable = _isNumericScalarField(*field);
+        _fieldSet.insert(column.name);
+        sub.columns.push_back(std::move(column));
+    }
+    _fieldListsDirty = true;
+}
+
+void ULogFullHandler::_appendSample(FieldColumn &column, double timestampSecs, double value)
+{
+    if (column.skipped + 1 < column.stride) {
+        column.skipped++;
+        return;
+    }
+    column.skipped = 0;
+
+    // Resolve the column once instead of hashing the name for every sample. Adding a key can rehash fieldSamples,
+    // which moves every entry, so that invalidates the pointers held by all other columns.
+    if (column.samplesGeneration != _samplesGeneration) {
+        const qsizetype fieldCount = _result.fieldSamples.size();
+        column.samples = &_result.fieldSamples[column.name];
+        if (_result.fieldSamples.size() != fieldCount) {
+            _samplesGeneration++;
+        }
+        column.samplesGeneration = _samplesGeneration;
+    }
+
+    QVector<QPointF> &samples = *column.samples;
+    samples.append(QPointF(timestampSecs, value));
+
+    if ((_maxSamplesPerField > 0) && (samples.size() >= _maxSamplesPerField)) {
+        // Keep every other sample, the whole time range stays covered at half the density
+        const qsizetype kept = (samples.size() + 1) / 2;
+        for (qsizetype i = 1; i < kept; i++) {
+            samples[i] = samples[i * 2];
+        }
+        samples.resize(kept);
+        column.stride *= 2;
+    }
+}
+
 void ULogFullHandler::data(const ulog_cpp::Data &data)
 {
     if (!_headerComplete) {
@@ -120,21 +187,25 @@ void ULogFullHandler::data(const ulog_cpp::Data &data)
     }
 
     const auto it = _subscriptions.find(data.msgId());
-    if (it == _subscriptions.cend()) {
+    if (it == _subscriptions.end()) {
         return;
     }
 
-    const SubscriptionInfo &sub = it->second;
+    SubscriptionInfo &sub = it->second;
     if (!sub.format) {
         return;
     }
 
     try {
+        if (!sub.columnsResolved) {
+            _resolveColumns(sub);
+        }
+
         const ulog_cpp::TypedDataView view(data, *sub.format);
 
         // Extract timestamp (ULog convention: field named "timestamp", unit µs)
         double timestampSecs = -1.0;
-        if (sub.format->fieldMap().count("timestamp") > 0) {
+        if (sub.hasTimestamp) {
             const uint64_t tsUs = view.at("timestamp").as<uint64_t>();
             timestampSecs = static_cast<double>(tsUs) / 1e6;
             _lastTimestampSecs = timestampSecs;
@@ -143,46 +214,29 @@ void ULogFullHandler::data(const ulog_cpp::Data &data)
         // Extract GPS UTC start time from first valid sensor_gps/vehicle_gps_position sample.
         // Define QGC_NO_LOG_START_TIME at build time to suppress this for UI testing.
 #ifndef QGC_NO_LOG_START_TIME
-        if (_result.startTime.isNull() && timestampSecs >= 0.0) {
-            if ((sub.topicName == "sensor_gps" || sub.topicName == "vehicle_gps_position")
-                    && sub.format->fieldMap().count("time_utc_usec") > 0) {
-                const uint64_t utcUsec = view.at("time_utc_usec").as<uint64_t>();
-                const uint64_t tsUs   = view.at("timestamp").as<uint64_t>();
-                if (utcUsec > 0 && utcUsec >= tsUs) {
-                    const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
-                    _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
-                }
+        if (_result.startTime.isNull() && timestampSecs >= 0.0 && sub.hasUtcTime) {
+            const uint64_t utcUsec = view.at("time_utc_usec").as<uint64_t>();
+            const uint64_t tsUs   = view.at("timestamp").as<uint64_t>();
+            if (utcUsec > 0 && utcUsec >= tsUs) {
+                const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
+                _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
             }
         }
 #endif // QGC_NO_LOG_START_TIME
 
-        // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance
-        const QString prefix = (sub.multiId > 0)
-            ? QStringLiteral("%1[%2].").arg(QString::fromStdString(sub.topicName)).arg(sub.multiId)
-            : QString::fromStdString(sub.topicName) + QLatin1Char('.');
-
-        for (const auto &field : sub.format->fields()) {
-            // Skip padding fields and the timestamp itself
-            if (field->name().rfind("_padding", 0) == 0) {
-                continue;
-            }
-            if (field->name() == "timestamp") {
-                continue;
-            }
-            if (!field->definitionResolved()) {
-                continue;
-            }
-
-            const QString fieldName = prefix + QString::fromStdString(field->name());
-            _fieldSet.insert(fieldName);
+        if (timestampSecs >= 0.0) {
+            for (FieldColumn &column : sub.columns) {
+                if (!column.plottable) {
+                    continue;
+                }
 
-            if (!_isNumericScalarField(*field) || timestampSecs < 0.0) {
-                continue;
+                _appendSample(column, timestampSecs, view.at(column.field).as<double>());
+                if (!column.listedPlottable) {
+                    column.listedPlottable = true;
+                    _plottableFieldSet.insert(column.name);
+                    _fieldListsDirty = true;
+                }
             }
-
-            const double value = view.at(field).as<double>();
-            _result.fieldSamples[fieldName].append(QPointF(timestampSecs, value));
-            _plottableFieldSet.insert(fieldName);
         }
 
         _result.sampleCount++;
@@ -289,7 +343,7 @@ void ULogFullHandler::dropout(const ulog_cpp::Dropout &dropout)
     _result.dropouts.append(row);
 }
 
-void ULogFullHandler::finalize()
+void ULogFullHandler::_detectVehicleType()
 {
     // Detect vehicle type from vehicle_status.vehicle_type
     // PX4 vehicle_type enum: 0=Unknown, 1=Rotary Wing, 2=Fixed Wing, 3=Rover, 4=Airship
@@ -304,6 +358,11 @@ void ULogFullHandler::finalize()
         default: break; // 0 = Unknown, leave empty so UI shows "Unknown"
         }
     }
+}
+
+void ULogFullHandler::_buildModeSegments()
+{
+    _result.modeSegments.clear();
 
     // Derive mode segments from vehicle_status.nav_state samples.
     // nav_state is a uint8_t mapped to the PX4 navigation_state enum.
@@ -340,12 +399,40 @@ void ULogFullHandler::finalize()
             _result.modeSegments.append(seg);
         }
     }
+}
+
+void ULogFullHandler::_buildFieldLists()
+{
+    if (!_fieldListsDirty) {
+        return;
+    }
+    _fieldListsDirty = false;
 
     // Sort field lists for consistent display
     _result.availableFields = _fieldSet.values();
     std::sort(_result.availableFields.begin(), _result.availableFields.end());
     _result.plottableFields = _plottableFieldSet.values();
     std::sort(_result.plottableFields.begin(), _result.plottableFields.end());
+}
+
+void ULogFullHandler::refresh()
+{
+    // Readers may copy the result from here on, a detached copy must not keep receiving samples
+    _samplesGeneration++;
+
+    _detectVehicleType();
+    _buildModeSegments();
+    _buildFieldLists();
+}
+
+void ULogFullHandler::finalize()
+{
+    _samplesGeneration++;
+
+    _detectVehicleType();
+    _buildModeSegments();
+    _fieldListsDirty = true;
+    _buildFieldLists();
 
     // Annotate parameter rows with default value info now that all ParameterDefault
     // messages have been collected.
@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <ulog_cpp/data_handler_interface.hpp>
 #include <ulog_cpp/messages.hpp>
@@ -23,6 +24,10 @@ struct LogParseResult;
 /// parameters, log messages, events, and dropouts into a LogParseResult.
 /// Call finalize() after parsing to build mode segments and sort signal lists.
 ///
+/// Samples are only ever appended to the per-field columns, so the handler can
+/// also decode a log which is still being written (see ULogStreamDecoder) and
+/// publish intermediate results with refresh().
+///
 class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
 {
 public:
@@ -46,15 +51,44 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
     /// and sort availableFields / plottableFields lists.
     void finalize();
 
+    /// Mid-parse: rebuild field lists, vehicle type and mode segments from the
+    /// samples decoded so far. Parameter defaults are left to finalize().
+    void refresh();
+
+    /// Caps the number of samples per field, 0 (default) is unbounded. A column
+    /// reaching the cap is thinned 2:1 and keeps every other sample from then on.
+    void setMaxSamplesPerField(qsizetype maxSamples) { _maxSamplesPerField = maxSamples; }
+
 private:
     LogParseResult &_result;
 
+    struct FieldColumn {
+        std::shared_ptr<ulog_cpp::Field> field;
+        QString name;                   ///< "topic.field" or "topic[N].field"
+        bool plottable{false};
+        bool listedPlottable{false};
+        int stride{1};                  ///< Only every stride'th sample is kept once the column was thinned
+        int skipped{0};
+        QVector<QPointF> *samples{nullptr}; ///< Entry in _result.fieldSamples, valid while samplesGeneration matches
+        quint64 samplesGeneration{0};
+    };
+
     struct SubscriptionInfo {
         std::shared_ptr<ulog_cpp::MessageFormat> format;
         uint8_t multiId{0};
         std::string topicName;
+        std::vector<FieldColumn> columns;   ///< Resolved on the first data message
+        bool columnsResolved{false};
+        bool hasTimestamp{false};
+        bool hasUtcTime{false};
     };
 
+    void _resolveColumns(SubscriptionInfo &sub);
+    void _appendSample(FieldColumn &column, double timestampSecs, double value);
+    void _detectVehicleType();
+    void _buildModeSegments();
+    void _buildFieldLists();
+
     std::map<std::string, std::shared_ptr<ulog_cpp::MessageFormat>> _formats;
     std::map<uint16_t, SubscriptionInfo> _subscriptions;
     QSet<QString> _fieldSet;
@@ -62,6 +96,9 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
     // Map of parameter name -> default value (system default, from ParameterDefault messages)
     QHash<QString, double> _paramDefaults;
     double _lastTimestampSecs{-1.0};
+    qsizetype _maxSamplesPerField{0};
+    quint64 _samplesGeneration{1};  ///< Bumped when fieldSamples may have moved (rehash, result handed out)
+    bool _fieldListsDirty{false};
     bool _hadFatalError{false};
     bool _headerComplete{false};
 };
@@ -0,0 +1,81 @@
+#include "ULogStreamDecoder.h"
+#include "QGCLoggingCategory.h"
+#include "ULogFullHandler.h"
+
+#include <ulog_cpp/reader.hpp>
+
+QGC_LOGGING_CATEGORY(ULogStreamDecoderLog, "AnalyzeView.ULogStreamDecoder")
+
+ULogStreamDecoder::ULogStreamDecoder(QObject *parent)
+    : QObject(parent)
+    , _handler(std::make_shared<ULogFullHandler>(_result))
+    , _reader(std::make_unique<ulog_cpp::Reader>(_handler))
+{
+    qCDebug(ULogStreamDecoderLog) << this;
+
+    _handler->setMaxSamplesPerField(kDefaultMaxSamplesPerField);
+
+    _updateTimer.setSingleShot(true);
+    _updateTimer.setInterval(kUpdateIntervalMs);
+    (void) connect(&_updateTimer, &QTimer::timeout, this, &ULogStreamDecoder::_publish);
+}
+
+ULogStreamDecoder::~ULogStreamDecoder()
+{
+    qCDebug(ULogStreamDecoderLog) << this;
+}
+
+void ULogStreamDecoder::setMaxSamplesPerField(qsizetype maxSamples)
+{
+    _handler->setMaxSamplesPerField(maxSamples);
+}
+
+bool ULogStreamDecoder::hadFatalError() const
+{
+    return _handler->hadFatalError();
+}
+
+void ULogStreamDecoder::feed(const char *data, qsizetype size)
+{
+    if (_finished || (size <= 0) || _handler->hadFatalError()) {
+        return;
+    }
+
+    _reader->readChunk(reinterpret_cast<const uint8_t *>(data), static_cast<size_t>(size));
+    _bytesDecoded += size;
+
+    if (_handler->hadFatalError()) {
+        qCWarning(ULogStreamDecoderLog) << "Live decoding stopped:" << _result.errorMessage;
+    }
+
+    // Coalesce updates, a vehicle sends LOGGING_DATA hundreds of times per second
+    if (!_updateTimer.isActive()) {
+        _updateTimer.start();
+    }
+}
+
+void ULogStreamDecoder::finish()
+{
+    if (_finished) {
+        return;
+    }
+
+    _updateTimer.stop();
+    if (_handler->isHeaderComplete() && !_handler->hadFatalError()) {
+        _handler->finalize();
+    } else {
+        _handler->refresh();
+    }
+
+    _finished = true;
+    qCDebug(ULogStreamDecoderLog) << "Finished after" << _bytesDecoded << "bytes," << _result.sampleCount << "messages";
+
+    emit updated();
+    emit finishedChanged();
+}
+
+void ULogStreamDecoder::_publish()
+{
+    _handler->refresh();
+    emit updated();
+}
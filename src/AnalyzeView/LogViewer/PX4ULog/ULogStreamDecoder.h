@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LogParseResultPrivate.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+#include <memory>
+
+namespace ulog_cpp {
+class Reader;
+}
+
+class ULogFullHandler;
+
+/// \brief Incremental decoder for a ULog byte stream which is still being written.
+///
+/// Fed with the log bytes as they arrive (MAVLinkLogProcessor passes everything it writes to the
+/// .ulg file), so an in-progress MAVLink log can be inspected without stopping it and re-parsing
+/// the file. Samples land in append-only per-field columns (result().fieldSamples) which
+/// LogFileParser reads in place while attached.
+///
+/// Memory is bounded by maxSamplesPerField: a column reaching the cap is thinned 2:1 and keeps
+/// every other sample from then on, so a long flight keeps its full time range at lower density.
+///
+class ULogStreamDecoder : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+    Q_PROPERTY(qint64 bytesDecoded READ bytesDecoded NOTIFY updated)
+    Q_PROPERTY(bool   finished     READ finished     NOTIFY finishedChanged)
+
+public:
+    static constexpr qsizetype kDefaultMaxSamplesPerField = 100000;
+    static constexpr int kUpdateIntervalMs = 500;
+
+    explicit ULogStreamDecoder(QObject *parent = nullptr);
+    ~ULogStreamDecoder() override;
+
+    void setMaxSamplesPerField(qsizetype maxSamples);
+
+    /// Decodes the next bytes of the stream. Message boundaries do not need to line up with the calls.
+    void feed(const char *data, qsizetype size);
+
+    /// No more data will arrive. Completes parameter defaults and publishes the final state.
+    void finish();
+
+    /// Decoded state so far, refreshed every kUpdateIntervalMs while data arrives
+    const LogParseResult &result() const { return _result; }
+
+    qint64 bytesDecoded() const { return _bytesDecoded; }
+    bool finished() const { return _finished; }
+    bool hadFatalError() const;
+
+signals:
+    /// New samples were decoded, emitted at most every kUpdateIntervalMs
+    void updated();
+    void finishedChanged();
+
+private:
+    void _publish();
+
+    LogParseResult _result;
+    std::shared_ptr<ULogFullHandler> _handler;
+    std::unique_ptr<ulog_cpp::Reader> _reader;
+    QTimer _updateTimer;
+    qint64 _bytesDecoded = 0;
+    bool _finished = false;
+};
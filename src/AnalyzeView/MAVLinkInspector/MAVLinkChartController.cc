@@ -11,18 +11,56 @@ static constexpr qreal kMinDelta = 1e-6;
 
 QGC_LOGGING_CATEGORY(MAVLinkChartControllerLog, "AnalyzeView.MAVLinkChartController")
 
+QList<MAVLinkChartController*> MAVLinkChartController::_refreshClockCharts;
+QTimer *MAVLinkChartController::_refreshClockTimer = nullptr;
+
 MAVLinkChartController::MAVLinkChartController(QObject *parent)
     : QObject(parent)
-    , _updateSeriesTimer(new QTimer(this))
 {
     // qCDebug(MAVLinkChartControllerLog) << Q_FUNC_INFO << this;
-
-    (void) connect(_updateSeriesTimer, &QTimer::timeout, this, &MAVLinkChartController::_refreshSeries);
 }
 
 MAVLinkChartController::~MAVLinkChartController()
 {
     // qCDebug(MAVLinkChartControllerLog) << Q_FUNC_INFO << this;
+
+    _removeFromRefreshClock(this);
+}
+
+void MAVLinkChartController::_addToRefreshClock(MAVLinkChartController *chart)
+{
+    if (_refreshClockCharts.contains(chart)) {
+        return;
+    }
+
+    _refreshClockCharts.append(chart);
+    if (!_refreshClockTimer) {
+        _refreshClockTimer = new QTimer();
+        _refreshClockTimer->setTimerType(Qt::CoarseTimer);
+        (void) connect(_refreshClockTimer, &QTimer::timeout, &MAVLinkChartController::_refreshClockTick);
+        _refreshClockTimer->start(kUpdateFrequency);
+    }
+}
+
+void MAVLinkChartController::_removeFromRefreshClock(MAVLinkChartController *chart)
+{
+    if (!_refreshClockCharts.removeOne(chart)) {
+        return;
+    }
+
+    if (_refreshClockCharts.isEmpty() && _refreshClockTimer) {
+        _refreshClockTimer->stop();
+        _refreshClockTimer->deleteLater();
+        _refreshClockTimer = nullptr;
+    }
+}
+
+void MAVLinkChartController::_refreshClockTick()
+{
+    const qreal now = qgcApp()->msecsSinceBoot();
+    for (MAVLinkChartController *chart : std::as_const(_refreshClockCharts)) {
+        chart->_refreshSeries(now);
+    }
 }
 
 void MAVLinkChartController::setInspectorController(MAVLinkInspectorController *controller)
@@ -80,10 +118,15 @@ void MAVLinkChartController::setRangeXIndex(quint32 index)
     emit rangeXIndexChanged();
 
     updateXRange();
-    _resetFieldBucketing();
+    _resetFieldWindows();
 }
 
 void MAVLinkChartController::updateXRange()
+{
+    _setXRange(qgcApp()->msecsSinceBoot());
+}
+
+void MAVLinkChartController::_setXRange(qreal nowMs)
 {
     if (!_inspectorController) {
         return;
@@ -93,7 +136,7 @@ void MAVLinkChartController::updateXRange()
         return;
     }
 
-    const qint64 bootTime = static_cast<qint64>(qgcApp()->msecsSinceBoot());
+    const qint64 bootTime = static_cast<qint64>(nowMs);
     _rangeXMax = static_cast<qreal>(bootTime);
     emit rangeXMaxChanged();
 
@@ -142,15 +185,15 @@ void MAVLinkChartController::updateYRange()
     }
 }
 
-void MAVLinkChartController::_refreshSeries()
+void MAVLinkChartController::_refreshSeries(qreal nowMs)
 {
-    updateXRange();
+    _setXRange(nowMs);
 
     for (QVariant &field : _chartFields) {
         QObject *const object = qvariant_cast<QObject*>(field);
         QGCMAVLinkMessageField *const pField = qobject_cast<QGCMAVLinkMessageField*>(object);
         if(pField) {
-            pField->updateSeries();
+            pField->updateSeries(nowMs);
         }
     }
 
@@ -176,7 +219,7 @@ void MAVLinkChartController::addSeries(QGCMAVLinkMessageField *field, QAbstractS
     field->addSeries(this, series);
     emit chartFieldsChanged();
 
-    _updateSeriesTimer->start(kUpdateFrequency);
+    _addToRefreshClock(this);
 }
 
 void MAVLinkChartController::delSeries(QGCMAVLinkMessageField *field)
@@ -195,7 +238,7 @@ void MAVLinkChartController::delSeries(QGCMAVLinkMessageField *field)
 
         if (_chartFields.isEmpty()) {
             updateXRange();
-            _updateSeriesTimer->stop();
+            _removeFromRefreshClock(this);
         }
     }
 }
@@ -208,21 +251,21 @@ void MAVLinkChartController::setPlotPixelWidth(int width)
 
     _plotPixelWidth = width;
     emit plotPixelWidthChanged();
-    _resetFieldBucketing();
+    _resetFieldWindows();
 }
 
-void MAVLinkChartController::_resetFieldBucketing()
+void MAVLinkChartController::_resetFieldWindows()
 {
     if (_plotPixelWidth <= 0) {
         return;
     }
 
-    const qreal bucketWidthMs = rangeXMs() / _plotPixelWidth;
+    const qreal rangeMs = rangeXMs();
     for (const QVariant &field : _chartFields) {
         QObject *const object = qvariant_cast<QObject*>(field);
         QGCMAVLinkMessageField *const pField = qobject_cast<QGCMAVLinkMessageField*>(object);
         if (pField) {
-            pField->resetBucketing(_plotPixelWidth, bucketWidthMs);
+            pField->setChartWindow(_plotPixelWidth, rangeMs);
         }
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 #include <QtQmlIntegration/QtQmlIntegration>
@@ -55,6 +56,9 @@ class MAVLinkChartController : public QObject
     void updateXRange();
     void updateYRange();
 
+    /// Number of charts currently driven by the shared refresh clock
+    static int refreshClockChartCount() { return static_cast<int>(_refreshClockCharts.size()); }
+
 signals:
     void chartFieldsChanged();
     void rangeXMinChanged();
@@ -65,14 +69,21 @@ class MAVLinkChartController : public QObject
     void rangeXIndexChanged();
     void plotPixelWidthChanged();
 
-private slots:
-    void _refreshSeries();
-
 private:
-    void _resetFieldBucketing();
+    void _refreshSeries(qreal nowMs);
+    void _setXRange(qreal nowMs);
+    void _resetFieldWindows();
+
+    /// All open charts are refreshed from one timer, in the same pass and against the same time stamp
+    static void _addToRefreshClock(MAVLinkChartController *chart);
+    static void _removeFromRefreshClock(MAVLinkChartController *chart);
+    static void _refreshClockTick();
+
+    static QList<MAVLinkChartController*> _refreshClockCharts;
+    static QTimer *_refreshClockTimer;
+
     int _chartIndex = 0;
     MAVLinkInspectorController *_inspectorController = nullptr;
-    QTimer *_updateSeriesTimer = nullptr;
 
     qreal _rangeXMin = 0;
     qreal _rangeXMax = 0;
@@ -0,0 +1,186 @@
+#include "MAVLinkChartData.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr qreal kMinDelta = 1e-6;
+
+void MAVLinkChartData::SeriesUpdate::applyTo(QList<QPointF> &points) const
+{
+    if (reset) {
+        points.clear();
+    }
+
+    const qsizetype back = std::min<qsizetype>(removeBack, points.size());
+    points.remove(points.size() - back, back);
+    points.remove(0, std::min<qsizetype>(removeFront, points.size()));
+    points.append(append);
+}
+
+MAVLinkChartData::MAVLinkChartData(int capacity)
+    : _time(static_cast<size_t>(std::max(1, capacity)))
+    , _value(static_cast<size_t>(std::max(1, capacity)))
+{
+}
+
+void MAVLinkChartData::setWindow(int pixelWidth, qreal rangeMs)
+{
+    if ((pixelWidth <= 0) || (rangeMs <= 0)) {
+        _pixelWidth = 0;
+        _columnWidthMs = 0;
+        _resetColumns();
+        return;
+    }
+
+    _pixelWidth = pixelWidth;
+    _columnWidthMs = rangeMs / pixelWidth;
+    _columnIndex.assign(static_cast<size_t>(pixelWidth), 0);
+    _columnMin.assign(static_cast<size_t>(pixelWidth), 0);
+    _columnMax.assign(static_cast<size_t>(pixelWidth), 0);
+    _resetColumns();
+
+    // Replay the retained history into the new layout, oldest first
+    const int cap = capacity();
+    int slot = (_sampleHead - _sampleCount + cap) % cap;
+    for (int i = 0; i < _sampleCount; i++) {
+        _decimate(_time[slot], _value[slot]);
+        slot = (slot + 1) % cap;
+    }
+}
+
+void MAVLinkChartData::append(qreal timeMs, qreal value)
+{
+    _time[_sampleHead] = timeMs;
+    _value[_sampleHead] = value;
+    _sampleHead = (_sampleHead + 1) % capacity();
+    _sampleCount = std::min(_sampleCount + 1, capacity());
+
+    _decimate(timeMs, value);
+}
+
+void MAVLinkChartData::clear()
+{
+    _sampleHead = 0;
+    _sampleCount = 0;
+    _resetColumns();
+    _rangeMin = std::numeric_limits<qreal>::max();
+    _rangeMax = std::numeric_limits<qreal>::lowest();
+}
+
+void MAVLinkChartData::_resetColumns()
+{
+    _columnHead = 0;
+    _columnCount = 0;
+    _openIndex = -1;
+    _resetPending = true;
+    _pendingColumns = 0;
+    _evictedColumns = 0;
+    _publishedTail = 0;
+}
+
+void MAVLinkChartData::_decimate(qreal timeMs, qreal value)
+{
+    if (_pixelWidth <= 0) {
+        return;
+    }
+
+    const qint64 index = static_cast<qint64>(std::floor(timeMs / _columnWidthMs));
+    if (_openIndex < 0) {
+        _openIndex = index;
+        _openMin = value;
+        _openMax = value;
+        return;
+    }
+
+    if (index <= _openIndex) {
+        // Same column, or a late sample which is folded into the current one
+        _openMin = std::min(_openMin, value);
+        _openMax = std::max(_openMax, value);
+        return;
+    }
+
+    _commitOpenColumn();
+    _openIndex = index;
+    _openMin = value;
+    _openMax = value;
+
+    // Drop columns which are now more than a chart width behind
+    while ((_columnCount > 0) && (_columnIndex[_columnHead] <= (index - _pixelWidth))) {
+        if ((_columnCount - _pendingColumns) > 0) {
+            _evictedColumns++;
+        } else {
+            _pendingColumns--;
+        }
+        _columnHead = (_columnHead + 1) % _pixelWidth;
+        _columnCount--;
+    }
+}
+
+void MAVLinkChartData::_commitOpenColumn()
+{
+    // Columns older than the open one are evicted when it opened, so there is always a free slot
+    const int slot = _columnSlot(_columnCount);
+    _columnIndex[slot] = _openIndex;
+    _columnMin[slot] = _openMin;
+    _columnMax[slot] = _openMax;
+    _columnCount++;
+    _pendingColumns++;
+}
+
+MAVLinkChartData::SeriesUpdate MAVLinkChartData::takeUpdate(qreal nowMs)
+{
+    SeriesUpdate update;
+    update.reset = _resetPending;
+
+    int first = 0;
+    if (!_resetPending) {
+        update.removeBack = _publishedTail;
+        update.removeFront = _evictedColumns * 2;
+        first = _columnCount - _pendingColumns;
+    }
+
+    update.append.reserve(((_columnCount - first) * 2) + 2);
+    for (int i = first; i < _columnCount; i++) {
+        const int slot = _columnSlot(i);
+        const qreal midTime = (static_cast<qreal>(_columnIndex[slot]) + 0.5) * _columnWidthMs;
+        update.append.append(QPointF(midTime, _columnMin[slot]));
+        update.append.append(QPointF(midTime, _columnMax[slot]));
+    }
+
+    // The in-progress column always follows the latest data
+    _publishedTail = 0;
+    if (_openIndex >= 0) {
+        update.append.append(QPointF(nowMs, _openMin));
+        _publishedTail++;
+        if (std::abs(_openMax - _openMin) > kMinDelta) {
+            update.append.append(QPointF(nowMs, _openMax));
+            _publishedTail++;
+        }
+    }
+
+    _resetPending = false;
+    _pendingColumns = 0;
+    _evictedColumns = 0;
+
+    _updateRange();
+
+    return update;
+}
+
+void MAVLinkChartData::_updateRange()
+{
+    qreal vmin = std::numeric_limits<qreal>::max();
+    qreal vmax = std::numeric_limits<qreal>::lowest();
+    for (int i = 0; i < _columnCount; i++) {
+        const int slot = _columnSlot(i);
+        vmin = std::min(vmin, _columnMin[slot]);
+        vmax = std::max(vmax, _columnMax[slot]);
+    }
+    if (_openIndex >= 0) {
+        vmin = std::min(vmin, _openMin);
+        vmax = std::max(vmax, _openMax);
+    }
+
+    _rangeMin = vmin;
+    _rangeMax = vmax;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+
+#include <limits>
+#include <vector>
+
+/// Sample store and decimator behind one charted MAVLink message field.
+///
+/// Samples are kept at source rate in a fixed capacity ring buffer (times and values in separate arrays), so changing
+/// the time scale or resizing the chart re-decimates the retained history instead of starting over. As samples arrive
+/// they are folded into per-pixel min/max columns covering the visible time range. The chart is fed through
+/// takeUpdate(), which only describes what changed since the previous call: columns which scrolled out at the front,
+/// columns committed since, and the in-progress column at the tail.
+class MAVLinkChartData
+{
+public:
+    static constexpr int kDefaultCapacity = 32768;  ///< ~5 minutes at 100Hz
+
+    /// Edit to bring a series in sync with the decimated data. Applied in order: clear (when reset), drop removeBack
+    /// points from the end, drop removeFront points from the start, then append.
+    struct SeriesUpdate {
+        bool reset = false;
+        int removeFront = 0;
+        int removeBack = 0;
+        QList<QPointF> append;
+
+        bool isEmpty() const { return !reset && (removeFront == 0) && (removeBack == 0) && append.isEmpty(); }
+        void applyTo(QList<QPointF> &points) const;
+    };
+
+    explicit MAVLinkChartData(int capacity = kDefaultCapacity);
+
+    /// Sets the column layout, @p pixelWidth columns spanning @p rangeMs, and re-decimates the retained samples
+    void setWindow(int pixelWidth, qreal rangeMs);
+    void append(qreal timeMs, qreal value);
+    void clear();
+
+    /// Returns the changes since the previous call. The in-progress column is placed at @p nowMs.
+    SeriesUpdate takeUpdate(qreal nowMs);
+
+    int capacity() const { return static_cast<int>(_time.size()); }
+    int sampleCount() const { return _sampleCount; }
+    int pixelWidth() const { return _pixelWidth; }
+    /// Committed columns, not counting the in-progress one
+    int columnCount() const { return _columnCount; }
+
+    /// Value range of the decimated data as of the last takeUpdate(), max()/lowest() when there is none
+    qreal rangeMin() const { return _rangeMin; }
+    qreal rangeMax() const { return _rangeMax; }
+
+private:
+    void _decimate(qreal timeMs, qreal value);
+    void _commitOpenColumn();
+    void _resetColumns();
+    void _updateRange();
+    int _columnSlot(int i) const { return (_columnHead + i) % _pixelWidth; }
+
+    // Source rate samples
+    std::vector<qreal> _time;
+    std::vector<qreal> _value;
+    int _sampleHead = 0;            ///< Next write position
+    int _sampleCount = 0;
+
+    // Per-pixel min/max columns, ring of _pixelWidth entries
+    int _pixelWidth = 0;
+    qreal _columnWidthMs = 0;
+    std::vector<qint64> _columnIndex;
+    std::vector<qreal> _columnMin;
+    std::vector<qreal> _columnMax;
+    int _columnHead = 0;            ///< Oldest column
+    int _columnCount = 0;
+
+    qint64 _openIndex = -1;         ///< Column currently being filled, -1 when none
+    qreal _openMin = 0;
+    qreal _openMax = 0;
+
+    // What the series holds: [published columns, two points each][_publishedTail points of the open column]
+    bool _resetPending = true;
+    int _pendingColumns = 0;        ///< Newest committed columns not yet sent
+    int _evictedColumns = 0;        ///< Sent columns dropped from the ring since the last update
+    int _publishedTail = 0;
+
+    qreal _rangeMin = std::numeric_limits<qreal>::max();
+    qreal _rangeMax = std::numeric_limits<qreal>::lowest();
+};
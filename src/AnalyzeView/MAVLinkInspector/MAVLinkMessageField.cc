@@ -1,16 +1,16 @@
 #include "MAVLinkMessageField.h"
 #include "MAVLinkChartController.h"
 #include "MAVLinkMessage.h"
+#include "MessageRateController.h"
+#include "MultiVehicleManager.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
+#include "Vehicle.h"
 
 #include <QtGraphs/QLineSeries>
 #include <QtGraphs/QAbstractSeries>
 
 #include <algorithm>
-#include <cmath>
-
-static constexpr qreal kMinDelta = 1e-6;
 
 QGC_LOGGING_CATEGORY(MAVLinkMessageFieldLog, "AnalyzeView.MAVLinkMessageField")
 
@@ -40,11 +40,15 @@ void QGCMAVLinkMessageField::addSeries(MAVLinkChartController *chartController,
     _pSeries = series;
     emit seriesChanged();
 
-    _dataIndex = 0;
-    _bucketCount = std::max(1, chartController->plotPixelWidth());
-    _bucketWidthMs = chartController->rangeXMs() / _bucketCount;
-    _currentBucketStart = -1;
+    _chartData = std::make_unique<MAVLinkChartData>();
+    _chartData->setWindow(std::max(1, chartController->plotPixelWidth()), chartController->rangeXMs());
     _msg->updateFieldSelection();
+
+    // A charted message is wanted at the rate the vehicle sends it, not at the rate the instruments show it
+    Vehicle *const vehicle = MultiVehicleManager::instance()->getVehicleById(_msg->sysId());
+    if (vehicle) {
+        vehicle->messageRateController()->requestRate(this, _msg->id(), MessageRateController::kFullRateHz);
+    }
 }
 
 void QGCMAVLinkMessageField::delSeries()
@@ -53,32 +57,25 @@ void QGCMAVLinkMessageField::delSeries()
         return;
     }
 
-    _values.clear();
-    _rangeMin = std::numeric_limits<qreal>::max();
-    _rangeMax = std::numeric_limits<qreal>::lowest();
     QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    lineSeries->replace(_values);
+    lineSeries->clear();
+    _chartData.reset();
     _pSeries = nullptr;
     _chartController = nullptr;
-    _bucketCount = 0;
-    _bucketWidthMs = 0;
-    _currentBucketStart = -1;
-    _dataIndex = 0;
     emit seriesChanged();
     _msg->updateFieldSelection();
+
+    Vehicle *const vehicle = MultiVehicleManager::instance()->getVehicleById(_msg->sysId());
+    if (vehicle) {
+        vehicle->messageRateController()->releaseRate(this, _msg->id());
+    }
 }
 
-void QGCMAVLinkMessageField::resetBucketing(int bucketCount, qreal bucketWidthMs)
+void QGCMAVLinkMessageField::setChartWindow(int pixelWidth, qreal rangeMs)
 {
-    _bucketCount = std::max(1, bucketCount);
-    _bucketWidthMs = bucketWidthMs;
-    _currentBucketStart = -1;
-    _currentBucketMin = 0;
-    _currentBucketMax = 0;
-    _dataIndex = 0;
-    _values.clear();
-    _rangeMin = std::numeric_limits<qreal>::max();
-    _rangeMax = std::numeric_limits<qreal>::lowest();
+    if (_chartData) {
+        _chartData->setWindow(std::max(1, pixelWidth), rangeMs);
+    }
 }
 
 QString QGCMAVLinkMessageField::label() const
@@ -110,146 +107,41 @@ void QGCMAVLinkMessageField::updateValue(const QString &newValue, qreal v)
         emit valueChanged();
     }
 
-    if (!_pSeries || !_chartController || _bucketCount <= 0) {
-        return;
+    // Only record the sample here, decimation into columns is incremental and the series and Y range are
+    // brought up to date on the shared chart refresh clock
+    if (_chartData) {
+        _chartData->append(qgcApp()->msecsSinceBoot(), v);
     }
+}
 
-    const qreal now = qgcApp()->msecsSinceBoot();
-
-    if (_currentBucketStart < 0) {
-        // First sample — start first bucket
-        _currentBucketStart = now;
-        _currentBucketMin = v;
-        _currentBucketMax = v;
-        if (_chartController->rangeYIndex() == 0) {
-            bool changed = false;
-            if (std::abs(_rangeMin - v) > kMinDelta) {
-                _rangeMin = v;
-                changed = true;
-            }
-            if (std::abs(_rangeMax - v) > kMinDelta) {
-                _rangeMax = v;
-                changed = true;
-            }
-            if (changed) {
-                _chartController->updateYRange();
-            }
-        }
+void QGCMAVLinkMessageField::updateSeries(qreal nowMs)
+{
+    if (!_pSeries || !_chartData) {
         return;
     }
 
-    if (now < _currentBucketStart + _bucketWidthMs) {
-        // Still in current bucket — update min/max
-        _currentBucketMin = std::min(_currentBucketMin, v);
-        _currentBucketMax = std::max(_currentBucketMax, v);
-        if (_chartController->rangeYIndex() == 0) {
-            bool changed = false;
-            if (v < _rangeMin - kMinDelta) {
-                _rangeMin = v;
-                changed = true;
-            }
-            if (v > _rangeMax + kMinDelta) {
-                _rangeMax = v;
-                changed = true;
-            }
-            if (changed) {
-                _chartController->updateYRange();
-            }
-        }
+    const MAVLinkChartData::SeriesUpdate update = _chartData->takeUpdate(nowMs);
+    if (update.isEmpty()) {
         return;
     }
 
-    // Crossed into next bucket — commit current bucket
-    _commitBucket();
-
-    // Start new bucket with this sample
-    _currentBucketStart = now;
-    _currentBucketMin = v;
-    _currentBucketMax = v;
-
-    // Update Y auto-range from committed data and current bucket
-    if (_chartController->rangeYIndex() != 0) {
+    QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
+    if (update.reset) {
+        lineSeries->replace(update.append);
         return;
     }
 
-    qreal vmin = _currentBucketMin;
-    qreal vmax = _currentBucketMax;
-    for (const QPointF &point : _values) {
-        vmin = std::min(vmin, point.y());
-        vmax = std::max(vmax, point.y());
+    // Only the tail changes between refreshes: the previous in-progress points, columns that scrolled out at the
+    // front and the columns committed since
+    if (update.removeBack > 0) {
+        const qsizetype count = lineSeries->count();
+        const qsizetype back = std::min<qsizetype>(update.removeBack, count);
+        lineSeries->removeMultiple(count - back, back);
     }
-
-    bool changed = false;
-    if (std::abs(_rangeMin - vmin) > kMinDelta) {
-        _rangeMin = vmin;
-        changed = true;
-    }
-
-    if (std::abs(_rangeMax - vmax) > kMinDelta) {
-        _rangeMax = vmax;
-        changed = true;
+    if (update.removeFront > 0) {
+        lineSeries->removeMultiple(0, std::min<qsizetype>(update.removeFront, lineSeries->count()));
     }
-
-    if (changed) {
-        _chartController->updateYRange();
+    if (!update.append.isEmpty()) {
+        lineSeries->append(update.append);
     }
 }
-
-void QGCMAVLinkMessageField::_commitBucket()
-{
-    const qreal bucketMidTime = _currentBucketStart + _bucketWidthMs * 0.5;
-    const int maxPoints = _bucketCount * 2;
-
-    // Append min and max points for this bucket (always two points to keep capacity predictable)
-    const int count = _values.count();
-    if (count < maxPoints) {
-        _values.append(QPointF(bucketMidTime, _currentBucketMin));
-        _values.append(QPointF(bucketMidTime, _currentBucketMax));
-    } else {
-        // Ring buffer wrap
-        if (_dataIndex >= maxPoints) {
-            _dataIndex = 0;
-        }
-        _values[_dataIndex] = QPointF(bucketMidTime, _currentBucketMin);
-        _dataIndex++;
-        if (_dataIndex >= maxPoints) {
-            _dataIndex = 0;
-        }
-        _values[_dataIndex] = QPointF(bucketMidTime, _currentBucketMax);
-        _dataIndex++;
-    }
-}
-
-void QGCMAVLinkMessageField::updateSeries()
-{
-    const int count = _values.count();
-
-    QList<QPointF> s;
-    s.reserve(count + 2);
-    int idx = _dataIndex;
-    for (int i = 0; i < count; i++, idx++) {
-        if (idx >= count) {
-            idx = 0;
-        }
-
-        const QPointF p(_values[idx]);
-        s.append(p);
-    }
-
-    // Append the in-progress bucket so the chart always shows the latest data
-    if (_currentBucketStart >= 0) {
-        const qreal now = qgcApp()->msecsSinceBoot();
-        s.append(QPointF(now, _currentBucketMin));
-        if (std::abs(_currentBucketMax - _currentBucketMin) > kMinDelta) {
-            s.append(QPointF(now, _currentBucketMax));
-        }
-    }
-
-    QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    if (s.isEmpty()) {
-        lineSeries->clear();
-        return;
-    }
-
-    lineSeries->replace(s);
-}
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <QtCore/QObject>
-#include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include <limits>
+#include <memory>
+
+#include "MAVLinkChartData.h"
 
 class QGCMAVLinkMessage;
 class MAVLinkChartController;
@@ -35,18 +37,21 @@ class QGCMAVLinkMessageField : public QObject
     bool selectable() const { return _selectable; }
     bool selected() const { return !!_pSeries; }
     const QAbstractSeries *series() const { return _pSeries; }
-    const QList<QPointF> *values() const { return &_values; }
-    qreal rangeMin() const { return _rangeMin; }
-    qreal rangeMax() const { return _rangeMax; }
+    /// Decimated chart data, null when the field is not charted
+    const MAVLinkChartData *chartData() const { return _chartData.get(); }
+    qreal rangeMin() const { return _chartData ? _chartData->rangeMin() : std::numeric_limits<qreal>::max(); }
+    qreal rangeMax() const { return _chartData ? _chartData->rangeMax() : std::numeric_limits<qreal>::lowest(); }
     int chartIndex() const;
 
     void setSelectable(bool sel);
     void updateValue(const QString &newValue, qreal v);
-    void resetBucketing(int bucketCount, qreal bucketWidthMs);
+    /// Re-decimates the retained samples to @p pixelWidth columns spanning @p rangeMs
+    void setChartWindow(int pixelWidth, qreal rangeMs);
 
     void addSeries(MAVLinkChartController *chartController, QAbstractSeries *series);
     void delSeries();
-    void updateSeries();
+    /// Applies the data changed since the previous call to the series
+    void updateSeries(qreal nowMs);
 
 signals:
     void seriesChanged();
@@ -54,23 +59,13 @@ class QGCMAVLinkMessageField : public QObject
     void valueChanged();
 
 private:
-    void _commitBucket();
-
     QString _type;
     QString _name;
     QGCMAVLinkMessage *_msg = nullptr;
 
     QString _value;
     bool _selectable = true;
-    int _dataIndex = 0;
-    int _bucketCount = 0;
-    qreal _bucketWidthMs = 0;
-    qreal _currentBucketStart = -1;
-    qreal _currentBucketMin = 0;
-    qreal _currentBucketMax = 0;
-    qreal _rangeMin = std::numeric_limits<qreal>::max();
-    qreal _rangeMax = std::numeric_limits<qreal>::lowest();
-    QList<QPointF> _values;
+    std::unique_ptr<MAVLinkChartData> _chartData;
 
     QAbstractSeries *_pSeries = nullptr;
     MAVLinkChartController *_chartController = nullptr;
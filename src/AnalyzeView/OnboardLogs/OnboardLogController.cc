@@ -1,10 +1,10 @@
 #include "OnboardLogController.h"
 #include "AppSettings.h"
+#include "OnboardLogDownloader.h"
 #include "OnboardLogEntry.h"
 #include "MAVLinkLib.h"
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
-#include "ParameterManager.h"
 #include "QGCFormat.h"
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
@@ -49,32 +49,82 @@ void OnboardLogController::_downloadToDirectory(const QString &dir)
 {
     _receivedAllEntries();
 
-    _downloadData.reset();
+    QString downloadPath = dir;
+    if (downloadPath.isEmpty() || !_vehicle) {
+        return;
+    }
+
+    if (!downloadPath.endsWith(QDir::separator())) {
+        downloadPath += QDir::separator();
+    }
+
+    OnboardLogDownloader *downloader = _downloader(_vehicle);
+    while (QGCOnboardLogEntry *const entry = _getNextSelected()) {
+        if (!downloader) {
+            downloader = new OnboardLogDownloader(_vehicle, _apmOffset, downloadPath, this);
+            (void) connect(downloader, &OnboardLogDownloader::rateChanged, this, &OnboardLogController::_updateDownloadRate);
+            (void) connect(downloader, &OnboardLogDownloader::finished, this, &OnboardLogController::_downloaderFinished);
+            _downloaders.append(downloader);
+            _updateDownloading();
+        }
+
+        // Deselects the entry, a finished downloader removes itself from _downloaders
+        downloader->enqueue(entry);
+        if (!_downloaders.contains(downloader)) {
+            downloader = nullptr;
+        }
+    }
+
+    emit selectionChanged();
+}
+
+OnboardLogDownloader *OnboardLogController::_downloader(const Vehicle *vehicle) const
+{
+    for (OnboardLogDownloader *const downloader : _downloaders) {
+        if (downloader->vehicle() == vehicle) {
+            return downloader;
+        }
+    }
+
+    return nullptr;
+}
 
-    _downloadPath = dir;
-    if (_downloadPath.isEmpty()) {
+void OnboardLogController::_downloaderFinished()
+{
+    OnboardLogDownloader *const downloader = qobject_cast<OnboardLogDownloader*>(sender());
+    if (!downloader || !_downloaders.removeOne(downloader)) {
         return;
     }
 
-    if (!_downloadPath.endsWith(QDir::separator())) {
-        _downloadPath += QDir::separator();
+    (void) disconnect(downloader, nullptr, this, nullptr);
+    downloader->deleteLater();
+
+    _updateDownloading();
+    _updateDownloadRate();
+}
+
+void OnboardLogController::_updateDownloadRate()
+{
+    qreal rate = 0.;
+    for (const OnboardLogDownloader *const downloader : std::as_const(_downloaders)) {
+        rate += downloader->rate();
     }
 
-    QGCOnboardLogEntry *const log = _getNextSelected();
-    if (log) {
-        log->setStatus(tr("Waiting"));
+    if (rate != _downloadRate) {
+        _downloadRate = rate;
+        emit downloadRateChanged();
     }
+}
 
-    _setDownloading(true);
-    _receivedAllData();
+QString OnboardLogController::downloadRateStr() const
+{
+    return QStringLiteral("%1/s").arg(QGC::bigSizeToString(static_cast<quint64>(_downloadRate)));
 }
 
 void OnboardLogController::_processDownload()
 {
     if (_requestingLogEntries) {
         _findMissingEntries();
-    } else if (_downloadingLogs) {
-        _findMissingData();
     }
 }
 
@@ -134,18 +184,19 @@ void OnboardLogController::_setActiveVehicle(Vehicle *vehicle)
         return;
     }
 
+    // Downloads of the previous vehicle continue in the background
     if (_vehicle) {
         _logEntriesModel->clearAndDeleteContents();
         (void) disconnect(_vehicle, &Vehicle::logEntry, this, &OnboardLogController::_logEntry);
-        (void) disconnect(_vehicle, &Vehicle::logData,  this, &OnboardLogController::_logData);
     }
 
     _vehicle = vehicle;
 
     if (_vehicle) {
         (void) connect(_vehicle, &Vehicle::logEntry, this, &OnboardLogController::_logEntry);
-        (void) connect(_vehicle, &Vehicle::logData,  this, &OnboardLogController::_logData);
     }
+
+    _updateDownloading();
 }
 
 void OnboardLogController::_logEntry(uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t last_log_num)
@@ -218,230 +269,6 @@ bool OnboardLogController::_entriesComplete() const
     return true;
 }
 
-void OnboardLogController::_logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data)
-{
-    if (!_downloadingLogs || !_downloadData) {
-        return;
-    }
-
-    id -= _apmOffset;
-    if (_downloadData->ID != id) {
-        qCWarning(OnboardLogControllerLog) << "Received log data for wrong log";
-        return;
-    }
-
-    if ((ofs % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0) {
-        qCWarning(OnboardLogControllerLog) << "Ignored misaligned incoming packet @" << ofs;
-        return;
-    }
-
-    bool result = false;
-    if (ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / OnboardLogDownloadData::kChunkSize;
-        // qCDebug(OnboardLogControllerLog) << "Received data - Offset:" << ofs << "Chunk:" << chunk;
-        if (chunk != _downloadData->current_chunk) {
-            qCWarning(OnboardLogControllerLog) << "Ignored packet for out of order chunk actual:expected" << chunk << _downloadData->current_chunk;
-            return;
-        }
-
-        const uint16_t bin = (ofs - (chunk * OnboardLogDownloadData::kChunkSize)) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qCWarning(OnboardLogControllerLog) << "Out of range bin received";
-        } else {
-            _downloadData->chunk_table.setBit(bin);
-        }
-
-        if (_downloadData->file.pos() != ofs) {
-            if (!_downloadData->file.seek(ofs)) {
-                qCWarning(OnboardLogControllerLog) << "Error while seeking log file offset";
-                return;
-            }
-        }
-
-        if (_downloadData->file.write(reinterpret_cast<const char*>(data), count)) {
-            _downloadData->written += count;
-            _downloadData->rate_bytes += count;
-            _updateDataRate();
-
-            result = true;
-            _retries = 0;
-
-            _timer->start(kTimeOutMs);
-            if (_logComplete()) {
-                _downloadData->entry->setStatus(tr("Downloaded"));
-                _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk * OnboardLogDownloadData::kChunkSize,
-                                _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if ((bin < (_downloadData->chunk_table.size() - 1)) && _downloadData->chunk_table.at(bin + 1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
-                _findMissingData();
-            }
-        } else {
-            qCWarning(OnboardLogControllerLog) << "Error while writing log file chunk";
-        }
-    } else {
-        qCWarning(OnboardLogControllerLog) << "Received log offset greater than expected";
-    }
-
-    if (!result) {
-        _downloadData->entry->setStatus(tr("Error"));
-    }
-}
-
-void OnboardLogController::_findMissingData()
-{
-    if (_logComplete()) {
-        _receivedAllData();
-        return;
-    }
-
-    if (_chunkComplete()) {
-        _downloadData->advanceChunk();
-    }
-
-    _retries++;
-
-    _updateDataRate();
-
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
-    for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
-            break;
-        }
-    }
-
-    for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
-            break;
-        }
-    }
-
-    const uint32_t pos = (_downloadData->current_chunk * OnboardLogDownloadData::kChunkSize) + (start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-    const uint32_t len = (end - start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-    _requestLogData(_downloadData->ID, pos, len, _retries);
-}
-
-void OnboardLogController::_updateDataRate()
-{
-    constexpr uint kSizeUpdateThreshold = 102400; // 0.1 MB
-    const bool timeThresholdMet = _downloadData->elapsed.elapsed() >= kGUIRateMs;
-    const bool sizeThresholdMet = (_downloadData->written - _downloadData->last_status_written) >= kSizeUpdateThreshold;
-
-    if (!timeThresholdMet && !sizeThresholdMet) {
-        return;
-    }
-
-    QString status;
-    if (timeThresholdMet) {
-        // Update both rate and size
-        const qreal rate = _downloadData->rate_bytes / (_downloadData->elapsed.elapsed() / 1000.0);
-        _downloadData->rate_avg = (_downloadData->rate_avg * 0.95) + (rate * 0.05);
-        _downloadData->rate_bytes = 0;
-
-        status = QStringLiteral("%1 (%2/s)").arg(QGC::bigSizeToString(_downloadData->written),
-                                                   QGC::bigSizeToString(_downloadData->rate_avg));
-        _downloadData->elapsed.start();
-    } else {
-        // Update size only, keep previous rate
-        status = QStringLiteral("%1 (%2/s)").arg(QGC::bigSizeToString(_downloadData->written),
-                                                   QGC::bigSizeToString(_downloadData->rate_avg));
-    }
-
-    _downloadData->entry->setStatus(status);
-    _downloadData->last_status_written = _downloadData->written;
-}
-
-bool OnboardLogController::_chunkComplete() const
-{
-    return _downloadData->chunkEquals(true);
-}
-
-bool OnboardLogController::_logComplete() const
-{
-    return (_chunkComplete() && ((_downloadData->current_chunk + 1) == _downloadData->numChunks()));
-}
-
-void OnboardLogController::_receivedAllData()
-{
-    _timer->stop();
-    if (_prepareLogDownload()) {
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-        _timer->start(kTimeOutMs);
-    } else {
-        _resetSelection();
-        _setDownloading(false);
-    }
-}
-
-bool OnboardLogController::_prepareLogDownload()
-{
-    _downloadData.reset();
-
-    QGCOnboardLogEntry *const entry = _getNextSelected();
-    if (!entry) {
-        return false;
-    }
-
-    entry->setSelected(false);
-    emit selectionChanged();
-
-    const QString ftime = (entry->time().date().year() >= 2010) ? entry->time().toString(QStringLiteral("yyyy-M-d-hh-mm-ss")) : QStringLiteral("UnknownDate");
-
-    _downloadData = std::make_unique<OnboardLogDownloadData>(entry);
-    _downloadData->filename = QStringLiteral("log_") + QString::number(entry->id()) + "_" + ftime;
-
-    if (_vehicle->firmwareType() == MAV_AUTOPILOT_PX4) {
-        const QString loggerParam = QStringLiteral("SYS_LOGGER");
-        ParameterManager *const parameterManager = _vehicle->parameterManager();
-        if (parameterManager->parameterExists(ParameterManager::defaultComponentId, loggerParam) && parameterManager->getParameter(ParameterManager::defaultComponentId, loggerParam)->rawValue().toInt() == 0) {
-            _downloadData->filename += ".px4log";
-        } else {
-            _downloadData->filename += ".ulg";
-        }
-    } else {
-        _downloadData->filename += ".bin";
-    }
-
-    _downloadData->file.setFileName(_downloadPath + _downloadData->filename);
-
-    if (_downloadData->file.exists()) {
-        uint32_t numDups = 0;
-        const QStringList filename_spl = _downloadData->filename.split('.');
-        do {
-            numDups += 1;
-            const QString filename = filename_spl[0] + '_' + QString::number(numDups) + '.' + filename_spl[1];
-            _downloadData->file.setFileName(_downloadPath + filename);
-        } while ( _downloadData->file.exists());
-    }
-
-    bool result = false;
-    if (!_downloadData->file.open(QIODevice::WriteOnly)) {
-        qCWarning(OnboardLogControllerLog) << "Failed to create log file:" <<  _downloadData->filename;
-    } else if (!_downloadData->file.resize(entry->size())) {
-        qCWarning(OnboardLogControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
-    } else {
-        _downloadData->current_chunk = 0;
-        _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
-        _downloadData->elapsed.start();
-        result = true;
-    }
-
-    if (!result) {
-        if (_downloadData->file.exists()) {
-            (void) _downloadData->file.remove();
-        }
-
-        _downloadData->entry->setStatus(QStringLiteral("Error"));
-        _downloadData.reset();
-    }
-
-    return result;
-}
-
 void OnboardLogController::refresh()
 {
     _logEntriesModel->clearAndDeleteContents();
@@ -468,20 +295,18 @@ QGCOnboardLogEntry *OnboardLogController::_getNextSelected() const
 
 void OnboardLogController::cancel()
 {
-    _requestLogEnd();
+    if (_requestingLogEntries) {
+        _requestLogEnd();
+    }
     _receivedAllEntries();
 
-    if (_downloadData) {
-        _downloadData->entry->setStatus(QStringLiteral("Canceled"));
-        if (_downloadData->file.exists()) {
-            (void) _downloadData->file.remove();
-        }
-
-        _downloadData.reset();
+    // Partial logs are kept with their sidecar bitmap so a later download resumes them
+    const QList<OnboardLogDownloader*> downloaders = _downloaders;
+    for (OnboardLogDownloader *const downloader : downloaders) {
+        downloader->cancel();
     }
 
     _resetSelection(true);
-    _setDownloading(false);
 }
 
 void OnboardLogController::selectAll(bool select)
@@ -675,40 +500,6 @@ void OnboardLogController::_requestLogList(uint32_t start, uint32_t end)
     _timer->start(kRequestLogListTimeoutMs);
 }
 
-void OnboardLogController::_requestLogData(uint16_t id, uint32_t offset, uint32_t count, int retryCount)
-{
-    if (!_vehicle) {
-        qCWarning(OnboardLogControllerLog) << "Vehicle Unavailable";
-        return;
-    }
-
-    SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
-    if (!sharedLink) {
-        qCWarning(OnboardLogControllerLog) << "Link Unavailable";
-        return;
-    }
-
-    id += _apmOffset;
-    qCDebug(OnboardLogControllerLog) << "Request log data (id:" << id << "offset:" << offset << "size:" << count << "retryCount" << retryCount << ")";
-
-    mavlink_message_t msg{};
-    (void) mavlink_msg_log_request_data_pack_chan(
-        MAVLinkProtocol::instance()->getSystemId(),
-        MAVLinkProtocol::getComponentId(),
-        sharedLink->mavlinkChannel(),
-        &msg,
-        _vehicle->id(),
-        _vehicle->defaultComponentId(),
-        id,
-        offset,
-        count
-    );
-
-    if (!_vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg)) {
-        qCWarning(OnboardLogControllerLog) << "Failed to send";
-    }
-}
-
 void OnboardLogController::_requestLogEnd()
 {
     if (!_vehicle) {
@@ -737,11 +528,13 @@ void OnboardLogController::_requestLogEnd()
     }
 }
 
-void OnboardLogController::_setDownloading(bool active)
+void OnboardLogController::_updateDownloading()
 {
+    emit activeDownloadsChanged();
+
+    const bool active = (_vehicle && _downloader(_vehicle));
     if (_downloadingLogs != active) {
         _downloadingLogs = active;
-        _vehicle->vehicleLinkManager()->setCommunicationLostEnabled(!active);
         emit downloadingLogsChanged();
     }
 }
@@ -3,7 +3,7 @@
 #include <QtCore/QObject>
 #include <QtQmlIntegration/QtQmlIntegration>
 
-struct OnboardLogDownloadData;
+class OnboardLogDownloader;
 class QGCOnboardLogEntry;
 class QmlObjectListModel;
 class QTimer;
@@ -23,6 +23,9 @@ class OnboardLogController : public QObject
     Q_PROPERTY(QmlObjectListModel *model               READ _getModel                                           CONSTANT)
     Q_PROPERTY(bool               requestingList       READ _getRequestingList                                  NOTIFY requestingListChanged)
     Q_PROPERTY(bool               downloadingLogs      READ _getDownloadingLogs                                 NOTIFY downloadingLogsChanged)
+    Q_PROPERTY(int                activeDownloads      READ activeDownloads                                     NOTIFY activeDownloadsChanged)
+    Q_PROPERTY(qreal              downloadRate         READ downloadRate                                        NOTIFY downloadRateChanged)
+    Q_PROPERTY(QString            downloadRateStr      READ downloadRateStr                                     NOTIFY downloadRateChanged)
     Q_PROPERTY(bool               allLogsSelected      READ allLogsSelected                                     NOTIFY selectionChanged)
     Q_PROPERTY(bool               sortAscending        READ sortAscending          WRITE setSortAscending       NOTIFY sortAscendingChanged)
     Q_PROPERTY(bool               compressLogs         READ compressLogs           WRITE setCompressLogs        NOTIFY compressLogsChanged)
@@ -51,6 +54,13 @@ class OnboardLogController : public QObject
     bool sortAscending() const { return _sortAscending; }
     void setSortAscending(bool ascending);
 
+    /// Number of vehicles with a log download in progress
+    int activeDownloads() const { return _downloaders.count(); }
+
+    /// Combined throughput of all log downloads in bytes per second
+    qreal downloadRate() const { return _downloadRate; }
+    QString downloadRateStr() const;
+
     /// Compress a single log file
     Q_INVOKABLE bool compressLogFile(const QString &logPath);
 
@@ -60,6 +70,8 @@ class OnboardLogController : public QObject
 signals:
     void requestingListChanged();
     void downloadingLogsChanged();
+    void activeDownloadsChanged();
+    void downloadRateChanged();
     void selectionChanged();
     void compressLogsChanged();
     void sortAscendingChanged();
@@ -71,8 +83,9 @@ private slots:
     void _setActiveVehicle(Vehicle *vehicle);
 
     void _logEntry(uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t last_log_num);
-    void _logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data);
     void _processDownload();
+    void _downloaderFinished();
+    void _updateDownloadRate();
     void _handleCompressionProgress(qreal progress);
     void _handleCompressionFinished(bool success);
 
@@ -81,22 +94,16 @@ private slots:
     bool _getRequestingList() const { return _requestingLogEntries; }
     bool _getDownloadingLogs() const { return _downloadingLogs; }
 
-    bool _chunkComplete() const;
     bool _entriesComplete() const;
-    bool _logComplete() const;
-    bool _prepareLogDownload();
     void _downloadToDirectory(const QString &dir);
-    void _findMissingData();
     void _findMissingEntries();
-    void _receivedAllData();
     void _receivedAllEntries();
-    void _requestLogData(uint16_t id, uint32_t offset, uint32_t count, int retryCount = 0);
     void _requestLogList(uint32_t start, uint32_t end);
     void _requestLogEnd();
     void _resetSelection(bool canceled = false);
-    void _setDownloading(bool active);
+    void _updateDownloading();
     void _setListing(bool active);
-    void _updateDataRate();
+    OnboardLogDownloader *_downloader(const Vehicle *vehicle) const;
 
     void _sortEntriesByTimestamp();
 
@@ -109,8 +116,8 @@ private slots:
     bool _requestingLogEntries = false;
     int _apmOffset = 0;
     int _retries = 0;
-    std::unique_ptr<OnboardLogDownloadData> _downloadData;
-    QString _downloadPath;
+    QList<OnboardLogDownloader*> _downloaders;  ///< One per vehicle, vehicles download in parallel
+    qreal _downloadRate = 0.;
     Vehicle *_vehicle = nullptr;
     bool _compressLogs = false;
     bool _compressing = false;
@@ -118,6 +125,5 @@ private slots:
     bool _sortAscending = false;
 
     static constexpr uint32_t kTimeOutMs = 500;
-    static constexpr uint32_t kGUIRateMs = 500; ///< Update download rate twice per second
     static constexpr uint32_t kRequestLogListTimeoutMs = 5000;
 };
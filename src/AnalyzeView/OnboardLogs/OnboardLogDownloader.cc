@@ -0,0 +1,547 @@
+#include "OnboardLogDownloader.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkProtocol.h"
+#include "OnboardLogEntry.h"
+#include "ParameterManager.h"
+#include "QGCFormat.h"
+#include "QGCLoggingCategory.h"
+#include "Vehicle.h"
+#include "VehicleLinkManager.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+
+QGC_LOGGING_CATEGORY(OnboardLogDownloaderLog, "AnalyzeView.OnboardLogDownloader")
+
+namespace {
+
+constexpr uint32_t kBinSize = MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+
+uint32_t binCount(uint size)
+{
+    return (size + kBinSize - 1) / kBinSize;
+}
+
+qint64 timeSecs(const QDateTime &time)
+{
+    return time.isValid() ? time.toSecsSinceEpoch() : 0;
+}
+
+} // namespace
+
+OnboardLogDownloader::OnboardLogDownloader(Vehicle *vehicle, int apmOffset, const QString &downloadPath, QObject *parent)
+    : QObject(parent)
+    , _vehicle(vehicle)
+    , _apmOffset(apmOffset)
+    , _downloadPath(downloadPath)
+    , _timer(new QTimer(this))
+{
+    qCDebug(OnboardLogDownloaderLog) << this << "vehicle" << (vehicle ? vehicle->id() : 0);
+
+    _timer->setSingleShot(true);
+    (void) connect(_timer, &QTimer::timeout, this, &OnboardLogDownloader::_timeout);
+
+    if (_vehicle) {
+        (void) connect(_vehicle, &Vehicle::logData, this, &OnboardLogDownloader::_logData);
+    }
+}
+
+OnboardLogDownloader::~OnboardLogDownloader()
+{
+    qCDebug(OnboardLogDownloaderLog) << this;
+
+    if (_file.isOpen()) {
+        _saveSidecar();
+        _file.close();
+    }
+
+    if (_active && _vehicle) {
+        _vehicle->vehicleLinkManager()->setCommunicationLostEnabled(true);
+    }
+}
+
+void OnboardLogDownloader::enqueue(QGCOnboardLogEntry *entry)
+{
+    Job job;
+    job.entry = entry;
+    job.id = entry->id();
+    job.size = entry->size();
+    job.time = entry->time();
+
+    entry->setSelected(false);
+    entry->setStatus(tr("Waiting"));
+    _queue.enqueue(job);
+
+    if (!_active) {
+        _nextJob();
+    }
+}
+
+void OnboardLogDownloader::cancel()
+{
+    if (!_active) {
+        return;
+    }
+
+    _requestLogEnd();
+
+    for (const Job &job : std::as_const(_queue)) {
+        if (job.entry) {
+            job.entry->setStatus(tr("Canceled"));
+        }
+    }
+    _queue.clear();
+
+    _finishJob(tr("Canceled"), false);
+}
+
+void OnboardLogDownloader::_nextJob()
+{
+    while (!_queue.isEmpty()) {
+        _job = _queue.dequeue();
+        if (_startJob()) {
+            return;
+        }
+    }
+
+    _job = Job();
+    _setActive(false);
+    emit finished();
+}
+
+bool OnboardLogDownloader::_startJob()
+{
+    if (!_vehicle) {
+        qCWarning(OnboardLogDownloaderLog) << "Vehicle Unavailable";
+        _setStatus(tr("Error"));
+        return false;
+    }
+
+    _setActive(true);
+
+    if (!_openLogFile()) {
+        _setStatus(tr("Error"));
+        return false;
+    }
+
+    _windowBins = kInitialWindowBins;
+    _slowStart = true;
+    _retries = 0;
+    _rateBytes = 0;
+    _rateAvg = 0.;
+    _written = std::min<size_t>(static_cast<size_t>(_receivedBins) * kBinSize, _job.size);
+    _rateElapsed.start();
+    _sidecarElapsed.start();
+    emit rateChanged();
+
+    if (_receivedBins == static_cast<uint32_t>(_received.size())) {
+        _finishJob(tr("Downloaded"), true);
+        return true;
+    }
+
+    _setStatus(tr("Downloading"));
+    _requestNext();
+    return true;
+}
+
+QString OnboardLogDownloader::_logFileName() const
+{
+    const QString ftime = (_job.time.date().year() >= 2010) ? _job.time.toString(QStringLiteral("yyyy-M-d-hh-mm-ss")) : QStringLiteral("UnknownDate");
+    QString filename = QStringLiteral("log_") + QString::number(_job.id) + "_" + ftime;
+
+    if (_vehicle->firmwareType() == MAV_AUTOPILOT_PX4) {
+        const QString loggerParam = QStringLiteral("SYS_LOGGER");
+        ParameterManager *const parameterManager = _vehicle->parameterManager();
+        if (parameterManager->parameterExists(ParameterManager::defaultComponentId, loggerParam) && parameterManager->getParameter(ParameterManager::defaultComponentId, loggerParam)->rawValue().toInt() == 0) {
+            filename += ".px4log";
+        } else {
+            filename += ".ulg";
+        }
+    } else {
+        filename += ".bin";
+    }
+
+    return filename;
+}
+
+bool OnboardLogDownloader::_openLogFile()
+{
+    // A partial log of the same name with a matching sidecar is an earlier, interrupted download of this log. A
+    // complete log of the same name is never written to.
+    const QString baseName = _logFileName();
+    const qsizetype extension = baseName.lastIndexOf('.');
+    QString filename = baseName;
+    uint32_t numDups = 0;
+    while (QFile::exists(_downloadPath + filename) || QFile::exists(partialPath(_downloadPath + filename))) {
+        if (!QFile::exists(_downloadPath + filename) && _loadSidecar(_downloadPath + filename)) {
+            _logPath = _downloadPath + filename;
+            _file.setFileName(partialPath(_logPath));
+            if (!_file.open(QIODevice::ReadWrite)) {
+                qCWarning(OnboardLogDownloaderLog) << "Failed to open partial log file:" << _file.fileName();
+                return false;
+            }
+
+            qCDebug(OnboardLogDownloaderLog) << "Resuming" << filename << "received bins" << _receivedBins << "of" << _received.size();
+            return true;
+        }
+
+        numDups += 1;
+        filename = baseName.left(extension) + '_' + QString::number(numDups) + baseName.mid(extension);
+    }
+
+    _logPath = _downloadPath + filename;
+    _file.setFileName(partialPath(_logPath));
+    _received = QBitArray(static_cast<qsizetype>(binCount(_job.size)), false);
+    _receivedBins = 0;
+    _firstMissingBin = 0;
+
+    if (!_file.open(QIODevice::WriteOnly)) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to create log file:" << _file.fileName();
+        return false;
+    }
+
+    if (!_file.resize(_job.size)) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to allocate space for log file:" << _file.fileName();
+        _file.close();
+        (void) _file.remove();
+        return false;
+    }
+
+    _saveSidecar();
+    return true;
+}
+
+bool OnboardLogDownloader::_loadSidecar(const QString &logPath)
+{
+    QFile sidecar(sidecarPath(logPath));
+    if (!sidecar.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&sidecar);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 id = 0;
+    quint32 size = 0;
+    qint64 time = 0;
+    QBitArray received;
+    stream >> magic >> version >> id >> size >> time >> received;
+
+    if ((stream.status() != QDataStream::Ok) || (magic != kSidecarMagic) || (version != kSidecarVersion)) {
+        qCWarning(OnboardLogDownloaderLog) << "Ignoring unreadable sidecar" << sidecar.fileName();
+        return false;
+    }
+
+    if ((id != _job.id) || (size != _job.size) || (time != timeSecs(_job.time)) ||
+        (received.size() != static_cast<qsizetype>(binCount(_job.size))) || (QFileInfo(partialPath(logPath)).size() != _job.size)) {
+        return false;
+    }
+
+    _received = received;
+    _receivedBins = static_cast<uint32_t>(_received.count(true));
+    _firstMissingBin = 0;
+    return true;
+}
+
+void OnboardLogDownloader::_saveSidecar()
+{
+    if (!_file.isOpen()) {
+        return;
+    }
+
+    // The bitmap must never claim data which is not in the log file yet
+    (void) _file.flush();
+
+    QSaveFile sidecar(sidecarPath(_logPath));
+    if (!sidecar.open(QIODevice::WriteOnly)) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to create sidecar:" << sidecar.errorString();
+        return;
+    }
+
+    QDataStream stream(&sidecar);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kSidecarMagic << kSidecarVersion << static_cast<quint32>(_job.id) << static_cast<quint32>(_job.size) << timeSecs(_job.time) << _received;
+
+    if (!sidecar.commit()) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to write sidecar:" << sidecar.errorString();
+    }
+
+    _sidecarElapsed.start();
+}
+
+void OnboardLogDownloader::_finishJob(const QString &status, bool complete)
+{
+    _timer->stop();
+
+    QString finalStatus = status;
+    if (_file.isOpen()) {
+        if (complete) {
+            _file.close();
+            if (_file.rename(_logPath)) {
+                (void) QFile::remove(sidecarPath(_logPath));
+            } else {
+                // Keep the sidecar, the next download of this log picks the partial log up again and retries
+                qCWarning(OnboardLogDownloaderLog) << "Failed to rename" << _file.fileName() << "to" << _logPath << _file.errorString();
+                finalStatus = tr("Error");
+            }
+        } else {
+            _saveSidecar();
+            _file.close();
+        }
+    }
+
+    qCDebug(OnboardLogDownloaderLog) << "Log" << _job.id << finalStatus;
+    _setStatus(finalStatus);
+    _nextJob();
+}
+
+void OnboardLogDownloader::_logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data)
+{
+    if (!_active || !_file.isOpen()) {
+        return;
+    }
+
+    id -= _apmOffset;
+    if (_job.id != id) {
+        qCWarning(OnboardLogDownloaderLog) << "Received log data for wrong log";
+        return;
+    }
+
+    if ((ofs % kBinSize) != 0) {
+        qCWarning(OnboardLogDownloaderLog) << "Ignored misaligned incoming packet @" << ofs;
+        return;
+    }
+
+    const uint32_t bin = ofs / kBinSize;
+    if (bin >= static_cast<uint32_t>(_received.size())) {
+        qCWarning(OnboardLogDownloaderLog) << "Received log offset greater than expected";
+        return;
+    }
+
+    if (!_received.testBit(bin)) {
+        if (!_file.seek(ofs) || (_file.write(reinterpret_cast<const char*>(data), count) != count)) {
+            qCWarning(OnboardLogDownloaderLog) << "Error while writing log file:" << _file.errorString();
+            _finishJob(tr("Error"), false);
+            return;
+        }
+
+        _received.setBit(bin);
+        _receivedBins++;
+        _written += count;
+    }
+
+    _rateBytes += count;
+    _retries = 0;
+    _updateStatus();
+
+    if (_receivedBins == static_cast<uint32_t>(_received.size())) {
+        _finishJob(tr("Downloaded"), true);
+    } else if ((bin + 1) == _requestEndBin) {
+        // The vehicle streams a request in order, its last bin closes the window
+        _windowComplete(false);
+    } else {
+        _timer->start(_timeoutMs());
+    }
+}
+
+void OnboardLogDownloader::_timeout()
+{
+    if (!_active) {
+        return;
+    }
+
+    if (!_vehicle) {
+        qCWarning(OnboardLogDownloaderLog) << "Vehicle Unavailable";
+        _finishJob(tr("Error"), false);
+        return;
+    }
+
+    if (++_retries > kMaxRetries) {
+        qCWarning(OnboardLogDownloaderLog) << "Too many errors downloading log" << _job.id << "Giving up.";
+        _finishJob(tr("Error"), false);
+        return;
+    }
+
+    _windowComplete(true);
+}
+
+void OnboardLogDownloader::_windowComplete(bool lost)
+{
+    for (uint32_t bin = _requestFirstBin; !lost && (bin < _requestEndBin); bin++) {
+        lost = !_received.testBit(bin);
+    }
+
+    if (lost) {
+        _slowStart = false;
+        _windowBins /= 2;
+    } else if ((_requestEndBin - _requestFirstBin) >= _windowBins) {
+        // Only a request which used the whole window says anything about a larger one
+        _windowBins = _slowStart ? (_windowBins * 2) : (_windowBins + kMinWindowBins);
+    }
+    _windowBins = std::clamp(_windowBins, kMinWindowBins, _maxWindowBins());
+
+    _requestNext();
+}
+
+void OnboardLogDownloader::_requestNext()
+{
+    const uint32_t bins = static_cast<uint32_t>(_received.size());
+    while ((_firstMissingBin < bins) && _received.testBit(_firstMissingBin)) {
+        _firstMissingBin++;
+    }
+
+    if (_firstMissingBin >= bins) {
+        _finishJob(tr("Downloaded"), true);
+        return;
+    }
+
+    // Request the first run of missing bins, gaps left by loss are refilled before new data
+    const uint32_t limit = std::min(bins, _firstMissingBin + _windowBins);
+    uint32_t end = _firstMissingBin + 1;
+    while ((end < limit) && !_received.testBit(end)) {
+        end++;
+    }
+
+    _requestFirstBin = _firstMissingBin;
+    _requestEndBin = end;
+
+    const uint32_t offset = _requestFirstBin * kBinSize;
+    const uint32_t count = std::min(_requestEndBin * kBinSize, static_cast<uint32_t>(_job.size)) - offset;
+    _requestLogData(offset, count);
+    _timer->start(_timeoutMs());
+
+    if (_sidecarElapsed.elapsed() >= kSidecarRateMs) {
+        _saveSidecar();
+    }
+}
+
+uint32_t OnboardLogDownloader::_maxWindowBins() const
+{
+    if (_rateAvg <= 0.) {
+        return kMaxWindowBins;
+    }
+
+    const qreal bins = (_rateAvg * kTargetWindowMs) / (1000. * kBinSize);
+    return std::clamp(static_cast<uint32_t>(bins), kMinWindowBins, kMaxWindowBins);
+}
+
+int OnboardLogDownloader::_timeoutMs() const
+{
+    if (_rateAvg <= 0.) {
+        return kTimeOutMs;
+    }
+
+    const int packetMs = qRound((1000. * kBinSize) / _rateAvg);
+    return std::clamp(kTimeOutPackets * packetMs, kMinTimeOutMs, kTimeOutMs);
+}
+
+void OnboardLogDownloader::_updateStatus()
+{
+    const bool complete = (_receivedBins == static_cast<uint32_t>(_received.size()));
+    if (!complete && (_rateElapsed.elapsed() < kGUIRateMs)) {
+        return;
+    }
+
+    const qint64 elapsedMs = _rateElapsed.elapsed();
+    if (elapsedMs > 0) {
+        const qreal rate = _rateBytes / (elapsedMs / 1000.0);
+        _rateAvg = (_rateAvg > 0.) ? ((_rateAvg * 0.7) + (rate * 0.3)) : rate;
+        _rateBytes = 0;
+        _rateElapsed.start();
+        emit rateChanged();
+    }
+
+    _setStatus(QStringLiteral("%1 (%2/s)").arg(QGC::bigSizeToString(_written), QGC::bigSizeToString(_rateAvg)));
+}
+
+void OnboardLogDownloader::_setStatus(const QString &status)
+{
+    if (_job.entry) {
+        _job.entry->setStatus(status);
+    }
+}
+
+void OnboardLogDownloader::_setActive(bool active)
+{
+    if (_active == active) {
+        return;
+    }
+
+    _active = active;
+    if (_vehicle) {
+        _vehicle->vehicleLinkManager()->setCommunicationLostEnabled(!active);
+    }
+
+    if (!active) {
+        _rateAvg = 0.;
+        emit rateChanged();
+    }
+}
+
+void OnboardLogDownloader::_requestLogData(uint32_t offset, uint32_t count)
+{
+    if (!_vehicle) {
+        qCWarning(OnboardLogDownloaderLog) << "Vehicle Unavailable";
+        return;
+    }
+
+    SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (!sharedLink) {
+        qCWarning(OnboardLogDownloaderLog) << "Link Unavailable";
+        return;
+    }
+
+    const uint16_t id = static_cast<uint16_t>(_job.id + _apmOffset);
+    qCDebug(OnboardLogDownloaderLog) << "Request log data (id:" << id << "offset:" << offset << "size:" << count << "window:" << _windowBins << "retryCount" << _retries << ")";
+
+    mavlink_message_t msg{};
+    (void) mavlink_msg_log_request_data_pack_chan(
+        MAVLinkProtocol::instance()->getSystemId(),
+        MAVLinkProtocol::getComponentId(),
+        sharedLink->mavlinkChannel(),
+        &msg,
+        _vehicle->id(),
+        _vehicle->defaultComponentId(),
+        id,
+        offset,
+        count
+    );
+
+    if (!_vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg)) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to send";
+    }
+}
+
+void OnboardLogDownloader::_requestLogEnd()
+{
+    if (!_vehicle) {
+        qCWarning(OnboardLogDownloaderLog) << "Vehicle Unavailable";
+        return;
+    }
+
+    SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (!sharedLink) {
+        qCWarning(OnboardLogDownloaderLog) << "Link Unavailable";
+        return;
+    }
+
+    mavlink_message_t msg{};
+    (void) mavlink_msg_log_request_end_pack_chan(
+        MAVLinkProtocol::instance()->getSystemId(),
+        MAVLinkProtocol::getComponentId(),
+        sharedLink->mavlinkChannel(),
+        &msg,
+        _vehicle->id(),
+        _vehicle->defaultComponentId()
+    );
+
+    if (!_vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg)) {
+        qCWarning(OnboardLogDownloaderLog) << "Failed to send";
+    }
+}
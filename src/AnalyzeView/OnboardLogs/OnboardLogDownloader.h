@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QtCore/QBitArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QQueue>
+
+Q_DECLARE_LOGGING_CATEGORY(OnboardLogDownloaderLog)
+
+class QGCOnboardLogEntry;
+class QTimer;
+class Vehicle;
+
+/// Downloads the queued onboard logs of one vehicle over LOG_REQUEST_DATA/LOG_DATA.
+///
+/// The vehicle streams one request at a time, so logs of the same vehicle are transferred in order while
+/// downloaders of different vehicles run side by side. Each request covers a window of LOG_DATA bins which
+/// grows while windows arrive complete and is halved on loss or timeout, capped to roughly kTargetWindowMs of
+/// the observed throughput. The log is written to "<log>.part" and only renamed to its final name once complete, so a
+/// file with the final name is always a whole log. The received bins are kept in a sidecar bitmap next to the partial
+/// log so that a canceled or interrupted download resumes where it stopped.
+class OnboardLogDownloader : public QObject
+{
+    Q_OBJECT
+
+    friend class OnboardLogDownloadTest;
+
+public:
+    OnboardLogDownloader(Vehicle *vehicle, int apmOffset, const QString &downloadPath, QObject *parent = nullptr);
+    ~OnboardLogDownloader();
+
+    Vehicle *vehicle() const { return _vehicle; }
+
+    /// Average throughput of the current transfer in bytes per second
+    qreal rate() const { return _rateAvg; }
+
+    bool active() const { return _active; }
+
+    /// Queues the log, the download starts immediately when the downloader is idle
+    void enqueue(QGCOnboardLogEntry *entry);
+
+    /// Stops the transfer, keeping the partial log and its sidecar bitmap for a later resume
+    void cancel();
+
+    /// Partial log, renamed to @p logPath once the download is complete
+    static QString partialPath(const QString &logPath) { return logPath + QStringLiteral(".part"); }
+
+    /// Sidecar bitmap recording the received parts of the partial log
+    static QString sidecarPath(const QString &logPath) { return partialPath(logPath) + QStringLiteral(".bitmap"); }
+
+signals:
+    void rateChanged();
+    void finished();
+
+private slots:
+    void _logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data);
+    void _timeout();
+
+private:
+    struct Job {
+        QPointer<QGCOnboardLogEntry> entry;
+        uint id = 0;
+        uint size = 0;
+        QDateTime time;
+    };
+
+    bool _startJob();
+    bool _openLogFile();
+    QString _logFileName() const;
+    bool _loadSidecar(const QString &logPath);
+    void _saveSidecar();
+    void _finishJob(const QString &status, bool complete);
+    void _nextJob();
+    void _windowComplete(bool lost);
+    void _requestNext();
+    void _requestLogData(uint32_t offset, uint32_t count);
+    void _requestLogEnd();
+    void _updateStatus();
+    void _setActive(bool active);
+    void _setStatus(const QString &status);
+    uint32_t _maxWindowBins() const;
+    int _timeoutMs() const;
+
+    QPointer<Vehicle> _vehicle;
+    const int _apmOffset = 0;
+    const QString _downloadPath;
+
+    QQueue<Job> _queue;
+    Job _job;
+    bool _active = false;
+
+    QString _logPath;                   ///< Final name of the log, _file is its partial log
+    QFile _file;
+    QBitArray _received;                ///< One bit per MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bin of the log
+    uint32_t _receivedBins = 0;
+    uint32_t _firstMissingBin = 0;      ///< All bins below are received
+    uint32_t _requestFirstBin = 0;      ///< Outstanding request [_requestFirstBin, _requestEndBin)
+    uint32_t _requestEndBin = 0;
+    uint32_t _windowBins = kInitialWindowBins;
+    bool _slowStart = true;
+    int _retries = 0;
+
+    QTimer *_timer = nullptr;
+    QElapsedTimer _rateElapsed;
+    QElapsedTimer _sidecarElapsed;
+    size_t _rateBytes = 0;
+    qreal _rateAvg = 0.;
+    size_t _written = 0;
+
+    static constexpr uint32_t kInitialWindowBins = 64;
+    static constexpr uint32_t kMinWindowBins = 8;
+    static constexpr uint32_t kMaxWindowBins = 2048;    ///< ~180 KB per request
+    static constexpr int kTargetWindowMs = 1000;        ///< Window cap in time at the observed throughput
+    static constexpr int kTimeOutMs = 500;
+    static constexpr int kMinTimeOutMs = 100;
+    static constexpr int kTimeOutPackets = 20;          ///< Silence of this many packets at the observed rate is a timeout
+    static constexpr int kMaxRetries = 10;              ///< Consecutive timeouts without data before giving up
+    static constexpr int kGUIRateMs = 500;              ///< Update download rate twice per second
+    static constexpr int kSidecarRateMs = 1000;         ///< Interval at which the sidecar bitmap is rewritten
+    static constexpr quint32 kSidecarMagic = 0x51474C42;
+    static constexpr quint32 kSidecarVersion = 1;
+};
@@ -183,9 +183,18 @@ AnalyzePage {
                 QGCButton {
                     Layout.fillWidth: true
                     text: qsTr("Cancel")
-                    enabled: OnboardLogController.requestingList || OnboardLogController.downloadingLogs
+                    enabled: OnboardLogController.requestingList || (OnboardLogController.activeDownloads > 0)
                     onClicked: OnboardLogController.cancel()
                 }
+
+                QGCLabel {
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignHCenter
+                    visible: OnboardLogController.activeDownloads > 0
+                    text: OnboardLogController.activeDownloads > 1
+                          ? qsTr("%1 vehicles\n%2").arg(OnboardLogController.activeDownloads).arg(OnboardLogController.downloadRateStr)
+                          : OnboardLogController.downloadRateStr
+                }
             }
         }
     }
@@ -0,0 +1,702 @@
+#include "CameraMediaBrowser.h"
+#include "AppSettings.h"
+#include "ExifUtility.h"
+#include "FTPManager.h"
+#include "QGCLoggingCategory.h"
+#include "QGCNetworkHelper.h"
+#include "SettingsManager.h"
+#include "Vehicle.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+#include <QtCore/QTimeZone>
+#include <QtCore/QUrl>
+#include <QtGui/QImage>
+#include <QtGui/QImageReader>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <algorithm>
+#include <tuple>
+
+QGC_LOGGING_CATEGORY(CameraMediaBrowserLog, "Camera.CameraMediaBrowser")
+
+CameraMediaBrowser::CameraMediaBrowser(Vehicle *vehicle, QObject *parent)
+    : QAbstractListModel(parent)
+    , _vehicle(vehicle)
+    , _downloadDirectory(SettingsManager::instance()->appSettings()->photoSavePath())
+    , _thumbnailCache(std::make_unique<CameraThumbnailCache>(
+          QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/CameraThumbnails"),
+          kDefaultThumbnailCacheBytes))
+{
+    qCDebug(CameraMediaBrowserLog) << this;
+
+    // Decoding is CPU bound, leave a core for the UI and the link
+    _decodePool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+
+    _ftpRetryTimer.setSingleShot(true);
+    _ftpRetryTimer.setInterval(_ftpRetryMsecs);
+    (void) connect(&_ftpRetryTimer, &QTimer::timeout, this, &CameraMediaBrowser::_startTransfers);
+
+    if (_vehicle) {
+        (void) connect(_vehicle, &Vehicle::armedChanged, this, &CameraMediaBrowser::_armedChanged);
+    }
+}
+
+CameraMediaBrowser::~CameraMediaBrowser()
+{
+    // We go away with the vehicle, whose FTPManager may already be gone
+    _ftpRow = -1;
+    _cancelTransfers();
+    // Workers read from the transfer directory which goes away with us
+    _decodePool.waitForDone();
+
+    qCDebug(CameraMediaBrowserLog) << this;
+}
+
+int CameraMediaBrowser::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant CameraMediaBrowser::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() < 0) || (index.row() >= count())) {
+        return QVariant();
+    }
+
+    const MediaItem &item = _items[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+    case FileNameRole:
+        return _fileName(item.fileUrl);
+    case CompIdRole:
+        return static_cast<int>(item.compId);
+    case ImageIndexRole:
+        return item.imageIndex;
+    case FileUrlRole:
+        return item.fileUrl;
+    case CoordinateRole:
+        return QVariant::fromValue(item.coordinate);
+    case CaptureTimeRole:
+        return item.captureTime;
+    case StateRole:
+        return item.state;
+    case ThumbnailUrlRole:
+        return item.thumbnailPath.isEmpty() ? QUrl() : QUrl::fromLocalFile(item.thumbnailPath);
+    case FullResolutionRequestedRole:
+        return item.fullResolutionRequested;
+    case LocalFileRole:
+        return item.localFile;
+    case ErrorRole:
+        return item.error;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CameraMediaBrowser::roleNames() const
+{
+    static const QHash<int, QByteArray> roles = {
+        { CompIdRole,                   "compId" },
+        { ImageIndexRole,               "imageIndex" },
+        { FileUrlRole,                  "fileUrl" },
+        { FileNameRole,                 "fileName" },
+        { CoordinateRole,               "coordinate" },
+        { CaptureTimeRole,              "captureTime" },
+        { StateRole,                    "mediaState" },
+        { ThumbnailUrlRole,             "thumbnailUrl" },
+        { FullResolutionRequestedRole,  "fullResolutionRequested" },
+        { LocalFileRole,                "localFile" },
+        { ErrorRole,                    "error" },
+    };
+    return roles;
+}
+
+void CameraMediaBrowser::setActive(bool active)
+{
+    if (active != _active) {
+        _active = active;
+        emit activeChanged();
+        _startTransfers();
+    }
+}
+
+void CameraMediaBrowser::setMaxHttpTransfers(int maxHttpTransfers)
+{
+    maxHttpTransfers = qMax(1, maxHttpTransfers);
+    if (maxHttpTransfers != _maxHttpTransfers) {
+        _maxHttpTransfers = maxHttpTransfers;
+        emit maxHttpTransfersChanged();
+        _startTransfers();
+    }
+}
+
+void CameraMediaBrowser::setDownloadDirectory(const QString &directory)
+{
+    if (directory != _downloadDirectory) {
+        _downloadDirectory = directory;
+        emit downloadDirectoryChanged();
+    }
+}
+
+void CameraMediaBrowser::setThumbnailCache(const QString &directory, qint64 maxBytes)
+{
+    _thumbnailCache = std::make_unique<CameraThumbnailCache>(directory, maxBytes);
+}
+
+void CameraMediaBrowser::setVisibleRange(int first, int last)
+{
+    _visibleFirst = first;
+    _visibleLast = last;
+    _startTransfers();
+}
+
+void CameraMediaBrowser::downloadFullResolution(int row)
+{
+    if ((row < 0) || (row >= count())) {
+        qCWarning(CameraMediaBrowserLog) << "downloadFullResolution: invalid row" << row;
+        return;
+    }
+
+    MediaItem &item = _items[row];
+    if (item.fullResolutionRequested || (!_isFtpUrl(item.fileUrl) && !_isHttpUrl(item.fileUrl))) {
+        return;
+    }
+    item.fullResolutionRequested = true;
+
+    if ((item.state == Queued) || (item.state == Transferring) || (item.state == Decoding)) {
+        // The pending transfer is kept once it completes, a queued one may start now even if it is not on screen
+        _emitRowChanged(row);
+        if (item.state == Queued) {
+            _startTransfers();
+        }
+        return;
+    }
+
+    _enqueue(row);
+    _startTransfers();
+}
+
+void CameraMediaBrowser::clear()
+{
+    _cancelTransfers();
+    _generation++;
+
+    beginResetModel();
+    _items.clear();
+    _rowByKey.clear();
+    _queue.clear();
+    endResetModel();
+
+    emit countChanged();
+    emit pendingTransfersChanged();
+}
+
+void CameraMediaBrowser::addCapturedImage(uint8_t compId, const mavlink_camera_image_captured_t &imageCaptured)
+{
+    if (imageCaptured.capture_result != 1) {
+        return;
+    }
+
+    const QString fileUrl = QString::fromUtf8(imageCaptured.file_url, qstrnlen(imageCaptured.file_url, sizeof(imageCaptured.file_url)));
+    if (fileUrl.isEmpty()) {
+        qCDebug(CameraMediaBrowserLog) << "Image" << imageCaptured.image_index << "from" << compId << "has no file url";
+        return;
+    }
+
+    const QString cacheKey = CameraThumbnailCache::key(compId, fileUrl);
+    if (_rowByKey.contains(cacheKey)) {
+        return;
+    }
+
+    MediaItem item;
+    item.compId = compId;
+    item.imageIndex = imageCaptured.image_index;
+    item.fileUrl = fileUrl;
+    item.cacheKey = cacheKey;
+    item.coordinate = QGeoCoordinate(imageCaptured.lat / 1e7, imageCaptured.lon / 1e7, imageCaptured.alt / 1e3);
+    if (imageCaptured.time_utc != 0) {
+        item.captureTime = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(imageCaptured.time_utc / 1000), QTimeZone::UTC);
+    }
+    item.thumbnailPath = _thumbnailCache->lookup(cacheKey);
+    if (!item.thumbnailPath.isEmpty()) {
+        item.state = Ready;
+    } else if (!_isFtpUrl(fileUrl) && !_isHttpUrl(fileUrl)) {
+        item.state = Failed;
+        item.error = tr("Unsupported file url");
+    }
+
+    const int row = count();
+    beginInsertRows(QModelIndex(), row, row);
+    _items.append(item);
+    _rowByKey.insert(cacheKey, row);
+    endInsertRows();
+    emit countChanged();
+
+    qCDebug(CameraMediaBrowserLog) << "Added" << fileUrl << "from" << compId << "cached thumbnail:" << !item.thumbnailPath.isEmpty();
+
+    if (item.state == Ready) {
+        emit thumbnailReady(row);
+    } else if (item.state == Queued) {
+        // Fetched once the row is shown, see setVisibleRange
+        _enqueue(row);
+    }
+}
+
+QList<int> CameraMediaBrowser::transferOrder() const
+{
+    // Requested full resolution copies, visible ones first, then the thumbnails of visible rows
+    const auto rank = [this](int row) {
+        const int fullResolution = _items[row].fullResolutionRequested ? 0 : 1;
+        if (_isVisible(row) || (_visibleLast < _visibleFirst)) {
+            return std::make_tuple(fullResolution, 0, row);
+        }
+        return std::make_tuple(fullResolution, (row < _visibleFirst) ? (_visibleFirst - row) : (row - _visibleLast), row);
+    };
+
+    QList<int> order;
+    for (const int row : _queue) {
+        if (_canStart(row)) {
+            order.append(row);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&rank](int a, int b) { return rank(a) < rank(b); });
+    return order;
+}
+
+bool CameraMediaBrowser::_isFtpUrl(const QString &url)
+{
+    return url.startsWith(QStringLiteral("%1://").arg(FTPManager::mavlinkFTPScheme), Qt::CaseInsensitive);
+}
+
+bool CameraMediaBrowser::_isHttpUrl(const QString &url)
+{
+    return url.startsWith(QStringLiteral("http://"), Qt::CaseInsensitive) || url.startsWith(QStringLiteral("https://"), Qt::CaseInsensitive);
+}
+
+QString CameraMediaBrowser::_fileName(const QString &url)
+{
+    const qsizetype slash = url.lastIndexOf(QLatin1Char('/'));
+    return (slash >= 0) ? url.mid(slash + 1) : url;
+}
+
+CameraMediaBrowser::Thumbnail CameraMediaBrowser::_makeThumbnail(const QString &path, int maxEdge)
+{
+    QImageReader reader(path);
+    return _scaleThumbnail(reader, maxEdge);
+}
+
+CameraMediaBrowser::Thumbnail CameraMediaBrowser::_makeEmbeddedThumbnail(const QString &path, int maxEdge)
+{
+    Thumbnail thumbnail;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        thumbnail.error = file.errorString();
+        return thumbnail;
+    }
+
+    // libexif only needs the APP1 segment, the truncated image data after it is not read
+    ExifData *const exifData = ExifUtility::loadFromBuffer(file.readAll());
+    if (!exifData) {
+        thumbnail.error = QStringLiteral("No EXIF data");
+        return thumbnail;
+    }
+    QByteArray preview;
+    if (exifData->data && (exifData->size > 0)) {
+        preview = QByteArray(reinterpret_cast<const char*>(exifData->data), static_cast<qsizetype>(exifData->size));
+    }
+    exif_data_unref(exifData);
+    if (preview.isEmpty()) {
+        thumbnail.error = QStringLiteral("No embedded thumbnail");
+        return thumbnail;
+    }
+
+    QBuffer buffer(&preview);
+    (void) buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    return _scaleThumbnail(reader, maxEdge);
+}
+
+CameraMediaBrowser::Thumbnail CameraMediaBrowser::_scaleThumbnail(QImageReader &reader, int maxEdge)
+{
+    Thumbnail thumbnail;
+
+    reader.setAutoTransform(true);
+    const QSize size = reader.size();
+    if (size.isValid() && ((size.width() > maxEdge) || (size.height() > maxEdge))) {
+        // Lets the JPEG decoder skip most of the work instead of scaling the full image afterwards
+        reader.setScaledSize(size.scaled(maxEdge, maxEdge, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        thumbnail.error = reader.errorString();
+        return thumbnail;
+    }
+    if ((image.width() > maxEdge) || (image.height() > maxEdge)) {
+        image = image.scaled(maxEdge, maxEdge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QBuffer buffer(&thumbnail.jpeg);
+    if (!buffer.open(QIODevice::WriteOnly) || !image.save(&buffer, "JPG", 85)) {
+        thumbnail.jpeg.clear();
+        thumbnail.error = QStringLiteral("Could not encode thumbnail");
+    }
+    return thumbnail;
+}
+
+bool CameraMediaBrowser::_needsTransfer(const MediaItem &item) const
+{
+    return item.thumbnailPath.isEmpty() || (item.fullResolutionRequested && item.localFile.isEmpty());
+}
+
+bool CameraMediaBrowser::_canStart(int row) const
+{
+    const MediaItem &item = _items[row];
+    if (item.fullResolutionRequested) {
+        return true;
+    }
+    if (!_active || !_isVisible(row)) {
+        return false;
+    }
+    return !_isFtpUrl(item.fileUrl) || !_vehicle || !_vehicle->armed();
+}
+
+void CameraMediaBrowser::_armedChanged(bool armed)
+{
+    if (armed && (_ftpRow >= 0) && !_items[_ftpRow].fullResolutionRequested) {
+        // A thumbnail is not worth link bandwidth in flight, fetch it again once disarmed
+        const int row = _ftpRow;
+        _ftpRow = -1;
+        FTPManager *const ftp = _vehicle->ftpManager();
+        (void) disconnect(ftp, &FTPManager::downloadComplete, this, &CameraMediaBrowser::_ftpDownloadComplete);
+        ftp->cancelDownload();
+
+        MediaItem &item = _items[row];
+        qCDebug(CameraMediaBrowserLog) << "Armed, stopped FTP thumbnail transfer of" << item.fileUrl;
+        (void) QFile::remove(item.transferFile);
+        item.transferFile.clear();
+        _enqueue(row);
+    }
+
+    _startTransfers();
+}
+
+void CameraMediaBrowser::_enqueue(int row)
+{
+    if (!_queue.contains(row)) {
+        _queue.append(row);
+        emit pendingTransfersChanged();
+    }
+    _setState(row, Queued);
+}
+
+template<typename Accept>
+int CameraMediaBrowser::_takeNext(Accept accept)
+{
+    const QList<int> order = transferOrder();
+    for (const int row : order) {
+        if (accept(row)) {
+            (void) _queue.removeOne(row);
+            return row;
+        }
+    }
+    return -1;
+}
+
+void CameraMediaBrowser::_startTransfers()
+{
+    const int pending = pendingTransfers();
+
+    if ((_ftpRow < 0) && !_ftpRetryTimer.isActive()) {
+        const int row = _takeNext([this](int row) { return _isFtpUrl(_items[row].fileUrl); });
+        if ((row >= 0) && !_startFtpTransfer(row)) {
+            qCDebug(CameraMediaBrowserLog) << "FTPManager busy, retrying";
+            _queue.append(row);
+            _ftpRetryTimer.start();
+        }
+    }
+
+    while (_httpTransfers.count() < _maxHttpTransfers) {
+        const int row = _takeNext([this](int row) { return _isHttpUrl(_items[row].fileUrl); });
+        if (row < 0) {
+            break;
+        }
+        _startHttpTransfer(row);
+    }
+
+    if (pendingTransfers() != pending) {
+        emit pendingTransfersChanged();
+    }
+}
+
+bool CameraMediaBrowser::_startFtpTransfer(int row)
+{
+    if (!_vehicle) {
+        return false;
+    }
+
+    MediaItem &item = _items[row];
+    const QFileInfo transferFile(_transferPath(row));
+    if (!QDir().mkpath(transferFile.absolutePath())) {
+        _transferFinished(row, tr("Could not create %1").arg(transferFile.absolutePath()));
+        return true;
+    }
+
+    FTPManager *const ftp = _vehicle->ftpManager();
+    (void) connect(ftp, &FTPManager::downloadComplete, this, &CameraMediaBrowser::_ftpDownloadComplete, Qt::UniqueConnection);
+    if (!ftp->download(item.compId, item.fileUrl, transferFile.absolutePath(), transferFile.fileName())) {
+        (void) disconnect(ftp, &FTPManager::downloadComplete, this, &CameraMediaBrowser::_ftpDownloadComplete);
+        return false;
+    }
+
+    qCDebug(CameraMediaBrowserLog) << "FTP transfer" << item.fileUrl << "to" << transferFile.absoluteFilePath();
+    item.transferFile = transferFile.absoluteFilePath();
+    _ftpRow = row;
+    _setState(row, Transferring);
+    return true;
+}
+
+void CameraMediaBrowser::_ftpDownloadComplete(const QString &file, const QString &errorMsg)
+{
+    Q_UNUSED(file);
+
+    (void) disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &CameraMediaBrowser::_ftpDownloadComplete);
+
+    const int row = _ftpRow;
+    _ftpRow = -1;
+    if (row >= 0) {
+        _transferFinished(row, errorMsg);
+    }
+    _startTransfers();
+}
+
+void CameraMediaBrowser::_startHttpTransfer(int row)
+{
+    if (!_networkManager) {
+        _networkManager = new QNetworkAccessManager(this);
+        QGCNetworkHelper::configureProxy(_networkManager);
+    }
+
+    MediaItem &item = _items[row];
+    const QFileInfo transferFile(_transferPath(row));
+    (void) QDir().mkpath(transferFile.absolutePath());
+    QFile *const file = new QFile(transferFile.absoluteFilePath());
+    if (!file->open(QIODevice::WriteOnly)) {
+        const QString error = file->errorString();
+        delete file;
+        _transferFinished(row, error);
+        return;
+    }
+
+    QNetworkRequest request((QUrl(item.fileUrl)));
+    item.headerOnly = !item.fullResolutionRequested && !item.noEmbeddedThumbnail;
+    if (item.headerOnly) {
+        request.setRawHeader(QByteArrayLiteral("Range"), QByteArrayLiteral("bytes=0-") + QByteArray::number(kEmbeddedThumbnailBytes - 1));
+    }
+
+    qCDebug(CameraMediaBrowserLog) << "HTTP transfer" << item.fileUrl << "to" << file->fileName() << "header only:" << item.headerOnly;
+    item.transferFile = file->fileName();
+
+    QNetworkReply *const reply = _networkManager->get(request);
+    _httpTransfers.insert(reply, HttpTransfer{ row, file });
+    // Written as it arrives so a large photo never sits in memory
+    (void) connect(reply, &QNetworkReply::readyRead, this, [reply, file]() {
+        (void) file->write(reply->readAll());
+    });
+    (void) connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        _httpTransferFinished(reply);
+    });
+
+    _setState(row, Transferring);
+}
+
+void CameraMediaBrowser::_httpTransferFinished(QNetworkReply *reply)
+{
+    const HttpTransfer transfer = _httpTransfers.take(reply);
+    reply->deleteLater();
+    if (!transfer.file) {
+        return;
+    }
+
+    (void) transfer.file->write(reply->readAll());
+    transfer.file->close();
+    delete transfer.file;
+
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206) {
+        // Server ignored the range, this is the whole file
+        _items[transfer.row].headerOnly = false;
+    }
+
+    _transferFinished(transfer.row, (reply->error() == QNetworkReply::NoError) ? QString() : reply->errorString());
+    _startTransfers();
+}
+
+void CameraMediaBrowser::_transferFinished(int row, const QString &errorMsg)
+{
+    MediaItem &item = _items[row];
+    const QString path = item.transferFile;
+    item.transferFile.clear();
+
+    if (!errorMsg.isEmpty()) {
+        qCWarning(CameraMediaBrowserLog) << "Transfer of" << item.fileUrl << "failed:" << errorMsg;
+        if (!path.isEmpty()) {
+            (void) QFile::remove(path);
+        }
+        if (item.headerOnly) {
+            // Some servers reject ranges, try the whole file
+            item.headerOnly = false;
+            item.noEmbeddedThumbnail = true;
+            _enqueue(row);
+            return;
+        }
+        _setState(row, Failed, errorMsg);
+        return;
+    }
+
+    if (!item.thumbnailPath.isEmpty()) {
+        _finishRow(row, path);
+        return;
+    }
+
+    _setState(row, Decoding);
+    const quint64 generation = _generation;
+    Thumbnail (*const makeThumbnail)(const QString&, int) = item.headerOnly ? &CameraMediaBrowser::_makeEmbeddedThumbnail : &CameraMediaBrowser::_makeThumbnail;
+    (void) QtConcurrent::run(&_decodePool, makeThumbnail, path, kThumbnailMaxEdge)
+        .then(this, [this, row, path, generation](const Thumbnail &thumbnail) {
+            if (generation != _generation) {
+                // Cleared while decoding, the transfer directory copy is no longer wanted
+                if (path.startsWith(_transferDir.path())) {
+                    (void) QFile::remove(path);
+                }
+                return;
+            }
+            _thumbnailDecoded(row, path, thumbnail);
+        });
+}
+
+void CameraMediaBrowser::_thumbnailDecoded(int row, const QString &path, const Thumbnail &thumbnail)
+{
+    MediaItem &item = _items[row];
+    const bool headerOnly = item.headerOnly;
+    item.headerOnly = false;
+
+    if (thumbnail.jpeg.isEmpty() && headerOnly) {
+        qCDebug(CameraMediaBrowserLog) << "No embedded thumbnail in" << item.fileUrl << thumbnail.error;
+        item.noEmbeddedThumbnail = true;
+    } else if (thumbnail.jpeg.isEmpty()) {
+        qCWarning(CameraMediaBrowserLog) << "Could not decode" << item.fileUrl << thumbnail.error;
+        item.error = thumbnail.error;
+    } else {
+        item.thumbnailPath = _thumbnailCache->insert(item.cacheKey, thumbnail.jpeg);
+        if (item.thumbnailPath.isEmpty()) {
+            item.error = tr("Could not cache thumbnail");
+        } else {
+            emit thumbnailReady(row);
+        }
+    }
+
+    if (headerOnly) {
+        // Only the start of the file, never kept as the full resolution copy
+        (void) QFile::remove(path);
+        if (item.error.isEmpty() && _needsTransfer(item)) {
+            _enqueue(row);
+            _startTransfers();
+        } else {
+            _setState(row, item.error.isEmpty() ? Ready : Failed, item.error);
+        }
+        return;
+    }
+
+    _finishRow(row, path);
+}
+
+void CameraMediaBrowser::_finishRow(int row, const QString &path)
+{
+    MediaItem &item = _items[row];
+
+    if (item.fullResolutionRequested && item.localFile.isEmpty()) {
+        const QString destination = _fullResolutionPath(item);
+        if (path != destination) {
+            // Requested while the thumbnail transfer was running, move it instead of transferring again
+            (void) QDir().mkpath(QFileInfo(destination).absolutePath());
+            (void) QFile::remove(destination);
+            if (!QFile::rename(path, destination) && (!QFile::copy(path, destination) || !QFile::remove(path))) {
+                qCWarning(CameraMediaBrowserLog) << "Could not move" << path << "to" << destination;
+            }
+        }
+        if (QFile::exists(destination)) {
+            item.localFile = destination;
+            emit fullResolutionReady(row);
+        } else if (item.error.isEmpty()) {
+            item.error = tr("Could not save %1").arg(destination);
+        }
+    } else if (path != item.localFile) {
+        (void) QFile::remove(path);
+    }
+
+    _setState(row, item.error.isEmpty() ? Ready : Failed, item.error);
+}
+
+void CameraMediaBrowser::_setState(int row, MediaState state, const QString &error)
+{
+    MediaItem &item = _items[row];
+    item.state = state;
+    item.error = error;
+    _emitRowChanged(row);
+}
+
+QString CameraMediaBrowser::_transferPath(int row) const
+{
+    const MediaItem &item = _items[row];
+    if (item.fullResolutionRequested) {
+        return _fullResolutionPath(item);
+    }
+    return _transferDir.filePath(QStringLiteral("%1_%2").arg(row).arg(_fileName(item.fileUrl)));
+}
+
+QString CameraMediaBrowser::_fullResolutionPath(const MediaItem &item) const
+{
+    const bool cameraComponent = (item.compId >= MAV_COMP_ID_CAMERA) && (item.compId <= MAV_COMP_ID_CAMERA6);
+    const int camera = cameraComponent ? (item.compId - MAV_COMP_ID_CAMERA + 1) : item.compId;
+    return QDir(_downloadDirectory).filePath(QStringLiteral("Camera%1/%2").arg(camera).arg(_fileName(item.fileUrl)));
+}
+
+void CameraMediaBrowser::_cancelTransfers()
+{
+    _ftpRetryTimer.stop();
+
+    if (_ftpRow >= 0) {
+        _ftpRow = -1;
+        if (_vehicle) {
+            FTPManager *const ftp = _vehicle->ftpManager();
+            (void) disconnect(ftp, &FTPManager::downloadComplete, this, &CameraMediaBrowser::_ftpDownloadComplete);
+            ftp->cancelDownload();
+        }
+    }
+
+    for (auto it = _httpTransfers.constBegin(); it != _httpTransfers.constEnd(); it++) {
+        QNetworkReply *const reply = it.key();
+        (void) disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+        it->file->close();
+        (void) it->file->remove();
+        delete it->file;
+    }
+    _httpTransfers.clear();
+}
+
+void CameraMediaBrowser::_emitRowChanged(int row)
+{
+    const QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex);
+}
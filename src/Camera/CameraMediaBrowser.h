@@ -0,0 +1,204 @@
+#pragma once
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+#include <memory>
+
+#include "CameraThumbnailCache.h"
+#include "MAVLinkLib.h"
+
+class QFile;
+class QImageReader;
+class QNetworkAccessManager;
+class QNetworkReply;
+class Vehicle;
+
+/// Browses the media captured by the cameras of a vehicle.
+///
+/// Every successful CAMERA_IMAGE_CAPTURED with a file URL adds a row; adding a row never starts a transfer. Media the
+/// camera stored before the browser saw it is not enumerated. Thumbnails are only fetched for rows on screen while the
+/// browser is open (see active and setVisibleRange), full resolution copies whenever the user asks for one.
+///
+/// Files are transferred with HTTP or MAVLink FTP (mftp://), several HTTP transfers at a time and one FTP transfer, as
+/// FTPManager has a single session per vehicle. Over HTTP the thumbnail is taken from the preview the camera embeds in
+/// the EXIF segment, which only needs the start of the file; the whole file is fetched if there is none. FTP shares
+/// the vehicle link, so thumbnails are never fetched over FTP while the vehicle is armed. Thumbnails are decoded and
+/// scaled on a worker pool and kept in a size-capped disk cache, so a file is only transferred again for its full
+/// resolution copy. Requested full resolution copies are started first, then the thumbnails of visible rows.
+class CameraMediaBrowser : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+    Q_PROPERTY(int      count               READ count                                              NOTIFY countChanged)
+    Q_PROPERTY(bool     active              READ active             WRITE setActive                 NOTIFY activeChanged)
+    Q_PROPERTY(int      pendingTransfers    READ pendingTransfers                                   NOTIFY pendingTransfersChanged)
+    Q_PROPERTY(int      maxHttpTransfers    READ maxHttpTransfers   WRITE setMaxHttpTransfers       NOTIFY maxHttpTransfersChanged)
+    Q_PROPERTY(QString  downloadDirectory   READ downloadDirectory  WRITE setDownloadDirectory      NOTIFY downloadDirectoryChanged)
+
+public:
+    enum MediaState {
+        Queued,         ///< Waiting for a transfer
+        Transferring,
+        Decoding,       ///< Making the thumbnail
+        Ready,
+        Failed,
+    };
+    Q_ENUM(MediaState)
+
+    enum Roles {
+        CompIdRole = Qt::UserRole + 1,
+        ImageIndexRole,
+        FileUrlRole,
+        FileNameRole,
+        CoordinateRole,
+        CaptureTimeRole,
+        StateRole,
+        ThumbnailUrlRole,           ///< file:// URL of the cached thumbnail, empty until there is one
+        FullResolutionRequestedRole,
+        LocalFileRole,              ///< Full resolution copy in the download directory, empty until downloaded
+        ErrorRole,
+    };
+    Q_ENUM(Roles)
+
+    explicit CameraMediaBrowser(Vehicle *vehicle, QObject *parent = nullptr);
+    ~CameraMediaBrowser() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return static_cast<int>(_items.count()); }
+    /// true while the browser is shown, thumbnails are only fetched then
+    bool active() const { return _active; }
+    void setActive(bool active);
+    int pendingTransfers() const { return static_cast<int>(_queue.count()); }
+    int transfersInFlight() const { return static_cast<int>(_httpTransfers.count()) + ((_ftpRow >= 0) ? 1 : 0); }
+    int maxHttpTransfers() const { return _maxHttpTransfers; }
+    void setMaxHttpTransfers(int maxHttpTransfers);
+    QString downloadDirectory() const { return _downloadDirectory; }
+    void setDownloadDirectory(const QString &directory);
+
+    /// Replaces the thumbnail cache, e.g. to place it elsewhere or change its size cap
+    void setThumbnailCache(const QString &directory, qint64 maxBytes);
+    CameraThumbnailCache *thumbnailCache() { return _thumbnailCache.get(); }
+
+    /// Rows currently on screen; @p last < @p first when nothing is shown
+    Q_INVOKABLE void setVisibleRange(int first, int last);
+    /// Keeps a full resolution copy of @p row in the download directory
+    Q_INVOKABLE void downloadFullResolution(int row);
+    /// Forgets all media and cancels the transfers; cached thumbnails are kept
+    Q_INVOKABLE void clear();
+
+    /// Adds the image reported by @p compId unless it failed, has no file URL or is already known
+    void addCapturedImage(uint8_t compId, const mavlink_camera_image_captured_t &imageCaptured);
+
+    /// Queued rows which may start now, in the order their transfers will be started
+    QList<int> transferOrder() const;
+
+    static constexpr int kDefaultMaxHttpTransfers = 4;
+    /// Range requested for the embedded thumbnail, an APP1 segment is at most 64 KiB
+    static constexpr qint64 kEmbeddedThumbnailBytes = 64 * 1024;
+    static constexpr int kThumbnailMaxEdge = 256;
+    static constexpr qint64 kDefaultThumbnailCacheBytes = 64 * 1024 * 1024;
+
+signals:
+    void countChanged();
+    void activeChanged();
+    void pendingTransfersChanged();
+    void maxHttpTransfersChanged();
+    void downloadDirectoryChanged();
+    void thumbnailReady(int row);
+    void fullResolutionReady(int row);
+
+private slots:
+    void _ftpDownloadComplete(const QString &file, const QString &errorMsg);
+    void _startTransfers();
+    void _armedChanged(bool armed);
+
+private:
+    struct MediaItem {
+        uint8_t compId = 0;
+        int imageIndex = 0;
+        QString fileUrl;
+        QString cacheKey;
+        QGeoCoordinate coordinate;
+        QDateTime captureTime;
+        MediaState state = Queued;
+        QString thumbnailPath;
+        QString localFile;
+        QString transferFile;           ///< Where the running transfer writes to
+        QString error;
+        bool fullResolutionRequested = false;
+        bool headerOnly = false;                ///< Running transfer is the range request for the embedded thumbnail
+        bool noEmbeddedThumbnail = false;       ///< The embedded thumbnail was tried, the whole file is needed
+    };
+
+    struct HttpTransfer {
+        int row = -1;
+        QFile *file = nullptr;
+    };
+
+    struct Thumbnail {
+        QByteArray jpeg;
+        QString error;
+    };
+
+    static bool _isFtpUrl(const QString &url);
+    static bool _isHttpUrl(const QString &url);
+    static QString _fileName(const QString &url);
+    static Thumbnail _makeThumbnail(const QString &path, int maxEdge);
+    /// Thumbnail from the EXIF preview in the start of the image at @p path
+    static Thumbnail _makeEmbeddedThumbnail(const QString &path, int maxEdge);
+    static Thumbnail _scaleThumbnail(QImageReader &reader, int maxEdge);
+
+    bool _needsTransfer(const MediaItem &item) const;
+    bool _isVisible(int row) const { return (row >= _visibleFirst) && (row <= _visibleLast); }
+    /// Thumbnail transfers wait for the row to be shown, FTP ones also for the vehicle to be disarmed
+    bool _canStart(int row) const;
+    void _enqueue(int row);
+    /// @return Best queued row for which @p accept is true, -1 if there is none
+    template<typename Accept>
+    int _takeNext(Accept accept);
+    bool _startFtpTransfer(int row);
+    void _startHttpTransfer(int row);
+    void _httpTransferFinished(QNetworkReply *reply);
+    void _transferFinished(int row, const QString &errorMsg);
+    void _thumbnailDecoded(int row, const QString &path, const Thumbnail &thumbnail);
+    /// Keeps the transferred @p path as the full resolution copy if one was requested, otherwise removes it
+    void _finishRow(int row, const QString &path);
+    void _setState(int row, MediaState state, const QString &error = QString());
+    QString _transferPath(int row) const;
+    QString _fullResolutionPath(const MediaItem &item) const;
+    void _cancelTransfers();
+    void _emitRowChanged(int row);
+
+    Vehicle *_vehicle = nullptr;
+    QList<MediaItem> _items;
+    QHash<QString, int> _rowByKey;
+    QList<int> _queue;                              ///< Rows waiting for a transfer, unordered
+    QHash<QNetworkReply*, HttpTransfer> _httpTransfers;
+    int _ftpRow = -1;                               ///< Row of the running FTP transfer
+    int _visibleFirst = 0;
+    int _visibleLast = -1;
+    bool _active = false;
+    int _maxHttpTransfers = kDefaultMaxHttpTransfers;
+    quint64 _generation = 0;                        ///< Bumped by clear() so late decodes are dropped
+    QString _downloadDirectory;
+    QNetworkAccessManager *_networkManager = nullptr;
+    std::unique_ptr<CameraThumbnailCache> _thumbnailCache;
+    QThreadPool _decodePool;
+    QTemporaryDir _transferDir;                     ///< Originals only needed for their thumbnail
+    QTimer _ftpRetryTimer;                          ///< FTPManager was busy with another operation
+
+    static constexpr int _ftpRetryMsecs = 250;
+};
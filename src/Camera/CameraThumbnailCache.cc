@@ -0,0 +1,132 @@
+#include "CameraThumbnailCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(CameraThumbnailCacheLog, "Camera.CameraThumbnailCache")
+
+CameraThumbnailCache::CameraThumbnailCache(const QString &directory, qint64 maxBytes)
+    : _dir(directory)
+    , _maxBytes(maxBytes)
+{
+    if (!_dir.exists() && !_dir.mkpath(QStringLiteral("."))) {
+        qCWarning(CameraThumbnailCacheLog) << "Failed to create cache directory" << directory;
+        return;
+    }
+
+    QFileInfoList files = _dir.entryInfoList({ QStringLiteral("*") + QLatin1String(fileExtension) }, QDir::Files);
+    std::sort(files.begin(), files.end(), [](const QFileInfo &a, const QFileInfo &b) {
+        return a.lastModified() < b.lastModified();
+    });
+    for (const QFileInfo &file : std::as_const(files)) {
+        Entry &entry = _entries[file.completeBaseName()];
+        entry.bytes = file.size();
+        entry.lastUse = _nextUse++;
+        _byUse.insert(entry.lastUse, file.completeBaseName());
+        _totalBytes += entry.bytes;
+    }
+
+    qCDebug(CameraThumbnailCacheLog) << "Opened" << directory << "entries:" << _entries.count() << "bytes:" << _totalBytes;
+    _evict();
+}
+
+QString CameraThumbnailCache::key(uint8_t compId, const QString &fileUrl)
+{
+    const QByteArray source = QByteArray::number(compId) + '|' + fileUrl.toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(source, QCryptographicHash::Sha1).toHex());
+}
+
+QString CameraThumbnailCache::lookup(const QString &key)
+{
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return QString();
+    }
+
+    const QString path = _filePath(key);
+    if (!QFile::exists(path)) {
+        // Removed behind our back
+        _totalBytes -= it->bytes;
+        _byUse.remove(it->lastUse);
+        _entries.erase(it);
+        return QString();
+    }
+
+    _touch(key, *it);
+    QFile file(path);
+    if (file.open(QIODevice::ReadWrite)) {
+        (void) file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+    return path;
+}
+
+QString CameraThumbnailCache::insert(const QString &key, const QByteArray &data)
+{
+    const QString path = _filePath(key);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || (file.write(data) != data.size()) || !file.commit()) {
+        qCWarning(CameraThumbnailCacheLog) << "Failed to write" << path << file.errorString();
+        return QString();
+    }
+
+    Entry &entry = _entries[key];
+    _totalBytes += data.size() - entry.bytes;
+    entry.bytes = data.size();
+    _touch(key, entry);
+
+    _evict();
+    return _entries.contains(key) ? path : QString();
+}
+
+void CameraThumbnailCache::remove(const QString &key)
+{
+    const auto it = _entries.constFind(key);
+    if (it == _entries.constEnd()) {
+        return;
+    }
+
+    (void) QFile::remove(_filePath(key));
+    _totalBytes -= it->bytes;
+    _byUse.remove(it->lastUse);
+    _entries.erase(it);
+}
+
+void CameraThumbnailCache::clear()
+{
+    for (auto it = _entries.constBegin(); it != _entries.constEnd(); it++) {
+        (void) QFile::remove(_filePath(it.key()));
+    }
+    _entries.clear();
+    _byUse.clear();
+    _totalBytes = 0;
+}
+
+void CameraThumbnailCache::setMaxBytes(qint64 maxBytes)
+{
+    _maxBytes = maxBytes;
+    _evict();
+}
+
+void CameraThumbnailCache::_touch(const QString &key, Entry &entry)
+{
+    if (entry.lastUse != 0) {
+        (void) _byUse.remove(entry.lastUse);
+    }
+    entry.lastUse = _nextUse++;
+    _byUse.insert(entry.lastUse, key);
+}
+
+void CameraThumbnailCache::_evict()
+{
+    while ((_totalBytes > _maxBytes) && !_byUse.isEmpty()) {
+        const QString key = _byUse.first();
+        qCDebug(CameraThumbnailCacheLog) << "Evicting" << key;
+        remove(key);
+    }
+}
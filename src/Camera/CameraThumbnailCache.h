@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+/// Size-capped on-disk cache of camera media thumbnails with LRU retention.
+///
+/// Thumbnails are keyed by camera component and file URL, so the same file name on two cameras or two storage
+/// locations never collides. Entries already on disk are picked up on construction, oldest first by modification
+/// time, which is refreshed on every hit so the retention order survives restarts.
+/// Notes:
+/// - only one instance per directory must exist
+/// - not thread-safe
+class CameraThumbnailCache
+{
+public:
+    CameraThumbnailCache(const QString &directory, qint64 maxBytes);
+
+    static QString key(uint8_t compId, const QString &fileUrl);
+
+    /// @return Path of the cached thumbnail, empty if there is none. Marks the entry as most recently used.
+    QString lookup(const QString &key);
+    bool contains(const QString &key) const { return _entries.contains(key); }
+
+    /// Stores the encoded thumbnail @p data, evicting least recently used entries until the cache fits its cap
+    /// @return Path of the cached thumbnail, empty on error
+    QString insert(const QString &key, const QByteArray &data);
+    void remove(const QString &key);
+    void clear();
+
+    QString directory() const { return _dir.path(); }
+    int count() const { return static_cast<int>(_entries.count()); }
+    qint64 totalBytes() const { return _totalBytes; }
+    qint64 maxBytes() const { return _maxBytes; }
+    void setMaxBytes(qint64 maxBytes);
+
+    static constexpr const char *fileExtension = ".jpg";
+
+private:
+    struct Entry {
+        qint64 bytes = 0;
+        quint64 lastUse = 0;    ///< 0 until the entry is first used
+    };
+
+    QString _filePath(const QString &key) const { return _dir.filePath(key + QLatin1String(fileExtension)); }
+    void _touch(const QString &key, Entry &entry);
+    void _evict();
+
+    QDir _dir;
+    qint64 _maxBytes = 0;
+    qint64 _totalBytes = 0;
+    quint64 _nextUse = 1;
+    QHash<QString, Entry> _entries;
+    QMap<quint64, QString> _byUse;  ///< Last use to key, least recently used first
+};
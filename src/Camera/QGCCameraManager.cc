@@ -1,4 +1,5 @@
 #include "QGCCameraManager.h"
+#include "CameraMediaBrowser.h"
 #include "CameraMetaData.h"
 #include "FirmwarePlugin.h"
 #include "Joystick.h"
@@ -76,6 +77,7 @@ QGCCameraManager::QGCCameraManager(Vehicle *vehicle)
     : QObject(vehicle)
     , _vehicle(vehicle)
     , _simulatedCameraControl(new SimulatedCameraControl(vehicle, this))
+    , _mediaBrowser(new CameraMediaBrowser(vehicle, this))
 {
     qCDebug(CameraManagerLog) << this;
 
@@ -192,6 +194,9 @@ void QGCCameraManager::_mavlinkMessageReceived(const mavlink_message_t &message)
         case MAVLINK_MSG_ID_CAMERA_FOV_STATUS:
             _handleCameraFovStatus(message);
             break;
+        case MAVLINK_MSG_ID_CAMERA_IMAGE_CAPTURED:
+            _handleCameraImageCaptured(message);
+            break;
         default:
             break;
         }
@@ -503,6 +508,13 @@ void QGCCameraManager::_handleTrackingImageStatus(const mavlink_message_t &messa
     }
 }
 
+void QGCCameraManager::_handleCameraImageCaptured(const mavlink_message_t &message)
+{
+    mavlink_camera_image_captured_t imageCaptured{};
+    mavlink_msg_camera_image_captured_decode(&message, &imageCaptured);
+    _mediaBrowser->addCapturedImage(message.compid, imageCaptured);
+}
+
 static void _handleCameraInfoRetry(QGCCameraManager::CameraStruct *cameraInfo);
 
 static void _requestCameraInfoCommandResultHandler(void *resultHandlerData, int /*compId*/, const mavlink_command_ack_t &ack, Vehicle::MavCmdResultFailureCode_t failureCode)
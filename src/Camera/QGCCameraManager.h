@@ -13,6 +13,7 @@
 
 class Vehicle;
 
+class CameraMediaBrowser;
 class CameraMetaData;
 class Joystick;
 class MavlinkCameraControlInterface;
@@ -27,6 +28,7 @@ class QGCCameraManager : public QObject
     Q_OBJECT
     QML_ELEMENT
     QML_UNCREATABLE("")
+    Q_MOC_INCLUDE("CameraMediaBrowser.h")
     Q_MOC_INCLUDE("Joystick.h")
     Q_MOC_INCLUDE("MavlinkCameraControlInterface.h")
 
@@ -35,6 +37,7 @@ class QGCCameraManager : public QObject
     Q_PROPERTY(MavlinkCameraControlInterface* currentCameraInstance READ currentCameraInstance NOTIFY currentCameraChanged)
     Q_PROPERTY(int currentCamera READ currentCamera WRITE setCurrentCamera NOTIFY currentCameraChanged)
     Q_PROPERTY(int currentZoomLevel READ currentZoomLevel NOTIFY currentZoomLevelChanged)
+    Q_PROPERTY(CameraMediaBrowser* mediaBrowser READ mediaBrowser CONSTANT)
 
 #ifdef QGC_UNITTEST_BUILD
     friend class QGCCameraManagerTest;
@@ -72,6 +75,7 @@ class QGCCameraManager : public QObject
     const QVariantList& cameraList() const;
 
     Vehicle* vehicle() const { return _vehicle; }
+    CameraMediaBrowser* mediaBrowser() const { return _mediaBrowser; }
 
     CameraStruct* findCameraStruct(uint8_t compId) const { return _cameraInfoRequest.value(QString::number(compId), nullptr); }
 
@@ -127,11 +131,13 @@ private slots:
     void _handleVideoStreamStatus(const mavlink_message_t& message);
     void _handleBatteryStatus(const mavlink_message_t& message);
     void _handleTrackingImageStatus(const mavlink_message_t& message);
+    void _handleCameraImageCaptured(const mavlink_message_t& message);
     void _addCameraControlToLists(MavlinkCameraControlInterface* cameraControl);
     void _handleCameraFovStatus(const mavlink_message_t& message);
 
     Vehicle* _vehicle;              ///< Raw pointer is safe: QGCCameraManager is a QObject child of Vehicle, so Vehicle always outlives us
     QPointer<SimulatedCameraControl> _simulatedCameraControl;
+    CameraMediaBrowser* _mediaBrowser = nullptr;
     QPointer<Joystick> _activeJoystick;
     bool _vehicleReadyState = false;
     int _currentTask = 0;
@@ -22,6 +22,9 @@
 #include "SerialLink.h"
 #include "GPSManager.h"
 #include "GPSRtk.h"
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#include "SerialPortHotplugWatcher.h"
+#endif
 #endif
 
 #ifdef QT_DEBUG
@@ -69,6 +72,9 @@ void LinkManager::init()
     if (!QGC::runningUnitTests()) {
         (void) connect(_portListTimer, &QTimer::timeout, this, &LinkManager::_updateAutoConnectLinks);
         _portListTimer->start(_autoconnectUpdateTimerMSecs); // timeout must be long enough to get past bootloader on second pass
+#if !defined(QGC_NO_SERIAL_LINK) && defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+        _startSerialHotplugWatcher();
+#endif
     }
 }
 
@@ -834,10 +840,10 @@ void LinkManager::_addSerialAutoConnectLink()
     // port is connected leaks file handles due to a bug somewhere in android serial code. In order to work around that
     // bug after we connect the first serial port we stop probing for additional ports.
     if (!_isSerialPortConnected()) {
-        portList = QGCSerialPortInfo::availablePorts();
+        portList = _availableSerialPorts();
     }
 #else
-    portList = QGCSerialPortInfo::availablePorts();
+    portList = _availableSerialPorts();
 #endif
 
     _filterCompositePorts(portList);
@@ -894,10 +900,10 @@ void LinkManager::_addSerialAutoConnectLink()
             } else if (!_autoconnectPortWaitList.contains(portInfo.systemLocation())) {
                 // We don't connect to the port the first time we see it. The ability to correctly detect whether we
                 // are in the bootloader is flaky from a cross-platform standpoint. So by putting it on a wait list
-                // and only connect on the second pass we leave enough time for the board to boot up.
-                qCDebug(LinkManagerLog) << "Waiting for next autoconnect pass" << portInfo.systemLocation() << boardName;
-                _autoconnectPortWaitList[portInfo.systemLocation()] = 1;
-            } else if ((++_autoconnectPortWaitList[portInfo.systemLocation()] * _autoconnectUpdateTimerMSecs) > _autoconnectConnectDelayMSecs) {
+                // and only connecting once the connect delay has passed we leave enough time for the board to boot up.
+                qCDebug(LinkManagerLog) << "Waiting for connect delay" << portInfo.systemLocation() << boardName;
+                _waitForConnectDelay(portInfo.systemLocation());
+            } else if (_autoconnectPortWaitList.value(portInfo.systemLocation()).hasExpired()) {
                 SerialConfiguration* pSerialConfig = nullptr;
                 _autoconnectPortWaitList.remove(portInfo.systemLocation());
                 switch (boardType) {
@@ -935,6 +941,12 @@ void LinkManager::_addSerialAutoConnectLink()
         }
     }
 
+    // Ports gone after their delay are forgotten, so plugging them in again waits again. A port still within its delay
+    // is kept: after a hotplug event the enumeration may not list it yet.
+    for (auto it = _autoconnectPortWaitList.begin(); it != _autoconnectPortWaitList.end();) {
+        it = (it->hasExpired() && !currentPorts.contains(it.key())) ? _autoconnectPortWaitList.erase(it) : std::next(it);
+    }
+
     // Check for RTK GPS connection gone
     if (!_autoConnectRTKPort.isEmpty() && !currentPorts.contains(_autoConnectRTKPort)) {
         qCDebug(LinkManagerLog) << "RTK GPS disconnected" << _autoConnectRTKPort;
@@ -943,6 +955,32 @@ void LinkManager::_addSerialAutoConnectLink()
     }
 }
 
+void LinkManager::_waitForConnectDelay(const QString &systemLocation)
+{
+    // Another pass runs as soon as the delay is over, rather than on whichever autoconnect pass happens to follow it. A
+    // precise timer does not fire before the deadline it was started after.
+    _autoconnectPortWaitList[systemLocation] = QDeadlineTimer(_autoconnectConnectDelayMSecs);
+    QTimer::singleShot(_autoconnectConnectDelayMSecs, Qt::PreciseTimer, this, [this, systemLocation]() {
+        _connectDelayExpired(systemLocation);
+    });
+}
+
+void LinkManager::_connectDelayExpired(const QString &systemLocation)
+{
+    // Connected or unplugged in the meantime, or plugged in again and waiting for a later timer
+    const auto it = _autoconnectPortWaitList.constFind(systemLocation);
+    if ((it == _autoconnectPortWaitList.constEnd()) || !it->hasExpired() || _connectionsSuspended) {
+        return;
+    }
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    // udev may not have published the USB descriptors yet when the device node appeared
+    _serialPortTableValid = false;
+#endif
+
+    _addSerialAutoConnectLink();
+}
+
 bool LinkManager::_allowAutoConnectToBoard(QGCSerialPortInfo::BoardType_t boardType) const
 {
     switch (boardType) {
@@ -991,7 +1029,7 @@ void LinkManager::_updateSerialPorts()
 {
     _commPortList.clear();
     _commPortDisplayList.clear();
-    const QList<QGCSerialPortInfo> portList = QGCSerialPortInfo::availablePorts();
+    const QList<QGCSerialPortInfo> portList = _availableSerialPorts();
     for (const QGCSerialPortInfo &info: portList) {
         const QString port = info.systemLocation().trimmed();
         _commPortList += port;
@@ -1035,4 +1073,69 @@ bool LinkManager::_isSerialPortConnected()
     return false;
 }
 
+QList<QGCSerialPortInfo> LinkManager::_availableSerialPorts()
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    if (_serialHotplugWatcher) {
+        // Only hotplug events change the port list, so it is enumerated once per event instead of on every pass
+        if (!_serialPortTableValid) {
+            _serialPortTable = QGCSerialPortInfo::availablePorts();
+            _serialPortTableValid = true;
+        }
+        return _serialPortTable;
+    }
+#endif
+
+    return QGCSerialPortInfo::availablePorts();
+}
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+
+void LinkManager::_startSerialHotplugWatcher()
+{
+    _serialHotplugWatcher = new SerialPortHotplugWatcher(this);
+    if (!_serialHotplugWatcher->start()) {
+        qCDebug(LinkManagerLog) << "Serial hotplug detection not available, polling for ports";
+        delete _serialHotplugWatcher;
+        _serialHotplugWatcher = nullptr;
+        return;
+    }
+
+    (void) connect(_serialHotplugWatcher, &SerialPortHotplugWatcher::portAdded, this, &LinkManager::_serialPortAdded);
+    (void) connect(_serialHotplugWatcher, &SerialPortHotplugWatcher::portRemoved, this, &LinkManager::_serialPortRemoved);
+    (void) connect(_serialHotplugWatcher, &SerialPortHotplugWatcher::stopped, this, [this]() {
+        qCWarning(LinkManagerLog) << "Serial hotplug detection stopped, polling for ports";
+        _serialHotplugWatcher->deleteLater();
+        _serialHotplugWatcher = nullptr;
+        _serialPortTableValid = false;
+    });
+}
+
+void LinkManager::_serialPortAdded(const QString &systemLocation)
+{
+    _serialPortTableValid = false;
+
+    // The delay starts when the node appears, also for a port replugged before a pass noticed it was gone
+    if (!_portAlreadyConnected(systemLocation)) {
+        _waitForConnectDelay(systemLocation);
+    }
+
+    if (!_connectionsSuspended) {
+        _addSerialAutoConnectLink();
+    }
+}
+
+void LinkManager::_serialPortRemoved(const QString &systemLocation)
+{
+    _serialPortTableValid = false;
+    (void) _autoconnectPortWaitList.remove(systemLocation);
+
+    if (!_connectionsSuspended) {
+        // Notices a disconnected RTK GPS right away
+        _addSerialAutoConnectLink();
+    }
+}
+
+#endif // Q_OS_LINUX && !Q_OS_ANDROID
+
 #endif // QGC_NO_SERIAL_LINK
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QMutexLocker>
@@ -21,6 +22,7 @@ class MAVLinkProtocol;
 class QmlObjectListModel;
 class QTimer;
 class SerialLink;
+class SerialPortHotplugWatcher;
 class UDPConfiguration;
 class UdpIODevice;
 
@@ -192,8 +194,12 @@ private slots:
     void _addSerialAutoConnectLink();
     bool _portAlreadyConnected(const QString &portName);
     void _filterCompositePorts(QList<QGCSerialPortInfo> &portList);
+    QList<QGCSerialPortInfo> _availableSerialPorts();
 
-    QMap<QString, int> _autoconnectPortWaitList;   ///< key: QGCSerialPortInfo::systemLocation, value: wait count
+    void _waitForConnectDelay(const QString &systemLocation);
+    void _connectDelayExpired(const QString &systemLocation);
+
+    QMap<QString, QDeadlineTimer> _autoconnectPortWaitList;   ///< key: QGCSerialPortInfo::systemLocation, value: end of the connect delay since the port appeared
     QList<SerialLink*> _activeLinkCheckList;       ///< List of links we are waiting for a vehicle to show up on
     QStringList _commPortList;
     QStringList _commPortDisplayList;
@@ -201,6 +207,16 @@ private slots:
     QString _nmeaDeviceName;
     uint32_t _nmeaBaud = 0;
     QSerialPort *_nmeaPort = nullptr;
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    void _startSerialHotplugWatcher();
+    void _serialPortAdded(const QString &systemLocation);
+    void _serialPortRemoved(const QString &systemLocation);
+
+    SerialPortHotplugWatcher *_serialHotplugWatcher = nullptr;  ///< nullptr: ports are found by polling availablePorts()
+    QList<QGCSerialPortInfo> _serialPortTable;     ///< availablePorts() as of the last hotplug event
+    bool _serialPortTableValid = false;
+#endif
 #endif // QGC_NO_SERIAL_LINK
 
     // NMEA UDP is network-only; available regardless of QGC_NO_SERIAL_LINK.
@@ -23,6 +23,7 @@
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
+#include "TelemetryShmPublisher.h"
 
 QGC_LOGGING_CATEGORY(MAVLinkProtocolLog, "Comms.MAVLinkProtocol")
 
@@ -54,6 +55,15 @@ void MAVLinkProtocol::init()
     (void)connect(MultiVehicleManager::instance(), &MultiVehicleManager::vehicleRemoved, this,
                   &MAVLinkProtocol::_vehicleCountChanged);
 
+    MavlinkSettings* const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    (void)connect(mavlinkSettings->sharedMemoryExport(), &Fact::rawValueChanged, this,
+                  &MAVLinkProtocol::_updateSharedMemoryExport);
+    (void)connect(mavlinkSettings->sharedMemoryExportName(), &Fact::rawValueChanged, this,
+                  &MAVLinkProtocol::_updateSharedMemoryExport);
+    (void)connect(mavlinkSettings->sharedMemoryExportOtherUsers(), &Fact::rawValueChanged, this,
+                  &MAVLinkProtocol::_updateSharedMemoryExport);
+    _updateSharedMemoryExport();
+
     _initialized = true;
 }
 
@@ -107,12 +117,16 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray& data)
         return;
     }
 
+    // The parser assembles each message in its channel state and copies it out on completion only, so one frame
+    // and status serve the whole buffer. The frame is replaced only when a receiver kept a reference to it.
+    MAVLinkFrame frame = MAVLinkFrame::allocate();
+    mavlink_status_t status{};
+
     for (uint8_t byte : data) {
         const uint8_t mavlinkChannel = link->mavlinkChannel();
-        mavlink_message_t message{};
-        mavlink_status_t status{};
 
-        const uint8_t framing = mavlink_parse_char(mavlinkChannel, byte, &message, &status);
+        const uint8_t framing = mavlink_parse_char(mavlinkChannel, byte, &frame.detach(), &status);
+        const mavlink_message_t& message = frame.message();
         if (framing == MAVLINK_FRAMING_OK || framing == MAVLINK_FRAMING_BAD_SIGNATURE) {
             if (SigningController* const sigCtrl = link->signing()) {
                 // Auto-detected key: reset sequence tracking so the key-install gap isn't counted as loss.
@@ -135,15 +149,21 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray& data)
         if (!isV1) {
             _updateCounters(mavlinkChannel, message);
         }
+        _sinkFrameLength = -1;
         if (!linkPtr->linkConfiguration()->isForwarding()) {
             _forward(message);
             _forwardSupport(message);
         }
         _logData(link, message);
+        _exportSharedMemory(mavlinkChannel, message);
 
-        if (!_updateStatus(link, linkPtr, mavlinkChannel, message)) {
+        if (!_updateStatus(link, linkPtr, mavlinkChannel, frame)) {
             break;
         }
+
+        if (frame.isShared()) {
+            frame = MAVLinkFrame::allocate();
+        }
     }
 }
 
@@ -196,7 +216,7 @@ void MAVLinkProtocol::_forward(const mavlink_message_t& message)
     }
 
     // Strip signature on forward: foreign key would BAD_SIGNATURE on downstream signing-aware parsers.
-    const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
+    const QByteArrayView bytes = _sinkFrame(message);
     (void)forwardingLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
 }
 
@@ -215,23 +235,65 @@ void MAVLinkProtocol::_forwardSupport(const mavlink_message_t& message)
         return;
     }
 
-    const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
+    const QByteArrayView bytes = _sinkFrame(message);
     (void)forwardingSupportLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
 }
 
+void MAVLinkProtocol::_exportSharedMemory(uint8_t mavlinkChannel, const mavlink_message_t& message)
+{
+    if (!_shmPublisher || (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING)) {
+        return;
+    }
+
+    _shmPublisher->publish(mavlinkChannel, message, _sinkFrame(message));
+}
+
+void MAVLinkProtocol::_updateSharedMemoryExport()
+{
+    MavlinkSettings* const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    const bool enabled = mavlinkSettings->sharedMemoryExport()->rawValue().toBool();
+    const QString name = mavlinkSettings->sharedMemoryExportName()->rawValue().toString();
+    const bool otherUsers = mavlinkSettings->sharedMemoryExportOtherUsers()->rawValue().toBool();
+
+    if (!enabled) {
+        _shmPublisher.reset();
+        return;
+    }
+
+    if (_shmPublisher && (_shmPublisher->name() == name) && (_shmPublisher->otherUsers() == otherUsers)) {
+        return;
+    }
+
+    // Release the current segment first, it may have the same name
+    _shmPublisher.reset();
+    auto publisher = std::make_unique<TelemetryShmPublisher>();
+    if (!publisher->open(name, otherUsers)) {
+        qCWarning(MAVLinkProtocolLog) << "Shared memory telemetry export unavailable:" << name;
+        return;
+    }
+    _shmPublisher = std::move(publisher);
+}
+
+QByteArrayView MAVLinkProtocol::_sinkFrame(const mavlink_message_t& message)
+{
+    uint8_t* const frame = _sinkFrameBuffer.data() + kLogTimestampBytes;
+    if (_sinkFrameLength < 0) {
+        _sinkFrameLength = MAVLinkSigning::serializeUnsigned(message, frame);
+    }
+    return QByteArrayView(reinterpret_cast<const char*>(frame), _sinkFrameLength);
+}
+
 void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& message)
 {
     if (!_logSuspendError && !_logSuspendReplay && _tempLogFile->isOpen()) {
         // MAVLink spec §Logging: omit SETUP_SIGNING (contains secret key)
         if (message.msgid != MAVLINK_MSG_ID_SETUP_SIGNING) {
             // MAVLink spec §Logging: strip signature block from logged packets.
-            const QByteArray msgBytes = MAVLinkSigning::serializeUnsignedCopy(message);
+            const qsizetype frameLength = _sinkFrame(message).size();
             const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-            QByteArray log_data;
-            log_data.resize(static_cast<qsizetype>(sizeof(timestamp)) + msgBytes.size());
-            qToBigEndian(timestamp, reinterpret_cast<uint8_t*>(log_data.data()));
-            std::memcpy(log_data.data() + sizeof(timestamp), msgBytes.constData(), msgBytes.size());
-            if (_tempLogFile->write(log_data) != log_data.size()) {
+            qToBigEndian(timestamp, _sinkFrameBuffer.data());
+            const qsizetype logLength = kLogTimestampBytes + frameLength;
+            if (_tempLogFile->write(reinterpret_cast<const char*>(_sinkFrameBuffer.data()), logLength) != logLength) {
                 const QString logErrorMessage =
                     QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.")
                         .arg(_tempLogFile->fileName());
@@ -277,8 +339,10 @@ void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& mes
 }
 
 bool MAVLinkProtocol::_updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                                    const mavlink_message_t& message)
+                                    const MAVLinkFrame& frame)
 {
+    const mavlink_message_t& message = frame.message();
+
     if ((_totalReceiveCounter[mavlinkChannel] % 31) == 0) {
         const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
         emit mavlinkMessageStatus(message.sysid, totalSent, _totalReceiveCounter[mavlinkChannel],
@@ -286,6 +350,7 @@ bool MAVLinkProtocol::_updateStatus(LinkInterface* link, const SharedLinkInterfa
     }
 
     emit messageReceived(link, message);
+    emit frameReceived(link, frame);
 
     if (linkPtr.use_count() == 1) {
         return false;
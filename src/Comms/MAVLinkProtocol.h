@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
 #include <QtCore/QObject>
 #include <QtCore/QPair>
 #include <QtCore/QSet>
@@ -8,9 +9,14 @@
 
 #include "LinkInterface.h"
 #include "MAVLinkEnums.h"
+#include "MAVLinkFrame.h"
 #include "MAVLinkMessageType.h"
 
+#include <array>
+#include <memory>
+
 class QFile;
+class TelemetryShmPublisher;
 
 /// \brief MAVLink micro air vehicle protocol reference implementation.
 ///
@@ -48,6 +54,10 @@ class MAVLinkProtocol : public QObject
 
     void messageReceived(LinkInterface* link, const mavlink_message_t& message);
 
+    /// Same message as messageReceived, shared by reference. Receivers which hold on to the message keep a copy
+    /// of the frame, which leaves the buffer to them and moves the parser on to a fresh one.
+    void frameReceived(LinkInterface* link, const MAVLinkFrame& frame);
+
     void mavlinkMessageStatus(int sysid, uint64_t totalSent, uint64_t totalReceived, uint64_t totalLoss,
                               float lossPercent);
 
@@ -60,6 +70,7 @@ public slots:
 
 private slots:
     void _vehicleCountChanged();
+    void _updateSharedMemoryExport();
 
 private:
     void _logData(LinkInterface* link, const mavlink_message_t& message);
@@ -69,16 +80,28 @@ private slots:
 
     void _forward(const mavlink_message_t& message);
     void _forwardSupport(const mavlink_message_t& message);
+    void _exportSharedMemory(uint8_t mavlinkChannel, const mavlink_message_t& message);
+
+    /// Unsigned wire bytes of the message currently being dispatched, serialized on first use and shared by the
+    /// forward, support-forward and log sinks so each inbound message is serialized at most once.
+    QByteArrayView _sinkFrame(const mavlink_message_t& message);
 
     void _updateCounters(uint8_t mavlinkChannel, const mavlink_message_t& message);
     bool _updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                       const mavlink_message_t& message);
+                       const MAVLinkFrame& frame);
 
     void _saveTelemetryLog(const QString& tempLogfile);
     bool _checkTelemetrySavePath();
 
     QFile* _tempLogFile = nullptr;
 
+    static constexpr qsizetype kLogTimestampBytes = sizeof(quint64);
+    /// Leading kLogTimestampBytes are reserved so the log sink writes timestamp + frame with one write and no copy.
+    std::array<uint8_t, kLogTimestampBytes + MAVLINK_MAX_PACKET_LEN> _sinkFrameBuffer{};
+    qsizetype _sinkFrameLength = -1;  ///< -1: not yet serialized for the current message
+
+    std::unique_ptr<TelemetryShmPublisher> _shmPublisher;  ///< Only exists while shared memory export is enabled
+
     bool _logSuspendError = false;
     bool _logSuspendReplay = false;
     bool _vehicleWasArmed = false;
@@ -20,6 +20,7 @@ MockConfiguration::MockConfiguration(const MockConfiguration *copy, QObject *par
     , _incrementVehicleId(copy->incrementVehicleId())
     , _startArmed(copy->startArmed())
     , _preloadMission(copy->preloadMission())
+    , _responseLatencyMSecs(copy->responseLatencyMSecs())
     , _cameraCaptureVideo(copy->cameraCaptureVideo())
     , _cameraCaptureImage(copy->cameraCaptureImage())
     , _cameraHasModes(copy->cameraHasModes())
@@ -76,6 +77,7 @@ void MockConfiguration::copyFrom(const LinkConfiguration *source)
     setGimbalHasNeutral(mockLinkSource->gimbalHasNeutral());
     setStartArmed(mockLinkSource->startArmed());
     setPreloadMission(mockLinkSource->preloadMission());
+    setResponseLatencyMSecs(mockLinkSource->responseLatencyMSecs());
 }
 
 void MockConfiguration::loadSettings(QSettings &settings, const QString &root)
@@ -116,6 +116,11 @@ class MockConfiguration : public LinkConfiguration
     bool preloadMission() const { return _preloadMission; }
     void setPreloadMission(bool preloadMission) { _preloadMission = preloadMission; }
 
+    // Test-only: delay in msecs before the simulated vehicle handles anything sent to it,
+    // which adds a round trip latency to every request. Not persisted.
+    int responseLatencyMSecs() const { return _responseLatencyMSecs; }
+    void setResponseLatencyMSecs(int latencyMSecs) { _responseLatencyMSecs = latencyMSecs; }
+
 signals:
     void firmwareChanged();
     void vehicleChanged();
@@ -152,6 +157,7 @@ class MockConfiguration : public LinkConfiguration
     uint16_t _boardProductId = 0;
     bool _startArmed = false;
     bool _preloadMission = false;
+    int _responseLatencyMSecs = 0;
 
     // Camera capability flags (defaults match current Camera 1 configuration)
     bool _cameraCaptureVideo = true;
@@ -26,6 +26,7 @@
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -124,6 +125,7 @@ MockLink::MockLink(SharedLinkConfigurationPtr &config, QObject *parent)
 
     _loadParams();
     _runningTime.start();
+    _messageIntervalTimer.start();
 
     _workerThread = new QThread(this);
     _workerThread->setObjectName(QStringLiteral("Mock_%1").arg(_mockConfig->name()));
@@ -264,16 +266,30 @@ void MockLink::run10HzTasks()
         }
         if (gpsDelayExpired || QGC::runningUnitTests()) {
             if (_vehicleType != MAV_TYPE_SUBMARINE) {
-                _sendGpsRawInt();
-                _sendGlobalPositionInt();
+                if (_messageIntervalDue(MAVLINK_MSG_ID_GPS_RAW_INT)) {
+                    _sendGpsRawInt();
+                }
+                if (_messageIntervalDue(MAVLINK_MSG_ID_GLOBAL_POSITION_INT)) {
+                    _sendGlobalPositionInt();
+                }
+            }
+            if (_messageIntervalDue(MAVLINK_MSG_ID_EXTENDED_SYS_STATE)) {
+                _sendExtendedSysState();
             }
-            _sendExtendedSysState();
         }
 
-        _sendAttitudeQuaternion();
-        _sendAttitudeTarget();
-        _sendLocalPositionNed();
-        _sendPositionTargetLocalNed();
+        if (_messageIntervalDue(MAVLINK_MSG_ID_ATTITUDE_QUATERNION)) {
+            _sendAttitudeQuaternion();
+        }
+        if (_messageIntervalDue(MAVLINK_MSG_ID_ATTITUDE_TARGET)) {
+            _sendAttitudeTarget();
+        }
+        if (_messageIntervalDue(MAVLINK_MSG_ID_LOCAL_POSITION_NED)) {
+            _sendLocalPositionNed();
+        }
+        if (_messageIntervalDue(MAVLINK_MSG_ID_POSITION_TARGET_LOCAL_NED)) {
+            _sendPositionTargetLocalNed();
+        }
 
         _mockLinkPX4Calibration->run10HzTasks();
 
@@ -295,6 +311,7 @@ void MockLink::run500HzTasks()
             _paramRequestListWorker();
         }
         _logDownloadWorker();
+        _mavlinkLogStreamWorker();
         _availableModesWorker();
         _apmCompassCalWorker();
         _apmAccelCalWorker();
@@ -760,11 +777,33 @@ void MockLink::respondWithMavlinkMessage(const mavlink_message_t &msg)
     if (!_commLost) {
         uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
         const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+
+        {
+            QMutexLocker locker(&_linkCapacityMutex);
+            if (_linkCapacity > 0) {
+                // Refill for the time passed, a burst of at most one second of capacity fits in the radio's buffer
+                _linkCapacityTokens = std::min(static_cast<double>(_linkCapacity), _linkCapacityTokens + (_linkCapacityTimer.restart() * _linkCapacity / 1000.));
+                if (_linkCapacityTokens < cBuffer) {
+                    _linkCapacityDroppedBytes += cBuffer;
+                    return;
+                }
+                _linkCapacityTokens -= cBuffer;
+            }
+        }
+
         const QByteArray bytes(reinterpret_cast<char*>(buffer), cBuffer);
         emit bytesReceived(this, bytes);
     }
 }
 
+void MockLink::setLinkCapacity(int bytesPerSecond)
+{
+    QMutexLocker locker(&_linkCapacityMutex);
+    _linkCapacity = std::max(0, bytesPerSecond);
+    _linkCapacityTokens = _linkCapacity;
+    _linkCapacityTimer.start();
+}
+
 void MockLink::_writeBytes(const QByteArray &bytes)
 {
     // This prevents the responses to mavlink messages from being sent until the _writeBytes returns.
@@ -778,6 +817,22 @@ void MockLink::_writeBytesQueued(const QByteArray &bytes)
         return;
     }
 
+    const int latencyMSecs = _mockConfig ? _mockConfig->responseLatencyMSecs() : 0;
+    if (latencyMSecs > 0) {
+        // Timers with the same interval fire in order, the bytes are still handled in the order they were sent
+        QTimer::singleShot(latencyMSecs, this, [this, bytes]() {
+            if (_connected && mavlinkChannelIsSet()) {
+                _handleWrittenBytes(bytes);
+            }
+        });
+        return;
+    }
+
+    _handleWrittenBytes(bytes);
+}
+
+void MockLink::_handleWrittenBytes(const QByteArray &bytes)
+{
     if (_inNSH) {
         _handleIncomingNSHBytes(bytes.constData(), bytes.length());
         return;
@@ -909,6 +964,9 @@ void MockLink::_handleIncomingMavlinkMsg(const mavlink_message_t &msg)
     case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
         _handleLogRequestData(msg);
         break;
+    case MAVLINK_MSG_ID_LOG_REQUEST_END:
+        _handleLogRequestEnd();
+        break;
     case MAVLINK_MSG_ID_PARAM_MAP_RC:
         _handleParamMapRC(msg);
         break;
@@ -1644,8 +1702,8 @@ void MockLink::_handleInProgressCommandLong(const mavlink_command_long_t &reques
 
 void MockLink::_handleCommandLongSetMessageInterval(const mavlink_command_long_t &request, bool &accepted)
 {
-    // Accept only the message IDs that MAVLinkStreamConfig requests for PID tuning.
-    // Anything else gets MAV_RESULT_UNSUPPORTED so unit tests will catch unexpected usage.
+    // Accept only the message IDs that MAVLinkStreamConfig requests for PID tuning and the 10Hz streams the
+    // adaptive rate control throttles. Anything else gets MAV_RESULT_UNSUPPORTED so unit tests will catch unexpected usage.
     static const QSet<int> kPidTuningMessageIds = {
         MAVLINK_MSG_ID_ATTITUDE_QUATERNION,
         MAVLINK_MSG_ID_ATTITUDE_TARGET,
@@ -1654,7 +1712,47 @@ void MockLink::_handleCommandLongSetMessageInterval(const mavlink_command_long_t
         MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT,
         MAVLINK_MSG_ID_VFR_HUD,
     };
-    accepted = kPidTuningMessageIds.contains(static_cast<int>(request.param1));
+    static const QSet<int> kStreamMessageIds = {
+        MAVLINK_MSG_ID_GPS_RAW_INT,
+        MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+        MAVLINK_MSG_ID_EXTENDED_SYS_STATE,
+    };
+
+    const int messageId = static_cast<int>(request.param1);
+    accepted = kPidTuningMessageIds.contains(messageId) || kStreamMessageIds.contains(messageId);
+    if (!accepted) {
+        return;
+    }
+
+    QMutexLocker locker(&_messageIntervalMutex);
+    const int32_t intervalUs = static_cast<int32_t>(request.param2);
+    if (intervalUs == 0) {
+        (void) _messageIntervalsUs.remove(messageId);
+    } else {
+        _messageIntervalsUs[messageId] = intervalUs;
+    }
+}
+
+bool MockLink::_messageIntervalDue(uint32_t messageId)
+{
+    QMutexLocker locker(&_messageIntervalMutex);
+    const auto it = _messageIntervalsUs.constFind(messageId);
+    if (it == _messageIntervalsUs.constEnd()) {
+        return true;
+    }
+    if (it.value() < 0) {
+        return false;
+    }
+
+    // Half a 10Hz tick of slack, otherwise timer jitter would round every interval up to the next tick
+    const qint64 nowMs = _messageIntervalTimer.elapsed();
+    const auto lastSent = _messageIntervalLastSentMs.constFind(messageId);
+    if ((lastSent != _messageIntervalLastSentMs.constEnd()) && (((nowMs - lastSent.value()) + 50) < (it.value() / 1000))) {
+        return false;
+    }
+
+    _messageIntervalLastSentMs[messageId] = nowMs;
+    return true;
 }
 
 void MockLink::_handleCommandLong(const mavlink_message_t &msg)
@@ -1781,6 +1879,22 @@ void MockLink::_handleCommandLong(const mavlink_message_t &msg)
     case MockLink::MAV_CMD_MOCKLINK_RESULT_IN_PROGRESS_NO_ACK:
         _handleInProgressCommandLong(request);
         return;
+    case MAV_CMD_LOGGING_START:
+    {
+        QMutexLocker locker(&_mavlinkLogStreamMutex);
+        _mavlinkLogStreamOffset = _mavlinkLogStream.isEmpty() ? -1 : 0;
+        _mavlinkLogStreamNextMessage = kULogHeaderSize;
+        _mavlinkLogStreamSequence = 0;
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    }
+    case MAV_CMD_LOGGING_STOP:
+    {
+        QMutexLocker locker(&_mavlinkLogStreamMutex);
+        _mavlinkLogStreamOffset = -1;
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    }
     case MAV_CMD_SET_MESSAGE_INTERVAL:
     {
         bool accepted = false;
@@ -2456,6 +2570,26 @@ void MockLink::_handleLogRequestData(const mavlink_message_t &msg)
     _logDownloadBytesRemaining = request.count;
 }
 
+void MockLink::_handleLogRequestEnd()
+{
+    QMutexLocker locker(&_logDownloadMutex);
+    _logDownloadBytesRemaining = 0;
+}
+
+void MockLink::setLogDownloadLinkConditions(uint32_t fileSize, int dropEveryNthPacket)
+{
+    QMutexLocker locker(&_logDownloadMutex);
+    if (!_logDownloadFilename.isEmpty() && (fileSize != _logDownloadFileSize)) {
+        (void) QFile::remove(_logDownloadFilename);
+        _logDownloadFilename.clear();
+    }
+
+    _logDownloadFileSize = fileSize;
+    _logDownloadDropEveryNthPacket = dropEveryNthPacket;
+    _logDownloadPacketCount = 0;
+    _logDownloadBytesRemaining = 0;
+}
+
 void MockLink::_logDownloadWorker()
 {
     // Runs every 2ms (500Hz on worker thread). Must protect shared state modified by main thread.
@@ -2479,6 +2613,14 @@ void MockLink::_logDownloadWorker()
 
     qCDebug(MockLinkLog) << "_logDownloadWorker" << _logDownloadCurrentOffset << _logDownloadBytesRemaining;
 
+    _logDownloadBytesSent += bytesToRead;
+    if ((_logDownloadDropEveryNthPacket > 0) && ((++_logDownloadPacketCount % _logDownloadDropEveryNthPacket) == 0)) {
+        qCDebug(MockLinkLog) << "_logDownloadWorker dropping LOG_DATA to simulate loss";
+        _logDownloadCurrentOffset += bytesToRead;
+        _logDownloadBytesRemaining -= bytesToRead;
+        return;
+    }
+
     mavlink_message_t responseMsg{};
     (void) mavlink_msg_log_data_pack_chan(
         _vehicleSystemId,
@@ -2498,6 +2640,48 @@ void MockLink::_logDownloadWorker()
     file.close();
 }
 
+void MockLink::_mavlinkLogStreamWorker()
+{
+    QMutexLocker locker(&_mavlinkLogStreamMutex);
+    if ((_mavlinkLogStreamOffset < 0) || (_mavlinkLogStreamOffset >= _mavlinkLogStream.size())) {
+        return;
+    }
+
+    // Same framing as the PX4 logger: the first packet starts with the file header, later packets
+    // carry the offset of the first ULog message starting in them or 255 if there is none.
+    const qsizetype offset = _mavlinkLogStreamOffset;
+    const qsizetype length = qMin<qsizetype>(_mavlinkLogStream.size() - offset, MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN);
+    uint8_t firstMessage = 255;
+    if (offset == 0) {
+        firstMessage = 0;
+    } else if (_mavlinkLogStreamNextMessage < (offset + length)) {
+        firstMessage = static_cast<uint8_t>(_mavlinkLogStreamNextMessage - offset);
+    }
+
+    // Advance past every message starting in this packet. ULog messages are [uint16 size][uint8 type][payload].
+    while ((_mavlinkLogStreamNextMessage + 2) <= _mavlinkLogStream.size() && (_mavlinkLogStreamNextMessage < (offset + length))) {
+        const uint8_t *const header = reinterpret_cast<const uint8_t*>(_mavlinkLogStream.constData()) + _mavlinkLogStreamNextMessage;
+        _mavlinkLogStreamNextMessage += (header[0] | (header[1] << 8)) + 3;
+    }
+
+    mavlink_message_t responseMsg{};
+    (void) mavlink_msg_logging_data_pack_chan(
+        _vehicleSystemId,
+        _vehicleComponentId,
+        _outgoingMavlinkChannel,
+        &responseMsg,
+        0,                                  // target_system
+        0,                                  // target_component
+        _mavlinkLogStreamSequence++,
+        static_cast<uint8_t>(length),
+        firstMessage,
+        reinterpret_cast<const uint8_t*>(_mavlinkLogStream.constData()) + offset
+    );
+    respondWithMavlinkMessage(responseMsg);
+
+    _mavlinkLogStreamOffset += length;
+}
+
 void MockLink::_sendADSBVehicles()
 {
     for (int i = 0; i < _adsbVehicles.size(); ++i) {
@@ -2659,7 +2843,45 @@ void MockLink::_handleRequestMessage(const mavlink_command_long_t &request, bool
     case MAVLINK_MSG_ID_AVAILABLE_MODES:
         _handleRequestMessageAvailableModes(request, accepted);
         break;
+    case MAVLINK_MSG_ID_MESSAGE_INTERVAL:
+        _handleRequestMessageMessageInterval(request, accepted);
+        break;
+    }
+}
+
+void MockLink::_handleRequestMessageMessageInterval(const mavlink_command_long_t &request, bool &accepted)
+{
+    accepted = true;
+
+    const uint16_t messageId = static_cast<uint16_t>(request.param2);
+    int32_t intervalUs = messageInterval(messageId);
+    if (intervalUs == 0) {
+        switch (messageId) {
+        case MAVLINK_MSG_ID_GPS_RAW_INT:
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        case MAVLINK_MSG_ID_EXTENDED_SYS_STATE:
+        case MAVLINK_MSG_ID_ATTITUDE_QUATERNION:
+        case MAVLINK_MSG_ID_ATTITUDE_TARGET:
+        case MAVLINK_MSG_ID_LOCAL_POSITION_NED:
+        case MAVLINK_MSG_ID_POSITION_TARGET_LOCAL_NED:
+            intervalUs = 100000;
+            break;
+        default:
+            // Unknown interval
+            break;
+        }
     }
+
+    mavlink_message_t responseMsg{};
+    (void) mavlink_msg_message_interval_pack_chan(
+        _vehicleSystemId,
+        _vehicleComponentId,
+        _outgoingMavlinkChannel,
+        &responseMsg,
+        messageId,
+        intervalUs
+    );
+    respondWithMavlinkMessage(responseMsg);
 }
 
 void MockLink::_sendGeneralMetaData()
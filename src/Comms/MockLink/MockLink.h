@@ -10,6 +10,7 @@
 #include "MockLinkMissionItemHandler.h"
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QMutex>
 #include <QtCore/QSet>
@@ -93,9 +94,43 @@ class MockLink : public LinkInterface
     /// Test-only: seeds a simple multirotor mission (takeoff, waypoint, RTL) onto the simulated vehicle.
     void loadSimpleMultirotorMission() const { _missionItemHandler->loadSimpleMultirotorMission(); }
 
+    /// Test-only: seeds a mission of @p count waypoints onto the simulated vehicle.
+    void loadWaypointMission(int count) const { _missionItemHandler->loadWaypointMission(count); }
+
+    /// Test-only: adds latency and loss to mission read responses, see MockLinkMissionItemHandler::setReadLinkConditions
+    void setMissionReadLinkConditions(int latencyMSecs, int dropEveryNthItem) const { _missionItemHandler->setReadLinkConditions(latencyMSecs, dropEveryNthItem); }
+
     /// Returns the filename for the simulated log file. Only available after a download is requested.
     QString logDownloadFile() const { return _logDownloadFilename; }
 
+    /// Test-only: resizes the simulated log file and makes LOG_DATA lossy
+    ///     @param fileSize Size of the simulated log file, replaces a file created by an earlier request
+    ///     @param dropEveryNthPacket Every nth LOG_DATA packet is lost, 0: no loss
+    void setLogDownloadLinkConditions(uint32_t fileSize, int dropEveryNthPacket);
+
+    /// Test-only: LOG_DATA payload bytes sent so far, dropped packets included
+    uint32_t logDownloadBytesSent() const { return _logDownloadBytesSent; }
+
+    /// Test-only: limits the bytes per second sent to QGC. Messages over the capacity are dropped whole, as a saturated
+    /// radio would drop them.
+    ///     @param bytesPerSecond 0: unlimited
+    void setLinkCapacity(int bytesPerSecond);
+
+    /// Test-only: bytes dropped by the link capacity so far
+    quint64 linkCapacityDroppedBytes() const { return _linkCapacityDroppedBytes; }
+
+    /// Test-only: interval set by SET_MESSAGE_INTERVAL for messageId, 0: default rate, -1: disabled
+    int32_t messageInterval(uint32_t messageId) const {
+        QMutexLocker locker(&_messageIntervalMutex);
+        return _messageIntervalsUs.value(messageId, 0);
+    }
+
+    /// Test-only: ULog file streamed as LOGGING_DATA once MAV_CMD_LOGGING_START is received
+    void setMavlinkLogStream(const QByteArray &ulog) {
+        QMutexLocker locker(&_mavlinkLogStreamMutex);
+        _mavlinkLogStream = ulog;
+    }
+
     void clearReceivedMavCommandCounts() { _receivedMavCommandCountMap.clear(); _receivedMavCommandByCompCountMap.clear(); _receivedRequestMessageByCompAndMsgCountMap.clear(); }
     int receivedMavCommandCount(MAV_CMD command) const { return _receivedMavCommandCountMap.value(command, 0); }
     int receivedMavCommandCount(MAV_CMD command, int compId) const { return _receivedMavCommandByCompCountMap.value(command).value(compId, 0); }
@@ -222,6 +257,9 @@ private slots:
     bool _allocateMavlinkChannel() final;
     void _freeMavlinkChannel() final;
 
+    /// Handles bytes QGC wrote to the MAV, after the configured response latency
+    void _handleWrittenBytes(const QByteArray &bytes);
+
     bool _incomingMavlinkChannelIsSet() const;
     bool _outgoingMavlinkChannelIsSet() const;
 
@@ -256,6 +294,7 @@ private slots:
     void _handleTakeoff(const mavlink_command_long_t &request);
     void _handleLogRequestList(const mavlink_message_t &msg);
     void _handleLogRequestData(const mavlink_message_t &msg);
+    void _handleLogRequestEnd();
     void _handleParamMapRC(const mavlink_message_t &msg);
     void _handleSetupSigning(const mavlink_message_t &msg);
     void _sendParamError(int componentId, const char *paramId, int16_t paramIndex, uint8_t errorCode);
@@ -263,6 +302,8 @@ private slots:
     void _handleRequestMessageAutopilotVersion(const mavlink_command_long_t &request, bool &accepted);
     void _handleRequestMessageDebug(const mavlink_command_long_t &request, bool &accepted, bool &noAck);
     void _handleRequestMessageAvailableModes(const mavlink_command_long_t &request, bool &accepted);
+    void _handleRequestMessageMessageInterval(const mavlink_command_long_t &request, bool &accepted);
+    bool _messageIntervalDue(uint32_t messageId);
 
     void _sendHeartBeat();
     void _sendHighLatency2();
@@ -292,6 +333,7 @@ private slots:
 
     void _paramRequestListWorker();
     void _logDownloadWorker();
+    void _mavlinkLogStreamWorker();
     void _availableModesWorker();
     void _apmCompassCalWorker();
     void _apmAccelCalWorker();
@@ -383,11 +425,37 @@ private slots:
     QString _logDownloadFilename;                       ///< Filename for log download which is in progress
     uint32_t _logDownloadCurrentOffset = 0;             ///< Current offset we are sending from
     uint32_t _logDownloadBytesRemaining = 0;            ///< Number of bytes still to send, 0 = send inactive
+    uint32_t _logDownloadFileSize = kLogDownloadDefaultFileSize;    ///< Size of simulated log file
+    int _logDownloadDropEveryNthPacket = 0;             ///< Simulated LOG_DATA loss, 0 = no loss
+    uint32_t _logDownloadPacketCount = 0;
+    std::atomic<uint32_t> _logDownloadBytesSent = 0;
     /// Protects log download state from race conditions between:
     ///   - Main thread: _handleLogRequestData() writing offset/count when new request arrives
     ///   - Worker thread: _logDownloadWorker() reading/modifying offset/remaining every 2ms (500Hz)
     QMutex _logDownloadMutex;
 
+    QByteArray _mavlinkLogStream;                       ///< ULog sent in response to MAV_CMD_LOGGING_START
+    qsizetype _mavlinkLogStreamOffset = -1;             ///< Next byte to send, -1 = not streaming
+    qsizetype _mavlinkLogStreamNextMessage = 0;         ///< Offset of the next ULog message start in the stream
+    uint16_t _mavlinkLogStreamSequence = 0;
+    /// Protects the log stream state from races between:
+    ///   - Main thread: _handleCommandLong() starting/stopping the stream
+    ///   - Worker thread: _mavlinkLogStreamWorker() sending the next packet every 2ms (500Hz)
+    QMutex _mavlinkLogStreamMutex;
+
+    /// Intervals set by SET_MESSAGE_INTERVAL for the 10Hz streams, which are decimated to them in run10HzTasks
+    QHash<uint32_t, int32_t> _messageIntervalsUs;
+    QHash<uint32_t, qint64> _messageIntervalLastSentMs;
+    QElapsedTimer _messageIntervalTimer;
+    mutable QMutex _messageIntervalMutex;
+
+    /// Token bucket of the simulated link capacity, respondWithMavlinkMessage is called from the main and worker threads
+    int _linkCapacity = 0;                              ///< Bytes per second, 0: unlimited
+    double _linkCapacityTokens = 0.;
+    QElapsedTimer _linkCapacityTimer;
+    std::atomic<quint64> _linkCapacityDroppedBytes = 0;
+    QMutex _linkCapacityMutex;
+
     RequestMessageFailureMode_t _requestMessageFailureMode = FailRequestMessageNone;
     mutable QMutex _requestMessageNoResponseMutex;
     QSet<uint32_t> _requestMessageNoResponseIds;
@@ -469,7 +537,8 @@ private slots:
     static constexpr uint8_t _vehicleComponentId = MAV_COMP_ID_AUTOPILOT1;
 
     static constexpr uint16_t _logDownloadLogId = 0;        ///< Id of siumulated log file
-    static constexpr uint32_t _logDownloadFileSize = 1000;  ///< Size of simulated log file
+    static constexpr uint32_t kLogDownloadDefaultFileSize = 1000;   ///< Default size of simulated log file
+    static constexpr qsizetype kULogHeaderSize = 16;        ///< ULog file header preceding the first message
 
     static constexpr bool _mavlinkStarted = true;
 
@@ -1,6 +1,7 @@
 #include "MockLinkCamera.h"
 #include "MAVLinkLib.h"
 #include "MockLink.h"
+#include "MockLinkFTP.h"
 #include "MissionManager/MissionCommandTree.h"
 #include "QGCLoggingCategory.h"
 
@@ -651,7 +652,15 @@ void MockLinkCamera::_sendCameraImageCaptured(uint8_t compId)
     const int32_t lon = static_cast<int32_t>(_mockLink->vehicleLongitude() * 1e7);
     const float alt = static_cast<float>(_mockLink->vehicleAltitudeAMSL());
     const float q[4] = {1.0f, 0.0f, 0.0f, 0.0f};    // quaternion (not used in this mock, set to identity)
-    const char fileUrl[MAVLINK_MSG_CAMERA_IMAGE_CAPTURED_FIELD_FILE_URL_LEN] = {};
+    // Served by MockLinkFTP, which generates a JPEG for any file below its image directory
+    char fileUrl[MAVLINK_MSG_CAMERA_IMAGE_CAPTURED_FIELD_FILE_URL_LEN] = {};
+    const QByteArray url = QStringLiteral("mftp://[;comp=%1]%2%3/IMG_%4.JPG")
+                               .arg(MAV_COMP_ID_AUTOPILOT1)
+                               .arg(QString::fromLatin1(MockLinkFTP::imageDirectory).mid(1))
+                               .arg((compId - MAV_COMP_ID_CAMERA) + 1)
+                               .arg(cam->imagesCaptured, 4, 10, QLatin1Char('0'))
+                               .toLatin1();
+    (void) qstrncpy(fileUrl, url.constData(), sizeof(fileUrl));
 
     mavlink_message_t msg{};
     (void) mavlink_msg_camera_image_captured_pack_chan(
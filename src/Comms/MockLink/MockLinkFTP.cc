@@ -5,6 +5,8 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QTemporaryFile>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
 
 QGC_LOGGING_CATEGORY(MockLinkFTPLog, "Comms.MockLink.MockLinkFTP")
 
@@ -130,6 +132,8 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
     if (path.startsWith(sizePrefix)) {
         const QString sizeString = path.right(path.length() - sizePrefix.length());
         tmpFilename = _createTestTempFile(sizeString.toInt());
+    } else if (path.startsWith(QLatin1String(imageDirectory))) {
+        tmpFilename = _createTestImageFile(path);
     } else if (path == "/general.json") {
         tmpFilename = QStringLiteral(":MockLink/General.MetaData.json");
     } else if (path == "/general.json.xz") {
@@ -576,6 +580,23 @@ uint16_t MockLinkFTP::_nextSeqNumber(uint16_t seqNumber) const
     return outgoingSeqNumber;
 }
 
+QString MockLinkFTP::_createTestImageFile(const QString &path)
+{
+    QTemporaryFile tmpFile(QDir::tempPath() + QStringLiteral("/MockLinkFTPImageXXXXXX.jpg"));
+    tmpFile.setAutoRemove(false);
+
+    if (tmpFile.open()) {
+        // Color derived from the path so each image is distinct
+        const size_t hash = qHash(path);
+        QImage image(1280, 960, QImage::Format_RGB32);
+        image.fill(QColor(hash & 0xff, (hash >> 8) & 0xff, (hash >> 16) & 0xff));
+        (void) image.save(&tmpFile, "JPG");
+        tmpFile.close();
+    }
+
+    return tmpFile.fileName();
+}
+
 QString MockLinkFTP::_createTestTempFile(int size)
 {
     QTemporaryFile tmpFile(QDir::tempPath() + QStringLiteral("/MockLinkFTPTestCaseXXXXXX"));
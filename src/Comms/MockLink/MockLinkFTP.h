@@ -72,6 +72,9 @@ class MockLinkFTP : public QObject
 
     static constexpr const char *sizeFilenamePrefix = "mocklink-size-";
 
+    /// Opening any file below this directory returns a generated JPEG, see MockLinkCamera image capture
+    static constexpr const char *imageDirectory = "/DCIM/";
+
     /// Base modification time (seconds since UNIX epoch UTC) reported by the kCmdListDirectoryWithTime
     /// mock listing. Entry N reports kMockModificationTime + N.
     static constexpr uint32_t kMockModificationTime = 1700000000;
@@ -106,6 +109,7 @@ class MockLinkFTP : public QObject
     /// bad sequence numbers when errModeBadSequence is set.
     uint16_t _nextSeqNumber(uint16_t seqNumber) const;
     static QString _createTestTempFile(int size);
+    static QString _createTestImageFile(const QString &path);
     QString _generateParamPck(bool withDefaults);
 
     /// if request is a string, this ensures it's null-terminated
@@ -59,6 +59,49 @@ void MockLinkMissionItemHandler::loadSimpleMultirotorMission()
     qCDebug(MockLinkMissionItemHandlerLog) << "loadSimpleMultirotorMission seeded" << _missionItems.count() << "items";
 }
 
+void MockLinkMissionItemHandler::loadWaypointMission(int count)
+{
+    _missionItems.clear();
+
+    for (int seq = 0; seq < count; seq++) {
+        mavlink_mission_item_int_t item{};
+        item.seq = static_cast<uint16_t>(seq);
+        item.frame = MAV_FRAME_GLOBAL_RELATIVE_ALT;
+        item.command = MAV_CMD_NAV_WAYPOINT;
+        item.current = (seq == 0) ? 1 : 0;
+        item.autocontinue = 1;
+        item.x = static_cast<int32_t>((47.397 + (seq * 0.0001)) * 1e7);
+        item.y = static_cast<int32_t>(8.5455 * 1e7);
+        item.z = 50.0f;
+        item.mission_type = MAV_MISSION_TYPE_MISSION;
+        _missionItems[static_cast<uint16_t>(seq)] = item;
+    }
+}
+
+void MockLinkMissionItemHandler::setReadLinkConditions(int latencyMSecs, int dropEveryNthItem)
+{
+    _readLatencyMSecs = latencyMSecs;
+    _dropEveryNthItem = dropEveryNthItem;
+    _itemResponseCount = 0;
+}
+
+void MockLinkMissionItemHandler::_sendReadResponse(const mavlink_message_t &message)
+{
+    if ((message.msgid == MAVLINK_MSG_ID_MISSION_ITEM_INT) && (_dropEveryNthItem > 0) && ((++_itemResponseCount % _dropEveryNthItem) == 0)) {
+        qCDebug(MockLinkMissionItemHandlerLog) << "_sendReadResponse dropping MISSION_ITEM_INT to simulate loss";
+        return;
+    }
+
+    if (_readLatencyMSecs <= 0) {
+        _mockLink->respondWithMavlinkMessage(message);
+        return;
+    }
+
+    QTimer::singleShot(_readLatencyMSecs, this, [this, message]() {
+        _mockLink->respondWithMavlinkMessage(message);
+    });
+}
+
 bool MockLinkMissionItemHandler::handleMavlinkMessage(const mavlink_message_t &msg)
 {
     switch (msg.msgid) {
@@ -180,7 +223,7 @@ void MockLinkMissionItemHandler::_handleMissionRequestList(const mavlink_message
         0
     );
 
-    _mockLink->respondWithMavlinkMessage(responseMsg);
+    _sendReadResponse(responseMsg);
 }
 
 void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t &msg)
@@ -264,7 +307,7 @@ void MockLinkMissionItemHandler::_handleMissionRequest(const mavlink_message_t &
         _requestType
     );
 
-    _mockLink->respondWithMavlinkMessage(responseMsg);
+    _sendReadResponse(responseMsg);
 }
 
 void MockLinkMissionItemHandler::_handleMissionCount(const mavlink_message_t &msg)
@@ -62,7 +62,15 @@ class MockLinkMissionItemHandler : public QObject
     void sendUnexpectedMissionRequest();
 
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
-    void reset() { _missionItems.clear(); _requestListCounts.clear(); }
+    void reset() { _missionItems.clear(); _requestListCounts.clear(); setReadLinkConditions(0, 0); }
+
+    /// Test-only: simulates a slow, lossy link for the read sequence
+    ///     @param latencyMSecs Delay before MISSION_COUNT and MISSION_ITEM_INT responses are sent
+    ///     @param dropEveryNthItem Every nth MISSION_ITEM_INT response is lost, 0: no loss
+    void setReadLinkConditions(int latencyMSecs, int dropEveryNthItem);
+
+    /// Test-only: seeds a mission of @p count waypoints
+    void loadWaypointMission(int count);
 
     /// Test-only: seeds a simple multirotor mission (takeoff, waypoint, RTL) so that a
     /// connecting GCS will download a non-empty mission.
@@ -84,6 +92,7 @@ private slots:
     void _handleMissionClearAll(const mavlink_message_t &msg);
     void _requestNextMissionItem(int sequenceNumber);
     void _sendAck(MAV_MISSION_RESULT ackType) const;
+    void _sendReadResponse(const mavlink_message_t &message);
     void _startMissionItemResponseTimer();
 
     MockLink *_mockLink = nullptr;
@@ -106,4 +115,7 @@ private slots:
     bool _failReadRequest1FirstResponse = true;
     bool _failWriteMissionCountFirstResponse = true;
     QMap<MAV_MISSION_TYPE, int> _requestListCounts;
+    int _readLatencyMSecs = 0;
+    int _dropEveryNthItem = 0;
+    int _itemResponseCount = 0;
 };
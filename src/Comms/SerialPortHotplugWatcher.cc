@@ -0,0 +1,201 @@
+#include "SerialPortHotplugWatcher.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSocketNotifier>
+
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(SerialPortHotplugWatcherLog, "Comms.SerialPortHotplugWatcher")
+
+SerialPortHotplugWatcher::SerialPortHotplugWatcher(QObject *parent)
+    : QObject(parent)
+{
+    qCDebug(SerialPortHotplugWatcherLog) << this;
+}
+
+SerialPortHotplugWatcher::~SerialPortHotplugWatcher()
+{
+    stop();
+
+    qCDebug(SerialPortHotplugWatcherLog) << this;
+}
+
+bool SerialPortHotplugWatcher::isHotplugPortName(const QString &name)
+{
+    // USB drivers name their nodes tty<driver>ACM<n> or tty<driver>USB<n> (ttyCH343USB, ttyXRUSB, ...). Fixed ports
+    // (ttyS, ttyAMA, ...) never come and go, so they are left to availablePorts().
+    static const QRegularExpression regExp(QStringLiteral("^(tty[A-Za-z0-9]*?(ACM|USB)|rfcomm)[0-9]+$"));
+    return regExp.match(name).hasMatch();
+}
+
+bool SerialPortHotplugWatcher::start(const QString &deviceDirectory)
+{
+    stop();
+
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotifyFd < 0) {
+        qCWarning(SerialPortHotplugWatcherLog) << "inotify_init1 failed:" << qt_error_string(errno);
+        return false;
+    }
+
+    // Watch before scanning so a port plugged in between the two is not missed; adding it twice is harmless
+    static constexpr uint32_t kEventMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    _watchDescriptor = inotify_add_watch(_inotifyFd, QFile::encodeName(deviceDirectory).constData(), kEventMask);
+    if (_watchDescriptor < 0) {
+        qCWarning(SerialPortHotplugWatcherLog) << "inotify_add_watch failed:" << deviceDirectory << qt_error_string(errno);
+        stop();
+        return false;
+    }
+
+    _deviceDirectory = deviceDirectory;
+    _notifier = new QSocketNotifier(_inotifyFd, QSocketNotifier::Read, this);
+    (void) connect(_notifier, &QSocketNotifier::activated, this, &SerialPortHotplugWatcher::_readEvents);
+
+    _rescan(false /* notify */);
+
+    qCDebug(SerialPortHotplugWatcherLog) << "Watching" << _deviceDirectory << "ports:" << ports();
+
+    return true;
+}
+
+void SerialPortHotplugWatcher::stop()
+{
+    if (_notifier) {
+        // May be called from _readEvents(), which runs inside the notifier's signal
+        _notifier->setEnabled(false);
+        _notifier->deleteLater();
+        _notifier = nullptr;
+    }
+
+    if (_inotifyFd >= 0) {
+        (void) ::close(_inotifyFd);
+        _inotifyFd = -1;
+    }
+
+    _watchDescriptor = -1;
+    _portNames.clear();
+}
+
+QStringList SerialPortHotplugWatcher::ports() const
+{
+    QStringList result;
+    result.reserve(_portNames.size());
+    for (const QString &name : _portNames) {
+        result.append(_systemLocation(name));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void SerialPortHotplugWatcher::_readEvents()
+{
+    alignas(struct inotify_event) char buffer[4096];
+
+    bool watchLost = false;
+    bool overflow = false;
+    while (_inotifyFd >= 0) {
+        const ssize_t length = ::read(_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            if ((length < 0) && (errno == EINTR)) {
+                continue;
+            }
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const struct inotify_event *const event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflow = true;
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT)) {
+                watchLost = true;
+                continue;
+            }
+            if ((event->len == 0) || (event->wd != _watchDescriptor)) {
+                continue;
+            }
+
+            const QString name = QFile::decodeName(event->name);
+            if (!isHotplugPortName(name)) {
+                continue;
+            }
+
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                _addPort(name);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                _removePort(name);
+            }
+        }
+    }
+
+    if (watchLost) {
+        qCWarning(SerialPortHotplugWatcherLog) << "Lost watch on" << _deviceDirectory;
+        stop();
+        emit stopped();
+    } else if (overflow) {
+        qCDebug(SerialPortHotplugWatcherLog) << "Event queue overflow, rescanning" << _deviceDirectory;
+        _rescan(true /* notify */);
+    }
+}
+
+void SerialPortHotplugWatcher::_rescan(bool notify)
+{
+    QSet<QString> present;
+    const QStringList entries = QDir(_deviceDirectory).entryList(QDir::System | QDir::Files | QDir::NoDotAndDotDot);
+    for (const QString &name : entries) {
+        if (isHotplugPortName(name)) {
+            (void) present.insert(name);
+        }
+    }
+
+    if (!notify) {
+        _portNames = present;
+        return;
+    }
+
+    const QSet<QString> removed = QSet<QString>(_portNames).subtract(present);
+    for (const QString &name : removed) {
+        _removePort(name);
+    }
+    for (const QString &name : present) {
+        _addPort(name);
+    }
+}
+
+void SerialPortHotplugWatcher::_addPort(const QString &name)
+{
+    if (_portNames.contains(name)) {
+        return;
+    }
+
+    (void) _portNames.insert(name);
+    const QString systemLocation = _systemLocation(name);
+    qCDebug(SerialPortHotplugWatcherLog) << "Port added" << systemLocation;
+    emit portAdded(systemLocation);
+}
+
+void SerialPortHotplugWatcher::_removePort(const QString &name)
+{
+    if (!_portNames.remove(name)) {
+        return;
+    }
+
+    const QString systemLocation = _systemLocation(name);
+    qCDebug(SerialPortHotplugWatcherLog) << "Port removed" << systemLocation;
+    emit portRemoved(systemLocation);
+}
+
+QString SerialPortHotplugWatcher::_systemLocation(const QString &name) const
+{
+    return QDir(_deviceDirectory).filePath(name);
+}
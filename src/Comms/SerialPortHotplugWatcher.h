@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class QSocketNotifier;
+
+/// Watches a device directory with inotify and keeps an incremental table of the hotpluggable serial ports in it
+/// (USB CDC ACM, USB serial converters including vendor drivers such as ttyCH343USB, Bluetooth RFCOMM). devtmpfs creates and removes the node as part of handling
+/// the kernel uevent, so the change is seen as soon as the kernel publishes it instead of on the next
+/// QGCSerialPortInfo::availablePorts() poll.
+///
+/// The directory is scanned once on start(); from then on only inotify events update the table. If the inotify queue
+/// overflows the directory is rescanned and the differences reported.
+class SerialPortHotplugWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialPortHotplugWatcher(QObject *parent = nullptr);
+    ~SerialPortHotplugWatcher();
+
+    /// Starts watching @a deviceDirectory. Ports already present are added to the table without signals.
+    ///     @return false if inotify is not available, in which case callers must keep polling
+    bool start(const QString &deviceDirectory = QStringLiteral("/dev"));
+    void stop();
+
+    bool isActive() const { return (_inotifyFd >= 0); }
+    QString deviceDirectory() const { return _deviceDirectory; }
+
+    /// System locations of the ports currently present, sorted
+    QStringList ports() const;
+
+    /// true: @a name is a device node name this watcher tracks
+    static bool isHotplugPortName(const QString &name);
+
+signals:
+    void portAdded(const QString &systemLocation);
+    void portRemoved(const QString &systemLocation);
+
+    /// The watch went away (directory removed or unmounted), the table is no longer maintained
+    void stopped();
+
+private slots:
+    void _readEvents();
+
+private:
+    void _rescan(bool notify);
+    void _addPort(const QString &name);
+    void _removePort(const QString &name);
+    QString _systemLocation(const QString &name) const;
+
+    int _inotifyFd = -1;
+    int _watchDescriptor = -1;
+    QSocketNotifier *_notifier = nullptr;
+    QString _deviceDirectory;
+    QSet<QString> _portNames;           ///< Device node names, not paths
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+/// @file TelemetryShmLayout.h
+/// @brief Memory layout of the shared memory telemetry export.
+///
+/// Shared by the publisher inside QGC and by TelemetryShmReader. Plain C++17 without Qt so external consumers can
+/// include it directly. The segment holds a header, a table with the latest state of each vehicle and a ring of raw
+/// MAVLink frames. There is a single writer and any number of readers; every slot is guarded by its own seqlock so
+/// readers never block the writer and retry when they raced with an update.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace TelemetryShm
+{
+
+constexpr uint32_t kMagic = 0x54434751;             ///< "QGCT"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kMaxVehicles = 16;
+constexpr uint32_t kFrameSlotCount = 4096;          ///< Power of two
+constexpr uint32_t kMaxFrameLength = 280;           ///< MAVLINK_MAX_PACKET_LEN
+constexpr const char *kDefaultName = "/qgc_telemetry";
+
+/// Decoded vehicle state, filled from the latest message of each kind
+struct VehicleState {
+    uint64_t updateTimeUs;          ///< monotonicMicros() of the last update
+    uint64_t messageCount;          ///< Messages received from this system
+    uint8_t systemId;               ///< 0 for an unused slot
+    uint8_t componentId;
+    uint8_t autopilot;              ///< MAV_AUTOPILOT
+    uint8_t vehicleType;            ///< MAV_TYPE
+    uint8_t baseMode;               ///< MAV_MODE_FLAG
+    uint8_t systemStatus;           ///< MAV_STATE
+    uint8_t armed;
+    uint8_t gpsFixType;             ///< GPS_FIX_TYPE
+    uint32_t customMode;
+    uint8_t satellitesVisible;
+    int8_t batteryRemainingPct;     ///< -1 when unknown
+    uint16_t reserved;
+    double latitudeDeg;
+    double longitudeDeg;
+    float altitudeAmslM;
+    float altitudeRelativeM;
+    float rollRad;
+    float pitchRad;
+    float yawRad;
+    float rollRateRadS;
+    float pitchRateRadS;
+    float yawRateRadS;
+    float groundSpeedMS;
+    float airSpeedMS;
+    float climbRateMS;
+    float headingDeg;
+    float batteryVoltageV;
+    float batteryCurrentA;
+    float hdop;
+};
+static_assert(std::is_trivially_copyable_v<VehicleState>);
+
+struct alignas(64) VehicleSlot {
+    std::atomic<uint32_t> sequence;     ///< Seqlock, odd while the slot is being written
+    VehicleState state;
+};
+
+struct alignas(64) FrameSlot {
+    std::atomic<uint32_t> sequence;     ///< Seqlock, odd while the slot is being written
+    uint16_t length;
+    uint8_t channel;                    ///< MAVLink channel of the link the frame arrived on
+    uint8_t reserved;
+    uint64_t index;                     ///< Position in the overall frame stream
+    uint64_t timestampUs;               ///< monotonicMicros() when published
+    uint8_t bytes[kMaxFrameLength];     ///< Unsigned wire bytes
+};
+
+struct alignas(64) Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segmentSize;
+    uint32_t maxVehicles;
+    uint32_t frameSlotCount;
+    uint32_t maxFrameLength;
+    std::atomic<int32_t> publisherPid;
+    uint32_t reserved;
+    std::atomic<uint64_t> frameWriteIndex;      ///< Frames published so far, the next one goes to this index
+    std::atomic<uint64_t> publisherUpdateUs;    ///< monotonicMicros() of the last publish
+};
+
+struct Segment {
+    Header header;
+    VehicleSlot vehicles[kMaxVehicles];
+    FrameSlot frames[kFrameSlotCount];
+};
+
+static_assert((kFrameSlotCount & (kFrameSlotCount - 1)) == 0);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+/// Time base shared by publisher and readers (CLOCK_MONOTONIC on POSIX)
+inline uint64_t monotonicMicros()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Writer side of a seqlock, only ever called by the single publisher
+template<typename WriteFn>
+inline void seqlockWrite(std::atomic<uint32_t> &sequence, WriteFn &&write)
+{
+    const uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    write();
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+/// Reader side of a seqlock. @return false if the copy raced with a write and must be retried
+template<typename ReadFn>
+inline bool seqlockRead(const std::atomic<uint32_t> &sequence, ReadFn &&read)
+{
+    const uint32_t start = sequence.load(std::memory_order_acquire);
+    if (start & 1) {
+        return false;
+    }
+    read();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence.load(std::memory_order_relaxed) == start;
+}
+
+} // namespace TelemetryShm
@@ -0,0 +1,268 @@
+#include "TelemetryShmPublisher.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QtGlobal>
+
+#include <cmath>
+#include <cstring>
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TELEMETRY_SHM_POSIX
+#endif
+
+QGC_LOGGING_CATEGORY(TelemetryShmPublisherLog, "Comms.TelemetryShmPublisher")
+
+using namespace TelemetryShm;
+
+TelemetryShmPublisher::~TelemetryShmPublisher()
+{
+    close();
+}
+
+bool TelemetryShmPublisher::open(const QString& name, [[maybe_unused]] bool otherUsers)
+{
+    close();
+
+#ifdef TELEMETRY_SHM_POSIX
+    if (!name.startsWith(QLatin1Char('/')) || (name.indexOf(QLatin1Char('/'), 1) >= 0)) {
+        qCWarning(TelemetryShmPublisherLog) << "Invalid shared memory name" << name;
+        return false;
+    }
+
+    const QByteArray nativeName = name.toLocal8Bit();
+
+    // Start from a fresh segment so readers of a stale one from a crashed instance see it unlinked
+    (void) ::shm_unlink(nativeName.constData());
+    const mode_t mode = otherUsers ? 0644 : 0600;
+    _fd = ::shm_open(nativeName.constData(), O_CREAT | O_EXCL | O_RDWR, mode);
+    if (_fd < 0) {
+        qCWarning(TelemetryShmPublisherLog) << "shm_open failed" << name << qt_error_string(errno);
+        return false;
+    }
+
+    // The umask may have narrowed the mode, sharing with other users was asked for explicitly
+    if (otherUsers && (::fchmod(_fd, mode) != 0)) {
+        qCWarning(TelemetryShmPublisherLog) << "fchmod failed" << name << qt_error_string(errno);
+    }
+
+    if (::ftruncate(_fd, static_cast<off_t>(sizeof(Segment))) != 0) {
+        qCWarning(TelemetryShmPublisherLog) << "ftruncate failed" << name << qt_error_string(errno);
+        (void) ::close(_fd);
+        _fd = -1;
+        (void) ::shm_unlink(nativeName.constData());
+        return false;
+    }
+
+    void* const mapping = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (mapping == MAP_FAILED) {
+        qCWarning(TelemetryShmPublisherLog) << "mmap failed" << name << qt_error_string(errno);
+        (void) ::close(_fd);
+        _fd = -1;
+        (void) ::shm_unlink(nativeName.constData());
+        return false;
+    }
+
+    // ftruncate zero fills, which is a valid initial state for every slot and atomic
+    _segment = static_cast<Segment*>(mapping);
+    _name = name;
+    _otherUsers = otherUsers;
+    _frameWriteIndex = 0;
+    std::memset(_shadow, 0, sizeof(_shadow));
+
+    Header& header = _segment->header;
+    header.version = kVersion;
+    header.segmentSize = sizeof(Segment);
+    header.maxVehicles = kMaxVehicles;
+    header.frameSlotCount = kFrameSlotCount;
+    header.maxFrameLength = kMaxFrameLength;
+    header.publisherPid.store(static_cast<int32_t>(::getpid()), std::memory_order_relaxed);
+    header.publisherUpdateUs.store(monotonicMicros(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    // Readers validate the magic last
+    header.magic = kMagic;
+
+    qCDebug(TelemetryShmPublisherLog) << "Publishing telemetry to" << name << sizeof(Segment) << "bytes";
+    return true;
+#else
+    qCDebug(TelemetryShmPublisherLog) << "Shared memory export not supported on this platform" << name;
+    return false;
+#endif
+}
+
+void TelemetryShmPublisher::close()
+{
+#ifdef TELEMETRY_SHM_POSIX
+    if (_segment) {
+        _segment->header.publisherPid.store(0, std::memory_order_relaxed);
+        (void) ::munmap(_segment, sizeof(Segment));
+        (void) ::shm_unlink(_name.toLocal8Bit().constData());
+        qCDebug(TelemetryShmPublisherLog) << "Closed" << _name;
+    }
+    if (_fd >= 0) {
+        (void) ::close(_fd);
+    }
+#endif
+    _segment = nullptr;
+    _fd = -1;
+    _name.clear();
+}
+
+void TelemetryShmPublisher::publish(uint8_t channel, const mavlink_message_t& message, QByteArrayView frame)
+{
+    if (!_segment) {
+        return;
+    }
+
+    const uint64_t nowUs = monotonicMicros();
+    _publishFrame(channel, frame, nowUs);
+
+    const int slot = _vehicleSlot(message.sysid, message.msgid == MAVLINK_MSG_ID_HEARTBEAT);
+    if (slot >= 0) {
+        VehicleState& state = _shadow[slot];
+        (void) _decode(message, state);
+        state.messageCount++;
+        state.updateTimeUs = nowUs;
+
+        VehicleSlot& vehicleSlot = _segment->vehicles[slot];
+        seqlockWrite(vehicleSlot.sequence, [&]() { std::memcpy(&vehicleSlot.state, &state, sizeof(state)); });
+    }
+
+    _segment->header.publisherUpdateUs.store(nowUs, std::memory_order_relaxed);
+}
+
+void TelemetryShmPublisher::_publishFrame(uint8_t channel, QByteArrayView frame, uint64_t nowUs)
+{
+    const uint16_t length = static_cast<uint16_t>(qMin<qsizetype>(frame.size(), kMaxFrameLength));
+
+    FrameSlot& slot = _segment->frames[_frameWriteIndex & (kFrameSlotCount - 1)];
+    seqlockWrite(slot.sequence, [&]() {
+        slot.length = length;
+        slot.channel = channel;
+        slot.index = _frameWriteIndex;
+        slot.timestampUs = nowUs;
+        std::memcpy(slot.bytes, frame.constData(), length);
+    });
+
+    _frameWriteIndex++;
+    _segment->header.frameWriteIndex.store(_frameWriteIndex, std::memory_order_release);
+}
+
+int TelemetryShmPublisher::_vehicleSlot(uint8_t systemId, bool create)
+{
+    if (systemId == 0) {
+        return -1;
+    }
+
+    int freeSlot = -1;
+    for (uint32_t slot = 0; slot < kMaxVehicles; slot++) {
+        if (_shadow[slot].systemId == systemId) {
+            return static_cast<int>(slot);
+        }
+        if ((freeSlot < 0) && (_shadow[slot].systemId == 0)) {
+            freeSlot = static_cast<int>(slot);
+        }
+    }
+
+    if (!create || (freeSlot < 0)) {
+        return -1;
+    }
+
+    // Only heartbeats create an entry, it is filtered to vehicles in _decode
+    VehicleState& state = _shadow[freeSlot];
+    std::memset(&state, 0, sizeof(state));
+    state.batteryRemainingPct = -1;
+    state.latitudeDeg = std::nan("");
+    state.longitudeDeg = std::nan("");
+    return freeSlot;
+}
+
+bool TelemetryShmPublisher::_decode(const mavlink_message_t& message, VehicleState& state) const
+{
+    switch (message.msgid) {
+    case MAVLINK_MSG_ID_HEARTBEAT: {
+        mavlink_heartbeat_t heartbeat{};
+        mavlink_msg_heartbeat_decode(&message, &heartbeat);
+        // Components other than the autopilot (cameras, gimbals, other GCS) don't own the vehicle state
+        if ((heartbeat.type == MAV_TYPE_GCS) || (heartbeat.autopilot == MAV_AUTOPILOT_INVALID)) {
+            return false;
+        }
+        state.systemId = message.sysid;
+        state.componentId = message.compid;
+        state.autopilot = heartbeat.autopilot;
+        state.vehicleType = heartbeat.type;
+        state.baseMode = heartbeat.base_mode;
+        state.customMode = heartbeat.custom_mode;
+        state.systemStatus = heartbeat.system_status;
+        state.armed = (heartbeat.base_mode & MAV_MODE_FLAG_SAFETY_ARMED) ? 1 : 0;
+        return true;
+    }
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT: {
+        mavlink_global_position_int_t position{};
+        mavlink_msg_global_position_int_decode(&message, &position);
+        state.latitudeDeg = position.lat / 1e7;
+        state.longitudeDeg = position.lon / 1e7;
+        state.altitudeAmslM = position.alt / 1000.0f;
+        state.altitudeRelativeM = position.relative_alt / 1000.0f;
+        return true;
+    }
+    case MAVLINK_MSG_ID_ATTITUDE: {
+        mavlink_attitude_t attitude{};
+        mavlink_msg_attitude_decode(&message, &attitude);
+        state.rollRad = attitude.roll;
+        state.pitchRad = attitude.pitch;
+        state.yawRad = attitude.yaw;
+        state.rollRateRadS = attitude.rollspeed;
+        state.pitchRateRadS = attitude.pitchspeed;
+        state.yawRateRadS = attitude.yawspeed;
+        return true;
+    }
+    case MAVLINK_MSG_ID_VFR_HUD: {
+        mavlink_vfr_hud_t vfrHud{};
+        mavlink_msg_vfr_hud_decode(&message, &vfrHud);
+        state.groundSpeedMS = vfrHud.groundspeed;
+        state.airSpeedMS = vfrHud.airspeed;
+        state.climbRateMS = vfrHud.climb;
+        state.headingDeg = vfrHud.heading;
+        return true;
+    }
+    case MAVLINK_MSG_ID_SYS_STATUS: {
+        mavlink_sys_status_t sysStatus{};
+        mavlink_msg_sys_status_decode(&message, &sysStatus);
+        if (sysStatus.voltage_battery != UINT16_MAX) {
+            state.batteryVoltageV = sysStatus.voltage_battery / 1000.0f;
+        }
+        if (sysStatus.current_battery != -1) {
+            state.batteryCurrentA = sysStatus.current_battery / 100.0f;
+        }
+        state.batteryRemainingPct = sysStatus.battery_remaining;
+        return true;
+    }
+    case MAVLINK_MSG_ID_BATTERY_STATUS: {
+        mavlink_battery_status_t battery{};
+        mavlink_msg_battery_status_decode(&message, &battery);
+        // The snapshot holds the first battery, SYS_STATUS covers vehicles which don't send BATTERY_STATUS
+        if (battery.id != 0) {
+            return false;
+        }
+        if (battery.current_battery != -1) {
+            state.batteryCurrentA = battery.current_battery / 100.0f;
+        }
+        state.batteryRemainingPct = battery.battery_remaining;
+        return true;
+    }
+    case MAVLINK_MSG_ID_GPS_RAW_INT: {
+        mavlink_gps_raw_int_t gps{};
+        mavlink_msg_gps_raw_int_decode(&message, &gps);
+        state.gpsFixType = gps.fix_type;
+        state.satellitesVisible = gps.satellites_visible;
+        state.hdop = (gps.eph == UINT16_MAX) ? std::nanf("") : (gps.eph / 100.0f);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
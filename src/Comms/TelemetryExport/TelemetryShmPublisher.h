@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QString>
+
+#include "MAVLinkLib.h"
+#include "TelemetryShmLayout.h"
+
+/// Publishes received telemetry to a POSIX shared memory segment for local consumers.
+///
+/// The segment holds the latest decoded state of each vehicle and a ring of the raw (unsigned) MAVLink frames; see
+/// TelemetryShmLayout.h. Publishing never blocks: each slot is a seqlock written by this single publisher and readers
+/// (TelemetryShmReader) retry on a torn read. Not available on Windows and Android, open() fails there.
+class TelemetryShmPublisher
+{
+public:
+    TelemetryShmPublisher() = default;
+    ~TelemetryShmPublisher();
+
+    TelemetryShmPublisher(const TelemetryShmPublisher&) = delete;
+    TelemetryShmPublisher& operator=(const TelemetryShmPublisher&) = delete;
+
+    /// Creates (or replaces) the segment @p name. It carries vehicle positions, so only the owner can read it unless
+    /// @p otherUsers is set.
+    bool open(const QString& name = QString::fromLatin1(TelemetryShm::kDefaultName), bool otherUsers = false);
+    /// Unmaps and unlinks the segment
+    void close();
+    bool isOpen() const { return _segment != nullptr; }
+    QString name() const { return _name; }
+    bool otherUsers() const { return _otherUsers; }
+
+    /// Publishes @p message received on MAVLink channel @p channel, @p frame holds its wire bytes
+    void publish(uint8_t channel, const mavlink_message_t& message, QByteArrayView frame);
+
+    uint64_t publishedFrames() const { return _frameWriteIndex; }
+
+private:
+    /// Updates the shadow state of the sending vehicle. @return false if the message carries no snapshot data.
+    bool _decode(const mavlink_message_t& message, TelemetryShm::VehicleState& state) const;
+    int _vehicleSlot(uint8_t systemId, bool create);
+    void _publishFrame(uint8_t channel, QByteArrayView frame, uint64_t nowUs);
+
+    TelemetryShm::Segment* _segment = nullptr;
+    QString _name;
+    bool _otherUsers = false;
+    int _fd = -1;
+    uint64_t _frameWriteIndex = 0;
+
+    /// Publisher side copy of the vehicle table, each message patches it and the whole state is copied to the slot
+    TelemetryShm::VehicleState _shadow[TelemetryShm::kMaxVehicles]{};
+};
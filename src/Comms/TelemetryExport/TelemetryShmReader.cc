@@ -0,0 +1,180 @@
+#include "TelemetryShmReader.h"
+
+#include <cstring>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TELEMETRY_SHM_POSIX
+#endif
+
+using namespace TelemetryShm;
+
+TelemetryShmReader::~TelemetryShmReader()
+{
+    close();
+}
+
+bool TelemetryShmReader::open(const char *name)
+{
+    close();
+
+#ifdef TELEMETRY_SHM_POSIX
+    _fd = ::shm_open(name, O_RDONLY, 0);
+    if (_fd < 0) {
+        return false;
+    }
+
+    struct stat info{};
+    if ((::fstat(_fd, &info) != 0) || (static_cast<size_t>(info.st_size) < sizeof(Segment))) {
+        close();
+        return false;
+    }
+
+    void *const mapping = ::mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, _fd, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    _segment = static_cast<const Segment *>(mapping);
+    const Header &header = _segment->header;
+    if ((header.magic != kMagic) || (header.version != kVersion) || (header.segmentSize != sizeof(Segment))
+        || (header.maxVehicles != kMaxVehicles) || (header.frameSlotCount != kFrameSlotCount)
+        || (header.maxFrameLength != kMaxFrameLength)) {
+        close();
+        return false;
+    }
+
+    seekToLatest();
+    _droppedFrames = 0;
+    return true;
+#else
+    (void) name;
+    return false;
+#endif
+}
+
+void TelemetryShmReader::close()
+{
+#ifdef TELEMETRY_SHM_POSIX
+    if (_segment) {
+        (void) ::munmap(const_cast<Segment *>(_segment), sizeof(Segment));
+    }
+    if (_fd >= 0) {
+        (void) ::close(_fd);
+    }
+#endif
+    _segment = nullptr;
+    _fd = -1;
+    _readIndex = 0;
+}
+
+bool TelemetryShmReader::_readVehicleSlot(uint32_t slot, VehicleState &state) const
+{
+    const VehicleSlot &vehicleSlot = _segment->vehicles[slot];
+    for (int attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+        if (seqlockRead(vehicleSlot.sequence, [&]() { std::memcpy(&state, &vehicleSlot.state, sizeof(state)); })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<uint8_t> TelemetryShmReader::vehicles() const
+{
+    std::vector<uint8_t> systemIds;
+    if (!_segment) {
+        return systemIds;
+    }
+
+    VehicleState state;
+    for (uint32_t slot = 0; slot < kMaxVehicles; slot++) {
+        if (_readVehicleSlot(slot, state) && (state.systemId != 0)) {
+            systemIds.push_back(state.systemId);
+        }
+    }
+    return systemIds;
+}
+
+bool TelemetryShmReader::vehicleState(uint8_t systemId, VehicleState &state) const
+{
+    if (!_segment || (systemId == 0)) {
+        return false;
+    }
+
+    for (uint32_t slot = 0; slot < kMaxVehicles; slot++) {
+        if (_readVehicleSlot(slot, state) && (state.systemId == systemId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TelemetryShmReader::readFrame(Frame &frame)
+{
+    if (!_segment) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+        const uint64_t writeIndex = _segment->header.frameWriteIndex.load(std::memory_order_acquire);
+        if (_readIndex >= writeIndex) {
+            return false;
+        }
+
+        // Fell more than a ring behind: everything older than one ring has been overwritten
+        if ((writeIndex - _readIndex) > kFrameSlotCount) {
+            const uint64_t oldest = writeIndex - kFrameSlotCount;
+            _droppedFrames += oldest - _readIndex;
+            _readIndex = oldest;
+        }
+
+        const FrameSlot &slot = _segment->frames[_readIndex & (kFrameSlotCount - 1)];
+        uint64_t slotIndex = 0;
+        const bool consistent = seqlockRead(slot.sequence, [&]() {
+            slotIndex = slot.index;
+            frame.index = slot.index;
+            frame.timestampUs = slot.timestampUs;
+            frame.channel = slot.channel;
+            frame.length = (slot.length <= kMaxFrameLength) ? slot.length : kMaxFrameLength;
+            std::memcpy(frame.bytes, slot.bytes, frame.length);
+        });
+
+        if (!consistent) {
+            continue;
+        }
+        if (slotIndex != _readIndex) {
+            // Overwritten between loading the write index and copying the slot
+            if (slotIndex > _readIndex) {
+                continue;
+            }
+            return false;
+        }
+
+        _readIndex++;
+        return true;
+    }
+
+    return false;
+}
+
+void TelemetryShmReader::seekToLatest()
+{
+    if (_segment) {
+        _readIndex = _segment->header.frameWriteIndex.load(std::memory_order_acquire);
+    }
+}
+
+bool TelemetryShmReader::publisherAlive(uint64_t timeoutUs) const
+{
+    if (!_segment || (_segment->header.publisherPid.load(std::memory_order_relaxed) == 0)) {
+        return false;
+    }
+
+    const uint64_t updateUs = _segment->header.publisherUpdateUs.load(std::memory_order_relaxed);
+    const uint64_t nowUs = monotonicMicros();
+    return (nowUs >= updateUs) && ((nowUs - updateUs) <= timeoutUs);
+}
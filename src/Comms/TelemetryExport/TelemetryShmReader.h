@@ -0,0 +1,70 @@
+#pragma once
+
+/// @file TelemetryShmReader.h
+/// @brief Reader for the telemetry QGC exports to shared memory.
+///
+/// Standalone (C++17 and POSIX only, no Qt) so it can be copied into other applications together with
+/// TelemetryShmLayout.h. The segment is mapped read-only and readers never block the publisher.
+///
+/// Example usage:
+/// @code
+/// TelemetryShmReader reader;
+/// if (reader.open()) {
+///     TelemetryShm::VehicleState state;
+///     if (reader.vehicleState(1, state)) { ... }
+///     TelemetryShmReader::Frame frame;
+///     while (reader.readFrame(frame)) { ... }
+/// }
+/// @endcode
+
+#include "TelemetryShmLayout.h"
+
+#include <vector>
+
+class TelemetryShmReader
+{
+public:
+    struct Frame {
+        uint64_t index = 0;
+        uint64_t timestampUs = 0;
+        uint8_t channel = 0;
+        uint16_t length = 0;
+        uint8_t bytes[TelemetryShm::kMaxFrameLength];
+    };
+
+    TelemetryShmReader() = default;
+    ~TelemetryShmReader();
+
+    TelemetryShmReader(const TelemetryShmReader &) = delete;
+    TelemetryShmReader &operator=(const TelemetryShmReader &) = delete;
+
+    /// Maps the segment published under @p name. Frame reading starts at the newest frame.
+    bool open(const char *name = TelemetryShm::kDefaultName);
+    void close();
+    bool isOpen() const { return _segment != nullptr; }
+
+    /// System ids of the vehicles currently in the table
+    std::vector<uint8_t> vehicles() const;
+    /// Copies the latest state of vehicle @p systemId
+    bool vehicleState(uint8_t systemId, TelemetryShm::VehicleState &state) const;
+
+    /// Reads the next frame in order. @return false when there is no newer frame.
+    /// Frames the publisher overwrote before they were read are skipped and counted in droppedFrames().
+    bool readFrame(Frame &frame);
+    /// Skips all pending frames
+    void seekToLatest();
+    uint64_t droppedFrames() const { return _droppedFrames; }
+
+    /// True if the publisher updated the segment within the last @p timeoutUs
+    bool publisherAlive(uint64_t timeoutUs = 2000000) const;
+
+private:
+    bool _readVehicleSlot(uint32_t slot, TelemetryShm::VehicleState &state) const;
+
+    const TelemetryShm::Segment *_segment = nullptr;
+    int _fd = -1;
+    uint64_t _readIndex = 0;
+    uint64_t _droppedFrames = 0;
+
+    static constexpr int kMaxReadAttempts = 64;
+};
@@ -11,6 +11,9 @@
 #include "QGCCorePlugin.h"
 #include "QGCLoggingCategory.h"
 #include "SettingsManager.h"
+#include "TelemetryStore.h"
+
+#include <QtCore/QMetaMethod>
 
 QGC_LOGGING_CATEGORY(FactLog, "FactSystem.Fact")
 
@@ -76,6 +79,77 @@ Fact::Fact(const Fact &other, QObject *parent)
 Fact::~Fact()
 {
     // qCDebug(FactLog) << Q_FUNC_INFO << this;
+
+    if (_telemetrySlot >= 0) {
+        if (TelemetryStore *const store = TelemetryStore::existingInstance()) {
+            store->unregisterFact(_telemetrySlot);
+        }
+    }
+}
+
+void Fact::_detachFromTelemetryStore(const QVariant &storedValue)
+{
+    if (_telemetryStoreHoldsValue) {
+        QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+        _rawValue = storedValue;
+    }
+    _telemetryStoreHoldsValue = false;
+    _telemetrySlot = -1;
+}
+
+void Fact::attachToTelemetryStore(int updateRateMSecs)
+{
+    if (_telemetrySlot >= 0) {
+        return;
+    }
+
+    const QVariant currentValue = rawValue();
+    _telemetrySlot = TelemetryStore::instance()->registerFact(this, _type, updateRateMSecs);
+    if ((_telemetrySlot >= 0) && TelemetryStore::isStoredType(_type)) {
+        (void) TelemetryStore::instance()->setValue(_telemetrySlot, currentValue);
+        _telemetryStoreHoldsValue = true;
+    }
+}
+
+QVariant Fact::_loadRawValue() const
+{
+    if (_telemetryStoreHoldsValue) {
+        return TelemetryStore::instance()->value(_telemetrySlot);
+    }
+
+    QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+    return _rawValue;
+}
+
+bool Fact::_storeRawValue(const QVariant &value)
+{
+    // Counted even when the value does not change, the group still handled a message for it
+    if (_groupValueWrites) {
+        ++(*_groupValueWrites);
+    }
+
+    if (_telemetryStoreHoldsValue) {
+        return TelemetryStore::instance()->setValue(_telemetrySlot, value);
+    }
+
+    QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+    if (_rawValue == value) {
+        return false;
+    }
+    _rawValue = value;
+    return true;
+}
+
+bool Fact::isObserved() const
+{
+    static const QMetaMethod valueChangedSignal = QMetaMethod::fromSignal(&Fact::valueChanged);
+    static const QMetaMethod rawValueChangedSignal = QMetaMethod::fromSignal(&Fact::rawValueChanged);
+    return (isSignalConnected(valueChangedSignal) || isSignalConnected(rawValueChangedSignal));
+}
+
+QVariant Fact::rawValue() const
+{
+    return _loadRawValue();
 }
 
 void Fact::_init()
@@ -89,18 +163,17 @@ const Fact &Fact::operator=(const Fact& other)
         return *this;
     }
 
-    QMutexLocker<QRecursiveMutex> otherLocker(&other._rawValueMutex);
-    QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+    const QVariant otherRawValue = other._loadRawValue();
 
     _name = other._name;
     _componentId = other._componentId;
-    _rawValue = other._rawValue;
     _type = other._type;
+    (void) _storeRawValue(otherRawValue);
     _sendValueChangedSignals = other._sendValueChangedSignals;
     _deferredValueChangeSignal = other._deferredValueChangeSignal;
     _valueSliderModel = nullptr;
     if (_metaData && other._metaData) {
-        *_metaData = *other._metaData;
+        *_writableMetaData() = *other._metaData;
     } else {
         _metaData = nullptr;
     }
@@ -115,13 +188,9 @@ void Fact::forceSetRawValue(const QVariant &value)
         QString errorString;
 
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
-            {
-                QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
-                _rawValue = typedValue;
-            }
+            (void) _storeRawValue(typedValue);
 
-            const QVariant cooked = _metaData->rawTranslator()(typedValue);
-            _sendValueChangedSignal(cooked);
+            _sendValueChangedSignal();
             //-- Must be in this order
             emit containerRawValueChanged(typedValue);
             emit rawValueChanged(typedValue);
@@ -138,18 +207,8 @@ void Fact::setRawValue(const QVariant &value)
         QString errorString;
 
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
-            bool changed = false;
-            {
-                QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
-                if (typedValue != _rawValue) {
-                    _rawValue = typedValue;
-                    changed = true;
-                }
-            }
-
-            if (changed) {
-                const QVariant cooked = _metaData->rawTranslator()(typedValue);
-                _sendValueChangedSignal(cooked);
+            if (_storeRawValue(typedValue)) {
+                _sendValueChangedSignal();
                 //-- Must be in this order
                 emit containerRawValueChanged(typedValue);
                 emit rawValueChanged(typedValue);
@@ -197,25 +256,11 @@ void Fact::setEnumIndex(int index)
 
 void Fact::containerSetRawValue(const QVariant &value)
 {
-    QVariant cooked;
-    QVariant currentRaw = value;
-    bool changed = false;
-    {
-        QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
-        if (_rawValue != value) {
-            _rawValue = value;
-            changed = true;
-        }
-        currentRaw = _rawValue;
-        if (_metaData) {
-            cooked = _metaData->rawTranslator()(_rawValue);
-        } else {
-            cooked = _rawValue;
-        }
-    }
+    const bool changed = _storeRawValue(value);
+    const QVariant currentRaw = _telemetryStoreHoldsValue ? _loadRawValue() : value;
 
     if (changed) {
-        _sendValueChangedSignal(cooked);
+        _sendValueChangedSignal();
         emit rawValueChanged(currentRaw);
     }
 
@@ -225,13 +270,13 @@ void Fact::containerSetRawValue(const QVariant &value)
 
 QVariant Fact::cookedValue() const
 {
-    QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+    const QVariant raw = _loadRawValue();
     if (_metaData) {
-        return _metaData->rawTranslator()(_rawValue);
+        return _metaData->rawTranslator()(raw);
     }
 
     qCWarning(FactLog) << kMissingMetadata << name();
-    return _rawValue;
+    return raw;
 }
 
 QString Fact::enumStringValue()
@@ -269,7 +314,7 @@ int Fact::enumIndex()
                 index++;
             }
             // Current value is not in list, add it manually
-            _metaData->addEnumInfo(tr("Unknown: %1").arg(rawValue().toString()), rawValue());
+            _writableMetaData()->addEnumInfo(tr("Unknown: %1").arg(rawValue().toString()), rawValue());
             emit enumsChanged();
             return index;
         }
@@ -302,7 +347,7 @@ QVariantList Fact::enumValues() const
 void Fact::setEnumInfo(const QStringList &strings, const QVariantList &values)
 {
     if (_metaData) {
-        _metaData->setEnumInfo(strings, values);
+        _writableMetaData()->setEnumInfo(strings, values);
         emit enumsChanged();
     } else {
         qCWarning(FactLog) << kMissingMetadata << name();
@@ -722,6 +767,7 @@ QString Fact::group() const
 
 void Fact::setMetaData(FactMetaData *metaData, bool setDefaultFromMetaData)
 {
+    _sharedMetaData.reset();
     _metaData = metaData;
     if (setDefaultFromMetaData && metaData->defaultValueAvailable()) {
         setRawValue(rawDefaultValue());
@@ -729,6 +775,22 @@ void Fact::setMetaData(FactMetaData *metaData, bool setDefaultFromMetaData)
     emit valueChanged(cookedValue());
 }
 
+void Fact::setSharedMetaData(std::shared_ptr<const FactMetaData> metaData, bool setDefaultFromMetaData)
+{
+    // Only _writableMetaData() hands out the pointer for writing, and it copies first
+    setMetaData(const_cast<FactMetaData*>(metaData.get()), setDefaultFromMetaData);
+    _sharedMetaData = std::move(metaData);
+}
+
+FactMetaData *Fact::_writableMetaData()
+{
+    if (_sharedMetaData) {
+        _metaData = new FactMetaData(*_sharedMetaData, this);
+        _sharedMetaData.reset();
+    }
+    return _metaData;
+}
+
 bool Fact::valueEqualsDefault() const
 {
     if (_metaData) {
@@ -812,13 +874,17 @@ void Fact::setSendValueChangedSignals(bool sendValueChangedSignals)
     }
 }
 
-void Fact::_sendValueChangedSignal(const QVariant &value)
+void Fact::_sendValueChangedSignal()
 {
     if (_sendValueChangedSignals) {
-        emit valueChanged(value);
+        emit valueChanged(cookedValue());
         _deferredValueChangeSignal = false;
     } else {
+        // Deferred: the cooked value is only computed when the signal is actually published
         _deferredValueChangeSignal = true;
+        if (_telemetrySlot >= 0) {
+            TelemetryStore::instance()->markDirty(_telemetrySlot);
+        }
     }
 }
 
@@ -826,7 +892,12 @@ void Fact::sendDeferredValueChangedSignal()
 {
     if (_deferredValueChangeSignal) {
         _deferredValueChangeSignal = false;
-        emit valueChanged(cookedValue());
+
+        // Nothing observes the value (no QML binding, no connection): skip the translation and emit entirely
+        static const QMetaMethod valueChangedSignal = QMetaMethod::fromSignal(&Fact::valueChanged);
+        if (isSignalConnected(valueChangedSignal)) {
+            emit valueChanged(cookedValue());
+        }
     }
 }
 
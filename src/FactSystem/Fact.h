@@ -9,6 +9,8 @@
 
 #include "FactMetaData.h"
 
+#include <memory>
+
 class FactValueSliderListModel;
 
 /// \brief A Fact is used to hold a single value within the system.
@@ -83,11 +85,7 @@ class Fact : public QObject
     /// Convert and clamp value
     Q_INVOKABLE QVariant clamp(const QString &cookedValue);
     QVariant cookedValue() const; /// Value after translation
-    QVariant rawValue() const
-    {
-        QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
-        return _rawValue;
-    }
+    QVariant rawValue() const;
     int componentId() const { return _componentId; }
     int decimalPlaces() const;
     int maxStringLength() const;
@@ -162,6 +160,14 @@ class Fact : public QObject
     void clearDeferredValueChangeSignal() { _deferredValueChangeSignal = false; }
     void sendDeferredValueChangedSignal();
 
+    /// Moves the value into the application-wide TelemetryStore and publishes deferred valueChanged signals from its
+    /// tick at the specified rate. Used by FactGroup for rate limited telemetry. Must be called from the GUI thread.
+    void attachToTelemetryStore(int updateRateMSecs);
+    int telemetrySlot() const { return _telemetrySlot; }
+
+    /// @return true: something (a QML binding, a chart, ...) is connected to valueChanged or rawValueChanged
+    bool isObserved() const;
+
     /// Sets and sends new value to vehicle even if value is the same
     void forceSetRawValue(const QVariant &value);
 
@@ -170,7 +176,13 @@ class Fact : public QObject
     ///     @param setDefaultFromMetaData true: set the fact value to the default specified in the meta data
     void setMetaData(FactMetaData *metaData, bool setDefaultFromMetaData = false);
 
-    FactMetaData *metaData() { return _metaData; }
+    /// Sets read only meta data which is shared with other Facts (see FactMetaDataRegistry). The Fact keeps it alive
+    /// and takes a private copy the first time it needs to change it.
+    void setSharedMetaData(std::shared_ptr<const FactMetaData> metaData, bool setDefaultFromMetaData = false);
+
+    /// @return Meta data which can be modified for this Fact only. Shared meta data is copied first.
+    FactMetaData *metaData() { return _writableMetaData(); }
+    const FactMetaData *metaData() const { return _metaData; }
 
     /// Value coming from Vehicle. This does NOT send a _containerRawValueChanged signal.
     void containerSetRawValue(const QVariant &value);
@@ -199,7 +211,12 @@ class Fact : public QObject
 
 protected:
     QString _variantToString(const QVariant &variant, int decimalPlaces) const;
-    void _sendValueChangedSignal(const QVariant &value);
+    void _sendValueChangedSignal();
+    FactMetaData *_writableMetaData();
+
+    /// Raw value storage: TelemetryStore slot for store-backed facts, _rawValue otherwise
+    QVariant _loadRawValue() const;
+    bool _storeRawValue(const QVariant &value);  ///< @return true: value changed
 
     QString _name;
     int _componentId = -1;
@@ -207,12 +224,23 @@ class Fact : public QObject
     mutable QRecursiveMutex _rawValueMutex;
     FactMetaData::ValueType_t _type = FactMetaData::valueTypeInt32;
     FactMetaData *_metaData = nullptr;
+    std::shared_ptr<const FactMetaData> _sharedMetaData;   ///< Set while _metaData is shared, which must not be written
     bool _sendValueChangedSignals = true;
     bool _deferredValueChangeSignal = false;
     FactValueSliderListModel *_valueSliderModel = nullptr;
+    int _telemetrySlot = -1;                ///< TelemetryStore slot, -1: not rate limited through the store
+    bool _telemetryStoreHoldsValue = false; ///< true: value lives in the store, _rawValue unused
+    quint64 *_groupValueWrites = nullptr;   ///< Write counter of the FactGroup holding this fact, see FactGroup::valueWrites()
 
     static constexpr const char *kMissingMetadata = "Meta data pointer missing";
 
+private:
+    /// Called by the TelemetryStore when it is destroyed before this fact: the value moves back into _rawValue
+    void _detachFromTelemetryStore(const QVariant &storedValue);
+
+    friend class FactGroup;
+    friend class TelemetryStore;
+
 private slots:
     void _checkForRebootMessaging();
 
@@ -2,7 +2,10 @@
 
 #include <QtCore/QJsonArray>
 
+#include <algorithm>
+
 #include "QGCLoggingCategory.h"
+#include "TelemetryStore.h"
 
 QGC_LOGGING_CATEGORY(FactGroupLog, "FactSystem.FactGroup")
 
@@ -12,8 +15,10 @@ FactGroup::FactGroup(int updateRateMsecs, const QString &metaDataFile, QObject *
     , _ignoreCamelCase(ignoreCamelCase)
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
-    _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    if (_updateRateMSecs > 0) {
+        TelemetryStore::instance()->registerGroup(this, _updateRateMSecs);
+    }
+    _sharedMetaData = FactMetaDataRegistry::instance()->metaDataForFile(metaDataFile);
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject *parent, bool ignoreCamelCase)
@@ -22,12 +27,19 @@ FactGroup::FactGroup(int updateRateMsecs, QObject *parent, bool ignoreCamelCase)
     , _ignoreCamelCase(ignoreCamelCase)
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
-    _setupTimer();
+    if (_updateRateMSecs > 0) {
+        TelemetryStore::instance()->registerGroup(this, _updateRateMSecs);
+    }
 }
 
 FactGroup::~FactGroup()
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
+    if (_updateRateMSecs > 0) {
+        if (TelemetryStore *const store = TelemetryStore::existingInstance()) {
+            store->unregisterGroup(this);
+        }
+    }
 }
 
 void FactGroup::_loadFromJsonArray(const QJsonArray &jsonArray)
@@ -36,16 +48,6 @@ void FactGroup::_loadFromJsonArray(const QJsonArray &jsonArray)
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonArray(jsonArray, defineMap, this);
 }
 
-void FactGroup::_setupTimer()
-{
-    if (_updateRateMSecs > 0) {
-        (void) connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_updateAllValues);
-        _updateTimer.setSingleShot(false);
-        _updateTimer.setInterval(_updateRateMSecs);
-        _updateTimer.start();
-    }
-}
-
 bool FactGroup::factExists(const QString &name) const
 {
     if (name.contains(".")) {
@@ -123,7 +125,13 @@ void FactGroup::_addFact(Fact *fact, const QString &name)
     fact->setSendValueChangedSignals(_updateRateMSecs == 0);
     if (_nameToFactMetaDataMap.contains(name)) {
         fact->setMetaData(_nameToFactMetaDataMap[name], true /* setDefaultFromMetaData */);
+    } else if (const FactMetaData *const sharedMetaData = _sharedMetaData ? _sharedMetaData->value(name) : nullptr) {
+        fact->setSharedMetaData(std::shared_ptr<const FactMetaData>(_sharedMetaData, sharedMetaData), true /* setDefaultFromMetaData */);
     }
+    if (_updateRateMSecs > 0) {
+        fact->attachToTelemetryStore(_updateRateMSecs);
+    }
+    fact->_groupValueWrites = &_valueWrites;
     _nameToFactMap[name] = fact;
     _factNames.append(name);
 
@@ -144,22 +152,28 @@ void FactGroup::_addFactGroup(FactGroup *factGroup, const QString &name)
 
 void FactGroup::_updateAllValues()
 {
+    // Store backed facts are published from the store dirty set, only facts which did not get a slot remain here
     for (Fact *fact: _nameToFactMap) {
-        fact->sendDeferredValueChangedSignal();
+        if (fact->telemetrySlot() < 0) {
+            fact->sendDeferredValueChangedSignal();
+        }
     }
 }
 
+bool FactGroup::isObserved() const
+{
+    return std::any_of(_nameToFactMap.cbegin(), _nameToFactMap.cend(), [](const Fact *fact) {
+        return fact->isObserved();
+    });
+}
+
 void FactGroup::setLiveUpdates(bool liveUpdates)
 {
-    if (_updateTimer.interval() == 0) {
+    if (_updateRateMSecs == 0) {
         return;
     }
 
-    if (liveUpdates) {
-        _updateTimer.stop();
-    } else {
-        _updateTimer.start();
-    }
+    TelemetryStore::instance()->setGroupPaused(this, liveUpdates);
 
     for (Fact *fact: _nameToFactMap) {
         fact->setSendValueChangedSignals(liveUpdates);
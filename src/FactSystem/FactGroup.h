@@ -5,7 +5,10 @@
 #include <QtCore/QTimer>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <memory>
+
 #include "Fact.h"
+#include "FactMetaDataRegistry.h"
 #include "MAVLinkMessageType.h"
 
 class Vehicle;
@@ -44,6 +47,14 @@ class FactGroup : public QObject
     QStringList factGroupNames() const { return _nameToFactGroupMap.keys(); }
     bool telemetryAvailable() const { return _telemetryAvailable; }
     const QMap<QString, FactGroup*> &factGroups() const { return _nameToFactGroupMap; }
+    int updateRateMSecs() const { return _updateRateMSecs; }
+
+    /// Number of writes to the group's own Facts, changed or not. Compared around handleMessage() to learn which
+    /// messages feed the group.
+    quint64 valueWrites() const { return _valueWrites; }
+
+    /// @return true: one of the group's own Facts is observed (child groups are not included)
+    bool isObserved() const;
 
     /// Allows a FactGroup to parse incoming messages and fill in values
     virtual void handleMessage(Vehicle * /*vehicle*/, const mavlink_message_t & /*message*/) {}
@@ -54,6 +65,8 @@ class FactGroup : public QObject
     void telemetryAvailableChanged(bool telemetryAvailable);
 
 protected slots:
+    /// Called from the TelemetryStore publish tick at the group update rate. Deferred valueChanged signals of the
+    /// group Facts are published by the store itself, overrides only refresh computed values (e.g. clocks).
     virtual void _updateAllValues();
 
 protected:
@@ -71,11 +84,17 @@ protected slots:
     QMap<QString, FactMetaData*> _nameToFactMetaDataMap;
     QStringList _factNames;
 
+    /// Metadata loaded from the group json file, shared with all groups using the same file. Facts added to the group
+    /// hold their own reference, so it outlives child Facts destroyed after the group.
+    FactMetaDataRegistry::SharedMetaDataMap _sharedMetaData;
+
 private:
-    void _setupTimer();
+
     static QString _camelCase(const QString &text);
 
-    QTimer _updateTimer;
     const bool _ignoreCamelCase = false;
     bool _telemetryAvailable = false;
+    quint64 _valueWrites = 0;
+
+    friend class TelemetryStore;
 };
@@ -0,0 +1,59 @@
+#include "FactMetaDataRegistry.h"
+#include "FactMetaData.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QGlobalStatic>
+
+QGC_LOGGING_CATEGORY(FactMetaDataRegistryLog, "FactSystem.FactMetaDataRegistry")
+
+Q_GLOBAL_STATIC(FactMetaDataRegistry, _factMetaDataRegistryInstance);
+
+FactMetaDataRegistry *FactMetaDataRegistry::instance()
+{
+    return _factMetaDataRegistryInstance();
+}
+
+FactMetaDataRegistry::SharedMetaDataMap FactMetaDataRegistry::metaDataForFile(const QString &jsonFilename)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (SharedMetaDataMap metaDataMap = _files.value(jsonFilename).lock()) {
+        return metaDataMap;
+    }
+
+    // Parse while holding the lock so concurrent first users do not parse the same file twice
+    const QMap<QString, FactMetaData*> loadedMap = FactMetaData::createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */);
+    MetaDataMap *const parsedMap = new MetaDataMap();
+    for (auto it = loadedMap.constBegin(); it != loadedMap.constEnd(); ++it) {
+        (void) parsedMap->insert(it.key(), it.value());
+    }
+    const SharedMetaDataMap metaDataMap(parsedMap, [](const MetaDataMap *map) {
+        qDeleteAll(*map);
+        delete map;
+    });
+    _files.insert(jsonFilename, metaDataMap);
+    _parseCount++;
+
+    qCDebug(FactMetaDataRegistryLog) << "Loaded" << jsonFilename << metaDataMap->count() << "facts";
+
+    return metaDataMap;
+}
+
+int FactMetaDataRegistry::loadedFileCount() const
+{
+    QMutexLocker locker(&_mutex);
+
+    int count = 0;
+    for (const std::weak_ptr<const MetaDataMap> &metaDataMap : _files) {
+        if (!metaDataMap.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int FactMetaDataRegistry::parseCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _parseCount;
+}
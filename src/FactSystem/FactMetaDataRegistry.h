@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <memory>
+
+class FactMetaData;
+
+/// \brief Process-wide cache of FactMetaData loaded from json files.
+///
+/// Each file is parsed once and the resulting FactMetaData objects are shared by every user until the last reference
+/// is dropped, at which point they are deleted. FactGroup uses this for the telemetry metadata files, so fifty
+/// connected vehicles share one copy of VehicleFact.json instead of parsing and allocating it fifty times.
+///
+/// Shared metadata is read only. Facts receive it through Fact::setSharedMetaData, which keeps the file alive for as
+/// long as the Fact exists and gives the Fact a private copy when it is adjusted (e.g. FirmwarePlugin::adjustMetaData).
+/// Users which customize metadata per instance (mission items, settings) keep calling
+/// FactMetaData::createMapFromJsonFile directly.
+class FactMetaDataRegistry
+{
+public:
+    using MetaDataMap = QMap<QString, const FactMetaData*>;
+    using SharedMetaDataMap = std::shared_ptr<const MetaDataMap>;
+
+    static FactMetaDataRegistry *instance();
+
+    /// @return Metadata for the json file, parsed on first use. Empty map if the file could not be loaded.
+    SharedMetaDataMap metaDataForFile(const QString &jsonFilename);
+
+    /// @return Number of files with metadata currently alive
+    int loadedFileCount() const;
+
+    /// @return Number of times a file was actually parsed since startup
+    int parseCount() const;
+
+private:
+    mutable QMutex _mutex;
+    QHash<QString, std::weak_ptr<const MetaDataMap>> _files;
+    int _parseCount = 0;
+};
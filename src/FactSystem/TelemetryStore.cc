@@ -0,0 +1,284 @@
+#include "TelemetryStore.h"
+#include "Fact.h"
+#include "FactGroup.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QApplicationStatic>
+#include <QtCore/QCoreApplication>
+
+#include <algorithm>
+#include <bit>
+
+QGC_LOGGING_CATEGORY(TelemetryStoreLog, "FactSystem.TelemetryStore")
+
+Q_APPLICATION_STATIC(TelemetryStore, _telemetryStoreInstance);
+
+namespace {
+std::atomic<TelemetryStore*> s_existingInstance{nullptr};
+}
+
+TelemetryStore::TelemetryStore(QObject *parent)
+    : QObject(parent)
+{
+    // qCDebug(TelemetryStoreLog) << Q_FUNC_INFO << this;
+
+    s_existingInstance.store(this, std::memory_order_release);
+
+    // The publish tick emits Fact signals which drive QML, so it must run on the GUI thread
+    if (QCoreApplication::instance() && (thread() != QCoreApplication::instance()->thread())) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+TelemetryStore::~TelemetryStore()
+{
+    // qCDebug(TelemetryStoreLog) << Q_FUNC_INFO << this;
+
+    s_existingInstance.store(nullptr, std::memory_order_release);
+
+    // Facts and groups can outlive the application static. Hand the values back to the facts so they stay readable
+    // and their destructors have nothing left to unregister.
+    for (int slot = 0; slot < _slotHighWater; slot++) {
+        Fact *const fact = _page(slot)->facts[_index(slot)].load(std::memory_order_acquire);
+        if (fact) {
+            fact->_detachFromTelemetryStore(value(slot));
+        }
+    }
+
+    for (std::atomic<Page*> &page : _pages) {
+        delete page.exchange(nullptr);
+    }
+}
+
+TelemetryStore *TelemetryStore::instance()
+{
+    return _telemetryStoreInstance();
+}
+
+TelemetryStore *TelemetryStore::existingInstance()
+{
+    return s_existingInstance.load(std::memory_order_acquire);
+}
+
+bool TelemetryStore::isStoredType(FactMetaData::ValueType_t type)
+{
+    return (type != FactMetaData::valueTypeString) && (type != FactMetaData::valueTypeCustom);
+}
+
+int TelemetryStore::registerFact(Fact *fact, FactMetaData::ValueType_t type, int updateRateMSecs)
+{
+    int slot;
+    if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        if (_slotHighWater >= (kPageSize * kMaxPages)) {
+            qCWarning(TelemetryStoreLog) << "Telemetry store full, fact will use its own storage" << fact->name();
+            return -1;
+        }
+        slot = _slotHighWater++;
+        if (!_pages[slot >> kPageBits].load(std::memory_order_relaxed)) {
+            _pages[slot >> kPageBits].store(new Page, std::memory_order_release);
+        }
+    }
+
+    Page *const page = _page(slot);
+    const int index = _index(slot);
+    page->types[index] = static_cast<quint8>(type);
+    page->rateMSecs[index] = updateRateMSecs;
+    page->bits[index].store(0, std::memory_order_relaxed);
+    page->facts[index].store(fact, std::memory_order_release);
+    (void) page->dirty[index / 64].fetch_and(~(quint64{1} << (index % 64)), std::memory_order_relaxed);
+    _registeredFactCount++;
+
+    return slot;
+}
+
+void TelemetryStore::unregisterFact(int slot)
+{
+    if (slot < 0) {
+        return;
+    }
+
+    Page *const page = _page(slot);
+    const int index = _index(slot);
+    page->facts[index].store(nullptr, std::memory_order_release);
+    (void) page->dirty[index / 64].fetch_and(~(quint64{1} << (index % 64)), std::memory_order_relaxed);
+    _retiredSlots.push_back(slot);
+    _registeredFactCount--;
+
+    // Without a rate timer there is no publish pass to wait for
+    if (_rateTimers.isEmpty()) {
+        _recycleRetiredSlots();
+    }
+}
+
+void TelemetryStore::_recycleRetiredSlots()
+{
+    _freeSlots.insert(_freeSlots.end(), _retiredSlots.cbegin(), _retiredSlots.cend());
+    _retiredSlots.clear();
+}
+
+void TelemetryStore::registerGroup(FactGroup *group, int updateRateMSecs)
+{
+    _groups.append(GroupEntry{ group, updateRateMSecs, false });
+    _updateRateTimer(updateRateMSecs);
+}
+
+void TelemetryStore::unregisterGroup(FactGroup *group)
+{
+    for (qsizetype i = 0; i < _groups.count(); i++) {
+        if (_groups[i].group == group) {
+            const int updateRateMSecs = _groups[i].updateRateMSecs;
+            _groups.removeAt(i);
+            _updateRateTimer(updateRateMSecs);
+            break;
+        }
+    }
+}
+
+void TelemetryStore::setGroupPaused(FactGroup *group, bool paused)
+{
+    for (GroupEntry &entry : _groups) {
+        if (entry.group == group) {
+            entry.paused = paused;
+            break;
+        }
+    }
+}
+
+void TelemetryStore::_updateRateTimer(int updateRateMSecs)
+{
+    const bool inUse = std::any_of(_groups.cbegin(), _groups.cend(), [updateRateMSecs](const GroupEntry &entry) {
+        return entry.updateRateMSecs == updateRateMSecs;
+    });
+
+    QTimer *timer = _rateTimers.value(updateRateMSecs);
+    if (inUse && !timer) {
+        timer = new QTimer(this);
+        timer->setSingleShot(false);
+        timer->setInterval(updateRateMSecs);
+        (void) connect(timer, &QTimer::timeout, this, [this, updateRateMSecs]() { publish(updateRateMSecs); });
+        _rateTimers.insert(updateRateMSecs, timer);
+        timer->start();
+    } else if (!inUse && timer) {
+        (void) _rateTimers.remove(updateRateMSecs);
+        timer->deleteLater();
+        if (_rateTimers.isEmpty()) {
+            _recycleRetiredSlots();
+        }
+    }
+}
+
+QVariant TelemetryStore::value(int slot) const
+{
+    const Page *const page = _page(slot);
+    const int index = _index(slot);
+    const quint64 bits = page->bits[index].load(std::memory_order_relaxed);
+
+    switch (static_cast<FactMetaData::ValueType_t>(page->types[index])) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        return QVariant(static_cast<int>(static_cast<qint64>(bits)));
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        return QVariant(static_cast<uint>(bits));
+    case FactMetaData::valueTypeInt64:
+        return QVariant(static_cast<qlonglong>(bits));
+    case FactMetaData::valueTypeUint64:
+        return QVariant(static_cast<qulonglong>(bits));
+    case FactMetaData::valueTypeBool:
+        return QVariant(bits != 0);
+    case FactMetaData::valueTypeFloat:
+        return QVariant(static_cast<float>(std::bit_cast<double>(bits)));
+    case FactMetaData::valueTypeDouble:
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+        return QVariant(std::bit_cast<double>(bits));
+    case FactMetaData::valueTypeString:
+    case FactMetaData::valueTypeCustom:
+        break;
+    }
+
+    return QVariant();
+}
+
+bool TelemetryStore::setValue(int slot, const QVariant &value)
+{
+    Page *const page = _page(slot);
+    const int index = _index(slot);
+    const auto type = static_cast<FactMetaData::ValueType_t>(page->types[index]);
+
+    quint64 bits;
+    switch (type) {
+    case FactMetaData::valueTypeUint64:
+        bits = value.toULongLong();
+        break;
+    case FactMetaData::valueTypeBool:
+        bits = value.toBool() ? 1 : 0;
+        break;
+    case FactMetaData::valueTypeFloat:
+        bits = std::bit_cast<quint64>(static_cast<double>(value.toFloat()));
+        break;
+    case FactMetaData::valueTypeDouble:
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+        bits = std::bit_cast<quint64>(value.toDouble());
+        break;
+    default:
+        bits = static_cast<quint64>(value.toLongLong());
+        break;
+    }
+
+    return page->bits[index].exchange(bits, std::memory_order_relaxed) != bits;
+}
+
+void TelemetryStore::markDirty(int slot)
+{
+    const int index = _index(slot);
+    (void) _page(slot)->dirty[index / 64].fetch_or(quint64{1} << (index % 64), std::memory_order_relaxed);
+}
+
+bool TelemetryStore::isDirty(int slot) const
+{
+    const int index = _index(slot);
+    return _page(slot)->dirty[index / 64].load(std::memory_order_relaxed) & (quint64{1} << (index % 64));
+}
+
+void TelemetryStore::publish(int updateRateMSecs)
+{
+    // Group hooks first (e.g. clock facts refresh themselves every tick) so their values go out in this same tick
+    for (qsizetype i = 0; i < _groups.count(); i++) {
+        const GroupEntry entry = _groups[i];
+        if (!entry.paused && (entry.updateRateMSecs == updateRateMSecs)) {
+            entry.group->_updateAllValues();
+        }
+    }
+
+    const int pageCount = (_slotHighWater + kPageSize - 1) / kPageSize;
+    for (int pageIndex = 0; pageIndex < pageCount; pageIndex++) {
+        Page *const page = _pages[pageIndex].load(std::memory_order_acquire);
+        for (int word = 0; word < kDirtyWordsPerPage; word++) {
+            quint64 pending = page->dirty[word].load(std::memory_order_relaxed);
+            while (pending) {
+                const int bit = std::countr_zero(pending);
+                pending &= pending - 1;
+
+                const int index = (word * 64) + bit;
+                if (page->rateMSecs[index] != updateRateMSecs) {
+                    continue;
+                }
+
+                (void) page->dirty[word].fetch_and(~(quint64{1} << bit), std::memory_order_relaxed);
+                // A receiver may have deleted the fact while handling an earlier signal in this tick
+                Fact *const fact = page->facts[index].load(std::memory_order_acquire);
+                if (fact) {
+                    fact->sendDeferredValueChangedSignal();
+                }
+            }
+        }
+    }
+
+    // Slots released during or before this pass can be reused now that no dirty bit refers to them
+    _recycleRetiredSlots();
+}
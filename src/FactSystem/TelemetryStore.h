@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QVariant>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "FactMetaData.h"
+
+class Fact;
+class FactGroup;
+
+/// \brief Application-wide typed value store and publish tick for rate limited telemetry Facts.
+///
+/// Facts added to a FactGroup with a non-zero update rate get a slot here. Numeric values are kept in a
+/// struct-of-arrays (one 64 bit word per slot holding a double or a 64 bit integer) so setting a value is an atomic
+/// store instead of a QVariant assignment behind a recursive mutex, and a change only sets a bit in a dirty bitset.
+/// One timer per distinct update rate replaces the per-FactGroup update timers, so every group keeps its exact rate:
+/// each tick runs the update hook of the groups at that rate and then emits Fact::valueChanged for their dirty Facts
+/// which are actually observed (QML binding or connection).
+///
+/// Value access is lock-free and may happen from any thread while the Fact is alive. Registration and publishing
+/// happen on the GUI thread. A released slot is only handed out again after the next publish pass.
+class TelemetryStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetryStore(QObject *parent = nullptr);
+    ~TelemetryStore();
+
+    static TelemetryStore *instance();
+
+    /// @return The store if it currently exists, nullptr once it was destroyed with the application. Destructors which
+    /// may run late use this instead of instance() so they neither crash nor recreate the store.
+    static TelemetryStore *existingInstance();
+
+    /// @return true: values of this type are held in the store, false: the Fact keeps its QVariant
+    static bool isStoredType(FactMetaData::ValueType_t type);
+
+    /// Allocates a slot for the fact, published every @p updateRateMSecs
+    /// @return Slot id, -1 if the store is full
+    int registerFact(Fact *fact, FactMetaData::ValueType_t type, int updateRateMSecs);
+    void unregisterFact(int slot);
+
+    /// Registers the FactGroup update hook (FactGroup::_updateAllValues) with the publish tick
+    void registerGroup(FactGroup *group, int updateRateMSecs);
+    void unregisterGroup(FactGroup *group);
+    void setGroupPaused(FactGroup *group, bool paused);
+
+    /// @return Value typed as FactMetaData::convertAndValidateRaw would produce for the slot type
+    QVariant value(int slot) const;
+
+    /// @return true: stored value changed
+    bool setValue(int slot, const QVariant &value);
+
+    void markDirty(int slot);
+    bool isDirty(int slot) const;
+
+    int registeredFactCount() const { return _registeredFactCount; }
+
+    /// Runs the publish tick for groups and facts at @p updateRateMSecs right away. Normally driven by the rate timer.
+    void publish(int updateRateMSecs);
+
+private:
+    static constexpr int kPageBits = 10;
+    static constexpr int kPageSize = 1 << kPageBits;
+    static constexpr int kMaxPages = 256;
+    static constexpr int kDirtyWordsPerPage = kPageSize / 64;
+
+    struct Page {
+        std::array<std::atomic<quint64>, kPageSize>         bits{};     ///< double bits or 64 bit integer
+        std::array<std::atomic<quint64>, kDirtyWordsPerPage> dirty{};
+        std::array<std::atomic<Fact*>, kPageSize>           facts{};
+        std::array<quint8, kPageSize>                       types{};    ///< FactMetaData::ValueType_t
+        std::array<int, kPageSize>                          rateMSecs{};
+    };
+
+    struct GroupEntry {
+        FactGroup  *group = nullptr;
+        int         updateRateMSecs = 0;
+        bool        paused = false;
+    };
+
+    Page *_page(int slot) const { return _pages[slot >> kPageBits].load(std::memory_order_acquire); }
+    static int _index(int slot) { return slot & (kPageSize - 1); }
+    void _updateRateTimer(int updateRateMSecs);
+    void _recycleRetiredSlots();
+
+    std::array<std::atomic<Page*>, kMaxPages> _pages{};
+    std::vector<int> _freeSlots;
+    std::vector<int> _retiredSlots;     ///< Released since the last publish pass, not reused yet
+    int _slotHighWater = 0;
+    int _registeredFactCount = 0;
+
+    QList<GroupEntry> _groups;
+    QHash<int, QTimer*> _rateTimers;    ///< Update rate in msecs to its publish timer
+};
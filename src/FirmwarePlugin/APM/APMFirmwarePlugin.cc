@@ -1,6 +1,7 @@
 #include "APMFirmwarePlugin.h"
 #include "APMAutoPilotPlugin.h"
 #include "QGCMAVLink.h"
+#include "MAVLinkFrame.h"
 #include "AppMessages.h"
 #include "QGCApplication.h"
 #include "MissionManager.h"
@@ -240,14 +241,14 @@ void APMFirmwarePlugin::_handleOutgoingParamSetThreadSafe(Vehicle* /*vehicle*/,
     _adjustOutgoingMavlinkMutex.unlock();
 }
 
-bool APMFirmwarePlugin::_handleIncomingStatusText(Vehicle* /*vehicle*/, mavlink_message_t *message)
+bool APMFirmwarePlugin::_handleIncomingStatusText(Vehicle* /*vehicle*/, MAVLinkFrame &frame)
 {
     // APM user facing calibration messages come through as high severity, we need to parse them out
     // and lower the severity on them so that they don't pop in the users face.
 
-    const QString messageText = StatusTextHandler::getMessageText(*message);
+    const QString messageText = StatusTextHandler::getMessageText(frame.message());
     if (messageText.contains("Place vehicle") || messageText.contains("Calibration successful")) {
-        _adjustCalibrationMessageSeverity(message);
+        _adjustCalibrationMessageSeverity(&frame.detach());
         return true;
     }
 
@@ -262,7 +263,7 @@ bool APMFirmwarePlugin::_handleIncomingStatusText(Vehicle* /*vehicle*/, mavlink_
     return true;
 }
 
-void APMFirmwarePlugin::_handleIncomingHeartbeat(Vehicle *vehicle, mavlink_message_t *message)
+void APMFirmwarePlugin::_handleIncomingHeartbeat(Vehicle *vehicle, const mavlink_message_t *message)
 {
     mavlink_heartbeat_t heartbeat{};
     mavlink_msg_heartbeat_decode(message, &heartbeat);
@@ -285,8 +286,11 @@ void APMFirmwarePlugin::_handleIncomingHeartbeat(Vehicle *vehicle, mavlink_messa
     _ardupilotComponentMap[message->sysid][MAV_COMP_ID_UDP_BRIDGE] = false;
 }
 
-bool APMFirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle *vehicle, mavlink_message_t *message)
+bool APMFirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle *vehicle, MAVLinkFrame &frame)
 {
+    // Only the rewritten messages below detach the frame from the receive path
+    const mavlink_message_t *const message = &frame.message();
+
     // We use loss of BATTERY_STATUS/HOME_POSITION as a trigger to reinitialize stream rates
     auto instanceData = qobject_cast<APMFirmwarePluginInstanceData*>(vehicle->firmwarePluginInstanceData());
 
@@ -302,15 +306,15 @@ bool APMFirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle *vehicle, mavlink_m
         if (_ardupilotComponentMap[vehicle->id()][message->compid]) {
             switch (message->msgid) {
             case MAVLINK_MSG_ID_PARAM_VALUE:
-                _handleIncomingParamValue(vehicle, message);
+                _handleIncomingParamValue(vehicle, &frame.detach());
                 break;
             case MAVLINK_MSG_ID_STATUSTEXT:
-                return _handleIncomingStatusText(vehicle, message);
+                return _handleIncomingStatusText(vehicle, frame);
             case MAVLINK_MSG_ID_RC_CHANNELS:
-                _handleRCChannels(vehicle, message);
+                _handleRCChannels(vehicle, &frame.detach());
                 break;
             case MAVLINK_MSG_ID_RC_CHANNELS_RAW:
-                _handleRCChannelsRaw(vehicle, message);
+                _handleRCChannelsRaw(vehicle, &frame.detach());
                 break;
             }
         }
@@ -47,11 +47,12 @@ class APMFirmwarePlugin : public FirmwarePlugin
     void guidedModeRTL(Vehicle *vehicle, bool smartRTL) const override;
     void guidedModeChangeAltitude(Vehicle *vehicle, double altitudeChange, bool pauseVehicle) override;
     void guidedModeChangeHeading(Vehicle *vehicle, const QGeoCoordinate &headingCoord) const override;
-    bool adjustIncomingMavlinkMessage(Vehicle *vehicle, mavlink_message_t *message) override;
+    bool adjustIncomingMavlinkMessage(Vehicle *vehicle, MAVLinkFrame &frame) override;
     void adjustOutgoingMavlinkMessageThreadSafe(Vehicle *vehicle, LinkInterface *outgoingLink, mavlink_message_t *message) override;
     virtual void initializeStreamRates(Vehicle *vehicle);
     void initializeVehicle(Vehicle *vehicle) override;
     bool sendHomePositionToVehicle() const override { return true; }
+    int missionReadWindowSize() const override { return 8; }
     QString missionCommandOverrides(QGCMAVLink::VehicleClass_t vehicleClass) const override;
     QString _internalParameterMetaDataFile(const Vehicle* vehicle) const override;
     MAV_AUTOPILOT _autopilotType() const override { return MAV_AUTOPILOT_ARDUPILOTMEGA; }
@@ -97,8 +98,8 @@ private slots:
     void _adjustCalibrationMessageSeverity(mavlink_message_t *message) const;
     void _setInfoSeverity(mavlink_message_t *message) const;
     void _handleIncomingParamValue(Vehicle *vehicle, mavlink_message_t *message);
-    bool _handleIncomingStatusText(Vehicle *vehicle, mavlink_message_t *message);
-    void _handleIncomingHeartbeat(Vehicle *vehicle, mavlink_message_t *message);
+    bool _handleIncomingStatusText(Vehicle *vehicle, MAVLinkFrame &frame);
+    void _handleIncomingHeartbeat(Vehicle *vehicle, const mavlink_message_t *message);
     void _handleOutgoingParamSetThreadSafe(Vehicle *vehicle, LinkInterface *outgoingLink, mavlink_message_t *message);
     void _soloVideoHandshake();
     bool _guidedModeTakeoff(Vehicle *vehicle, double altitudeRel) const;
@@ -40,16 +40,16 @@ QString ArduSubFirmwarePlugin::vehicleImageOutline(const Vehicle *vehicle) const
     return vehicleImageOpaque(vehicle);
 }
 
-void ArduSubFirmwarePlugin::adjustMetaData(MAV_TYPE vehicleType, FactMetaData *metaData)
+void ArduSubFirmwarePlugin::adjustMetaData(MAV_TYPE vehicleType, Fact *fact)
 {
     Q_UNUSED(vehicleType);
 
-    if (!metaData) {
+    if (!fact) {
         return;
     }
 
-    if (_factRenameMap.contains(metaData->name())) {
-        metaData->setShortDescription(QString(_factRenameMap[metaData->name()]));
+    if (_factRenameMap.contains(fact->name())) {
+        fact->metaData()->setShortDescription(QString(_factRenameMap[fact->name()]));
     }
 }
 
@@ -226,7 +226,7 @@ bool ArduSubFirmwarePlugin::isCapable(const Vehicle *vehicle, FirmwareCapabiliti
     return ((capabilities & available) == capabilities);
 }
 
-void ArduSubFirmwarePlugin::_handleNamedValueFloat(mavlink_message_t *message)
+void ArduSubFirmwarePlugin::_handleNamedValueFloat(const mavlink_message_t *message)
 {
     mavlink_named_value_float_t value{};
     mavlink_msg_named_value_float_decode(message, &value);
@@ -252,7 +252,7 @@ void ArduSubFirmwarePlugin::_handleNamedValueFloat(mavlink_message_t *message)
     }
 }
 
-void ArduSubFirmwarePlugin::_handleMavlinkMessage(mavlink_message_t *message)
+void ArduSubFirmwarePlugin::_handleMavlinkMessage(const mavlink_message_t *message)
 {
     switch (message->msgid) {
     case (MAVLINK_MSG_ID_NAMED_VALUE_FLOAT):
@@ -270,10 +270,10 @@ void ArduSubFirmwarePlugin::_handleMavlinkMessage(mavlink_message_t *message)
     }
 }
 
-bool ArduSubFirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle *vehicle, mavlink_message_t *message)
+bool ArduSubFirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle *vehicle, MAVLinkFrame &frame)
 {
-    _handleMavlinkMessage(message);
-    return APMFirmwarePlugin::adjustIncomingMavlinkMessage(vehicle, message);
+    _handleMavlinkMessage(&frame.message());
+    return APMFirmwarePlugin::adjustIncomingMavlinkMessage(vehicle, frame);
 }
 
 QMap<QString, FactGroup*>* ArduSubFirmwarePlugin::factGroups()
@@ -95,9 +95,9 @@ class ArduSubFirmwarePlugin : public APMFirmwarePlugin
 
     const FirmwarePlugin::remapParamNameMajorVersionMap_t& paramNameRemapMajorVersionMap() const override { return _remapParamName; }
     int remapParamNameHigestMinorVersionNumber(int majorVersionNumber) const override;
-    bool adjustIncomingMavlinkMessage(Vehicle *vehicle, mavlink_message_t *message) override;
+    bool adjustIncomingMavlinkMessage(Vehicle *vehicle, MAVLinkFrame &frame) override;
     QMap<QString, FactGroup*> *factGroups() override;
-    void adjustMetaData(MAV_TYPE vehicleType, FactMetaData *metaData) override;
+    void adjustMetaData(MAV_TYPE vehicleType, Fact *fact) override;
 
     QString stabilizedFlightMode() const override;
     QString motorDetectionFlightMode() const override;
@@ -125,8 +125,8 @@ class ArduSubFirmwarePlugin : public APMFirmwarePlugin
     static bool _remapParamNameIntialized;
     QMap<QString, QString> _factRenameMap;
     static FirmwarePlugin::remapParamNameMajorVersionMap_t _remapParamName;
-    void _handleNamedValueFloat(mavlink_message_t *message);
-    void _handleMavlinkMessage(mavlink_message_t *message);
+    void _handleNamedValueFloat(const mavlink_message_t *message);
+    void _handleMavlinkMessage(const mavlink_message_t *message);
 
     QMap<QString, FactGroup*> _nameToFactGroupMap;
     APMSubmarineFactGroup _infoFactGroup;
@@ -15,11 +15,12 @@ class Vehicle;
 
 class VehicleComponent;
 class AutoPilotPlugin;
-class FactMetaData;
+class Fact;
 class MavlinkCameraControlInterface;
 class QGCCameraManager;
 class Autotune;
 class LinkInterface;
+class MAVLinkFrame;
 class FactGroup;
 class ParameterMetaData;
 
@@ -272,10 +273,11 @@ class FirmwarePlugin : public QObject
     /// Called before any mavlink message is processed by Vehicle such that the firmwre plugin
     /// can adjust any message characteristics. This is handy to adjust or differences in mavlink
     /// spec implementations such that the base code can remain mavlink generic.
+    /// The frame is shared with the receive path, call frame.detach() for a writable copy before changing it.
     ///     @param vehicle Vehicle message came from
-    ///     @param message[in,out] Mavlink message to adjust if needed.
+    ///     @param frame[in,out] Mavlink message to adjust if needed.
     /// @return false: skip message, true: process message
-    virtual bool adjustIncomingMavlinkMessage(Vehicle* /*vehicle*/, mavlink_message_t* /*message*/) { return true; }
+    virtual bool adjustIncomingMavlinkMessage(Vehicle* /*vehicle*/, MAVLinkFrame& /*frame*/) { return true; }
 
     /// Called before any mavlink message is sent to the Vehicle so plugin can adjust any message characteristics.
     /// This is handy to adjust or differences in mavlink spec implementations such that the base code can remain
@@ -298,6 +300,10 @@ class FirmwarePlugin : public QObject
     ///     false: Do not send first item to vehicle, sequence numbers must be adjusted
     virtual bool sendHomePositionToVehicle() const { return false; }
 
+    /// @return Number of MISSION_REQUEST_INT messages the vehicle accepts outstanding at once during a mission read.
+    ///         1: vehicle requires items to be requested strictly in sequence
+    virtual int missionReadWindowSize() const { return 1; }
+
     /// List of supported mission commands. Empty list for all commands supported.
     virtual QList<MAV_CMD> supportedMissionCommands(QGCMAVLinkTypes::VehicleClass_t /*vehicleClass*/) const { return QList<MAV_CMD>(); }
 
@@ -372,10 +378,11 @@ class FirmwarePlugin : public QObject
     int versionCompare(const Vehicle *vehicle, const QString &compare) const;
     int versionCompare(const Vehicle *vehicle, int major, int minor, int patch) const;
 
-    /// Allows the Firmware plugin to override the facts meta data.
+    /// Allows the Firmware plugin to override the facts meta data. Vehicle facts share their meta data with other
+    /// vehicles, so only call fact->metaData() for facts which are changed: it gives the fact a private copy.
     ///     @param vehicleType - Type of current vehicle
-    ///     @param metaData - MetaData for fact
-    virtual void adjustMetaData(MAV_TYPE /*vehicleType*/, FactMetaData* /*metaData*/) {}
+    ///     @param fact - Vehicle fact
+    virtual void adjustMetaData(MAV_TYPE /*vehicleType*/, Fact* /*fact*/) {}
 
     /// Sends the appropriate mavlink message for follow me support
     virtual void sendGCSMotionReport(Vehicle *vehicle, const FollowMe::GCSMotionReport &motionReport, uint8_t estimationCapabilities) const;
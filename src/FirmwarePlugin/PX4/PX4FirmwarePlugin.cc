@@ -636,8 +636,10 @@ bool PX4FirmwarePlugin::isGuidedMode(const Vehicle* vehicle) const
     return (vehicle->flightMode() == pauseFlightMode() || vehicle->flightMode() == takeOffFlightMode() || vehicle->flightMode() == landFlightMode());
 }
 
-bool PX4FirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle* vehicle, mavlink_message_t* message)
+bool PX4FirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle* vehicle, MAVLinkFrame& frame)
 {
+    const mavlink_message_t* const message = &frame.message();
+
     //-- Don't process messages to/from UDP Bridge. It doesn't suffer from these issues
     if (message->compid == MAV_COMP_ID_UDP_BRIDGE) {
         return true;
@@ -652,7 +654,7 @@ bool PX4FirmwarePlugin::adjustIncomingMavlinkMessage(Vehicle* vehicle, mavlink_m
     return true;
 }
 
-void PX4FirmwarePlugin::_handleAutopilotVersion(Vehicle* vehicle, mavlink_message_t* message)
+void PX4FirmwarePlugin::_handleAutopilotVersion(Vehicle* vehicle, const mavlink_message_t* message)
 {
     Q_UNUSED(vehicle);
 
@@ -56,7 +56,7 @@ class PX4FirmwarePlugin : public FirmwarePlugin
     QString             _internalParameterMetaDataFile  (const Vehicle* vehicle) const override { Q_UNUSED(vehicle); return QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.json"); }
     MAV_AUTOPILOT       _autopilotType                  () const override { return MAV_AUTOPILOT_PX4; }
     ParameterMetaData*  _createParameterMetaData         () final;
-    bool                adjustIncomingMavlinkMessage    (Vehicle* vehicle, mavlink_message_t* message) override;
+    bool                adjustIncomingMavlinkMessage    (Vehicle* vehicle, MAVLinkFrame& frame) override;
     QString             offlineEditingParamFile         (Vehicle* vehicle) const override { Q_UNUSED(vehicle); return QStringLiteral(":/FirmwarePlugin/PX4/PX4.OfflineEditing.params"); }
     QString             autoDisarmParameter             (Vehicle* vehicle) const override { Q_UNUSED(vehicle); return QStringLiteral("COM_DISARM_LAND"); }
     uint32_t            highLatencyCustomModeTo32Bits   (uint16_t hlCustomMode) const override;
@@ -71,7 +71,7 @@ private slots:
     void _mavCommandResult(int vehicleId, int component, int command, int result, int failureCode);
 
 private:
-    void    _handleAutopilotVersion         (Vehicle* vehicle, mavlink_message_t* message);
+    void    _handleAutopilotVersion         (Vehicle* vehicle, const mavlink_message_t* message);
 
     QString _getLatestVersionFileUrl        (Vehicle* vehicle) const override;
     QString _versionRegex                   () const override;
@@ -365,11 +365,35 @@ Map {
 
     // KML Overlay initialization
     Component.onCompleted: {
+        _updateKmlOverlayViewport()
         if (_flightMapSettings.kmlOverlayFile.rawValue !== "") {
             QGroundControl.kmlOverlayManager.loadKML(_flightMapSettings.kmlOverlayFile.rawValue)
         }
     }
 
+    // The overlay only holds the features in view, simplified for the zoom level. The overlay manager is shared by
+    // the Fly and Plan maps, the one showing drives it.
+    function _updateKmlOverlayViewport() {
+        if (_map.visible) {
+            QGroundControl.kmlOverlayManager.setViewport(_map.zoomLevel, _map.visibleRegion)
+        }
+    }
+
+    Timer {
+        id:             kmlOverlayViewportTimer
+        interval:       250
+        onTriggered:    _map._updateKmlOverlayViewport()
+    }
+
+    Connections {
+        target:                         _map
+        function onZoomLevelChanged()   { kmlOverlayViewportTimer.restart() }
+        function onCenterChanged()      { kmlOverlayViewportTimer.restart() }
+        function onWidthChanged()       { kmlOverlayViewportTimer.restart() }
+        function onHeightChanged()      { kmlOverlayViewportTimer.restart() }
+        function onVisibleChanged()     { kmlOverlayViewportTimer.restart() }
+    }
+
     Connections {
         target: _flightMapSettings.kmlOverlayFile
         function onRawValueChanged() {
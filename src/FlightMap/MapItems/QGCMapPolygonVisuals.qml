@@ -193,7 +193,21 @@ Item {
         }
     }
 
+    // Large polygons only get drag handles for the vertices in view
+    Timer {
+        id:             handleRegionTimer
+        interval:       250
+        onTriggered:    mapPolygon.setHandleRegion(mapControl.visibleRegion)
+    }
+
+    Connections {
+        target:                         mapControl
+        function onZoomLevelChanged()   { handleRegionTimer.restart() }
+        function onCenterChanged()      { handleRegionTimer.restart() }
+    }
+
     Component.onCompleted: {
+        mapPolygon.setHandleRegion(mapControl.visibleRegion)
         addCommonVisuals()
         _handleInteractiveChanged()
     }
@@ -313,20 +327,22 @@ Item {
         id: edgeLengthHandlesComponent
 
         Repeater {
-            model: _isVertexBeingDragged ? mapPolygon.path : undefined
+            model: _isVertexBeingDragged ? mapPolygon.pathModel : undefined
 
             delegate: Item {
                 property var _edgeLengthHandle
+                property int _vertex:           mapPolygon.handleVertex(index)
 
                 function _setHandlePosition() {
-                    var vertices = mapPolygon.vertexDrag ? mapPolygon.dragPath : mapPolygon.path
-                    var nextIndex = index + 1
-                    if (nextIndex > vertices.length - 1) {
+                    var nextIndex = _vertex + 1
+                    if (nextIndex > mapPolygon.count - 1) {
                         nextIndex = 0
                     }
-                    var distance = vertices[index].distanceTo(vertices[nextIndex])
-                    var azimuth = vertices[index].azimuthTo(vertices[nextIndex])
-                    _edgeLengthHandle.coordinate = vertices[index].atDistanceAndAzimuth(distance / 2, azimuth)
+                    var vertex = mapPolygon.vertexCoordinate(_vertex)
+                    var nextVertex = mapPolygon.vertexCoordinate(nextIndex)
+                    var distance = vertex.distanceTo(nextVertex)
+                    var azimuth = vertex.azimuthTo(nextVertex)
+                    _edgeLengthHandle.coordinate = vertex.atDistanceAndAzimuth(distance / 2, azimuth)
                     _edgeLengthHandle.distance = distance
                 }
 
@@ -337,7 +353,7 @@ Item {
 
                 Component.onCompleted: {
                     _edgeLengthHandle = edgeLengthHandleComponent.createObject(mapControl)
-                    _edgeLengthHandle.vertexIndex = index
+                    _edgeLengthHandle.vertexIndex = _vertex
                     _setHandlePosition()
                     mapControl.addMapItem(_edgeLengthHandle)
                 }
@@ -373,25 +389,39 @@ Item {
         id: splitHandlesComponent
 
         Repeater {
-            model: mapPolygon.path
+            model: mapPolygon.pathModel
 
             delegate: Item {
                 property var _splitHandle
-                property var _vertices:     mapPolygon.path
+                property int _vertex:       mapPolygon.handleVertex(index)
 
                 function _setHandlePosition() {
-                    var nextIndex = index + 1
-                    if (nextIndex > _vertices.length - 1) {
+                    var nextIndex = _vertex + 1
+                    if (nextIndex > mapPolygon.count - 1) {
                         nextIndex = 0
                     }
-                    var distance = _vertices[index].distanceTo(_vertices[nextIndex])
-                    var azimuth = _vertices[index].azimuthTo(_vertices[nextIndex])
-                    _splitHandle.coordinate = _vertices[index].atDistanceAndAzimuth(distance / 2, azimuth)
+                    var vertex = mapPolygon.vertexCoordinate(_vertex)
+                    var nextVertex = mapPolygon.vertexCoordinate(nextIndex)
+                    var distance = vertex.distanceTo(nextVertex)
+                    var azimuth = vertex.azimuthTo(nextVertex)
+                    _splitHandle.coordinate = vertex.atDistanceAndAzimuth(distance / 2, azimuth)
+                }
+
+                on_VertexChanged: {
+                    if (_splitHandle) {
+                        _splitHandle.vertexIndex = _vertex
+                        _setHandlePosition()
+                    }
+                }
+
+                Connections {
+                    target: mapPolygon
+                    function onPathChanged() { _setHandlePosition() }
                 }
 
                 Component.onCompleted: {
                     _splitHandle = splitHandleComponent.createObject(mapControl)
-                    _splitHandle.vertexIndex = index
+                    _splitHandle.vertexIndex = _vertex
                     _setHandlePosition()
                     mapControl.addMapItem(_splitHandle)
                 }
@@ -501,10 +531,10 @@ Item {
                 Component.onCompleted: {
                     var dragHandle = dragHandleComponent.createObject(mapControl)
                     dragHandle.coordinate = Qt.binding(function() { return object.coordinate })
-                    dragHandle.polygonVertex = Qt.binding(function() { return index })
+                    dragHandle.polygonVertex = Qt.binding(function() { return mapPolygon.handleVertex(index) })
                     mapControl.addMapItem(dragHandle)
                     var dragArea = dragAreaComponent.createObject(mapControl, { "itemIndicator": dragHandle, "itemCoordinate": object.coordinate })
-                    dragArea.polygonVertex = Qt.binding(function() { return index })
+                    dragArea.polygonVertex = Qt.binding(function() { return mapPolygon.handleVertex(index) })
                     _visuals.push(dragHandle)
                     _visuals.push(dragArea)
                 }
@@ -99,7 +99,21 @@ Item {
         }
     }
 
+    // Long polylines only get drag handles for the vertices in view
+    Timer {
+        id:             handleRegionTimer
+        interval:       250
+        onTriggered:    mapPolyline.setHandleRegion(mapControl.visibleRegion)
+    }
+
+    Connections {
+        target:                         mapControl
+        function onZoomLevelChanged()   { handleRegionTimer.restart() }
+        function onCenterChanged()      { handleRegionTimer.restart() }
+    }
+
     Component.onCompleted: {
+        mapPolyline.setHandleRegion(mapControl.visibleRegion)
         _addCommonVisuals()
         if (interactive) {
             _addInteractiveVisuals()
@@ -142,7 +156,7 @@ Item {
 
         QGCMenuItem {
             text:           qsTr("Edit position..." )
-            onTriggered:    editPositionDialogFactory.open({ coordinate: mapPolyline.path[menu._removeVertexIndex] })
+            onTriggered:    editPositionDialogFactory.open({ coordinate: mapPolyline.vertexCoordinate(menu._removeVertexIndex) })
         }
     }
 
@@ -195,30 +209,45 @@ Item {
         id: splitHandlesComponent
 
         Repeater {
-            model: mapPolyline.path
+            model: mapPolyline.pathModel
 
             delegate: Item {
                 property var _splitHandle
-                property var _vertices:     mapPolyline.path
+                property int _vertex:       mapPolyline.handleVertex(index)
 
                 opacity:    _root.opacity
 
-                function _setHandlePosition() {
-                    var nextIndex = index + 1
-                    var distance = _vertices[index].distanceTo(_vertices[nextIndex])
-                    var azimuth = _vertices[index].azimuthTo(_vertices[nextIndex])
-                    _splitHandle.coordinate = _vertices[index].atDistanceAndAzimuth(distance / 2, azimuth)
-                }
-
-                Component.onCompleted: {
-                    if (index + 1 <= _vertices.length - 1) {
+                // The last vertex has no segment to split, which vertex is last changes as vertices are added
+                function _updateSplitHandle() {
+                    var nextIndex = _vertex + 1
+                    if (_vertex < 0 || nextIndex > mapPolyline.count - 1) {
+                        if (_splitHandle) {
+                            _splitHandle.destroy()
+                            _splitHandle = undefined
+                        }
+                        return
+                    }
+                    if (!_splitHandle) {
                         _splitHandle = splitHandleComponent.createObject(mapControl)
-                        _splitHandle.vertexIndex = index
-                        _setHandlePosition()
                         mapControl.addMapItem(_splitHandle)
                     }
+                    _splitHandle.vertexIndex = _vertex
+                    var vertex = mapPolyline.vertexCoordinate(_vertex)
+                    var nextVertex = mapPolyline.vertexCoordinate(nextIndex)
+                    var distance = vertex.distanceTo(nextVertex)
+                    var azimuth = vertex.azimuthTo(nextVertex)
+                    _splitHandle.coordinate = vertex.atDistanceAndAzimuth(distance / 2, azimuth)
+                }
+
+                on_VertexChanged: _updateSplitHandle()
+
+                Connections {
+                    target: mapPolyline
+                    function onPathChanged() { _updateSplitHandle() }
                 }
 
+                Component.onCompleted: _updateSplitHandle()
+
                 Component.onDestruction: {
                     if (_splitHandle) {
                         _splitHandle.destroy()
@@ -253,20 +282,22 @@ Item {
         id: edgeLengthHandlesComponent
 
         Repeater {
-            model: _isVertexBeingDragged ? mapPolyline.path : undefined
+            model: _isVertexBeingDragged ? mapPolyline.pathModel : undefined
 
             delegate: Item {
                 property var _edgeLengthHandle
+                property int _vertex:           mapPolyline.handleVertex(index)
 
                 function _setHandlePosition() {
-                    var vertices = mapPolyline.vertexDrag ? mapPolyline.dragPath : mapPolyline.path
-                    var nextIndex = index + 1
-                    if (nextIndex > vertices.length - 1) {
+                    var nextIndex = _vertex + 1
+                    if (nextIndex > mapPolyline.count - 1) {
                         return
                     }
-                    var distance = vertices[index].distanceTo(vertices[nextIndex])
-                    var azimuth = vertices[index].azimuthTo(vertices[nextIndex])
-                    _edgeLengthHandle.coordinate = vertices[index].atDistanceAndAzimuth(distance / 2, azimuth)
+                    var vertex = mapPolyline.vertexCoordinate(_vertex)
+                    var nextVertex = mapPolyline.vertexCoordinate(nextIndex)
+                    var distance = vertex.distanceTo(nextVertex)
+                    var azimuth = vertex.azimuthTo(nextVertex)
+                    _edgeLengthHandle.coordinate = vertex.atDistanceAndAzimuth(distance / 2, azimuth)
                     _edgeLengthHandle.distance = distance
                 }
 
@@ -276,9 +307,9 @@ Item {
                 }
 
                 Component.onCompleted: {
-                    if (index + 1 <= mapPolyline.path.length - 1) {
+                    if (_vertex + 1 <= mapPolyline.count - 1) {
                         _edgeLengthHandle = edgeLengthHandleComponent.createObject(mapControl)
-                        _edgeLengthHandle.vertexIndex = index
+                        _edgeLengthHandle.vertexIndex = _vertex
                         _setHandlePosition()
                         mapControl.addMapItem(_edgeLengthHandle)
                     }
@@ -364,10 +395,10 @@ Item {
                 Component.onCompleted: {
                     var dragHandle = dragHandleComponent.createObject(mapControl)
                     dragHandle.coordinate = Qt.binding(function() { return object.coordinate })
-                    dragHandle.polylineVertex = Qt.binding(function() { return index })
+                    dragHandle.polylineVertex = Qt.binding(function() { return mapPolyline.handleVertex(index) })
                     mapControl.addMapItem(dragHandle)
                     var dragArea = dragAreaComponent.createObject(mapControl, { "itemIndicator": dragHandle, "itemCoordinate": object.coordinate })
-                    dragArea.polylineVertex = Qt.binding(function() { return index })
+                    dragArea.polylineVertex = Qt.binding(function() { return mapPolyline.handleVertex(index) })
                     _visuals.push(dragHandle)
                     _visuals.push(dragArea)
                 }
@@ -244,11 +244,26 @@ FlightMap {
         z:          QGroundControl.zOrderTrajectoryLines
         visible:    !pipMode
 
+        // Only the points needed for the current zoom and viewport are handed to the polyline
+        function refreshPath() {
+            trajectoryPolyline.path = _activeVehicle ? _activeVehicle.trajectoryPoints.geometry(_root.zoomLevel, _root.visibleRegion) : []
+        }
+
+        Timer {
+            id:             trajectoryRefreshTimer
+            interval:       250
+            onTriggered:    trajectoryPolyline.refreshPath()
+        }
+
         Connections {
             target:                 QGroundControl.multiVehicleManager
-            function onActiveVehicleChanged(activeVehicle) {
-                trajectoryPolyline.path = _activeVehicle ? _activeVehicle.trajectoryPoints.list() : []
-            }
+            function onActiveVehicleChanged(activeVehicle) { trajectoryPolyline.refreshPath() }
+        }
+
+        Connections {
+            target:                     _root
+            function onZoomLevelChanged() { trajectoryRefreshTimer.restart() }
+            function onCenterChanged()    { trajectoryRefreshTimer.restart() }
         }
 
         Connections {
@@ -256,6 +271,7 @@ FlightMap {
             function onPointAdded(coordinate) { trajectoryPolyline.addCoordinate(coordinate) }
             function onUpdateLastPoint(coordinate) { trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate) }
             function onPointsCleared() { trajectoryPolyline.path = [] }
+            function onGeometryChanged() { trajectoryPolyline.refreshPath() }
         }
     }
 
@@ -18,6 +18,7 @@
 #include <QtCore/QSet>
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include <QtCore/QSettings>
 #include <QtCore/QThread>
 
@@ -152,6 +153,10 @@ Joystick::Joystick(const QString &name, int axisCount, int buttonCount, int hatC
         _joystickSettings.calibrated()->setRawValue(false);
     });
 
+    (void) connect(_joystickSettings.axisFrequencyHz(), &Fact::rawValueChanged, this, &Joystick::_cacheRateSettings);
+    (void) connect(_joystickSettings.buttonFrequencyHz(), &Fact::rawValueChanged, this, &Joystick::_cacheRateSettings);
+    _cacheRateSettings();
+
     _resetFunctionToAxisMap();
     _resetAxisCalibrationData();
     _resetButtonActionData();
@@ -165,6 +170,7 @@ Joystick::Joystick(const QString &name, int axisCount, int buttonCount, int hatC
 Joystick::~Joystick()
 {
     _exitPollingThread = true;
+    _wakePollingThread();
     if (isRunning()) {
         if (QThread::currentThread() == this) {
             qCWarning(JoystickLog) << "Skipping wait() on joystick thread";
@@ -663,14 +669,26 @@ void Joystick::run()
     }
 
     if (!openFailed) {
-        _axisElapsedTimer.start();
-
         for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
             if (_assignedButtonActions[buttonIndex]) {
                 _assignedButtonActions[buttonIndex]->buttonElapsedTimer.start();
             }
         }
 
+        // Deadline scheduling: axes are sampled and sent on a fixed-rate grid, buttons are processed on their own
+        // grid and additionally on any pass where _update() delivered new input. Deadlines advance by whole periods
+        // so send times do not drift with processing time, and missed slots are skipped rather than burst. The
+        // backend only delivers input from inside _update(), so between deadlines the thread just sleeps; the
+        // condition variable exists only to cut that sleep short when polling is stopped.
+        using Clock = std::chrono::steady_clock;
+        const auto advanceDeadline = [](Clock::time_point deadline, qint64 intervalUs, Clock::time_point now) {
+            deadline += std::chrono::microseconds(intervalUs);
+            return (deadline <= now) ? (now + std::chrono::microseconds(intervalUs)) : deadline;
+        };
+
+        Clock::time_point nextAxisDeadline = Clock::now();
+        Clock::time_point nextButtonDeadline = nextAxisDeadline;
+
         while (!_exitPollingThread) {
             if (!_update()) {
                 qCWarning(JoystickLog) << "Joystick disconnected or update failed:" << _name;
@@ -678,17 +696,23 @@ void Joystick::run()
                 break;
             }
 
-            _handleButtons();
-
-            if (axisCount() != 0) {
-                _handleAxis();
+            const Clock::time_point now = Clock::now();
+            const bool buttonsDue = now >= nextButtonDeadline;
+            if (_inputPending.exchange(false, std::memory_order_relaxed) || buttonsDue) {
+                _handleButtons();
+            }
+            if (buttonsDue) {
+                nextButtonDeadline = advanceDeadline(nextButtonDeadline, _buttonIntervalUs.load(std::memory_order_relaxed), now);
             }
 
-            const double axisFrequencyHz = _joystickSettings.axisFrequencyHz()->rawValue().toDouble();
-            const double buttonFrequencyHz = _joystickSettings.buttonFrequencyHz()->rawValue().toDouble();
+            if (now >= nextAxisDeadline) {
+                if (axisCount() != 0) {
+                    _handleAxis();
+                }
+                nextAxisDeadline = advanceDeadline(nextAxisDeadline, _axisIntervalUs.load(std::memory_order_relaxed), now);
+            }
 
-            const int sleep = qMin(static_cast<int>(1000.0 / axisFrequencyHz), static_cast<int>(1000.0 / buttonFrequencyHz)) / 2;
-            QThread::msleep(sleep);
+            _waitForDeadline(qMin(nextAxisDeadline, nextButtonDeadline));
         }
 
         _close();
@@ -781,7 +805,7 @@ void Joystick::_handleButtons()
         }
 
         //-- Process button press/release
-        const int buttonDelay = static_cast<int>(1000.0 / _joystickSettings.buttonFrequencyHz()->rawValue().toDouble());
+        const qint64 buttonDelay = _buttonIntervalUs.load(std::memory_order_relaxed) / 1000;
         QSet<QString> executedActions;
         for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
             if (!_assignedButtonActions[buttonIndex]) {
@@ -930,13 +954,6 @@ uint16_t Joystick::_adjustRangeToRcOverridePwm(int value, const AxisCalibration_
 
 void Joystick::_handleAxis()
 {
-    const int axisDelay = static_cast<int>(1000.0 / _joystickSettings.axisFrequencyHz()->rawValue().toDouble());
-    if (_axisElapsedTimer.elapsed() <= axisDelay) {
-        return;
-    }
-
-    _axisElapsedTimer.start();
-
     if (_pollingFlags == PollingNone) {
         qCWarning(JoystickLog) << "Internal Error: Joystick not polling!";
         return;
@@ -950,6 +967,8 @@ void Joystick::_handleAxis()
             channelValues[axisIndex] = _getAxisValue(axisIndex);
         }
         emit rawChannelValuesChanged(channelValues);
+        // Nothing goes on the wire while calibrating, so there is no latency to record
+        _pendingInputTimestampNs.store(0, std::memory_order_relaxed);
     } else if (_pollingFlags.testFlag(PollingForVehicle)) {
         Vehicle *const vehicle = _pollingVehicle;
         if (!vehicle) {
@@ -1180,8 +1199,9 @@ void Joystick::_handleAxis()
         const uint16_t highButtons = static_cast<uint16_t>((buttonPressedBits >> 16) & 0xFFFF);
 
 
-        vehicle->sendJoystickDataThreadSafe(roll, pitch, yaw, throttle, lowButtons, highButtons, pitchExtension, rollExtension, auxManualControl1, auxManualControl2, auxManualControl3, auxManualControl4, auxManualControl5, auxManualControl6);
-        vehicle->sendJoystickAuxRcOverrideThreadSafe(auxRcOverridePwm, auxRcOverrideEnabled, !additionalAxesFunctionIsManualControl);
+        vehicle->sendJoystickControlThreadSafe(roll, pitch, yaw, throttle, lowButtons, highButtons, pitchExtension, rollExtension, auxManualControl1, auxManualControl2, auxManualControl3, auxManualControl4, auxManualControl5, auxManualControl6,
+                                               auxRcOverridePwm, auxRcOverrideEnabled, !additionalAxesFunctionIsManualControl);
+        _recordInputToWireLatency();
     }
 }
 
@@ -1331,6 +1351,7 @@ void Joystick::_stopPollingThread()
     if (isRunning()) {
         qCDebug(JoystickLog) << "Stopping polling thread. Flags:" << _pollingFlagsToString(_pollingFlags);
         _exitPollingThread = true;
+        _wakePollingThread();
         if (QThread::currentThread() == this) {
             qCWarning(JoystickLog) << "Skipping wait() on joystick thread to avoid deadlock";
         } else {
@@ -1342,6 +1363,59 @@ void Joystick::_stopPollingThread()
     }
 }
 
+void Joystick::_cacheRateSettings()
+{
+    const auto intervalUs = [](Fact *frequencyFact) {
+        const double frequencyHz = frequencyFact->rawValue().toDouble();
+        if (!(frequencyHz > 0.0)) {
+            return qint64{1000000};
+        }
+        return qMax(qint64{1000}, static_cast<qint64>(std::llround(1000000.0 / frequencyHz)));
+    };
+
+    _axisIntervalUs.store(intervalUs(_joystickSettings.axisFrequencyHz()), std::memory_order_relaxed);
+    _buttonIntervalUs.store(intervalUs(_joystickSettings.buttonFrequencyHz()), std::memory_order_relaxed);
+}
+
+void Joystick::_waitForDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(_stopMutex);
+    (void) _stopCondition.wait_until(lock, deadline, [this]() {
+        return _exitPollingThread.load();
+    });
+}
+
+void Joystick::_wakePollingThread()
+{
+    // Taking the mutex orders the notify after a waiter's predicate check, so the exit request cannot be missed
+    std::lock_guard<std::mutex> lock(_stopMutex);
+    _stopCondition.notify_all();
+}
+
+void Joystick::_notifyInputEvent(quint64 timestampNs)
+{
+    // Keep the oldest unsent input so the histogram reflects worst-case staleness of each sent frame
+    quint64 expected = 0;
+    (void) _pendingInputTimestampNs.compare_exchange_strong(expected, qMax(timestampNs, quint64{1}), std::memory_order_relaxed);
+    _inputPending.store(true, std::memory_order_relaxed);
+}
+
+quint64 Joystick::_inputClockNs() const
+{
+    return static_cast<quint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Joystick::_recordInputToWireLatency()
+{
+    const quint64 inputNs = _pendingInputTimestampNs.exchange(0, std::memory_order_relaxed);
+    if (inputNs == 0) {
+        return;
+    }
+
+    const quint64 nowNs = _inputClockNs();
+    _latencyHistogram.record((nowNs > inputNs) ? ((nowNs - inputNs) / 1000) : 0);
+}
+
 QString Joystick::_pollingFlagsToString(PollingFlags flags) const
 {
     if (flags == PollingNone) {
@@ -10,7 +10,11 @@
 
 #include <functional>
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
+#include "JoystickLatencyHistogram.h"
 #include "RemoteControlCalibrationController.h"
 #include "JoystickSettings.h"
 
@@ -308,6 +312,11 @@ class Joystick : public QThread
     // Per-device custom mapping
     Q_INVOKABLE virtual bool setMapping(const QString &mapping) { Q_UNUSED(mapping); return false; }
 
+    /// Input-to-wire latency statistics for MANUAL_CONTROL output (see JoystickLatencyHistogram::toVariantMap)
+    Q_INVOKABLE QVariantMap latencyStatistics() const { return _latencyHistogram.toVariantMap(); }
+    Q_INVOKABLE void resetLatencyStatistics() { _latencyHistogram.reset(); }
+    const JoystickLatencyHistogram &latencyHistogram() const { return _latencyHistogram; }
+
     QStringList buttonActions() const;
     QString buttonActionNone() const { return _buttonActionNone; }
     QString disabledActionName() const { return _buttonActionNone; }
@@ -383,6 +392,14 @@ class Joystick : public QThread
     void updateComplete();
 
 protected:
+    /// Called by backends when new input arrives, normally from inside _update(). Marks buttons for handling on the
+    /// current polling pass and records the timestamp used for input-to-wire latency measurement.
+    ///     @param timestampNs Input time on the _inputClockNs() clock
+    void _notifyInputEvent(quint64 timestampNs);
+
+    /// Monotonic clock used for input timestamps. Backends override this to match their event timestamps.
+    virtual quint64 _inputClockNs() const;
+
     QString _name;
     int _axisCount = 0;
     int _buttonCount = 0;
@@ -418,6 +435,10 @@ private slots:
     void _stopAllPollingForVehicle();
     void _startPollingThread();
     void _stopPollingThread();
+    void _cacheRateSettings();
+    void _waitForDeadline(std::chrono::steady_clock::time_point deadline);
+    void _wakePollingThread();
+    void _recordInputToWireLatency();
     QString _pollingFlagsToString(PollingFlags flags) const;
     PollingFlags _pollingFlags = PollingNone;
 
@@ -473,10 +494,19 @@ private slots:
     AxisFunctionMap_t _axisFunctionToJoystickAxisMap; ///< Map from AxisFunction_t to axis index, kJoystickAxisNotAssigned if not assigned
     static constexpr const int kJoystickAxisNotAssigned = -1;
 
-    QElapsedTimer _axisElapsedTimer;
     QStringList _availableActionTitles;
     std::atomic<bool> _exitPollingThread = false;    ///< true: signal thread to exit
 
+    // Polling thread scheduling. Rates are cached from the settings Facts so the polling thread never touches
+    // QVariant-backed Facts owned by the GUI thread.
+    std::atomic<qint64> _axisIntervalUs{0};
+    std::atomic<qint64> _buttonIntervalUs{0};
+    std::mutex _stopMutex;
+    std::condition_variable _stopCondition;         ///< Ends the sleep between deadlines when polling stops
+    std::atomic<bool> _inputPending{false};         ///< Backend delivered input since the last button pass
+    std::atomic<quint64> _pendingInputTimestampNs{0}; ///< Oldest input not yet sent, 0 if none
+    JoystickLatencyHistogram _latencyHistogram;
+
     // HOTAS/Multi-device linking
     QString _linkedGroupId;
     QString _linkedGroupRole;
@@ -0,0 +1,98 @@
+#include "JoystickLatencyHistogram.h"
+
+#include <QtCore/QVariantList>
+
+#include <bit>
+#include <cmath>
+
+int JoystickLatencyHistogram::_bucketForLatency(quint64 latencyUs)
+{
+    if (latencyUs < 2) {
+        return 0;
+    }
+    const int bucket = static_cast<int>(std::bit_width(latencyUs)) - 1;
+    return qMin(bucket, BucketCount - 1);
+}
+
+void JoystickLatencyHistogram::record(quint64 latencyUs)
+{
+    (void) _buckets[_bucketForLatency(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+    (void) _sumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    (void) _count.fetch_add(1, std::memory_order_relaxed);
+
+    quint64 currentMax = _maxUs.load(std::memory_order_relaxed);
+    while ((latencyUs > currentMax) && !_maxUs.compare_exchange_weak(currentMax, latencyUs, std::memory_order_relaxed)) {
+    }
+}
+
+void JoystickLatencyHistogram::reset()
+{
+    for (auto &bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sumUs.store(0, std::memory_order_relaxed);
+    _maxUs.store(0, std::memory_order_relaxed);
+}
+
+double JoystickLatencyHistogram::meanUs() const
+{
+    const quint64 samples = count();
+    if (samples == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(_sumUs.load(std::memory_order_relaxed)) / static_cast<double>(samples);
+}
+
+quint64 JoystickLatencyHistogram::bucketCount(int bucket) const
+{
+    if ((bucket < 0) || (bucket >= BucketCount)) {
+        return 0;
+    }
+    return _buckets[bucket].load(std::memory_order_relaxed);
+}
+
+quint64 JoystickLatencyHistogram::percentileUs(double percentile) const
+{
+    std::array<quint64, BucketCount> snapshot;
+    quint64 total = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        snapshot[i] = bucketCount(i);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const double clamped = qBound(0.0, percentile, 100.0);
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(std::ceil((clamped / 100.0) * static_cast<double>(total))));
+
+    quint64 cumulative = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        cumulative += snapshot[i];
+        if (cumulative >= rank) {
+            // Never report more than the observed maximum for the open-ended/top buckets
+            return qMin(bucketUpperBoundUs(i), qMax(maxUs(), quint64{1}));
+        }
+    }
+    return maxUs();
+}
+
+QVariantMap JoystickLatencyHistogram::toVariantMap() const
+{
+    QVariantList buckets;
+    buckets.reserve(BucketCount);
+    for (int i = 0; i < BucketCount; i++) {
+        buckets.append(bucketCount(i));
+    }
+
+    return {
+        { QStringLiteral("count"),   count() },
+        { QStringLiteral("meanUs"),  meanUs() },
+        { QStringLiteral("maxUs"),   maxUs() },
+        { QStringLiteral("p50Us"),   percentileUs(50.0) },
+        { QStringLiteral("p90Us"),   percentileUs(90.0) },
+        { QStringLiteral("p99Us"),   percentileUs(99.0) },
+        { QStringLiteral("buckets"), buckets },
+    };
+}
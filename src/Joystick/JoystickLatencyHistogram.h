@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QtCore/QVariantMap>
+
+#include <array>
+#include <atomic>
+
+/// Lock-free histogram of joystick input-to-wire latency.
+///
+/// Bucket i counts samples in [2^i, 2^(i+1)) microseconds; bucket 0 also holds sub-microsecond samples
+/// and the last bucket is open ended. Recording is wait-free so the polling thread can record while the
+/// GUI thread reads statistics.
+class JoystickLatencyHistogram
+{
+public:
+    static constexpr int BucketCount = 22;  ///< Last bounded bucket ends at ~2.1s
+
+    void record(quint64 latencyUs);
+    void reset();
+
+    quint64 count() const { return _count.load(std::memory_order_relaxed); }
+    quint64 maxUs() const { return _maxUs.load(std::memory_order_relaxed); }
+    double meanUs() const;
+
+    /// @return Upper bound (us) of the bucket containing the given percentile (0-100), 0 if empty
+    quint64 percentileUs(double percentile) const;
+
+    quint64 bucketCount(int bucket) const;
+    static quint64 bucketUpperBoundUs(int bucket) { return (quint64{1} << (bucket + 1)); }
+
+    /// Snapshot for QML/diagnostics: count, meanUs, maxUs, p50Us, p90Us, p99Us, buckets
+    QVariantMap toVariantMap() const;
+
+private:
+    static int _bucketForLatency(quint64 latencyUs);
+
+    std::array<std::atomic<quint64>, BucketCount> _buckets{};
+    std::atomic<quint64> _count{0};
+    std::atomic<quint64> _sumUs{0};
+    std::atomic<quint64> _maxUs{0};
+};
@@ -4,6 +4,8 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QMetaObject>
+#include <QtCore/QMultiHash>
+#include <QtCore/QMutex>
 #include <QtCore/QThread>
 
 #include <array>
@@ -21,6 +23,10 @@ QGC_LOGGING_CATEGORY(JoystickSDLLog, "Joystick.JoystickSDL")
 /// Discovery cache - main thread only, cleared in shutdown()
 static QMap<QString, Joystick*> s_discoveryCache;
 
+/// Open joysticks by SDL instance id - input events are dispatched from whichever thread runs the SDL update
+static QMultiHash<int, JoystickSDL*> s_openJoysticks;
+Q_GLOBAL_STATIC(QMutex, s_openJoysticksMutex)
+
 /// SDL event watcher - uses Qt::QueuedConnection for thread safety
 static bool sdlEventWatcher(void *userdata, SDL_Event *event)
 {
@@ -32,6 +38,24 @@ static bool sdlEventWatcher(void *userdata, SDL_Event *event)
     }
 
     switch (event->type) {
+    case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+        JoystickSDL::dispatchInputEvent(static_cast<int>(event->jaxis.which), event->common.timestamp);
+        break;
+    case SDL_EVENT_JOYSTICK_HAT_MOTION:
+        JoystickSDL::dispatchInputEvent(static_cast<int>(event->jhat.which), event->common.timestamp);
+        break;
+    case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+    case SDL_EVENT_JOYSTICK_BUTTON_UP:
+        JoystickSDL::dispatchInputEvent(static_cast<int>(event->jbutton.which), event->common.timestamp);
+        break;
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        JoystickSDL::dispatchInputEvent(static_cast<int>(event->gaxis.which), event->common.timestamp);
+        break;
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        JoystickSDL::dispatchInputEvent(static_cast<int>(event->gbutton.which), event->common.timestamp);
+        break;
+
     case SDL_EVENT_JOYSTICK_ADDED:
         qCInfo(JoystickSDLLog) << "SDL event: Joystick added, instance ID:" << event->jdevice.which;
         QMetaObject::invokeMethod(manager, "_checkForAddedOrRemovedJoysticks", Qt::QueuedConnection);
@@ -354,6 +378,11 @@ bool JoystickSDL::_open()
 
     qCDebug(JoystickSDLLog) << "Opened" << SDL_GetJoystickName(_sdlJoystick) << "joystick at" << _sdlJoystick;
 
+    {
+        QMutexLocker locker(s_openJoysticksMutex());
+        s_openJoysticks.insert(_instanceId, this);
+    }
+
     return true;
 }
 
@@ -366,6 +395,11 @@ void JoystickSDL::_close()
 
     qCDebug(JoystickSDLLog) << "Closing joystick" << _name << "at" << _sdlJoystick;
 
+    {
+        QMutexLocker locker(s_openJoysticksMutex());
+        (void) s_openJoysticks.remove(_instanceId, this);
+    }
+
     if (_sdlHaptic) {
         SDL_CloseHaptic(_sdlHaptic);
         _sdlHaptic = nullptr;
@@ -397,6 +431,20 @@ bool JoystickSDL::_update()
     return true;
 }
 
+quint64 JoystickSDL::_inputClockNs() const
+{
+    // SDL event timestamps are on the SDL_GetTicksNS() clock
+    return SDL_GetTicksNS();
+}
+
+void JoystickSDL::dispatchInputEvent(int instanceId, quint64 timestampNs)
+{
+    QMutexLocker locker(s_openJoysticksMutex());
+    for (auto it = s_openJoysticks.constFind(instanceId); (it != s_openJoysticks.cend()) && (it.key() == instanceId); ++it) {
+        it.value()->_notifyInputEvent(timestampNs);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Input State Accessors
 //-----------------------------------------------------------------------------
@@ -141,10 +141,14 @@ class JoystickSDL : public Joystick
     static void shutdown(bool deleteDiscoveryCache = true);
     static QMap<QString, Joystick*> discover();
 
+    /// Routes an SDL input event to the open joysticks for @p instanceId. Safe to call from any thread.
+    static void dispatchInputEvent(int instanceId, quint64 timestampNs);
+
 private:
     [[nodiscard]] bool _open() final;
     void _close() final;
     bool _update() final;
+    quint64 _inputClockNs() const final;
 
     bool _getButton(int idx) const final;
     int _getAxisValue(int idx) const final;
@@ -0,0 +1,130 @@
+#include "MAVLinkFrame.h"
+
+#include <cstring>
+
+namespace {
+
+std::atomic<quint64> s_allocations{0};
+std::atomic<quint64> s_reuses{0};
+std::atomic<quint64> s_bytesCopied{0};
+
+} // namespace
+
+/// Free buffers of one thread. A buffer released on another thread than the one which allocated it simply joins
+/// the releasing thread's pool.
+struct MAVLinkFrame::Pool
+{
+    ~Pool()
+    {
+        while (head) {
+            Buffer *const next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    Buffer *head = nullptr;
+    int count = 0;
+};
+
+MAVLinkFrame::Pool &MAVLinkFrame::_pool()
+{
+    thread_local Pool pool;
+    return pool;
+}
+
+MAVLinkFrame::MAVLinkFrame(const MAVLinkFrame &other) noexcept
+    : _buffer(other._buffer)
+{
+    if (_buffer) {
+        (void) _buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+MAVLinkFrame &MAVLinkFrame::operator=(const MAVLinkFrame &other) noexcept
+{
+    if (other._buffer) {
+        (void) other._buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    _release();
+    _buffer = other._buffer;
+    return *this;
+}
+
+MAVLinkFrame &MAVLinkFrame::operator=(MAVLinkFrame &&other) noexcept
+{
+    if (this != &other) {
+        _release();
+        _buffer = other._buffer;
+        other._buffer = nullptr;
+    }
+    return *this;
+}
+
+void MAVLinkFrame::_release()
+{
+    if (_buffer && (_buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+        Pool &pool = _pool();
+        if (pool.count < kMaxPooledBuffers) {
+            _buffer->next = pool.head;
+            pool.head = _buffer;
+            pool.count++;
+        } else {
+            delete _buffer;
+        }
+    }
+    _buffer = nullptr;
+}
+
+MAVLinkFrame MAVLinkFrame::allocate()
+{
+    Pool &pool = _pool();
+    Buffer *buffer = pool.head;
+    if (buffer) {
+        pool.head = buffer->next;
+        pool.count--;
+        buffer->next = nullptr;
+        buffer->refs.store(1, std::memory_order_relaxed);
+        (void) s_reuses.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        buffer = new Buffer;
+        (void) s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return MAVLinkFrame(buffer);
+}
+
+MAVLinkFrame MAVLinkFrame::fromMessage(const mavlink_message_t &message)
+{
+    MAVLinkFrame frame = allocate();
+    (void) memcpy(&frame._buffer->message, &message, sizeof(mavlink_message_t));
+    (void) s_bytesCopied.fetch_add(sizeof(mavlink_message_t), std::memory_order_relaxed);
+    return frame;
+}
+
+mavlink_message_t &MAVLinkFrame::detach()
+{
+    if (!_buffer) {
+        *this = allocate();
+    } else if (isShared()) {
+        *this = fromMessage(_buffer->message);
+    }
+
+    return _buffer->message;
+}
+
+MAVLinkFrame::Stats MAVLinkFrame::stats()
+{
+    Stats stats;
+    stats.allocations = s_allocations.load(std::memory_order_relaxed);
+    stats.reuses = s_reuses.load(std::memory_order_relaxed);
+    stats.bytesCopied = s_bytesCopied.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MAVLinkFrame::resetStats()
+{
+    s_allocations.store(0, std::memory_order_relaxed);
+    s_reuses.store(0, std::memory_order_relaxed);
+    s_bytesCopied.store(0, std::memory_order_relaxed);
+}
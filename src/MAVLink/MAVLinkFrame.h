@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QtCore/QMetaType>
+
+#include "MAVLinkMessageType.h"
+
+#include <atomic>
+
+/// A received MAVLink message shared by reference along the receive path.
+///
+/// Copying a frame only adds a reference, so the parser, the vehicle and anything which keeps the message all look
+/// at the same buffer. Buffers come from a per-thread pool and return to it when the last reference is dropped, which
+/// keeps a steady message stream free of heap allocations. Readers use the const message(); detach() hands out a
+/// writable message and copies it first only while another reference can still see the buffer.
+class MAVLinkFrame
+{
+public:
+    MAVLinkFrame() = default;
+    MAVLinkFrame(const MAVLinkFrame &other) noexcept;
+    MAVLinkFrame(MAVLinkFrame &&other) noexcept : _buffer(other._buffer) { other._buffer = nullptr; }
+    MAVLinkFrame &operator=(const MAVLinkFrame &other) noexcept;
+    MAVLinkFrame &operator=(MAVLinkFrame &&other) noexcept;
+    ~MAVLinkFrame() { _release(); }
+
+    /// Frame with an unshared buffer from the pool, the message contents are unspecified
+    static MAVLinkFrame allocate();
+
+    /// Frame holding a copy of message, for producers which do not parse into a frame
+    static MAVLinkFrame fromMessage(const mavlink_message_t &message);
+
+    bool isNull() const { return !_buffer; }
+    bool isShared() const { return _buffer && (_buffer->refs.load(std::memory_order_acquire) > 1); }
+
+    const mavlink_message_t &message() const { return _buffer->message; }
+    const mavlink_message_t *operator->() const { return &_buffer->message; }
+
+    /// Writable message, moved to a buffer of its own first if the current one is shared
+    mavlink_message_t &detach();
+
+    /// Process wide counters, used by the receive path benchmark
+    struct Stats {
+        quint64 allocations = 0;    ///< Buffers taken from the heap because the pool was empty
+        quint64 reuses = 0;         ///< Buffers taken from the pool
+        quint64 bytesCopied = 0;    ///< Message bytes copied by fromMessage() and detach()
+    };
+    static Stats stats();
+    static void resetStats();
+
+private:
+    struct Buffer {
+        std::atomic<int> refs{1};
+        Buffer *next = nullptr;     ///< Free list link while pooled
+        mavlink_message_t message;
+    };
+    struct Pool;
+
+    explicit MAVLinkFrame(Buffer *buffer) : _buffer(buffer) {}
+
+    void _release();
+    static Pool &_pool();
+
+    Buffer *_buffer = nullptr;
+
+    static constexpr int kMaxPooledBuffers = 64;
+};
+Q_DECLARE_METATYPE(MAVLinkFrame)
@@ -1,4 +1,5 @@
 #include "QGCMAVLink.h"
+#include "MAVLinkFrame.h"
 #include "MAVLinkLib.h"
 #include "QGCLoggingCategory.h"
 
@@ -70,6 +71,7 @@ QGCMAVLink::QGCMAVLink(QObject *parent)
     // qCDebug(StatusTextHandlerLog) << Q_FUNC_INFO << this;
 
    (void) qRegisterMetaType<mavlink_message_t>("mavlink_message_t");
+   (void) qRegisterMetaType<MAVLinkFrame>("MAVLinkFrame");
    // Removes dependence on Q_ENUM_NS static-init order for queued connections.
    (void) qRegisterMetaType<GRIPPER_ACTIONS>("GRIPPER_ACTIONS");
 }
@@ -122,6 +122,13 @@ void setMessageSigned(mavlink_message_t& message, bool isSigned)
 }
 
 QByteArray serializeUnsignedCopy(const mavlink_message_t& message)
+{
+    QByteArray buf(MAVLINK_MAX_PACKET_LEN, Qt::Uninitialized);
+    buf.resize(serializeUnsigned(message, reinterpret_cast<uint8_t*>(buf.data())));
+    return buf;
+}
+
+uint16_t serializeUnsigned(const mavlink_message_t& message, uint8_t* buffer)
 {
     mavlink_message_t copy = message;
 
@@ -150,10 +157,7 @@ QByteArray serializeUnsignedCopy(const mavlink_message_t& message)
         mavlink_ck_b(&copy) = static_cast<uint8_t>(checksum >> 8);
     }
 
-    QByteArray buf(MAVLINK_MAX_PACKET_LEN, Qt::Uninitialized);
-    const uint16_t len = mavlink_msg_to_send_buffer(reinterpret_cast<uint8_t*>(buf.data()), &copy);
-    buf.resize(len);
-    return buf;
+    return mavlink_msg_to_send_buffer(buffer, &copy);
 }
 
 namespace {
@@ -9,6 +9,8 @@
 
 #include <QtCore/QJsonArray>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(CorridorScanComplexItemLog, "Plan.CorridorScanComplexItem")
 
 CorridorScanComplexItem::CorridorScanComplexItem(PlanMasterController* masterController, bool flyView, const QString& kmlOrShpFile)
@@ -257,6 +259,7 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
     if (_corridorPolyline.count() >= 2) {
         // First build up the transects all going the same direction
         //qDebug() << "_rebuildTransectsPhase1";
+        _transects.reserve(transectCount);
         for (int i=0; i<transectCount; i++) {
             //qDebug() << "start transect";
             double offsetDistance;
@@ -271,6 +274,7 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
             // Turn transect into CoordInfo transect
             QList<TransectStyleComplexItem::CoordInfo_t> transect;
             QList<QGeoCoordinate> transectCoords = _corridorPolyline.offsetPolyline(offsetDistance);
+            transect.reserve(transectCoords.count() + 2);
             for (int j=1; j<transectCoords.count() - 1; j++) {
                 TransectStyleComplexItem::CoordInfo_t coordInfo = { transectCoords[j], CoordTypeInterior };
                 transect.append(coordInfo);
@@ -335,47 +339,30 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
             reverseVertices = true;
             break;
         }
+        // Reverse in place rather than building reversed copies
         if (reverseTransects) {
-            QList<QList<TransectStyleComplexItem::CoordInfo_t>> reversedTransects;
-            for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect: _transects) {
-                reversedTransects.prepend(transect);
-            }
-            _transects = reversedTransects;
+            std::reverse(_transects.begin(), _transects.end());
         }
         if (reverseVertices) {
-            for (int i=0; i<_transects.count(); i++) {
-                QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
-                for (const TransectStyleComplexItem::CoordInfo_t& vertex: _transects[i]) {
-                    reversedVertices.prepend(vertex);
-                }
-                _transects[i] = reversedVertices;
+            for (QList<TransectStyleComplexItem::CoordInfo_t>& transect: _transects) {
+                std::reverse(transect.begin(), transect.end());
             }
         }
 
         // Adjust to lawnmower pattern
-        reverseVertices = false;
-        for (int i=0; i<_transects.count(); i++) {
+        for (int i=1; i<_transects.count(); i+=2) {
             // We must reverse the vertices for every other transect in order to make a lawnmower pattern
-            QList<TransectStyleComplexItem::CoordInfo_t> transectVertices = _transects[i];
-            if (reverseVertices) {
-                reverseVertices = false;
-                QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
-                for (int j=transectVertices.count()-1; j>=0; j--) {
-                    reversedVertices.append(transectVertices[j]);
-
-                    // as we are flying the transect reversed, we also need to swap entry and exit coordinate types
-                    if (reversedVertices.last().coordType == CoordTypeSurveyEntry) {
-                        reversedVertices.last().coordType = CoordTypeSurveyExit;
-                    } else if (reversedVertices.last().coordType == CoordTypeSurveyExit) {
-                        reversedVertices.last().coordType = CoordTypeSurveyEntry;
-                    }
+            QList<TransectStyleComplexItem::CoordInfo_t>& transectVertices = _transects[i];
+            std::reverse(transectVertices.begin(), transectVertices.end());
+
+            // as we are flying the transect reversed, we also need to swap entry and exit coordinate types
+            for (TransectStyleComplexItem::CoordInfo_t& coordInfo: transectVertices) {
+                if (coordInfo.coordType == CoordTypeSurveyEntry) {
+                    coordInfo.coordType = CoordTypeSurveyExit;
+                } else if (coordInfo.coordType == CoordTypeSurveyExit) {
+                    coordInfo.coordType = CoordTypeSurveyEntry;
                 }
-
-                transectVertices = reversedVertices;
-            } else {
-                reverseVertices = true;
             }
-            _transects[i] = transectVertices;
         }
     }
 }
@@ -24,6 +24,7 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
 {
     _ackTimeoutTimer = new QTimer(this);
     _ackTimeoutTimer->setSingleShot(true);
+    _transferClock.start();
 
     connect(_ackTimeoutTimer, &QTimer::timeout, this, &PlanManager::_ackTimeout);
 }
@@ -144,9 +145,11 @@ void PlanManager::_requestList(void)
 {
     qCDebug(PlanManagerLog) << QStringLiteral("_requestList %1 _planType:_retryCount").arg(_planTypeString()) << _planType << _retryCount;
 
-    _itemIndicesToRead.clear();
     _clearMissionItems();
 
+    // A retried REQUEST_LIST makes the MISSION_COUNT round trip ambiguous, so only the first one is timed
+    _requestListSentMSecs = (_retryCount == 0) ? _transferClock.elapsed() : -1;
+
     SharedLinkInterfacePtr  sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink){
         mavlink_message_t       message;
@@ -192,8 +195,9 @@ void PlanManager::_ackTimeout(void)
             _finishTransaction(false);
         } else {
             _retryCount++;
+            _timeoutBackoff = qMin(_timeoutBackoff * 2, 16);
             qCDebug(PlanManagerLog) << tr("Retrying %1 MISSION_REQUEST retry Count").arg(_planTypeString()) << _retryCount;
-            _requestNextMissionItem();
+            _retryMissionItemRequests();
         }
         break;
     case AckMissionRequest:
@@ -242,13 +246,12 @@ void PlanManager::_ackTimeout(void)
 void PlanManager::_startAckTimeout(AckType_t ack)
 {
     // Use much shorter timeouts in unit tests since MockLink responds instantly
-    const int retryTimeout = QGC::runningUnitTests() ? 10 : _retryTimeoutMilliseconds;
     const int ackTimeout = QGC::runningUnitTests() ? kTestAckTimeoutMs : _ackTimeoutMilliseconds;
 
     switch (ack) {
     case AckMissionItem:
         // We are actively trying to get the mission item, so we don't want to wait as long.
-        _ackTimeoutTimer->setInterval(retryTimeout);
+        _ackTimeoutTimer->setInterval(itemRequestTimeoutMSecs());
         break;
     case AckNone:
         // FALLTHROUGH
@@ -333,28 +336,90 @@ void PlanManager::_handleMissionCount(const mavlink_message_t& message)
 
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 count:").arg(_planTypeString()) << missionCount.count;
 
+    if (_requestListSentMSecs >= 0) {
+        _updateRoundTripTime(_transferClock.elapsed() - _requestListSentMSecs);
+    }
     _retryCount = 0;
+    _timeoutBackoff = 1;
 
     if (missionCount.count == 0) {
         _readTransactionComplete();
     } else {
-        // Prime read list
-        for (int i=0; i<missionCount.count; i++) {
-            _itemIndicesToRead << i;
-        }
+        // Items are assembled by sequence number so they may arrive in any order
         _missionItemCountToRead = missionCount.count;
-        _requestNextMissionItem();
+        _readItems.fill(nullptr, missionCount.count);
+        _readItemsReceived = 0;
+        _nextReadIndex = 0;
+        _readRequestsInFlight.clear();
+        _requestMissionItems();
     }
 }
 
-void PlanManager::_requestNextMissionItem(void)
+int PlanManager::readWindowSize(void) const
+{
+    const int windowSize = (_readWindowSize > 0) ? _readWindowSize : _vehicle->firmwarePlugin()->missionReadWindowSize();
+    return qMax(1, windowSize);
+}
+
+int PlanManager::itemRequestTimeoutMSecs(void) const
 {
-    if (_itemIndicesToRead.count() == 0) {
-        _sendError(InternalError, tr("Internal Error: Call to Vehicle _requestNextMissionItem with no more indices to read"));
+    const int minTimeout = QGC::runningUnitTests() ? 10 : _retryTimeoutMilliseconds;
+    const int maxTimeout = QGC::runningUnitTests() ? kTestAckTimeoutMs * 4 : _maxItemTimeoutMilliseconds;
+
+    // RFC 6298 style retransmission timeout, never below the fixed retry timeout used for fast links
+    double timeout = minTimeout;
+    if (_smoothedRttMSecs >= 0) {
+        timeout = qMax(timeout, _smoothedRttMSecs + (4 * _rttVarianceMSecs));
+    }
+
+    return qMin(qRound(timeout) * _timeoutBackoff, maxTimeout);
+}
+
+void PlanManager::_updateRoundTripTime(qint64 sampleMSecs)
+{
+    const double sample = static_cast<double>(sampleMSecs);
+    if (_smoothedRttMSecs < 0) {
+        _smoothedRttMSecs = sample;
+        _rttVarianceMSecs = sample / 2;
+    } else {
+        _rttVarianceMSecs = (0.75 * _rttVarianceMSecs) + (0.25 * qAbs(_smoothedRttMSecs - sample));
+        _smoothedRttMSecs = (0.875 * _smoothedRttMSecs) + (0.125 * sample);
+    }
+}
+
+/// Tops up the outstanding requests to the read window and (re)starts the item timeout
+void PlanManager::_requestMissionItems(void)
+{
+    const int windowSize = readWindowSize();
+    while ((_readRequestsInFlight.count() < windowSize) && (_nextReadIndex < _missionItemCountToRead)) {
+        _readRequestsInFlight.append(ReadRequest_t{ _nextReadIndex, _transferClock.elapsed(), false });
+        _sendMissionRequest(_nextReadIndex++);
+    }
+
+    if (_readRequestsInFlight.isEmpty()) {
+        _sendError(InternalError, tr("Internal Error: Call to Vehicle _requestMissionItems with no more indices to read"));
         return;
     }
 
-    qCDebug(PlanManagerLog) << QStringLiteral("_requestNextMissionItem %1 sequenceNumber:retry").arg(_planTypeString()) << _itemIndicesToRead[0] << _retryCount;
+    _startAckTimeout(AckMissionItem);
+}
+
+/// Selective retry: only the requests which are still unanswered are sent again
+void PlanManager::_retryMissionItemRequests(void)
+{
+    const qint64 now = _transferClock.elapsed();
+    for (ReadRequest_t& request : _readRequestsInFlight) {
+        request.sentMSecs = now;
+        request.retransmitted = true;
+        _sendMissionRequest(request.sequenceNumber);
+    }
+
+    _startAckTimeout(AckMissionItem);
+}
+
+void PlanManager::_sendMissionRequest(int sequenceNumber)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_sendMissionRequest %1 sequenceNumber:retry").arg(_planTypeString()) << sequenceNumber << _retryCount;
 
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
@@ -366,11 +431,10 @@ void PlanManager::_requestNextMissionItem(void)
                                                   &message,
                                                   _vehicle->id(),
                                                   MAV_COMP_ID_AUTOPILOT1,
-                                                  _itemIndicesToRead[0],
+                                                  sequenceNumber,
                                                   _planType);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
     }
-    _startAckTimeout(AckMissionItem);
 }
 
 void PlanManager::_handleMissionItem(const mavlink_message_t& message)
@@ -438,8 +502,19 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
         return;
     }
 
-    if (_itemIndicesToRead.contains(seq)) {
-        _itemIndicesToRead.removeOne(seq);
+    qsizetype requestIndex = -1;
+    for (qsizetype i=0; i<_readRequestsInFlight.count(); i++) {
+        if (_readRequestsInFlight[i].sequenceNumber == seq) {
+            requestIndex = i;
+            break;
+        }
+    }
+
+    if ((requestIndex >= 0) && !_readItems[seq]) {
+        const ReadRequest_t request = _readRequestsInFlight.takeAt(requestIndex);
+        if (!request.retransmitted) {
+            _updateRoundTripTime(_transferClock.elapsed() - request.sentMSecs);
+        }
 
         MissionItem* item = new MissionItem(seq,
                                             command,
@@ -460,7 +535,8 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
             item->setParam1((int)item->param1() + 1);
         }
 
-        _missionItems.append(item);
+        _readItems[seq] = item;
+        _readItemsReceived++;
     } else {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 mission item received item index which was not requested, disregrarding:").arg(_planTypeString()) << seq;
         // We have to put the ack timeout back since it was removed above
@@ -468,19 +544,35 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
         return;
     }
 
-    emit progressPctChanged((double)seq / (double)_missionItemCountToRead);
+    emit progressPctChanged((double)_readItemsReceived / (double)_missionItemCountToRead);
 
     _retryCount = 0;
-    if (_itemIndicesToRead.count() == 0) {
+    _timeoutBackoff = 1;
+    if (_readItemsReceived == _missionItemCountToRead) {
+        _missionItems.append(_readItems);
+        _readItems.clear();
         _readTransactionComplete();
     } else {
-        _requestNextMissionItem();
+        // Requests which have been outstanding longer than the timeout while later ones were answered were most
+        // likely lost; ask again right away instead of waiting for the whole window to stall.
+        const qint64 now = _transferClock.elapsed();
+        const int timeout = itemRequestTimeoutMSecs();
+        for (ReadRequest_t& request : _readRequestsInFlight) {
+            if ((request.sequenceNumber < seq) && ((now - request.sentMSecs) > timeout)) {
+                request.sentMSecs = now;
+                request.retransmitted = true;
+                _sendMissionRequest(request.sequenceNumber);
+            }
+        }
+        _requestMissionItems();
     }
 }
 
 void PlanManager::_clearMissionItems(void)
 {
-    _itemIndicesToRead.clear();
+    _readRequestsInFlight.clear();
+    qDeleteAll(_readItems);
+    _readItems.clear();
     _clearAndDeleteMissionItems();
 }
 
@@ -807,7 +899,10 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     emit progressPctChanged(1);
     _disconnectFromMavlink();
 
-    _itemIndicesToRead.clear();
+    // Partially read items are discarded, a completed read has already moved them to _missionItems
+    _readRequestsInFlight.clear();
+    qDeleteAll(_readItems);
+    _readItems.clear();
     _itemIndicesToWrite.clear();
 
     // First thing we do is clear the transaction. This way inProgesss is off when we signal transaction complete.
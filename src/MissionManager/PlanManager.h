@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include "MissionItem.h"
@@ -41,6 +42,14 @@ class PlanManager : public QObject
     ///     Signals removeAllComplete when done
     void removeAll(void);
 
+    /// Sets the number of MISSION_REQUEST_INT messages kept outstanding during a read
+    ///     @param windowSize 0: use FirmwarePlugin::missionReadWindowSize, 1: strictly sequential reads
+    void setReadWindowSize(int windowSize) { _readWindowSize = windowSize; }
+    int readWindowSize(void) const;
+
+    /// Current timeout for an outstanding item request, adapted to the measured round trip time
+    int itemRequestTimeoutMSecs(void) const;
+
     /// Error codes returned in error signal
     typedef enum {
         InternalError,
@@ -60,6 +69,8 @@ class PlanManager : public QObject
     // When actively retrying to request mission items, use a shorter timeout instead.
     static constexpr int _retryTimeoutMilliseconds = 250;
     static constexpr int _maxRetryCount = 5;
+    /// Upper bound for the adaptive item request timeout (satcom round trips can take several seconds)
+    static constexpr int _maxItemTimeoutMilliseconds = 6000;
 
     /// Ack timeout used in unit tests (much shorter for faster tests)
     static constexpr int kTestAckTimeoutMs = 50;
@@ -104,7 +115,10 @@ private slots:
     void _handleMissionItem(const mavlink_message_t& message);
     void _handleMissionRequest(const mavlink_message_t& message);
     void _handleMissionAck(const mavlink_message_t& message);
-    void _requestNextMissionItem(void);
+    void _requestMissionItems(void);
+    void _sendMissionRequest(int sequenceNumber);
+    void _retryMissionItemRequests(void);
+    void _updateRoundTripTime(qint64 sampleMSecs);
     void _clearMissionItems(void);
     void _sendError(ErrorCode_t errorCode, const QString& errorMsg);
     QString _ackTypeToString(AckType_t ackType);
@@ -132,10 +146,26 @@ private slots:
     TransactionType_t   _transactionInProgress;
     bool                _resumeMission;
     QList<int>          _itemIndicesToWrite;    ///< List of mission items which still need to be written to vehicle
-    QList<int>          _itemIndicesToRead;     ///< List of mission items which still need to be requested from vehicle
     int                 _lastMissionRequest;    ///< Index of item last requested by MISSION_REQUEST
     int                 _missionItemCountToRead;///< Count of all mission items to read
 
+    struct ReadRequest_t {
+        int     sequenceNumber;
+        qint64  sentMSecs;          ///< _transferClock time the request was (last) sent
+        bool    retransmitted;      ///< Retransmitted requests are ambiguous and never used as RTT samples
+    };
+    QList<MissionItem*>     _readItems;             ///< Read items by sequence number, nullptr: not received yet
+    QList<ReadRequest_t>    _readRequestsInFlight;  ///< Outstanding MISSION_REQUEST_INT messages
+    int                     _nextReadIndex =        0;
+    int                     _readItemsReceived =    0;
+    int                     _readWindowSize =       0;
+
+    QElapsedTimer       _transferClock;
+    qint64              _requestListSentMSecs = -1;
+    double              _smoothedRttMSecs =     -1;     ///< -1: no sample yet
+    double              _rttVarianceMSecs =     0;
+    int                 _timeoutBackoff =       1;      ///< Doubles on every item timeout, reset by progress
+
     QList<MissionItem*> _missionItems;          ///< Set of mission items on vehicle
     QList<MissionItem*> _writeMissionItems;     ///< Set of mission items currently being written to vehicle
     int                 _currentMissionIndex;
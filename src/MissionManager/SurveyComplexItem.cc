@@ -10,10 +10,11 @@
 #include "QGCApplication.h"
 #include "Vehicle.h"
 #include "QGCLoggingCategory.h"
+#include "SurveyTransectGenerator.h"
 
-#include <QtGui/QPolygonF>
 #include <QtCore/QJsonArray>
 #include <QtCore/QLineF>
+#include <QtCore/QRectF>
 
 QGC_LOGGING_CATEGORY(SurveyComplexItemLog, "Plan.SurveyComplexItem")
 
@@ -344,40 +345,22 @@ bool SurveyComplexItem::_loadV3(const QJsonObject& complexObject, int sequenceNu
     return true;
 }
 
-/// Reverse the order of the transects. First transect becomes last and so forth.
-void SurveyComplexItem::_reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects)
-{
-    QList<QList<QGeoCoordinate>> rgReversedTransects;
-    for (int i=transects.count() - 1; i>=0; i--) {
-        rgReversedTransects.append(transects[i]);
-    }
-    transects = rgReversedTransects;
-}
-
-/// Reverse the order of all points within each transect, First point becomes last and so forth.
-void SurveyComplexItem::_reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects)
-{
-    for (int i=0; i<transects.count(); i++) {
-        QList<QGeoCoordinate> rgReversedCoords;
-        QList<QGeoCoordinate>& rgOriginalCoords = transects[i];
-        for (int j=rgOriginalCoords.count()-1; j>=0; j--) {
-            rgReversedCoords.append(rgOriginalCoords[j]);
-        }
-        transects[i] = rgReversedCoords;
-    }
-}
-
 /// Reorders the transects such that the first transect is the shortest distance to the specified coordinate
 /// and the first point within that transect is the shortest distance to the specified coordinate.
 ///     @param distanceCoord Coordinate to measure distance against
+///     @param tangentOrigin NED origin of the transects
 ///     @param transects Transects to test and reorder
-void SurveyComplexItem::_optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects)
+void SurveyComplexItem::_optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, const QGeoCoordinate& tangentOrigin, std::vector<QLineF>& transects)
 {
+    if (transects.empty()) {
+        return;
+    }
+
     double rgTransectDistance[4];
-    rgTransectDistance[0] = transects.first().first().distanceTo(distanceCoord);
-    rgTransectDistance[1] = transects.first().last().distanceTo(distanceCoord);
-    rgTransectDistance[2] = transects.last().first().distanceTo(distanceCoord);
-    rgTransectDistance[3] = transects.last().last().distanceTo(distanceCoord);
+    rgTransectDistance[0] = SurveyTransectGenerator::toGeo(transects.front().p1(), tangentOrigin).distanceTo(distanceCoord);
+    rgTransectDistance[1] = SurveyTransectGenerator::toGeo(transects.front().p2(), tangentOrigin).distanceTo(distanceCoord);
+    rgTransectDistance[2] = SurveyTransectGenerator::toGeo(transects.back().p1(), tangentOrigin).distanceTo(distanceCoord);
+    rgTransectDistance[3] = SurveyTransectGenerator::toGeo(transects.back().p2(), tangentOrigin).distanceTo(distanceCoord);
 
     int shortestIndex = 0;
     double shortestDistance = rgTransectDistance[0];
@@ -390,11 +373,11 @@ void SurveyComplexItem::_optimizeTransectsForShortestDistance(const QGeoCoordina
 
     if (shortestIndex > 1) {
         // We need to reverse the order of segments
-        _reverseTransectOrder(transects);
+        SurveyTransectGenerator::reverseTransectOrder(transects);
     }
     if (shortestIndex & 1) {
         // We need to reverse the points within each segment
-        _reverseInternalTransectPoints(transects);
+        SurveyTransectGenerator::reverseTransectPoints(transects);
     }
 }
 
@@ -423,9 +406,9 @@ bool SurveyComplexItem::_gridAngleIsNorthSouthTransects()
     return gridAngle < 45.0 || (gridAngle > 360.0 - 45.0) || (gridAngle > 90.0 + 45.0 && gridAngle < 270.0 - 45.0);
 }
 
-void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects)
+void SurveyComplexItem::_adjustTransectsToEntryPointLocation(std::vector<QLineF>& transects)
 {
-    if (transects.count() == 0) {
+    if (transects.empty()) {
         return;
     }
 
@@ -441,25 +424,14 @@ void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoo
 
     if (reversePoints) {
         qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Reverse Points";
-        _reverseInternalTransectPoints(transects);
+        SurveyTransectGenerator::reverseTransectPoints(transects);
     }
     if (reverseTransects) {
         qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Reverse Transects";
-        _reverseTransectOrder(transects);
+        SurveyTransectGenerator::reverseTransectOrder(transects);
     }
 
-    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.first().first() << _entryPoint;
-}
-
-QPointF SurveyComplexItem::_rotatePoint(const QPointF& point, const QPointF& origin, double angle)
-{
-    QPointF rotated;
-    double radians = (M_PI / 180.0) * -angle;
-
-    rotated.setX(((point.x() - origin.x()) * cos(radians)) - ((point.y() - origin.y()) * sin(radians)) + origin.x());
-    rotated.setY(((point.x() - origin.x()) * sin(radians)) + ((point.y() - origin.y()) * cos(radians)) + origin.y());
-
-    return rotated;
+    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.front().p1() << _entryPoint;
 }
 
 void SurveyComplexItem::_intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines)
@@ -523,74 +495,6 @@ void SurveyComplexItem::_intersectLinesWithRect(const QList<QLineF>& lineList, c
     }
 }
 
-void SurveyComplexItem::_intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines)
-{
-    resultLines.clear();
-
-    for (int i=0; i<lineList.count(); i++) {
-        const QLineF& line = lineList[i];
-        QList<QPointF> intersections;
-
-        // Intersect the line with all the polygon edges
-        for (int j=0; j<polygon.count()-1; j++) {
-            QPointF intersectPoint;
-            QLineF polygonLine = QLineF(polygon[j], polygon[j+1]);
-
-            auto intersect = line.intersects(polygonLine, &intersectPoint);
-            if (intersect == QLineF::BoundedIntersection) {
-                if (!intersections.contains(intersectPoint)) {
-                    intersections.append(intersectPoint);
-                }
-            }
-        }
-
-        // We now have one or more intersection points all along the same line. Find the two
-        // which are furthest away from each other to form the transect.
-        if (intersections.count() > 1) {
-            QPointF firstPoint;
-            QPointF secondPoint;
-            double currentMaxDistance = 0;
-
-            for (int intersectionIndex=0; intersectionIndex<intersections.count(); intersectionIndex++) {
-                for (int compareIndex=0; compareIndex<intersections.count(); compareIndex++) {
-                    QLineF lineTest(intersections[intersectionIndex], intersections[compareIndex]);
-                    double newMaxDistance = lineTest.length();
-                    if (newMaxDistance > currentMaxDistance) {
-                        firstPoint = intersections[intersectionIndex];
-                        secondPoint = intersections[compareIndex];
-                        currentMaxDistance = newMaxDistance;
-                    }
-                }
-            }
-
-            resultLines += QLineF(firstPoint, secondPoint);
-        }
-    }
-}
-
-/// Adjust the line segments such that they are all going the same direction with respect to going from P1->P2
-void SurveyComplexItem::_adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines)
-{
-    qreal firstAngle = 0;
-    for (int i=0; i<lineList.count(); i++) {
-        const QLineF& line = lineList[i];
-        QLineF adjustedLine;
-
-        if (i == 0) {
-            firstAngle = line.angle();
-        }
-
-        if (qAbs(line.angle() - firstAngle) > 1.0) {
-            adjustedLine.setP1(line.p2());
-            adjustedLine.setP2(line.p1());
-        } else {
-            adjustedLine = line;
-        }
-
-        resultLines += adjustedLine;
-    }
-}
-
 double SurveyComplexItem::_clampGridAngle90(double gridAngle)
 {
     // Clamp grid angle to -90<->90. This prevents transects from being rotated to a reversed order.
@@ -648,222 +552,130 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         return;
     }
 
-    // Convert polygon to NED
-
-    QList<QPointF> polygonPoints;
-    QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
-        double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
-        if (i == 0) {
-            // This avoids a nan calculation that comes out of convertGeoToNed
-            x = y = 0;
-        } else {
-            QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
-        }
-        polygonPoints += QPointF(x, y);
-        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
-    }
-
-    // Generate transects
-
-    double gridAngle = _gridAngleFact.rawValue().toDouble();
-    double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    // Convert polygon to NED and generate transects
 
-    gridAngle = _clampGridAngle90(gridAngle);
-    gridAngle += refly ? 90 : 0;
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Clamped grid angle" << gridAngle;
+    SurveyTransectGenerator::Workspace& workspace = _transectWorkspace;
+    SurveyTransectGenerator::setPolygon(_surveyAreaPolygon.coordinateList(), workspace);
+    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << workspace.tangentOrigin;
 
+    const double gridAngle = _clampGridAngle90(_gridAngleFact.rawValue().toDouble()) + (refly ? 90 : 0);
+    const double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
     qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 gridSpacing:gridAngle:refly" << gridSpacing << gridAngle << refly;
 
-    // Convert polygon to bounding rect
-
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Polygon";
-    QPolygonF polygon;
-    for (int i=0; i<polygonPoints.count(); i++) {
-        qCDebug(SurveyComplexItemLog) << "Vertex" << polygonPoints[i];
-        polygon << polygonPoints[i];
-    }
-    polygon << polygonPoints[0];
-    QRectF boundingRect = polygon.boundingRect();
-    QPointF boundingCenter = boundingRect.center();
-    qCDebug(SurveyComplexItemLog) << "Bounding rect" << boundingRect.topLeft().x() << boundingRect.topLeft().y() << boundingRect.bottomRight().x() << boundingRect.bottomRight().y();
-
-    // Create set of rotated parallel lines within the expanded bounding rect. Make the lines larger than the
-    // bounding box to guarantee intersection.
-
-    QList<QLineF> lineList;
-
-    // Sweep lines must extend beyond the polygon boundary regardless of grid angle.
-    // The worst case is when the polygon is rotated 45° relative to the sweep direction,
-    // where the required reach equals half the diagonal of the bounding rect.
-    // We use diagonal * 1.5 to provide a 50% safety margin beyond that worst case.
-    // Note: the old fixed +2000m was insufficient for polygons larger than ~10km.
-    const double diagonal = qSqrt(boundingRect.width() * boundingRect.width() + boundingRect.height() * boundingRect.height());
-    double maxWidth = diagonal * 1.5;
-    if (maxWidth <= 0.0) {
+    if (!SurveyTransectGenerator::generate(gridAngle, gridSpacing, maxTransectCount, workspace)) {
         qCWarning(SurveyComplexItemLog) << "Degenerate polygon bounding rect (all vertices coincident or collinear), aborting transect rebuild";
         return;
     }
-
-    if (gridSpacing <= 0) {
-        // Invalid spacing: seed one center line so the < 2 fallback produces a single center transect.
+    if (workspace.spacingInvalid) {
         qCWarning(SurveyComplexItemLog) << "Grid spacing" << gridSpacing << "is invalid, falling back to single center transect";
-        const double halfW = maxWidth / 2.0;
-        lineList += QLineF(
-            _rotatePoint(QPointF(boundingCenter.x(), boundingCenter.y() - halfW), boundingCenter, gridAngle),
-            _rotatePoint(QPointF(boundingCenter.x(), boundingCenter.y() + halfW), boundingCenter, gridAngle));
-    } else {
-        // Cap spacing so the sweep never generates more than maxTransectCount transects.
-        // Uses diagonal (not maxWidth) so the count reflects actual polygon-crossing transects.
-        if (gridSpacing < diagonal / maxTransectCount) {
-            qCWarning(SurveyComplexItemLog) << "Transect spacing" << gridSpacing << "raised to" << diagonal / maxTransectCount << "to limit transect count to" << maxTransectCount;
-            gridSpacing = diagonal / maxTransectCount;
-        }
-
-        double halfWidth = maxWidth / 2.0;
-        double transectX = boundingCenter.x() - halfWidth;
-        double transectXMax = transectX + maxWidth;
-        while (transectX < transectXMax) {
-            double transectYTop = boundingCenter.y() - halfWidth;
-            double transectYBottom = boundingCenter.y() + halfWidth;
-
-            lineList += QLineF(_rotatePoint(QPointF(transectX, transectYTop), boundingCenter, gridAngle), _rotatePoint(QPointF(transectX, transectYBottom), boundingCenter, gridAngle));
-            transectX += gridSpacing;
-        }
+    } else if (workspace.spacingRaised) {
+        qCWarning(SurveyComplexItemLog) << "Transect spacing" << gridSpacing << "raised to" << workspace.gridSpacing << "to limit transect count to" << maxTransectCount;
     }
 
-    // Now intersect the lines with the polygon
-    QList<QLineF> intersectLines;
-#if 1
-    _intersectLinesWithPolygon(lineList, polygon, intersectLines);
-#else
-    // This is handy for debugging grid problems, not for release
-    intersectLines = lineList;
-#endif
-
-    // Less than two transects intersected with the polygon:
-    //      Create a single transect which goes through the center of the polygon
-    //      Intersect it with the polygon
-    if (intersectLines.count() < 2) {
-        _surveyAreaPolygon.center();
-        QLineF firstLine = lineList.first();
-        QPointF lineCenter = firstLine.pointAt(0.5);
-        QPointF centerOffset = boundingCenter - lineCenter;
-        firstLine.translate(centerOffset);
-        lineList.clear();
-        lineList.append(firstLine);
-        intersectLines = lineList;
-        _intersectLinesWithPolygon(lineList, polygon, intersectLines);
-    }
-
-    // Make sure all lines are going the same direction. Polygon intersection leads to lines which
-    // can be in varied directions depending on the order of the intesecting sides.
-    QList<QLineF> resultLines;
-    _adjustLineDirection(intersectLines, resultLines);
-
-    // Convert from NED to Geo
-    QList<QList<QGeoCoordinate>> transects;
-    for (const QLineF& line : resultLines) {
-        QGeoCoordinate          coord;
-        QList<QGeoCoordinate>   transect;
-
-        QGCGeo::convertNedToGeo(line.p1().y(), line.p1().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-        QGCGeo::convertNedToGeo(line.p2().y(), line.p2().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-
-        transects.append(transect);
-    }
+    std::vector<QLineF>& transects = workspace.transects;
 
     _adjustTransectsToEntryPointLocation(transects);
 
-    if (refly) {
-        _optimizeTransectsForShortestDistance(_transects.last().last().coord, transects);
+    if (refly && !_transects.isEmpty()) {
+        _optimizeTransectsForShortestDistance(_transects.last().last().coord, workspace.tangentOrigin, transects);
     }
 
     if (_flyAlternateTransectsFact.rawValue().toBool()) {
-        QList<QList<QGeoCoordinate>> alternatingTransects;
-        for (int i=0; i<transects.count(); i++) {
-            if (!(i & 1)) {
-                alternatingTransects.append(transects[i]);
-            }
-        }
-        for (int i=transects.count()-1; i>0; i--) {
-            if (i & 1) {
-                alternatingTransects.append(transects[i]);
-            }
-        }
-        transects = alternatingTransects;
+        SurveyTransectGenerator::alternateTransectOrder(workspace);
     }
 
     // Adjust to lawnmower pattern
-    bool reverseVertices = false;
-    for (int i=0; i<transects.count(); i++) {
-        // We must reverse the vertices for every other transect in order to make a lawnmower pattern
-        QList<QGeoCoordinate> transectVertices = transects[i];
-        if (reverseVertices) {
-            reverseVertices = false;
-            QList<QGeoCoordinate> reversedVertices;
-            for (int j=transectVertices.count()-1; j>=0; j--) {
-                reversedVertices.append(transectVertices[j]);
-            }
-            transectVertices = reversedVertices;
-        } else {
-            reverseVertices = true;
-        }
-        transects[i] = transectVertices;
-    }
+    SurveyTransectGenerator::applyLawnmowerPattern(transects);
+
+    // Convert from NED to CoordInfo transects and append to _transects
+    const bool hoverAndCapture = triggerCamera() && hoverAndCaptureEnabled();
+    const bool hasTurnaround = _hasTurnaround();
+    const double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
+
+    _transects.reserve(_transects.count() + static_cast<qsizetype>(transects.size()));
+    for (const QLineF& line : transects) {
+        const QGeoCoordinate entryCoord = SurveyTransectGenerator::toGeo(line.p1(), workspace.tangentOrigin);
+        const QGeoCoordinate exitCoord = SurveyTransectGenerator::toGeo(line.p2(), workspace.tangentOrigin);
 
-    // Convert to CoordInfo transects and append to _transects
-    for (const QList<QGeoCoordinate>& transect : transects) {
-        QGeoCoordinate                                  coord;
-        QList<TransectStyleComplexItem::CoordInfo_t>    coordInfoTransect;
-        TransectStyleComplexItem::CoordInfo_t           coordInfo;
+        QList<TransectStyleComplexItem::CoordInfo_t> coordInfoTransect;
+        coordInfoTransect.reserve(hasTurnaround ? 4 : 2);
+
+        // Extend the transect ends for turnaround
+        if (hasTurnaround) {
+            QGeoCoordinate turnaroundCoord = entryCoord.atDistanceAndAzimuth(-turnAroundDistance, entryCoord.azimuthTo(exitCoord));
+            turnaroundCoord.setAltitude(qQNaN());
+            coordInfoTransect.append({ turnaroundCoord, CoordTypeTurnaround });
+        }
 
-        coordInfo = { transect[0], CoordTypeSurveyEntry };
-        coordInfoTransect.append(coordInfo);
-        coordInfo = { transect[1], CoordTypeSurveyExit };
-        coordInfoTransect.append(coordInfo);
+        coordInfoTransect.append({ entryCoord, CoordTypeSurveyEntry });
 
         // For hover and capture we need points for each camera location within the transect
-        if (triggerCamera() && hoverAndCaptureEnabled()) {
-            double transectLength = transect[0].distanceTo(transect[1]);
-            double transectAzimuth = transect[0].azimuthTo(transect[1]);
+        if (hoverAndCapture) {
+            double transectLength = entryCoord.distanceTo(exitCoord);
+            double transectAzimuth = entryCoord.azimuthTo(exitCoord);
             if (triggerDistance() < transectLength) {
                 int cInnerHoverPoints = static_cast<int>(floor(transectLength / triggerDistance()));
                 qCDebug(SurveyComplexItemLog) << "cInnerHoverPoints" << cInnerHoverPoints;
                 for (int i=0; i<cInnerHoverPoints; i++) {
-                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(triggerDistance() * (i + 1), transectAzimuth);
-                    TransectStyleComplexItem::CoordInfo_t hoverCoordInfo = { hoverCoord, CoordTypeInteriorHoverTrigger };
-                    coordInfoTransect.insert(1 + i, hoverCoordInfo);
+                    QGeoCoordinate hoverCoord = entryCoord.atDistanceAndAzimuth(triggerDistance() * (i + 1), transectAzimuth);
+                    coordInfoTransect.append({ hoverCoord, CoordTypeInteriorHoverTrigger });
                 }
             }
         }
 
-        // Extend the transect ends for turnaround
-        if (_hasTurnaround()) {
-            QGeoCoordinate turnaroundCoord;
-            double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
-
-            double azimuth = transect[0].azimuthTo(transect[1]);
-            turnaroundCoord = transect[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
-            turnaroundCoord.setAltitude(qQNaN());
-            TransectStyleComplexItem::CoordInfo_t turnaroundCoordInfo = { turnaroundCoord, CoordTypeTurnaround };
-            coordInfoTransect.prepend(turnaroundCoordInfo);
+        coordInfoTransect.append({ exitCoord, CoordTypeSurveyExit });
 
-            azimuth = transect.last().azimuthTo(transect[transect.count() - 2]);
-            turnaroundCoord = transect.last().atDistanceAndAzimuth(-turnAroundDistance, azimuth);
+        if (hasTurnaround) {
+            QGeoCoordinate turnaroundCoord = exitCoord.atDistanceAndAzimuth(-turnAroundDistance, exitCoord.azimuthTo(entryCoord));
             turnaroundCoord.setAltitude(qQNaN());
-            coordInfo = { turnaroundCoord, CoordTypeTurnaround };
-            coordInfoTransect.append(coordInfo);
+            coordInfoTransect.append({ turnaroundCoord, CoordTypeTurnaround });
         }
 
         _transects.append(coordInfoTransect);
     }
 }
 
+std::function<QVariantList()> SurveyComplexItem::_createTransectPreviewJob(void)
+{
+    if (_surveyAreaPolygon.count() < 3) {
+        return {};
+    }
+
+    // Snapshot everything the worker needs; it must not touch this object
+    const QList<QGeoCoordinate> vertices = _surveyAreaPolygon.coordinateList();
+    const double gridAngle = _clampGridAngle90(_gridAngleFact.rawValue().toDouble());
+    const double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    const bool reversePoints = (_entryPoint == EntryLocationBottomLeft) || (_entryPoint == EntryLocationBottomRight);
+    const bool reverseTransects = (_entryPoint == EntryLocationTopRight) || (_entryPoint == EntryLocationBottomRight);
+    const bool flyAlternate = _flyAlternateTransectsFact.rawValue().toBool();
+
+    return [vertices, gridAngle, gridSpacing, reversePoints, reverseTransects, flyAlternate]() -> QVariantList {
+        thread_local SurveyTransectGenerator::Workspace workspace;
+
+        SurveyTransectGenerator::setPolygon(vertices, workspace);
+        if (!SurveyTransectGenerator::generate(gridAngle, gridSpacing, previewTransectCount, workspace)) {
+            return {};
+        }
+        if (reversePoints) {
+            SurveyTransectGenerator::reverseTransectPoints(workspace.transects);
+        }
+        if (reverseTransects) {
+            SurveyTransectGenerator::reverseTransectOrder(workspace.transects);
+        }
+        if (flyAlternate) {
+            SurveyTransectGenerator::alternateTransectOrder(workspace);
+        }
+        SurveyTransectGenerator::applyLawnmowerPattern(workspace.transects);
+
+        QVariantList points;
+        points.reserve(static_cast<qsizetype>(workspace.transects.size() * 2));
+        for (const QLineF& line : workspace.transects) {
+            points.append(QVariant::fromValue(SurveyTransectGenerator::toGeo(line.p1(), workspace.tangentOrigin)));
+            points.append(QVariant::fromValue(SurveyTransectGenerator::toGeo(line.p2(), workspace.tangentOrigin)));
+        }
+        return points;
+    };
+}
 
 void SurveyComplexItem::_recalcCameraShots(void)
 {
@@ -2,6 +2,7 @@
 
 #include "TransectStyleComplexItem.h"
 #include "SettingsFact.h"
+#include "SurveyTransectGenerator.h"
 
 class PlanMasterController;
 class MissionItem;
@@ -71,6 +72,8 @@ class SurveyComplexItem : public TransectStyleComplexItem
     static constexpr const char* flyAlternateTransectsName =  "FlyAlternateTransects";
     static constexpr const char* splitConcavePolygonsName =   "SplitConcavePolygons";
 
+    static constexpr int previewTransectCount = 50; ///< Transect cap for the coarse preview generated while dragging
+
 signals:
     void refly90DegreesChanged(bool refly90Degrees);
 
@@ -81,6 +84,10 @@ private slots:
     void _rebuildTransectsPhase1        (void) final;
     void _recalcCameraShots             (void) final;
 
+protected:
+    // Overrides from TransectStyleComplexItem
+    std::function<QVariantList()> _createTransectPreviewJob(void) final;
+
 private:
     enum CameraTriggerCode {
         CameraTriggerNone,
@@ -89,19 +96,14 @@ private slots:
         CameraTriggerHoverAndCapture
     };
 
-    QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
     void _intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines);
-    void _intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
-    void _adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines);
     bool _nextTransectCoord(const QList<QGeoCoordinate>& transectPoints, int pointIndex, QGeoCoordinate& coord);
     bool _appendMissionItemsWorker(QList<MissionItem*>& items, QObject* missionItemParent, int& seqNum, bool hasRefly, bool buildRefly);
-    void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
+    void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, const QGeoCoordinate& tangentOrigin, std::vector<QLineF>& transects);
     qreal _ccw(QPointF pt1, QPointF pt2, QPointF pt3);
     qreal _dp(QPointF pt1, QPointF pt2);
     void _swapPoints(QList<QPointF>& points, int index1, int index2);
-    void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
-    void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
-    void _adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects);
+    void _adjustTransectsToEntryPointLocation(std::vector<QLineF>& transects);
     bool _gridAngleIsNorthSouthTransects();
     double _clampGridAngle90(double gridAngle);
     bool _imagesEverywhere(void) const;
@@ -121,6 +123,8 @@ private slots:
     SettingsFact    _splitConcavePolygonsFact;
     int             _entryPoint;
 
+    SurveyTransectGenerator::Workspace _transectWorkspace;  ///< Reused between rebuilds so regeneration does not allocate
+
     static constexpr const char* _jsonGridAngleKey =          "angle";
     static constexpr const char* _jsonEntryPointKey =         "entryLocation";
 
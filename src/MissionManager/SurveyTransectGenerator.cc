@@ -0,0 +1,262 @@
+#include "SurveyTransectGenerator.h"
+#include "QGCGeo.h"
+
+#include <QtCore/QRectF>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SurveyTransectGenerator
+{
+
+namespace {
+
+/// Rotation about a fixed origin with sin/cos computed once per sweep rather than once per point
+class Rotator
+{
+public:
+    Rotator(const QPointF& origin, double angle)
+        : _origin(origin)
+        , _cos(std::cos(qDegreesToRadians(-angle)))
+        , _sin(std::sin(qDegreesToRadians(-angle)))
+    {
+    }
+
+    QPointF operator()(double x, double y) const
+    {
+        const double dx = x - _origin.x();
+        const double dy = y - _origin.y();
+        return QPointF((dx * _cos) - (dy * _sin) + _origin.x(), (dx * _sin) + (dy * _cos) + _origin.y());
+    }
+
+private:
+    QPointF _origin;
+    double  _cos;
+    double  _sin;
+};
+
+QRectF _boundingRect(const std::vector<QPointF>& polygon)
+{
+    double minX = polygon.front().x();
+    double maxX = minX;
+    double minY = polygon.front().y();
+    double maxY = minY;
+    for (const QPointF& point : polygon) {
+        minX = qMin(minX, point.x());
+        maxX = qMax(maxX, point.x());
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+/// Intersects the line with every polygon edge and returns the two intersections furthest apart.
+///
+/// All intersections lie on the same line, so the furthest pair is simply the minimum and maximum along the line
+/// direction; no intersection list is needed. The returned line starts at whichever of the two extremes was found
+/// first while walking the edges, which matches the orientation the pairwise search used to produce.
+bool _clipLineToPolygon(const QLineF& line, const std::vector<QPointF>& polygon, QLineF& result)
+{
+    const double dirX = line.dx();
+    const double dirY = line.dy();
+
+    int     found = 0;
+    QPointF minPoint;
+    QPointF maxPoint;
+    double  minT = 0;
+    double  maxT = 0;
+    int     minOrder = 0;
+    int     maxOrder = 0;
+
+    for (size_t j = 0; (j + 1) < polygon.size(); j++) {
+        QPointF intersectPoint;
+        if (line.intersects(QLineF(polygon[j], polygon[j + 1]), &intersectPoint) != QLineF::BoundedIntersection) {
+            continue;
+        }
+
+        const double t = ((intersectPoint.x() - line.x1()) * dirX) + ((intersectPoint.y() - line.y1()) * dirY);
+        if (found == 0) {
+            minPoint = maxPoint = intersectPoint;
+            minT = maxT = t;
+        } else if (t < minT) {
+            minPoint = intersectPoint;
+            minT = t;
+            minOrder = found;
+        } else if (t > maxT) {
+            maxPoint = intersectPoint;
+            maxT = t;
+            maxOrder = found;
+        }
+        found++;
+    }
+
+    if ((found < 2) || (minPoint == maxPoint)) {
+        return false;
+    }
+
+    result = (minOrder <= maxOrder) ? QLineF(minPoint, maxPoint) : QLineF(maxPoint, minPoint);
+    return true;
+}
+
+} // namespace
+
+void setPolygon(const QList<QGeoCoordinate>& vertices, Workspace& workspace)
+{
+    workspace.polygon.clear();
+    if (vertices.isEmpty()) {
+        return;
+    }
+
+    workspace.tangentOrigin = vertices.first();
+    workspace.polygon.reserve(vertices.count() + 1);
+
+    // First vertex is the origin. This also avoids a nan calculation that comes out of convertGeoToNed.
+    workspace.polygon.emplace_back(0, 0);
+    for (int i=1; i<vertices.count(); i++) {
+        double north, east, down;
+        QGCGeo::convertGeoToNed(vertices[i], workspace.tangentOrigin, north, east, down);
+        workspace.polygon.emplace_back(east, north);
+    }
+    workspace.polygon.push_back(workspace.polygon.front());
+}
+
+bool generate(double gridAngle, double gridSpacing, int maxTransectCount, Workspace& workspace)
+{
+    workspace.transects.clear();
+    workspace.gridSpacing = gridSpacing;
+    workspace.spacingRaised = false;
+    workspace.spacingInvalid = false;
+
+    if (workspace.polygon.size() < 4) {
+        return false;
+    }
+
+    const QRectF boundingRect = _boundingRect(workspace.polygon);
+    const QPointF boundingCenter = boundingRect.center();
+
+    // Sweep lines must extend beyond the polygon boundary regardless of grid angle.
+    // The worst case is when the polygon is rotated 45° relative to the sweep direction,
+    // where the required reach equals half the diagonal of the bounding rect.
+    // We use diagonal * 1.5 to provide a 50% safety margin beyond that worst case.
+    const double diagonal = qSqrt(boundingRect.width() * boundingRect.width() + boundingRect.height() * boundingRect.height());
+    const double maxWidth = diagonal * 1.5;
+    if (maxWidth <= 0.0) {
+        return false;
+    }
+
+    const double halfWidth = maxWidth / 2.0;
+    const Rotator rotate(boundingCenter, gridAngle);
+    const double transectYTop = boundingCenter.y() - halfWidth;
+    const double transectYBottom = boundingCenter.y() + halfWidth;
+    auto sweepLine = [&](double transectX) {
+        return QLineF(rotate(transectX, transectYTop), rotate(transectX, transectYBottom));
+    };
+
+    // First line of the sweep, used as the center transect fallback below
+    QLineF firstLine;
+
+    if (gridSpacing <= 0) {
+        // Invalid spacing: seed one center line so the < 2 fallback produces a single center transect
+        workspace.spacingInvalid = true;
+        firstLine = sweepLine(boundingCenter.x());
+        QLineF clipped;
+        if (_clipLineToPolygon(firstLine, workspace.polygon, clipped)) {
+            workspace.transects.push_back(clipped);
+        }
+    } else {
+        // Cap spacing so the sweep never generates more than maxTransectCount transects.
+        // Uses diagonal (not maxWidth) so the count reflects actual polygon-crossing transects.
+        if (gridSpacing < diagonal / maxTransectCount) {
+            gridSpacing = diagonal / maxTransectCount;
+            workspace.spacingRaised = true;
+        }
+        workspace.gridSpacing = gridSpacing;
+
+        const double transectXMin = boundingCenter.x() - halfWidth;
+        const double transectXMax = transectXMin + maxWidth;
+        workspace.transects.reserve(static_cast<size_t>(std::ceil(maxWidth / gridSpacing)));
+
+        firstLine = sweepLine(transectXMin);
+        for (double transectX = transectXMin; transectX < transectXMax; transectX += gridSpacing) {
+            QLineF clipped;
+            if (_clipLineToPolygon(sweepLine(transectX), workspace.polygon, clipped)) {
+                workspace.transects.push_back(clipped);
+            }
+        }
+    }
+
+    // Less than two transects intersected with the polygon:
+    //      Create a single transect which goes through the center of the polygon
+    //      Intersect it with the polygon
+    if (workspace.transects.size() < 2) {
+        firstLine.translate(boundingCenter - firstLine.pointAt(0.5));
+        workspace.transects.clear();
+        QLineF clipped;
+        if (_clipLineToPolygon(firstLine, workspace.polygon, clipped)) {
+            workspace.transects.push_back(clipped);
+        }
+    }
+
+    // Make sure all lines are going the same direction. Polygon intersection leads to lines which
+    // can be in varied directions depending on the order of the intesecting sides.
+    if (!workspace.transects.empty()) {
+        const qreal firstAngle = workspace.transects.front().angle();
+        for (QLineF& line : workspace.transects) {
+            if (qAbs(line.angle() - firstAngle) > 1.0) {
+                line = QLineF(line.p2(), line.p1());
+            }
+        }
+    }
+
+    return true;
+}
+
+void reverseTransectOrder(std::vector<QLineF>& transects)
+{
+    std::reverse(transects.begin(), transects.end());
+}
+
+void reverseTransectPoints(std::vector<QLineF>& transects)
+{
+    for (QLineF& line : transects) {
+        line = QLineF(line.p2(), line.p1());
+    }
+}
+
+void alternateTransectOrder(Workspace& workspace)
+{
+    std::vector<QLineF>& transects = workspace.transects;
+    std::vector<QLineF>& alternating = workspace.scratch;
+    if (transects.empty()) {
+        return;
+    }
+
+    alternating.clear();
+    alternating.reserve(transects.size());
+    for (size_t i=0; i<transects.size(); i+=2) {
+        alternating.push_back(transects[i]);
+    }
+    for (size_t i=transects.size() - 1; i>0; i--) {
+        if (i & 1) {
+            alternating.push_back(transects[i]);
+        }
+    }
+    transects.swap(alternating);
+}
+
+void applyLawnmowerPattern(std::vector<QLineF>& transects)
+{
+    for (size_t i=1; i<transects.size(); i+=2) {
+        transects[i] = QLineF(transects[i].p2(), transects[i].p1());
+    }
+}
+
+QGeoCoordinate toGeo(const QPointF& nedPoint, const QGeoCoordinate& tangentOrigin)
+{
+    QGeoCoordinate coord;
+    QGCGeo::convertNedToGeo(nedPoint.y(), nedPoint.x(), 0, tangentOrigin, coord);
+    return coord;
+}
+
+} // namespace SurveyTransectGenerator
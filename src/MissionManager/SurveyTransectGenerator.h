@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QtCore/QLineF>
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <vector>
+
+/// Survey grid geometry: sweeps parallel lines across a polygon in a local NED frame and clips them to the polygon.
+///
+/// Pure functions over a caller-owned Workspace so the same code runs on the GUI thread (full resolution rebuild)
+/// and on a worker thread (coarse preview while dragging). The workspace buffers keep their capacity between calls,
+/// so once warmed up regenerating transects does not allocate.
+namespace SurveyTransectGenerator
+{
+    struct Workspace {
+        QGeoCoordinate          tangentOrigin;              ///< NED origin, first polygon vertex
+        std::vector<QPointF>    polygon;                    ///< Closed polygon in NED (x = east, y = north)
+        std::vector<QLineF>     transects;                  ///< Output: clipped transects, all pointing the same direction
+        std::vector<QLineF>     scratch;
+        double                  gridSpacing =       0;      ///< Output: spacing actually used
+        bool                    spacingRaised =     false;  ///< Output: spacing was raised to honor the transect cap
+        bool                    spacingInvalid =    false;  ///< Output: spacing <= 0, single center transect used
+    };
+
+    /// Converts the polygon vertices to NED around the first vertex and closes the ring
+    void setPolygon(const QList<QGeoCoordinate>& vertices, Workspace& workspace);
+
+    /// Generates transects for the polygon currently in the workspace.
+    ///     @param gridAngle Sweep angle in degrees (already clamped/offset for refly)
+    ///     @param gridSpacing Distance between transects in meters
+    ///     @param maxTransectCount Spacing is raised so the sweep never produces more than this many transects
+    /// @return false: polygon is degenerate, no transects generated
+    bool generate(double gridAngle, double gridSpacing, int maxTransectCount, Workspace& workspace);
+
+    /// Reverse the order of the transects. First transect becomes last and so forth.
+    void reverseTransectOrder(std::vector<QLineF>& transects);
+
+    /// Swap the entry and exit point of every transect
+    void reverseTransectPoints(std::vector<QLineF>& transects);
+
+    /// Reorder for alternate transect flight: even transects in order followed by odd transects in reverse
+    void alternateTransectOrder(Workspace& workspace);
+
+    /// Reverse every other transect so consecutive transects are flown back and forth
+    void applyLawnmowerPattern(std::vector<QLineF>& transects);
+
+    QGeoCoordinate toGeo(const QPointF& nedPoint, const QGeoCoordinate& tangentOrigin);
+}
@@ -14,6 +14,7 @@
 #include "Vehicle.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QJsonArray>
 
 QGC_LOGGING_CATEGORY(TransectStyleComplexItemLog, "Plan.TransectStyleComplexItem")
@@ -45,6 +46,7 @@ TransectStyleComplexItem::TransectStyleComplexItem(PlanMasterController* masterC
     connect(&_terrainAdjustMaxDescentRateFact,          &Fact::valueChanged,                this, &TransectStyleComplexItem::_rebuildTransects);
     connect(&_terrainAdjustToleranceFact,               &Fact::valueChanged,                this, &TransectStyleComplexItem::_rebuildTransects);
     connect(&_surveyAreaPolygon,                        &QGCMapPolygon::pathChanged,        this, &TransectStyleComplexItem::_rebuildTransects);
+    connect(&_surveyAreaPolygon,                        &QGCMapPolygon::dragPathChanged,    this, &TransectStyleComplexItem::_scheduleTransectPreview);
     connect(&_cameraTriggerInTurnAroundFact,            &Fact::valueChanged,                this, &TransectStyleComplexItem::_rebuildTransects);
     connect(_cameraCalc.adjustedFootprintSide(),        &Fact::valueChanged,                this, &TransectStyleComplexItem::_rebuildTransects);
     connect(_cameraCalc.adjustedFootprintFrontal(),     &Fact::valueChanged,                this, &TransectStyleComplexItem::_rebuildTransects);
@@ -403,6 +405,10 @@ void TransectStyleComplexItem::_rebuildTransects(void)
         return;
     }
 
+    // Any preview still being computed is now stale
+    _transectGeneration++;
+    _previewPending = false;
+
     _transects.clear();
     _rgPathHeightInfo.clear();
     _rgFlightPathCoordInfo.clear();
@@ -482,6 +488,45 @@ void TransectStyleComplexItem::_rebuildTransects(void)
     _amslExitAltChanged();
 }
 
+/// Generates a coarse preview of the transects on a worker thread while the polygon is being dragged. Only one job
+/// runs at a time; drag updates arriving meanwhile are coalesced into a single follow-up job using the latest path.
+/// The full resolution rebuild on drag end still runs synchronously, see _rebuildTransects().
+void TransectStyleComplexItem::_scheduleTransectPreview(void)
+{
+    if (_ignoreRecalc) {
+        return;
+    }
+    if (_previewInFlight) {
+        _previewPending = true;
+        return;
+    }
+
+    std::function<QVariantList()> job = _createTransectPreviewJob();
+    if (!job) {
+        return;
+    }
+
+    const quint64 generation = ++_transectGeneration;
+    _previewInFlight = true;
+    (void) QtConcurrent::run(std::move(job)).then(this, [this, generation](const QVariantList& previewPoints) {
+        _previewInFlight = false;
+
+        if (generation == _transectGeneration) {
+            _visualTransectPoints = previewPoints;
+            emit visualTransectPointsChanged();
+        } else {
+            qCDebug(TransectStyleComplexItemLog) << "Dropping stale transect preview generation" << generation << "current" << _transectGeneration;
+        }
+
+        if (_previewPending) {
+            _previewPending = false;
+            if (_surveyAreaPolygon.vertexDrag() || _surveyAreaPolygon.centerDrag()) {
+                _scheduleTransectPreview();
+            }
+        }
+    });
+}
+
 void TransectStyleComplexItem::_segmentTerrainCollisionChanged(bool terrainCollision)
 {
     ComplexMissionItem::_segmentTerrainCollisionChanged(terrainCollision);
@@ -8,6 +8,8 @@
 #include "CameraCalc.h"
 #include "TerrainQuery.h"
 
+#include <functional>
+
 class PlanMasterController;
 
 class TransectStyleComplexItem : public ComplexMissionItem
@@ -124,12 +126,19 @@ protected slots:
     void _updateCoordinateAltitudes         (void);
     void _polyPathTerrainData               (bool success, const QList<TerrainPathQuery::PathHeightInfo_t>& rgPathHeightInfo);
     void _missionItemCoordTerrainData       (bool success, QList<double> heights);
+    /// Full resolution rebuild. Runs synchronously on the GUI thread: mission item generation, save, sequence
+    /// numbering and the terrain query chain all read _transects right after a setting or path change, so the result
+    /// must be current when this returns. Only the coarse drag preview (_scheduleTransectPreview) runs on a worker.
     void _rebuildTransects                  (void);
 
 protected:
     virtual void _rebuildTransectsPhase1    (void) = 0; ///< Rebuilds the _transects array
     virtual void _recalcCameraShots         (void) = 0;
 
+    /// Returns a job which computes a coarse preview of visualTransectPoints from a snapshot of the current settings.
+    /// The job runs on a worker thread so it must not reference this object. Empty function: no preview support.
+    virtual std::function<QVariantList()> _createTransectPreviewJob(void) { return {}; }
+
     void    _save                           (QJsonObject& saveObject);
     bool    _load                           (const QJsonObject& complexObject, bool forPresets, QString& errorString);
     void    _setExitCoordinate              (const QGeoCoordinate& coordinate);
@@ -210,6 +219,7 @@ private slots:
     void _updateFlightPathSegmentsDontCallDirectly  (void);
     void _segmentTerrainCollisionChanged            (bool terrainCollision) final;
     void _distanceModeChanged                       (int distanceMode);
+    void _scheduleTransectPreview                   (void);
 
 private:
     typedef struct {
@@ -236,6 +246,10 @@ private slots:
     TerrainAtCoordinateQuery*   _currentTerrainAtCoordinateQuery    = nullptr;
     QTimer                      _terrainPolyPathQueryTimer;
 
+    quint64 _transectGeneration =   0;      ///< Bumped by every rebuild/preview, results from older generations are dropped
+    bool    _previewInFlight =      false;
+    bool    _previewPending =       false;
+
     // Deprecated json keys
     static constexpr const char* _jsonTerrainFollowKeyDeprecated = "FollowTerrain";
 };
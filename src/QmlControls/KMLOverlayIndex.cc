@@ -0,0 +1,418 @@
+#include "KMLOverlayIndex.h"
+#include "QGCGeo.h"
+#include "QGCLoggingCategory.h"
+#include "ShapeFileHelper.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QStringView>
+#include <QtCore/QXmlStreamReader>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+QGC_LOGGING_CATEGORY(KMLOverlayIndexLog, "QMLControls.KMLOverlayIndex")
+
+namespace {
+
+constexpr double kMetersPerPixelAtZoom0 = 156543.03392;    ///< Web mercator ground resolution at the equator
+constexpr double kViewportMargin = 0.5;                    ///< Fraction of the viewport size added on every side
+
+/// Parses a KML coordinates element: whitespace separated "lon,lat[,alt]" tuples
+QList<QGeoCoordinate> _parseCoordinates(QStringView text)
+{
+    QList<QGeoCoordinate> coords;
+
+    qsizetype index = 0;
+    while (index < text.size()) {
+        while ((index < text.size()) && text[index].isSpace()) {
+            index++;
+        }
+        qsizetype end = index;
+        while ((end < text.size()) && !text[end].isSpace()) {
+            end++;
+        }
+        if (end == index) {
+            break;
+        }
+
+        const QStringView tuple = text.sliced(index, end - index);
+        index = end;
+
+        const qsizetype lonEnd = tuple.indexOf(u',');
+        if (lonEnd < 0) {
+            continue;
+        }
+        QStringView latitudeText = tuple.sliced(lonEnd + 1);
+        const qsizetype latEnd = latitudeText.indexOf(u',');
+        if (latEnd >= 0) {
+            latitudeText = latitudeText.first(latEnd);
+        }
+
+        bool lonOk = false;
+        bool latOk = false;
+        const double longitude = tuple.first(lonEnd).toDouble(&lonOk);
+        const double latitude = latitudeText.toDouble(&latOk);
+        if (lonOk && latOk) {
+            const QGeoCoordinate coord(latitude, longitude);
+            if (coord.isValid()) {
+                coords.append(coord);
+            }
+        }
+    }
+
+    return coords;
+}
+
+} // namespace
+
+void KMLOverlayIndex::Bounds::unite(const Bounds &other)
+{
+    minLat = std::min(minLat, other.minLat);
+    maxLat = std::max(maxLat, other.maxLat);
+    minLon = std::min(minLon, other.minLon);
+    maxLon = std::max(maxLon, other.maxLon);
+}
+
+bool KMLOverlayIndex::Bounds::intersects(const Bounds &other) const
+{
+    return (minLat <= other.maxLat) && (maxLat >= other.minLat) && (minLon <= other.maxLon) && (maxLon >= other.minLon);
+}
+
+bool KMLOverlayIndex::loadKmlFile(const QString &file, QString &errorString)
+{
+    QFile kmlFile(file);
+    if (!kmlFile.open(QIODevice::ReadOnly)) {
+        errorString = QStringLiteral("Unable to open %1: %2").arg(file, kmlFile.errorString());
+        return false;
+    }
+
+    return loadKml(&kmlFile, errorString);
+}
+
+bool KMLOverlayIndex::loadKml(QIODevice *device, QString &errorString)
+{
+    QXmlStreamReader xml(device);
+
+    // Open elements below the current Placemark, coordinates are classified by their ancestors
+    QStringList elements;
+    bool inPlacemark = false;
+    QString name;
+    QList<std::pair<FeatureType, QList<QGeoCoordinate>>> geometries;
+
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = xml.readNext();
+
+        if (token == QXmlStreamReader::StartElement) {
+            const QStringView element = xml.name();
+            if (element == u"Placemark") {
+                inPlacemark = true;
+                elements.clear();
+                name.clear();
+                geometries.clear();
+                continue;
+            }
+            if (!inPlacemark) {
+                continue;
+            }
+
+            if ((element == u"name") && elements.isEmpty()) {
+                name = xml.readElementText(QXmlStreamReader::SkipChildElements).trimmed();
+            } else if (element == u"coordinates") {
+                const QString text = xml.readElementText(QXmlStreamReader::SkipChildElements);
+                if (elements.contains(QStringLiteral("LineString"))) {
+                    geometries.append({ FeatureType::Polyline, _parseCoordinates(text) });
+                } else if (elements.contains(QStringLiteral("outerBoundaryIs"))) {
+                    geometries.append({ FeatureType::Polygon, _parseCoordinates(text) });
+                } else if (elements.contains(QStringLiteral("Point"))) {
+                    geometries.append({ FeatureType::Label, _parseCoordinates(text) });
+                }
+            } else {
+                elements.append(element.toString());
+            }
+        } else if (token == QXmlStreamReader::EndElement) {
+            if (!inPlacemark) {
+                continue;
+            }
+
+            if (xml.name() == u"Placemark") {
+                inPlacemark = false;
+                for (const auto &[type, path] : std::as_const(geometries)) {
+                    if (path.isEmpty() || ((type == FeatureType::Label) && name.isEmpty())) {
+                        continue;
+                    }
+                    addFeature(type, path, name);
+                }
+            } else if (!elements.isEmpty()) {
+                elements.removeLast();
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        errorString = QStringLiteral("XML parsing error: %1 at line %2 column %3").arg(xml.errorString()).arg(xml.lineNumber()).arg(xml.columnNumber());
+        return false;
+    }
+
+    return true;
+}
+
+bool KMLOverlayIndex::loadShapeFile(const QString &file, QString &errorString)
+{
+    const ShapeFileHelper::ShapeType shapeType = ShapeFileHelper::determineShapeType(file, errorString);
+    if (!errorString.isEmpty()) {
+        return false;
+    }
+
+    QList<QList<QGeoCoordinate>> paths;
+    FeatureType type = FeatureType::Polygon;
+    switch (shapeType) {
+    case ShapeFileHelper::ShapeType::Polygon:
+        type = FeatureType::Polygon;
+        if (!ShapeFileHelper::loadPolygonsFromFile(file, paths, errorString)) {
+            return false;
+        }
+        break;
+    case ShapeFileHelper::ShapeType::Polyline:
+        type = FeatureType::Polyline;
+        if (!ShapeFileHelper::loadPolylinesFromFile(file, paths, errorString)) {
+            return false;
+        }
+        break;
+    case ShapeFileHelper::ShapeType::Point:
+    case ShapeFileHelper::ShapeType::Error:
+    default:
+        errorString = QStringLiteral("Unable to determine shape type");
+        return false;
+    }
+
+    for (const QList<QGeoCoordinate> &path : std::as_const(paths)) {
+        if (!path.isEmpty()) {
+            addFeature(type, path);
+        }
+    }
+
+    return true;
+}
+
+void KMLOverlayIndex::addFeature(FeatureType type, const QList<QGeoCoordinate> &path, const QString &text)
+{
+    Feature feature;
+    feature.type = type;
+    feature.text = text;
+
+    QList<QGeoCoordinate> &levelZero = feature.levels[0];
+    if (type == FeatureType::Label) {
+        levelZero.append(path.first());
+    } else {
+        levelZero = path;
+        if ((type == FeatureType::Polygon) && (levelZero.count() > 3) && (levelZero.first() == levelZero.last())) {
+            // KML rings repeat the first vertex, map polygons close themselves
+            levelZero.removeLast();
+        }
+    }
+
+    for (const QGeoCoordinate &coord : std::as_const(levelZero)) {
+        feature.bounds.minLat = std::min(feature.bounds.minLat, coord.latitude());
+        feature.bounds.maxLat = std::max(feature.bounds.maxLat, coord.latitude());
+        feature.bounds.minLon = std::min(feature.bounds.minLon, coord.longitude());
+        feature.bounds.maxLon = std::max(feature.bounds.maxLon, coord.longitude());
+    }
+    if (type != FeatureType::Label) {
+        feature.sizeMeters = QGeoCoordinate(feature.bounds.minLat, feature.bounds.minLon).distanceTo(QGeoCoordinate(feature.bounds.maxLat, feature.bounds.maxLon));
+    }
+
+    _pointCount += levelZero.count();
+    _features.push_back(std::move(feature));
+}
+
+void KMLOverlayIndex::_simplify(Feature &feature)
+{
+    if (feature.type == FeatureType::Label) {
+        return;
+    }
+
+    // Each level simplifies the one below it, the error adds up to at most 4/3 of the level tolerance
+    const bool closed = (feature.type == FeatureType::Polygon);
+    const qsizetype minimumCount = closed ? 3 : 2;
+    const QList<QGeoCoordinate> *previous = &feature.levels[0];
+    for (int level = 1; level < kLevelCount; level++) {
+        feature.levels[level].clear();
+        if (previous->count() <= minimumCount) {
+            continue;
+        }
+
+        QList<QGeoCoordinate> simplified = QGCGeo::simplifyPath(*previous, kLevelToleranceMeters[level], closed);
+        if (simplified.count() < previous->count()) {
+            feature.levels[level] = std::move(simplified);
+            previous = &feature.levels[level];
+        }
+    }
+}
+
+template<typename BoundsOf>
+void KMLOverlayIndex::_sortTileRecursive(std::vector<int> &ids, BoundsOf &&boundsOf)
+{
+    const size_t nodeCount = (ids.size() + kNodeCapacity - 1) / kNodeCapacity;
+    const size_t sliceSize = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodeCount)))) * kNodeCapacity;
+
+    auto centerLon = [&boundsOf](int id) { const Bounds &bounds = boundsOf(id); return bounds.minLon + bounds.maxLon; };
+    auto centerLat = [&boundsOf](int id) { const Bounds &bounds = boundsOf(id); return bounds.minLat + bounds.maxLat; };
+
+    std::sort(ids.begin(), ids.end(), [&centerLon](int a, int b) { return centerLon(a) < centerLon(b); });
+    for (size_t slice = 0; slice < ids.size(); slice += sliceSize) {
+        const auto sliceEnd = ids.begin() + static_cast<std::ptrdiff_t>(std::min(ids.size(), slice + sliceSize));
+        std::sort(ids.begin() + static_cast<std::ptrdiff_t>(slice), sliceEnd, [&centerLat](int a, int b) { return centerLat(a) < centerLat(b); });
+    }
+}
+
+void KMLOverlayIndex::build()
+{
+    _nodes.clear();
+    _leafFeatures.clear();
+    _childNodes.clear();
+    if (_features.empty()) {
+        return;
+    }
+
+    for (Feature &feature : _features) {
+        _simplify(feature);
+    }
+
+    _leafFeatures.resize(_features.size());
+    std::iota(_leafFeatures.begin(), _leafFeatures.end(), 0);
+    _sortTileRecursive(_leafFeatures, [this](int feature) -> const Bounds & { return _features[feature].bounds; });
+
+    std::vector<int> level;
+    for (size_t first = 0; first < _leafFeatures.size(); first += kNodeCapacity) {
+        Node node;
+        node.first = static_cast<int>(first);
+        node.count = static_cast<int>(std::min<size_t>(kNodeCapacity, _leafFeatures.size() - first));
+        for (int i = node.first; i < (node.first + node.count); i++) {
+            node.bounds.unite(_features[_leafFeatures[i]].bounds);
+        }
+        level.push_back(static_cast<int>(_nodes.size()));
+        _nodes.push_back(node);
+    }
+
+    while (level.size() > 1) {
+        _sortTileRecursive(level, [this](int node) -> const Bounds & { return _nodes[node].bounds; });
+
+        std::vector<int> parents;
+        for (size_t first = 0; first < level.size(); first += kNodeCapacity) {
+            Node node;
+            node.leaf = false;
+            node.first = static_cast<int>(_childNodes.size());
+            node.count = static_cast<int>(std::min<size_t>(kNodeCapacity, level.size() - first));
+            for (size_t i = first; i < (first + static_cast<size_t>(node.count)); i++) {
+                node.bounds.unite(_nodes[level[i]].bounds);
+                _childNodes.push_back(level[i]);
+            }
+            parents.push_back(static_cast<int>(_nodes.size()));
+            _nodes.push_back(node);
+        }
+        level = std::move(parents);
+    }
+
+    qCDebug(KMLOverlayIndexLog) << "Indexed" << _features.size() << "features" << _pointCount << "points in" << _nodes.size() << "nodes";
+}
+
+const QList<QGeoCoordinate> &KMLOverlayIndex::path(int feature, int level) const
+{
+    const std::array<QList<QGeoCoordinate>, kLevelCount> &levels = _features[feature].levels;
+    for (int i = std::clamp(level, 0, kLevelCount - 1); i > 0; i--) {
+        if (!levels[i].isEmpty()) {
+            return levels[i];
+        }
+    }
+    return levels[0];
+}
+
+int KMLOverlayIndex::levelForZoom(double zoomLevel, double latitude)
+{
+    const double metersPerPixel = kMetersPerPixelAtZoom0 * std::cos(qDegreesToRadians(latitude)) / std::pow(2.0, zoomLevel);
+
+    int level = 0;
+    while (((level + 1) < kLevelCount) && (kLevelToleranceMeters[level + 1] <= metersPerPixel)) {
+        level++;
+    }
+    return level;
+}
+
+bool KMLOverlayIndex::_visibleAtLevel(const Feature &feature, int level)
+{
+    // Below the level tolerance a feature is smaller than a pixel
+    return (feature.type == FeatureType::Label) || (feature.sizeMeters >= kLevelToleranceMeters[level]);
+}
+
+QList<int> KMLOverlayIndex::query(const QGeoRectangle &viewport, int level) const
+{
+    QList<int> features;
+    if (_nodes.empty()) {
+        return features;
+    }
+    level = std::clamp(level, 0, kLevelCount - 1);
+
+    if (!viewport.isValid()) {
+        for (int i = 0; i < count(); i++) {
+            if (_visibleAtLevel(_features[i], level)) {
+                features.append(i);
+            }
+        }
+        return features;
+    }
+
+    const double latMargin = viewport.height() * kViewportMargin;
+    const double lonMargin = viewport.width() * kViewportMargin;
+    const double west = viewport.topLeft().longitude() - lonMargin;
+    const double east = viewport.bottomRight().longitude() + lonMargin;
+
+    Bounds bounds;
+    bounds.minLat = std::clamp(viewport.bottomRight().latitude() - latMargin, -90.0, 90.0);
+    bounds.maxLat = std::clamp(viewport.topLeft().latitude() + latMargin, -90.0, 90.0);
+    if (viewport.topLeft().longitude() <= viewport.bottomRight().longitude()) {
+        bounds.minLon = std::max(west, -180.0);
+        bounds.maxLon = std::min(east, 180.0);
+        _query(bounds, level, features);
+    } else {
+        // Viewport crosses the antimeridian, query both sides
+        bounds.minLon = west;
+        bounds.maxLon = 180.0;
+        _query(bounds, level, features);
+        bounds.minLon = -180.0;
+        bounds.maxLon = east;
+        _query(bounds, level, features);
+    }
+
+    std::sort(features.begin(), features.end());
+    features.erase(std::unique(features.begin(), features.end()), features.end());
+    return features;
+}
+
+void KMLOverlayIndex::_query(const Bounds &bounds, int level, QList<int> &features) const
+{
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(static_cast<int>(_nodes.size()) - 1);
+
+    while (!stack.empty()) {
+        const Node &node = _nodes[stack.back()];
+        stack.pop_back();
+        if (!node.bounds.intersects(bounds)) {
+            continue;
+        }
+
+        for (int i = node.first; i < (node.first + node.count); i++) {
+            if (node.leaf) {
+                const Feature &feature = _features[_leafFeatures[i]];
+                if (feature.bounds.intersects(bounds) && _visibleAtLevel(feature, level)) {
+                    features.append(_leafFeatures[i]);
+                }
+            } else {
+                stack.push_back(_childNodes[i]);
+            }
+        }
+    }
+}
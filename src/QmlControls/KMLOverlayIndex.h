@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+
+#include <array>
+#include <vector>
+
+class QIODevice;
+
+/// Spatial index and level of detail geometry for the features of a KML/SHP map overlay.
+///
+/// KML is streamed with QXmlStreamReader so a large file is never held as a DOM. Once all features are added, build()
+/// simplifies every polyline and polygon once per level (each level simplifies the previous one) and bulk loads an
+/// R-tree (sort-tile-recursive) over the feature bounds. The map then asks only for the features which intersect the
+/// viewport, at the level for its zoom. Features smaller than the level tolerance (about a pixel) are left out.
+///
+/// Building is meant to run on a worker thread; a built index is read only and may be shared between threads.
+class KMLOverlayIndex
+{
+public:
+    enum class FeatureType {
+        Polyline,
+        Polygon,
+        Label
+    };
+
+    static constexpr int kLevelCount = 6;   ///< Level 0 is full resolution
+    static constexpr int kNodeCapacity = 16;
+
+    /// Douglas-Peucker tolerance in meters for each level
+    static constexpr std::array<double, kLevelCount> kLevelToleranceMeters = { 0, 2, 8, 32, 128, 512 };
+
+    /// Adds the LineString, Polygon (outer boundary) and named Point placemarks of a KML document
+    /// @return false if the document could not be parsed, features read up to the error are kept
+    bool loadKml(QIODevice *device, QString &errorString);
+    bool loadKmlFile(const QString &file, QString &errorString);
+
+    /// Adds the polygons or polylines of a SHP (or KML) file through ShapeFileHelper
+    bool loadShapeFile(const QString &file, QString &errorString);
+
+    /// @param path Vertices for polylines and polygons, a single coordinate for labels
+    void addFeature(FeatureType type, const QList<QGeoCoordinate> &path, const QString &text = QString());
+
+    /// Simplifies the features and builds the spatial index, call once after all features are added
+    void build();
+
+    int count() const { return static_cast<int>(_features.size()); }
+    bool isEmpty() const { return _features.empty(); }
+    qsizetype pointCount() const { return _pointCount; }
+
+    FeatureType type(int feature) const { return _features[feature].type; }
+    const QString &text(int feature) const { return _features[feature].text; }
+
+    /// @return Vertices of the feature at the level, the finest stored level at or below it
+    const QList<QGeoCoordinate> &path(int feature, int level) const;
+
+    /// @return Level whose tolerance stays below one screen pixel at the specified map zoom level
+    static int levelForZoom(double zoomLevel, double latitude);
+
+    /// @return Features intersecting @p viewport (plus a margin) which are not too small to see at the level, in
+    ///         ascending order. Invalid viewport: all features large enough for the level.
+    QList<int> query(const QGeoRectangle &viewport, int level = 0) const;
+
+private:
+    struct Bounds {
+        double minLat =  90;
+        double maxLat = -90;
+        double minLon =  180;
+        double maxLon = -180;
+
+        void unite(const Bounds &other);
+        bool intersects(const Bounds &other) const;
+    };
+
+    struct Feature {
+        FeatureType                                     type = FeatureType::Label;
+        QString                                         text;
+        Bounds                                          bounds;
+        double                                          sizeMeters = 0; ///< Diagonal of the bounds
+        std::array<QList<QGeoCoordinate>, kLevelCount>  levels;         ///< Empty: same as the previous level
+    };
+
+    struct Node {
+        Bounds  bounds;
+        int     first = 0;      ///< First entry of _leafFeatures for a leaf, of _childNodes otherwise
+        int     count = 0;
+        bool    leaf = true;
+    };
+
+    /// Orders @p ids into runs of kNodeCapacity which are compact in both latitude and longitude
+    template<typename BoundsOf>
+    static void _sortTileRecursive(std::vector<int> &ids, BoundsOf &&boundsOf);
+
+    static void _simplify(Feature &feature);
+    void _query(const Bounds &bounds, int level, QList<int> &features) const;
+    static bool _visibleAtLevel(const Feature &feature, int level);
+
+    std::vector<Feature> _features;
+    std::vector<Node> _nodes;           ///< Root is the last node
+    std::vector<int> _leafFeatures;     ///< Features in leaf order
+    std::vector<int> _childNodes;
+    qsizetype _pointCount = 0;
+};
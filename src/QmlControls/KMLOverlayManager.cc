@@ -8,14 +8,29 @@
  ****************************************************************************/
 
 #include "KMLOverlayManager.h"
-#include "QGCMapPolygon.h"
-#include "QGCMapPolyline.h"
+#include "KMLOverlayIndex.h"
+#include "QGCLoggingCategory.h"
 #include "ShapeFileHelper.h"
 
-#include <QtCore/QDebug>
-#include <QtCore/QFile>
-#include <QtCore/QRegularExpression>
-#include <QtXml/QDomDocument>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFuture>
+
+QGC_LOGGING_CATEGORY(KMLOverlayManagerLog, "QMLControls.KMLOverlayManager")
+
+namespace {
+
+QVariantList _toVariantList(const QList<QGeoCoordinate>& path)
+{
+    QVariantList list;
+    list.reserve(path.count());
+    for (const QGeoCoordinate& coord : path) {
+        list.append(QVariant::fromValue(coord));
+    }
+    return list;
+}
+
+} // namespace
 
 KMLOverlayManager::KMLOverlayManager(QObject* parent)
     : QObject(parent)
@@ -32,352 +47,188 @@ bool KMLOverlayManager::loadKML(const QString& filePath)
         return false;
     }
 
-    _currentFilePath = filePath;
-
-    // Clear existing overlays
+    // Clear existing overlays, this also drops the result of a load still in progress
     clearAll();
 
-    // Load all geometry types from KML/SHP file
-    bool hasGeometry = false;
-
-    if (filePath.endsWith(".kml", Qt::CaseInsensitive)) {
-        // For KML files, load all geometry types
-        hasGeometry |= loadPolylines(filePath);
-        hasGeometry |= loadPolygons(filePath);
-        hasGeometry |= loadLabels(filePath);
-    } else {
-        // For SHP files, use ShapeFileHelper to determine type
+    // Reject what can be told without parsing here, so callers get false instead of a later loadComplete(false).
+    // A SHP header is a few bytes, a KML file has to be parsed completely and so is only checked on the worker.
+    const QFileInfo fileInfo(filePath);
+    const bool isKml = (fileInfo.suffix().compare(QStringLiteral("kml"), Qt::CaseInsensitive) == 0);
+    const bool isShp = (fileInfo.suffix().compare(QStringLiteral("shp"), Qt::CaseInsensitive) == 0);
+    if (!fileInfo.isFile() || !fileInfo.isReadable() || (!isKml && !isShp)) {
+        qCWarning(KMLOverlayManagerLog) << "Not a readable KML/SHP file" << filePath;
+        return false;
+    }
+    if (isShp) {
         QString errorString;
-        ShapeFileHelper::ShapeType shapeType = ShapeFileHelper::determineShapeType(filePath, errorString);
-
-        if (!errorString.isEmpty()) {
-            qDebug() << "KMLOverlay: Error determining shape type:" << errorString;
+        if (ShapeFileHelper::determineShapeType(filePath, errorString) == ShapeFileHelper::ShapeType::Error) {
+            qCWarning(KMLOverlayManagerLog) << "Failed to load" << filePath << errorString;
             return false;
         }
-
-        switch (shapeType) {
-        case ShapeFileHelper::ShapeType::Polygon:
-            hasGeometry = loadPolygons(filePath);
-            break;
-        case ShapeFileHelper::ShapeType::Polyline:
-            hasGeometry = loadPolylines(filePath);
-            break;
-        case ShapeFileHelper::ShapeType::Error:
-        default:
-            qDebug() << "KMLOverlay: Unable to determine shape type";
-            break;
-        }
     }
 
-    return hasGeometry;
-}
-
-bool KMLOverlayManager::loadPolygons(const QString& filePath)
-{
-    if (filePath.endsWith(".kml", Qt::CaseInsensitive)) {
-        // Parse KML file to find all Polygon elements
-        QFile file(filePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "KMLOverlayManager: Failed to open file:" << filePath;
-            return false;
-        }
-
-        QDomDocument doc;
-        QByteArray xmlData = file.readAll();
-        file.close();
-
-        auto parseResult = doc.setContent(xmlData);
-        if (!parseResult) {
-            qDebug() << "KMLOverlayManager: XML parsing error:" << parseResult.errorMessage;
-            return false;
-        }
-
-        _polygons.clear();
-        int polygonCount = 0;
-
-        // Find all Polygon elements
-        QDomNodeList placemarks = doc.elementsByTagName("Placemark");
-        for (int i = 0; i < placemarks.count(); i++) {
-            QDomElement placemark = placemarks.item(i).toElement();
-            QDomElement polygon = placemark.firstChildElement("Polygon");
-
-            if (polygon.isNull()) {
-                continue;
-            }
-
-            // Parse outer boundary
-            QDomElement outerBoundary = polygon.firstChildElement("outerBoundaryIs");
-            if (outerBoundary.isNull()) {
-                continue;
-            }
-
-            QDomElement linearRing = outerBoundary.firstChildElement("LinearRing");
-            if (linearRing.isNull()) {
-                continue;
-            }
-
-            QDomElement coordinates = linearRing.firstChildElement("coordinates");
-            if (coordinates.isNull()) {
-                continue;
-            }
-
-            // Parse coordinates
-            QVariantList path;
-            QString coordText = coordinates.text().simplified();
-            QStringList coordPairs = coordText.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-
-            for (const QString& pair : coordPairs) {
-                QStringList parts = pair.split(",");
-                if (parts.count() >= 2) {
-                    bool lonOk, latOk;
-                    double longitude = parts[0].toDouble(&lonOk);
-                    double latitude = parts[1].toDouble(&latOk);
-
-                    if (lonOk && latOk) {
-                        QGeoCoordinate coord(latitude, longitude);
-                        if (coord.isValid()) {
-                            path.append(QVariant::fromValue(coord));
-                        }
-                    }
-                }
-            }
+    _currentFilePath = filePath;
+    const quint64 generation = ++_loadGeneration;
+    _setLoading(true);
 
-            if (!path.isEmpty()) {
-                QVariantMap polygonData;
-                polygonData["path"] = path;
-                _polygons.append(polygonData);
-                polygonCount++;
-            }
+    // Parsing, simplification and indexing all happen off the GUI thread
+    (void) QtConcurrent::run([filePath, isKml]() -> std::shared_ptr<const KMLOverlayIndex> {
+        auto index = std::make_shared<KMLOverlayIndex>();
+        QString errorString;
+        bool success;
+        if (isKml) {
+            success = index->loadKmlFile(filePath, errorString);
+        } else {
+            success = index->loadShapeFile(filePath, errorString);
         }
-
-        if (polygonCount > 0) {
-            qDebug() << "KMLOverlayManager: Successfully loaded" << polygonCount << "polygons";
-            emit polygonsChanged();
-            return true;
+        if (!success) {
+            qCWarning(KMLOverlayManagerLog) << "Failed to load" << filePath << errorString;
+            return nullptr;
         }
 
-        return false;
-    } else {
-        // For SHP files, use existing QGCMapPolygon loader
-        QGCMapPolygon polygon(this);
-        if (!polygon.loadKMLOrSHPFile(filePath)) {
-            return false;
+        index->build();
+        return index;
+    }).then(this, [this, generation, filePath](std::shared_ptr<const KMLOverlayIndex> index) {
+        if (generation != _loadGeneration) {
+            qCDebug(KMLOverlayManagerLog) << "Dropping stale load of" << filePath;
+            return;
         }
 
-        if (polygon.count() > 0) {
-            QVariantMap polygonData;
-            polygonData["path"] = polygon.path();
-            _polygons.append(polygonData);
-            qDebug() << "KMLOverlayManager: Successfully loaded polygon with" << polygon.count() << "vertices";
-            emit polygonsChanged();
-            return true;
+        _setLoading(false);
+        if (index && !index->isEmpty()) {
+            qCDebug(KMLOverlayManagerLog) << "Loaded" << index->count() << "features with" << index->pointCount() << "points from" << filePath;
+            _index = std::move(index);
+            _updateVisible(true /* force */);
         }
-    }
+        emit loadComplete(_index != nullptr);
+    });
 
-    return false;
+    return true;
 }
 
-bool KMLOverlayManager::loadPolylines(const QString& filePath)
+void KMLOverlayManager::clearAll()
 {
-    if (filePath.endsWith(".kml", Qt::CaseInsensitive)) {
-        // Parse KML file to find all LineString elements
-        QFile file(filePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "KMLOverlayManager: Failed to open file:" << filePath;
-            return false;
-        }
-
-        QDomDocument doc;
-        QByteArray xmlData = file.readAll();
-        file.close();
-
-        auto parseResult = doc.setContent(xmlData);
-        if (!parseResult) {
-            qDebug() << "KMLOverlayManager: XML parsing error:" << parseResult.errorMessage;
-            return false;
-        }
-
-        _polylines.clear();
-        int polylineCount = 0;
-
-        // Find all LineString elements
-        QDomNodeList placemarks = doc.elementsByTagName("Placemark");
-        for (int i = 0; i < placemarks.count(); i++) {
-            QDomElement placemark = placemarks.item(i).toElement();
-            QDomElement lineString = placemark.firstChildElement("LineString");
-
-            if (lineString.isNull()) {
-                continue;
-            }
-
-            QDomElement coordinates = lineString.firstChildElement("coordinates");
-            if (coordinates.isNull()) {
-                continue;
-            }
-
-            // Parse coordinates
-            QVariantList path;
-            QString coordText = coordinates.text().simplified();
-            QStringList coordPairs = coordText.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-
-            for (const QString& pair : coordPairs) {
-                QStringList parts = pair.split(",");
-                if (parts.count() >= 2) {
-                    bool lonOk, latOk;
-                    double longitude = parts[0].toDouble(&lonOk);
-                    double latitude = parts[1].toDouble(&latOk);
-
-                    if (lonOk && latOk) {
-                        QGeoCoordinate coord(latitude, longitude);
-                        if (coord.isValid()) {
-                            path.append(QVariant::fromValue(coord));
-                        }
-                    }
-                }
-            }
-
-            if (!path.isEmpty()) {
-                QVariantMap polylineData;
-                polylineData["path"] = path;
-                _polylines.append(polylineData);
-                polylineCount++;
-            }
-        }
-
-        if (polylineCount > 0) {
-            qDebug() << "KMLOverlayManager: Successfully loaded" << polylineCount << "polylines";
-            emit polylinesChanged();
-            return true;
-        }
+    _loadGeneration++;
+    _setLoading(false);
+    _index.reset();
+
+    _visibleLevel = -1;
+    _visiblePolylines.clear();
+    _visiblePolygons.clear();
+    _visibleLabels.clear();
+    _polylines.clear();
+    _polygons.clear();
+    _labels.clear();
+    _currentFilePath.clear();
 
-        return false;
-    } else {
-        // For SHP files, use existing QGCMapPolyline loader
-        QGCMapPolyline polyline(this);
-        if (!polyline.loadKMLOrSHPFile(filePath)) {
-            return false;
-        }
+    emit polylinesChanged();
+    emit polygonsChanged();
+    emit labelsChanged();
+}
 
-        if (polyline.count() > 0) {
-            QVariantMap polylineData;
-            polylineData["path"] = polyline.path();
-            _polylines.append(polylineData);
-            qDebug() << "KMLOverlayManager: Successfully loaded polyline with" << polyline.count() << "vertices";
-            emit polylinesChanged();
-            return true;
-        }
+void KMLOverlayManager::reload()
+{
+    if (!_currentFilePath.isEmpty()) {
+        loadKML(_currentFilePath);
     }
-
-    return false;
 }
 
-bool KMLOverlayManager::loadLabels(const QString& filePath)
+void KMLOverlayManager::setViewport(double zoomLevel, const QGeoShape& visibleRegion)
 {
-    // Only support KML files for labels
-    if (!filePath.endsWith(".kml", Qt::CaseInsensitive)) {
-        return false;
-    }
+    _zoomLevel = zoomLevel;
+    _viewport = visibleRegion.isValid() ? visibleRegion.boundingGeoRectangle() : QGeoRectangle();
+    _updateVisible();
+}
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "KMLOverlayManager: Failed to open file for label loading:" << filePath;
-        return false;
+void KMLOverlayManager::_setLoading(bool loading)
+{
+    if (loading != _loading) {
+        _loading = loading;
+        emit loadingChanged(_loading);
     }
+}
 
-    QDomDocument doc;
-    QByteArray xmlData = file.readAll();
-    file.close();
-
-    auto parseResult = doc.setContent(xmlData);
-    if (!parseResult) {
-        qDebug() << "KMLOverlayManager: XML parsing error:" << parseResult.errorMessage
-                 << "at line" << parseResult.errorLine << "column" << parseResult.errorColumn;
-        return false;
+void KMLOverlayManager::_updateVisible(bool force)
+{
+    if (!_index) {
+        return;
     }
 
-    _labels.clear();
-    int labelCount = 0;
-
-    // Find all Placemark elements with Point geometry
-    QDomNodeList placemarks = doc.elementsByTagName("Placemark");
-
-    for (int i = 0; i < placemarks.count(); i++) {
-        QDomElement placemark = placemarks.item(i).toElement();
-
-        // Check if this Placemark has a Point (not LineString or Polygon)
-        QDomElement point = placemark.firstChildElement("Point");
-        if (point.isNull()) {
-            continue;
-        }
-
-        // Get the name
-        QDomElement nameElement = placemark.firstChildElement("name");
-        if (nameElement.isNull()) {
-            continue;
-        }
-        QString name = nameElement.text().trimmed();
-        if (name.isEmpty()) {
-            continue;
-        }
-
-        // Get coordinates
-        QDomElement coordinatesElement = point.firstChildElement("coordinates");
-        if (coordinatesElement.isNull()) {
-            continue;
-        }
-
-        QString coordText = coordinatesElement.text().simplified();
-        QStringList coordParts = coordText.split(",");
-        if (coordParts.count() < 2) {
-            continue;
+    const double latitude = _viewport.isValid() ? _viewport.center().latitude() : 0;
+    const int level = KMLOverlayIndex::levelForZoom(_zoomLevel, latitude);
+    const bool levelChanged = force || (level != _visibleLevel);
+    _visibleLevel = level;
+
+    QList<int> polylines;
+    QList<int> polygons;
+    QList<int> labels;
+    for (const int feature : _index->query(_viewport, level)) {
+        switch (_index->type(feature)) {
+        case KMLOverlayIndex::FeatureType::Polyline:
+            polylines.append(feature);
+            break;
+        case KMLOverlayIndex::FeatureType::Polygon:
+            polygons.append(feature);
+            break;
+        case KMLOverlayIndex::FeatureType::Label:
+            labels.append(feature);
+            break;
         }
+    }
 
-        bool lonOk, latOk;
-        double longitude = coordParts[0].toDouble(&lonOk);
-        double latitude = coordParts[1].toDouble(&latOk);
-
-        if (!lonOk || !latOk) {
-            continue;
+    // Panning within the same set of features leaves the map items alone
+    if (levelChanged || (polylines != _visiblePolylines)) {
+        _visiblePolylines = polylines;
+        _polylines.clear();
+        _polylines.reserve(polylines.count());
+        for (const int feature : std::as_const(polylines)) {
+            QVariantMap polylineData;
+            polylineData["path"] = _toVariantList(_index->path(feature, level));
+            _polylines.append(polylineData);
         }
+        emit polylinesChanged();
+    }
 
-        QGeoCoordinate coord(latitude, longitude);
-        if (!coord.isValid()) {
-            continue;
+    if (levelChanged || (polygons != _visiblePolygons)) {
+        _visiblePolygons = polygons;
+        _polygons.clear();
+        _polygons.reserve(polygons.count());
+        for (const int feature : std::as_const(polygons)) {
+            QVariantMap polygonData;
+            polygonData["path"] = _toVariantList(_index->path(feature, level));
+            _polygons.append(polygonData);
         }
-
-        // Create label data as QVariantMap
-        QVariantMap label;
-        label["coordinate"] = QVariant::fromValue(coord);
-        label["text"] = name;
-
-        _labels.append(label);
-        labelCount++;
+        emit polygonsChanged();
     }
 
-    if (labelCount > 0) {
-        qDebug() << "KMLOverlayManager: Successfully loaded" << labelCount << "labels";
+    if (force || (labels != _visibleLabels)) {
+        _visibleLabels = labels;
+        _labels.clear();
+        _labels.reserve(labels.count());
+        for (const int feature : std::as_const(labels)) {
+            QVariantMap label;
+            label["coordinate"] = QVariant::fromValue(_index->path(feature, 0).first());
+            label["text"] = _index->text(feature);
+            _labels.append(label);
+        }
         emit labelsChanged();
-        return true;
     }
 
-    return false;
+    qCDebug(KMLOverlayManagerLog) << "Showing" << polylines.count() << "polylines" << polygons.count() << "polygons" << labels.count() << "labels at level" << level;
 }
 
-void KMLOverlayManager::clearAll()
+int KMLOverlayManager::visiblePointCount() const
 {
-    _polylines.clear();
-    _polygons.clear();
-    _labels.clear();
-    _currentFilePath.clear();
-
-    emit polylinesChanged();
-    emit polygonsChanged();
-    emit labelsChanged();
-}
+    if (!_index) {
+        return 0;
+    }
 
-void KMLOverlayManager::reload()
-{
-    if (!_currentFilePath.isEmpty()) {
-        loadKML(_currentFilePath);
+    qsizetype count = _visibleLabels.count();
+    for (const int feature : _visiblePolylines) {
+        count += _index->path(feature, _visibleLevel).count();
+    }
+    for (const int feature : _visiblePolygons) {
+        count += _index->path(feature, _visibleLevel).count();
     }
+    return static_cast<int>(count);
 }
@@ -13,10 +13,19 @@
 #include <QtCore/QVariantList>
 #include <QtCore/QVariantMap>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/QGeoShape>
 #include <QtQml/QQmlEngine>
 
+#include <memory>
+
+class KMLOverlayIndex;
+
 /// KML/SHP overlay manager for FlightMap
 /// Manages loading and displaying KML/SHP files on the map
+///
+/// Files are parsed and indexed by KMLOverlayIndex on a worker thread. The overlay lists only hold the features which
+/// intersect the map viewport, simplified for the map zoom, and only change when that set or the detail level does.
 class KMLOverlayManager : public QObject
 {
     Q_OBJECT
@@ -25,6 +34,7 @@ class KMLOverlayManager : public QObject
     Q_PROPERTY(QVariantList polylines READ polylines NOTIFY polylinesChanged)
     Q_PROPERTY(QVariantList polygons READ polygons NOTIFY polygonsChanged)
     Q_PROPERTY(QVariantList labels READ labels NOTIFY labelsChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
 
 public:
     explicit KMLOverlayManager(QObject* parent = nullptr);
@@ -34,10 +44,11 @@ class KMLOverlayManager : public QObject
     QVariantList polylines() const { return _polylines; }
     QVariantList polygons() const { return _polygons; }
     QVariantList labels() const { return _labels; }
+    bool loading() const { return _loading; }
 
-    /// Load KML/SHP file and display on map
+    /// Load KML/SHP file and display on map. Loading completes asynchronously, see loadComplete().
     /// @param filePath Path to KML or SHP file
-    /// @return true if loaded successfully
+    /// @return false if the file is missing, not KML/SHP or an unusable SHP file, loadComplete() is not emitted then
     Q_INVOKABLE bool loadKML(const QString& filePath);
 
     /// Clear all overlay items from map
@@ -46,15 +57,36 @@ class KMLOverlayManager : public QObject
     /// Reload current file (useful after settings change)
     Q_INVOKABLE void reload();
 
+    /// Restricts the overlay to the map viewport
+    /// @param zoomLevel Map zoom level, selects the detail level
+    /// @param visibleRegion Map visible region, invalid to show features everywhere
+    Q_INVOKABLE void setViewport(double zoomLevel, const QGeoShape& visibleRegion);
+
+    /// @return Number of coordinates currently handed to the map, used by tests and benchmarks
+    int visiblePointCount() const;
+
 signals:
     void polylinesChanged();
     void polygonsChanged();
     void labelsChanged();
+    void loadingChanged(bool loading);
+    /// @param success false if the file could not be loaded or holds no geometry
+    void loadComplete(bool success);
 
 private:
-    bool loadPolygons(const QString& filePath);
-    bool loadPolylines(const QString& filePath);
-    bool loadLabels(const QString& filePath);
+    void _setLoading(bool loading);
+    void _updateVisible(bool force = false);
+
+    std::shared_ptr<const KMLOverlayIndex> _index;
+    quint64 _loadGeneration = 0;
+    bool _loading = false;
+
+    double _zoomLevel = 0;
+    QGeoRectangle _viewport;
+    int _visibleLevel = -1;
+    QList<int> _visiblePolylines;  // Feature indices of the current lists
+    QList<int> _visiblePolygons;
+    QList<int> _visibleLabels;
 
     QVariantList _polylines;   // List of polyline objects, each with {path: [...]}
     QVariantList _polygons;    // List of polygon objects, each with {path: [...]}
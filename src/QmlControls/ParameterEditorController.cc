@@ -88,29 +88,60 @@ void ParameterTableModel::append(Fact* fact)
     insert(rowCount(), fact);
 }
 
-void ParameterTableModel::insert(int row, Fact* fact)
+ParameterTableModel::ColumnData ParameterTableModel::_columnData(Fact* fact) const
 {
-    if (row < 0 || row > rowCount()) {
-        qWarning() << "Invalid row row:rowCount" << row << rowCount() << Q_FUNC_INFO;
-        row = qMax(qMin(row, rowCount()), 0);
-    }
-
     ColumnData colData(_tableViewColCount, QString());
     colData[FavColumn] = QString();
     colData[NameColumn] = fact->name();
     colData[ValueColumn] = QVariant::fromValue(fact);
     colData[DescriptionColumn] = fact->shortDescription();
+    return colData;
+}
+
+void ParameterTableModel::insert(int row, Fact* fact)
+{
+    insert(row, QList<Fact*>{ fact });
+}
+
+void ParameterTableModel::insert(int row, const QList<Fact*>& facts)
+{
+    if (facts.isEmpty()) {
+        return;
+    }
+    if (row < 0 || row > rowCount()) {
+        qWarning() << "Invalid row row:rowCount" << row << rowCount() << Q_FUNC_INFO;
+        row = qMax(qMin(row, rowCount()), 0);
+    }
 
     if (!_isResetting()) {
-        beginInsertRows(QModelIndex(), row, row);
+        beginInsertRows(QModelIndex(), row, row + facts.count() - 1);
+    }
+    for (int i=0; i<facts.count(); i++) {
+        _tableData.insert(row + i, _columnData(facts[i]));
     }
-    _tableData.insert(row, colData);
     if (!_isResetting()) {
         endInsertRows();
         emit rowCountChanged(rowCount());
     }
 }
 
+void ParameterTableModel::remove(int row, int count)
+{
+    if (row < 0 || count <= 0 || row + count > rowCount()) {
+        qWarning() << "Invalid row range row:count:rowCount" << row << count << rowCount() << Q_FUNC_INFO;
+        return;
+    }
+
+    if (!_isResetting()) {
+        beginRemoveRows(QModelIndex(), row, row + count - 1);
+    }
+    _tableData.remove(row, count);
+    if (!_isResetting()) {
+        endRemoveRows();
+        emit rowCountChanged(rowCount());
+    }
+}
+
 void ParameterTableModel::beginReset()
 {
     _resetNestingCount++;
@@ -157,6 +188,7 @@ ParameterEditorController::ParameterEditorController(QObject *parent)
     // qCDebug(ParameterEditorControllerLog) << Q_FUNC_INFO << this;
 
     _buildLists();
+    _buildSearchIndex();
 
     _searchTimer.setSingleShot(true);
     _searchTimer.setInterval(300);
@@ -274,6 +306,9 @@ void ParameterEditorController::_buildLists(void)
 
 void ParameterEditorController::_factAdded(int compId, Fact* fact)
 {
+    // Rebuilt on the next search so new facts keep their place in parameter order
+    _searchIndexDirty = true;
+
     if (_hideReadOnly && fact->readOnly()) {
         return;
     }
@@ -563,58 +598,61 @@ void ParameterEditorController::_hideReadOnlyChanged(void)
     }
 }
 
-void ParameterEditorController::_performSearch(void)
+void ParameterEditorController::_buildSearchIndex(void)
 {
-    QObjectList newParameterList;
+    _searchIndex.clear();
+    for (int compId : _parameterMgr->componentIds()) {
+        for (const QString &paraName: _parameterMgr->parameterNames(compId)) {
+            (void) _searchIndex.addFact(_parameterMgr->getParameter(compId, paraName));
+        }
+    }
+    _searchIndexDirty = false;
+
+    // Previous results refer to entries of the old index
+    _lastSearchValid = false;
+    _lastSearchTerms.clear();
+    _lastSearchMatches.clear();
+    _searchParameterEntries.clear();
+    _searchParameters.clear();
 
+    qCDebug(ParameterEditorControllerLog) << "Search index built for" << _searchIndex.count() << "parameters";
+}
+
+void ParameterEditorController::_performSearch(void)
+{
     QStringList rgSearchStrings = _searchText.split(' ', Qt::SkipEmptyParts);
 
     if (rgSearchStrings.isEmpty() && !_showModifiedOnly && !_showFavoritesOnly) {
         ParameterEditorCategory* category = _categories.count() ? _categories.value<ParameterEditorCategory*>(0) : nullptr;
         setCurrentCategory(category);
         _searchParameters.clear();
+        _searchParameterEntries.clear();
+        _lastSearchValid = false;
     } else {
-        QVector<QRegularExpression> regexList;
-        regexList.reserve(rgSearchStrings.size());
-        for (const QString &searchItem : rgSearchStrings) {
-            QRegularExpression re(searchItem, QRegularExpression::CaseInsensitiveOption);
-            regexList.append(re.isValid() ? re : QRegularExpression());
+        if (_searchIndexDirty) {
+            _buildSearchIndex();
         }
 
-        _searchParameters.beginReset();
-        _searchParameters.clear();
-
-        for (int compId : _parameterMgr->componentIds()) {
-            for (const QString &paraName: _parameterMgr->parameterNames(compId)) {
-                Fact* fact = _parameterMgr->getParameter(compId, paraName);
-                bool matched = _shouldShow(fact);
-                // All of the search items must match in order for the parameter to be added to the list
-                if (matched) {
-                    for (int i = 0; i < rgSearchStrings.size(); ++i) {
-                        const QRegularExpression &re = regexList.at(i);
-                        if (re.isValid()) {
-                            if (!fact->name().contains(re) &&
-                                    !fact->shortDescription().contains(re) &&
-                                    !fact->longDescription().contains(re)) {
-                                matched = false;
-                            }
-                        } else {
-                            const QString &searchItem = rgSearchStrings.at(i);
-                            if (!fact->name().contains(searchItem, Qt::CaseInsensitive) &&
-                                    !fact->shortDescription().contains(searchItem, Qt::CaseInsensitive) &&
-                                    !fact->longDescription().contains(searchItem, Qt::CaseInsensitive)) {
-                                matched = false;
-                            }
-                        }
-                    }
-                }
-                if (matched) {
-                    _searchParameters.append(fact);
-                }
+        // Extending the previous query can only remove matches, so only the previous matches need to be checked
+        QList<int> matches;
+        if (_lastSearchValid && ParameterSearchIndex::narrows(rgSearchStrings, _lastSearchTerms)) {
+            matches = _searchIndex.search(rgSearchStrings, &_lastSearchMatches);
+        } else {
+            matches = _searchIndex.search(rgSearchStrings);
+        }
+        _lastSearchTerms = rgSearchStrings;
+        _lastSearchMatches = matches;
+        _lastSearchValid = true;
+
+        QList<int> visibleEntries;
+        visibleEntries.reserve(matches.count());
+        for (int entry : std::as_const(matches)) {
+            if (_shouldShow(_searchIndex.fact(entry))) {
+                visibleEntries.append(entry);
             }
         }
 
-        _searchParameters.endReset();
+        _setSearchResults(visibleEntries);
 
         if (_parameters != &_searchParameters) {
             _parameters = &_searchParameters;
@@ -626,6 +664,54 @@ void ParameterEditorController::_performSearch(void)
     }
 }
 
+void ParameterEditorController::_setSearchResults(const QList<int>& entries)
+{
+    QList<Fact*> facts;
+
+    if (_parameters != &_searchParameters) {
+        // Not on screen, nothing to preserve
+        facts.reserve(entries.count());
+        for (int entry : entries) {
+            facts.append(_searchIndex.fact(entry));
+        }
+        _searchParameters.beginReset();
+        _searchParameters.clear();
+        _searchParameters.insert(0, facts);
+        _searchParameters.endReset();
+        _searchParameterEntries = entries;
+        return;
+    }
+
+    // Both lists are in index order: walk them together and turn the differences into row removals and insertions,
+    // so the view keeps its position and delegates for the rows which stay
+    const QList<int> oldEntries = _searchParameterEntries;
+    int row = 0;
+    int oldIndex = 0;
+    int newIndex = 0;
+    while (oldIndex < oldEntries.count() || newIndex < entries.count()) {
+        if (newIndex == entries.count() || (oldIndex < oldEntries.count() && oldEntries[oldIndex] < entries[newIndex])) {
+            int count = 0;
+            while (oldIndex + count < oldEntries.count() && (newIndex == entries.count() || oldEntries[oldIndex + count] < entries[newIndex])) {
+                count++;
+            }
+            _searchParameters.remove(row, count);
+            oldIndex += count;
+        } else if (oldIndex == oldEntries.count() || entries[newIndex] < oldEntries[oldIndex]) {
+            facts.clear();
+            while (newIndex < entries.count() && (oldIndex == oldEntries.count() || entries[newIndex] < oldEntries[oldIndex])) {
+                facts.append(_searchIndex.fact(entries[newIndex++]));
+            }
+            _searchParameters.insert(row, facts);
+            row += facts.count();
+        } else {
+            row++;
+            oldIndex++;
+            newIndex++;
+        }
+    }
+    _searchParameterEntries = entries;
+}
+
 void ParameterEditorController::_currentCategoryChanged(void)
 {
     ParameterEditorGroup* group = nullptr;
@@ -7,6 +7,7 @@
 #include "FactPanelController.h"
 #include "QmlObjectListModel.h"
 #include "FactMetaData.h"
+#include "ParameterSearchIndex.h"
 
 class ParameterManager;
 
@@ -35,6 +36,8 @@ class ParameterTableModel : public QAbstractTableModel
 
     void append      (Fact* fact);
     void insert      (int row, Fact* fact);
+    void insert      (int row, const QList<Fact*>& facts);
+    void remove      (int row, int count);
     void clear       ();
     void beginReset  (); ///< Supports nesting - only outermost call has effect
     void endReset    (); ///< Supports nesting - only outermost call has effect
@@ -52,6 +55,7 @@ class ParameterTableModel : public QAbstractTableModel
 
 private:
     bool _isResetting() const { return _resetNestingCount > 0; }
+    ColumnData _columnData(Fact* fact) const;
 
     int                 _tableViewColCount = 4;
     QList<ColumnData>   _tableData;
@@ -187,7 +191,9 @@ private slots:
 
 private:
     bool _shouldShow(Fact *fact) const;
+    void _buildSearchIndex();
     void _performSearch();
+    void _setSearchResults(const QList<int>& entries);
     void _loadFavorites();
     void _saveFavorites();
 
@@ -208,6 +214,12 @@ private slots:
     QmlObjectListModel          _categories;
     QmlObjectListModel          _diffList;
     ParameterTableModel         _searchParameters;
+    ParameterSearchIndex        _searchIndex;
+    bool                        _searchIndexDirty       = true;
+    bool                        _lastSearchValid        = false;
+    QStringList                 _lastSearchTerms;
+    QList<int>                  _lastSearchMatches;                     ///< Index entries matching _lastSearchTerms, before _shouldShow
+    QList<int>                  _searchParameterEntries;                ///< Index entry of each row in _searchParameters
     QAbstractTableModel*        _parameters             = nullptr;
     QMap<QString, ParameterEditorCategory*> _mapCategoryName2Category;
 };
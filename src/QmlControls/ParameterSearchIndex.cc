@@ -0,0 +1,181 @@
+#include "ParameterSearchIndex.h"
+#include "Fact.h"
+
+#include <algorithm>
+#include <iterator>
+
+void ParameterSearchIndex::clear()
+{
+    _entries.clear();
+    _trigrams.clear();
+}
+
+int ParameterSearchIndex::addFact(Fact *fact)
+{
+    const int entryIndex = count();
+
+    QStringList fields = { fact->name(), fact->shortDescription(), fact->longDescription() };
+    fields.append(fact->enumStrings());
+    fields.append(fact->bitmaskStrings());
+
+    Entry entry;
+    entry.fact = fact;
+    entry.text = fields.join(QLatin1Char('\n')).toLower();
+
+    const QChar *const chars = entry.text.constData();
+    for (qsizetype i = 0; (i + 2) < entry.text.size(); i++) {
+        QList<int> &postings = _trigrams[_trigramKey(&chars[i])];
+        // Entries are added in order, so a repeated trigram of this entry is always the last posting
+        if (postings.isEmpty() || (postings.constLast() != entryIndex)) {
+            postings.append(entryIndex);
+        }
+    }
+
+    _entries.append(entry);
+    return entryIndex;
+}
+
+bool ParameterSearchIndex::isPlainText(const QString &term)
+{
+    static const QString regexSyntax = QStringLiteral("\\^$.|?*+()[]{}");
+    for (const QChar c : term) {
+        if (regexSyntax.contains(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParameterSearchIndex::narrows(const QStringList &terms, const QStringList &previousTerms)
+{
+    for (const QString &previousTerm : previousTerms) {
+        if (!isPlainText(previousTerm)) {
+            return false;
+        }
+
+        bool extended = false;
+        for (const QString &term : terms) {
+            if (isPlainText(term) && term.contains(previousTerm, Qt::CaseInsensitive)) {
+                extended = true;
+                break;
+            }
+        }
+        if (!extended) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ParameterSearchIndex::Term ParameterSearchIndex::_compileTerm(const QString &term)
+{
+    Term compiled;
+    if (!isPlainText(term)) {
+        // Each field is a line, anchors match at the start and end of a field as they did on the fields themselves
+        compiled.regex = QRegularExpression(term, QRegularExpression::CaseInsensitiveOption | QRegularExpression::MultilineOption);
+        if (compiled.regex.isValid()) {
+            return compiled;
+        }
+    }
+
+    // Plain text, or an invalid expression which is matched as plain text
+    compiled.text = term.toLower();
+    return compiled;
+}
+
+bool ParameterSearchIndex::_matches(const Entry &entry, const Term &term)
+{
+    return term.text.isEmpty() ? entry.text.contains(term.regex) : entry.text.contains(term.text);
+}
+
+bool ParameterSearchIndex::_trigramCandidates(const QString &text, QList<int> &candidates) const
+{
+    if (text.size() < 3) {
+        return false;
+    }
+
+    candidates.clear();
+    const QChar *const chars = text.constData();
+    for (qsizetype i = 0; (i + 2) < text.size(); i++) {
+        const auto it = _trigrams.constFind(_trigramKey(&chars[i]));
+        if (it == _trigrams.constEnd()) {
+            candidates.clear();
+            return true;
+        }
+
+        if (i == 0) {
+            candidates = it.value();
+        } else {
+            QList<int> intersection;
+            intersection.reserve(qMin(candidates.size(), it.value().size()));
+            std::set_intersection(candidates.cbegin(), candidates.cend(), it.value().cbegin(), it.value().cend(),
+                                  std::back_inserter(intersection));
+            candidates = std::move(intersection);
+        }
+
+        if (candidates.isEmpty()) {
+            return true;
+        }
+    }
+    return true;
+}
+
+QList<int> ParameterSearchIndex::search(const QStringList &terms, const QList<int> *candidates) const
+{
+    QList<Term> compiledTerms;
+    compiledTerms.reserve(terms.size());
+    for (const QString &term : terms) {
+        compiledTerms.append(_compileTerm(term));
+    }
+
+    // A narrowed search verifies its few candidates directly, otherwise the trigrams of the plain text terms pick
+    // the candidates
+    QList<int> indexCandidates;
+    bool haveIndexCandidates = false;
+    if (!candidates) {
+        QList<int> termCandidates;
+        for (const Term &term : std::as_const(compiledTerms)) {
+            if (term.text.isEmpty() || !_trigramCandidates(term.text, termCandidates)) {
+                continue;
+            }
+
+            if (!haveIndexCandidates) {
+                indexCandidates = std::move(termCandidates);
+                haveIndexCandidates = true;
+            } else {
+                QList<int> intersection;
+                std::set_intersection(indexCandidates.cbegin(), indexCandidates.cend(), termCandidates.cbegin(), termCandidates.cend(),
+                                      std::back_inserter(intersection));
+                indexCandidates = std::move(intersection);
+            }
+        }
+        if (haveIndexCandidates) {
+            candidates = &indexCandidates;
+        }
+    }
+
+    const auto matchesAll = [&compiledTerms](const Entry &entry) {
+        for (const Term &term : compiledTerms) {
+            if (!_matches(entry, term)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    QList<int> result;
+    if (candidates) {
+        for (const int entryIndex : *candidates) {
+            if ((entryIndex >= 0) && (entryIndex < count()) && matchesAll(_entries[entryIndex])) {
+                result.append(entryIndex);
+            }
+        }
+    } else {
+        for (int entryIndex = 0; entryIndex < count(); entryIndex++) {
+            if (matchesAll(_entries[entryIndex])) {
+                result.append(entryIndex);
+            }
+        }
+    }
+    return result;
+}
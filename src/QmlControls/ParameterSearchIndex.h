@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class Fact;
+
+/// Text index over the parameters shown by the parameter editor.
+///
+/// Each fact is indexed by its lower-cased name, short and long description and enum/bitmask labels. Search terms
+/// are regular expressions like the editor always accepted, but most terms are plain text: those are looked up in a
+/// trigram index and only the candidate entries are verified, the remaining terms are matched against the text of
+/// each candidate. Results are entry indices in the order the facts were added.
+class ParameterSearchIndex
+{
+public:
+    void clear();
+    /// @return Entry index of @p fact
+    int addFact(Fact *fact);
+
+    int count() const { return static_cast<int>(_entries.count()); }
+    Fact *fact(int entry) const { return _entries[entry].fact; }
+
+    /// Entries which match all @p terms, in entry order.
+    /// @param candidates Sorted entries to restrict the search to, e.g. the result of a query this one narrows
+    QList<int> search(const QStringList &terms, const QList<int> *candidates = nullptr) const;
+
+    /// @return true if @p term has no regular expression syntax and is matched as plain text
+    static bool isPlainText(const QString &term);
+    /// @return true if everything @p terms matches is also matched by @p previousTerms, so the previous result can
+    /// be narrowed instead of searching again
+    static bool narrows(const QStringList &terms, const QStringList &previousTerms);
+
+private:
+    struct Entry {
+        Fact *fact = nullptr;
+        QString text;   ///< Lower-cased searchable fields, one per line
+    };
+
+    struct Term {
+        QString text;               ///< Lower-cased plain text, empty for a regular expression
+        QRegularExpression regex;
+    };
+
+    static Term _compileTerm(const QString &term);
+    static bool _matches(const Entry &entry, const Term &term);
+    /// Sorted entries which contain all trigrams of @p text. @return false if @p text is too short to have any
+    bool _trigramCandidates(const QString &text, QList<int> &candidates) const;
+
+    static constexpr quint64 _trigramKey(const QChar *chars)
+    {
+        return (static_cast<quint64>(chars[0].unicode()) << 32) | (static_cast<quint64>(chars[1].unicode()) << 16) | chars[2].unicode();
+    }
+
+    QList<Entry> _entries;
+    QHash<quint64, QList<int>> _trigrams;   ///< Trigram to sorted entries containing it
+};
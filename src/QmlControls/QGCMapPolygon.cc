@@ -6,12 +6,16 @@
 #include "AppMessages.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
+#include "PlanViewSettings.h"
+#include "SettingsManager.h"
 #include "ShapeFileHelper.h"
 #include "KMLDomDocument.h"
 
 #include <QtCore/QLineF>
 #include <QMetaMethod>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(QGCMapPolygonLog, "QMLControls.QGCMapPolygon")
 
 QGCMapPolygon::QGCMapPolygon(QObject* parent)
@@ -46,8 +50,10 @@ void QGCMapPolygon::_init(void)
     connect(&_polygonModel, &QmlObjectListModel::dirtyChanged, this, &QGCMapPolygon::_polygonModelDirtyChanged);
     connect(&_polygonModel, &QmlObjectListModel::countChanged, this, &QGCMapPolygon::_polygonModelCountChanged);
     connect(&_polygonModel, &QmlObjectListModel::modelReset, this, [this]() {
-        emit pathChanged();
-        emit centerChanged(_center);
+        if (!_updatingHandleRegion) {
+            emit pathChanged();
+            emit centerChanged(_center);
+        }
     });
 
     connect(this, &QGCMapPolygon::pathChanged,  this, &QGCMapPolygon::_updateCenter);
@@ -60,12 +66,7 @@ const QGCMapPolygon& QGCMapPolygon::operator=(const QGCMapPolygon& other)
 {
     clear();
 
-    QVariantList vertices = other.path();
-    QList<QGeoCoordinate> rgCoord;
-    for (const QVariant& vertexVar: vertices) {
-        rgCoord.append(vertexVar.value<QGeoCoordinate>());
-    }
-    appendVertices(rgCoord);
+    appendVertices(other.coordinateList());
 
     setDirty(true);
 
@@ -75,8 +76,9 @@ const QGCMapPolygon& QGCMapPolygon::operator=(const QGCMapPolygon& other)
 void QGCMapPolygon::clear(void)
 {
     // Bug workaround, see below
-    while (_polygonPath.count() > 1) {
-        _polygonPath.takeLast();
+    if (_coordinates.count() > 1) {
+        _coordinates.resize(1);
+        _pathCacheValid = false;
     }
     if (_vertexDrag) {
         emit dragPathChanged();
@@ -88,8 +90,11 @@ void QGCMapPolygon::clear(void)
     // to be a bug in QGCMapPolygon which causes it to not be redrawn if the list is empty. So
     // we work around it by using the code above to remove all but the last point which in turn
     // will cause the polygon to go away.
-    _polygonPath.clear();
+    _coordinates.clear();
+    _pathCacheValid = false;
 
+    _handleVertices.clear();
+    _allHandles = true;
     _polygonModel.clearAndDeleteContents();
 
     emit cleared();
@@ -99,8 +104,14 @@ void QGCMapPolygon::clear(void)
 
 void QGCMapPolygon::adjustVertex(int vertexIndex, const QGeoCoordinate coordinate)
 {
-    _polygonPath[vertexIndex] = QVariant::fromValue(coordinate);
-    _polygonModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    _coordinates[vertexIndex] = coordinate;
+    if (_pathCacheValid) {
+        _pathCache[vertexIndex] = QVariant::fromValue(coordinate);
+    }
+    const int handleIndex = _handleIndex(vertexIndex);
+    if (handleIndex >= 0) {
+        _polygonModel.value<QGCQGeoCoordinate*>(handleIndex)->setCoordinate(coordinate);
+    }
     if (!_centerDrag) {
         if (!_deferredPathChanged) {
             _deferredPathChanged = true;
@@ -136,8 +147,8 @@ QGeoCoordinate QGCMapPolygon::_coordFromPointF(const QPointF& point) const
 {
     QGeoCoordinate coord;
 
-    if (_polygonPath.count() > 0) {
-        QGeoCoordinate tangentOrigin = _polygonPath[0].value<QGeoCoordinate>();
+    if (_coordinates.count() > 0) {
+        QGeoCoordinate tangentOrigin = _coordinates[0];
         QGCGeo::convertNedToGeo(-point.y(), point.x(), 0, tangentOrigin, coord);
     }
 
@@ -146,9 +157,9 @@ QGeoCoordinate QGCMapPolygon::_coordFromPointF(const QPointF& point) const
 
 QPointF QGCMapPolygon::_pointFFromCoord(const QGeoCoordinate& coordinate) const
 {
-    if (_polygonPath.count() > 0) {
+    if (_coordinates.count() > 0) {
         double y, x, down;
-        QGeoCoordinate tangentOrigin = _polygonPath[0].value<QGeoCoordinate>();
+        QGeoCoordinate tangentOrigin = _coordinates[0];
 
         QGCGeo::convertGeoToNed(coordinate, tangentOrigin, y, x, down);
         return QPointF(x, -y);
@@ -161,9 +172,12 @@ QPolygonF QGCMapPolygon::_toPolygonF(void) const
 {
     QPolygonF polygon;
 
-    if (_polygonPath.count() > 2) {
-        for (int i=0; i<_polygonPath.count(); i++) {
-            polygon.append(_pointFFromCoord(_polygonPath[i].value<QGeoCoordinate>()));
+    if (_coordinates.count() > 2) {
+        // One tangent plane setup for all vertices instead of one per vertex
+        const QList<QPointF> ned = QGCGeo::convertGeoToNed(_coordinates, _coordinates[0]);
+        polygon.reserve(ned.count());
+        for (const QPointF& northEast: ned) {
+            polygon.append(QPointF(northEast.y(), -northEast.x()));
         }
     }
 
@@ -172,7 +186,7 @@ QPolygonF QGCMapPolygon::_toPolygonF(void) const
 
 bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
 {
-    if (_polygonPath.count() > 2) {
+    if (_coordinates.count() > 2) {
         return _toPolygonF().containsPoint(_pointFFromCoord(coordinate), Qt::OddEvenFill);
     } else {
         return false;
@@ -181,12 +195,9 @@ bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
 
 void QGCMapPolygon::setPath(const QList<QGeoCoordinate>& path)
 {
-    _polygonPath.clear();
-    _polygonModel.clearAndDeleteContents();
-    for(const QGeoCoordinate& coord: path) {
-        _polygonPath.append(QVariant::fromValue(coord));
-        _polygonModel.append(new QGCQGeoCoordinate(coord, this));
-    }
+    _coordinates = path;
+    _pathCacheValid = false;
+    _resetHandles();
 
     setDirty(true);
     emit pathChanged();
@@ -194,22 +205,194 @@ void QGCMapPolygon::setPath(const QList<QGeoCoordinate>& path)
 
 void QGCMapPolygon::setPath(const QVariantList& path)
 {
-    _polygonPath = path;
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(path.count());
+    for (const QVariant& varCoord: path) {
+        coordinates.append(varCoord.value<QGeoCoordinate>());
+    }
+    setPath(coordinates);
+}
+
+QVariantList QGCMapPolygon::path(void) const
+{
+    if (!_pathCacheValid) {
+        _pathCache.clear();
+        _pathCache.reserve(_coordinates.count());
+        for (const QGeoCoordinate& coord: _coordinates) {
+            _pathCache.append(QVariant::fromValue(coord));
+        }
+        _pathCacheValid = true;
+    }
+
+    return _pathCache;
+}
+
+int QGCMapPolygon::_handleIndex(int vertexIndex) const
+{
+    if (_allHandles) {
+        return vertexIndex;
+    }
+
+    const auto it = std::lower_bound(_handleVertices.cbegin(), _handleVertices.cend(), vertexIndex);
+    if ((it != _handleVertices.cend()) && (*it == vertexIndex)) {
+        return static_cast<int>(it - _handleVertices.cbegin());
+    }
+    return -1;
+}
+
+int QGCMapPolygon::handleVertex(int handleIndex) const
+{
+    if (_allHandles) {
+        return handleIndex;
+    }
+
+    if (handleIndex >= 0 && handleIndex < _handleVertices.count()) {
+        return _handleVertices[handleIndex];
+    }
+    return -1;
+}
 
+void QGCMapPolygon::_rebuildHandles(void)
+{
     _polygonModel.clearAndDeleteContents();
-    for (int i=0; i<_polygonPath.count(); i++) {
-        _polygonModel.append(new QGCQGeoCoordinate(_polygonPath[i].value<QGeoCoordinate>(), this));
+    _handleVertices.clear();
+    _regionVertexCount = 0;
+    _allHandles = count() <= maxVertexHandles;
+
+    QList<QObject*> objects;
+    if (_allHandles) {
+        for (const QGeoCoordinate& coord: std::as_const(_coordinates)) {
+            objects.append(new QGCQGeoCoordinate(coord, this));
+        }
+    } else if (_handleRegion.isValid()) {
+        for (int i=0; i<_coordinates.count(); i++) {
+            if (_handleRegion.contains(_coordinates[i])) {
+                _handleVertices.append(i);
+            }
+        }
+        _regionVertexCount = static_cast<int>(_handleVertices.count());
+        if (_regionVertexCount > maxVertexHandles) {
+            // Too dense to drag at this zoom, the user has to zoom in first
+            _handleVertices.clear();
+        }
+        for (int vertexIndex: std::as_const(_handleVertices)) {
+            objects.append(new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        }
+    }
+
+    if (!objects.isEmpty()) {
+        _polygonModel.append(objects);
+    }
+}
+
+void QGCMapPolygon::_resetHandles(void)
+{
+    beginReset();
+    _rebuildHandles();
+    endReset();
+}
+
+void QGCMapPolygon::_insertVertexHandle(int vertexIndex)
+{
+    if (_handlesInPlace()) {
+        _polygonModel.insert(vertexIndex, new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        return;
+    }
+    if (_allHandles) {
+        // Just grew past maxVertexHandles, from now on only the handle region has handles
+        _resetHandles();
+        return;
     }
 
+    // Only the new vertex can gain a handle, the ones after it just move up
+    const auto it = std::lower_bound(_handleVertices.begin(), _handleVertices.end(), vertexIndex);
+    const int handleIndex = static_cast<int>(it - _handleVertices.begin());
+    for (auto shift = it; shift != _handleVertices.end(); shift++) {
+        (*shift)++;
+    }
+
+    _updatingHandleRegion = true;
+    if (_handleRegion.isValid() && _handleRegion.contains(_coordinates[vertexIndex])) {
+        _regionVertexCount++;
+        if (_regionVertexCount <= maxVertexHandles) {
+            _handleVertices.insert(handleIndex, vertexIndex);
+            _polygonModel.insert(handleIndex, new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        } else if (!_handleVertices.isEmpty()) {
+            // Now too dense to drag at this zoom
+            _handleVertices.clear();
+            _polygonModel.clearAndDeleteContents();
+        }
+    }
+    _updatingHandleRegion = false;
+
     setDirty(true);
-    emit pathChanged();
+    emit countChanged(count());
+}
+
+void QGCMapPolygon::_removeVertexHandle(int vertexIndex, const QGeoCoordinate& removedCoordinate)
+{
+    if (_handlesInPlace()) {
+        _polygonModel.removeAt(vertexIndex)->deleteLater();
+        return;
+    }
+    if (count() <= maxVertexHandles) {
+        // Shrunk back to a size where every vertex has a handle
+        _resetHandles();
+        return;
+    }
+
+    const auto it = std::lower_bound(_handleVertices.begin(), _handleVertices.end(), vertexIndex);
+    const bool hadHandle = (it != _handleVertices.end()) && (*it == vertexIndex);
+    const int handleIndex = static_cast<int>(it - _handleVertices.begin());
+    for (auto shift = hadHandle ? (it + 1) : it; shift != _handleVertices.end(); shift++) {
+        (*shift)--;
+    }
+
+    _updatingHandleRegion = true;
+    if (hadHandle) {
+        _regionVertexCount--;
+        _handleVertices.removeAt(handleIndex);
+        _polygonModel.removeAt(handleIndex)->deleteLater();
+    } else if ((_regionVertexCount > maxVertexHandles) && _handleRegion.contains(removedCoordinate)) {
+        _regionVertexCount--;
+        if (_regionVertexCount <= maxVertexHandles) {
+            // No longer too dense, the vertices in the region get their handles
+            _resetHandles();
+        }
+    }
+    _updatingHandleRegion = false;
+
+    setDirty(true);
+    emit countChanged(count());
+}
+
+void QGCMapPolygon::setHandleRegion(const QGeoShape& region)
+{
+    const QGeoRectangle handleRegion = region.boundingGeoRectangle();
+    if (handleRegion == _handleRegion) {
+        return;
+    }
+    _handleRegion = handleRegion;
+
+    if (_allHandles) {
+        // Small polygon, every vertex already has a handle
+        return;
+    }
+
+    // Only the handles change, the polygon itself does not
+    _updatingHandleRegion = true;
+    _resetHandles();
+    if (!_dirty) {
+        _polygonModel.setDirty(false);
+    }
+    _updatingHandleRegion = false;
 }
 
 void QGCMapPolygon::saveToJson(QJsonObject& json)
 {
     QJsonValue jsonValue;
 
-    GeoJsonHelper::saveGeoCoordinateArray(_polygonPath, false /* writeAltitude*/, jsonValue);
+    GeoJsonHelper::saveGeoCoordinateArray(_coordinates, false /* writeAltitude*/, jsonValue);
     json.insert(jsonPolygonKey, jsonValue);
     setDirty(false);
 }
@@ -227,12 +410,21 @@ bool QGCMapPolygon::loadFromJson(const QJsonObject& json, bool required, QString
         return true;
     }
 
-    if (!GeoJsonHelper::loadGeoCoordinateArray(json[jsonPolygonKey], false /* altitudeRequired */, _polygonPath, errorString)) {
+    if (!GeoJsonHelper::loadGeoCoordinateArray(json[jsonPolygonKey], false /* altitudeRequired */, _coordinates, errorString)) {
         return false;
     }
+    _pathCacheValid = false;
 
-    for (int i=0; i<_polygonPath.count(); i++) {
-        _polygonModel.append(new QGCQGeoCoordinate(_polygonPath[i].value<QGeoCoordinate>(), this));
+    if (_handlesInPlace()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coord: std::as_const(_coordinates)) {
+            objects.append(new QGCQGeoCoordinate(coord, this));
+        }
+        if (!objects.isEmpty()) {
+            _polygonModel.append(objects);
+        }
+    } else {
+        _resetHandles();
     }
 
     setDirty(false);
@@ -241,26 +433,15 @@ bool QGCMapPolygon::loadFromJson(const QJsonObject& json, bool required, QString
     return true;
 }
 
-QList<QGeoCoordinate> QGCMapPolygon::coordinateList(void) const
-{
-    QList<QGeoCoordinate> coords;
-
-    for (int i=0; i<_polygonPath.count(); i++) {
-        coords.append(_polygonPath[i].value<QGeoCoordinate>());
-    }
-
-    return coords;
-}
-
 void QGCMapPolygon::splitPolygonSegment(int vertexIndex)
 {
     int nextIndex = vertexIndex + 1;
-    if (nextIndex > _polygonPath.length() - 1) {
+    if (nextIndex > _coordinates.length() - 1) {
         nextIndex = 0;
     }
 
-    QGeoCoordinate firstVertex = _polygonPath[vertexIndex].value<QGeoCoordinate>();
-    QGeoCoordinate nextVertex = _polygonPath[nextIndex].value<QGeoCoordinate>();
+    QGeoCoordinate firstVertex = _coordinates[vertexIndex];
+    QGeoCoordinate nextVertex = _coordinates[nextIndex];
 
     double distance = firstVertex.distanceTo(nextVertex);
     double azimuth = firstVertex.azimuthTo(nextVertex);
@@ -269,8 +450,9 @@ void QGCMapPolygon::splitPolygonSegment(int vertexIndex)
     if (nextIndex == 0) {
         appendVertex(newVertex);
     } else {
-        _polygonModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
-        _polygonPath.insert(nextIndex, QVariant::fromValue(newVertex));
+        _coordinates.insert(nextIndex, newVertex);
+        _pathCacheValid = false;
+        _insertVertexHandle(nextIndex);
         emit pathChanged();
         if (0 <= _selectedVertexIndex && vertexIndex < _selectedVertexIndex) {
             selectVertex(_selectedVertexIndex+1);
@@ -280,8 +462,9 @@ void QGCMapPolygon::splitPolygonSegment(int vertexIndex)
 
 void QGCMapPolygon::appendVertex(const QGeoCoordinate& coordinate)
 {
-    _polygonPath.append(QVariant::fromValue(coordinate));
-    _polygonModel.append(new QGCQGeoCoordinate(coordinate, this));
+    _coordinates.append(coordinate);
+    _pathCacheValid = false;
+    _insertVertexHandle(count() - 1);
     if (!_deferredPathChanged) {
         // Only update the path once per event loop, to prevent lag-spikes
         _deferredPathChanged = true;
@@ -298,14 +481,18 @@ void QGCMapPolygon::appendVertex(const QGeoCoordinate& coordinate)
 
 void QGCMapPolygon::appendVertices(const QList<QGeoCoordinate>& coordinates)
 {
-    QList<QObject*> objects;
-
     beginReset();
-    for (const QGeoCoordinate& coordinate: coordinates) {
-        objects.append(new QGCQGeoCoordinate(coordinate, this));
-        _polygonPath.append(QVariant::fromValue(coordinate));
+    _coordinates.append(coordinates);
+    _pathCacheValid = false;
+    if (_handlesInPlace()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            objects.append(new QGCQGeoCoordinate(coordinate, this));
+        }
+        _polygonModel.append(objects);
+    } else {
+        _rebuildHandles();
     }
-    _polygonModel.append(objects);
     endReset();
 
     if (_vertexDrag) {
@@ -318,6 +505,7 @@ void QGCMapPolygon::appendVertices(const QList<QGeoCoordinate>& coordinates)
 void QGCMapPolygon::appendVertices(const QVariantList& varCoords)
 {
     QList<QGeoCoordinate> rgCoords;
+    rgCoords.reserve(varCoords.count());
     for (const QVariant& varCoord: varCoords) {
         rgCoords.append(varCoord.value<QGeoCoordinate>());
     }
@@ -326,38 +514,41 @@ void QGCMapPolygon::appendVertices(const QVariantList& varCoords)
 
 void QGCMapPolygon::_polygonModelDirtyChanged(bool dirty)
 {
-    if (dirty) {
+    if (dirty && !_updatingHandleRegion) {
         setDirty(true);
     }
 }
 
 void QGCMapPolygon::removeVertex(int vertexIndex)
 {
-    if (vertexIndex < 0 || vertexIndex >= _polygonPath.length()) {
-        qCWarning(QGCMapPolygonLog) << "Call to removePolygonCoordinate with bad vertexIndex:count" << vertexIndex << _polygonPath.length();
+    if (vertexIndex < 0 || vertexIndex >= _coordinates.length()) {
+        qCWarning(QGCMapPolygonLog) << "Call to removePolygonCoordinate with bad vertexIndex:count" << vertexIndex << _coordinates.length();
         return;
     }
 
-    if (_polygonPath.length() <= 3) {
+    if (_coordinates.length() <= 3) {
         // Don't allow the user to trash the polygon
         return;
     }
 
-    QObject* coordObj = _polygonModel.removeAt(vertexIndex);
-    coordObj->deleteLater();
+    const QGeoCoordinate removedCoordinate = _coordinates.takeAt(vertexIndex);
+    _pathCacheValid = false;
+    _removeVertexHandle(vertexIndex, removedCoordinate);
     if(vertexIndex == _selectedVertexIndex) {
         selectVertex(-1);
     } else if (vertexIndex < _selectedVertexIndex) {
         selectVertex(_selectedVertexIndex - 1);
     } // else do nothing - keep current selected vertex
 
-    _polygonPath.removeAt(vertexIndex);
     emit pathChanged();
 }
 
-void QGCMapPolygon::_polygonModelCountChanged(int count)
+void QGCMapPolygon::_polygonModelCountChanged(int /* handleCount */)
 {
-    emit countChanged(count);
+    // pathModel only holds the drag handles, count is always the vertex count
+    if (!_updatingHandleRegion) {
+        emit countChanged(count());
+    }
 }
 
 void QGCMapPolygon::_updateCenter(void)
@@ -365,7 +556,7 @@ void QGCMapPolygon::_updateCenter(void)
     if (!_ignoreCenterUpdates) {
         QGeoCoordinate center;
 
-        if (_polygonPath.count() > 2) {
+        if (_coordinates.count() > 2) {
             QPolygonF polygonF = _toPolygonF();
             const int n = polygonF.count();
 
@@ -413,7 +604,7 @@ void QGCMapPolygon::setCenter(QGeoCoordinate newCenter)
         double azimuth = _center.azimuthTo(newCenter);
 
         for (int i=0; i<count(); i++) {
-            QGeoCoordinate oldVertex = _polygonPath[i].value<QGeoCoordinate>();
+            QGeoCoordinate oldVertex = _coordinates[i];
             QGeoCoordinate newVertex = oldVertex.atDistanceAndAzimuth(distance, azimuth);
             adjustVertex(i, newVertex);
         }
@@ -482,10 +673,10 @@ void QGCMapPolygon::setInteractive(bool interactive)
 
 QGeoCoordinate QGCMapPolygon::vertexCoordinate(int vertex) const
 {
-    if (vertex >= 0 && vertex < _polygonPath.count()) {
-        return _polygonPath[vertex].value<QGeoCoordinate>();
+    if (vertex >= 0 && vertex < _coordinates.count()) {
+        return _coordinates[vertex];
     } else {
-        qCWarning(QGCMapPolygonLog) << "QGCMapPolygon::vertexCoordinate bad vertex requested:count" << vertex << _polygonPath.count();
+        qCWarning(QGCMapPolygonLog) << "QGCMapPolygon::vertexCoordinate bad vertex requested:count" << vertex << _coordinates.count();
         return QGeoCoordinate();
     }
 }
@@ -495,18 +686,15 @@ QList<QPointF> QGCMapPolygon::nedPolygon(void) const
     QList<QPointF>  nedPolygon;
 
     if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polygonModel.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
+        const QList<QPointF> ned = QGCGeo::convertGeoToNed(_coordinates, _coordinates[0]);
+        nedPolygon.reserve(ned.count());
+        for (int i=0; i<ned.count(); i++) {
             if (i == 0) {
                 // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
+                nedPolygon += QPointF(0, 0);
             } else {
-                QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
+                nedPolygon += QPointF(ned[i].y(), ned[i].x());
             }
-            nedPolygon += QPointF(x, y);
         }
     }
 
@@ -569,6 +757,11 @@ void QGCMapPolygon::offset(double distance)
 }
 
 bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
+{
+    return loadKMLOrSHPFile(file, SettingsManager::instance()->planViewSettings()->importSimplifyTolerance()->rawValue().toDouble());
+}
+
+bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file, double simplifyToleranceMeters)
 {
     QString errorString;
     QList<QList<QGeoCoordinate>> polygons;
@@ -580,7 +773,12 @@ bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
         QGC::showAppMessage(tr("No polygons found in file"));
         return false;
     }
-    const QList<QGeoCoordinate>& rgCoords = polygons.first();
+    QList<QGeoCoordinate> rgCoords = polygons.first();
+    if (simplifyToleranceMeters > 0) {
+        const qsizetype importCount = rgCoords.count();
+        rgCoords = QGCGeo::simplifyPath(rgCoords, simplifyToleranceMeters, true /* closed */);
+        qCDebug(QGCMapPolygonLog) << "Simplified" << file << "from" << importCount << "to" << rgCoords.count() << "vertices";
+    }
 
     beginReset();
     clear();
@@ -594,7 +792,7 @@ double QGCMapPolygon::area(void) const
 {
     // https://www.mathopenref.com/coordpolygonarea2.html
 
-    if (_polygonPath.count() < 3) {
+    if (_coordinates.count() < 3) {
         return 0;
     }
 
@@ -612,14 +810,14 @@ double QGCMapPolygon::area(void) const
 
 void QGCMapPolygon::verifyClockwiseWinding(void)
 {
-    if (_polygonPath.count() <= 2) {
+    if (_coordinates.count() <= 2) {
         return;
     }
 
     double sum = 0;
-    for (int i=0; i<_polygonPath.count(); i++) {
-        QGeoCoordinate coord1 = _polygonPath[i].value<QGeoCoordinate>();
-        QGeoCoordinate coord2 = (i == _polygonPath.count() - 1) ? _polygonPath[0].value<QGeoCoordinate>() : _polygonPath[i+1].value<QGeoCoordinate>();
+    for (int i=0; i<_coordinates.count(); i++) {
+        const QGeoCoordinate& coord1 = _coordinates[i];
+        const QGeoCoordinate& coord2 = (i == _coordinates.count() - 1) ? _coordinates[0] : _coordinates[i+1];
 
         sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
     }
@@ -627,10 +825,8 @@ void QGCMapPolygon::verifyClockwiseWinding(void)
     if (sum < 0.0) {
         // Winding is counter-clockwise and needs reversal
 
-        QList<QGeoCoordinate> rgReversed;
-        for (const QVariant& varCoord: _polygonPath) {
-            rgReversed.prepend(varCoord.value<QGeoCoordinate>());
-        }
+        QList<QGeoCoordinate> rgReversed = _coordinates;
+        std::reverse(rgReversed.begin(), rgReversed.end());
 
         beginReset();
         clear();
@@ -683,10 +879,10 @@ QDomElement QGCMapPolygon::kmlPolygonElement(KMLDomDocument& domDocument)
     polygonElement.appendChild(outerBoundaryIsElement);
 
     QString coordString;
-    for (const QVariant& varCoord : _polygonPath) {
-        coordString += QStringLiteral("%1\n").arg(domDocument.kmlCoordString(varCoord.value<QGeoCoordinate>()));
+    for (const QGeoCoordinate& coord : std::as_const(_coordinates)) {
+        coordString += QStringLiteral("%1\n").arg(domDocument.kmlCoordString(coord));
     }
-    coordString += QStringLiteral("%1\n").arg(domDocument.kmlCoordString(_polygonPath.first().value<QGeoCoordinate>()));
+    coordString += QStringLiteral("%1\n").arg(domDocument.kmlCoordString(_coordinates.first()));
     domDocument.addTextElement(linearRingElement, "coordinates", coordString);
 
     return polygonElement;
@@ -2,6 +2,8 @@
 
 #include <QtCore/QObject>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/QGeoShape>
 #include <QtCore/QVariantList>
 #include <QtGui/QPolygonF>
 #include <QtXml/QDomElement>
@@ -12,7 +14,9 @@ class KMLDomDocument;
 
 /// \brief The QGCMapPolygon class provides a polygon which can be displayed on a map using a map visuals control.
 ///
-/// It maintains a representation of the polygon on QVariantList and QmlObjectListModel format.
+/// The vertices are kept in a packed coordinate list. The QVariantList path for map items is built from it on
+/// demand. pathModel only holds the QGCQGeoCoordinate drag handles: one per vertex for polygons of up to
+/// maxVertexHandles vertices, otherwise only for the vertices inside the handle region set by the map visuals.
 ///
 class QGCMapPolygon : public QObject
 {
@@ -65,12 +69,24 @@ class QGCMapPolygon : public QObject
     /// Offsets the current polygon edges by the specified distance in meters
     Q_INVOKABLE void offset(double distance);
 
-    /// Loads a polygon from a KML/SHP file
+    /// Loads a polygon from a KML/SHP file, simplified to the Plan View import tolerance setting
     /// @return true: success
     Q_INVOKABLE bool loadKMLOrSHPFile(const QString& file);
 
+    /// Loads a polygon from a KML/SHP file
+    ///     @param simplifyToleranceMeters Simplify the outline to this tolerance without making it self intersect, 0 keeps all vertices
+    /// @return true: success
+    bool loadKMLOrSHPFile(const QString& file, double simplifyToleranceMeters);
+
     /// Returns the path in a list of QGeoCoordinate's format
-    QList<QGeoCoordinate> coordinateList(void) const;
+    QList<QGeoCoordinate> coordinateList(void) const { return _coordinates; }
+
+    /// Returns the polygon vertex index for the specified pathModel entry
+    Q_INVOKABLE int handleVertex(int handleIndex) const;
+
+    /// Sets the map region the user is looking at. Polygons with more than maxVertexHandles vertices only get drag
+    /// handles for the vertices inside it, and none when it holds too many vertices to drag at this zoom.
+    Q_INVOKABLE void setHandleRegion(const QGeoShape& region);
 
     /// Returns the QGeoCoordinate for the vertex specified
     Q_INVOKABLE QGeoCoordinate vertexCoordinate(int vertex) const;
@@ -102,20 +118,20 @@ class QGCMapPolygon : public QObject
 
     // Property methods
 
-    int             count       (void) const { return _polygonPath.count(); }
+    int             count       (void) const { return _coordinates.count(); }
     bool            dirty       (void) const { return _dirty; }
     void            setDirty    (bool dirty);
     QGeoCoordinate  center      (void) const { return _center; }
     bool            centerDrag  (void) const { return _centerDrag; }
     bool            vertexDrag  (void) const { return _vertexDrag; }
     bool            interactive (void) const { return _interactive; }
-    bool            isValid     (void) const { return _polygonModel.count() >= 3; }
-    bool            empty       (void) const { return _polygonModel.count() == 0; }
+    bool            isValid     (void) const { return count() >= 3; }
+    bool            empty       (void) const { return count() == 0; }
     bool            traceMode   (void) const { return _traceMode; }
     bool            showAltColor(void) const { return _showAltColor; }
     int             selectedVertex()   const { return _selectedVertexIndex; }
 
-    QVariantList        path        (void) const { return _polygonPath; }
+    QVariantList        path        (void) const;
     QmlObjectListModel* qmlPathModel(void) { return &_polygonModel; }
     QmlObjectListModel& pathModel   (void) { return _polygonModel; }
 
@@ -131,6 +147,9 @@ class QGCMapPolygon : public QObject
 
     static constexpr const char* jsonPolygonKey = "polygon";
 
+    /// Most drag handles pathModel holds
+    static constexpr int maxVertexHandles = 500;
+
 signals:
     void countChanged       (int count);
     void pathChanged        (void);
@@ -158,17 +177,30 @@ private slots:
     QPolygonF       _toPolygonF             (void) const;
     QGeoCoordinate  _coordFromPointF        (const QPointF& point) const;
     QPointF         _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
-
-    QVariantList        _polygonPath;
-    QmlObjectListModel  _polygonModel;
-    bool                _dirty =                false;
-    QGeoCoordinate      _center;
-    bool                _centerDrag =           false;
-    bool                _vertexDrag =           false;
-    bool                _ignoreCenterUpdates =  false;
-    bool                _interactive =          false;
-    bool                _traceMode =            false;
-    bool                _showAltColor =         false;
-    int                 _selectedVertexIndex =  -1;
-    bool                _deferredPathChanged =  false;
+    int             _handleIndex            (int vertexIndex) const;
+    bool            _handlesInPlace         (void) const { return _allHandles && (count() <= maxVertexHandles); }
+    void            _rebuildHandles         (void);
+    void            _resetHandles           (void);
+    void            _insertVertexHandle     (int vertexIndex);
+    void            _removeVertexHandle     (int vertexIndex, const QGeoCoordinate& removedCoordinate);
+
+    QList<QGeoCoordinate>   _coordinates;                       ///< Polygon vertices
+    mutable QVariantList    _pathCache;                         ///< path(), rebuilt after vertices are added or removed
+    mutable bool            _pathCacheValid =       false;
+    QmlObjectListModel      _polygonModel;                      ///< Vertex drag handles
+    QList<int>              _handleVertices;                    ///< Vertex index of each drag handle when _allHandles is false
+    int                     _regionVertexCount =    0;          ///< Vertices inside _handleRegion when _allHandles is false
+    bool                    _allHandles =           true;       ///< Every vertex has a drag handle, in vertex order
+    QGeoRectangle           _handleRegion;
+    bool                    _updatingHandleRegion = false;
+    bool                    _dirty =                false;
+    QGeoCoordinate          _center;
+    bool                    _centerDrag =           false;
+    bool                    _vertexDrag =           false;
+    bool                    _ignoreCenterUpdates =  false;
+    bool                    _interactive =          false;
+    bool                    _traceMode =            false;
+    bool                    _showAltColor =         false;
+    int                     _selectedVertexIndex =  -1;
+    bool                    _deferredPathChanged =  false;
 };
@@ -6,11 +6,15 @@
 #include "AppMessages.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
+#include "PlanViewSettings.h"
+#include "SettingsManager.h"
 #include "ShapeFileHelper.h"
 
 #include <QtCore/QLineF>
 #include <QMetaMethod>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(QGCMapPolylineLog, "QMLControls.QGCMapPolyline")
 
 QGCMapPolyline::QGCMapPolyline(QObject* parent)
@@ -40,10 +44,7 @@ const QGCMapPolyline& QGCMapPolyline::operator=(const QGCMapPolyline& other)
 {
     clear();
 
-    QVariantList vertices = other.path();
-    for (int i=0; i<vertices.count(); i++) {
-        appendVertex(vertices[i].value<QGeoCoordinate>());
-    }
+    appendVertices(other.coordinateList());
 
     setDirty(true);
 
@@ -54,7 +55,11 @@ void QGCMapPolyline::_init(void)
 {
     connect(&_polylineModel, &QmlObjectListModel::dirtyChanged, this, &QGCMapPolyline::_polylineModelDirtyChanged);
     connect(&_polylineModel, &QmlObjectListModel::countChanged, this, &QGCMapPolyline::_polylineModelCountChanged);
-    connect(&_polylineModel, &QmlObjectListModel::modelReset, this, &QGCMapPolyline::pathChanged);
+    connect(&_polylineModel, &QmlObjectListModel::modelReset, this, [this]() {
+        if (!_updatingHandleRegion) {
+            emit pathChanged();
+        }
+    });
 
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isValidChanged);
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isEmptyChanged);
@@ -64,9 +69,12 @@ void QGCMapPolyline::_init(void)
 
 void QGCMapPolyline::clear(void)
 {
-    _polylinePath.clear();
+    _coordinates.clear();
+    _pathCacheValid = false;
     emit pathChanged();
 
+    _handleVertices.clear();
+    _allHandles = true;
     _polylineModel.clearAndDeleteContents();
 
     emit cleared();
@@ -76,8 +84,14 @@ void QGCMapPolyline::clear(void)
 
 void QGCMapPolyline::adjustVertex(int vertexIndex, const QGeoCoordinate coordinate)
 {
-    _polylinePath[vertexIndex] = QVariant::fromValue(coordinate);
-    _polylineModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    _coordinates[vertexIndex] = coordinate;
+    if (_pathCacheValid) {
+        _pathCache[vertexIndex] = QVariant::fromValue(coordinate);
+    }
+    const int handleIndex = _handleIndex(vertexIndex);
+    if (handleIndex >= 0) {
+        _polylineModel.value<QGCQGeoCoordinate*>(handleIndex)->setCoordinate(coordinate);
+    }
     if (!_deferredPathChanged) {
         _deferredPathChanged = true;
         if (_vertexDrag) {
@@ -110,8 +124,8 @@ QGeoCoordinate QGCMapPolyline::_coordFromPointF(const QPointF& point) const
 {
     QGeoCoordinate coord;
 
-    if (_polylinePath.count() > 0) {
-        QGeoCoordinate tangentOrigin = _polylinePath[0].value<QGeoCoordinate>();
+    if (_coordinates.count() > 0) {
+        QGeoCoordinate tangentOrigin = _coordinates[0];
         QGCGeo::convertNedToGeo(-point.y(), point.x(), 0, tangentOrigin, coord);
     }
 
@@ -120,9 +134,9 @@ QGeoCoordinate QGCMapPolyline::_coordFromPointF(const QPointF& point) const
 
 QPointF QGCMapPolyline::_pointFFromCoord(const QGeoCoordinate& coordinate) const
 {
-    if (_polylinePath.count() > 0) {
+    if (_coordinates.count() > 0) {
         double y, x, down;
-        QGeoCoordinate tangentOrigin = _polylinePath[0].value<QGeoCoordinate>();
+        QGeoCoordinate tangentOrigin = _coordinates[0];
 
         QGCGeo::convertGeoToNed(coordinate, tangentOrigin, y, x, down);
         return QPointF(x, -y);
@@ -135,12 +149,9 @@ void QGCMapPolyline::setPath(const QList<QGeoCoordinate>& path)
 {
     beginReset();
 
-    _polylinePath.clear();
-    _polylineModel.clearAndDeleteContents();
-    for (const QGeoCoordinate& coord: path) {
-        _polylinePath.append(QVariant::fromValue(coord));
-        _polylineModel.append(new QGCQGeoCoordinate(coord, this));
-    }
+    _coordinates = path;
+    _pathCacheValid = false;
+    _rebuildHandles();
 
     setDirty(true);
 
@@ -149,24 +160,195 @@ void QGCMapPolyline::setPath(const QList<QGeoCoordinate>& path)
 
 void QGCMapPolyline::setPath(const QVariantList& path)
 {
-    beginReset();
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(path.count());
+    for (const QVariant& varCoord: path) {
+        coordinates.append(varCoord.value<QGeoCoordinate>());
+    }
+    setPath(coordinates);
+}
+
+QVariantList QGCMapPolyline::path(void) const
+{
+    if (!_pathCacheValid) {
+        _pathCache.clear();
+        _pathCache.reserve(_coordinates.count());
+        for (const QGeoCoordinate& coord: _coordinates) {
+            _pathCache.append(QVariant::fromValue(coord));
+        }
+        _pathCacheValid = true;
+    }
+
+    return _pathCache;
+}
+
+int QGCMapPolyline::_handleIndex(int vertexIndex) const
+{
+    if (_allHandles) {
+        return vertexIndex;
+    }
+
+    const auto it = std::lower_bound(_handleVertices.cbegin(), _handleVertices.cend(), vertexIndex);
+    if ((it != _handleVertices.cend()) && (*it == vertexIndex)) {
+        return static_cast<int>(it - _handleVertices.cbegin());
+    }
+    return -1;
+}
+
+int QGCMapPolyline::handleVertex(int handleIndex) const
+{
+    if (_allHandles) {
+        return handleIndex;
+    }
+
+    if (handleIndex >= 0 && handleIndex < _handleVertices.count()) {
+        return _handleVertices[handleIndex];
+    }
+    return -1;
+}
 
-    _polylinePath = path;
+void QGCMapPolyline::_rebuildHandles(void)
+{
     _polylineModel.clearAndDeleteContents();
-    for (int i=0; i<_polylinePath.count(); i++) {
-        _polylineModel.append(new QGCQGeoCoordinate(_polylinePath[i].value<QGeoCoordinate>(), this));
+    _handleVertices.clear();
+    _regionVertexCount = 0;
+    _allHandles = count() <= maxVertexHandles;
+
+    QList<QObject*> objects;
+    if (_allHandles) {
+        for (const QGeoCoordinate& coord: std::as_const(_coordinates)) {
+            objects.append(new QGCQGeoCoordinate(coord, this));
+        }
+    } else if (_handleRegion.isValid()) {
+        for (int i=0; i<_coordinates.count(); i++) {
+            if (_handleRegion.contains(_coordinates[i])) {
+                _handleVertices.append(i);
+            }
+        }
+        _regionVertexCount = static_cast<int>(_handleVertices.count());
+        if (_regionVertexCount > maxVertexHandles) {
+            // Too dense to drag at this zoom, the user has to zoom in first
+            _handleVertices.clear();
+        }
+        for (int vertexIndex: std::as_const(_handleVertices)) {
+            objects.append(new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        }
     }
-    setDirty(true);
 
+    if (!objects.isEmpty()) {
+        _polylineModel.append(objects);
+    }
+}
+
+void QGCMapPolyline::_resetHandles(void)
+{
+    beginReset();
+    _rebuildHandles();
     endReset();
 }
 
+void QGCMapPolyline::_insertVertexHandle(int vertexIndex)
+{
+    if (_handlesInPlace()) {
+        _polylineModel.insert(vertexIndex, new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        return;
+    }
+    if (_allHandles) {
+        // Just grew past maxVertexHandles, from now on only the handle region has handles
+        _resetHandles();
+        return;
+    }
+
+    // Only the new vertex can gain a handle, the ones after it just move up
+    const auto it = std::lower_bound(_handleVertices.begin(), _handleVertices.end(), vertexIndex);
+    const int handleIndex = static_cast<int>(it - _handleVertices.begin());
+    for (auto shift = it; shift != _handleVertices.end(); shift++) {
+        (*shift)++;
+    }
+
+    _updatingHandleRegion = true;
+    if (_handleRegion.isValid() && _handleRegion.contains(_coordinates[vertexIndex])) {
+        _regionVertexCount++;
+        if (_regionVertexCount <= maxVertexHandles) {
+            _handleVertices.insert(handleIndex, vertexIndex);
+            _polylineModel.insert(handleIndex, new QGCQGeoCoordinate(_coordinates[vertexIndex], this));
+        } else if (!_handleVertices.isEmpty()) {
+            // Now too dense to drag at this zoom
+            _handleVertices.clear();
+            _polylineModel.clearAndDeleteContents();
+        }
+    }
+    _updatingHandleRegion = false;
+
+    setDirty(true);
+    emit countChanged(count());
+}
+
+void QGCMapPolyline::_removeVertexHandle(int vertexIndex, const QGeoCoordinate& removedCoordinate)
+{
+    if (_handlesInPlace()) {
+        _polylineModel.removeAt(vertexIndex)->deleteLater();
+        return;
+    }
+    if (count() <= maxVertexHandles) {
+        // Shrunk back to a size where every vertex has a handle
+        _resetHandles();
+        return;
+    }
+
+    const auto it = std::lower_bound(_handleVertices.begin(), _handleVertices.end(), vertexIndex);
+    const bool hadHandle = (it != _handleVertices.end()) && (*it == vertexIndex);
+    const int handleIndex = static_cast<int>(it - _handleVertices.begin());
+    for (auto shift = hadHandle ? (it + 1) : it; shift != _handleVertices.end(); shift++) {
+        (*shift)--;
+    }
+
+    _updatingHandleRegion = true;
+    if (hadHandle) {
+        _regionVertexCount--;
+        _handleVertices.removeAt(handleIndex);
+        _polylineModel.removeAt(handleIndex)->deleteLater();
+    } else if ((_regionVertexCount > maxVertexHandles) && _handleRegion.contains(removedCoordinate)) {
+        _regionVertexCount--;
+        if (_regionVertexCount <= maxVertexHandles) {
+            // No longer too dense, the vertices in the region get their handles
+            _resetHandles();
+        }
+    }
+    _updatingHandleRegion = false;
+
+    setDirty(true);
+    emit countChanged(count());
+}
+
+void QGCMapPolyline::setHandleRegion(const QGeoShape& region)
+{
+    const QGeoRectangle handleRegion = region.boundingGeoRectangle();
+    if (handleRegion == _handleRegion) {
+        return;
+    }
+    _handleRegion = handleRegion;
+
+    if (_allHandles) {
+        // Short polyline, every vertex already has a handle
+        return;
+    }
+
+    // Only the handles change, the polyline itself does not
+    _updatingHandleRegion = true;
+    _resetHandles();
+    if (!_dirty) {
+        _polylineModel.setDirty(false);
+    }
+    _updatingHandleRegion = false;
+}
+
 
 void QGCMapPolyline::saveToJson(QJsonObject& json)
 {
     QJsonValue jsonValue;
 
-    GeoJsonHelper::saveGeoCoordinateArray(_polylinePath, false /* writeAltitude*/, jsonValue);
+    GeoJsonHelper::saveGeoCoordinateArray(_coordinates, false /* writeAltitude*/, jsonValue);
     json.insert(jsonPolylineKey, jsonValue);
     setDirty(false);
 }
@@ -184,12 +366,21 @@ bool QGCMapPolyline::loadFromJson(const QJsonObject& json, bool required, QStrin
         return true;
     }
 
-    if (!GeoJsonHelper::loadGeoCoordinateArray(json[jsonPolylineKey], false /* altitudeRequired */, _polylinePath, errorString)) {
+    if (!GeoJsonHelper::loadGeoCoordinateArray(json[jsonPolylineKey], false /* altitudeRequired */, _coordinates, errorString)) {
         return false;
     }
+    _pathCacheValid = false;
 
-    for (int i=0; i<_polylinePath.count(); i++) {
-        _polylineModel.append(new QGCQGeoCoordinate(_polylinePath[i].value<QGeoCoordinate>(), this));
+    if (_handlesInPlace()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coord: std::as_const(_coordinates)) {
+            objects.append(new QGCQGeoCoordinate(coord, this));
+        }
+        if (!objects.isEmpty()) {
+            _polylineModel.append(objects);
+        }
+    } else {
+        _resetHandles();
     }
 
     setDirty(false);
@@ -198,26 +389,15 @@ bool QGCMapPolyline::loadFromJson(const QJsonObject& json, bool required, QStrin
     return true;
 }
 
-QList<QGeoCoordinate> QGCMapPolyline::coordinateList(void) const
-{
-    QList<QGeoCoordinate> coords;
-
-    for (int i=0; i<_polylinePath.count(); i++) {
-        coords.append(_polylinePath[i].value<QGeoCoordinate>());
-    }
-
-    return coords;
-}
-
 void QGCMapPolyline::splitSegment(int vertexIndex)
 {
     int nextIndex = vertexIndex + 1;
-    if (nextIndex > _polylinePath.length() - 1) {
+    if (nextIndex > _coordinates.length() - 1) {
         return;
     }
 
-    QGeoCoordinate firstVertex = _polylinePath[vertexIndex].value<QGeoCoordinate>();
-    QGeoCoordinate nextVertex = _polylinePath[nextIndex].value<QGeoCoordinate>();
+    QGeoCoordinate firstVertex = _coordinates[vertexIndex];
+    QGeoCoordinate nextVertex = _coordinates[nextIndex];
 
     double distance = firstVertex.distanceTo(nextVertex);
     double azimuth = firstVertex.azimuthTo(nextVertex);
@@ -226,40 +406,42 @@ void QGCMapPolyline::splitSegment(int vertexIndex)
     if (nextIndex == 0) {
         appendVertex(newVertex);
     } else {
-        _polylineModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
-        _polylinePath.insert(nextIndex, QVariant::fromValue(newVertex));
+        _coordinates.insert(nextIndex, newVertex);
+        _pathCacheValid = false;
+        _insertVertexHandle(nextIndex);
         emit pathChanged();
     }
 }
 
 void QGCMapPolyline::appendVertex(const QGeoCoordinate& coordinate)
 {
-    _polylinePath.append(QVariant::fromValue(coordinate));
-    _polylineModel.append(new QGCQGeoCoordinate(coordinate, this));
+    _coordinates.append(coordinate);
+    _pathCacheValid = false;
+    _insertVertexHandle(count() - 1);
     emit pathChanged();
 }
 
 void QGCMapPolyline::removeVertex(int vertexIndex)
 {
-    if (vertexIndex < 0 || vertexIndex > _polylinePath.length() - 1) {
-        qCWarning(QGCMapPolylineLog) << "Call to removeVertex with bad vertexIndex:count" << vertexIndex << _polylinePath.length();
+    if (vertexIndex < 0 || vertexIndex > _coordinates.length() - 1) {
+        qCWarning(QGCMapPolylineLog) << "Call to removeVertex with bad vertexIndex:count" << vertexIndex << _coordinates.length();
         return;
     }
 
-    if (_polylinePath.length() <= 2) {
+    if (_coordinates.length() <= 2) {
         // Don't allow the user to trash the polyline
         return;
     }
 
-    QObject* coordObj = _polylineModel.removeAt(vertexIndex);
-    coordObj->deleteLater();
+    const QGeoCoordinate removedCoordinate = _coordinates.takeAt(vertexIndex);
+    _pathCacheValid = false;
+    _removeVertexHandle(vertexIndex, removedCoordinate);
     if(vertexIndex == _selectedVertexIndex) {
         selectVertex(-1);
     } else if (vertexIndex < _selectedVertexIndex) {
         selectVertex(_selectedVertexIndex - 1);
     } // else do nothing - keep current selected vertex
 
-    _polylinePath.removeAt(vertexIndex);
     emit pathChanged();
 }
 
@@ -285,8 +467,8 @@ void QGCMapPolyline::setVertexDrag(bool vertexDrag)
 
 QGeoCoordinate QGCMapPolyline::vertexCoordinate(int vertex) const
 {
-    if (vertex >= 0 && vertex < _polylinePath.count()) {
-        return _polylinePath[vertex].value<QGeoCoordinate>();
+    if (vertex >= 0 && vertex < _coordinates.count()) {
+        return _coordinates[vertex];
     } else {
         qCWarning(QGCMapPolylineLog) << "QGCMapPolyline::vertexCoordinate bad vertex requested";
         return QGeoCoordinate();
@@ -298,18 +480,15 @@ QList<QPointF> QGCMapPolyline::nedPolyline(void)
     QList<QPointF>  nedPolyline;
 
     if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polylinePath.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
+        const QList<QPointF> ned = QGCGeo::convertGeoToNed(_coordinates, _coordinates[0]);
+        nedPolyline.reserve(ned.count());
+        for (int i=0; i<ned.count(); i++) {
             if (i == 0) {
                 // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
+                nedPolyline += QPointF(0, 0);
             } else {
-                QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
+                nedPolyline += QPointF(ned[i].y(), ned[i].x());
             }
-            nedPolyline += QPointF(x, y);
         }
     }
 
@@ -374,6 +553,11 @@ QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
 }
 
 bool QGCMapPolyline::loadKMLOrSHPFile(const QString &file)
+{
+    return loadKMLOrSHPFile(file, SettingsManager::instance()->planViewSettings()->importSimplifyTolerance()->rawValue().toDouble());
+}
+
+bool QGCMapPolyline::loadKMLOrSHPFile(const QString &file, double simplifyToleranceMeters)
 {
     QString errorString;
     QList<QList<QGeoCoordinate>> polylines;
@@ -385,7 +569,12 @@ bool QGCMapPolyline::loadKMLOrSHPFile(const QString &file)
         QGC::showAppMessage(tr("No polylines found in file"));
         return false;
     }
-    const QList<QGeoCoordinate>& rgCoords = polylines.first();
+    QList<QGeoCoordinate> rgCoords = polylines.first();
+    if (simplifyToleranceMeters > 0) {
+        const qsizetype importCount = rgCoords.count();
+        rgCoords = QGCGeo::simplifyPath(rgCoords, simplifyToleranceMeters, false /* closed */);
+        qCDebug(QGCMapPolylineLog) << "Simplified" << file << "from" << importCount << "to" << rgCoords.count() << "vertices";
+    }
 
     beginReset();
     clear();
@@ -397,14 +586,17 @@ bool QGCMapPolyline::loadKMLOrSHPFile(const QString &file)
 
 void QGCMapPolyline::_polylineModelDirtyChanged(bool dirty)
 {
-    if (dirty) {
+    if (dirty && !_updatingHandleRegion) {
         setDirty(true);
     }
 }
 
-void QGCMapPolyline::_polylineModelCountChanged(int count)
+void QGCMapPolyline::_polylineModelCountChanged(int /* handleCount */)
 {
-    emit countChanged(count);
+    // pathModel only holds the drag handles, count is always the vertex count
+    if (!_updatingHandleRegion) {
+        emit countChanged(count());
+    }
 }
 
 
@@ -412,10 +604,8 @@ double QGCMapPolyline::length(void) const
 {
     double length = 0;
 
-    for (int i=0; i<_polylinePath.count() - 1; i++) {
-        QGeoCoordinate from = _polylinePath[i].value<QGeoCoordinate>();
-        QGeoCoordinate to = _polylinePath[i+1].value<QGeoCoordinate>();
-        length += from.distanceTo(to);
+    for (int i=0; i<_coordinates.count() - 1; i++) {
+        length += _coordinates[i].distanceTo(_coordinates[i+1]);
     }
 
     return length;
@@ -425,12 +615,17 @@ void QGCMapPolyline::appendVertices(const QList<QGeoCoordinate>& coordinates)
 {
     beginReset();
 
-    QList<QObject*> objects;
-    for (const QGeoCoordinate& coordinate: coordinates) {
-        objects.append(new QGCQGeoCoordinate(coordinate, this));
-        _polylinePath.append(QVariant::fromValue(coordinate));
+    _coordinates.append(coordinates);
+    _pathCacheValid = false;
+    if (_handlesInPlace()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            objects.append(new QGCQGeoCoordinate(coordinate, this));
+        }
+        _polylineModel.append(objects);
+    } else {
+        _rebuildHandles();
     }
-    _polylineModel.append(objects);
 
     endReset();
 
@@ -3,9 +3,15 @@
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/QGeoShape>
 
 #include "QmlObjectListModel.h"
 
+/// Polyline which can be displayed on a map using a map visuals control.
+///
+/// Vertices are stored the same way as QGCMapPolygon: a packed coordinate list, a QVariantList path built on
+/// demand and a pathModel of drag handles which only covers the handle region for long polylines.
 class QGCMapPolyline : public QObject
 {
     Q_OBJECT
@@ -47,15 +53,27 @@ class QGCMapPolyline : public QObject
     /// @return Offset set of vertices
     QList<QGeoCoordinate> offsetPolyline(double distance);
 
-    /// Loads a polyline from a KML/SHP file
+    /// Loads a polyline from a KML/SHP file, simplified to the Plan View import tolerance setting
     /// @return true: success
     Q_INVOKABLE bool loadKMLOrSHPFile(const QString &file);
 
+    /// Loads a polyline from a KML/SHP file
+    ///     @param simplifyToleranceMeters Simplify the line to this tolerance without making it self intersect, 0 keeps all vertices
+    /// @return true: success
+    bool loadKMLOrSHPFile(const QString &file, double simplifyToleranceMeters);
+
     Q_INVOKABLE void beginReset (void);
     Q_INVOKABLE void endReset   (void);
 
     /// Returns the path in a list of QGeoCoordinate's format
-    QList<QGeoCoordinate> coordinateList(void) const;
+    QList<QGeoCoordinate> coordinateList(void) const { return _coordinates; }
+
+    /// Returns the polyline vertex index for the specified pathModel entry
+    Q_INVOKABLE int handleVertex(int handleIndex) const;
+
+    /// Sets the map region the user is looking at. Polylines with more than maxVertexHandles vertices only get drag
+    /// handles for the vertices inside it, and none when it holds too many vertices to drag at this zoom.
+    Q_INVOKABLE void setHandleRegion(const QGeoShape& region);
 
     /// Returns the QGeoCoordinate for the vertex specified
     Q_INVOKABLE QGeoCoordinate vertexCoordinate(int vertex) const;
@@ -78,14 +96,14 @@ class QGCMapPolyline : public QObject
     double length(void) const;
 
     // Property methods
-    int             count       (void) const { return _polylinePath.count(); }
+    int             count       (void) const { return _coordinates.count(); }
     bool            dirty       (void) const { return _dirty; }
     void            setDirty    (bool dirty);
     bool            interactive (void) const { return _interactive; }
     bool            vertexDrag  (void) const { return _vertexDrag; }
-    QVariantList    path        (void) const { return _polylinePath; }
-    bool            isValid     (void) const { return _polylineModel.count() >= 2; }
-    bool            empty       (void) const { return _polylineModel.count() == 0; }
+    QVariantList    path        (void) const;
+    bool            isValid     (void) const { return count() >= 2; }
+    bool            empty       (void) const { return count() == 0; }
     bool            traceMode   (void) const { return _traceMode; }
     int             selectedVertex()   const { return _selectedVertexIndex; }
 
@@ -101,6 +119,9 @@ class QGCMapPolyline : public QObject
 
     static constexpr const char* jsonPolylineKey = "polyline";
 
+    /// Most drag handles pathModel holds
+    static constexpr int maxVertexHandles = 500;
+
 signals:
     void countChanged       (int count);
     void pathChanged        (void);
@@ -122,13 +143,26 @@ private slots:
     void            _init                   (void);
     QGeoCoordinate  _coordFromPointF        (const QPointF& point) const;
     QPointF         _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
-
-    QVariantList        _polylinePath;
-    QmlObjectListModel  _polylineModel;
-    bool                _deferredPathChanged = false;
-    bool                _dirty;
-    bool                _interactive;
-    bool                _vertexDrag = false;
-    bool                _traceMode = false;
-    int                 _selectedVertexIndex = -1;
+    int             _handleIndex            (int vertexIndex) const;
+    bool            _handlesInPlace         (void) const { return _allHandles && (count() <= maxVertexHandles); }
+    void            _rebuildHandles         (void);
+    void            _resetHandles           (void);
+    void            _insertVertexHandle     (int vertexIndex);
+    void            _removeVertexHandle     (int vertexIndex, const QGeoCoordinate& removedCoordinate);
+
+    QList<QGeoCoordinate>   _coordinates;                   ///< Polyline vertices
+    mutable QVariantList    _pathCache;                     ///< path(), rebuilt after vertices are added or removed
+    mutable bool            _pathCacheValid = false;
+    QmlObjectListModel      _polylineModel;                 ///< Vertex drag handles
+    QList<int>              _handleVertices;                ///< Vertex index of each drag handle when _allHandles is false
+    int                     _regionVertexCount = 0;         ///< Vertices inside _handleRegion when _allHandles is false
+    bool                    _allHandles = true;             ///< Every vertex has a drag handle, in vertex order
+    QGeoRectangle           _handleRegion;
+    bool                    _updatingHandleRegion = false;
+    bool                    _deferredPathChanged = false;
+    bool                    _dirty;
+    bool                    _interactive;
+    bool                    _vertexDrag = false;
+    bool                    _traceMode = false;
+    int                     _selectedVertexIndex = -1;
 };
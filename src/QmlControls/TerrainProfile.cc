@@ -53,28 +53,57 @@ void TerrainProfile::_newVisualItems(void)
     emit _updateSignal();
 }
 
-void TerrainProfile::_updateSegmentCounts(FlightPathSegment* segment, int& cFlightProfileSegments, int& cTerrainProfilePoints, int& cMissingTerrainSegments, int& cTerrainCollisionSegments, double& minTerrainHeight, double& maxTerrainHeight)
+template<typename Visitor>
+void TerrainProfile::_forEachSegment(Visitor&& visitor) const
 {
-    if (_shouldAddFlightProfileSegment(segment)) {
-        if (segment->segmentType() == FlightPathSegment::SegmentTypeTerrainFrame) {
-            cFlightProfileSegments += segment->amslTerrainHeights().count() - 1;
-        } else {
-            cFlightProfileSegments++;
+    for (int viIndex=0; viIndex<_visualItems->count(); viIndex++) {
+        VisualMissionItem*  visualItem =    _visualItems->value<VisualMissionItem*>(viIndex);
+        ComplexMissionItem* complexItem =   _visualItems->value<ComplexMissionItem*>(viIndex);
+
+        if (complexItem) {
+            if (complexItem->flightPathSegments()->count() == 0) {
+                visitor(nullptr, complexItem->complexDistance());
+            } else {
+                for (int segmentIndex=0; segmentIndex<complexItem->flightPathSegments()->count(); segmentIndex++) {
+                    visitor(complexItem->flightPathSegments()->value<FlightPathSegment*>(segmentIndex), 0.0);
+                }
+            }
         }
-    }
 
-    if (_shouldAddMissingTerrainSegment(segment)) {
-        cMissingTerrainSegments += 1;
-    } else {
-        cTerrainProfilePoints += segment->amslTerrainHeights().count();
-        for (int i=0; i<segment->amslTerrainHeights().count(); i++) {
-            minTerrainHeight = std::fmin(minTerrainHeight, segment->amslTerrainHeights()[i].value<double>());
-            maxTerrainHeight = std::fmax(maxTerrainHeight, segment->amslTerrainHeights()[i].value<double>());
+        if (visualItem->simpleFlightPathSegment()) {
+            visitor(visualItem->simpleFlightPathSegment(), 0.0);
         }
     }
-    if (segment->terrainCollision()) {
-        cTerrainCollisionSegments++;
-    }
+}
+
+TerrainProfileBlock& TerrainProfile::_block(FlightPathSegment* segment)
+{
+    auto it = _blocks.find(segment);
+    if (it == _blocks.end()) {
+        // Anything which changes the chart points of the segment drops its block
+        (void) connect(segment, &FlightPathSegment::amslTerrainHeightsChanged,   this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::coord1AMSLAltChanged,        this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::coord2AMSLAltChanged,        this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::distanceBetweenChanged,      this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::finalDistanceBetweenChanged, this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::totalDistanceChanged,        this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &FlightPathSegment::terrainCollisionChanged,     this, &TerrainProfile::_segmentChanged, Qt::UniqueConnection);
+        (void) connect(segment, &QObject::destroyed,                             this, &TerrainProfile::_segmentDestroyed, Qt::UniqueConnection);
+
+        it = _blocks.insert(segment, TerrainProfileBlock(segment));
+    }
+    return it.value();
+}
+
+void TerrainProfile::_segmentChanged(void)
+{
+    (void) _blocks.remove(qobject_cast<FlightPathSegment*>(sender()));
+}
+
+void TerrainProfile::_segmentDestroyed(QObject* segment)
+{
+    // Only used as a key, the segment is already destroyed
+    (void) _blocks.remove(static_cast<FlightPathSegment*>(segment));
 }
 
 void TerrainProfile::_updateProfile(void)
@@ -87,25 +116,31 @@ void TerrainProfile::_updateProfile(void)
     int    cMissingTerrainSegments =   0;
     int    cFlightProfileSegments =    0;
     int    cTerrainCollisionSegments = 0;
+    int    cRebuiltBlocks =            0;
     double minTerrainHeight =          qQNaN();
     double maxTerrainHeight =          qQNaN();
 
-    for (int viIndex=0; viIndex<_visualItems->count(); viIndex++) {
-        VisualMissionItem*  visualItem =    _visualItems->value<VisualMissionItem*>(viIndex);
-        ComplexMissionItem* complexItem =   _visualItems->value<ComplexMissionItem*>(viIndex);
-
-        if (visualItem->simpleFlightPathSegment()) {
-            FlightPathSegment* segment = visualItem->simpleFlightPathSegment();
-            _updateSegmentCounts(segment, cFlightProfileSegments, cTerrainProfilePoints, cMissingTerrainSegments, cTerrainCollisionSegments, minTerrainHeight, maxTerrainHeight);
+    _forEachSegment([&](FlightPathSegment* segment, double /* distance */) {
+        if (!segment) {
+            return;
+        }
+        if (!_blocks.contains(segment)) {
+            cRebuiltBlocks++;
         }
 
-        if (complexItem) {
-            for (int segmentIndex=0; segmentIndex<complexItem->flightPathSegments()->count(); segmentIndex++) {
-                FlightPathSegment* segment = complexItem->flightPathSegments()->value<FlightPathSegment*>(segmentIndex);
-                _updateSegmentCounts(segment, cFlightProfileSegments, cTerrainProfilePoints, cMissingTerrainSegments, cTerrainCollisionSegments, minTerrainHeight, maxTerrainHeight);
-            }
+        const TerrainProfileBlock& block = _block(segment);
+        cFlightProfileSegments += block.flightProfileSegmentCount();
+        if (block.missingTerrain()) {
+            cMissingTerrainSegments++;
+        } else {
+            cTerrainProfilePoints += block.terrainPointCount();
+            minTerrainHeight = std::fmin(minTerrainHeight, block.minTerrainHeight());
+            maxTerrainHeight = std::fmax(maxTerrainHeight, block.maxTerrainHeight());
         }
-    }
+        if (block.terrainCollision()) {
+            cTerrainCollisionSegments++;
+        }
+    });
 
     _minAMSLAlt = std::fmin(_missionController->minAMSLAltitude(), minTerrainHeight);
     _maxAMSLAlt = std::fmax(_missionController->maxAMSLAltitude(), maxTerrainHeight);
@@ -129,6 +164,7 @@ void TerrainProfile::_updateProfile(void)
         "\n\tcTerrainProfilePoints" << cTerrainProfilePoints <<
         "\n\tcMissingTerrainSegments" << cMissingTerrainSegments <<
         "\n\tcTerrainCollisionSegments" << cTerrainCollisionSegments <<
+        "\n\tcRebuiltBlocks" << cRebuiltBlocks <<
         "\n\t_minAMSLAlt" << _minAMSLAlt <<
         "\n\t_maxAMSLAlt" << _maxAMSLAlt <<
         "\n\tmaxTerrainHeight" << maxTerrainHeight;
@@ -148,155 +184,40 @@ void TerrainProfile::updateSeries(QXYSeries* terrainSeries, QXYSeries* flightSer
         return;
     }
 
-    QList<QPointF> terrainPoints;
-    QList<QPointF> flightPoints;
-    QList<QPointF> missingPoints;
-    QList<QPointF> collisionPoints;
+    const double bucketMeters = TerrainProfileBlock::bucketMeters(_missionController->missionTotalDistance(), _visibleWidth);
 
+    TerrainProfileBlock::SeriesPoints points;
     double currentDistance = 0;
 
-    for (int viIndex=0; viIndex<_visualItems->count(); viIndex++) {
-        VisualMissionItem*  visualItem =    _visualItems->value<VisualMissionItem*>(viIndex);
-        ComplexMissionItem* complexItem =   _visualItems->value<ComplexMissionItem*>(viIndex);
-
-        if (complexItem) {
-            if (complexItem->flightPathSegments()->count() == 0) {
-                currentDistance += complexItem->complexDistance();
-            } else {
-                for (int segmentIndex=0; segmentIndex<complexItem->flightPathSegments()->count(); segmentIndex++) {
-                    FlightPathSegment* segment = complexItem->flightPathSegments()->value<FlightPathSegment*>(segmentIndex);
-
-                    _addTerrainPoints   (segment, currentDistance, terrainPoints);
-                    _addFlightPoints    (segment, currentDistance, flightPoints);
-                    _addMissingPoints   (segment, currentDistance, missingPoints);
-                    _addCollisionPoints (segment, currentDistance, collisionPoints);
-
-                    currentDistance += segment->totalDistance();
-                }
-            }
+    _forEachSegment([&](FlightPathSegment* segment, double distance) {
+        if (!segment) {
+            currentDistance += distance;
+            return;
         }
 
-        if (visualItem->simpleFlightPathSegment()) {
-            FlightPathSegment* segment = visualItem->simpleFlightPathSegment();
-
-            _addTerrainPoints   (segment, currentDistance, terrainPoints);
-            _addFlightPoints    (segment, currentDistance, flightPoints);
-            _addMissingPoints   (segment, currentDistance, missingPoints);
-            _addCollisionPoints (segment, currentDistance, collisionPoints);
-
-            currentDistance += segment->totalDistance();
-        }
-    }
+        TerrainProfileBlock& block = _block(segment);
+        block.appendTo(points, currentDistance, bucketMeters, _horizontalScale, _verticalScale, _minAMSLAlt);
+        currentDistance += block.totalDistance();
+    });
 
     // Using clear/append instead of replace works around bugs in QtGraphs where you end up with parts of old series data showing.
     if (terrainSeries) {
         terrainSeries->clear();
-        terrainSeries->append(terrainPoints);
+        terrainSeries->append(points.terrain);
     }
     if (flightSeries) {
         flightSeries->clear();
-        flightSeries->append(flightPoints);
+        flightSeries->append(points.flight);
     }
     if (missingSeries) {
         missingSeries->clear();
-        missingSeries->append(missingPoints);
+        missingSeries->append(points.missing);
     }
     if (collisionSeries) {
         collisionSeries->clear();
-        collisionSeries->append(collisionPoints);
-    }
-
-    qCDebug(TerrainProfileLog).noquote() << QStringLiteral("updateSeries terrainPoints:%1 flightPoints:%2 missingPoints:%3 collisionPoints:%4")
-        .arg(terrainPoints.count()).arg(flightPoints.count()).arg(missingPoints.count()).arg(collisionPoints.count());
-}
-
-void TerrainProfile::_addTerrainPoints(FlightPathSegment* segment, double currentDistance, QList<QPointF>& points)
-{
-    if (_shouldAddMissingTerrainSegment(segment)) {
-        if (!points.isEmpty()) {
-            points.append(QPointF(qQNaN(), qQNaN()));
-        }
-        return;
-    }
-
-    double terrainDistance = 0;
-    for (int heightIndex=0; heightIndex<segment->amslTerrainHeights().count(); heightIndex++) {
-        if (heightIndex == 0) {
-            // First point at start of segment
-        } else if (heightIndex == segment->amslTerrainHeights().count() - 2) {
-            terrainDistance += segment->finalDistanceBetween();
-        } else {
-            terrainDistance += segment->distanceBetween();
-        }
-
-        const double amslTerrainHeight = segment->amslTerrainHeights()[heightIndex].value<double>() * _verticalScale;
-        points.append(QPointF((currentDistance + terrainDistance) * _horizontalScale, amslTerrainHeight));
-    }
-}
-
-void TerrainProfile::_addFlightPoints(FlightPathSegment* segment, double currentDistance, QList<QPointF>& points)
-{
-    if (!_shouldAddFlightProfileSegment(segment)) {
-        if (!points.isEmpty()) {
-            points.append(QPointF(currentDistance * _horizontalScale, qQNaN()));
-        }
-        return;
+        collisionSeries->append(points.collision);
     }
 
-    if (segment->segmentType() == FlightPathSegment::SegmentTypeTerrainFrame) {
-        double terrainDistance = 0;
-        double distanceToSurface = segment->coord1AMSLAlt() - segment->amslTerrainHeights().first().value<double>();
-        for (int heightIndex=0; heightIndex<segment->amslTerrainHeights().count(); heightIndex++) {
-            if (heightIndex == 0) {
-                // First point
-            } else if (heightIndex == segment->amslTerrainHeights().count() - 2) {
-                terrainDistance += segment->finalDistanceBetween();
-            } else {
-                terrainDistance += segment->distanceBetween();
-            }
-
-            const double amslTerrainHeight = (segment->amslTerrainHeights()[heightIndex].value<double>() + distanceToSurface) * _verticalScale;
-            points.append(QPointF((currentDistance + terrainDistance) * _horizontalScale, amslTerrainHeight));
-        }
-    } else {
-        points.append(QPointF(currentDistance * _horizontalScale, segment->coord1AMSLAlt() * _verticalScale));
-        points.append(QPointF((currentDistance + segment->totalDistance()) * _horizontalScale, segment->coord2AMSLAlt() * _verticalScale));
-    }
-}
-
-void TerrainProfile::_addMissingPoints(FlightPathSegment* segment, double currentDistance, QList<QPointF>& points)
-{
-    if (_shouldAddMissingTerrainSegment(segment)) {
-        if (!points.isEmpty()) {
-            points.append(QPointF(currentDistance * _horizontalScale, qQNaN()));
-        }
-        const double minAlt = _minAMSLAlt * _verticalScale;
-        points.append(QPointF(currentDistance * _horizontalScale, minAlt));
-        points.append(QPointF((currentDistance + segment->totalDistance()) * _horizontalScale, minAlt));
-    }
-}
-
-void TerrainProfile::_addCollisionPoints(FlightPathSegment* segment, double currentDistance, QList<QPointF>& points)
-{
-    if (segment->terrainCollision()) {
-        if (!points.isEmpty()) {
-            points.append(QPointF(currentDistance * _horizontalScale, qQNaN()));
-        }
-        points.append(QPointF(currentDistance * _horizontalScale, segment->coord1AMSLAlt() * _verticalScale));
-        points.append(QPointF((currentDistance + segment->totalDistance()) * _horizontalScale, segment->coord2AMSLAlt() * _verticalScale));
-    }
-}
-
-bool TerrainProfile::_shouldAddFlightProfileSegment(FlightPathSegment* segment)
-{
-    bool shouldAdd = !qIsNaN(segment->coord1AMSLAlt()) && !qIsNaN(segment->coord2AMSLAlt());
-    if (segment->segmentType() == FlightPathSegment::SegmentTypeTerrainFrame) {
-        shouldAdd &= segment->amslTerrainHeights().count() != 0;
-    }
-    return shouldAdd;
-}
-
-bool TerrainProfile::_shouldAddMissingTerrainSegment(FlightPathSegment* segment)
-{
-    return segment->amslTerrainHeights().count() == 0;
+    qCDebug(TerrainProfileLog).noquote() << QStringLiteral("updateSeries terrainPoints:%1 flightPoints:%2 missingPoints:%3 collisionPoints:%4 bucketMeters:%5")
+        .arg(points.terrain.count()).arg(points.flight.count()).arg(points.missing.count()).arg(points.collision.count()).arg(bucketMeters);
 }
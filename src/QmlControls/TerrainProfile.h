@@ -1,15 +1,23 @@
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtQuick/QQuickItem>
 #include <QtQmlIntegration/QtQmlIntegration>
 #include <QtGraphs/QXYSeries>
 
+#include "TerrainProfileBlock.h"
+
 class MissionController;
 class QmlObjectListModel;
 class FlightPathSegment;
 
 Q_MOC_INCLUDE("MissionController.h")
 
+/// Terrain and flight altitude profile of the mission for the Plan view terrain chart.
+///
+/// Chart points are cached per flight path segment (TerrainProfileBlock) and only rebuilt for segments which signal a
+/// change, e.g. the two segments next to a waypoint being dragged. The series are assembled from the cached blocks at
+/// their cumulative mission distance, decimated to the visible width.
 class TerrainProfile : public QQuickItem
 {
     Q_OBJECT
@@ -51,15 +59,17 @@ class TerrainProfile : public QQuickItem
 private slots:
     void _newVisualItems            (void);
     void _updateProfile             (void);
+    void _segmentChanged            (void);
+    void _segmentDestroyed          (QObject* segment);
 
 private:
-    void    _updateSegmentCounts            (FlightPathSegment* segment, int& cFlightProfileSegments, int& cTerrainPoints, int& cMissingTerrainSegments, int& cTerrainCollisionSegments, double& minTerrainHeight, double& maxTerrainHeight);
-    void    _addTerrainPoints               (FlightPathSegment* segment, double currentDistance, QList<QPointF>& points);
-    void    _addFlightPoints                (FlightPathSegment* segment, double currentDistance, QList<QPointF>& points);
-    void    _addMissingPoints               (FlightPathSegment* segment, double currentDistance, QList<QPointF>& points);
-    void    _addCollisionPoints             (FlightPathSegment* segment, double currentDistance, QList<QPointF>& points);
-    bool    _shouldAddFlightProfileSegment  (FlightPathSegment* segment);
-    bool    _shouldAddMissingTerrainSegment (FlightPathSegment* segment);
+    /// Calls visitor(FlightPathSegment* segment, double distance) for each segment in mission order. Complex items
+    /// without segments are visited with a null segment and their distance.
+    template<typename Visitor>
+    void _forEachSegment(Visitor&& visitor) const;
+
+    /// @return Cached chart points of the segment, rebuilt if the segment changed since
+    TerrainProfileBlock& _block(FlightPathSegment* segment);
 
     MissionController*  _missionController =    nullptr;
     QmlObjectListModel* _visualItems =          nullptr;
@@ -70,5 +80,7 @@ private slots:
     double              _horizontalScale =      1;
     double              _verticalScale =        1;
 
+    QHash<FlightPathSegment*, TerrainProfileBlock> _blocks;
+
     Q_DISABLE_COPY(TerrainProfile)
 };
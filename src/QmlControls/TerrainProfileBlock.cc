@@ -0,0 +1,163 @@
+#include "TerrainProfileBlock.h"
+
+#include <QtCore/QtMath>
+
+#include <cmath>
+
+TerrainProfileBlock::TerrainProfileBlock(FlightPathSegment::SegmentType segmentType, double coord1AMSLAlt, double coord2AMSLAlt,
+                                         const QList<double> &amslTerrainHeights, double distanceBetween, double finalDistanceBetween,
+                                         double totalDistance, bool terrainCollision)
+    : _totalDistance(totalDistance)
+    , _coord1AMSLAlt(coord1AMSLAlt)
+    , _coord2AMSLAlt(coord2AMSLAlt)
+    , _missingTerrain(amslTerrainHeights.isEmpty())
+    , _terrainCollision(terrainCollision)
+{
+    // Terrain heights are spaced distanceBetween apart, except for the last pair
+    _terrainPoints.reserve(amslTerrainHeights.count());
+    double terrainDistance = 0;
+    for (int heightIndex=0; heightIndex<amslTerrainHeights.count(); heightIndex++) {
+        if (heightIndex == 0) {
+            // First point at start of segment
+        } else if (heightIndex == amslTerrainHeights.count() - 2) {
+            terrainDistance += finalDistanceBetween;
+        } else {
+            terrainDistance += distanceBetween;
+        }
+
+        const double amslTerrainHeight = amslTerrainHeights[heightIndex];
+        _terrainPoints.append(QPointF(terrainDistance, amslTerrainHeight));
+        _minTerrainHeight = std::fmin(_minTerrainHeight, amslTerrainHeight);
+        _maxTerrainHeight = std::fmax(_maxTerrainHeight, amslTerrainHeight);
+    }
+
+    _flightProfile = !qIsNaN(coord1AMSLAlt) && !qIsNaN(coord2AMSLAlt);
+    if (segmentType == FlightPathSegment::SegmentTypeTerrainFrame) {
+        _flightProfile &= !_missingTerrain;
+    }
+    if (!_flightProfile) {
+        return;
+    }
+
+    if (segmentType == FlightPathSegment::SegmentTypeTerrainFrame) {
+        // Flight follows the terrain at the height above terrain of the first coordinate
+        const double distanceToSurface = coord1AMSLAlt - amslTerrainHeights.first();
+        _flightPoints.reserve(_terrainPoints.count());
+        for (const QPointF &terrainPoint : std::as_const(_terrainPoints)) {
+            _flightPoints.append(QPointF(terrainPoint.x(), terrainPoint.y() + distanceToSurface));
+        }
+        _flightProfileSegmentCount = static_cast<int>(_terrainPoints.count()) - 1;
+    } else {
+        _flightPoints.append(QPointF(0, coord1AMSLAlt));
+        _flightPoints.append(QPointF(totalDistance, coord2AMSLAlt));
+        _flightProfileSegmentCount = 1;
+    }
+}
+
+TerrainProfileBlock::TerrainProfileBlock(const FlightPathSegment *segment)
+    : TerrainProfileBlock(segment->segmentType(), segment->coord1AMSLAlt(), segment->coord2AMSLAlt(),
+                          [segment]() {
+                              QList<double> heights;
+                              heights.reserve(segment->amslTerrainHeights().count());
+                              for (const QVariant &height : segment->amslTerrainHeights()) {
+                                  heights.append(height.toDouble());
+                              }
+                              return heights;
+                          }(),
+                          segment->distanceBetween(), segment->finalDistanceBetween(), segment->totalDistance(), segment->terrainCollision())
+{
+}
+
+double TerrainProfileBlock::bucketMeters(double missionDistance, double visibleWidth)
+{
+    if ((missionDistance <= 0) || (visibleWidth <= 0)) {
+        return 0;
+    }
+
+    return std::exp2(std::floor(std::log2(missionDistance / visibleWidth)));
+}
+
+void TerrainProfileBlock::decimate(const QList<QPointF> &points, double bucketWidth, QList<QPointF> &decimated)
+{
+    decimated.clear();
+    if ((points.count() <= 2) || (bucketWidth <= 0)) {
+        decimated = points;
+        return;
+    }
+
+    const int lastIndex = static_cast<int>(points.count()) - 1;
+    decimated.append(points.first());
+
+    int index = 1;
+    while (index < lastIndex) {
+        const double bucket = std::floor(points[index].x() / bucketWidth);
+        int minIndex = index;
+        int maxIndex = index;
+        int next = index + 1;
+        for (; (next < lastIndex) && (std::floor(points[next].x() / bucketWidth) == bucket); next++) {
+            if (points[next].y() < points[minIndex].y()) {
+                minIndex = next;
+            }
+            if (points[next].y() > points[maxIndex].y()) {
+                maxIndex = next;
+            }
+        }
+
+        decimated.append(points[std::min(minIndex, maxIndex)]);
+        if (minIndex != maxIndex) {
+            decimated.append(points[std::max(minIndex, maxIndex)]);
+        }
+        index = next;
+    }
+
+    decimated.append(points.last());
+}
+
+void TerrainProfileBlock::appendTo(SeriesPoints &points, double distance, double bucketMeters, double horizontalScale, double verticalScale, double minAMSLAlt)
+{
+    if (bucketMeters != _decimatedBucketMeters) {
+        decimate(_terrainPoints, bucketMeters, _decimatedTerrainPoints);
+        decimate(_flightPoints, bucketMeters, _decimatedFlightPoints);
+        _decimatedBucketMeters = bucketMeters;
+    }
+
+    const double startX = distance * horizontalScale;
+    const double endX = (distance + _totalDistance) * horizontalScale;
+
+    if (_missingTerrain) {
+        if (!points.terrain.isEmpty()) {
+            points.terrain.append(QPointF(qQNaN(), qQNaN()));
+        }
+    } else {
+        for (const QPointF &point : std::as_const(_decimatedTerrainPoints)) {
+            points.terrain.append(QPointF((distance + point.x()) * horizontalScale, point.y() * verticalScale));
+        }
+    }
+
+    if (!_flightProfile) {
+        if (!points.flight.isEmpty()) {
+            points.flight.append(QPointF(startX, qQNaN()));
+        }
+    } else {
+        for (const QPointF &point : std::as_const(_decimatedFlightPoints)) {
+            points.flight.append(QPointF((distance + point.x()) * horizontalScale, point.y() * verticalScale));
+        }
+    }
+
+    if (_missingTerrain) {
+        if (!points.missing.isEmpty()) {
+            points.missing.append(QPointF(startX, qQNaN()));
+        }
+        const double minAlt = minAMSLAlt * verticalScale;
+        points.missing.append(QPointF(startX, minAlt));
+        points.missing.append(QPointF(endX, minAlt));
+    }
+
+    if (_terrainCollision) {
+        if (!points.collision.isEmpty()) {
+            points.collision.append(QPointF(startX, qQNaN()));
+        }
+        points.collision.append(QPointF(startX, _coord1AMSLAlt * verticalScale));
+        points.collision.append(QPointF(endX, _coord2AMSLAlt * verticalScale));
+    }
+}
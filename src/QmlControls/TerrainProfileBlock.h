@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+#include <QtCore/QtNumeric>
+
+#include "FlightPathSegment.h"
+
+/// Chart points of one flight path segment for TerrainProfile.
+///
+/// Points are kept relative to the start of the segment and unscaled, so a block stays valid while the segments
+/// before it change length; the chart position and units are applied when the block is appended. Terrain and terrain
+/// following flight points are decimated to the min/max pair of each bucket. Bucket widths are powers of two meters,
+/// so the small change in mission length from dragging a waypoint does not invalidate the decimated points of every
+/// other block.
+class TerrainProfileBlock
+{
+public:
+    /// Points for the four TerrainProfile series, NaN points separate the pieces of a series
+    struct SeriesPoints {
+        QList<QPointF> terrain;
+        QList<QPointF> flight;
+        QList<QPointF> missing;
+        QList<QPointF> collision;
+
+        qsizetype count() const { return terrain.count() + flight.count() + missing.count() + collision.count(); }
+    };
+
+    TerrainProfileBlock() = default;
+    TerrainProfileBlock(FlightPathSegment::SegmentType segmentType, double coord1AMSLAlt, double coord2AMSLAlt,
+                        const QList<double> &amslTerrainHeights, double distanceBetween, double finalDistanceBetween,
+                        double totalDistance, bool terrainCollision);
+    explicit TerrainProfileBlock(const FlightPathSegment *segment);
+
+    double totalDistance() const { return _totalDistance; }
+    bool missingTerrain() const { return _missingTerrain; }
+    bool terrainCollision() const { return _terrainCollision; }
+    int flightProfileSegmentCount() const { return _flightProfileSegmentCount; }
+    int terrainPointCount() const { return static_cast<int>(_terrainPoints.count()); }
+    double minTerrainHeight() const { return _minTerrainHeight; }
+    double maxTerrainHeight() const { return _maxTerrainHeight; }
+
+    /// Appends the block to the series
+    /// @param distance Mission distance at the start of the segment
+    /// @param bucketMeters Decimation bucket width from bucketMeters(), 0 for all points
+    /// @param minAMSLAlt Chart minimum, missing terrain is drawn along it
+    void appendTo(SeriesPoints &points, double distance, double bucketMeters, double horizontalScale, double verticalScale, double minAMSLAlt);
+
+    /// @return Decimation bucket width giving at most two buckets per pixel, 0 if the chart has no width
+    static double bucketMeters(double missionDistance, double visibleWidth);
+
+    /// Replaces @p decimated with the first and last points of @p points plus the lowest and highest point of each
+    /// @p bucketWidth wide bucket in between, in x order
+    static void decimate(const QList<QPointF> &points, double bucketWidth, QList<QPointF> &decimated);
+
+private:
+    double          _totalDistance =             0;
+    double          _coord1AMSLAlt =             qQNaN();
+    double          _coord2AMSLAlt =             qQNaN();
+    double          _minTerrainHeight =          qQNaN();
+    double          _maxTerrainHeight =          qQNaN();
+    bool            _missingTerrain =            true;
+    bool            _flightProfile =             false;
+    bool            _terrainCollision =          false;
+    int             _flightProfileSegmentCount = 0;
+    QList<QPointF>  _terrainPoints;
+    QList<QPointF>  _flightPoints;
+
+    double          _decimatedBucketMeters =     -1;    ///< Bucket width the decimated points were built for
+    QList<QPointF>  _decimatedTerrainPoints;
+    QList<QPointF>  _decimatedFlightPoints;
+};
@@ -94,6 +94,15 @@ bool QGCMapEngine::addTask(QGCMapTask *task)
     return result;
 }
 
+QGCTileCacheIndex::Lookup QGCMapEngine::lookupTile(const QString &hash) const
+{
+    if (!m_worker) {
+        return QGCTileCacheIndex::Lookup::Unknown;
+    }
+
+    return m_worker->lookupTile(hash);
+}
+
 void QGCMapEngine::_updateTotals(quint32 totaltiles, quint64 totalsize, quint32 defaulttiles, quint64 defaultsize)
 {
     emit updateTotals(totaltiles, totalsize, defaulttiles, defaultsize);
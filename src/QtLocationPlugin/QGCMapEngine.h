@@ -3,6 +3,8 @@
 #include <QtCore/QObject>
 #include <QtCore/QString>
 
+#include "QGCTileCacheIndex.h"
+
 class QGCMapTask;
 class QGCCacheWorker;
 
@@ -17,6 +19,9 @@ class QGCMapEngine : public QObject
     void init(const QString &databasePath);
     bool addTask(QGCMapTask *task);
 
+    /// @return Absent if the tile is definitely not in the cache database, see QGCTileCacheIndex
+    QGCTileCacheIndex::Lookup lookupTile(const QString &hash) const;
+
     /// Stops the cache worker thread and closes the database. Call before
     /// QCoreApplication teardown when the engine was initialized outside the
     /// normal QML map lifecycle (e.g. unit test runs).
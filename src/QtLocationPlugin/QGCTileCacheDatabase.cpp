@@ -266,6 +266,34 @@ std::optional<quint64> QGCTileCacheDatabase::findTile(const QString &hash)
     return std::nullopt;
 }
 
+std::optional<quint64> QGCTileCacheDatabase::getTileHashes(quint64 afterTileID, int count, QStringList &hashes)
+{
+    if (!_ensureConnected()) {
+        return std::nullopt;
+    }
+
+    QSqlQuery query(_database());
+    query.setForwardOnly(true);
+    if (!query.prepare("SELECT tileID, hash FROM Tiles WHERE tileID > ? ORDER BY tileID LIMIT ?")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare getTileHashes):" << query.lastError().text();
+        return std::nullopt;
+    }
+    query.addBindValue(afterTileID);
+    query.addBindValue(count);
+    if (!query.exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (getTileHashes):" << query.lastError().text();
+        return std::nullopt;
+    }
+
+    quint64 lastTileID = afterTileID;
+    while (query.next()) {
+        lastTileID = query.value(0).toULongLong();
+        hashes.append(query.value(1).toString());
+    }
+
+    return lastTileID;
+}
+
 QList<TileSetRecord> QGCTileCacheDatabase::getTileSets()
 {
     QList<TileSetRecord> records;
@@ -672,7 +700,7 @@ bool QGCTileCacheDatabase::updateAllTileDownloadStates(quint64 setID, int state)
     return true;
 }
 
-bool QGCTileCacheDatabase::pruneCache(quint64 amount)
+bool QGCTileCacheDatabase::pruneCache(quint64 amount, QStringList *prunedHashes)
 {
     if (!_ensureConnected()) {
         return false;
@@ -693,11 +721,13 @@ bool QGCTileCacheDatabase::pruneCache(quint64 amount)
         }
 
         QList<quint64> tileIDs;
+        QStringList hashes;
         while (query.next() && (remaining > 0)) {
             tileIDs << query.value(0).toULongLong();
             const quint64 sz = query.value(1).toULongLong();
             remaining = (sz >= remaining) ? 0 : remaining - sz;
-            qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << query.value(2).toString();
+            hashes << query.value(2).toString();
+            qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << hashes.last();
         }
 
         if (tileIDs.isEmpty()) {
@@ -716,6 +746,10 @@ bool QGCTileCacheDatabase::pruneCache(quint64 amount)
         if (!txn.commit()) {
             return false;
         }
+
+        if (prunedHashes) {
+            prunedHashes->append(hashes);
+        }
     }
 
     return true;
@@ -3,6 +3,7 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 
 #include <memory>
 #include <optional>
@@ -34,6 +35,11 @@ class QGCTileCacheDatabase
     std::unique_ptr<QGCCacheTile> getTile(const QString &hash);
     std::optional<quint64> findTile(const QString &hash);
 
+    /// Reads up to @p count tile hashes with a tileID above @p afterTileID, in tileID order.
+    /// Used to stream the Tiles table in small steps without holding a long read transaction.
+    /// @return Highest tileID read (afterTileID if none), nullopt on error
+    std::optional<quint64> getTileHashes(quint64 afterTileID, int count, QStringList &hashes);
+
     // Tile Sets
     QList<TileSetRecord> getTileSets();
     std::optional<quint64> createTileSet(const QString &name, const QString &mapTypeStr,
@@ -51,7 +57,7 @@ class QGCTileCacheDatabase
     bool updateAllTileDownloadStates(quint64 setID, int state);
 
     // Cache
-    bool pruneCache(quint64 amount);
+    bool pruneCache(quint64 amount, QStringList *prunedHashes = nullptr);
     void deleteBingNoTileTiles();
 
     // Stats
@@ -0,0 +1,139 @@
+#include "QGCTileCacheIndex.h"
+
+namespace {
+
+/// Spreads the fingerprint bits over the table index (murmur3 finalizer)
+inline quint64 _mix(quint64 value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+QGCTileCacheIndex::QGCTileCacheIndex()
+    : _slots(kInitialCapacity, kEmpty)
+{
+}
+
+quint64 QGCTileCacheIndex::_fingerprint(QStringView hash)
+{
+    // FNV-1a, 64 bit on every platform unlike qHash
+    quint64 fingerprint = 0xcbf29ce484222325ULL;
+    for (const QChar ch : hash) {
+        fingerprint ^= ch.unicode();
+        fingerprint *= 0x100000001b3ULL;
+    }
+    return (fingerprint == kEmpty) ? 1 : fingerprint;
+}
+
+qsizetype QGCTileCacheIndex::_find(quint64 fingerprint) const
+{
+    const qsizetype mask = static_cast<qsizetype>(_slots.size()) - 1;
+    for (qsizetype i = static_cast<qsizetype>(_mix(fingerprint)) & mask; ; i = (i + 1) & mask) {
+        if (_slots[i] == fingerprint) {
+            return i;
+        }
+        if (_slots[i] == kEmpty) {
+            return -1;
+        }
+    }
+}
+
+QGCTileCacheIndex::Lookup QGCTileCacheIndex::lookup(QStringView hash) const
+{
+    if (!isReady()) {
+        return Lookup::Unknown;
+    }
+
+    const quint64 fingerprint = _fingerprint(hash);
+    QReadLocker locker(&_lock);
+    if (_find(fingerprint) >= 0) {
+        return Lookup::Present;
+    }
+    // The removed tile may have shared this fingerprint with one which is still cached
+    return _removedFingerprints.contains(fingerprint) ? Lookup::Unknown : Lookup::Absent;
+}
+
+void QGCTileCacheIndex::_insert(quint64 fingerprint)
+{
+    const qsizetype mask = static_cast<qsizetype>(_slots.size()) - 1;
+    for (qsizetype i = static_cast<qsizetype>(_mix(fingerprint)) & mask; ; i = (i + 1) & mask) {
+        if (_slots[i] == fingerprint) {
+            return;
+        }
+        if (_slots[i] == kEmpty) {
+            _slots[i] = fingerprint;
+            _count++;
+            return;
+        }
+    }
+}
+
+void QGCTileCacheIndex::_grow()
+{
+    std::vector<quint64> old(_slots.size() * 2, kEmpty);
+    old.swap(_slots);
+    _count = 0;
+    for (const quint64 fingerprint : old) {
+        if (fingerprint != kEmpty) {
+            _insert(fingerprint);
+        }
+    }
+}
+
+void QGCTileCacheIndex::insert(QStringView hash)
+{
+    const quint64 fingerprint = _fingerprint(hash);
+    QWriteLocker locker(&_lock);
+    if (((_count + 1) * 2) > static_cast<qsizetype>(_slots.size())) {
+        _grow();
+    }
+    _insert(fingerprint);
+    (void) _removedFingerprints.remove(fingerprint);
+}
+
+void QGCTileCacheIndex::remove(QStringView hash)
+{
+    const quint64 fingerprint = _fingerprint(hash);
+    QWriteLocker locker(&_lock);
+
+    qsizetype hole = _find(fingerprint);
+    if (hole < 0) {
+        return;
+    }
+
+    // Backward shift deletion: pull later entries of the probe run into the hole so no tombstones are needed
+    const qsizetype mask = static_cast<qsizetype>(_slots.size()) - 1;
+    for (qsizetype next = (hole + 1) & mask; _slots[next] != kEmpty; next = (next + 1) & mask) {
+        const qsizetype home = static_cast<qsizetype>(_mix(_slots[next])) & mask;
+        const bool homeBetween = (hole <= next) ? ((hole < home) && (home <= next)) : ((hole < home) || (home <= next));
+        if (!homeBetween) {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+    }
+    _slots[hole] = kEmpty;
+    _count--;
+    (void) _removedFingerprints.insert(fingerprint);
+}
+
+void QGCTileCacheIndex::clear()
+{
+    setReady(false);
+
+    QWriteLocker locker(&_lock);
+    std::vector<quint64>(kInitialCapacity, kEmpty).swap(_slots);
+    _count = 0;
+    _removedFingerprints.clear();
+}
+
+qsizetype QGCTileCacheIndex::count() const
+{
+    QReadLocker locker(&_lock);
+    return _count;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QSet>
+#include <QtCore/QStringView>
+#include <QtCore/QtTypes>
+
+#include <atomic>
+#include <vector>
+
+/// In-memory membership index of the tile hashes held by the cache database.
+///
+/// Lets a tile request which is definitely not cached go straight to the network instead of waiting for an SQLite
+/// miss on the cache worker thread. Only a 64 bit fingerprint of each hash is kept, in an open addressing table, so a
+/// large cache costs a few bytes per tile. A fingerprint collision can produce a false "present", which just falls
+/// back to the normal cache round trip. Removing a tile can also drop a fingerprint another cached tile shares, so
+/// fingerprints removed since the last clear() answer Unknown instead of Absent until they are inserted again. That
+/// keeps "absent" answers exact.
+///
+/// The index is filled by the cache worker while it streams the Tiles table in the background. Until that completes
+/// lookup() answers Unknown. Lookups may happen from any thread.
+class QGCTileCacheIndex
+{
+public:
+    enum class Lookup {
+        Unknown,    ///< Index not built yet or fingerprint removed, ask the database
+        Present,    ///< Probably cached
+        Absent      ///< Definitely not cached
+    };
+
+    QGCTileCacheIndex();
+
+    Lookup lookup(QStringView hash) const;
+
+    void insert(QStringView hash);
+    void remove(QStringView hash);
+
+    /// Drops all entries and marks the index as not ready
+    void clear();
+
+    bool isReady() const { return _ready.load(std::memory_order_acquire); }
+    void setReady(bool ready) { _ready.store(ready, std::memory_order_release); }
+
+    qsizetype count() const;
+
+private:
+    static quint64 _fingerprint(QStringView hash);
+    qsizetype _find(quint64 fingerprint) const;
+    void _insert(quint64 fingerprint);
+    void _grow();
+
+    static constexpr quint64 kEmpty = 0;
+    static constexpr qsizetype kInitialCapacity = 1024;
+
+    mutable QReadWriteLock _lock;
+    std::vector<quint64> _slots;    ///< Power of two sized, kept at most half full
+    qsizetype _count = 0;
+    QSet<quint64> _removedFingerprints; ///< Removed since the last clear() and not inserted again
+    std::atomic_bool _ready = false;
+};
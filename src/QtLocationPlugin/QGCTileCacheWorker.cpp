@@ -97,6 +97,7 @@ void QGCCacheWorker::run()
     }
 
     _dbValid = _database->isValid();
+    _resetTileIndex();
 
     _updateTimer.start();
 
@@ -106,6 +107,10 @@ void QGCCacheWorker::run()
             QGCMapTask* const task = _taskQueue.dequeue();
             lock.unlock();
             _runTask(task);
+            // Keep the index build moving even when tile requests never let the queue drain
+            if (_tileIndexBuilding && (++_tasksSinceIndexStep >= kIndexBuildTaskInterval)) {
+                _buildTileIndexStep();
+            }
             lock.relock();
             task->deleteLater();
 
@@ -123,6 +128,10 @@ void QGCCacheWorker::run()
                     lock.relock();
                 }
             }
+        } else if (_tileIndexBuilding) {
+            lock.unlock();
+            _buildTileIndexStep();
+            lock.relock();
         } else {
             (void) _waitc.wait(lock.mutex(), 5000);
         }
@@ -136,6 +145,8 @@ void QGCCacheWorker::run()
     lock.unlock();
 
     _dbValid = false;
+    _tileIndex.clear();
+    _tileIndexBuilding = false;
     if (_database) {
         _database->disconnectDB();
         _database.reset();
@@ -199,6 +210,51 @@ bool QGCCacheWorker::_testTask(QGCMapTask *mtask)
     return true;
 }
 
+QGCTileCacheIndex::Lookup QGCCacheWorker::lookupTile(const QString &hash) const
+{
+#ifdef QGC_UNITTEST_BUILD
+    // Misses must reach _getTile so the synthetic tile generator can answer them
+    if (QGC::runningUnitTests() && _unitTestTileGenerator) {
+        return QGCTileCacheIndex::Lookup::Unknown;
+    }
+#endif
+
+    return _tileIndex.lookup(hash);
+}
+
+void QGCCacheWorker::_resetTileIndex()
+{
+    _tileIndex.clear();
+    _tileIndexCursor = 0;
+    _tasksSinceIndexStep = 0;
+    _tileIndexBuilding = _database && _database->isValid();
+}
+
+void QGCCacheWorker::_buildTileIndexStep()
+{
+    _tasksSinceIndexStep = 0;
+
+    QStringList hashes;
+    const std::optional<quint64> lastTileID = _database->getTileHashes(_tileIndexCursor, kIndexBuildBatchSize, hashes);
+    if (!lastTileID.has_value()) {
+        // Index stays not ready, every request keeps going through the database
+        qCWarning(QGCTileCacheWorkerLog) << "Failed to build tile index";
+        _tileIndexBuilding = false;
+        return;
+    }
+
+    for (const QString &hash : std::as_const(hashes)) {
+        _tileIndex.insert(hash);
+    }
+    _tileIndexCursor = lastTileID.value();
+
+    if (hashes.size() < kIndexBuildBatchSize) {
+        _tileIndexBuilding = false;
+        _tileIndex.setReady(true);
+        qCDebug(QGCTileCacheWorkerLog) << "Tile index ready:" << _tileIndex.count() << "tiles";
+    }
+}
+
 void QGCCacheWorker::_emitTotals()
 {
     TotalsResult t = _database->computeTotals();
@@ -216,7 +272,9 @@ void QGCCacheWorker::_saveTile(QGCMapTask *mtask)
     if (!_database->saveTile(task->tile()->hash, task->tile()->format,
                              task->tile()->img, task->tile()->type, task->tile()->tileSet)) {
         mtask->setError("Error saving tile to cache");
+        return;
     }
+    _tileIndex.insert(task->tile()->hash);
 }
 
 void QGCCacheWorker::_getTile(QGCMapTask *mtask)
@@ -362,7 +420,13 @@ void QGCCacheWorker::_pruneCache(QGCMapTask *mtask)
     }
 
     QGCPruneCacheTask *task = static_cast<QGCPruneCacheTask*>(mtask);
-    if (!_database->pruneCache(task->amount())) {
+    QStringList prunedHashes;
+    const bool pruned = _database->pruneCache(task->amount(), &prunedHashes);
+    // Batches committed before a failure are gone from the database as well
+    for (const QString &hash : std::as_const(prunedHashes)) {
+        _tileIndex.remove(hash);
+    }
+    if (!pruned) {
         mtask->setError("Error pruning cache");
         return;
     }
@@ -375,6 +439,8 @@ void QGCCacheWorker::_deleteTileSet(QGCMapTask *mtask)
         return;
     }
 
+    // Tiles removed with the set stay in the tile index. A stale entry only costs the regular database lookup,
+    // only a missing entry would be wrong.
     QGCDeleteTileSetTask *task = static_cast<QGCDeleteTileSetTask*>(mtask);
     if (!_database->deleteTileSet(task->setID())) {
         mtask->setError("Error deleting tile set");
@@ -408,6 +474,7 @@ void QGCCacheWorker::_resetCacheDatabase(QGCMapTask *mtask)
         return;
     }
     _dbValid = _database->isValid();
+    _resetTileIndex();
     task->setResetCompleted();
 }
 
@@ -428,6 +495,8 @@ void QGCCacheWorker::_importSets(QGCMapTask *mtask)
     }
 
     _dbValid = _database->isValid();
+    // Imported tiles are not tracked one by one, stream the table again
+    _resetTileIndex();
 
     if (!result.success) {
         task->setError(result.errorString);
@@ -9,6 +9,8 @@
 
 #include <memory>
 
+#include "QGCTileCacheIndex.h"
+
 #ifdef QGC_UNITTEST_BUILD
 #include <functional>
 #endif
@@ -30,6 +32,12 @@ class QGCCacheWorker : public QThread
 
     void setDatabaseFile(const QString &path) { if (isRunning()) { return; } _databasePath = path; }
 
+    /// Thread-safe check against the in-memory tile index, lets callers skip the database round trip for tiles which
+    /// are definitely not cached. Unknown while the index is still being built.
+    QGCTileCacheIndex::Lookup lookupTile(const QString &hash) const;
+
+    const QGCTileCacheIndex &tileIndex() const { return _tileIndex; }
+
 #ifdef QGC_UNITTEST_BUILD
     /// Unit-test hook: consulted on tile cache miss to synthesize a tile instead of
     /// erroring, so tests never fall back to real network fetches. Only active while
@@ -69,6 +77,8 @@ public slots:
     void _exportSets(QGCMapTask *task);
     bool _testTask(QGCMapTask *task);
     void _emitTotals();
+    void _resetTileIndex();
+    void _buildTileIndexStep();
 
     std::unique_ptr<QGCTileCacheDatabase> _database;
     QMutex _taskQueueMutex;
@@ -80,8 +90,15 @@ public slots:
     std::atomic_bool _dbValid = false;
     std::atomic_bool _stopRequested = false;
 
+    QGCTileCacheIndex _tileIndex;
+    quint64 _tileIndexCursor = 0;       ///< Highest tileID streamed into the index so far
+    bool _tileIndexBuilding = false;
+    int _tasksSinceIndexStep = 0;
+
     static constexpr int kShortTimeoutMs = 2000;
     static constexpr int kLongTimeoutMs = 5000;
+    static constexpr int kIndexBuildBatchSize = 4096;   ///< Hashes streamed per index build step
+    static constexpr int kIndexBuildTaskInterval = 8;   ///< A build step is also run every this many tasks while busy
 
 #ifdef QGC_UNITTEST_BUILD
     static std::function<QGCCacheTile*(const QString&)> _unitTestTileGenerator;
@@ -50,12 +50,15 @@ bool QGeoTiledMapReplyQGC::init()
         setCached(false);
     }, Qt::AutoConnection);
 
-    QGCFetchTileTask *task = QGeoFileTileCacheQGC::createFetchTileTask(UrlFactory::getProviderTypeFromQtMapId(tileSpec().mapId()), tileSpec().x(), tileSpec().y(), tileSpec().zoom());
-    if (!task) {
-        qCWarning(QGeoTiledMapReplyQGCLog) << "Failed to create fetch tile task";
-        m_initialized = false;
-        return false;
+    const QString hash = UrlFactory::getTileHash(UrlFactory::getProviderTypeFromQtMapId(tileSpec().mapId()), tileSpec().x(), tileSpec().y(), tileSpec().zoom());
+    if (getQGCMapEngine()->lookupTile(hash) == QGCTileCacheIndex::Lookup::Absent) {
+        // Definite miss: no point queueing behind the cache worker for an SQLite miss
+        qCDebug(QGeoTiledMapReplyQGCLog) << "Tile not cached:" << hash;
+        _fetchFromNetwork();
+        return true;
     }
+
+    QGCFetchTileTask *task = new QGCFetchTileTask(hash);
     (void) connect(task, &QGCFetchTileTask::tileFetched, this, &QGeoTiledMapReplyQGC::_cacheReply);
     (void) connect(task, &QGCMapTask::error, this, &QGeoTiledMapReplyQGC::_cacheError);
     if (!getQGCMapEngine()->addTask(task)) {
@@ -197,6 +200,11 @@ void QGeoTiledMapReplyQGC::_cacheError(QGCMapTask::TaskType type, QStringView er
 
     Q_ASSERT(type == QGCMapTask::TaskType::taskFetchTile);
 
+    _fetchFromNetwork();
+}
+
+void QGeoTiledMapReplyQGC::_fetchFromNetwork()
+{
     if (!QGCNetworkHelper::isInternetAvailable()) {
         setError(QGeoTiledMapReply::CommunicationError, tr("Network Not Available"));
         return;
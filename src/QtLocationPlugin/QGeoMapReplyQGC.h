@@ -30,6 +30,7 @@ private slots:
 
 private:
     static void _initDataFromResources();
+    void _fetchFromNetwork();
 
     QNetworkAccessManager *_networkManager = nullptr;
     QNetworkRequest _request;
@@ -34,7 +34,12 @@ DECLARE_SETTINGSFACT(MavlinkSettings, saveCsvTelemetry)
 DECLARE_SETTINGSFACT(MavlinkSettings, forwardMavlink)
 DECLARE_SETTINGSFACT(MavlinkSettings, forwardMavlinkHostName)
 DECLARE_SETTINGSFACT(MavlinkSettings, forwardMavlinkAPMSupportHostName)
+DECLARE_SETTINGSFACT(MavlinkSettings, sharedMemoryExport)
+DECLARE_SETTINGSFACT(MavlinkSettings, sharedMemoryExportName)
+DECLARE_SETTINGSFACT(MavlinkSettings, sharedMemoryExportOtherUsers)
 DECLARE_SETTINGSFACT(MavlinkSettings, sendGCSHeartbeat)
 DECLARE_SETTINGSFACT(MavlinkSettings, gcsMavlinkSystemID)
 DECLARE_SETTINGSFACT(MavlinkSettings, saveSensorLog)
 DECLARE_SETTINGSFACT(MavlinkSettings, noInitialDownloadWhenFlying)
+DECLARE_SETTINGSFACT(MavlinkSettings, adaptiveRateControl)
+DECLARE_SETTINGSFACT(MavlinkSettings, adaptiveRateBudget)
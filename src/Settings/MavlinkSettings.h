@@ -22,11 +22,16 @@ class MavlinkSettings : public SettingsGroup
     DEFINE_SETTINGFACT(forwardMavlink)
     DEFINE_SETTINGFACT(forwardMavlinkHostName)
     DEFINE_SETTINGFACT(forwardMavlinkAPMSupportHostName)
+    DEFINE_SETTINGFACT(sharedMemoryExport)
+    DEFINE_SETTINGFACT(sharedMemoryExportName)
+    DEFINE_SETTINGFACT(sharedMemoryExportOtherUsers)
     DEFINE_SETTINGFACT(sendGCSHeartbeat)
     DEFINE_SETTINGFACT(gcsMavlinkSystemID)
     DEFINE_SETTINGFACT(saveSensorLog)
 
     DEFINE_SETTINGFACT(noInitialDownloadWhenFlying)
+    DEFINE_SETTINGFACT(adaptiveRateControl)
+    DEFINE_SETTINGFACT(adaptiveRateBudget)
 
     // Although this is a global setting it only affects ArduPilot vehicle since PX4 automatically starts the stream from the vehicle side
     DEFINE_SETTINGFACT(apmStartMavlinkStreams)
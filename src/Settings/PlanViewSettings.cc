@@ -13,3 +13,4 @@ DECLARE_SETTINGSFACT(PlanViewSettings, showGimbalOnlyWhenSet)
 DECLARE_SETTINGSFACT(PlanViewSettings, vtolTransitionDistance)
 DECLARE_SETTINGSFACT(PlanViewSettings, showROIToolstrip)
 DECLARE_SETTINGSFACT(PlanViewSettings, missionDownload)
+DECLARE_SETTINGSFACT(PlanViewSettings, importSimplifyTolerance)
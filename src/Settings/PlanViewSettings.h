@@ -24,4 +24,5 @@ class PlanViewSettings : public SettingsGroup
     DEFINE_SETTINGFACT(vtolTransitionDistance)
     DEFINE_SETTINGFACT(showROIToolstrip)
     DEFINE_SETTINGFACT(missionDownload)
+    DEFINE_SETTINGFACT(importSimplifyTolerance)
 };
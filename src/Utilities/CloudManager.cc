@@ -3,6 +3,7 @@
 #include "CloudSettings.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
+#include "QGCChunkedUpload.h"
 #include "QGCFileDownload.h"
 #include "QGCLoggingCategory.h"
 
@@ -21,6 +22,10 @@
 #include <QDateTime>
 #include <QtQml/qqml.h>
 #include <QtCore/QProcess>
+#include <QtCore/QBuffer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSettings>
+#include <QtConcurrent/QtConcurrentRun>
 
 QGC_LOGGING_CATEGORY(CloudManagerLog, "Utilities.CloudManager")
 
@@ -204,6 +209,7 @@ void CloudManager::uploadJsonFile(const QJsonDocument &jsonDoc,
         fileName = QString("mission_%1.plan").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
     }
 
+    // Plan documents are small, building them in memory is fine
     QByteArray jsonData = jsonDoc.toJson(QJsonDocument::Compact);
     uploadFile(jsonData, bucketName, fileName, "application/octet-stream");
 }
@@ -213,32 +219,91 @@ void CloudManager::uploadFile(const QByteArray &fileData,
                               const QString &originalFileName,
                               const QString &mimeType)
 {
-    // 고유한 파일 ID 생성
-    QString fileId = QUuid::createUuid().toString(QUuid::WithoutBraces);
-
-    // 안전한 파일명 생성 (UUID + 확장자)
-    QString safeFileName = generateUniqueFileName(originalFileName);
-
-    // 체크섬 계산
-    QString checksum = calculateChecksum(fileData);
-
     // 업로드 컨텍스트 생성
     UploadContext context;
-    context.fileId = fileId;
+    context.fileId = QUuid::createUuid().toString(QUuid::WithoutBraces);
     context.originalName = originalFileName;
-    context.storagePath = createStoragePath(bucketName, safeFileName);
+    context.storagePath = createStoragePath(bucketName, generateUniqueFileName(originalFileName));
     context.bucketName = bucketName;
     context.fileSize = fileData.size();
     context.mimeType = mimeType;
     context.uploadTime = QDateTime::currentDateTime();
-    context.checksum = checksum;
 
-    qCDebug(CloudManagerLog) << "Starting upload:"
-                             << "FileId:" << fileId
-                             << "Original:" << originalFileName
-                             << "Storage:" << context.storagePath;
+    // Plan sized data, hashing it here is cheaper than a worker round trip
+    context.checksum = QString::fromLatin1(QCryptographicHash::hash(fileData, QCryptographicHash::Sha256).toHex());
+
+    QBuffer *const buffer = new QBuffer(this);
+    buffer->setData(fileData);
+    (void) buffer->open(QIODevice::ReadOnly);
+
+    // In memory data can not survive a restart, so there is nothing to resume
+    startUpload(buffer, context, QString());
+}
+
+void CloudManager::uploadLocalFile(const QString &filePath,
+                                   const QString &bucketName,
+                                   const QString &mimeType)
+{
+    QFile *const file = new QFile(filePath, this);
+    if (!file->open(QIODevice::ReadOnly)) {
+        const QString errorMessage = QString("Upload failed: %1").arg(file->errorString());
+        qCWarning(CloudManagerLog) << errorMessage << filePath;
+        qgcApp()->showAppMessage(tr("클라우드 저장소 업로드에 실패하였습니다.") + errorMessage);
+        file->deleteLater();
+        emit uploadFinished(QString(), false, errorMessage);
+        return;
+    }
+
+    const QFileInfo fileInfo(filePath);
+    const QString resumeKey = QString("%1|%2|%3|%4").arg(bucketName, fileInfo.absoluteFilePath())
+                                                    .arg(fileInfo.size())
+                                                    .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+
+    // A resumed upload must keep the object name and file id of the interrupted one
+    QSettings settings;
+    settings.beginGroup(resumeSettingsGroup(resumeKey));
+
+    UploadContext context;
+    context.fileId = settings.value(kResumeFileId, QUuid::createUuid().toString(QUuid::WithoutBraces)).toString();
+    context.originalName = fileInfo.fileName();
+    context.storagePath = settings.value(kResumeStoragePath, createStoragePath(bucketName, generateUniqueFileName(context.originalName))).toString();
+    context.bucketName = bucketName;
+    context.fileSize = file->size();
+    context.mimeType = mimeType;
+    context.uploadTime = QDateTime::currentDateTime();
+    // The resume key covers size and modification time, so a checksum stored with it is still valid
+    context.checksum = settings.value(kResumeChecksum).toString();
+
+    settings.setValue(kResumeFileId, context.fileId);
+    settings.setValue(kResumeStoragePath, context.storagePath);
+    settings.endGroup();
+
+    if (!context.checksum.isEmpty()) {
+        startUpload(file, context, resumeKey);
+        return;
+    }
 
-    uploadFileInternal(fileData, context);
+    // The checksum goes into the tus creation request, so it is needed before the upload starts. Hash on a worker
+    // thread from a separate handle so a large log does not stall the GUI.
+    (void) QtConcurrent::run(&CloudManager::calculateChecksum, fileInfo.absoluteFilePath())
+        .then(this, [this, file, context, resumeKey](const QString &checksum) mutable {
+            if (checksum.isEmpty()) {
+                const QString errorMessage = QString("Upload failed: could not read %1").arg(file->fileName());
+                qCWarning(CloudManagerLog) << errorMessage;
+                qgcApp()->showAppMessage(tr("클라우드 저장소 업로드에 실패하였습니다.") + errorMessage);
+                file->deleteLater();
+                emit uploadFinished(QString(), false, errorMessage);
+                return;
+            }
+
+            QSettings settings;
+            settings.beginGroup(resumeSettingsGroup(resumeKey));
+            settings.setValue(kResumeChecksum, checksum);
+            settings.endGroup();
+
+            context.checksum = checksum;
+            startUpload(file, context, resumeKey);
+        });
 }
 
 QString CloudManager::generateUniqueFileName(const QString &originalName)
@@ -261,39 +326,73 @@ QString CloudManager::extractFileExtension(const QString &fileName)
     return QString();
 }
 
-void CloudManager::uploadFileInternal(const QByteArray &fileData, const UploadContext &context)
+void CloudManager::startUpload(QIODevice *device, const UploadContext &context, const QString &resumeKey)
 {
-    // 프록시 설정 임시 변경
-    QNetworkProxy savedProxy = _nam->proxy();
-    QNetworkProxy tempProxy;
-    tempProxy.setType(QNetworkProxy::DefaultProxy);
-    _nam->setProxy(tempProxy);
+    if (!_nam) {
+        _nam = new QNetworkAccessManager(this);
+    }
 
-    // 업로드 요청 생성
-    QNetworkRequest request = createUploadRequest(context.storagePath);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, context.mimeType);
+    qCDebug(CloudManagerLog) << "Starting upload:"
+                             << "FileId:" << context.fileId
+                             << "Original:" << context.originalName
+                             << "Storage:" << context.storagePath
+                             << "Size:" << context.fileSize;
+
+    QGCChunkedUpload *const upload = new QGCChunkedUpload(_nam, this);
+    device->setParent(upload);
 
-    // 추가 헤더 설정
-    request.setRawHeader("x-file-id", context.fileId.toUtf8());
-    request.setRawHeader("x-original-name", context.originalName.toUtf8());
-    request.setRawHeader("x-checksum", context.checksum.toUtf8());
+    // Supabase storage tus endpoint, chunks must be exactly 6 MiB and concatenation is not supported
+    upload->setEndpoint(QUrl(QString("https://%1/storage/v1/upload/resumable").arg(m_supabaseEndpoint)));
+    upload->setChunkSize(QGCChunkedUpload::kDefaultChunkSize);
+    upload->setParallelStreams(1);
+    upload->setResumeKey(resumeKey);
+
+    // HTTP/2 negotiation can fail with some proxies, causing upload failures.
+    // Disable it to fall back to HTTP/1.1.
+    QGCNetworkHelper::RequestConfig config;
+    config.http2Allowed = false;
+    upload->setRequestConfig(config);
 
-    // 업로드 실행
-    QNetworkReply *reply = _nam->put(request, fileData);
+    // 인증 헤더 설정
+    upload->setRawHeader("apikey", m_apiAnonKey.toUtf8());
+    upload->setRawHeader("Authorization", QString("Bearer %1").arg(m_accessToken).toUtf8());
+    upload->setRawHeader("x-upsert", "true"); // 덮어쓰기 허용
+
+    const qsizetype bucketPrefix = context.bucketName.size() + (context.bucketName.endsWith('/') ? 0 : 1);
+    upload->setMetadata("bucketName", context.bucketName);
+    upload->setMetadata("objectName", context.storagePath.mid(bucketPrefix));
+    upload->setMetadata("contentType", context.mimeType);
+    // Stored by the storage server as the object's user metadata
+    const QJsonObject objectMetadata{
+        { "fileId", context.fileId },
+        { "originalName", context.originalName },
+        { "checksum", context.checksum },
+    };
+    upload->setMetadata("metadata", QString::fromUtf8(QJsonDocument(objectMetadata).toJson(QJsonDocument::Compact)));
 
-    // 컨텍스트 저장
     UploadContext contextCopy = context;
-    contextCopy.reply = reply;
-    _activeUploads[reply] = contextCopy;
+    contextCopy.upload = upload;
+    contextCopy.resumeKey = resumeKey;
+    _activeUploads[upload] = contextCopy;
 
-    // 시그널 연결
-    connect(reply, &QNetworkReply::finished, this, &CloudManager::onUploadFinished);
-    connect(reply, &QNetworkReply::uploadProgress, this, [this, fileId = context.fileId](qint64 bytesSent, qint64 bytesTotal) {
+    (void) connect(upload, &QGCChunkedUpload::progress, this, [this, fileId = context.fileId](qint64 bytesSent, qint64 bytesTotal) {
         emit uploadProgress(fileId, bytesSent, bytesTotal);
     });
+    (void) connect(upload, &QGCChunkedUpload::chunkUploaded, this, [](int, qint64 offset, qint64 size, double bytesPerSecond) {
+        qCDebug(CloudManagerLog) << "Uploaded chunk at" << offset << "size" << size << formatThroughput(bytesPerSecond);
+    });
+    (void) connect(upload, &QGCChunkedUpload::finished, this, [this, upload](bool success, const QUrl &, const QString &errorString) {
+        onUploadFinished(upload, success, errorString);
+    });
 
-    // 프록시 복원
-    _nam->setProxy(savedProxy);
+    if (!upload->start(device)) {
+        onUploadFinished(upload, false, upload->errorString());
+    }
+}
+
+QString CloudManager::formatThroughput(double bytesPerSecond)
+{
+    return QString("%1 KB/s").arg(bytesPerSecond / 1024.0, 0, 'f', 1);
 }
 
 QString CloudManager::createStoragePath(const QString &bucketName, const QString &fileName)
@@ -307,46 +406,46 @@ QString CloudManager::createStoragePath(const QString &bucketName, const QString
     return QString("%1missions/%2").arg(cleanBucketName, fileName);
 }
 
-QNetworkRequest CloudManager::createUploadRequest(const QString &storagePath)
+QString CloudManager::calculateChecksum(const QString &filePath)
 {
-    QString endpoint = QString("https://%1/storage/v1/object/%2")
-    .arg(m_supabaseEndpoint, storagePath);
-
-    QUrl url(endpoint);
-    QNetworkRequest request(url);
-
-    // HTTP/2 negotiation can fail with some proxies, causing upload failures.
-    // Disable it to fall back to HTTP/1.1.
-    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
-
-    // 인증 헤더 설정
-    request.setRawHeader("apikey", m_apiAnonKey.toUtf8());
-    request.setRawHeader("Authorization", QString("Bearer %1").arg(m_accessToken).toUtf8());
-
-    // 추가 헤더
-    request.setRawHeader("x-upsert", "true"); // 덮어쓰기 허용
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
 
-    return request;
+    // Streamed so large files are never loaded as a whole
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        return QString();
+    }
+    return QString::fromLatin1(hash.result().toHex());
 }
 
-QString CloudManager::calculateChecksum(const QByteArray &data)
+QString CloudManager::resumeSettingsGroup(const QString &resumeKey)
 {
-    return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+    const QByteArray digest = QCryptographicHash::hash(resumeKey.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QString("%1/%2").arg(kResumableUploadsGroup, QString::fromLatin1(digest));
 }
 
-void CloudManager::onUploadFinished()
+void CloudManager::onUploadFinished(QGCChunkedUpload *upload, bool success, const QString &errorString)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !_activeUploads.contains(reply)) {
+    if (!_activeUploads.contains(upload)) {
         return;
     }
 
-    UploadContext context = _activeUploads.take(reply);
+    UploadContext context = _activeUploads.take(upload);
 
-    if (reply->error() == QNetworkReply::NoError) {
-        qCDebug(CloudManagerLog) << "Upload successful:" << context.fileId;
+    if (success) {
+        qCDebug(CloudManagerLog) << "Upload successful:" << context.fileId
+                                 << "resumed" << upload->bytesResumed() << "bytes,"
+                                 << formatThroughput(upload->throughput());
         qgcApp()->showAppMessage(tr("클라우드 저장소에 업로드되었습니다."));
 
+        if (!context.resumeKey.isEmpty()) {
+            QSettings settings;
+            settings.remove(resumeSettingsGroup(context.resumeKey));
+        }
+
         // 메타데이터 저장
         FileMetadata metadata;
         metadata.fileId = context.fileId;
@@ -362,14 +461,14 @@ void CloudManager::onUploadFinished()
 
         emit uploadFinished(context.fileId, true);
     } else {
-        QString errorMessage = QString("Upload failed: %1").arg(reply->errorString());
+        QString errorMessage = QString("Upload failed: %1").arg(errorString);
         qgcApp()->showAppMessage(tr("클라우드 저장소 업로드에 실패하였습니다.") + errorMessage);
         qCWarning(CloudManagerLog) << errorMessage;
-        handleUploadError(reply, errorMessage);
+        handleUploadError(errorMessage);
         emit uploadFinished(context.fileId, false, errorMessage);
     }
 
-    reply->deleteLater();
+    upload->deleteLater();
 }
 
 void CloudManager::saveFileMetadata(const FileMetadata &metadata)
@@ -445,10 +544,9 @@ void CloudManager::setSupabaseConfig(const QString &endpoint, const QString &ano
     m_accessToken = accessToken;
 }
 
-void CloudManager::handleUploadError(QNetworkReply *reply, const QString &errorMessage)
+void CloudManager::handleUploadError(const QString &errorMessage)
 {
-    // 에러 로깅 및 재시도 로직 등을 여기에 구현
-    Q_UNUSED(reply)
+    // Transient failures were already retried by QGCChunkedUpload, resume state is kept for uploadLocalFile()
     qCCritical(CloudManagerLog) << "Upload error:" << errorMessage;
 }
 
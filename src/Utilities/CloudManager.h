@@ -36,6 +36,7 @@ struct FileMetadata {
 
 class CloudManager;
 class DatabaseManager;
+class QGCChunkedUpload;
 
 class CloudManager : public QObject
 {
@@ -86,6 +87,10 @@ class CloudManager : public QObject
                     const QString &bucketName,
                     const QString &originalFileName,
                     const QString &mimeType = "application/octet-stream");
+    /// Streams the file from disk in chunks. An interrupted upload of the same (unmodified) file resumes.
+    Q_INVOKABLE void uploadLocalFile(const QString &filePath,
+                                     const QString &bucketName,
+                                     const QString &mimeType = "application/octet-stream");
     void getListBucket(const QString &bucketName);
     void setSignedIn (bool signedIn);
     void setSignedId (QString signedId);
@@ -124,7 +129,6 @@ class CloudManager : public QObject
 public slots:
     void signInReplyReadyRead();
     void uploadProgress(qint64 bytesSent, qint64 bytesTotal);
-    void onUploadFinished();
     void onDownloadFinished(QNetworkReply* reply, const QString& objectName);
 
 signals:
@@ -171,7 +175,8 @@ private slots:
         QString mimeType;
         QDateTime uploadTime;
         QString checksum;
-        QNetworkReply* reply;
+        QString resumeKey;
+        QGCChunkedUpload* upload = nullptr;
     };
 
     static const QString API_BASE_URL;
@@ -182,12 +187,16 @@ private slots:
     static constexpr const char* kCloudManagerGroup = "CloudManagerGroup";
     static constexpr const char* kEmailAddress      = "Email";
     static constexpr const char* kPassword          = "Password";
+    static constexpr const char* kResumableUploadsGroup = "CloudManagerResumableUploads";
+    static constexpr const char* kResumeFileId      = "fileId";
+    static constexpr const char* kResumeStoragePath = "storagePath";
+    static constexpr const char* kResumeChecksum    = "checksum";
 
     QNetworkInformation *m_networkInfo = nullptr;
     QNetworkAccessManager *_nam;
     QNetworkReply *m_networkReply;
     QNetworkRequest m_networkRequest;
-    QHash<QNetworkReply*, UploadContext> _activeUploads;
+    QHash<QGCChunkedUpload*, UploadContext> _activeUploads;
     QString databaseUrl;
     QString m_networkStatus;
     QString _emailAddress;
@@ -236,11 +245,14 @@ private slots:
     bool isAccessTokenExpired(const QString &token);
 
     QString createStoragePath(const QString &bucketName, const QString &fileName);
-    QNetworkRequest createUploadRequest(const QString &storagePath);
     QNetworkRequest createMetadataRequest();
-    QString calculateChecksum(const QByteArray &data);
-    void uploadFileInternal(const QByteArray &fileData, const UploadContext &context);
-    void handleUploadError(QNetworkReply *reply, const QString &errorMessage);
+    /// SHA-256 of the file as hex, empty on read failure. Thread safe, runs on a worker thread.
+    static QString calculateChecksum(const QString &filePath);
+    void startUpload(QIODevice *device, const UploadContext &context, const QString &resumeKey);
+    void onUploadFinished(QGCChunkedUpload *upload, bool success, const QString &errorString);
+    void handleUploadError(const QString &errorMessage);
+    static QString formatThroughput(double bytesPerSecond);
+    static QString resumeSettingsGroup(const QString &resumeKey);
     void deleteFileMetadata(const QString &storagePath, const QString &bucketName);
 };
 
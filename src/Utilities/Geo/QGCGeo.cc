@@ -12,7 +12,11 @@
 
 #include <QtCore/QString>
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/Geodesic.hpp>
@@ -24,6 +28,49 @@
 
 QGC_LOGGING_CATEGORY(QGCGeoLog, "Utilities.QGCGeo")
 
+namespace
+{
+
+double _segmentDistance(const QPointF &point, const QPointF &a, const QPointF &b)
+{
+    const QPointF ab = b - a;
+    const double lengthSquared = QPointF::dotProduct(ab, ab);
+    QPointF closest = a;
+    if (lengthSquared > 0.0) {
+        const double t = std::clamp(QPointF::dotProduct(point - a, ab) / lengthSquared, 0.0, 1.0);
+        closest = a + (ab * t);
+    }
+    return std::hypot(point.x() - closest.x(), point.y() - closest.y());
+}
+
+double _cross(const QPointF &origin, const QPointF &a, const QPointF &b)
+{
+    return ((a.x() - origin.x()) * (b.y() - origin.y())) - ((a.y() - origin.y()) * (b.x() - origin.x()));
+}
+
+bool _withinBounds(const QPointF &point, const QPointF &a, const QPointF &b)
+{
+    return (std::min(a.x(), b.x()) <= point.x()) && (point.x() <= std::max(a.x(), b.x())) &&
+           (std::min(a.y(), b.y()) <= point.y()) && (point.y() <= std::max(a.y(), b.y()));
+}
+
+/// Touching or overlapping segments count as intersecting
+bool _segmentsIntersect(const QPointF &a1, const QPointF &a2, const QPointF &b1, const QPointF &b2)
+{
+    const double d1 = _cross(b1, b2, a1);
+    const double d2 = _cross(b1, b2, a2);
+    const double d3 = _cross(a1, a2, b1);
+    const double d4 = _cross(a1, a2, b2);
+    if ((((d1 > 0) && (d2 < 0)) || ((d1 < 0) && (d2 > 0))) && (((d3 > 0) && (d4 < 0)) || ((d3 < 0) && (d4 > 0)))) {
+        return true;
+    }
+
+    return ((d1 == 0) && _withinBounds(a1, b1, b2)) || ((d2 == 0) && _withinBounds(a2, b1, b2)) ||
+           ((d3 == 0) && _withinBounds(b1, a1, a2)) || ((d4 == 0) && _withinBounds(b2, a1, a2));
+}
+
+} // namespace
+
 namespace QGCGeo
 {
 
@@ -53,6 +100,29 @@ void convertGeoToNed(const QGeoCoordinate &coord, const QGeoCoordinate &origin,
     z = -up;
 }
 
+QList<QPointF> convertGeoToNed(const QList<QGeoCoordinate> &coords, const QGeoCoordinate &origin)
+{
+    QList<QPointF> ned;
+    ned.reserve(coords.size());
+
+    const double originAlt = std::isnan(origin.altitude()) ? 0.0 : origin.altitude();
+    const GeographicLib::LocalCartesian ltp(origin.latitude(), origin.longitude(), originAlt,
+                                            GeographicLib::Geocentric::WGS84());
+    for (const QGeoCoordinate &coord : coords) {
+        if (coord == origin) {
+            ned.append(QPointF(0.0, 0.0));
+            continue;
+        }
+
+        const double coordAlt = std::isnan(coord.altitude()) ? 0.0 : coord.altitude();
+        double east, north, up;
+        ltp.Forward(coord.latitude(), coord.longitude(), coordAlt, east, north, up);
+        ned.append(QPointF(north, east));
+    }
+
+    return ned;
+}
+
 void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin, QGeoCoordinate &coord)
 {
     // Convert NED to ENU
@@ -371,4 +441,142 @@ QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoord
     return QGeoCoordinate(lat, lon, alt);
 }
 
+QList<QGeoCoordinate> simplifyPath(const QList<QGeoCoordinate> &path, double toleranceMeters, bool closed)
+{
+    const int count = static_cast<int>(path.size());
+    const int minVertices = closed ? 3 : 2;
+    if ((toleranceMeters <= 0.0) || (count <= minVertices)) {
+        return path;
+    }
+
+    // Flat projection around the first vertex. A polygon repeats its first vertex at the end so
+    // it simplifies as a single open span like a path does.
+    QList<QPointF> points = convertGeoToNed(path, path.first());
+    if (closed) {
+        points.append(points.first());
+    }
+    const int last = static_cast<int>(points.size()) - 1;
+
+    const auto farthest = [&points](int first, int end, double &distance) {
+        int index = -1;
+        distance = -1.0;
+        for (int i = first + 1; i < end; i++) {
+            const double pointDistance = _segmentDistance(points[i], points[first], points[end]);
+            if (pointDistance > distance) {
+                distance = pointDistance;
+                index = i;
+            }
+        }
+        return index;
+    };
+
+    std::vector<bool> keep(points.size(), false);
+    keep[0] = true;
+    keep[last] = true;
+
+    std::vector<std::pair<int, int>> stack;
+    stack.emplace_back(0, last);
+    while (!stack.empty()) {
+        const auto [first, end] = stack.back();
+        stack.pop_back();
+
+        double distance;
+        const int split = farthest(first, end, distance);
+        // The first span of a polygon starts and ends on the same vertex, it always has to split
+        const bool mustSplit = closed && (first == 0) && (end == last);
+        if ((split < 0) || ((distance <= toleranceMeters) && !mustSplit)) {
+            continue;
+        }
+        keep[split] = true;
+        stack.emplace_back(first, split);
+        stack.emplace_back(split, end);
+    }
+
+    // Split spans whose edge crosses another edge of the result until none do. Spans which can not split
+    // any further are edges of the original outline, which crossed to begin with.
+    std::vector<int> kept;
+    while (true) {
+        kept.clear();
+        for (int i = 0; i <= last; i++) {
+            if (keep[i]) {
+                kept.push_back(i);
+            }
+        }
+
+        if (closed && (kept.size() < 4)) {
+            // Less than 3 distinct vertices, keep the most significant remaining one
+            double bestDistance = -1.0;
+            int best = -1;
+            for (size_t edge = 0; (edge + 1) < kept.size(); edge++) {
+                double distance;
+                const int split = farthest(kept[edge], kept[edge + 1], distance);
+                if ((split >= 0) && (distance > bestDistance)) {
+                    bestDistance = distance;
+                    best = split;
+                }
+            }
+            if (best >= 0) {
+                keep[best] = true;
+                continue;
+            }
+        }
+
+        const int edgeCount = static_cast<int>(kept.size()) - 1;
+        const auto minX = [&](int edge) { return std::min(points[kept[edge]].x(), points[kept[edge + 1]].x()); };
+        const auto maxX = [&](int edge) { return std::max(points[kept[edge]].x(), points[kept[edge + 1]].x()); };
+
+        // Sweep the edges in x order, only edges overlapping in x can cross
+        std::vector<int> order(edgeCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return minX(a) < minX(b); });
+
+        std::vector<bool> crossing(edgeCount, false);
+        for (int i = 0; i < edgeCount; i++) {
+            const int a = order[i];
+            const QPointF &a1 = points[kept[a]];
+            const QPointF &a2 = points[kept[a + 1]];
+            for (int j = i + 1; (j < edgeCount) && (minX(order[j]) <= maxX(a)); j++) {
+                const int b = order[j];
+                const int lowEdge = std::min(a, b);
+                const int highEdge = std::max(a, b);
+                const bool adjacent = ((highEdge - lowEdge) == 1) || (closed && (lowEdge == 0) && (highEdge == (edgeCount - 1)));
+                if (adjacent) {
+                    continue;
+                }
+                if (_segmentsIntersect(a1, a2, points[kept[b]], points[kept[b + 1]])) {
+                    crossing[a] = true;
+                    crossing[b] = true;
+                }
+            }
+        }
+
+        bool splitAny = false;
+        for (int edge = 0; edge < edgeCount; edge++) {
+            if (crossing[edge]) {
+                double distance;
+                const int split = farthest(kept[edge], kept[edge + 1], distance);
+                if (split >= 0) {
+                    keep[split] = true;
+                    splitAny = true;
+                }
+            }
+        }
+        if (!splitAny) {
+            break;
+        }
+    }
+
+    QList<QGeoCoordinate> simplified;
+    simplified.reserve(static_cast<qsizetype>(kept.size()));
+    for (const int index : kept) {
+        if (index < count) {
+            simplified.append(path[index]);
+        }
+    }
+
+    qCDebug(QGCGeoLog) << "simplifyPath" << count << "->" << simplified.size() << "vertices at" << toleranceMeters << "m";
+
+    return simplified;
+}
+
 } // namespace QGCGeo
@@ -22,6 +22,8 @@
 ///
 /// All conversions use the WGS84 ellipsoid model for accuracy.
 
+#include <QtCore/QList>
+#include <QtCore/QPointF>
 #include <QtGui/QVector3D>
 #include <QtPositioning/QGeoCoordinate>
 
@@ -49,6 +51,13 @@ void convertGeoToNed(const QGeoCoordinate &coord, const QGeoCoordinate &origin,
 /// @param[out] coord Resulting geodetic coordinate.
 void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin, QGeoCoordinate &coord);
 
+/// Convert many geodetic coordinates to NED relative to the same origin.
+/// Same results as convertGeoToNed() per coordinate, but the local tangent plane is only set up once.
+/// @param coords Geodetic coordinates to convert.
+/// @param origin Reference point for local tangent plane.
+/// @return North (x) and East (y) components in meters, Down is dropped.
+QList<QPointF> convertGeoToNed(const QList<QGeoCoordinate> &coords, const QGeoCoordinate &origin);
+
 // ============================================================================
 // ENU (East-North-Up) Local Tangent Plane
 // ============================================================================
@@ -189,4 +198,13 @@ QList<QGeoCoordinate> interpolatePath(const QGeoCoordinate &from, const QGeoCoor
 /// @note Useful for midpoint: interpolateAtDistance(from, to, geodesicDistance(from, to) / 2)
 QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoordinate &to, double distance);
 
+/// Simplify a path or polygon with Douglas-Peucker without changing its topology.
+/// A simplified edge which would cross another edge of the result keeps its span split until it no longer does,
+/// so a simple outline stays simple.
+/// @param path Vertices to simplify.
+/// @param toleranceMeters Maximum distance of a dropped vertex from the simplified outline, 0 or less returns path as is.
+/// @param closed True if path is a polygon (last vertex connects back to the first).
+/// @return Subset of path in the original order. Both ends of a path are kept, a polygon keeps at least 3 vertices.
+QList<QGeoCoordinate> simplifyPath(const QList<QGeoCoordinate> &path, double toleranceMeters, bool closed);
+
 } // namespace QGCGeo
@@ -0,0 +1,516 @@
+#include "QGCChunkedUpload.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QSettings>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+
+QGC_LOGGING_CATEGORY(QGCChunkedUploadLog, "Utilities.QGCChunkedUpload")
+
+namespace {
+
+constexpr const char *kResumeSizeKey = "size";
+constexpr const char *kResumeBeginsKey = "begins";
+constexpr const char *kResumeEndsKey = "ends";
+constexpr const char *kResumeUrlsKey = "urls";
+constexpr const char *kResumeOffsetsKey = "offsets";
+
+int _statusCode(const QNetworkReply *reply)
+{
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+}
+
+qint64 _uploadOffset(const QNetworkReply *reply)
+{
+    bool ok = false;
+    const qint64 offset = reply->rawHeader("Upload-Offset").toLongLong(&ok);
+    return ok ? offset : -1;
+}
+
+} // namespace
+
+QGCChunkedUpload::QGCChunkedUpload(QNetworkAccessManager *networkManager, QObject *parent)
+    : QObject(parent)
+    , _networkManager(networkManager)
+{
+    qCDebug(QGCChunkedUploadLog) << "Created" << this;
+}
+
+QGCChunkedUpload::~QGCChunkedUpload()
+{
+    qCDebug(QGCChunkedUploadLog) << "Destroying" << this;
+    cancel();
+}
+
+// ============================================================================
+// Public
+// ============================================================================
+
+bool QGCChunkedUpload::start(QIODevice *device)
+{
+    if (isRunning()) {
+        qCWarning(QGCChunkedUploadLog) << "Upload already in progress";
+        return false;
+    }
+
+    if (!_endpoint.isValid()) {
+        _errorString = tr("Invalid upload endpoint");
+        qCWarning(QGCChunkedUploadLog) << _errorString << _endpoint;
+        return false;
+    }
+
+    if (!device || !device->isOpen() || !device->isReadable() || device->isSequential()) {
+        _errorString = tr("Upload source must be an open, random access device");
+        qCWarning(QGCChunkedUploadLog) << _errorString;
+        return false;
+    }
+
+    _device = device;
+    _bytesTotal = device->size();
+    _bytesSent = 0;
+    _uploadUrl.clear();
+    _errorString.clear();
+    _streams.clear();
+    _sessionTimer.start();
+    _setState(State::Preparing);
+
+    if (!_loadResumeState()) {
+        // Ranges are whole multiples of the chunk size so only the very last chunk of the device is short
+        const qint64 chunkCount = qMax<qint64>(1, (_bytesTotal + _chunkSize - 1) / _chunkSize);
+        const qint64 streamCount = qMin<qint64>(_parallelStreams, chunkCount);
+        const qint64 chunksPerStream = (chunkCount + streamCount - 1) / streamCount;
+
+        for (qint64 begin = 0; (begin < _bytesTotal) || _streams.empty(); begin += chunksPerStream * _chunkSize) {
+            Stream stream;
+            stream.begin = begin;
+            stream.end = qMin(_bytesTotal, begin + (chunksPerStream * _chunkSize));
+            _streams.push_back(stream);
+        }
+    } else {
+        qCDebug(QGCChunkedUploadLog) << "Resuming upload" << _resumeKey;
+    }
+
+    qCDebug(QGCChunkedUploadLog) << "Uploading" << _bytesTotal << "bytes in" << _streams.size() << "stream(s)";
+
+    for (int i = 0; i < static_cast<int>(_streams.size()); i++) {
+        if (_streams[i].url.isEmpty()) {
+            _createStream(i);
+        } else {
+            _resyncStream(i);
+        }
+    }
+
+    return true;
+}
+
+void QGCChunkedUpload::cancel()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    // Resume state is kept, a later start() with the same key picks the upload up again
+    _setState(State::Cancelled);
+    for (Stream &stream : _streams) {
+        if (stream.reply) {
+            stream.reply->abort();
+        }
+    }
+    if (_finalReply) {
+        _finalReply->abort();
+    }
+
+    _errorString = tr("Upload cancelled");
+    emit finished(false, QUrl(), _errorString);
+}
+
+qint64 QGCChunkedUpload::bytesUploaded() const
+{
+    qint64 bytes = 0;
+    for (const Stream &stream : _streams) {
+        bytes += stream.offset;
+    }
+    return bytes;
+}
+
+double QGCChunkedUpload::throughput() const
+{
+    const qint64 elapsed = _sessionTimer.isValid() ? _sessionTimer.elapsed() : 0;
+    return (elapsed > 0) ? ((_bytesSent * 1000.0) / elapsed) : 0.0;
+}
+
+void QGCChunkedUpload::clearResumeState(const QString &key)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+
+    QSettings settings;
+    settings.remove(_resumeGroup(key));
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+QNetworkRequest QGCChunkedUpload::_request(const QUrl &url) const
+{
+    QGCNetworkHelper::RequestConfig config = _requestConfig;
+    config.cacheEnabled = false;
+
+    QNetworkRequest request = QGCNetworkHelper::createRequest(url, config);
+    request.setRawHeader("Tus-Resumable", kTusVersion);
+    for (auto it = _headers.cbegin(); it != _headers.cend(); ++it) {
+        request.setRawHeader(it.key(), it.value());
+    }
+    return request;
+}
+
+QByteArray QGCChunkedUpload::_encodedMetadata() const
+{
+    QByteArrayList pairs;
+    for (auto it = _metadata.cbegin(); it != _metadata.cend(); ++it) {
+        pairs.append(it.key().toUtf8() + ' ' + it.value().toUtf8().toBase64());
+    }
+    return pairs.join(',');
+}
+
+void QGCChunkedUpload::_createStream(int index)
+{
+    Stream &stream = _streams[index];
+    stream.offset = 0;
+
+    QNetworkRequest request = _request(_endpoint);
+    request.setRawHeader("Upload-Length", QByteArray::number(stream.length()));
+    if (_streams.size() > 1) {
+        request.setRawHeader("Upload-Concat", "partial");
+    } else if (!_metadata.isEmpty()) {
+        request.setRawHeader("Upload-Metadata", _encodedMetadata());
+    }
+
+    QNetworkReply *const reply = _networkManager->post(request, QByteArray());
+    stream.reply = reply;
+    (void) connect(reply, &QNetworkReply::finished, this, [this, index, reply]() {
+        reply->deleteLater();
+        if (!isRunning()) {
+            return;
+        }
+
+        const QByteArray location = reply->rawHeader("Location");
+        if ((reply->error() != QNetworkReply::NoError) || (_statusCode(reply) != 201) || location.isEmpty()) {
+            _streamRequestFailed(index, reply);
+            return;
+        }
+
+        Stream &created = _streams[index];
+        created.url = _endpoint.resolved(QUrl(QString::fromLatin1(location)));
+        qCDebug(QGCChunkedUploadLog) << "Stream" << index << "created" << created.url;
+        _saveResumeState();
+        _sendChunk(index);
+    });
+}
+
+void QGCChunkedUpload::_resyncStream(int index)
+{
+    Stream &stream = _streams[index];
+
+    QNetworkReply *const reply = _networkManager->head(_request(stream.url));
+    stream.reply = reply;
+    (void) connect(reply, &QNetworkReply::finished, this, [this, index, reply]() {
+        reply->deleteLater();
+        if (!isRunning()) {
+            return;
+        }
+
+        Stream &resynced = _streams[index];
+        const int status = _statusCode(reply);
+        if ((status == 404) || (status == 410)) {
+            // Server discarded the upload (e.g. expired), start this range over
+            qCDebug(QGCChunkedUploadLog) << "Stream" << index << "gone on server, recreating";
+            resynced.url.clear();
+            _createStream(index);
+            return;
+        }
+
+        const qint64 offset = _uploadOffset(reply);
+        if ((reply->error() != QNetworkReply::NoError) || (offset < 0) || (offset > resynced.length())) {
+            _streamRequestFailed(index, reply);
+            return;
+        }
+
+        resynced.offset = offset;
+        qCDebug(QGCChunkedUploadLog) << "Stream" << index << "server offset" << offset << "of" << resynced.length();
+        emit progress(bytesUploaded(), _bytesTotal);
+        _sendChunk(index);
+    });
+}
+
+void QGCChunkedUpload::_sendChunk(int index)
+{
+    Stream &stream = _streams[index];
+    if (stream.done()) {
+        _checkComplete();
+        return;
+    }
+
+    if (_state == State::Preparing) {
+        _setState(State::Uploading);
+    }
+
+    // Only one chunk per stream is ever held in memory
+    const qint64 size = qMin(_chunkSize, stream.length() - stream.offset);
+    if (!_device->seek(stream.begin + stream.offset)) {
+        _fail(tr("Could not seek upload source: %1").arg(_device->errorString()));
+        return;
+    }
+    const QByteArray chunk = _device->read(size);
+    if (chunk.size() != size) {
+        _fail(tr("Could not read upload source: %1").arg(_device->errorString()));
+        return;
+    }
+
+    QNetworkRequest request = _request(stream.url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArrayLiteral("application/offset+octet-stream"));
+    request.setRawHeader("Upload-Offset", QByteArray::number(stream.offset));
+
+    stream.chunkSize = size;
+    stream.chunkTimer.start();
+    QNetworkReply *const reply = _networkManager->sendCustomRequest(request, QByteArrayLiteral("PATCH"), chunk);
+    stream.reply = reply;
+    (void) connect(reply, &QNetworkReply::finished, this, [this, index, reply]() {
+        reply->deleteLater();
+        if (!isRunning()) {
+            return;
+        }
+
+        Stream &patched = _streams[index];
+        const int status = _statusCode(reply);
+        if (status == 409) {
+            // Offset mismatch, the retry asks the server where it is. Counted as a retry so a server which keeps
+            // disagreeing with its own HEAD offset (stale lock, rewriting proxy) cannot keep the upload looping.
+            qCDebug(QGCChunkedUploadLog) << "Stream" << index << "offset conflict, resyncing";
+            _streamRequestFailed(index, reply);
+            return;
+        }
+
+        const qint64 offset = _uploadOffset(reply);
+        if ((reply->error() != QNetworkReply::NoError) || (status != 204) || (offset <= patched.offset) || (offset > patched.length())) {
+            _streamRequestFailed(index, reply);
+            return;
+        }
+
+        const qint64 sent = offset - patched.offset;
+        const qint64 chunkOffset = patched.begin + patched.offset;
+        const qint64 elapsed = qMax<qint64>(1, patched.chunkTimer.elapsed());
+        patched.offset = offset;
+        patched.retries = 0;
+        _bytesSent += sent;
+
+        emit chunkUploaded(index, chunkOffset, sent, (sent * 1000.0) / elapsed);
+        emit progress(bytesUploaded(), _bytesTotal);
+        _saveResumeState();
+        _sendChunk(index);
+    });
+}
+
+void QGCChunkedUpload::_streamRequestFailed(int index, QNetworkReply *reply)
+{
+    const int status = _statusCode(reply);
+    const QString error = (reply->error() != QNetworkReply::NoError) ? reply->errorString() : QGCNetworkHelper::httpStatusText(status);
+
+    // Client errors other than timeouts/offset conflicts/throttling/locks will not go away by retrying
+    const bool permanent = QGCNetworkHelper::isHttpClientError(status) && (status != 408) && (status != 409) && (status != 423) && (status != 429);
+    int &retries = (index < 0) ? _streams.front().retries : _streams[index].retries;
+    if (permanent || (++retries > _maxRetries)) {
+        _fail(tr("Upload failed: %1").arg(error));
+        return;
+    }
+
+    const int delayMs = kRetryBaseDelayMs << qMin(retries - 1, 6);
+    qCDebug(QGCChunkedUploadLog) << "Stream" << index << "request failed:" << error << "retry" << retries << "in" << delayMs << "ms";
+    QTimer::singleShot(delayMs, this, [this, index]() {
+        _retryStream(index);
+    });
+}
+
+void QGCChunkedUpload::_retryStream(int index)
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    if (index < 0) {
+        _finalize();
+    } else if (_streams[index].url.isEmpty()) {
+        _createStream(index);
+    } else {
+        // The failed chunk may have partially landed, always ask first
+        _resyncStream(index);
+    }
+}
+
+void QGCChunkedUpload::_checkComplete()
+{
+    for (const Stream &stream : _streams) {
+        if (!stream.done()) {
+            return;
+        }
+    }
+
+    if (_streams.size() == 1) {
+        _complete(_streams.front().url);
+    } else {
+        _finalize();
+    }
+}
+
+void QGCChunkedUpload::_finalize()
+{
+    if (_finalReply) {
+        return;
+    }
+
+    _setState(State::Finalizing);
+
+    QByteArrayList urls;
+    for (const Stream &stream : _streams) {
+        urls.append(stream.url.toEncoded());
+    }
+
+    QNetworkRequest request = _request(_endpoint);
+    request.setRawHeader("Upload-Concat", "final;" + urls.join(' '));
+    if (!_metadata.isEmpty()) {
+        request.setRawHeader("Upload-Metadata", _encodedMetadata());
+    }
+
+    QNetworkReply *const reply = _networkManager->post(request, QByteArray());
+    _finalReply = reply;
+    (void) connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        _finalReply.clear();
+        if (!isRunning()) {
+            return;
+        }
+
+        const QByteArray location = reply->rawHeader("Location");
+        if ((reply->error() != QNetworkReply::NoError) || (_statusCode(reply) != 201) || location.isEmpty()) {
+            _streamRequestFailed(-1, reply);
+            return;
+        }
+
+        _complete(_endpoint.resolved(QUrl(QString::fromLatin1(location))));
+    });
+}
+
+void QGCChunkedUpload::_complete(const QUrl &url)
+{
+    _uploadUrl = url;
+    clearResumeState(_resumeKey);
+
+    qCDebug(QGCChunkedUploadLog) << "Upload complete" << url << _bytesSent << "bytes sent," << bytesResumed()
+                                 << "resumed," << qRound64(throughput()) << "B/s";
+
+    _setState(State::Completed);
+    emit finished(true, _uploadUrl, QString());
+}
+
+void QGCChunkedUpload::_fail(const QString &errorString)
+{
+    _setState(State::Failed);
+    for (Stream &stream : _streams) {
+        if (stream.reply) {
+            stream.reply->abort();
+        }
+    }
+    if (_finalReply) {
+        _finalReply->abort();
+    }
+
+    _errorString = errorString;
+    qCWarning(QGCChunkedUploadLog) << errorString;
+    emit finished(false, QUrl(), _errorString);
+}
+
+void QGCChunkedUpload::_setState(State state)
+{
+    if (_state != state) {
+        _state = state;
+        emit stateChanged(state);
+    }
+}
+
+// ============================================================================
+// Resume State
+// ============================================================================
+
+QString QGCChunkedUpload::_resumeGroup(const QString &key)
+{
+    const QByteArray digest = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStringLiteral("%1/%2").arg(QLatin1String(kSettingsGroup), QString::fromLatin1(digest));
+}
+
+bool QGCChunkedUpload::_loadResumeState()
+{
+    if (_resumeKey.isEmpty()) {
+        return false;
+    }
+
+    QSettings settings;
+    settings.beginGroup(_resumeGroup(_resumeKey));
+    if (!settings.contains(kResumeSizeKey)) {
+        return false;
+    }
+
+    const QVariantList begins = settings.value(kResumeBeginsKey).toList();
+    const QVariantList ends = settings.value(kResumeEndsKey).toList();
+    const QStringList urls = settings.value(kResumeUrlsKey).toStringList();
+    const QVariantList offsets = settings.value(kResumeOffsetsKey).toList();
+    const bool consistent = (settings.value(kResumeSizeKey).toLongLong() == _bytesTotal) && !begins.isEmpty() &&
+                            (begins.size() == ends.size()) && (begins.size() == urls.size()) && (begins.size() == offsets.size());
+    if (!consistent) {
+        // Source changed since the state was saved
+        settings.endGroup();
+        settings.remove(_resumeGroup(_resumeKey));
+        return false;
+    }
+
+    for (qsizetype i = 0; i < begins.size(); i++) {
+        Stream stream;
+        stream.begin = begins[i].toLongLong();
+        stream.end = ends[i].toLongLong();
+        stream.url = QUrl(urls[i]);
+        // Only a hint for progress, the server offset wins once the stream resyncs
+        stream.offset = stream.url.isEmpty() ? 0 : offsets[i].toLongLong();
+        _streams.push_back(stream);
+    }
+
+    return true;
+}
+
+void QGCChunkedUpload::_saveResumeState() const
+{
+    if (_resumeKey.isEmpty()) {
+        return;
+    }
+
+    QVariantList begins;
+    QVariantList ends;
+    QStringList urls;
+    QVariantList offsets;
+    for (const Stream &stream : _streams) {
+        begins.append(stream.begin);
+        ends.append(stream.end);
+        urls.append(stream.url.toString());
+        offsets.append(stream.offset);
+    }
+
+    QSettings settings;
+    settings.beginGroup(_resumeGroup(_resumeKey));
+    settings.setValue(kResumeSizeKey, _bytesTotal);
+    settings.setValue(kResumeBeginsKey, begins);
+    settings.setValue(kResumeEndsKey, ends);
+    settings.setValue(kResumeUrlsKey, urls);
+    settings.setValue(kResumeOffsetsKey, offsets);
+}
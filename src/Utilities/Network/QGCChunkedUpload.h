@@ -0,0 +1,160 @@
+#pragma once
+
+/// @file QGCChunkedUpload.h
+/// @brief Streaming, resumable chunked upload engine (tus 1.0.0 protocol)
+
+#include "QGCNetworkHelper.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QUrl>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <vector>
+
+class QIODevice;
+class QNetworkAccessManager;
+
+/// \brief Uploads a QIODevice in fixed size chunks using the tus resumable upload protocol
+///
+/// Features:
+/// - Reads the device one chunk at a time, memory use is bounded by chunkSize * parallelStreams
+/// - Upload URLs and offsets are persisted with QSettings under a caller supplied resume key, a later
+///   upload with the same key continues where the previous one stopped (after asking the server for its offset)
+/// - Transient failures are retried with backoff after resynchronizing the offset with the server
+/// - Optional parallel streams: the device is split into contiguous ranges, each uploaded as a partial upload
+///   and joined with a final concatenation request (tus "concatenation" extension, the server must support it)
+/// - Progress and throughput are reported per chunk
+///
+/// Example usage:
+/// @code
+/// auto *upload = new QGCChunkedUpload(networkManager, this);
+/// upload->setEndpoint(QUrl("https://example.com/files/"));
+/// upload->setMetadata("filename", "flight.ulg");
+/// upload->setResumeKey(filePath);
+/// connect(upload, &QGCChunkedUpload::finished, this, [](bool success, const QUrl &url, const QString &error) { ... });
+/// upload->start(file);
+/// @endcode
+///
+class QGCChunkedUpload : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(QGCChunkedUpload)
+
+public:
+    enum class State {
+        Idle,           ///< Not started
+        Preparing,      ///< Creating or resuming the upload on the server
+        Uploading,      ///< Sending chunks
+        Finalizing,     ///< Joining parallel streams
+        Completed,
+        Failed,
+        Cancelled
+    };
+    Q_ENUM(State)
+
+    static constexpr qint64 kDefaultChunkSize = 6 * 1024 * 1024;   ///< Supabase storage requires exactly 6 MiB
+    static constexpr int kDefaultMaxRetries = 5;
+
+    explicit QGCChunkedUpload(QNetworkAccessManager *networkManager, QObject *parent = nullptr);
+    ~QGCChunkedUpload() override;
+
+    /// tus creation endpoint
+    void setEndpoint(const QUrl &endpoint) { _endpoint = endpoint; }
+    /// Header added to every request, e.g. authorization
+    void setRawHeader(const QByteArray &name, const QByteArray &value) { _headers.insert(name, value); }
+    /// Entry of the Upload-Metadata header sent when the (final) upload is created
+    void setMetadata(const QString &key, const QString &value) { _metadata.insert(key, value); }
+    void setChunkSize(qint64 chunkSize) { _chunkSize = qMax<qint64>(1, chunkSize); }
+    void setParallelStreams(int streams) { _parallelStreams = qMax(1, streams); }
+    void setMaxRetries(int retries) { _maxRetries = qMax(0, retries); }
+    /// Timeouts, HTTP/2 and redirect policy for every request. Caching is always disabled.
+    void setRequestConfig(const QGCNetworkHelper::RequestConfig &config) { _requestConfig = config; }
+    /// Enables persisting the upload state, uploads started with the same key resume. Empty disables.
+    void setResumeKey(const QString &key) { _resumeKey = key; }
+
+    /// Starts uploading @p device, which must be open, readable and random access.
+    /// The device is not owned and must outlive the upload.
+    bool start(QIODevice *device);
+    void cancel();
+
+    State state() const { return _state; }
+    bool isRunning() const { return (_state == State::Preparing) || (_state == State::Uploading) || (_state == State::Finalizing); }
+    qint64 bytesTotal() const { return _bytesTotal; }
+    qint64 bytesUploaded() const;
+    /// Bytes resumed from a previous session rather than sent by this one
+    qint64 bytesResumed() const { return bytesUploaded() - _bytesSent; }
+    /// Average bytes per second sent by this session
+    double throughput() const;
+    QUrl uploadUrl() const { return _uploadUrl; }
+    QString errorString() const { return _errorString; }
+
+    /// Removes persisted state for @p key
+    static void clearResumeState(const QString &key);
+
+signals:
+    void stateChanged(QGCChunkedUpload::State state);
+    /// A chunk was accepted by the server
+    void chunkUploaded(int stream, qint64 offset, qint64 size, double bytesPerSecond);
+    void progress(qint64 bytesUploaded, qint64 bytesTotal);
+    void finished(bool success, const QUrl &uploadUrl, const QString &errorString);
+
+private:
+    struct Stream {
+        qint64 begin = 0;               ///< Range of the device covered by this stream
+        qint64 end = 0;
+        qint64 offset = 0;              ///< Bytes of the range acknowledged by the server
+        QUrl url;
+        QPointer<QNetworkReply> reply;
+        int retries = 0;
+        QElapsedTimer chunkTimer;
+        qint64 chunkSize = 0;
+
+        qint64 length() const { return end - begin; }
+        bool done() const { return !url.isEmpty() && (offset >= length()); }
+    };
+
+    QNetworkRequest _request(const QUrl &url) const;
+    void _setState(State state);
+    void _fail(const QString &errorString);
+    void _createStream(int index);
+    void _resyncStream(int index);
+    void _sendChunk(int index);
+    void _streamRequestFailed(int index, QNetworkReply *reply);
+    void _retryStream(int index);
+    void _checkComplete();
+    void _finalize();
+    void _complete(const QUrl &url);
+    QByteArray _encodedMetadata() const;
+
+    bool _loadResumeState();
+    void _saveResumeState() const;
+    static QString _resumeGroup(const QString &key);
+
+    QNetworkAccessManager *_networkManager = nullptr;
+    QIODevice *_device = nullptr;
+    QUrl _endpoint;
+    QHash<QByteArray, QByteArray> _headers;
+    QHash<QString, QString> _metadata;
+    qint64 _chunkSize = kDefaultChunkSize;
+    int _parallelStreams = 1;
+    int _maxRetries = kDefaultMaxRetries;
+    QString _resumeKey;
+    QGCNetworkHelper::RequestConfig _requestConfig;
+
+    std::vector<Stream> _streams;
+    QPointer<QNetworkReply> _finalReply;
+    State _state = State::Idle;
+    qint64 _bytesTotal = 0;
+    qint64 _bytesSent = 0;
+    QElapsedTimer _sessionTimer;
+    QUrl _uploadUrl;
+    QString _errorString;
+
+    static constexpr const char *kTusVersion = "1.0.0";
+    static constexpr const char *kSettingsGroup = "QGCChunkedUpload";
+    static constexpr int kRetryBaseDelayMs = 500;
+};
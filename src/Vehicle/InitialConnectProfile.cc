@@ -0,0 +1,158 @@
+#include "InitialConnectProfile.h"
+
+#include <QtCore/QJsonArray>
+
+int InitialConnectProfile::addPhase(const QString &name)
+{
+    Phase phase;
+    phase.name = name;
+    _phases.append(phase);
+    return static_cast<int>(_phases.count() - 1);
+}
+
+void InitialConnectProfile::start(int vehicleId)
+{
+    for (Phase &phase : _phases) {
+        phase = Phase{ phase.name };
+    }
+    _vehicleId = vehicleId;
+    _timeToReadyMs = -1;
+    _timer.start();
+}
+
+void InitialConnectProfile::finish()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    for (int index = 0; index < _phases.count(); index++) {
+        if (_phases[index].isRunning()) {
+            phaseFinished(index);
+        }
+    }
+    _timeToReadyMs = _timer.elapsed();
+}
+
+void InitialConnectProfile::phaseStarted(int index)
+{
+    if (!_validIndex(index)) {
+        return;
+    }
+
+    Phase &phase = _phases[index];
+    phase.startMs = elapsedMs();
+    phase.durationMs = 0;
+    phase.outcome = Outcome::Pending;
+}
+
+void InitialConnectProfile::setOutcome(int index, Outcome outcome)
+{
+    if (_validIndex(index) && _phases[index].isRunning()) {
+        _phases[index].outcome = outcome;
+    }
+}
+
+void InitialConnectProfile::phaseFinished(int index)
+{
+    if (!_validIndex(index) || (_phases[index].startMs < 0)) {
+        return;
+    }
+
+    Phase &phase = _phases[index];
+    phase.durationMs = elapsedMs() - phase.startMs;
+    if (phase.outcome == Outcome::Pending) {
+        phase.outcome = Outcome::TimedOut;
+    }
+}
+
+void InitialConnectProfile::addRetry(int index, int count)
+{
+    if (_validIndex(index)) {
+        _phases[index].retries += count;
+    }
+}
+
+void InitialConnectProfile::addReceived(int index, quint64 bytes)
+{
+    if (_validIndex(index)) {
+        _phases[index].bytesReceived += bytes;
+        _phases[index].messagesReceived++;
+    }
+}
+
+qint64 InitialConnectProfile::serialTimeMs() const
+{
+    qint64 total = 0;
+    for (const Phase &phase : _phases) {
+        total += phase.durationMs;
+    }
+    return total;
+}
+
+const InitialConnectProfile::Phase *InitialConnectProfile::phase(const QString &name) const
+{
+    for (const Phase &phase : _phases) {
+        if (phase.name == name) {
+            return &phase;
+        }
+    }
+    return nullptr;
+}
+
+QString InitialConnectProfile::outcomeName(Outcome outcome)
+{
+    switch (outcome) {
+    case Outcome::Pending:
+        return QStringLiteral("pending");
+    case Outcome::Completed:
+        return QStringLiteral("completed");
+    case Outcome::Skipped:
+        return QStringLiteral("skipped");
+    case Outcome::Failed:
+        return QStringLiteral("failed");
+    case Outcome::TimedOut:
+        return QStringLiteral("timedOut");
+    }
+    return QString();
+}
+
+QJsonObject InitialConnectProfile::toJson() const
+{
+    QJsonArray phases;
+    for (const Phase &phase : _phases) {
+        QJsonObject phaseJson;
+        phaseJson[QStringLiteral("name")] = phase.name;
+        phaseJson[QStringLiteral("startMs")] = phase.startMs;
+        phaseJson[QStringLiteral("durationMs")] = phase.durationMs;
+        phaseJson[QStringLiteral("bytesReceived")] = static_cast<qint64>(phase.bytesReceived);
+        phaseJson[QStringLiteral("messagesReceived")] = static_cast<qint64>(phase.messagesReceived);
+        phaseJson[QStringLiteral("retries")] = phase.retries;
+        phaseJson[QStringLiteral("outcome")] = outcomeName(phase.outcome);
+        phases.append(phaseJson);
+    }
+
+    QJsonObject json;
+    json[QStringLiteral("vehicleId")] = _vehicleId;
+    json[QStringLiteral("timeToReadyMs")] = _timeToReadyMs;
+    json[QStringLiteral("serialTimeMs")] = serialTimeMs();
+    json[QStringLiteral("phases")] = phases;
+    return json;
+}
+
+QString InitialConnectProfile::summary() const
+{
+    QString result = QStringLiteral("Vehicle %1 initial connect: %2 ms (phases back to back: %3 ms)\n")
+                         .arg(_vehicleId).arg(_timeToReadyMs).arg(serialTimeMs());
+    for (const Phase &phase : _phases) {
+        result += QStringLiteral("  %1: start %2 ms, %3 ms, %4 bytes in %5 messages, %6 retries, %7\n")
+                      .arg(phase.name, -20)
+                      .arg(phase.startMs)
+                      .arg(phase.durationMs)
+                      .arg(phase.bytesReceived)
+                      .arg(phase.messagesReceived)
+                      .arg(phase.retries)
+                      .arg(outcomeName(phase.outcome));
+    }
+    return result;
+}
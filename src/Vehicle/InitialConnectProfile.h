@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+/// Timing profile of the initial connect sequence of one vehicle.
+///
+/// Each phase (autopilot version, parameters, mission, ...) records when it started relative to the start of the
+/// sequence, how long it ran, the MAVLink traffic received for it, how often it was retried and how it ended.
+/// Phases overlap, so time to ready is shorter than the sum of the phase durations; that sum is what the same
+/// transfers would take back to back.
+class InitialConnectProfile
+{
+public:
+    enum class Outcome {
+        Pending,
+        Completed,
+        Skipped,
+        Failed,     ///< Gave up after an error, the sequence carried on without the data
+        TimedOut,   ///< Left after the last retry timed out
+    };
+
+    struct Phase {
+        QString name;
+        qint64 startMs = -1;        ///< Relative to the start of the sequence, -1 if the phase never ran
+        qint64 durationMs = 0;
+        quint64 bytesReceived = 0;
+        quint32 messagesReceived = 0;
+        int retries = 0;
+        Outcome outcome = Outcome::Pending;
+
+        bool isRunning() const { return (startMs >= 0) && (outcome == Outcome::Pending); }
+    };
+
+    /// Registers a phase. @return Index used by the other calls
+    int addPhase(const QString &name);
+
+    /// Clears the results of all phases and starts the clock
+    void start(int vehicleId);
+    /// Stops the clock, records time to ready
+    void finish();
+
+    void phaseStarted(int index);
+    /// Sets the outcome of a running phase, the first outcome set wins
+    void setOutcome(int index, Outcome outcome);
+    /// Ends a phase; a phase left without an outcome timed out
+    void phaseFinished(int index);
+    void addRetry(int index, int count = 1);
+    void addReceived(int index, quint64 bytes);
+
+    bool isRunning() const { return _timer.isValid() && (_timeToReadyMs < 0); }
+    int vehicleId() const { return _vehicleId; }
+    qint64 elapsedMs() const { return _timer.isValid() ? _timer.elapsed() : 0; }
+    /// @return Duration of the whole sequence, -1 until it finished
+    qint64 timeToReadyMs() const { return _timeToReadyMs; }
+    /// @return Sum of the phase durations
+    qint64 serialTimeMs() const;
+
+    const QList<Phase> &phases() const { return _phases; }
+    /// @return nullptr if there is no phase @p name
+    const Phase *phase(const QString &name) const;
+
+    QJsonObject toJson() const;
+    QString summary() const;
+
+    static QString outcomeName(Outcome outcome);
+
+private:
+    bool _validIndex(int index) const { return (index >= 0) && (index < _phases.count()); }
+
+    QList<Phase> _phases;
+    QElapsedTimer _timer;
+    int _vehicleId = 0;
+    qint64 _timeToReadyMs = -1;
+};
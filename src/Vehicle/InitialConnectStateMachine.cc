@@ -14,6 +14,7 @@
 #include "QGCLoggingCategory.h"
 #include "SettingsManager.h"
 #include "MavlinkSettings.h"
+#include "ParallelState.h"
 
 #include <cstring>
 
@@ -26,11 +27,23 @@ QGC_LOGGING_CATEGORY(InitialConnectStateMachineLog, "Vehicle.InitialConnectState
 InitialConnectStateMachine::InitialConnectStateMachine(Vehicle* vehicle, QObject* parent)
     : QGCStateMachine(QStringLiteral("InitialConnectStateMachine"), vehicle, parent)
 {
+    // Registered in Phase order, the phase is the profile index
+    (void) _profile.addPhase(QStringLiteral("AutopilotVersion"));
+    (void) _profile.addPhase(QStringLiteral("StandardModes"));
+    (void) _profile.addPhase(QStringLiteral("CompInfo"));
+    (void) _profile.addPhase(QStringLiteral("Parameters"));
+    (void) _profile.addPhase(QStringLiteral("Mission"));
+    (void) _profile.addPhase(QStringLiteral("GeoFence"));
+    (void) _profile.addPhase(QStringLiteral("RallyPoints"));
+    Q_ASSERT(_profile.phases().count() == PhaseCount);
+
     _createStates();
     _wireTransitions();
     _wireProgressTracking();
     _wireTimeoutHandling();
 
+    (void) connect(vehicle, &Vehicle::mavlinkMessageReceived, this, &InitialConnectStateMachine::_onMavlinkMessageReceived);
+
     setInitialState(_stateAutopilotVersion);
 }
 
@@ -41,6 +54,10 @@ InitialConnectStateMachine::~InitialConnectStateMachine()
 void InitialConnectStateMachine::start()
 {
     resetProgress();
+    for (double& progressValue : _phaseProgress) {
+        progressValue = 0;
+    }
+    _profile.start(vehicle()->id());
     QGCStateMachine::start();
 }
 
@@ -59,16 +76,30 @@ void InitialConnectStateMachine::_createStates()
         _timeoutAutopilotVersion
     );
     _stateAutopilotVersion->setSkipPredicate([this]() {
-        return _shouldSkipAutopilotVersionRequest();
+        if (_shouldSkipAutopilotVersionRequest()) {
+            _profile.setOutcome(PhaseAutopilotVersion, InitialConnectProfile::Outcome::Skipped);
+            return true;
+        }
+        return false;
     });
     _stateAutopilotVersion->setFailureHandler([this](auto, auto) {
         _handleAutopilotVersionFailure();
     });
 
+    // The remaining transfers only depend on the capabilities from AUTOPILOT_VERSION, each
+    // region chains the transfers which depend on each other and the regions run in parallel
+    _stateTransfers = new ParallelState(QStringLiteral("InitialConnectTransfers"), this);
+    _regionMetadata = new QGCState(QStringLiteral("MetadataTransfers"), _stateTransfers);
+    _regionModes = new QGCState(QStringLiteral("ModesTransfers"), _stateTransfers);
+    _regionPlan = new QGCState(QStringLiteral("PlanTransfers"), _stateTransfers);
+    _regionMetadataFinal = new QGCFinalState(QStringLiteral("MetadataTransfersComplete"), _regionMetadata);
+    _regionModesFinal = new QGCFinalState(QStringLiteral("ModesTransfersComplete"), _regionModes);
+    _regionPlanFinal = new QGCFinalState(QStringLiteral("PlanTransfersComplete"), _regionPlan);
+
     // State 1: Request standard modes
     _stateStandardModes = new AsyncFunctionState(
         QStringLiteral("RequestStandardModes"),
-        this,
+        _regionModes,
         [this](AsyncFunctionState* state) { _requestStandardModes(state); },
         _timeoutStandardModes
     );
@@ -76,7 +107,7 @@ void InitialConnectStateMachine::_createStates()
     // State 2: Request component information
     _stateCompInfo = new AsyncFunctionState(
         QStringLiteral("RequestCompInfo"),
-        this,
+        _regionMetadata,
         [this](AsyncFunctionState* state) { _requestCompInfo(state); },
         _timeoutCompInfo
     );
@@ -84,7 +115,7 @@ void InitialConnectStateMachine::_createStates()
     // State 3: Request parameters (skippable)
     _stateParameters = new SkippableAsyncState(
         QStringLiteral("RequestParameters"),
-        this,
+        _regionMetadata,
         [this]() {
             if (_shouldSkipForFlying()) {
                 // PX4 can try a lightweight hash-check cache load
@@ -107,7 +138,7 @@ void InitialConnectStateMachine::_createStates()
     // State 4: Request mission (skippable)
     _stateMission = new SkippableAsyncState(
         QStringLiteral("RequestMission"),
-        this,
+        _regionPlan,
         [this]() { return _shouldSkipForPlanLoad(); },
         [this](SkippableAsyncState* state) { _requestMission(state); },
         [this]() {
@@ -119,7 +150,7 @@ void InitialConnectStateMachine::_createStates()
     // State 5: Request geofence (skippable)
     _stateGeoFence = new SkippableAsyncState(
         QStringLiteral("RequestGeoFence"),
-        this,
+        _regionPlan,
         [this]() {
             if (_shouldSkipForPlanLoad()) {
                 return true;
@@ -140,7 +171,7 @@ void InitialConnectStateMachine::_createStates()
     // State 6: Request rally points (skippable)
     _stateRallyPoints = new SkippableAsyncState(
         QStringLiteral("RequestRallyPoints"),
-        this,
+        _regionPlan,
         [this]() {
             if (_shouldSkipForPlanLoad()) {
                 return true;
@@ -161,6 +192,10 @@ void InitialConnectStateMachine::_createStates()
         _timeoutRallyPoints
     );
 
+    _regionMetadata->setInitialState(_stateCompInfo);
+    _regionModes->setInitialState(_stateStandardModes);
+    _regionPlan->setInitialState(_stateMission);
+
     // State 7: Signal completion
     // Use RetryState with zero retries so completion participates in the unified
     // retry/error state family while preserving immediate success behavior.
@@ -182,24 +217,32 @@ void InitialConnectStateMachine::_createStates()
 
 void InitialConnectStateMachine::_wireTransitions()
 {
-    // Linear progression - use completed() for WaitStateBase-derived states (more semantic)
-    _stateAutopilotVersion->addTransition(_stateAutopilotVersion, &WaitStateBase::completed, _stateStandardModes);
-    _stateStandardModes->addTransition(_stateStandardModes, &WaitStateBase::completed, _stateCompInfo);
+    // Use completed() for WaitStateBase-derived states (more semantic)
+    _stateAutopilotVersion->addTransition(_stateAutopilotVersion, &WaitStateBase::completed, _stateTransfers);
+
+    // Metadata region
     _stateCompInfo->addTransition(_stateCompInfo, &WaitStateBase::completed, _stateParameters);
 
     // SkippableAsyncStates: both completed and skipped go to next state
 
-    _stateParameters->addTransition(_stateParameters, &WaitStateBase::completed, _stateMission);
-    _stateParameters->addTransition(_stateParameters, &SkippableAsyncState::skipped, _stateMission);
+    _stateParameters->addTransition(_stateParameters, &WaitStateBase::completed, _regionMetadataFinal);
+    _stateParameters->addTransition(_stateParameters, &SkippableAsyncState::skipped, _regionMetadataFinal);
+
+    // Modes region
+    _stateStandardModes->addTransition(_stateStandardModes, &WaitStateBase::completed, _regionModesFinal);
 
+    // Plan region
     _stateMission->addTransition(_stateMission, &WaitStateBase::completed, _stateGeoFence);
     _stateMission->addTransition(_stateMission, &SkippableAsyncState::skipped, _stateGeoFence);
 
     _stateGeoFence->addTransition(_stateGeoFence, &WaitStateBase::completed, _stateRallyPoints);
     _stateGeoFence->addTransition(_stateGeoFence, &SkippableAsyncState::skipped, _stateRallyPoints);
 
-    _stateRallyPoints->addTransition(_stateRallyPoints, &WaitStateBase::completed, _stateComplete);
-    _stateRallyPoints->addTransition(_stateRallyPoints, &SkippableAsyncState::skipped, _stateComplete);
+    _stateRallyPoints->addTransition(_stateRallyPoints, &WaitStateBase::completed, _regionPlanFinal);
+    _stateRallyPoints->addTransition(_stateRallyPoints, &SkippableAsyncState::skipped, _regionPlanFinal);
+
+    // All regions finished -> Complete
+    _stateTransfers->addTransition(_stateTransfers, &QGCState::advance, _stateComplete);
 
     // Complete -> Final (RetryState emits advance() on success)
     _stateComplete->addTransition(_stateComplete, &QGCState::advance, _stateFinal);
@@ -207,23 +250,148 @@ void InitialConnectStateMachine::_wireTransitions()
 
 void InitialConnectStateMachine::_wireProgressTracking()
 {
-    // Use QGCStateMachine's built-in weighted progress tracking
-    // Progress is automatically updated when states are entered
+    // The parallel transfers are a single step of QGCStateMachine's weighted progress tracking,
+    // its sub progress is the weighted progress of the individual transfers
+    int transfersWeight = 0;
+    for (int phase = PhaseStandardModes; phase < PhaseCount; phase++) {
+        transfersWeight += _phaseWeights[phase];
+    }
     setProgressWeights({
-        {_stateAutopilotVersion, 1},
-        {_stateStandardModes, 1},
-        {_stateCompInfo, 5},
-        {_stateParameters, 5},
-        {_stateMission, 2},
-        {_stateGeoFence, 1},
-        {_stateRallyPoints, 1},
+        {_stateAutopilotVersion, _phaseWeights[PhaseAutopilotVersion]},
+        {_stateTransfers, transfersWeight},
         {_stateComplete, 1}
     });
+
+    _wireProfiling(_stateAutopilotVersion, PhaseAutopilotVersion);
+    _wireProfiling(_stateStandardModes, PhaseStandardModes);
+    _wireProfiling(_stateCompInfo, PhaseCompInfo);
+    _wireProfiling(_stateParameters, PhaseParameters);
+    _wireProfiling(_stateMission, PhaseMission);
+    _wireProfiling(_stateGeoFence, PhaseGeoFence);
+    _wireProfiling(_stateRallyPoints, PhaseRallyPoints);
+
+    (void) connect(_stateAutopilotVersion, &RetryableRequestMessageState::messageReceived, this, [this]() {
+        _profile.setOutcome(PhaseAutopilotVersion, InitialConnectProfile::Outcome::Completed);
+    });
+    (void) connect(_stateAutopilotVersion, &RetryableRequestMessageState::retriesExhausted, this, [this]() {
+        _profile.setOutcome(PhaseAutopilotVersion, InitialConnectProfile::Outcome::Failed);
+    });
+    // The state retries on its own, collect the count before it resets on the next entry
+    (void) connect(_stateAutopilotVersion, &QAbstractState::exited, this, [this]() {
+        _profile.addRetry(PhaseAutopilotVersion, _stateAutopilotVersion->retryCount());
+    });
 }
 
-void InitialConnectStateMachine::_onSubProgressUpdate(double progressValue)
+void InitialConnectStateMachine::_wireProfiling(WaitStateBase* state, Phase phase)
 {
-    setSubProgress(static_cast<float>(progressValue));
+    // The entry callback runs before the state's own entry handling, which may already complete it
+    state->setOnEntry([this, phase]() {
+        _profile.phaseStarted(phase);
+        _setPhaseProgress(phase, 0);
+    });
+    (void) connect(state, &WaitStateBase::completed, this, [this, phase]() {
+        _profile.setOutcome(phase, InitialConnectProfile::Outcome::Completed);
+    });
+    (void) connect(state, &QAbstractState::exited, this, [this, phase]() {
+        _profile.phaseFinished(phase);
+        _setPhaseProgress(phase, 1);
+    });
+}
+
+void InitialConnectStateMachine::_wireProfiling(SkippableAsyncState* state, Phase phase)
+{
+    _wireProfiling(static_cast<WaitStateBase*>(state), phase);
+    (void) connect(state, &SkippableAsyncState::skipped, this, [this, phase]() {
+        _profile.setOutcome(phase, InitialConnectProfile::Outcome::Skipped);
+    });
+}
+
+void InitialConnectStateMachine::_setPhaseProgress(Phase phase, double progressValue)
+{
+    _phaseProgress[phase] = qBound(0.0, progressValue, 1.0);
+    if (phase == PhaseAutopilotVersion) {
+        setSubProgress(static_cast<float>(_phaseProgress[phase]));
+        return;
+    }
+
+    double completedWeight = 0;
+    int totalWeight = 0;
+    for (int transfer = PhaseStandardModes; transfer < PhaseCount; transfer++) {
+        completedWeight += _phaseWeights[transfer] * _phaseProgress[transfer];
+        totalWeight += _phaseWeights[transfer];
+    }
+    setSubProgress(static_cast<float>(completedWeight / totalWeight));
+}
+
+void InitialConnectStateMachine::_onCompInfoProgress(float progressValue)
+{
+    _setPhaseProgress(PhaseCompInfo, progressValue);
+}
+
+void InitialConnectStateMachine::_onParameterLoadProgress(float progressValue)
+{
+    _setPhaseProgress(PhaseParameters, progressValue);
+}
+
+void InitialConnectStateMachine::_onMissionProgress(double progressValue)
+{
+    _setPhaseProgress(PhaseMission, progressValue);
+}
+
+void InitialConnectStateMachine::_onGeoFenceProgress(double progressValue)
+{
+    _setPhaseProgress(PhaseGeoFence, progressValue);
+}
+
+void InitialConnectStateMachine::_onRallyPointProgress(double progressValue)
+{
+    _setPhaseProgress(PhaseRallyPoints, progressValue);
+}
+
+// ============================================================================
+// Connect Profile
+// ============================================================================
+
+int InitialConnectStateMachine::_profilePhaseForMessage(uint32_t msgId) const
+{
+    switch (msgId) {
+    case MAVLINK_MSG_ID_AUTOPILOT_VERSION:
+        return PhaseAutopilotVersion;
+    case MAVLINK_MSG_ID_AVAILABLE_MODES:
+        return PhaseStandardModes;
+    case MAVLINK_MSG_ID_COMPONENT_METADATA:
+    case MAVLINK_MSG_ID_COMPONENT_INFORMATION:
+        return PhaseCompInfo;
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+        // Component info and parameters both download over FTP, never at the same time
+        return _profile.phases()[PhaseCompInfo].isRunning() ? PhaseCompInfo : PhaseParameters;
+    case MAVLINK_MSG_ID_PARAM_VALUE:
+        return PhaseParameters;
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_ACK:
+        for (int phase = PhaseMission; phase <= PhaseRallyPoints; phase++) {
+            if (_profile.phases()[phase].isRunning()) {
+                return phase;
+            }
+        }
+        return -1;
+    default:
+        return -1;
+    }
+}
+
+void InitialConnectStateMachine::_onMavlinkMessageReceived(const mavlink_message_t& message)
+{
+    if (!_profile.isRunning()) {
+        return;
+    }
+
+    const int phase = _profilePhaseForMessage(message.msgid);
+    if ((phase >= 0) && _profile.phases()[phase].isRunning()) {
+        _profile.addReceived(phase, mavlink_msg_get_send_buffer_length(&message));
+    }
 }
 
 // ============================================================================
@@ -235,23 +403,42 @@ void InitialConnectStateMachine::_wireTimeoutHandling()
     // Note: _stateAutopilotVersion is RetryableRequestMessageState which handles its own retry
 
     // Use addRetryTransition builder for cleaner timeout handling
-    addRetryTransition(_stateStandardModes, &WaitStateBase::timedOut, _stateCompInfo,
-                       [this]() { _requestStandardModes(_stateStandardModes); }, _maxRetries);
+    // A transfer which still times out after its retries moves on to the next one in its region
+    addRetryTransition(_stateStandardModes, &WaitStateBase::timedOut, _regionModesFinal,
+                       [this]() {
+                           _profile.addRetry(PhaseStandardModes);
+                           _requestStandardModes(_stateStandardModes);
+                       }, _maxRetries);
 
     addRetryTransition(_stateCompInfo, &WaitStateBase::timedOut, _stateParameters,
-                       [this]() { _requestCompInfo(_stateCompInfo); }, _maxRetries);
+                       [this]() {
+                           _profile.addRetry(PhaseCompInfo);
+                           _requestCompInfo(_stateCompInfo);
+                       }, _maxRetries);
 
-    addRetryTransition(_stateParameters, &WaitStateBase::timedOut, _stateMission,
-                       [this]() { _requestParameters(_stateParameters); }, _maxRetries);
+    addRetryTransition(_stateParameters, &WaitStateBase::timedOut, _regionMetadataFinal,
+                       [this]() {
+                           _profile.addRetry(PhaseParameters);
+                           _requestParameters(_stateParameters);
+                       }, _maxRetries);
 
     addRetryTransition(_stateMission, &WaitStateBase::timedOut, _stateGeoFence,
-                       [this]() { _requestMission(_stateMission); }, _maxRetries);
+                       [this]() {
+                           _profile.addRetry(PhaseMission);
+                           _requestMission(_stateMission);
+                       }, _maxRetries);
 
     addRetryTransition(_stateGeoFence, &WaitStateBase::timedOut, _stateRallyPoints,
-                       [this]() { _requestGeoFence(_stateGeoFence); }, _maxRetries);
-
-    addRetryTransition(_stateRallyPoints, &WaitStateBase::timedOut, _stateComplete,
-                       [this]() { _requestRallyPoints(_stateRallyPoints); }, _maxRetries);
+                       [this]() {
+                           _profile.addRetry(PhaseGeoFence);
+                           _requestGeoFence(_stateGeoFence);
+                       }, _maxRetries);
+
+    addRetryTransition(_stateRallyPoints, &WaitStateBase::timedOut, _regionPlanFinal,
+                       [this]() {
+                           _profile.addRetry(PhaseRallyPoints);
+                           _requestRallyPoints(_stateRallyPoints);
+                       }, _maxRetries);
 }
 
 // ============================================================================
@@ -398,12 +585,12 @@ void InitialConnectStateMachine::_requestCompInfo(AsyncFunctionState* state)
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestCompInfo";
 
     connect(vehicle()->_componentInformationManager, &ComponentInformationManager::progressUpdate,
-            this, &InitialConnectStateMachine::_onSubProgressUpdate, Qt::UniqueConnection);
+            this, &InitialConnectStateMachine::_onCompInfoProgress, Qt::UniqueConnection);
 
     // Ensure progress tracking is always cleaned up, including timeout/skip paths.
     state->setOnExit([this]() {
         disconnect(vehicle()->_componentInformationManager, &ComponentInformationManager::progressUpdate,
-                   this, &InitialConnectStateMachine::_onSubProgressUpdate);
+                   this, &InitialConnectStateMachine::_onCompInfoProgress);
     });
 
     vehicle()->_componentInformationManager->requestAllComponentInformation(
@@ -434,7 +621,7 @@ void InitialConnectStateMachine::_requestParameters(SkippableAsyncState* state)
     }
 
     connect(vehicle()->_parameterManager, &ParameterManager::loadProgressChanged,
-            this, &InitialConnectStateMachine::_onSubProgressUpdate, Qt::UniqueConnection);
+            this, &InitialConnectStateMachine::_onParameterLoadProgress, Qt::UniqueConnection);
 
     state->connectToCompletion(vehicle()->_parameterManager, &ParameterManager::parametersReadyChanged,
         [this](bool parametersReady) {
@@ -444,7 +631,7 @@ void InitialConnectStateMachine::_requestParameters(SkippableAsyncState* state)
     // Ensure progress tracking is always cleaned up, including timeout/skip paths.
     state->setOnExit([this, cacheFailedConn]() {
         disconnect(vehicle()->_parameterManager, &ParameterManager::loadProgressChanged,
-                   this, &InitialConnectStateMachine::_onSubProgressUpdate);
+                   this, &InitialConnectStateMachine::_onParameterLoadProgress);
         if (cacheFailedConn) {
             disconnect(cacheFailedConn);
         }
@@ -463,7 +650,7 @@ void InitialConnectStateMachine::_onParametersReady(bool parametersReady)
 
     // Disconnect progress tracking from parameter manager
     disconnect(vehicle()->_parameterManager, &ParameterManager::loadProgressChanged,
-               this, &InitialConnectStateMachine::_onSubProgressUpdate);
+               this, &InitialConnectStateMachine::_onParameterLoadProgress);
 
     if (parametersReady) {
         // Send time to vehicle (twice for reliability on noisy links)
@@ -486,14 +673,14 @@ void InitialConnectStateMachine::_requestMission(SkippableAsyncState* state)
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission";
 
     connect(vehicle()->_missionManager, &MissionManager::progressPctChanged,
-            this, &InitialConnectStateMachine::_onSubProgressUpdate, Qt::UniqueConnection);
+            this, &InitialConnectStateMachine::_onMissionProgress, Qt::UniqueConnection);
 
     state->connectToCompletion(vehicle()->_missionManager, &MissionManager::newMissionItemsAvailable);
 
     // Disconnect progress tracking on exit
     state->setOnExit([this]() {
         disconnect(vehicle()->_missionManager, &MissionManager::progressPctChanged,
-                   this, &InitialConnectStateMachine::_onSubProgressUpdate);
+                   this, &InitialConnectStateMachine::_onMissionProgress);
     });
 
     vehicle()->_missionManager->loadFromVehicle();
@@ -504,14 +691,14 @@ void InitialConnectStateMachine::_requestGeoFence(SkippableAsyncState* state)
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence";
 
     connect(vehicle()->_geoFenceManager, &GeoFenceManager::progressPctChanged,
-            this, &InitialConnectStateMachine::_onSubProgressUpdate, Qt::UniqueConnection);
+            this, &InitialConnectStateMachine::_onGeoFenceProgress, Qt::UniqueConnection);
 
     state->connectToCompletion(vehicle()->_geoFenceManager, &GeoFenceManager::loadComplete);
 
     // Disconnect progress tracking on exit
     state->setOnExit([this]() {
         disconnect(vehicle()->_geoFenceManager, &GeoFenceManager::progressPctChanged,
-                   this, &InitialConnectStateMachine::_onSubProgressUpdate);
+                   this, &InitialConnectStateMachine::_onGeoFenceProgress);
     });
 
     vehicle()->_geoFenceManager->loadFromVehicle();
@@ -522,7 +709,7 @@ void InitialConnectStateMachine::_requestRallyPoints(SkippableAsyncState* state)
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints";
 
     connect(vehicle()->_rallyPointManager, &RallyPointManager::progressPctChanged,
-            this, &InitialConnectStateMachine::_onSubProgressUpdate, Qt::UniqueConnection);
+            this, &InitialConnectStateMachine::_onRallyPointProgress, Qt::UniqueConnection);
 
     state->connectToCompletion(vehicle()->_rallyPointManager, &RallyPointManager::loadComplete,
         [this]() {
@@ -538,7 +725,7 @@ void InitialConnectStateMachine::_requestRallyPoints(SkippableAsyncState* state)
     // Always clean up progress tracking when leaving this state.
     state->setOnExit([this]() {
         disconnect(vehicle()->_rallyPointManager, &RallyPointManager::progressPctChanged,
-                   this, &InitialConnectStateMachine::_onSubProgressUpdate);
+                   this, &InitialConnectStateMachine::_onRallyPointProgress);
     });
 
     vehicle()->_rallyPointManager->loadFromVehicle();
@@ -547,6 +734,10 @@ void InitialConnectStateMachine::_requestRallyPoints(SkippableAsyncState* state)
 void InitialConnectStateMachine::_signalComplete()
 {
     qCDebug(InitialConnectStateMachineLog) << "Signalling initialConnectComplete";
+
+    _profile.finish();
+    qCDebug(InitialConnectStateMachineLog).noquote() << _profile.summary();
+
     connect(this, &QStateMachine::finished, vehicle(), [this]() {
         emit vehicle()->initialConnectComplete();
     }, Qt::SingleShotConnection);
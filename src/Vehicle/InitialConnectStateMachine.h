@@ -1,22 +1,30 @@
 #pragma once
 
+#include <QtCore/QJsonObject>
+
 #include "QGCStateMachine.h"
 #include "MAVLinkMessageType.h"
+#include "InitialConnectProfile.h"
 
 class Vehicle;
 class SkippableAsyncState;
 class AsyncFunctionState;
 class RetryableRequestMessageState;
 class RetryState;
+class ParallelState;
+class WaitStateBase;
 
 /// \brief State machine for initial vehicle connection sequence.
 ///
-/// Handles requesting autopilot version, standard modes, component info,
-/// parameters, missions, geofence, and rally points in sequence.
+/// Requests the autopilot version first, its capability bits decide what the
+/// rest of the sequence can ask for. The remaining transfers then run as three
+/// parallel regions, each a chain of the transfers which depend on each other:
+///   - Metadata: component info, then parameters (fact metadata comes from component info)
+///   - Modes: standard modes
+///   - Plan: mission, geofence, rally points (one mission protocol transaction at a time)
 ///
-/// Uses QGCStateMachine's built-in weighted progress tracking where different
-/// states contribute different amounts to the overall progress (e.g., parameter
-/// loading takes longer than version request).
+/// Progress is weighted per transfer, overlapping transfers advance it together.
+/// Every run records an InitialConnectProfile with the timing of each transfer.
 ///
 class InitialConnectStateMachine : public QGCStateMachine
 {
@@ -26,10 +34,31 @@ class InitialConnectStateMachine : public QGCStateMachine
     explicit InitialConnectStateMachine(Vehicle* vehicle, QObject* parent = nullptr);
     ~InitialConnectStateMachine() override;
 
+    /// Transfers of the sequence, also the phase indices of profile()
+    enum Phase {
+        PhaseAutopilotVersion,
+        PhaseStandardModes,
+        PhaseCompInfo,
+        PhaseParameters,
+        PhaseMission,
+        PhaseGeoFence,
+        PhaseRallyPoints,
+        PhaseCount
+    };
+
     void start();
 
+    /// Timing profile of the current or last connect sequence
+    const InitialConnectProfile& profile() const { return _profile; }
+    QJsonObject profileJson() const { return _profile.toJson(); }
+
 private slots:
-    void _onSubProgressUpdate(double progressValue);
+    // Sub progress of the transfers, each reports to its own phase
+    void _onCompInfoProgress(float progressValue);
+    void _onParameterLoadProgress(float progressValue);
+    void _onMissionProgress(double progressValue);
+    void _onGeoFenceProgress(double progressValue);
+    void _onRallyPointProgress(double progressValue);
 
 private:
     // State creation and wiring
@@ -37,6 +66,13 @@ private slots:
     void _wireTransitions();
     void _wireProgressTracking();
     void _wireTimeoutHandling();
+    void _wireProfiling(WaitStateBase* state, Phase phase);
+    void _wireProfiling(SkippableAsyncState* state, Phase phase);
+
+    // Progress and profiling
+    void _setPhaseProgress(Phase phase, double progressValue);
+    int _profilePhaseForMessage(uint32_t msgId) const;
+    void _onMavlinkMessageReceived(const mavlink_message_t& message);
 
     // State callbacks
     void _handleAutopilotVersionSuccess(const mavlink_message_t& message);
@@ -61,6 +97,13 @@ private slots:
 
     // State pointers for wiring
     RetryableRequestMessageState* _stateAutopilotVersion = nullptr;
+    ParallelState* _stateTransfers = nullptr;
+    QGCState* _regionMetadata = nullptr;
+    QGCState* _regionModes = nullptr;
+    QGCState* _regionPlan = nullptr;
+    QGCFinalState* _regionMetadataFinal = nullptr;
+    QGCFinalState* _regionModesFinal = nullptr;
+    QGCFinalState* _regionPlanFinal = nullptr;
     AsyncFunctionState* _stateStandardModes = nullptr;
     AsyncFunctionState* _stateCompInfo = nullptr;
     SkippableAsyncState* _stateParameters = nullptr;
@@ -70,6 +113,12 @@ private slots:
     RetryState* _stateComplete = nullptr;
     QGCFinalState* _stateFinal = nullptr;
 
+    InitialConnectProfile _profile;
+    double _phaseProgress[PhaseCount] = {};
+
+    /// Share of each transfer in the progress of the parallel transfers
+    static constexpr int _phaseWeights[PhaseCount] = { 1, 1, 5, 5, 2, 1, 1 };
+
     // Timeout handling with retry
     static constexpr int _maxRetries = 1;
 
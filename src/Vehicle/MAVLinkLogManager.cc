@@ -3,6 +3,7 @@
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
+#include "ULogStreamDecoder.h"
 #include "AppSettings.h"
 #include "Vehicle.h"
 
@@ -186,6 +187,10 @@ void MAVLinkLogProcessor::_writeData(const void *data, int len)
     if (_record) {
         _record->setSize(_written);
     }
+
+    if (_decoder) {
+        _decoder->feed(reinterpret_cast<const char*>(data), len);
+    }
 }
 
 QByteArray MAVLinkLogProcessor::_writeUlogMessage(QByteArray &data)
@@ -620,6 +625,7 @@ void MAVLinkLogManager::stopLogging()
 
     delete _logProcessor;
     _logProcessor = nullptr;
+    _finishLiveLog();
     _logRunning = false;
     emit logRunningChanged();
 }
@@ -806,6 +812,7 @@ void MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_s
     qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << _logProcessor->fileName();
     delete _logProcessor;
     _logProcessor = nullptr;
+    _finishLiveLog();
     _logRunning = false;
     _vehicle->stopMavlinkLog();
     emit logRunningChanged();
@@ -849,10 +856,23 @@ void MAVLinkLogManager::_discardLog()
         _logProcessor = nullptr;
     }
 
+    if (_liveLog) {
+        _liveLog->deleteLater();
+        _liveLog = nullptr;
+        emit liveLogChanged();
+    }
+
     _logRunning = false;
     emit logRunningChanged();
 }
 
+void MAVLinkLogManager::_finishLiveLog()
+{
+    if (_liveLog) {
+        _liveLog->finish();
+    }
+}
+
 bool MAVLinkLogManager::_createNewLog()
 {
     delete _logProcessor;
@@ -861,6 +881,13 @@ bool MAVLinkLogManager::_createNewLog()
     if (_logProcessor->create(this, _logPath, static_cast<uint8_t>(_vehicle->id()))) {
         _insertNewLog(_logProcessor->record());
         emit logFilesChanged();
+
+        if (_liveLog) {
+            _liveLog->deleteLater();
+        }
+        _liveLog = new ULogStreamDecoder(this);
+        _logProcessor->setDecoder(_liveLog);
+        emit liveLogChanged();
     } else {
         qCWarning(MAVLinkLogManagerLog) << "Could not create MAVLink log file:" << _logProcessor->fileName();
         delete _logProcessor;
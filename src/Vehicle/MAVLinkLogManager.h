@@ -2,12 +2,14 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtNetwork/QHttpPart>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 class QmlObjectListModel;
 class QNetworkAccessManager;
 class MAVLinkLogManager;
+class ULogStreamDecoder;
 class Vehicle;
 
 class MAVLinkLogFiles : public QObject
@@ -73,6 +75,8 @@ class MAVLinkLogProcessor
     MAVLinkLogFiles *record() { return _record; }
     QString fileName() const { return _fileName; }
     bool processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray &in);
+    /// Everything written to the file is also fed to decoder, for live display while logging
+    void setDecoder(ULogStreamDecoder *decoder) { _decoder = decoder; }
 
 private:
     bool _checkSequence(uint16_t seq, int &num_drops);
@@ -88,6 +92,7 @@ class MAVLinkLogProcessor
     QFile _file;
     QString _fileName;
     quint32 _written = 0;
+    QPointer<ULogStreamDecoder> _decoder;
 
     static constexpr int kUlogMessageHeader = 3;
     static constexpr int kSequenceSize = 1 << 15;
@@ -101,6 +106,7 @@ class MAVLinkLogManager : public QObject
     QML_ELEMENT
     QML_UNCREATABLE("")
     Q_MOC_INCLUDE("QmlObjectListModel.h")
+    Q_MOC_INCLUDE("ULogStreamDecoder.h")
     Q_PROPERTY(QString              emailAddress        READ emailAddress       WRITE setEmailAddress       NOTIFY emailAddressChanged)
     Q_PROPERTY(QString              description         READ description        WRITE setDescription        NOTIFY descriptionChanged)
     Q_PROPERTY(QString              uploadURL           READ uploadURL          WRITE setUploadURL          NOTIFY uploadURLChanged)
@@ -116,6 +122,7 @@ class MAVLinkLogManager : public QObject
     Q_PROPERTY(QmlObjectListModel   *logFiles           READ logFiles                                       NOTIFY logFilesChanged)
     Q_PROPERTY(int                  windSpeed           READ windSpeed          WRITE setWindSpeed          NOTIFY windSpeedChanged)
     Q_PROPERTY(QString              rating              READ rating             WRITE setRating             NOTIFY ratingChanged)
+    Q_PROPERTY(ULogStreamDecoder    *liveLog            READ liveLog                                        NOTIFY liveLogChanged)
 
 public:
     /// Constructs an MAVLinkLogManager object.
@@ -148,6 +155,8 @@ class MAVLinkLogManager : public QObject
     QString logExtension() const { return _ulogExtension; }
 
     QmlObjectListModel *logFiles() { return _logFiles; }
+    /// Incremental decode of the log being received, kept after logging stops until the next one starts
+    ULogStreamDecoder *liveLog() const { return _liveLog; }
 
     void setDeleteAfterUpload(bool enable);
     void setDescription(const QString &description);
@@ -171,6 +180,7 @@ class MAVLinkLogManager : public QObject
     void enableAutoUploadChanged();
     void failed();
     void feedbackChanged();
+    void liveLogChanged();
     void logFilesChanged();
     void logRunningChanged();
     void publicLogChanged();
@@ -199,6 +209,7 @@ private slots:
     void _insertNewLog(MAVLinkLogFiles *newLog);
     void _deleteLog(MAVLinkLogFiles *log);
     void _discardLog();
+    void _finishLiveLog();
     QString _makeFilename(const QString &baseName) const;
 
     static QHttpPart _createFormPart(QStringView name, QStringView value);
@@ -219,6 +230,7 @@ private slots:
     int _windSpeed = -1;
     MAVLinkLogFiles *_currentLogfile = nullptr;
     MAVLinkLogProcessor *_logProcessor = nullptr;
+    ULogStreamDecoder *_liveLog = nullptr;
     QString _description;
     QString _emailAddress;
     QString _feedback;
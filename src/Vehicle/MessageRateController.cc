@@ -0,0 +1,375 @@
+#include "MessageRateController.h"
+#include "FactGroup.h"
+#include "MAVLinkLib.h"
+#include "MavlinkSettings.h"
+#include "MessageIntervalManager.h"
+#include "MultiVehicleManager.h"
+#include "QGCLoggingCategory.h"
+#include "QmlObjectListModel.h"
+#include "SettingsManager.h"
+#include "Vehicle.h"
+#include "VehicleLinkManager.h"
+
+#include <QtCore/QList>
+#include <QtCore/QTimer>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(MessageRateControllerLog, "Vehicle.MessageRateController")
+
+MessageRateController::MessageRateController(Vehicle *vehicle, MessageIntervalManager *intervalManager)
+    : QObject(vehicle)
+    , _vehicle(vehicle)
+    , _intervalManager(intervalManager)
+    , _timer(new QTimer(this))
+{
+    // qCDebug(MessageRateControllerLog) << Q_FUNC_INFO << this;
+
+    _timer->setInterval(kUpdateIntervalMs);
+    (void) connect(_timer, &QTimer::timeout, this, &MessageRateController::_update);
+    _window.start();
+
+    Fact *const enabledFact = SettingsManager::instance()->mavlinkSettings()->adaptiveRateControl();
+    (void) connect(enabledFact, &Fact::rawValueChanged, this, [this](const QVariant &value) {
+        _setEnabled(value.toBool());
+    });
+    _setEnabled(enabledFact->rawValue().toBool());
+}
+
+MessageRateController::~MessageRateController()
+{
+    // qCDebug(MessageRateControllerLog) << Q_FUNC_INFO << this;
+}
+
+void MessageRateController::requestRate(QObject *consumer, uint32_t msgId, qreal rateHz)
+{
+    if (!consumer) {
+        return;
+    }
+
+    if (!_consumers.contains(consumer)) {
+        (void) _consumers.insert(consumer);
+        (void) connect(consumer, &QObject::destroyed, this, [this, consumer]() {
+            _releaseConsumer(consumer);
+        });
+    }
+
+    (void) _requests[msgId].insert(consumer, rateHz);
+    qCDebug(MessageRateControllerLog) << "Rate requested" << msgId << rateHz << consumer;
+}
+
+void MessageRateController::releaseRate(QObject *consumer, uint32_t msgId)
+{
+    const auto it = _requests.find(msgId);
+    if (it == _requests.end()) {
+        return;
+    }
+
+    (void) it->remove(consumer);
+    if (it->isEmpty()) {
+        (void) _requests.erase(it);
+    }
+}
+
+void MessageRateController::_releaseConsumer(QObject *consumer)
+{
+    (void) _consumers.remove(consumer);
+    for (auto it = _requests.begin(); it != _requests.end();) {
+        (void) it->remove(consumer);
+        it = it->isEmpty() ? _requests.erase(it) : std::next(it);
+    }
+}
+
+void MessageRateController::setExternallyManaged(uint32_t msgId, bool managed)
+{
+    if (managed) {
+        (void) _externallyManaged.insert(msgId);
+        // The other owner's interval replaces ours, the default is measured again once it is handed back
+        auto it = _streams.find(msgId);
+        if (it != _streams.end()) {
+            it->commandedHz = 0;
+        }
+    } else {
+        (void) _externallyManaged.remove(msgId);
+    }
+}
+
+void MessageRateController::factGroupUpdated(FactGroup *factGroup, uint32_t msgId)
+{
+    if (!_isControllable(msgId)) {
+        return;
+    }
+
+    QList<QPointer<FactGroup>> &factGroups = _factGroups[msgId];
+    if (factGroups.contains(factGroup)) {
+        return;
+    }
+
+    // Destroyed groups (a removed battery) are left behind as null pointers and dropped here
+    (void) factGroups.removeIf([](const QPointer<FactGroup> &group) { return group.isNull(); });
+    factGroups.append(factGroup);
+    qCDebug(MessageRateControllerLog) << "Message" << msgId << "feeds" << factGroup->objectName() << factGroup;
+}
+
+void MessageRateController::messageReceived(const mavlink_message_t &message)
+{
+    const int length = _wireLength(message);
+    _linkRate.recordBytes(length);
+
+    if ((message.compid != _vehicle->defaultComponentId()) || !_isControllable(message.msgid)) {
+        return;
+    }
+
+    Stream &stream = _streams[message.msgid];
+    stream.windowMessages++;
+    stream.windowBytes += length;
+}
+
+void MessageRateController::_setEnabled(bool enabled)
+{
+    if (enabled == _enabled) {
+        return;
+    }
+
+    _enabled = enabled;
+    qCDebug(MessageRateControllerLog) << "Adaptive rate control" << (enabled ? "enabled" : "disabled") << "for vehicle" << _vehicle->id();
+
+    if (enabled) {
+        _budgetScale = 1.;
+        _windowStartReceived = _totalReceived;
+        _windowStartLoss = _totalLoss;
+        for (Stream &stream : _streams) {
+            stream.windowMessages = 0;
+            stream.windowBytes = 0;
+        }
+        _window.restart();
+        _timer->start();
+    } else {
+        _timer->stop();
+        _restoreDefaults();
+        _budget = 0.;
+    }
+}
+
+void MessageRateController::_measure()
+{
+    const qreal elapsedSecs = _window.restart() / 1000.;
+    if (elapsedSecs <= 0.) {
+        return;
+    }
+
+    for (auto it = _streams.begin(); it != _streams.end(); ++it) {
+        Stream &stream = it.value();
+        const qreal windowHz = stream.windowMessages / elapsedSecs;
+        if (stream.windowMessages > 0) {
+            stream.bytesPerMessage = static_cast<qreal>(stream.windowBytes) / stream.windowMessages;
+        }
+        stream.measuredHz = (stream.measuredHz > 0.) ? ((kSmoothing * windowHz) + ((1. - kSmoothing) * stream.measuredHz)) : windowHz;
+        if ((stream.commandedHz == 0) && !_externallyManaged.contains(it.key())) {
+            stream.nativeHz = stream.measuredHz;
+        }
+        stream.windowMessages = 0;
+        stream.windowBytes = 0;
+    }
+}
+
+void MessageRateController::_update()
+{
+    _measure();
+
+    // MAVLinkProtocol's running loss averages over the whole session, the budget has to follow the recent loss. The
+    // counters start over when the channel is reset.
+    const uint64_t received = (_totalReceived >= _windowStartReceived) ? (_totalReceived - _windowStartReceived) : _totalReceived;
+    const uint64_t lost = (_totalLoss >= _windowStartLoss) ? (_totalLoss - _windowStartLoss) : _totalLoss;
+    _lossPercent = ((received + lost) > 0) ? ((100. * lost) / (received + lost)) : 0.;
+    _windowStartReceived = _totalReceived;
+    _windowStartLoss = _totalLoss;
+
+    // Loss on the link backs the budget off multiplicatively, a clean link recovers it additively
+    if (_lossPercent > kLossThresholdPercent) {
+        _budgetScale = std::max(kMinBudgetScale, _budgetScale * kBackoff);
+    } else {
+        _budgetScale = std::min(1., _budgetScale + kRecovery);
+    }
+    _budget = _linkShare() * _budgetScale;
+
+    struct Candidate {
+        uint32_t msgId;
+        qreal desiredHz;
+        qreal bytesPerMessage;
+    };
+    QList<Candidate> candidates;
+    qreal streamBytes = 0.;
+    qreal floorBytes = 0.;
+    qreal extraBytes = 0.;
+    for (auto it = _streams.cbegin(); it != _streams.cend(); ++it) {
+        const Stream &stream = it.value();
+        streamBytes += stream.measuredHz * stream.bytesPerMessage;
+        if ((stream.nativeHz <= kMinRateHz) || _externallyManaged.contains(it.key())) {
+            continue;
+        }
+
+        const qreal desiredHz = std::clamp(_demandedRate(it.key()), kMinRateHz, stream.nativeHz);
+        candidates.append({ it.key(), desiredHz, stream.bytesPerMessage });
+        floorBytes += kMinRateHz * stream.bytesPerMessage;
+        extraBytes += (desiredHz - kMinRateHz) * stream.bytesPerMessage;
+    }
+
+    // Traffic which is not shaped here (other components, commands, transfers) comes off the top of the budget, the
+    // rest is shared by the streams in proportion to what they are demanded above the minimum rate
+    const qreal unshaped = std::max(0., _linkRate.bytesPerSec() - streamBytes);
+    const qreal available = std::max(0., _budget - unshaped);
+    const qreal scale = (extraBytes > 0.) ? std::clamp((available - floorBytes) / extraBytes, 0., 1.) : 1.;
+
+    qCDebug(MessageRateControllerLog) << "Vehicle" << _vehicle->id() << "budget" << _budget << "B/s, traffic" << _linkRate.bytesPerSec()
+                                      << "B/s, unshaped" << unshaped << "B/s, loss" << _lossPercent << "%, stream scale" << scale;
+
+    int commands = 0;
+    for (const Candidate &candidate : candidates) {
+        Stream &stream = _streams[candidate.msgId];
+        const qreal targetHz = kMinRateHz + (scale * (candidate.desiredHz - kMinRateHz));
+
+        int rateHz = 0;
+        if (targetHz < (stream.nativeHz * kRestoreFraction)) {
+            rateHz = std::max(static_cast<int>(kMinRateHz), static_cast<int>(targetHz));
+        }
+        if (rateHz == stream.commandedHz) {
+            continue;
+        }
+        if ((rateHz > 0) && (stream.commandedHz > 0) && (std::abs(rateHz - stream.commandedHz) < std::max(1., stream.commandedHz * kHysteresis))) {
+            continue;
+        }
+        if (commands++ >= kMaxCommandsPerUpdate) {
+            // The rest follows on the next update, the command queue is shared with everything else
+            break;
+        }
+
+        _command(candidate.msgId, stream, rateHz);
+    }
+}
+
+void MessageRateController::_command(uint32_t msgId, Stream &stream, int rateHz)
+{
+    qCDebug(MessageRateControllerLog) << "Vehicle" << _vehicle->id() << "message" << msgId << "rate" << stream.commandedHz << "->" << rateHz
+                                      << "Hz, default" << stream.nativeHz << "Hz";
+
+    stream.commandedHz = rateHz;
+    _intervalManager->setMessageRate(static_cast<uint8_t>(_vehicle->defaultComponentId()), static_cast<uint16_t>(msgId), rateHz);
+}
+
+void MessageRateController::_restoreDefaults()
+{
+    for (auto it = _streams.begin(); it != _streams.end(); ++it) {
+        if (it->commandedHz != 0) {
+            _command(it.key(), it.value(), 0);
+        }
+    }
+}
+
+qreal MessageRateController::_demandedRate(uint32_t msgId) const
+{
+    qreal rateHz = kDisplayRateHz;
+
+    // An observed group shows new values once per update period, faster messages are never seen
+    const auto groupIt = _factGroups.constFind(msgId);
+    if (groupIt != _factGroups.constEnd()) {
+        for (const QPointer<FactGroup> &factGroup : groupIt.value()) {
+            if (factGroup && factGroup->isObserved()) {
+                const int updateRateMSecs = factGroup->updateRateMSecs();
+                rateHz = std::max(rateHz, (updateRateMSecs > 0) ? (1000. / updateRateMSecs) : kFullRateHz);
+            }
+        }
+    }
+
+    const auto it = _requests.constFind(msgId);
+    if (it != _requests.constEnd()) {
+        for (const qreal requestedHz : it.value()) {
+            rateHz = std::max(rateHz, requestedHz);
+        }
+    }
+
+    return rateHz;
+}
+
+qreal MessageRateController::_linkShare() const
+{
+    const qreal budget = SettingsManager::instance()->mavlinkSettings()->adaptiveRateBudget()->rawValue().toDouble();
+
+    // Vehicles behind the same radio share its budget
+    const SharedLinkInterfacePtr link = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (!link) {
+        return budget;
+    }
+
+    int vehiclesOnLink = 0;
+    const QmlObjectListModel *const vehicles = MultiVehicleManager::instance()->vehicles();
+    for (int i = 0; i < vehicles->count(); i++) {
+        Vehicle *const vehicle = vehicles->value<Vehicle*>(i);
+        if (vehicle && (vehicle->vehicleLinkManager()->primaryLink().lock() == link)) {
+            vehiclesOnLink++;
+        }
+    }
+
+    return budget / std::max(1, vehiclesOnLink);
+}
+
+bool MessageRateController::_isControllable(uint32_t msgId)
+{
+    // Protocol traffic, transfers and messages sent on request are left alone, only periodic telemetry is shaped
+    switch (msgId) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+    case MAVLINK_MSG_ID_HIGH_LATENCY:
+    case MAVLINK_MSG_ID_HIGH_LATENCY2:
+    case MAVLINK_MSG_ID_COMMAND_ACK:
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+    case MAVLINK_MSG_ID_COMMAND_INT:
+    case MAVLINK_MSG_ID_STATUSTEXT:
+    case MAVLINK_MSG_ID_PARAM_VALUE:
+    case MAVLINK_MSG_ID_PARAM_EXT_VALUE:
+    case MAVLINK_MSG_ID_PARAM_EXT_ACK:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+    case MAVLINK_MSG_ID_MISSION_ACK:
+    case MAVLINK_MSG_ID_LOG_ENTRY:
+    case MAVLINK_MSG_ID_LOG_DATA:
+    case MAVLINK_MSG_ID_LOGGING_DATA:
+    case MAVLINK_MSG_ID_LOGGING_DATA_ACKED:
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+    case MAVLINK_MSG_ID_SERIAL_CONTROL:
+    case MAVLINK_MSG_ID_PING:
+    case MAVLINK_MSG_ID_MESSAGE_INTERVAL:
+    case MAVLINK_MSG_ID_AUTOPILOT_VERSION:
+    case MAVLINK_MSG_ID_COMPONENT_METADATA:
+    case MAVLINK_MSG_ID_EVENT:
+    case MAVLINK_MSG_ID_CURRENT_EVENT_SEQUENCE:
+    case MAVLINK_MSG_ID_RESPONSE_EVENT_ERROR:
+    case MAVLINK_MSG_ID_AVAILABLE_MODES:
+    case MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE:
+    case MAVLINK_MSG_ID_ENCAPSULATED_DATA:
+    case MAVLINK_MSG_ID_TERRAIN_REQUEST:
+    case MAVLINK_MSG_ID_TERRAIN_REPORT:
+    case MAVLINK_MSG_ID_CAMERA_INFORMATION:
+    case MAVLINK_MSG_ID_CAMERA_SETTINGS:
+    case MAVLINK_MSG_ID_CAMERA_IMAGE_CAPTURED:
+    case MAVLINK_MSG_ID_STORAGE_INFORMATION:
+    case MAVLINK_MSG_ID_ADSB_VEHICLE:
+    case MAVLINK_MSG_ID_RADIO_STATUS:
+    case MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS:
+    case MAVLINK_MSG_ID_SETUP_SIGNING:
+        return false;
+    default:
+        return true;
+    }
+}
+
+int MessageRateController::_wireLength(const mavlink_message_t &message)
+{
+    if (message.magic == MAVLINK_STX_MAVLINK1) {
+        return message.len + MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + MAVLINK_NUM_CHECKSUM_BYTES;
+    }
+
+    const int signature = (message.incompat_flags & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+    return message.len + MAVLINK_NUM_NON_PAYLOAD_BYTES + signature;
+}
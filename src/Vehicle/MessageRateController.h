@@ -0,0 +1,124 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+
+#include "DataRateTracker.h"
+#include "MAVLinkMessageType.h"
+
+Q_DECLARE_LOGGING_CATEGORY(MessageRateControllerLog)
+
+class FactGroup;
+class MessageIntervalManager;
+class QTimer;
+class Vehicle;
+
+/// \brief Closed-loop control of the vehicle's telemetry stream rates within a link budget.
+///
+/// Streams of the autopilot are measured as they arrive (rate and wire size), together with the loss MAVLinkProtocol
+/// counts for the vehicle within each update. Each stream is demanded at the rate its consumers need: explicit requests
+/// such as an open chart, and the update rate of each fact group the message feeds while one of the group's Facts is
+/// observed (shown by a widget, bound by QML). Streams nothing consumes keep kDisplayRateHz. The telemetry log records
+/// what arrives, so it holds the shaped rates as well. The vehicle's share of the link budget is split over the streams
+/// and SET_MESSAGE_INTERVAL is renegotiated through MessageIntervalManager when a target moves away from the commanded
+/// rate. The budget backs off while the link reports loss and recovers while it is clean.
+///
+/// Enabled by MavlinkSettings::adaptiveRateControl, the budget is MavlinkSettings::adaptiveRateBudget per link.
+class MessageRateController : public QObject
+{
+    Q_OBJECT
+
+    friend class MessageRateControllerTest;
+
+public:
+    MessageRateController(Vehicle *vehicle, MessageIntervalManager *intervalManager);
+    ~MessageRateController();
+
+    /// consumer needs msgId at rateHz until releaseRate() or until consumer is destroyed
+    void requestRate(QObject *consumer, uint32_t msgId, qreal rateHz);
+    void releaseRate(QObject *consumer, uint32_t msgId);
+
+    /// Leaves msgId alone while another owner, such as the PID tuning streams, sets its interval
+    void setExternallyManaged(uint32_t msgId, bool managed);
+
+    /// factGroup took values from a msgId message. The group then demands msgId at its update rate while it is observed.
+    void factGroupUpdated(FactGroup *factGroup, uint32_t msgId);
+
+    /// Measures every message of the vehicle, before any firmware plugin adjustment
+    void messageReceived(const mavlink_message_t &message);
+
+    /// Receive and loss totals of the vehicle's messages as reported by MAVLinkProtocol
+    void setLinkCounters(uint64_t totalReceived, uint64_t totalLoss) { _totalReceived = totalReceived; _totalLoss = totalLoss; }
+
+    bool enabled() const { return _enabled; }
+
+    /// Bytes per second the vehicle's traffic currently aims for, 0 while disabled
+    qreal budget() const { return _budget; }
+
+    /// Rate last commanded for msgId, 0 while the firmware default applies
+    int commandedRate(uint32_t msgId) const { return _streams.value(msgId).commandedHz; }
+
+    /// Rate for consumers which need every message the vehicle sends
+    static constexpr qreal kFullRateHz = 1000.;
+
+private slots:
+    void _update();
+
+private:
+    struct Stream {
+        qreal nativeHz = 0.;        ///< Rate the vehicle sends at its own default
+        qreal measuredHz = 0.;
+        qreal bytesPerMessage = 0.;
+        int windowMessages = 0;
+        qint64 windowBytes = 0;
+        int commandedHz = 0;        ///< 0: firmware default
+    };
+
+    void _setEnabled(bool enabled);
+    void _measure();
+    void _restoreDefaults();
+    void _command(uint32_t msgId, Stream &stream, int rateHz);
+    void _releaseConsumer(QObject *consumer);
+    qreal _demandedRate(uint32_t msgId) const;
+    qreal _linkShare() const;
+    static bool _isControllable(uint32_t msgId);
+    static int _wireLength(const mavlink_message_t &message);
+
+    Vehicle *_vehicle = nullptr;
+    MessageIntervalManager *_intervalManager = nullptr;
+    QTimer *_timer = nullptr;
+
+    QElapsedTimer _window;
+    DataRateTracker _linkRate;                          ///< All traffic of the vehicle, streams or not
+    QHash<uint32_t, Stream> _streams;
+    QHash<uint32_t, QHash<QObject*, qreal>> _requests;  ///< msgId -> consumer -> rate
+    QSet<QObject*> _consumers;
+    QHash<uint32_t, QList<QPointer<FactGroup>>> _factGroups; ///< msgId -> groups taking values from it
+    QSet<uint32_t> _externallyManaged;
+
+    uint64_t _totalReceived = 0;
+    uint64_t _totalLoss = 0;
+    uint64_t _windowStartReceived = 0;
+    uint64_t _windowStartLoss = 0;
+    qreal _lossPercent = 0.;                            ///< Loss within the last update window
+    qreal _budgetScale = 1.;
+    qreal _budget = 0.;
+    bool _enabled = false;
+
+    static constexpr int kUpdateIntervalMs = 1000;
+    static constexpr qreal kDisplayRateHz = 2.;         ///< Streams nothing observes, enough for a display to pick up
+    static constexpr qreal kMinRateHz = 1.;             ///< Streams are never throttled below this
+    static constexpr qreal kSmoothing = 0.5;            ///< Weight of the latest window in the measured rates
+    static constexpr qreal kLossThresholdPercent = 2.;
+    static constexpr qreal kBackoff = 0.7;              ///< Budget scale applied per update while the link reports loss
+    static constexpr qreal kRecovery = 0.1;             ///< Budget scale regained per update while the link is clean
+    static constexpr qreal kMinBudgetScale = 0.25;
+    static constexpr qreal kRestoreFraction = 0.9;      ///< Targets this close to the default rate restore the default
+    static constexpr qreal kHysteresis = 0.2;           ///< Relative change below which a commanded rate is kept
+    static constexpr int kMaxCommandsPerUpdate = 4;
+};
@@ -39,7 +39,7 @@ class RemoteIDManager : public QObject
     bool    vehicleReportsBasicIDMissing(void) const { return _vehicleReportsBasicIDMissing; }
     bool    emergencyDeclared   (void) const { return _emergencyDeclared;}
 
-    void mavlinkMessageReceived (mavlink_message_t& message);
+    void mavlinkMessageReceived (const mavlink_message_t& message);
 
     enum LocationTypes {
         TAKEOFF,
@@ -62,7 +62,7 @@ private slots:
     void _updateLastGCSPositionInfo(QGeoPositionInfo update);
 
 private:
-    void _handleArmStatus(mavlink_message_t& message);
+    void _handleArmStatus(const mavlink_message_t& message);
 
     // Self ID
     void        _sendSelfIDMsg ();
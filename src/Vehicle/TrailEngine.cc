@@ -0,0 +1,318 @@
+#include "TrailEngine.h"
+
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kE7 = 1e7;
+constexpr double kEarthRadiusMeters = 6378137.0;
+constexpr double kMetersPerPixelAtZoom0 = 156543.03392;    ///< Web mercator ground resolution at the equator
+constexpr double kViewportMargin = 0.5;                    ///< Fraction of the viewport size added on every side
+constexpr float kAlwaysKept = std::numeric_limits<float>::infinity();
+
+/// Distance in meters from p to the segment a-b, all in a local flat projection
+double _segmentDistance(double px, double py, double ax, double ay, double bx, double by)
+{
+    const double dx = bx - ax;
+    const double dy = by - ay;
+    const double lengthSquared = (dx * dx) + (dy * dy);
+    double t = 0;
+    if (lengthSquared > 0) {
+        t = std::clamp((((px - ax) * dx) + ((py - ay) * dy)) / lengthSquared, 0.0, 1.0);
+    }
+    const double ex = px - (ax + (t * dx));
+    const double ey = py - (ay + (t * dy));
+    return std::sqrt((ex * ex) + (ey * ey));
+}
+
+} // namespace
+
+TrailEngine::TrailEngine(int maxSamples)
+    : _maxChunks(std::max(2, (maxSamples + kChunkSize - 1) / kChunkSize))
+{
+}
+
+TrailEngine::Sample TrailEngine::_pack(const QGeoCoordinate &coordinate, qint64 timestampMSecs) const
+{
+    const qint64 relativeMSecs = std::clamp<qint64>(timestampMSecs - _firstTimestampMSecs, 0, std::numeric_limits<quint32>::max());
+
+    return Sample{
+        static_cast<qint32>(std::lround(coordinate.latitude() * kE7)),
+        static_cast<qint32>(std::lround(coordinate.longitude() * kE7)),
+        static_cast<float>(coordinate.altitude()),
+        static_cast<quint32>(relativeMSecs)
+    };
+}
+
+QGeoCoordinate TrailEngine::_toCoordinate(const Sample &sample)
+{
+    const double latitude = sample.latE7 / kE7;
+    const double longitude = sample.lonE7 / kE7;
+    if (std::isnan(sample.altitude)) {
+        return QGeoCoordinate(latitude, longitude);
+    }
+    return QGeoCoordinate(latitude, longitude, sample.altitude);
+}
+
+void TrailEngine::append(const QGeoCoordinate &coordinate, qint64 timestampMSecs)
+{
+    if (_firstTimestampMSecs < 0) {
+        _firstTimestampMSecs = timestampMSecs;
+    }
+
+    if (_chunks.empty() || (_chunks.back()->count == kChunkSize)) {
+        if (!_chunks.empty()) {
+            _closeChunk(*_chunks.back());
+        }
+
+        std::unique_ptr<Chunk> chunk;
+        if (static_cast<int>(_chunks.size()) >= _maxChunks) {
+            // Memory cap reached: the oldest chunk is dropped and its storage reused
+            chunk = std::move(_chunks.front());
+            _chunks.pop_front();
+            _count -= chunk->count;
+            chunk->count = 0;
+            for (std::vector<quint16> &level : chunk->levels) {
+                level.clear();
+            }
+            _trimCount++;
+        } else {
+            chunk = std::make_unique<Chunk>();
+        }
+        _chunks.push_back(std::move(chunk));
+    }
+
+    Chunk &chunk = *_chunks.back();
+    chunk.samples[chunk.count++] = _pack(coordinate, timestampMSecs);
+    _count++;
+}
+
+void TrailEngine::replaceLast(const QGeoCoordinate &coordinate, qint64 timestampMSecs)
+{
+    if (_chunks.empty()) {
+        append(coordinate, timestampMSecs);
+        return;
+    }
+
+    // The last chunk is always open, closing only happens when the next sample starts a new chunk
+    Chunk &chunk = *_chunks.back();
+    chunk.samples[chunk.count - 1] = _pack(coordinate, timestampMSecs);
+}
+
+void TrailEngine::clear()
+{
+    _chunks.clear();
+    _count = 0;
+    _trimCount = 0;
+    _firstTimestampMSecs = -1;
+}
+
+QGeoCoordinate TrailEngine::last() const
+{
+    if (_chunks.empty()) {
+        return QGeoCoordinate();
+    }
+
+    const Chunk &chunk = *_chunks.back();
+    return _toCoordinate(chunk.samples[chunk.count - 1]);
+}
+
+void TrailEngine::_simplify(const Sample *samples, int count, float *significance)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    std::fill(significance, significance + count, 0.0f);
+    significance[0] = kAlwaysKept;
+    significance[count - 1] = kAlwaysKept;
+    if (count < 3) {
+        return;
+    }
+
+    // Flat projection around the first sample, plenty accurate for the span of a single chunk
+    const double metersPerE7 = qDegreesToRadians(1.0 / kE7) * kEarthRadiusMeters;
+    const double lonScale = metersPerE7 * std::cos(qDegreesToRadians(samples[0].latE7 / kE7));
+    const qint32 originLat = samples[0].latE7;
+    const qint32 originLon = samples[0].lonE7;
+    auto x = [&](int i) { return static_cast<double>(samples[i].lonE7 - originLon) * lonScale; };
+    auto y = [&](int i) { return static_cast<double>(samples[i].latE7 - originLat) * metersPerE7; };
+
+    struct Range {
+        int     first;
+        int     last;
+        float   parentSignificance;
+    };
+    std::vector<Range> stack;
+    stack.reserve(64);
+    stack.push_back(Range{ 0, count - 1, kAlwaysKept });
+
+    while (!stack.empty()) {
+        const Range range = stack.back();
+        stack.pop_back();
+        if ((range.last - range.first) < 2) {
+            continue;
+        }
+
+        const double ax = x(range.first);
+        const double ay = y(range.first);
+        const double bx = x(range.last);
+        const double by = y(range.last);
+
+        int split = -1;
+        double maxDistance = -1;
+        for (int i = range.first + 1; i < range.last; i++) {
+            const double distance = _segmentDistance(x(i), y(i), ax, ay, bx, by);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                split = i;
+            }
+        }
+
+        // A point only survives a tolerance if every split above it did, which keeps the levels nested
+        const float splitSignificance = std::min(static_cast<float>(maxDistance), range.parentSignificance);
+        significance[split] = splitSignificance;
+        stack.push_back(Range{ range.first, split, splitSignificance });
+        stack.push_back(Range{ split, range.last, splitSignificance });
+    }
+}
+
+void TrailEngine::_closeChunk(Chunk &chunk)
+{
+    _simplify(chunk.samples.data(), chunk.count, chunk.significance.data());
+
+    for (int level = 1; level < kLevelCount; level++) {
+        std::vector<quint16> &indices = chunk.levels[level - 1];
+        const float tolerance = static_cast<float>(kLevelToleranceMeters[level]);
+        indices.clear();
+        for (int i = 0; i < chunk.count; i++) {
+            if (chunk.significance[i] > tolerance) {
+                indices.push_back(static_cast<quint16>(i));
+            }
+        }
+    }
+}
+
+int TrailEngine::levelForZoom(double zoomLevel, double latitude)
+{
+    const double metersPerPixel = kMetersPerPixelAtZoom0 * std::cos(qDegreesToRadians(latitude)) / std::pow(2.0, zoomLevel);
+
+    int level = 0;
+    while (((level + 1) < kLevelCount) && (kLevelToleranceMeters[level + 1] <= metersPerPixel)) {
+        level++;
+    }
+    return level;
+}
+
+template<typename Visitor>
+void TrailEngine::_forEachAtLevel(int level, const QGeoRectangle &viewport, Visitor &&visitor) const
+{
+    // Viewports crossing the antimeridian are not filtered
+    const bool filter = viewport.isValid() && (viewport.topLeft().longitude() <= viewport.bottomRight().longitude());
+    qint32 minLat = 0, maxLat = 0, minLon = 0, maxLon = 0;
+    if (filter) {
+        const double latMargin = viewport.height() * kViewportMargin;
+        const double lonMargin = viewport.width() * kViewportMargin;
+        minLat = static_cast<qint32>(std::clamp(viewport.bottomRight().latitude() - latMargin, -90.0, 90.0) * kE7);
+        maxLat = static_cast<qint32>(std::clamp(viewport.topLeft().latitude() + latMargin, -90.0, 90.0) * kE7);
+        minLon = static_cast<qint32>(std::clamp(viewport.topLeft().longitude() - lonMargin, -180.0, 180.0) * kE7);
+        maxLon = static_cast<qint32>(std::clamp(viewport.bottomRight().longitude() + lonMargin, -180.0, 180.0) * kE7);
+    }
+    auto touchesViewport = [&](const Sample &a, const Sample &b) {
+        return (std::max(a.latE7, b.latE7) >= minLat) && (std::min(a.latE7, b.latE7) <= maxLat) &&
+               (std::max(a.lonE7, b.lonE7) >= minLon) && (std::min(a.lonE7, b.lonE7) <= maxLon);
+    };
+    const float coarsestTolerance = static_cast<float>(kLevelToleranceMeters[kLevelCount - 1]);
+
+    // Points are decided with one point of look ahead: a point is needed if either adjacent segment at this level
+    // touches the viewport, otherwise only if the coarsest level keeps it
+    const Sample *previous = nullptr;
+    const Sample *current = nullptr;
+    float currentSignificance = 0;
+    auto decide = [&](const Sample *next) {
+        const bool keep = !filter || (currentSignificance > coarsestTolerance) ||
+                          (previous && touchesViewport(*previous, *current)) ||
+                          (next && touchesViewport(*current, *next)) ||
+                          (!previous && !next && touchesViewport(*current, *current));
+        if (keep) {
+            visitor(*current);
+        }
+    };
+    auto feed = [&](const Sample &sample, float significance) {
+        if (current) {
+            decide(&sample);
+        }
+        previous = current;
+        current = &sample;
+        currentSignificance = significance;
+    };
+
+    for (const std::unique_ptr<Chunk> &chunkPtr : _chunks) {
+        const Chunk &chunk = *chunkPtr;
+        const bool open = (chunkPtr == _chunks.back());
+        const float *significance = chunk.significance.data();
+        if (open && (filter || (level > 0))) {
+            // The open chunk is small, simplify it on demand
+            _tailSignificance.resize(kChunkSize);
+            _simplify(chunk.samples.data(), chunk.count, _tailSignificance.data());
+            significance = _tailSignificance.data();
+        }
+
+        if ((level == 0) || open) {
+            const float tolerance = static_cast<float>(kLevelToleranceMeters[level]);
+            for (int i = 0; i < chunk.count; i++) {
+                if ((level == 0) || (significance[i] > tolerance)) {
+                    feed(chunk.samples[i], significance[i]);
+                }
+            }
+        } else {
+            for (const quint16 index : chunk.levels[level - 1]) {
+                feed(chunk.samples[index], significance[index]);
+            }
+        }
+    }
+
+    if (current) {
+        decide(nullptr);
+    }
+}
+
+QVariantList TrailEngine::coordinates() const
+{
+    QVariantList coordinates;
+    coordinates.reserve(_count);
+    _forEachAtLevel(0, QGeoRectangle(), [&coordinates](const Sample &sample) {
+        coordinates.append(QVariant::fromValue(_toCoordinate(sample)));
+    });
+    return coordinates;
+}
+
+QVariantList TrailEngine::geometry(double zoomLevel, const QGeoRectangle &viewport) const
+{
+    QVariantList coordinates;
+    if (_chunks.empty()) {
+        return coordinates;
+    }
+
+    const int level = levelForZoom(zoomLevel, last().latitude());
+    _forEachAtLevel(level, viewport, [&coordinates](const Sample &sample) {
+        coordinates.append(QVariant::fromValue(_toCoordinate(sample)));
+    });
+    return coordinates;
+}
+
+int TrailEngine::geometryPointCount(double zoomLevel, const QGeoRectangle &viewport) const
+{
+    if (_chunks.empty()) {
+        return 0;
+    }
+
+    int count = 0;
+    const int level = levelForZoom(zoomLevel, last().latitude());
+    _forEachAtLevel(level, viewport, [&count](const Sample &) { count++; });
+    return count;
+}
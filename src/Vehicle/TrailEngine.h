@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QtCore/QtTypes>
+#include <QtCore/QVariantList>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/// Bounded storage and zoom aware simplification for a vehicle trail.
+///
+/// Samples are packed (1e-7 degree lat/lon, float altitude, msecs since the first sample) into fixed size chunks
+/// which form a ring: once the sample cap is reached the oldest chunk is recycled for new samples, so memory use per
+/// vehicle is fixed no matter how long the flight is.
+///
+/// When a chunk is closed it is simplified once with Douglas-Peucker. The simplification is hierarchical (a point
+/// kept at a coarse tolerance is also kept at every finer one) so one pass records each point's significance and
+/// the per zoom band index lists fall out of it. Queries hand back only the points needed at a zoom level: full
+/// detail inside the viewport, the coarsest band outside of it.
+class TrailEngine
+{
+public:
+    static constexpr int kChunkSize = 1024;
+    static constexpr int kDefaultMaxSamples = 64 * kChunkSize;  ///< ~1.3 MB per vehicle
+    static constexpr int kLevelCount = 7;                       ///< Level 0 is full resolution
+
+    /// Douglas-Peucker tolerance in meters for each level
+    static constexpr std::array<double, kLevelCount> kLevelToleranceMeters = { 0, 1, 4, 16, 64, 256, 1024 };
+
+    explicit TrailEngine(int maxSamples = kDefaultMaxSamples);
+
+    void append(const QGeoCoordinate &coordinate, qint64 timestampMSecs);
+
+    /// Replaces the most recent sample, used while the vehicle moves along a straight segment
+    void replaceLast(const QGeoCoordinate &coordinate, qint64 timestampMSecs);
+
+    void clear();
+
+    int count() const { return _count; }
+    bool isEmpty() const { return _count == 0; }
+    int maxSamples() const { return _maxChunks * kChunkSize; }
+    QGeoCoordinate last() const;
+
+    /// @return Number of times the oldest samples were dropped to honor the memory cap
+    int trimCount() const { return _trimCount; }
+
+    /// @return Number of closed (simplified) chunks, changes when the simplified geometry changes
+    int closedChunkCount() const { return _chunks.empty() ? 0 : static_cast<int>(_chunks.size()) - 1; }
+
+    /// @return Level whose tolerance stays below one screen pixel at the specified map zoom level
+    static int levelForZoom(double zoomLevel, double latitude);
+
+    /// @return Full resolution trail
+    QVariantList coordinates() const;
+
+    /// @return Points needed to draw the trail at the zoom level. Segments touching @p viewport (plus a margin)
+    ///         use the level for the zoom, the remainder uses the coarsest level. Invalid viewport: whole trail at
+    ///         the zoom level.
+    QVariantList geometry(double zoomLevel, const QGeoRectangle &viewport) const;
+
+    /// @return Number of points geometry() would produce, used by tests and benchmarks
+    int geometryPointCount(double zoomLevel, const QGeoRectangle &viewport) const;
+
+private:
+    struct Sample {
+        qint32  latE7;
+        qint32  lonE7;
+        float   altitude;
+        quint32 timeMSecs;
+    };
+    static_assert(sizeof(Sample) == 16, "Trail samples must stay packed");
+
+    struct Chunk {
+        std::array<Sample, kChunkSize>                      samples{};
+        std::array<float, kChunkSize>                       significance{};   ///< Largest tolerance which keeps the point
+        std::array<std::vector<quint16>, kLevelCount - 1>   levels;             ///< Kept indices for levels 1..n
+        int                                                 count = 0;
+    };
+
+    static void _closeChunk(Chunk &chunk);
+    static void _simplify(const Sample *samples, int count, float *significance);
+    static QGeoCoordinate _toCoordinate(const Sample &sample);
+
+    /// Calls visitor(const Sample&) for every point of the trail which survives at the level
+    template<typename Visitor>
+    void _forEachAtLevel(int level, const QGeoRectangle &viewport, Visitor &&visitor) const;
+
+    Sample _pack(const QGeoCoordinate &coordinate, qint64 timestampMSecs) const;
+
+    std::deque<std::unique_ptr<Chunk>> _chunks;     ///< Oldest first, the last chunk is the open (unsimplified) one
+    int _maxChunks = 1;
+    int _count = 0;
+    int _trimCount = 0;
+    qint64 _firstTimestampMSecs = -1;
+    mutable std::vector<float> _tailSignificance;
+};
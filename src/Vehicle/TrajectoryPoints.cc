@@ -6,6 +6,12 @@ TrajectoryPoints::TrajectoryPoints(Vehicle* vehicle, QObject* parent)
     , _vehicle      (vehicle)
     , _lastAzimuth  (qQNaN())
 {
+    _trailClock.start();
+}
+
+QVariantList TrajectoryPoints::geometry(double zoomLevel, const QGeoShape& visibleRegion) const
+{
+    return _trail.geometry(zoomLevel, visibleRegion.isValid() ? visibleRegion.boundingGeoRectangle() : QGeoRectangle());
 }
 
 void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
@@ -24,20 +30,26 @@ void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
                 // The new position IS NOT colinear with the last segment. Append the new position to the list.
                 _lastAzimuth = _lastPoint.azimuthTo(coordinate);
                 _lastPoint = coordinate;
-                _points.append(QVariant::fromValue(coordinate));
+                const int closedChunkCount = _trail.closedChunkCount();
+                const int trimCount = _trail.trimCount();
+                _trail.append(coordinate, _trailClock.elapsed());
                 emit pointAdded(coordinate);
+                if ((_trail.closedChunkCount() != closedChunkCount) || (_trail.trimCount() != trimCount)) {
+                    // A chunk was simplified and/or the oldest chunk dropped: the map should re-query the geometry
+                    emit geometryChanged();
+                }
             } else {
                 // The new position IS colinear with the last segment. Don't add a new point, just update
                 // the last point to be the new position.
                 _lastPoint = coordinate;
-                _points[_points.count() - 1] = QVariant::fromValue(coordinate);
+                _trail.replaceLast(coordinate, _trailClock.elapsed());
                 emit updateLastPoint(coordinate);
             }
         }
     } else {
         // Add the very first trajectory point to the list
         _lastPoint = coordinate;
-        _points.append(QVariant::fromValue(coordinate));
+        _trail.append(coordinate, _trailClock.elapsed());
         emit pointAdded(coordinate);
     }
 }
@@ -55,7 +67,7 @@ void TrajectoryPoints::stop(void)
 
 void TrajectoryPoints::clear(void)
 {
-    _points.clear();
+    _trail.clear();
     _lastPoint = QGeoCoordinate();
     _lastAzimuth = qQNaN();
     emit pointsCleared();
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoShape>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "TrailEngine.h"
+
 class Vehicle;
 
 class TrajectoryPoints : public QObject
@@ -15,7 +19,13 @@ class TrajectoryPoints : public QObject
 public:
     TrajectoryPoints(Vehicle* vehicle, QObject* parent = nullptr);
 
-    Q_INVOKABLE QVariantList list(void) const { return _points; }
+    /// Full resolution trail (bounded by TrailEngine::maxSamples)
+    Q_INVOKABLE QVariantList list(void) const { return _trail.coordinates(); }
+
+    /// Trail simplified for the map zoom level, full detail only near the visible region
+    Q_INVOKABLE QVariantList geometry(double zoomLevel, const QGeoShape& visibleRegion) const;
+
+    const TrailEngine& trail(void) const { return _trail; }
 
     void start  (void);
     void stop   (void);
@@ -27,13 +37,15 @@ public slots:
     void pointAdded     (QGeoCoordinate coordinate);
     void updateLastPoint(QGeoCoordinate coordinate);
     void pointsCleared  (void);
+    void geometryChanged(void);     ///< Simplified geometry changed (chunk simplified or oldest points dropped), re-query geometry()
 
 private slots:
     void _vehicleCoordinateChanged(QGeoCoordinate coordinate);
 
 private:
     Vehicle*        _vehicle;
-    QVariantList    _points;
+    TrailEngine     _trail;
+    QElapsedTimer   _trailClock;
     QGeoCoordinate  _lastPoint;
     double          _lastAzimuth;
 
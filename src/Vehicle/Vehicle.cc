@@ -44,6 +44,7 @@
 #include "LinkManager.h"
 #include "MavCommandQueue.h"
 #include "MessageIntervalManager.h"
+#include "MessageRateController.h"
 #include "TerrainQueryCoordinator.h"
 #include "MAVLinkLogManager.h"
 #include "MAVLinkProtocol.h"
@@ -129,7 +130,7 @@ Vehicle::Vehicle(LinkInterface*             link,
 {
     connect(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged, this, &Vehicle::_activeVehicleChanged);
 
-    connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived,        this, &Vehicle::_mavlinkMessageReceived);
+    connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::frameReceived,          this, &Vehicle::_mavlinkMessageReceived);
     connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus,   this, &Vehicle::_mavlinkMessageStatus);
 
     connect(this, &Vehicle::flightModeChanged,          this, &Vehicle::_handleFlightModeChanged);
@@ -169,7 +170,7 @@ Vehicle::Vehicle(LinkInterface*             link,
 
     _firmwarePlugin->initializeVehicle(this);
     for(auto& factName: factNames()) {
-        _firmwarePlugin->adjustMetaData(vehicleType, getFact(factName)->metaData());
+        _firmwarePlugin->adjustMetaData(vehicleType, getFact(factName));
     }
 
     _sendMultipleTimer.start(_sendMessageMultipleIntraMessageDelay);
@@ -282,6 +283,7 @@ void Vehicle::_commonInit(LinkInterface* link)
     _messageIntervalManager = new MessageIntervalManager(this, _mavCmdQueue, _reqMsgCoord);
     connect(_messageIntervalManager, &MessageIntervalManager::mavlinkMsgIntervalsChanged,
             this, &Vehicle::mavlinkMsgIntervalsChanged);
+    _messageRateController = new MessageRateController(this, _messageIntervalManager);
     _terrainQueryCoordinator = new TerrainQueryCoordinator(this);
     connect(this, &Vehicle::coordinateChanged, _terrainQueryCoordinator, &TerrainQueryCoordinator::updateAltAboveTerrain);
 
@@ -547,30 +549,33 @@ void Vehicle::resetCounters()
     _heardFrom          = false;
 }
 
-void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t message)
+void Vehicle::_mavlinkMessageReceived(LinkInterface* link, const MAVLinkFrame& received)
 {
-    if (message.sysid != _systemID && message.sysid != 0) {
+    const mavlink_message_t& incoming = received.message();
+
+    if (incoming.sysid != _systemID && incoming.sysid != 0) {
         // We allow RADIO_STATUS messages which come from a link the vehicle is using to pass through and be handled
-        if (!(message.msgid == MAVLINK_MSG_ID_RADIO_STATUS && _vehicleLinkManager->containsLink(link))) {
+        if (!(incoming.msgid == MAVLINK_MSG_ID_RADIO_STATUS && _vehicleLinkManager->containsLink(link))) {
             return;
         }
     }
 
     // We give the link manager first whack since it it reponsible for adding new links
-    _vehicleLinkManager->mavlinkMessageReceived(link, message);
+    _vehicleLinkManager->mavlinkMessageReceived(link, incoming);
+    _messageRateController->messageReceived(incoming);
 
     //-- Check link status
     _messagesReceived++;
     emit messagesReceivedChanged();
     if(!_heardFrom) {
-        if(message.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+        if(incoming.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
             _heardFrom  = true;
-            _compID     = message.compid;
-            _messageSeq = message.seq + 1;
+            _compID     = incoming.compid;
+            _messageSeq = incoming.seq + 1;
         }
     } else {
-        if(_compID == message.compid) {
-            uint16_t seq_received = static_cast<uint16_t>(message.seq);
+        if(_compID == incoming.compid) {
+            uint16_t seq_received = static_cast<uint16_t>(incoming.seq);
             uint16_t packet_lost_count = 0;
             //-- Account for overflow during packet loss
             if(seq_received < _messageSeq) {
@@ -578,17 +583,20 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
             } else {
                 packet_lost_count = seq_received - _messageSeq;
             }
-            _messageSeq = message.seq + 1;
+            _messageSeq = incoming.seq + 1;
             _messagesLost += packet_lost_count;
             if(packet_lost_count)
                 emit messagesLostChanged();
         }
     }
 
-    // Give the plugin a change to adjust the message contents
-    if (!_firmwarePlugin->adjustIncomingMavlinkMessage(this, &message)) {
+    // Give the plugin a change to adjust the message contents. The frame shares the parser's buffer, the plugin
+    // only copies it for the few messages it rewrites.
+    MAVLinkFrame frame = received;
+    if (!_firmwarePlugin->adjustIncomingMavlinkMessage(this, frame)) {
         return;
     }
+    const mavlink_message_t& message = frame.message();
 
     // Give the Core Plugin access to all mavlink traffic
     if (!QGCCorePlugin::instance()->mavlinkMessage(this, link, message)) {
@@ -600,7 +608,7 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     }
     _ftpManager->_mavlinkMessageReceived(message);
     _parameterManager->mavlinkMessageReceived(message);
-    (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
+    _imageProtocolManager->mavlinkMessageReceived(message);
     _remoteIDManager->mavlinkMessageReceived(message);
 
     _reqMsgCoord->handleReceivedMessage(message);
@@ -609,11 +617,18 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     _batteryFactGroupListModel->handleMessageForFactGroupCreation(this, message);
     _escStatusFactGroupListModel->handleMessageForFactGroupCreation(this, message);
 
-    // Let the fact groups take a whack at the mavlink traffic
+    // Let the fact groups take a whack at the mavlink traffic. While the stream rates are shaped the rate controller
+    // learns which groups each message feeds, their displays are what the stream is demanded for.
+    const bool trackConsumers = _messageRateController->enabled();
     for (FactGroup* factGroup : factGroups()) {
+        const quint64 valueWrites = factGroup->valueWrites();
         factGroup->handleMessage(this, message);
+        if (trackConsumers && (factGroup->valueWrites() != valueWrites)) {
+            _messageRateController->factGroupUpdated(factGroup, message.msgid);
+        }
     }
 
+    const quint64 vehicleValueWrites = valueWrites();
     this->handleMessage(this, message);
 
     switch (message.msgid) {
@@ -780,6 +795,10 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
         break;
     }
 
+    if (trackConsumers && (valueWrites() != vehicleValueWrites)) {
+        _messageRateController->factGroupUpdated(this, message.msgid);
+    }
+
     // This must be emitted after the vehicle processes the message. This way the vehicle state is up to date when anyone else
     // does processing.
     emit mavlinkMessageReceived(message);
@@ -873,7 +892,7 @@ void Vehicle::_handleCameraImageCaptured(const mavlink_message_t& message)
 }
 
 // TODO: VehicleFactGroup
-void Vehicle::_handleGpsRawInt(mavlink_message_t& message)
+void Vehicle::_handleGpsRawInt(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -899,7 +918,7 @@ void Vehicle::_handleGpsRawInt(mavlink_message_t& message)
 }
 
 // TODO: VehicleFactGroup
-void Vehicle::_handleGlobalPositionInt(mavlink_message_t& message)
+void Vehicle::_handleGlobalPositionInt(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -928,7 +947,7 @@ void Vehicle::_handleGlobalPositionInt(mavlink_message_t& message)
 }
 
 // TODO: VehicleFactGroup
-void Vehicle::_handleHighLatency(mavlink_message_t& message)
+void Vehicle::_handleHighLatency(const mavlink_message_t& message)
 {
     mavlink_high_latency_t highLatency;
     mavlink_msg_high_latency_decode(&message, &highLatency);
@@ -975,7 +994,7 @@ void Vehicle::_handleHighLatency(mavlink_message_t& message)
 }
 
 // TODO: VehicleFactGroup
-void Vehicle::_handleHighLatency2(mavlink_message_t& message)
+void Vehicle::_handleHighLatency2(const mavlink_message_t& message)
 {
     mavlink_high_latency2_t highLatency2;
     mavlink_msg_high_latency2_decode(&message, &highLatency2);
@@ -1083,7 +1102,7 @@ QString Vehicle::vehicleUID2Str()
     return uid2;
 }
 
-void Vehicle::_handleExtendedSysState(mavlink_message_t& message)
+void Vehicle::_handleExtendedSysState(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -1126,7 +1145,7 @@ bool Vehicle::_apmArmingNotRequired()
             _parameterManager->getParameter(ParameterManager::defaultComponentId, armingRequireParam)->rawValue().toInt() == 0;
 }
 
-void Vehicle::_handleSysStatus(mavlink_message_t& message)
+void Vehicle::_handleSysStatus(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -1184,7 +1203,7 @@ void Vehicle::_handleSysStatus(mavlink_message_t& message)
     }
 }
 
-void Vehicle::_handleBatteryStatus(mavlink_message_t& message)
+void Vehicle::_handleBatteryStatus(const mavlink_message_t& message)
 {
     mavlink_battery_status_t batteryStatus;
     mavlink_msg_battery_status_decode(&message, &batteryStatus);
@@ -1252,7 +1271,7 @@ void Vehicle::_setHomePosition(QGeoCoordinate& homeCoord)
     }
 }
 
-void Vehicle::_handleHomePosition(mavlink_message_t& message)
+void Vehicle::_handleHomePosition(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -1292,7 +1311,7 @@ void Vehicle::_updateArmed(bool armed)
     }
 }
 
-void Vehicle::_handlePing(LinkInterface* link, mavlink_message_t& message)
+void Vehicle::_handlePing(LinkInterface* link, const mavlink_message_t& message)
 {
     SharedLinkInterfacePtr sharedLink = vehicleLinkManager()->primaryLink().lock();
     if (!sharedLink) {
@@ -1330,7 +1349,7 @@ void Vehicle::setActuatorsMetadata([[maybe_unused]] uint8_t compid,
     _actuators->load(metadataJsonFileName, metadataJson);
 }
 
-void Vehicle::_handleHeartbeat(mavlink_message_t& message)
+void Vehicle::_handleHeartbeat(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -1370,7 +1389,7 @@ void Vehicle::_handleHeartbeat(mavlink_message_t& message)
     }
 }
 
-void Vehicle::_handleCurrentMode(mavlink_message_t& message)
+void Vehicle::_handleCurrentMode(const mavlink_message_t& message)
 {
     if (message.compid != _defaultComponentId) {
         return;
@@ -1389,7 +1408,7 @@ void Vehicle::_handleCurrentMode(mavlink_message_t& message)
     }
 }
 
-void Vehicle::_handleRCChannels(mavlink_message_t& message)
+void Vehicle::_handleRCChannels(const mavlink_message_t& message)
 {
     mavlink_rc_channels_t channels;
 
@@ -2281,7 +2300,7 @@ void Vehicle::showCommandAckError(const mavlink_command_ack_t& ack)
     MavCommandQueue::showCommandAckError(ack);
 }
 
-void Vehicle::_handleCommandAck(mavlink_message_t& message)
+void Vehicle::_handleCommandAck(const mavlink_message_t& message)
 {
     mavlink_command_ack_t ack;
     mavlink_msg_command_ack_decode(&message, &ack);
@@ -2578,7 +2597,7 @@ void Vehicle::_ackMavlinkLogData(uint16_t sequence)
     sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
 }
 
-void Vehicle::_handleMavlinkLoggingData(mavlink_message_t& message)
+void Vehicle::_handleMavlinkLoggingData(const mavlink_message_t& message)
 {
     mavlink_logging_data_t log;
     mavlink_msg_logging_data_decode(&message, &log);
@@ -2590,7 +2609,7 @@ void Vehicle::_handleMavlinkLoggingData(mavlink_message_t& message)
     }
 }
 
-void Vehicle::_handleMavlinkLoggingDataAcked(mavlink_message_t& message)
+void Vehicle::_handleMavlinkLoggingDataAcked(const mavlink_message_t& message)
 {
     mavlink_logging_data_acked_t log;
     mavlink_msg_logging_data_acked_decode(&message, &log);
@@ -2831,6 +2850,7 @@ void Vehicle::_mavlinkMessageStatus(int uasId, uint64_t totalSent, uint64_t tota
         _mavlinkReceivedCount   = totalReceived;
         _mavlinkLossCount       = totalLoss;
         _mavlinkLossPercent     = lossPercent;
+        _messageRateController->setLinkCounters(totalReceived, totalLoss);
         emit mavlinkStatusChanged();
     }
 }
@@ -2877,6 +2897,8 @@ void Vehicle::setPIDTuningTelemetryMode(PIDTuningTelemetryMode mode)
 
 void Vehicle::_setMessageInterval(int messageId, int rate)
 {
+    // Streams configured for the PID tuning charts are not shaped by the adaptive rate control until restored
+    _messageRateController->setExternallyManaged(static_cast<uint32_t>(messageId), rate != 0);
     sendMavCommand(defaultComponentId(),
                    MAV_CMD_SET_MESSAGE_INTERVAL,
                    true,                        // show error
@@ -3242,18 +3264,40 @@ void Vehicle::clearAllParamMapRC(void)
     }
 }
 
-void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6)
+SharedLinkInterfacePtr Vehicle::_joystickLinkThreadSafe() const
 {
-    SharedLinkInterfacePtr sharedLink = vehicleLinkManager()->primaryLink().lock();
+    SharedLinkInterfacePtr sharedLink = _vehicleLinkManager->primaryLink().lock();
     if (!sharedLink) {
-        qCDebug(VehicleLog)<< "sendJoystickDataThreadSafe: primary link gone!";
-        return;
+        qCDebug(VehicleLog) << "primary link gone!";
+        return nullptr;
     }
 
     if (sharedLink->linkConfiguration()->isHighLatency()) {
-        return;
+        return nullptr;
     }
 
+    return sharedLink;
+}
+
+void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6)
+{
+    if (SharedLinkInterfacePtr sharedLink = _joystickLinkThreadSafe()) {
+        _sendJoystickDataOnLinkThreadSafe(sharedLink.get(), roll, pitch, yaw, thrust, buttons, buttons2, pitchExtension, rollExtension, aux1, aux2, aux3, aux4, aux5, aux6);
+    }
+}
+
+void Vehicle::sendJoystickControlThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6,
+                                            const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride)
+{
+    // One primary link lookup for both messages so they always go out back to back on the same link
+    if (SharedLinkInterfacePtr sharedLink = _joystickLinkThreadSafe()) {
+        _sendJoystickDataOnLinkThreadSafe(sharedLink.get(), roll, pitch, yaw, thrust, buttons, buttons2, pitchExtension, rollExtension, aux1, aux2, aux3, aux4, aux5, aux6);
+        _sendJoystickAuxRcOverrideOnLinkThreadSafe(sharedLink.get(), channelValues, channelEnabled, useRcOverride);
+    }
+}
+
+void Vehicle::_sendJoystickDataOnLinkThreadSafe(LinkInterface *link, float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6)
+{
     mavlink_message_t message;
 
     float axesScaling = 1.0 * 1000.0;
@@ -3279,7 +3323,7 @@ void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, flo
     mavlink_msg_manual_control_pack_chan(
         static_cast<uint8_t>(MAVLinkProtocol::instance()->getSystemId()),
         static_cast<uint8_t>(MAVLinkProtocol::getComponentId()),
-        sharedLink->mavlinkChannel(),
+        link->mavlinkChannel(),
         &message,
         static_cast<uint8_t>(_systemID),
         static_cast<int16_t>(newPitchCommand),
@@ -3297,23 +3341,20 @@ void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, flo
         outgoingExtensionValues[6],
         outgoingExtensionValues[7]
     );
-    sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    sendMessageOnLinkThreadSafe(link, message);
 }
 
 // Sends RC_CHANNELS_OVERRIDE for joystick aux axes mapped to RC channels 5–10 only.
 // Channels 1–4 (attitude axes) always carry UINT16_MAX (ignore) and channels 11–18 are unused.
 void Vehicle::sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride)
 {
-    SharedLinkInterfacePtr sharedLink = vehicleLinkManager()->primaryLink().lock();
-    if (!sharedLink) {
-        qCDebug(VehicleLog) << "sendJoystickAuxRcOverrideThreadSafe: primary link gone!";
-        return;
-    }
-
-    if (sharedLink->linkConfiguration()->isHighLatency()) {
-        return;
+    if (SharedLinkInterfacePtr sharedLink = _joystickLinkThreadSafe()) {
+        _sendJoystickAuxRcOverrideOnLinkThreadSafe(sharedLink.get(), channelValues, channelEnabled, useRcOverride);
     }
+}
 
+void Vehicle::_sendJoystickAuxRcOverrideOnLinkThreadSafe(LinkInterface *link, const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride)
+{
     bool anyEnabledChannel = false;
     for (bool enabled : channelEnabled) {
         if (enabled) {
@@ -3333,7 +3374,7 @@ void Vehicle::sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAu
         mavlink_msg_rc_channels_override_pack_chan(
             static_cast<uint8_t>(MAVLinkProtocol::instance()->getSystemId()),
             static_cast<uint8_t>(MAVLinkProtocol::getComponentId()),
-            sharedLink->mavlinkChannel(),
+            link->mavlinkChannel(),
             &releaseMessage,
             static_cast<uint8_t>(_systemID),
             static_cast<uint8_t>(_defaultComponentId),
@@ -3355,7 +3396,7 @@ void Vehicle::sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAu
             0,
             0,
             0);
-        sendMessageOnLinkThreadSafe(sharedLink.get(), releaseMessage);
+        sendMessageOnLinkThreadSafe(link, releaseMessage);
         return;
     }
 
@@ -3363,7 +3404,7 @@ void Vehicle::sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAu
     mavlink_msg_rc_channels_override_pack_chan(
         static_cast<uint8_t>(MAVLinkProtocol::instance()->getSystemId()),
         static_cast<uint8_t>(MAVLinkProtocol::getComponentId()),
-        sharedLink->mavlinkChannel(),
+        link->mavlinkChannel(),
         &message,
         static_cast<uint8_t>(_systemID),
         static_cast<uint8_t>(_defaultComponentId),
@@ -3385,7 +3426,7 @@ void Vehicle::sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAu
         0,
         0,
         0);
-    sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    sendMessageOnLinkThreadSafe(link, message);
     _joystickAuxRcOverrideActive = true;
 }
 
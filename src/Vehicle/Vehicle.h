@@ -17,6 +17,7 @@
 #include <array>
 #include <atomic>
 
+#include "MAVLinkFrame.h"
 #include "QGCMAVLink.h"
 #include "VehicleFactGroup.h"
 #include "VehicleSigningController.h"  // Q_PROPERTY needs the full QObject type for moc/QML metatype registration
@@ -77,6 +78,7 @@ class LinkInterface;
 class MAVLinkLogManager;
 class MavCommandQueue;
 class MessageIntervalManager;
+class MessageRateController;
 class MissionManager;
 class ParameterManager;
 class RequestMessageCoordinator;
@@ -454,6 +456,9 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
     /// Sends RC_CHANNELS_OVERRIDE for joystick aux axes mapped to RC channels 5–10 only.
     static constexpr int kAuxRcOverrideChannelCount = 6; ///< Number of RC channels overridden (channels 5–10)
     void sendJoystickAuxRcOverrideThreadSafe(const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride);
+    /// Sends MANUAL_CONTROL followed by the aux RC_CHANNELS_OVERRIDE using a single primary link lookup
+    void sendJoystickControlThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6,
+                                       const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride);
 
     // Property accesors
     int id() const{ return _systemID; }
@@ -624,6 +629,7 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
     Autotune*                       autotune            () const { return _autotune; }
     DropSequence*                   dropSequence        () const { return _dropSequence; }
     RemoteIDManager*                remoteIDManager     () { return _remoteIDManager; }
+    MessageRateController*          messageRateController() { return _messageRateController; }
 
     static void showCommandAckError(const mavlink_command_ack_t& ack);
 
@@ -885,7 +891,7 @@ public slots:
     void logData                        (uint32_t ofs, uint16_t id, uint8_t count, const uint8_t* data);
 
 private slots:
-    void _mavlinkMessageReceived            (LinkInterface* link, mavlink_message_t message);
+    void _mavlinkMessageReceived            (LinkInterface* link, const MAVLinkFrame& received);
     void _sendMessageMultipleNext           ();
     void _parametersReady                   (bool parametersReady);
     void _handleFlightModeChanged           (const QString& flightMode);
@@ -913,19 +919,19 @@ private slots:
 
 private:
     void _activeVehicleChanged          (Vehicle* newActiveVehicle);
-    void _handlePing                    (LinkInterface* link, mavlink_message_t& message);
-    void _handleHomePosition            (mavlink_message_t& message);
-    void _handleHeartbeat               (mavlink_message_t& message);
-    void _handleCurrentMode             (mavlink_message_t& message);
-    void _handleRCChannels              (mavlink_message_t& message);
-    void _handleBatteryStatus           (mavlink_message_t& message);
-    void _handleSysStatus               (mavlink_message_t& message);
-    void _handleExtendedSysState        (mavlink_message_t& message);
-    void _handleCommandAck              (mavlink_message_t& message);
-    void _handleGpsRawInt               (mavlink_message_t& message);
-    void _handleGlobalPositionInt       (mavlink_message_t& message);
-    void _handleHighLatency             (mavlink_message_t& message);
-    void _handleHighLatency2            (mavlink_message_t& message);
+    void _handlePing                    (LinkInterface* link, const mavlink_message_t& message);
+    void _handleHomePosition            (const mavlink_message_t& message);
+    void _handleHeartbeat               (const mavlink_message_t& message);
+    void _handleCurrentMode             (const mavlink_message_t& message);
+    void _handleRCChannels              (const mavlink_message_t& message);
+    void _handleBatteryStatus           (const mavlink_message_t& message);
+    void _handleSysStatus               (const mavlink_message_t& message);
+    void _handleExtendedSysState        (const mavlink_message_t& message);
+    void _handleCommandAck              (const mavlink_message_t& message);
+    void _handleGpsRawInt               (const mavlink_message_t& message);
+    void _handleGlobalPositionInt       (const mavlink_message_t& message);
+    void _handleHighLatency             (const mavlink_message_t& message);
+    void _handleHighLatency2            (const mavlink_message_t& message);
     void _handleOrbitExecutionStatus    (const mavlink_message_t& message);
     void _handleGimbalOrientation       (const mavlink_message_t& message);
     void _handleObstacleDistance        (const mavlink_message_t& message);
@@ -943,8 +949,11 @@ private slots:
     void _rallyPointManagerError        (int errorCode, const QString& errorMsg);
     void _say                           (const QString& text);
     QString _vehicleIdSpeech            ();
-    void _handleMavlinkLoggingData      (mavlink_message_t& message);
-    void _handleMavlinkLoggingDataAcked (mavlink_message_t& message);
+    std::shared_ptr<LinkInterface> _joystickLinkThreadSafe() const;
+    void _sendJoystickDataOnLinkThreadSafe(LinkInterface *link, float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6);
+    void _sendJoystickAuxRcOverrideOnLinkThreadSafe(LinkInterface *link, const std::array<uint16_t, kAuxRcOverrideChannelCount> &channelValues, const std::array<bool, kAuxRcOverrideChannelCount> &channelEnabled, bool useRcOverride);
+    void _handleMavlinkLoggingData      (const mavlink_message_t& message);
+    void _handleMavlinkLoggingDataAcked (const mavlink_message_t& message);
     void _ackMavlinkLogData             (uint16_t sequence);
     void _commonInit                    (LinkInterface* link);
     void _setupAutoDisarmSignalling     ();
@@ -1223,6 +1232,7 @@ private slots:
 
 private:
     MessageIntervalManager* _messageIntervalManager = nullptr;
+    MessageRateController*  _messageRateController = nullptr;
 
 /*---------------------------------------------------------------------------*/
 /*===========================================================================*/
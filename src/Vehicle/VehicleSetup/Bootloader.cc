@@ -5,8 +5,11 @@
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QQueue>
 #include <QtCore/QThread>
 
+#include <cstring>
+
 QGC_LOGGING_CATEGORY(FirmwareUpgradeLog, "VehicleSetup.FirmwareUpgrade")
 QGC_LOGGING_CATEGORY(FirmwareUpgradeVerboseLog, "VehicleSetup.FirmwareUpgrade:verbose")
 
@@ -15,7 +18,8 @@ Bootloader::Bootloader(bool sikRadio, QObject *parent)
     : QObject   (parent)
     , _sikRadio (sikRadio)
 {
-
+    // SiK radios are flashed over a plain UART without flow control, their bootloader cannot queue commands
+    _programWindow = _sikRadio ? 1 : _programWindowDefault;
 }
 
 bool Bootloader::open(const QString portName)
@@ -177,22 +181,31 @@ bool Bootloader::erase(void)
         timeout += (_boardFlashSize / 1e6) * 4000;
     }
 
+    QElapsedTimer elapsed;
+    elapsed.start();
+
     // Erase is slow, need larger timeout
     if (!_sendCommand(PROTO_CHIP_ERASE, timeout)) {
         _errorString = tr("Erase failed: %1").arg(_errorString);
         return false;
     }
 
+    _eraseMsecs = elapsed.elapsed();
     return true;
 }
 
 bool Bootloader::program(const FirmwareImage* image)
 {
-    if (image->imageIsBinFormat()) {
-        return _binProgram(image);
-    } else {
-        return _ihxProgram(image);
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    const bool success = image->imageIsBinFormat() ? _binProgram(image) : _ihxProgram(image);
+    if (success) {
+        _programMsecs = elapsed.elapsed();
+        qCDebug(FirmwareUpgradeLog) << "Program took" << _programMsecs << "msecs, window" << _programWindow;
     }
+
+    return success;
 }
 
 bool Bootloader::reboot(void)
@@ -297,6 +310,19 @@ bool Bootloader::_getCommandResponse(int responseTimeout)
     return true;
 }
 
+/// Consumes the responses of commands which were already sent when an earlier one failed, so they are not taken for
+/// the response to the next command
+///     @param count Number of responses still outstanding
+void Bootloader::_discardResponses(int count)
+{
+    QElapsedTimer timeout;
+    timeout.start();
+    while ((_port.bytesAvailable() < (count * 2)) && (timeout.elapsed() < _responseTimeout)) {
+        _port.waitForReadyRead(100);
+    }
+    (void) _port.readAll();
+}
+
 /// Send a PROTO_GET_DEVICE command to retrieve a value from the PX4 bootloader
 ///     @param param Value to retrieve using INFO_BOARD_* enums
 ///     @param value Returned value
@@ -353,56 +379,68 @@ bool Bootloader::_binProgram(const FirmwareImage* image)
     }
     uint32_t imageSize = (uint32_t)firmwareFile.size();
 
-    uint8_t imageBuf[PROG_MULTI_MAX];
+    // PROTO_PROG_MULTI, byte count, data, PROTO_EOC
+    uint8_t packet[PROG_MULTI_MAX + 3];
     uint32_t bytesSent = 0;
+    QQueue<uint32_t> inFlight;      ///< Address of each chunk sent but not acknowledged yet, oldest first
     _imageCRC = 0;
 
     Q_ASSERT(PROG_MULTI_MAX <= 0x8F);
 
-    while (bytesSent < imageSize) {
-        int bytesToSend = imageSize - bytesSent;
-        if (bytesToSend > (int)sizeof(imageBuf)) {
-            bytesToSend = (int)sizeof(imageBuf);
-        }
-
-        Q_ASSERT((bytesToSend % 4) == 0);
+    // Up to _programWindow chunks are sent ahead of their responses. The bootloader handles commands strictly in order,
+    // so each INSYNC/OK belongs to the oldest chunk in flight.
+    while ((bytesSent < imageSize) || !inFlight.isEmpty()) {
+        while ((bytesSent < imageSize) && (inFlight.count() < _programWindow)) {
+            int bytesToSend = imageSize - bytesSent;
+            if (bytesToSend > PROG_MULTI_MAX) {
+                bytesToSend = PROG_MULTI_MAX;
+            }
 
-        int bytesRead = firmwareFile.read((char *)imageBuf, bytesToSend);
-        if (bytesRead == -1 || bytesRead != bytesToSend) {
-            _errorString = tr("Firmware file read failed: %1").arg(firmwareFile.errorString());
-            return false;
-        }
+            Q_ASSERT((bytesToSend % 4) == 0);
 
-        Q_ASSERT(bytesToSend <= 0x8F);
+            int bytesRead = firmwareFile.read((char *)&packet[2], bytesToSend);
+            if (bytesRead == -1 || bytesRead != bytesToSend) {
+                _errorString = tr("Firmware file read failed: %1").arg(firmwareFile.errorString());
+                _discardResponses(inFlight.count());
+                return false;
+            }
 
-        bool failed = true;
-        if (_write(PROTO_PROG_MULTI) &&
-                _write((uint8_t)bytesToSend) &&
-                _write(imageBuf, bytesToSend) &&
-                _write(PROTO_EOC)) {
-            if (_getCommandResponse()) {
-                failed = false;
+            packet[0] = PROTO_PROG_MULTI;
+            packet[1] = (uint8_t)bytesToSend;
+            packet[bytesToSend + 2] = PROTO_EOC;
+            if (!_write(packet, bytesToSend + 3)) {
+                _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesSent, 8, 16, QLatin1Char('0'));
+                _discardResponses(inFlight.count());
+                return false;
             }
+
+            // Calculate the CRC while the chunk is in flight so verify can start as soon as the last one is acknowledged
+            _imageCRC = QGC::crc32(&packet[2], bytesToSend, _imageCRC);
+
+            inFlight.enqueue(bytesSent);
+            bytesSent += bytesToSend;
         }
-        if (failed) {
-            _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesSent, 8, 16, QLatin1Char('0'));
+        _port.flush();
+
+        const uint32_t chunkAddress = inFlight.dequeue();
+        if (!_getCommandResponse()) {
+            _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(chunkAddress, 8, 16, QLatin1Char('0'));
+            _discardResponses(inFlight.count());
             return false;
         }
 
-        bytesSent += bytesToSend;
-
-        // Calculate the CRC now so we can test it after the board is flashed.
-        _imageCRC = QGC::crc32((uint8_t *)imageBuf, bytesToSend, _imageCRC);
-
-        emit updateProgress(bytesSent, imageSize);
+        emit updateProgress(inFlight.isEmpty() ? bytesSent : inFlight.head(), imageSize);
     }
     firmwareFile.close();
 
     // We calculate the CRC using the entire flash size, filling the remainder with 0xFF.
+    static constexpr uint32_t fillSize = 1024;
+    uint8_t fill[fillSize];
+    memset(fill, 0xFF, sizeof(fill));
     while (bytesSent < _boardFlashSize) {
-        const uint8_t fill = 0xFF;
-        _imageCRC = QGC::crc32(&fill, 1, _imageCRC);
-        bytesSent++;
+        const uint32_t fillBytes = qMin(fillSize, _boardFlashSize - bytesSent);
+        _imageCRC = QGC::crc32(fill, fillBytes, _imageCRC);
+        bytesSent += fillBytes;
     }
 
     return true;
@@ -486,6 +524,8 @@ bool Bootloader::_ihxProgram(const FirmwareImage* image)
 bool Bootloader::verify(const FirmwareImage* image)
 {
     bool ret;
+    QElapsedTimer elapsed;
+    elapsed.start();
 
     if (!image->imageIsBinFormat() || _bootloaderVersion <= 2) {
         ret = _verifyBytes(image);
@@ -493,6 +533,10 @@ bool Bootloader::verify(const FirmwareImage* image)
         ret = _verifyCRC();
     }
 
+    if (ret) {
+        _verifyMsecs = elapsed.elapsed();
+    }
+
     reboot();
 
     return ret;
@@ -30,6 +30,16 @@ class Bootloader : public QObject
     bool verify             (const FirmwareImage* image);
     bool reboot             (void);
 
+    /// Number of PROTO_PROG_MULTI chunks sent ahead of their INSYNC/OK response, 1 is stop-and-wait.
+    /// Defaults to _programWindowDefault for PX4 bootloaders and stop-and-wait for SiK radios.
+    void setProgramWindow   (int chunks) { _programWindow = qMax(1, chunks); }
+    int  programWindow      (void) const { return _programWindow; }
+
+    /// Msecs taken by the last erase, program and verify, -1 if not run
+    qint64 eraseMsecs       (void) const { return _eraseMsecs; }
+    qint64 programMsecs     (void) const { return _programMsecs; }
+    qint64 verifyMsecs      (void) const { return _verifyMsecs; }
+
     static const int boardIDSiKRadio1000    = 78;       ///< Original radio based on SI1000 chip
     static const int boardIDSiKRadio1060    = 80;       ///< Newer radio based on SI1060 chip
 
@@ -53,6 +63,7 @@ class Bootloader : public QObject
     bool    _read               (uint8_t* data, qint64 cBytesExpected, int readTimeout = _readTimout);
     bool    _sendCommand        (uint8_t cmd, int responseTimeout = _responseTimeout);
     bool    _getCommandResponse (const int responseTimeout = _responseTimeout);
+    void    _discardResponses   (int count);
     bool    _protoGetDevice     (uint8_t param, uint32_t& value);
     bool    _verifyBytes        (const FirmwareImage* image);
     bool    _binVerifyBytes     (const FirmwareImage* image);
@@ -105,6 +116,10 @@ class Bootloader : public QObject
     uint32_t    _imageCRC           = 0;        ///< CRC for image in currently selected firmware file
     QString     _firmwareFilename;              ///< Currently selected firmware file to flash
     QString     _errorString;                   ///< Last error
+    int         _programWindow      = 1;        ///< PROTO_PROG_MULTI chunks in flight
+    qint64      _eraseMsecs         = -1;
+    qint64      _programMsecs       = -1;
+    qint64      _verifyMsecs        = -1;
 
     static const int _eraseTimeout                      = 20000;    ///< Msecs to wait for response from erase command
     static const int _rebootTimeout                     = 10000;    ///< Msecs to wait for reboot command to cause serial port to disconnect
@@ -113,4 +128,5 @@ class Bootloader : public QObject
     static const int _responseTimeout                   = 2000;     ///< Msecs to wait for command response bytes
     static const int _flashSizeSmall                    = 1032192;  ///< Flash size for boards with silicon error
     static const int _bootloaderVersionV2CorrectFlash   = 5;        ///< Anything below this bootloader version on V2 boards cannot trust flash size
+    static const int _programWindowDefault              = 8;        ///< Chunks in flight, USB CDC flow control holds the host back if the bootloader falls behind
 };
@@ -138,6 +138,7 @@ FirmwareUpgradeController::FirmwareUpgradeController(void)
     connect(_threadController, &PX4FirmwareUpgradeThreadController::status,                 this, &FirmwareUpgradeController::_status);
     connect(_threadController, &PX4FirmwareUpgradeThreadController::eraseStarted,           this, &FirmwareUpgradeController::_eraseStarted);
     connect(_threadController, &PX4FirmwareUpgradeThreadController::eraseComplete,          this, &FirmwareUpgradeController::_eraseComplete);
+    connect(_threadController, &PX4FirmwareUpgradeThreadController::flashTimings,           this, &FirmwareUpgradeController::_flashTimings);
     connect(_threadController, &PX4FirmwareUpgradeThreadController::flashComplete,          this, &FirmwareUpgradeController::_flashComplete);
     connect(_threadController, &PX4FirmwareUpgradeThreadController::updateProgress,         this, &FirmwareUpgradeController::_updateProgress);
     connect(_threadController, &PX4FirmwareUpgradeThreadController::portsAvailable,         this, &FirmwareUpgradeController::_portsAvailable);
@@ -488,6 +489,19 @@ void FirmwareUpgradeController::_flashComplete(void)
     LinkManager::instance()->setConnectionsAllowed();
 }
 
+/// @brief Logs how long each phase of the flash took, programming throughput depends on the bootloader's transport
+void FirmwareUpgradeController::_flashTimings(qint64 eraseMsecs, qint64 programMsecs, qint64 verifyMsecs, int imageSize)
+{
+    const double programKBps = (programMsecs > 0) ? ((imageSize / 1024.0) / (programMsecs / 1000.0)) : 0;
+
+    qCDebug(FirmwareUpgradeControllerLog) << "Flash timings - erase:" << eraseMsecs << "program:" << programMsecs << "verify:" << verifyMsecs << "msecs, image size:" << imageSize;
+    _appendStatusLog(tr("Erase %1 s, program %2 s (%3 KB/s), verify %4 s")
+                     .arg(eraseMsecs / 1000.0, 0, 'f', 1)
+                     .arg(programMsecs / 1000.0, 0, 'f', 1)
+                     .arg(programKBps, 0, 'f', 1)
+                     .arg(verifyMsecs / 1000.0, 0, 'f', 1));
+}
+
 void FirmwareUpgradeController::_error(const QString& errorString)
 {
     delete _image;
@@ -179,6 +179,7 @@ private slots:
     void _status                            (const QString& statusString);
     void _bootloaderSyncFailed              (void);
     void _flashComplete                     (void);
+    void _flashTimings                      (qint64 eraseMsecs, qint64 programMsecs, qint64 verifyMsecs, int imageSize);
     void _updateProgress                    (int curr, int total);
     void _eraseStarted                      (void);
     void _eraseComplete                     (void);
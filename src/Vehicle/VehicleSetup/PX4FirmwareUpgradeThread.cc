@@ -271,6 +271,8 @@ void PX4FirmwareUpgradeThreadWorker::_flash(void)
         }
     }
 
+    emit flashTimings(_bootloader->eraseMsecs(), _bootloader->programMsecs(), _bootloader->verifyMsecs(), static_cast<int>(_controller->image()->imageSize()));
+
     emit status(tr("Rebooting board"));
     _reboot();
 
@@ -327,6 +329,7 @@ PX4FirmwareUpgradeThreadController::PX4FirmwareUpgradeThreadController(QObject*
     connect(_worker, &PX4FirmwareUpgradeThreadWorker::status,               this, &PX4FirmwareUpgradeThreadController::_status);
     connect(_worker, &PX4FirmwareUpgradeThreadWorker::eraseStarted,         this, &PX4FirmwareUpgradeThreadController::_eraseStarted);
     connect(_worker, &PX4FirmwareUpgradeThreadWorker::eraseComplete,        this, &PX4FirmwareUpgradeThreadController::_eraseComplete);
+    connect(_worker, &PX4FirmwareUpgradeThreadWorker::flashTimings,         this, &PX4FirmwareUpgradeThreadController::_flashTimings);
     connect(_worker, &PX4FirmwareUpgradeThreadWorker::flashComplete,        this, &PX4FirmwareUpgradeThreadController::_flashComplete);
     connect(_worker, &PX4FirmwareUpgradeThreadWorker::portsAvailable,       this, &PX4FirmwareUpgradeThreadController::_portsAvailable);
 
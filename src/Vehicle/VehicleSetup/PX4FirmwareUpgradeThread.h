@@ -36,6 +36,7 @@ class PX4FirmwareUpgradeThreadWorker : public QObject
     void status                 (const QString& statusText);
     void eraseStarted           (void);
     void eraseComplete          (void);
+    void flashTimings           (qint64 eraseMsecs, qint64 programMsecs, qint64 verifyMsecs, int imageSize);
     void flashComplete          (void);
     void portsAvailable         (const QVariantList& ports);
 
@@ -104,6 +105,8 @@ class PX4FirmwareUpgradeThreadController : public QObject
     void status         (const QString& status);
     void eraseStarted   (void);
     void eraseComplete  (void);
+    /// Time taken by each phase of a successful flash
+    void flashTimings   (qint64 eraseMsecs, qint64 programMsecs, qint64 verifyMsecs, int imageSize);
     void flashComplete  (void);
     void updateProgress (int curr, int total);
     void portsAvailable (const QVariantList& ports);
@@ -125,6 +128,7 @@ private slots:
     void _status                (const QString& statusText) { emit status(statusText); }
     void _eraseStarted          (void) { emit eraseStarted(); }
     void _eraseComplete         (void) { emit eraseComplete(); }
+    void _flashTimings          (qint64 eraseMsecs, qint64 programMsecs, qint64 verifyMsecs, int imageSize) { emit flashTimings(eraseMsecs, programMsecs, verifyMsecs, imageSize); }
     void _flashComplete         (void) { emit flashComplete(); }
     void _portsAvailable        (const QVariantList& ports) { emit portsAvailable(ports); }
 
@@ -0,0 +1,205 @@
+#include "ExifStreamTaggerTest.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+
+#include "Benchmarking.h"
+#include "ExifParser.h"
+#include "ExifStreamTagger.h"
+#include "ExifUtility.h"
+#include "GeoTagData.h"
+#include "QGCFileHelper.h"
+
+namespace {
+
+QByteArray readAll(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+bool writeAll(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+}
+
+double readLatitude(const QByteArray &buffer)
+{
+    ExifData *data = ExifUtility::loadFromBuffer(buffer);
+    if (!data) {
+        return 0;
+    }
+    ExifEntry *entry = exif_content_get_entry(data->ifd[EXIF_IFD_GPS], static_cast<ExifTag>(EXIF_TAG_GPS_LATITUDE));
+    const double latitude = entry ? ExifUtility::gpsRationalToDecimal(entry, exif_data_get_byte_order(data)) : 0;
+    exif_data_unref(data);
+    return latitude;
+}
+
+GeoTagData makeGeoTag(double latitude)
+{
+    GeoTagData geotag;
+    geotag.coordinate = QGeoCoordinate(latitude, 151.2093, 58.0);
+    return geotag;
+}
+
+} // namespace
+
+void ExifStreamTaggerTest::_readHeaderTest()
+{
+    QFile file(QStringLiteral(":/unittest/DSCN0010.jpg"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    ExifStreamTagger::JpegHeader header;
+    QString errorMessage;
+    QVERIFY(ExifStreamTagger::readHeader(file, header, errorMessage));
+    QVERIFY(header.hasExif());
+    QCOMPARE(header.app1Offset, qint64(2));
+    QCOMPARE(qint64(header.bytes.size()), header.dataOffset);
+    QCOMPARE(header.dataOffset, header.app1Offset + header.app1Size);
+
+    // Only the header was read, not the image data
+    QVERIFY(header.dataOffset < (file.size() / 4));
+    QVERIFY(ExifUtility::hasExifData(header.exifBuffer()));
+}
+
+void ExifStreamTaggerTest::_readTimeTest()
+{
+    QTemporaryDir tempDir;
+    const QString path = tempDir.filePath(QStringLiteral("image.jpg"));
+    QVERIFY(QFile::copy(QStringLiteral(":/unittest/DSCN0010.jpg"), path));
+
+    QString errorMessage;
+    const QDateTime imageTime = ExifStreamTagger::readTime(path, errorMessage);
+    QVERIFY2(imageTime.isValid(), qPrintable(errorMessage));
+    QCOMPARE(imageTime, QDateTime(QDate(2008, 10, 22), QTime(16, 28, 39)));
+    QCOMPARE(imageTime, ExifParser::readTime(readAll(path)));
+}
+
+void ExifStreamTaggerTest::_writeFileMatchesBufferWriteTest()
+{
+    QTemporaryDir tempDir;
+    const QString source = tempDir.filePath(QStringLiteral("source.jpg"));
+    const QString output = tempDir.filePath(QStringLiteral("output.jpg"));
+    QVERIFY(QFile::copy(QStringLiteral(":/unittest/DSCN0010.jpg"), source));
+
+    const GeoTagData geotag = makeGeoTag(-33.8688);
+
+    QString errorMessage;
+    QVERIFY2(ExifStreamTagger::writeFile(source, output, geotag, errorMessage), qPrintable(errorMessage));
+
+    QByteArray expected = readAll(source);
+    QVERIFY(ExifParser::write(expected, geotag));
+    QCOMPARE(readAll(output), expected);
+}
+
+void ExifStreamTaggerTest::_retagInPlaceTest()
+{
+    QTemporaryDir tempDir;
+    const QString source = tempDir.filePath(QStringLiteral("source.jpg"));
+    const QString path = tempDir.filePath(QStringLiteral("tagged.jpg"));
+    QVERIFY(QFile::copy(QStringLiteral(":/unittest/DSCN0010.jpg"), source));
+
+    QString errorMessage;
+    QVERIFY(ExifStreamTagger::writeFile(source, path, makeGeoTag(10.0), errorMessage));
+    const QByteArray before = readAll(path);
+
+    // Source and output are the same file: written to a temporary file and renamed over it
+    QVERIFY2(ExifStreamTagger::writeFile(path, path, makeGeoTag(20.0), errorMessage), qPrintable(errorMessage));
+    QCOMPARE(QDir(tempDir.path()).entryList(QDir::Files).size(), 2);
+
+    const QByteArray after = readAll(path);
+    QVERIFY(qAbs(readLatitude(after) - 20.0) < 0.001);
+
+    // Image data after the segment is untouched
+    ExifStreamTagger::JpegHeader header;
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(ExifStreamTagger::readHeader(file, header, errorMessage));
+    QCOMPARE(after.mid(header.dataOffset), before.mid(header.dataOffset));
+}
+
+void ExifStreamTaggerTest::_insertExifTest()
+{
+    QTemporaryDir tempDir;
+    const QString source = tempDir.filePath(QStringLiteral("noexif.jpg"));
+    const QString output = tempDir.filePath(QStringLiteral("output.jpg"));
+
+    const QByteArray app0("\xFF\xE0\x00\x10JFIF\x00\x01\x01\x00\x00\x01\x00\x01\x00\x00", 18);
+    const QByteArray imageData = QByteArray("\xFF\xDB\x00\x04\x00\x00", 6) + QByteArray(4096, '\x55') + QByteArray("\xFF\xD9", 2);
+    QVERIFY(writeAll(source, QByteArray("\xFF\xD8", 2) + app0 + imageData));
+
+    QString errorMessage;
+    QVERIFY2(ExifStreamTagger::writeFile(source, output, makeGeoTag(45.0), errorMessage), qPrintable(errorMessage));
+
+    const QByteArray tagged = readAll(output);
+    QVERIFY(ExifUtility::hasExifData(tagged));
+    QVERIFY(tagged.endsWith(app0 + imageData));
+    QVERIFY(qAbs(readLatitude(tagged) - 45.0) < 0.001);
+}
+
+void ExifStreamTaggerTest::_notJpegTest()
+{
+    QTemporaryDir tempDir;
+    const QString source = tempDir.filePath(QStringLiteral("text.jpg"));
+    QVERIFY(writeAll(source, QByteArrayLiteral("This is not a JPEG file")));
+
+    QString errorMessage;
+    QVERIFY(!ExifStreamTagger::writeFile(source, tempDir.filePath(QStringLiteral("out.jpg")), makeGeoTag(1.0), errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+
+    errorMessage.clear();
+    QVERIFY(!ExifStreamTagger::readTime(source, errorMessage).isValid());
+    QVERIFY(!errorMessage.isEmpty());
+}
+
+void ExifStreamTaggerTest::_benchmarkTagging()
+{
+    // Synthetic survey: the sample image padded with scan data to a realistic size
+    constexpr int kImageCount = 16;
+    constexpr qsizetype kImageSize = 8 * 1024 * 1024;
+
+    QTemporaryDir tempDir;
+    QByteArray image = readAll(QStringLiteral(":/unittest/DSCN0010.jpg"));
+    QVERIFY(!image.isEmpty());
+    image.append(QByteArray(kImageSize - image.size(), '\x5A'));
+
+    QStringList sources;
+    for (int i = 0; i < kImageCount; ++i) {
+        sources.append(tempDir.filePath(QStringLiteral("image_%1.jpg").arg(i)));
+        QVERIFY(writeAll(sources.last(), image));
+    }
+    const QString outputDir = tempDir.filePath(QStringLiteral("TAGGED"));
+    QVERIFY(QGCFileHelper::ensureDirectoryExists(outputDir));
+
+    const GeoTagData geotag = makeGeoTag(-33.8688);
+    auto bench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    bench.batch(kImageCount).unit("image").relative(true);
+    bench.run("tag: read whole image, rewrite buffer (baseline)", [&] {
+        for (const QString &source : std::as_const(sources)) {
+            QByteArray buffer = readAll(source);
+            (void) ExifParser::write(buffer, geotag);
+            (void) QGCFileHelper::atomicWrite(QGCFileHelper::joinPath(outputDir, QFileInfo(source).fileName()), buffer);
+        }
+    });
+    bench.run("tag: ExifStreamTagger::writeFile", [&] {
+        for (const QString &source : std::as_const(sources)) {
+            QString errorMessage;
+            (void) ExifStreamTagger::writeFile(source, QGCFileHelper::joinPath(outputDir, QFileInfo(source).fileName()), geotag, errorMessage);
+        }
+    });
+    bench.run("scan: read whole image for timestamp (baseline)", [&] {
+        for (const QString &source : std::as_const(sources)) {
+            ankerl::nanobench::doNotOptimizeAway(ExifParser::readTime(readAll(source)));
+        }
+    });
+    bench.run("scan: ExifStreamTagger::readTime", [&] {
+        for (const QString &source : std::as_const(sources)) {
+            QString errorMessage;
+            ankerl::nanobench::doNotOptimizeAway(ExifStreamTagger::readTime(source, errorMessage));
+        }
+    });
+}
+
+UT_REGISTER_TEST(ExifStreamTaggerTest, TestLabel::Integration, TestLabel::AnalyzeView)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ExifStreamTaggerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _readHeaderTest();
+    void _readTimeTest();
+    void _writeFileMatchesBufferWriteTest();
+    void _retagInPlaceTest();
+    void _insertExifTest();
+    void _notJpegTest();
+    void _benchmarkTagging();
+};
@@ -4,6 +4,13 @@
 
 #include "MAVLinkChartController.h"
 #include "MAVLinkInspectorController.h"
+#include "MAVLinkMessageField.h"
+#include "MAVLinkTestHelpers.h"
+#include "QmlObjectListModel.h"
+
+#include <QtGraphs/QLineSeries>
+
+#include <memory>
 
 void MAVLinkChartControllerTest::_constructionTest()
 {
@@ -102,4 +109,42 @@ void MAVLinkChartControllerTest::_setInspectorControllerTest()
     QCOMPARE(chart.inspectorController(), &controller);
 }
 
+void MAVLinkChartControllerTest::_sharedRefreshClockTest()
+{
+    MAVLinkInspectorController controller;
+    auto msg = std::unique_ptr<QGCMAVLinkMessage>(MAVLinkTestHelpers::makeHeartbeatMsg());
+    QGCMAVLinkMessageField *const field1 = qobject_cast<QGCMAVLinkMessageField*>((*msg->fields())[0]);
+    QGCMAVLinkMessageField *const field2 = qobject_cast<QGCMAVLinkMessageField*>((*msg->fields())[1]);
+    QVERIFY(field1 && field2);
+
+    QLineSeries series1;
+    QLineSeries series2;
+    const int baseCount = MAVLinkChartController::refreshClockChartCount();
+    {
+        MAVLinkChartController chart1;
+        MAVLinkChartController chart2;
+        chart1.setInspectorController(&controller);
+        chart2.setInspectorController(&controller);
+        chart1.setPlotPixelWidth(100);
+        chart2.setPlotPixelWidth(100);
+
+        chart1.addSeries(field1, &series1);
+        chart2.addSeries(field2, &series2);
+        QCOMPARE(MAVLinkChartController::refreshClockChartCount(), baseCount + 2);
+        QVERIFY(field1->chartData());
+
+        // Samples reach the series on the shared clock
+        field1->updateValue(QStringLiteral("1"), 1.0);
+        QTRY_VERIFY_WITH_TIMEOUT(series1.count() > 0, 1000);
+
+        chart1.delSeries(field1);
+        QCOMPARE(MAVLinkChartController::refreshClockChartCount(), baseCount + 1);
+        QVERIFY(!field1->chartData());
+        QCOMPARE(series1.count(), 0);
+
+        chart2.delSeries(field2);
+    }
+    QCOMPARE(MAVLinkChartController::refreshClockChartCount(), baseCount);
+}
+
 UT_REGISTER_TEST(MAVLinkChartControllerTest, TestLabel::Unit, TestLabel::AnalyzeView)
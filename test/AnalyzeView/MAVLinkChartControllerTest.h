@@ -15,4 +15,5 @@ private slots:
     void _setRangeYIndexTest();
     void _setRangeYIndexSameValueNoSignalTest();
     void _setInspectorControllerTest();
+    void _sharedRefreshClockTest();
 };
@@ -0,0 +1,190 @@
+#include "MAVLinkChartDataTest.h"
+#include "MAVLinkChartData.h"
+#include "Benchmarking.h"
+
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+
+#include <cmath>
+
+namespace {
+
+/// Feeds a 100Hz sine from @p startMs to @p endMs
+void feedSine(MAVLinkChartData &data, qreal startMs, qreal endMs)
+{
+    for (qreal t = startMs; t < endMs; t += 10.0) {
+        data.append(t, std::sin(t / 250.0));
+    }
+}
+
+} // namespace
+
+void MAVLinkChartDataTest::_decimateToPixelWidthTest()
+{
+    MAVLinkChartData data;
+    data.setWindow(100, 5000.0);    // 50ms columns
+
+    feedSine(data, 0, 20000.0);
+    QCOMPARE(data.sampleCount(), 2000);
+
+    // One chart width of columns, the newest of which is still open
+    QCOMPARE(data.columnCount(), 99);
+
+    const MAVLinkChartData::SeriesUpdate update = data.takeUpdate(20000.0);
+    QVERIFY(update.reset);
+    QVERIFY(update.append.size() <= (data.pixelWidth() * 2));
+    QVERIFY(update.append.size() >= (data.columnCount() * 2));
+
+    // Oldest column must lie within the window
+    QVERIFY(update.append.first().x() >= (20000.0 - 5000.0));
+    QVERIFY(data.rangeMin() >= -1.0);
+    QVERIFY(data.rangeMax() <= 1.0);
+    QVERIFY(data.rangeMax() > data.rangeMin());
+}
+
+void MAVLinkChartDataTest::_tailOnlyUpdateTest()
+{
+    MAVLinkChartData data;
+    data.setWindow(10, 1000.0);     // 100ms columns
+
+    data.append(0, 1.0);
+    data.append(10, 2.0);
+    MAVLinkChartData::SeriesUpdate update = data.takeUpdate(10);
+    QVERIFY(update.reset);
+    QCOMPARE(update.append.size(), 2);  // In-progress min and max
+
+    // Nothing arrived, the in-progress points are simply refreshed
+    update = data.takeUpdate(20);
+    QVERIFY(!update.reset);
+    QCOMPARE(update.removeFront, 0);
+    QCOMPARE(update.removeBack, 2);
+    QCOMPARE(update.append.size(), 2);
+
+    // Crossing into the next column commits one column
+    data.append(100, 3.0);
+    update = data.takeUpdate(100);
+    QCOMPARE(update.removeFront, 0);
+    QCOMPARE(update.removeBack, 2);
+    QCOMPARE(update.append.size(), 3);
+    QCOMPARE(update.append[0], QPointF(50.0, 1.0));
+    QCOMPARE(update.append[1], QPointF(50.0, 2.0));
+    QCOMPARE(update.append[2], QPointF(100.0, 3.0));
+
+    // A full chart width later the first column scrolls out at the front
+    data.append(1000, 4.0);
+    update = data.takeUpdate(1000);
+    QCOMPARE(update.removeFront, 2);
+    QCOMPARE(update.removeBack, 1);
+    QCOMPARE(update.append.size(), 3);
+    QCOMPARE(data.columnCount(), 1);
+}
+
+void MAVLinkChartDataTest::_incrementalMatchesFullRebuildTest()
+{
+    MAVLinkChartData incremental;
+    incremental.setWindow(64, 2000.0);
+
+    QList<QPointF> series;
+    qreal t = 0;
+    for (int refresh = 0; refresh < 200; refresh++) {
+        // Irregular arrival, including gaps longer than the chart width
+        const qreal burst = (refresh % 37 == 0) ? 2500.0 : 66.0;
+        for (const qreal end = t + burst; t < end; t += 7.0) {
+            incremental.append(t, std::fmod(t, 113.0));
+        }
+        incremental.takeUpdate(t).applyTo(series);
+    }
+
+    MAVLinkChartData full;
+    full.setWindow(64, 2000.0);
+    for (qreal s = 0; s < t; s += 7.0) {
+        full.append(s, std::fmod(s, 113.0));
+    }
+    QList<QPointF> rebuilt;
+    full.takeUpdate(t).applyTo(rebuilt);
+
+    QCOMPARE(series, rebuilt);
+    QCOMPARE(incremental.rangeMin(), full.rangeMin());
+    QCOMPARE(incremental.rangeMax(), full.rangeMax());
+}
+
+void MAVLinkChartDataTest::_capacityWrapTest()
+{
+    MAVLinkChartData data(16);
+    QCOMPARE(data.capacity(), 16);
+
+    for (int i = 0; i < 40; i++) {
+        data.append(i * 10.0, i);
+    }
+    QCOMPARE(data.sampleCount(), 16);
+
+    // Re-decimating only sees the retained samples
+    data.setWindow(1000, 100000.0);
+    (void) data.takeUpdate(400);
+    QCOMPARE(data.rangeMin(), 24.0);
+    QCOMPARE(data.rangeMax(), 39.0);
+
+    data.clear();
+    QCOMPARE(data.sampleCount(), 0);
+    QCOMPARE(data.columnCount(), 0);
+    QVERIFY(data.rangeMin() > data.rangeMax());
+}
+
+void MAVLinkChartDataTest::_setWindowKeepsHistoryTest()
+{
+    MAVLinkChartData data;
+    data.setWindow(200, 5000.0);
+    feedSine(data, 0, 30000.0);
+    (void) data.takeUpdate(30000.0);
+
+    // Widening the time scale shows history recorded before the change
+    data.setWindow(200, 30000.0);
+    const MAVLinkChartData::SeriesUpdate update = data.takeUpdate(30000.0);
+    QVERIFY(update.reset);
+    QVERIFY(update.append.first().x() < 1000.0);
+
+    // Shrinking the chart reduces the column count
+    data.setWindow(20, 30000.0);
+    QVERIFY(data.columnCount() < 20);
+    QVERIFY(data.takeUpdate(30000.0).reset);
+}
+
+void MAVLinkChartDataTest::_benchmarkSeriesRefresh()
+{
+    // 100Hz source, 15Hz refresh, 1000 pixel wide chart showing 60 seconds
+    constexpr int kPixelWidth = 1000;
+    constexpr qreal kRangeMs = 60000.0;
+    constexpr qreal kSamplePeriodMs = 10.0;
+    constexpr qreal kRefreshMs = 1000.0 / 15.0;
+
+    MAVLinkChartData data;
+    data.setWindow(kPixelWidth, kRangeMs);
+    feedSine(data, 0, kRangeMs);
+    QList<QPointF> series;
+    data.takeUpdate(kRangeMs).applyTo(series);
+
+    qreal t = kRangeMs;
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true);
+    bench.run("refresh: rebuild full point list (baseline)", [&] {
+        for (const qreal end = t + kRefreshMs; t < end; t += kSamplePeriodMs) {
+            data.append(t, std::sin(t / 250.0));
+        }
+        (void) data.takeUpdate(t);
+        QList<QPointF> rebuilt;
+        rebuilt.reserve(series.size());
+        for (const QPointF &point : std::as_const(series)) {
+            rebuilt.append(point);
+        }
+        ankerl::nanobench::doNotOptimizeAway(rebuilt);
+    });
+    bench.run("refresh: incremental tail update", [&] {
+        for (const qreal end = t + kRefreshMs; t < end; t += kSamplePeriodMs) {
+            data.append(t, std::sin(t / 250.0));
+        }
+        data.takeUpdate(t).applyTo(series);
+        ankerl::nanobench::doNotOptimizeAway(series.size());
+    });
+}
+
+UT_REGISTER_TEST(MAVLinkChartDataTest, TestLabel::Unit, TestLabel::AnalyzeView)
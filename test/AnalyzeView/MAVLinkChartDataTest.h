@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkChartDataTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _decimateToPixelWidthTest();
+    void _tailOnlyUpdateTest();
+    void _incrementalMatchesFullRebuildTest();
+    void _capacityWrapTest();
+    void _setWindowKeepsHistoryTest();
+    void _benchmarkSeriesRefresh();
+};
@@ -1,13 +1,22 @@
 #include "OnboardLogDownloadTest.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
 
 #include "OnboardLogController.h"
+#include "OnboardLogDownloader.h"
 #include "OnboardLogEntry.h"
 #include "MAVLinkProtocol.h"
 #include "MultiSignalSpy.h"
 #include "MultiVehicleManager.h"
 #include "QmlObjectListModel.h"
+#include "Vehicle.h"
+
+namespace {
+
+constexpr uint32_t kLargeLogSize = 32 * 1024;
+
+} // namespace
 
 void OnboardLogDownloadTest::_downloadTest()
 {
@@ -40,4 +49,163 @@ void OnboardLogDownloadTest::_downloadTest()
     (void)QFile::remove(downloadFile);
 }
 
+void OnboardLogDownloadTest::_refreshLogList(OnboardLogController *controller)
+{
+    MultiSignalSpy spy;
+    QVERIFY(spy.init(controller));
+    controller->refresh();
+    QVERIFY(spy.waitForSignal("requestingListChanged", TestTimeout::longMs()));
+    QTRY_VERIFY_WITH_TIMEOUT(!controller->_getRequestingList(), TestTimeout::longMs());
+    QVERIFY(controller->_getModel()->count() > 0);
+}
+
+void OnboardLogDownloadTest::_downloadLossTest()
+{
+    // Every seventh LOG_DATA is lost, the gaps must be requested again until the log is complete
+    _mockLink->setLogDownloadLinkConditions(kLargeLogSize, 7);
+
+    OnboardLogController* const controller = new OnboardLogController(this);
+    _refreshLogList(controller);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    QGCOnboardLogEntry* const entry = controller->_getModel()->value<QGCOnboardLogEntry*>(0);
+    QCOMPARE(entry->size(), kLargeLogSize);
+    entry->setSelected(true);
+
+    const QString downloadTo = QDir::currentPath();
+    const QString downloadFile = QDir(downloadTo).filePath("log_0_UnknownDate.ulg");
+    (void)QFile::remove(downloadFile);
+    (void)QFile::remove(OnboardLogDownloader::partialPath(downloadFile));
+    (void)QFile::remove(OnboardLogDownloader::sidecarPath(downloadFile));
+
+    controller->download(downloadTo);
+    QVERIFY(controller->_getDownloadingLogs());
+    QCOMPARE(controller->activeDownloads(), 1);
+    QTRY_VERIFY_WITH_TIMEOUT(!controller->_getDownloadingLogs(), TestTimeout::longMs());
+    QCOMPARE(controller->activeDownloads(), 0);
+    QCOMPARE(entry->status(), QStringLiteral("Downloaded"));
+
+    QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
+    QVERIFY(!QFile::exists(OnboardLogDownloader::partialPath(downloadFile)));
+    QVERIFY(!QFile::exists(OnboardLogDownloader::sidecarPath(downloadFile)));
+
+    // Only the lost bins are sent again, not whole requests
+    QVERIFY(_mockLink->logDownloadBytesSent() < (2 * kLargeLogSize));
+
+    (void)QFile::remove(downloadFile);
+}
+
+void OnboardLogDownloadTest::_resumeTest()
+{
+    _mockLink->setLogDownloadLinkConditions(kLargeLogSize, 0);
+
+    OnboardLogController* const controller = new OnboardLogController(this);
+    _refreshLogList(controller);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    QGCOnboardLogEntry* const entry = controller->_getModel()->value<QGCOnboardLogEntry*>(0);
+    entry->setSelected(true);
+
+    const QString downloadTo = QDir::currentPath();
+    const QString downloadFile = QDir(downloadTo).filePath("log_0_UnknownDate.ulg");
+    const QString partialFile = OnboardLogDownloader::partialPath(downloadFile);
+    const QString sidecarFile = OnboardLogDownloader::sidecarPath(downloadFile);
+    (void)QFile::remove(downloadFile);
+    (void)QFile::remove(partialFile);
+    (void)QFile::remove(sidecarFile);
+
+    // Cancel part way, the partial log and its sidecar bitmap stay behind and nothing has the final name
+    controller->download(downloadTo);
+    QTRY_VERIFY_WITH_TIMEOUT(_mockLink->logDownloadBytesSent() >= (kLargeLogSize / 4), TestTimeout::longMs());
+    QVERIFY(QFile::exists(partialFile));
+    QVERIFY(!QFile::exists(downloadFile));
+    controller->cancel();
+    QVERIFY(!controller->_getDownloadingLogs());
+    QCOMPARE(entry->status(), QStringLiteral("Canceled"));
+    QVERIFY(!QFile::exists(downloadFile));
+    QVERIFY(QFile::exists(partialFile));
+    QVERIFY(QFile::exists(sidecarFile));
+
+    // Downloading again continues the same file and only fetches what is missing
+    const uint32_t bytesSentBeforeResume = _mockLink->logDownloadBytesSent();
+    entry->setSelected(true);
+    controller->download(downloadTo);
+    QTRY_VERIFY_WITH_TIMEOUT(!controller->_getDownloadingLogs(), TestTimeout::longMs());
+    QCOMPARE(entry->status(), QStringLiteral("Downloaded"));
+
+    QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
+    QVERIFY(!QFile::exists(partialFile));
+    QVERIFY(!QFile::exists(sidecarFile));
+    QVERIFY(!QFile::exists(QDir(downloadTo).filePath("log_0_UnknownDate_1.ulg")));
+    QVERIFY((_mockLink->logDownloadBytesSent() - bytesSentBeforeResume) < kLargeLogSize);
+
+    (void)QFile::remove(downloadFile);
+}
+
+void OnboardLogDownloadTest::_parallelVehiclesTest()
+{
+    // Long enough that the first vehicle is still sending when the second one starts
+    constexpr uint32_t kLogSize = 8 * kLargeLogSize;
+
+    MockLink* const secondLink = MockLink::startPX4MockLink(false /* sendStatusText */, false /* enableCamera */, false /* enableGimbal */);
+    QVERIFY(secondLink);
+    QTRY_VERIFY_WITH_TIMEOUT(MultiVehicleManager::instance()->getVehicleById(secondLink->vehicleId()), TestTimeout::longMs());
+    Vehicle* const secondVehicle = MultiVehicleManager::instance()->getVehicleById(secondLink->vehicleId());
+    QTRY_VERIFY_WITH_TIMEOUT(secondVehicle->isInitialConnectComplete(), TestTimeout::longMs());
+    QCOMPARE(MultiVehicleManager::instance()->activeVehicle(), _vehicle);
+
+    _mockLink->setLogDownloadLinkConditions(kLogSize, 0);
+    secondLink->setLogDownloadLinkConditions(kLogSize, 0);
+
+    // Both vehicles name their log the same, so each gets its own directory
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString firstDownloadTo = dir.filePath(QStringLiteral("first"));
+    const QString secondDownloadTo = dir.filePath(QStringLiteral("second"));
+    QVERIFY(QDir().mkpath(firstDownloadTo));
+    QVERIFY(QDir().mkpath(secondDownloadTo));
+
+    OnboardLogController* const controller = new OnboardLogController(this);
+    _refreshLogList(controller);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+    controller->_getModel()->value<QGCOnboardLogEntry*>(0)->setSelected(true);
+    controller->download(firstDownloadTo);
+    QCOMPARE(controller->activeDownloads(), 1);
+
+    // Switching vehicles keeps the first download running
+    MultiVehicleManager::instance()->setActiveVehicle(secondVehicle);
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->activeVehicle(), secondVehicle, TestTimeout::mediumMs());
+    _refreshLogList(controller);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+    QGCOnboardLogEntry* const secondEntry = controller->_getModel()->value<QGCOnboardLogEntry*>(0);
+    QCOMPARE(secondEntry->size(), kLogSize);
+    secondEntry->setSelected(true);
+    controller->download(secondDownloadTo);
+
+    // Each vehicle streams its own log at the same time
+    QCOMPARE(controller->activeDownloads(), 2);
+    QVERIFY(_mockLink->logDownloadBytesSent() < kLogSize);
+    QTRY_VERIFY_WITH_TIMEOUT(secondLink->logDownloadBytesSent() > 0, TestTimeout::mediumMs());
+    QCOMPARE(controller->activeDownloads(), 2);
+
+    QTRY_COMPARE_WITH_TIMEOUT(controller->activeDownloads(), 0, TestTimeout::longMs());
+    QVERIFY(!controller->_getDownloadingLogs());
+    QCOMPARE(secondEntry->status(), QStringLiteral("Downloaded"));
+    QVERIFY(UnitTest::fileCompare(QDir(firstDownloadTo).filePath("log_0_UnknownDate.ulg"), _mockLink->logDownloadFile()));
+    QVERIFY(UnitTest::fileCompare(QDir(secondDownloadTo).filePath("log_0_UnknownDate.ulg"), secondLink->logDownloadFile()));
+
+    // Leave only the first vehicle for cleanup()
+    secondLink->disconnect();
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->vehicles()->count(), 1, TestTimeout::longMs());
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->activeVehicle(), _vehicle, TestTimeout::mediumMs());
+}
+
 UT_REGISTER_TEST(OnboardLogDownloadTest, TestLabel::Integration, TestLabel::AnalyzeView, TestLabel::Vehicle)
@@ -2,10 +2,18 @@
 
 #include "BaseClasses/VehicleTest.h"
 
+class OnboardLogController;
+
 class OnboardLogDownloadTest : public VehicleTest
 {
     Q_OBJECT
 
 private slots:
     void _downloadTest();
+    void _downloadLossTest();
+    void _resumeTest();
+    void _parallelVehiclesTest();
+
+private:
+    void _refreshLogList(OnboardLogController *controller);
 };
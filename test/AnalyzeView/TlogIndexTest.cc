@@ -0,0 +1,434 @@
+#include "TlogIndexTest.h"
+#include "LogFileParser.h"
+#include "TlogIndex.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimeZone>
+#include <QtCore/QtEndian>
+
+#include <cmath>
+
+#include "Benchmarking.h"
+
+namespace {
+
+constexpr quint64 kStartUsec = 1700000000ULL * 1000 * 1000;
+constexpr uint8_t kVehicleSysId = 1;
+constexpr uint8_t kGcsSysId = 255;
+
+/// Builds a tlog the way MAVLinkProtocol writes one
+class TlogBuilder
+{
+public:
+    void append(quint64 timeUsec, const mavlink_message_t &message)
+    {
+        uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t length = mavlink_msg_to_send_buffer(frame, &message);
+        uchar timestamp[sizeof(quint64)];
+        qToBigEndian(timeUsec, timestamp);
+        bytes.append(reinterpret_cast<const char *>(timestamp), sizeof(timestamp));
+        bytes.append(reinterpret_cast<const char *>(frame), length);
+    }
+
+    bool write(const QString &filePath) const
+    {
+        QFile file(filePath);
+        return file.open(QIODevice::WriteOnly) && (file.write(bytes) == bytes.size());
+    }
+
+    QByteArray bytes;
+};
+
+mavlink_message_t heartbeat(uint8_t sysId, MAV_TYPE type, MAV_AUTOPILOT autopilot)
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_heartbeat_pack_chan(sysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, type, autopilot, 0, 0, MAV_STATE_ACTIVE);
+    return message;
+}
+
+mavlink_message_t attitude(uint8_t sysId, uint32_t timeBootMs, float roll)
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_attitude_pack_chan(sysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, timeBootMs, roll, -roll, 0.25f, 0, 0, 0);
+    return message;
+}
+
+mavlink_message_t globalPosition(uint32_t timeBootMs, int32_t lat, int32_t lon, uint16_t hdg)
+{
+    // vz and hdg are the last fields on the wire, the frame drops their bytes when they are zero
+    mavlink_message_t message;
+    (void) mavlink_msg_global_position_int_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, timeBootMs,
+                                                     lat, lon, 488000, 12500, 100, -100, 0, hdg);
+    return message;
+}
+
+/// A tlog of 100 attitudes at 100 Hz and 50 positions from the vehicle, mixed with ground station heartbeats, a
+/// MAVLink 1 frame, a second system, damaged bytes and a truncated final record
+TlogBuilder sampleTlog()
+{
+    TlogBuilder tlog;
+    tlog.append(kStartUsec, heartbeat(kGcsSysId, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID));
+    tlog.append(kStartUsec, heartbeat(kVehicleSysId, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4));
+
+    for (int i = 0; i < 100; i++) {
+        const quint64 timeUsec = kStartUsec + (static_cast<quint64>(i) * 10000);
+        tlog.append(timeUsec, attitude(kVehicleSysId, i * 10, i * 0.01f));
+        if ((i % 2) == 0) {
+            tlog.append(timeUsec, globalPosition(i * 10, 473977418 + i, 85455939 - i, (i == 50) ? 9000 : 0));
+        }
+        if (i == 40) {
+            tlog.bytes.append("\xFD\x01garbage", 9);
+        }
+        if (i == 60) {
+            tlog.append(timeUsec, attitude(2, 0, 3.0f));
+        }
+    }
+
+    // MAVLink 1 frame
+    mavlink_status_t *const status = mavlink_get_channel_status(MAVLINK_COMM_2);
+    const uint8_t savedFlags = status->flags;
+    status->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    mavlink_message_t v1Message;
+    (void) mavlink_msg_heartbeat_pack_chan(kGcsSysId, MAV_COMP_ID_MISSIONPLANNER, MAVLINK_COMM_2, &v1Message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, 0);
+    status->flags = savedFlags;
+    tlog.append(kStartUsec + 1000000, v1Message);
+
+    mavlink_message_t statusText;
+    (void) mavlink_msg_statustext_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &statusText, MAV_SEVERITY_WARNING, "Low battery", 0, 0);
+    tlog.append(kStartUsec + 500000, statusText);
+
+    mavlink_param_union_t intValue;
+    intValue.param_int32 = 42;
+    mavlink_message_t paramValue;
+    (void) mavlink_msg_param_value_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &paramValue, "SYS_AUTOSTART", intValue.param_float, MAV_PARAM_TYPE_INT32, 2, 0);
+    tlog.append(kStartUsec + 600000, paramValue);
+    (void) mavlink_msg_param_value_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &paramValue, "MPC_XY_VEL_MAX", 12.5f, MAV_PARAM_TYPE_REAL32, 2, 1);
+    tlog.append(kStartUsec + 600000, paramValue);
+
+    // Truncated final record, as left by a crash while logging
+    TlogBuilder truncated;
+    truncated.append(kStartUsec + 2000000, attitude(kVehicleSysId, 2000, 0));
+    tlog.bytes.append(truncated.bytes.left(12));
+    return tlog;
+}
+
+} // namespace
+
+void TlogIndexTest::_testIndex()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("sample.tlog"));
+    QVERIFY(sampleTlog().write(file));
+
+    TlogIndex index;
+    QVERIFY(index.open(file));
+    QVERIFY(index.errorString().isEmpty());
+
+    // 2 + 100 + 50 + 1 heartbeats, attitudes, positions and the other system, then v1, status text and 2 parameters
+    QCOMPARE(index.frameCount(), 157);
+    QCOMPARE(index.skippedBytes(), 9 + 12);
+    QCOMPARE(index.frames(MAVLINK_MSG_ID_ATTITUDE).count(), 101);
+    QCOMPARE(index.frames(MAVLINK_MSG_ID_GLOBAL_POSITION_INT).count(), 50);
+    QCOMPARE(index.frames(MAVLINK_MSG_ID_HEARTBEAT).count(), 3);
+    QVERIFY(index.frames(MAVLINK_MSG_ID_SYS_STATUS).isEmpty());
+    QCOMPARE(index.messageIds().first(), static_cast<uint32_t>(MAVLINK_MSG_ID_HEARTBEAT));
+
+    QCOMPARE(index.firstTimeUsec(), kStartUsec);
+    QCOMPARE(index.lastTimeUsec(), kStartUsec + 1000000);
+
+    // The ground station heartbeat comes first but is not from an autopilot
+    QCOMPARE(index.vehicleSystemId(), kVehicleSysId);
+    QCOMPARE(index.vehicleAutopilot(), MAV_AUTOPILOT_PX4);
+    QCOMPARE(index.vehicleType(), MAV_TYPE_QUADROTOR);
+
+    // The MAVLink 1 heartbeat is the last one
+    mavlink_message_t message;
+    index.message(index.frames(MAVLINK_MSG_ID_HEARTBEAT).last(), message);
+    QCOMPARE(message.magic, static_cast<uint8_t>(MAVLINK_STX_MAVLINK1));
+    QCOMPARE(message.sysid, kGcsSysId);
+    QCOMPARE(mavlink_msg_heartbeat_get_type(&message), static_cast<uint8_t>(MAV_TYPE_GCS));
+
+    index.close();
+    QCOMPARE(index.frameCount(), 0);
+    QVERIFY(index.frames(MAVLINK_MSG_ID_ATTITUDE).isEmpty());
+}
+
+void TlogIndexTest::_testDecode()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("sample.tlog"));
+    TlogBuilder tlog = sampleTlog();
+
+    mavlink_message_t quaternion;
+    const float q[4] = { 1, 0, 0, 0 };
+    const float reprOffset[4] = { 1, 0.5f, 0, 0 };
+    (void) mavlink_msg_attitude_quaternion_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &quaternion, 0, q[0], q[1], q[2], q[3], 0, 0, 0, reprOffset);
+    tlog.bytes.chop(12);
+    tlog.append(kStartUsec, quaternion);
+    QVERIFY(tlog.write(file));
+
+    TlogIndex index;
+    QVERIFY(index.open(file));
+
+    const QStringList fields = {
+        QStringLiteral("ATTITUDE.roll"),
+        QStringLiteral("ATTITUDE.time_boot_ms"),
+        QStringLiteral("GLOBAL_POSITION_INT.lat"),
+        QStringLiteral("GLOBAL_POSITION_INT.hdg"),
+        QStringLiteral("GLOBAL_POSITION_INT.vz"),
+        QStringLiteral("ATTITUDE_QUATERNION.repr_offset_q[1]"),
+        QStringLiteral("ATTITUDE.nosuchfield"),
+        QStringLiteral("ATTITUDE_QUATERNION.repr_offset_q[4]"),
+        QStringLiteral("SYS_STATUS.load"),
+    };
+    const QList<TlogIndex::Column> columns = index.decode(fields, kVehicleSysId);
+    QCOMPARE(columns.count(), fields.count());
+    for (qsizetype i = 0; i < fields.count(); i++) {
+        QCOMPARE(columns[i].name, fields[i]);
+    }
+
+    // Cross-check against the generated decoder, the other system's attitude is filtered out
+    const QVector<QPointF> &roll = columns[0].samples;
+    QCOMPARE(columns[0].type, MAVLINK_TYPE_FLOAT);
+    QCOMPARE(roll.count(), 100);
+    int rollIndex = 0;
+    for (const TlogIndex::Frame &frame : index.frames(MAVLINK_MSG_ID_ATTITUDE)) {
+        mavlink_message_t message;
+        index.message(frame, message);
+        if (message.sysid != kVehicleSysId) {
+            continue;
+        }
+        QCOMPARE(roll[rollIndex].y(), static_cast<double>(mavlink_msg_attitude_get_roll(&message)));
+        QCOMPARE(roll[rollIndex].x(), static_cast<double>(frame.timeUsec - kStartUsec) / 1e6);
+        rollIndex++;
+    }
+    QCOMPARE(columns[1].type, MAVLINK_TYPE_UINT32_T);
+    QCOMPARE(columns[1].samples.last().y(), 990.0);
+
+    QCOMPARE(columns[2].samples.count(), 50);
+    QCOMPARE(columns[2].samples[3].y(), 473977418.0 + 6);
+
+    // Values in bytes dropped from the end of the frame decode as zero
+    QCOMPARE(columns[3].type, MAVLINK_TYPE_UINT16_T);
+    QCOMPARE(columns[3].samples[0].y(), 0.0);
+    QCOMPARE(columns[3].samples[25].y(), 9000.0);
+    QCOMPARE(columns[4].samples[25].y(), 0.0);
+
+    // Array element of an extension field
+    QCOMPARE(columns[5].samples.count(), 1);
+    QCOMPARE(columns[5].samples[0].y(), 0.5);
+
+    // Unknown field, array index out of range and a message which is not in the log
+    QVERIFY(columns[6].samples.isEmpty());
+    QVERIFY(columns[7].samples.isEmpty());
+    QVERIFY(columns[8].samples.isEmpty());
+
+    // Every system
+    QCOMPARE(index.decode({ QStringLiteral("ATTITUDE.roll") }).first().samples.count(), 101);
+
+    const QStringList plottable = index.fieldNames(true);
+    QVERIFY(plottable.contains(QStringLiteral("ATTITUDE_QUATERNION.repr_offset_q[3]")));
+    QVERIFY(!plottable.contains(QStringLiteral("STATUSTEXT.text")));
+    QVERIFY(index.fieldNames(false).contains(QStringLiteral("STATUSTEXT.text")));
+}
+
+void TlogIndexTest::_testChecksum()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("damaged.tlog"));
+
+    TlogBuilder tlog;
+    QList<qsizetype> recordOffsets;
+    for (int i = 0; i < 10; i++) {
+        recordOffsets.append(tlog.bytes.size());
+        tlog.append(kStartUsec + (static_cast<quint64>(i) * 10000), attitude(kVehicleSysId, i * 10, i * 0.01f));
+    }
+    const qsizetype recordLength = recordOffsets[1] - recordOffsets[0];
+
+    // A flipped payload bit keeps the framing intact, only the checksum tells the record apart
+    tlog.bytes[recordOffsets[4] + TlogIndex::kTimestampBytes + MAVLINK_NUM_HEADER_BYTES + 4] ^= 0x01;
+
+    // A frame of a message which is not in the dialect cannot be checked either
+    mavlink_message_t unknown = attitude(kVehicleSysId, 70, 0.07f);
+    unknown.msgid = 0xFFFFFF;
+    const qsizetype unknownOffset = recordOffsets[7];
+    TlogBuilder unknownRecord;
+    unknownRecord.append(kStartUsec + 70000, unknown);
+    tlog.bytes.insert(unknownOffset, unknownRecord.bytes);
+    QVERIFY(tlog.write(file));
+
+    TlogIndex index;
+    QVERIFY(index.open(file));
+    QCOMPARE(index.frameCount(), 9);
+    QCOMPARE(index.skippedBytes(), recordLength + unknownRecord.bytes.size());
+    QCOMPARE(index.messageIds(), QList<uint32_t>{ MAVLINK_MSG_ID_ATTITUDE });
+
+    const QVector<TlogIndex::Frame> &frames = index.frames(MAVLINK_MSG_ID_ATTITUDE);
+    QCOMPARE(frames[3].timeUsec, kStartUsec + 30000);
+    QCOMPARE(frames[4].timeUsec, kStartUsec + 50000);
+}
+
+void TlogIndexTest::_testParseFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("sample.tlog"));
+    QVERIFY(sampleTlog().write(file));
+
+    LogFileParser parser;
+    QVERIFY(parser.parseFile(file));
+    QVERIFY(parser.parseComplete());
+
+    QVERIFY(parser.plottableFields().contains(QStringLiteral("ATTITUDE.roll")));
+    QVERIFY(parser.availableFields().contains(QStringLiteral("STATUSTEXT.text")));
+    QVERIFY(!parser.plottableFields().contains(QStringLiteral("STATUSTEXT.text")));
+    QCOMPARE(parser.fieldSamples(QStringLiteral("ATTITUDE.roll")).count(), 100);
+    QCOMPARE(parser.sampleCount(), 157);
+    QCOMPARE(parser.minTimestamp(), 0.0);
+    QCOMPARE(parser.maxTimestamp(), 1.0);
+    QCOMPARE(parser.startTime(), QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(kStartUsec / 1000), QTimeZone::utc()));
+    QVERIFY(!parser.detectedVehicleType().isEmpty());
+
+    // Positions are scaled to degrees and meters and give the map path
+    QCOMPARE(parser.fieldValueAt(QStringLiteral("GLOBAL_POSITION_INT.alt"), 0), 488.0);
+    const QVariantList path = parser.gpsPath();
+    QCOMPARE(path.count(), 50);
+    QVERIFY(std::fabs(path.first().toMap().value(QStringLiteral("latitude")).toDouble() - 47.3977418) < 1e-9);
+    QCOMPARE(parser.gpsAltitudeFieldName(), QStringLiteral("GLOBAL_POSITION_INT.alt"));
+
+    QCOMPARE(parser.messages().count(), 1);
+    QCOMPARE(parser.messages().first().toMap().value(QStringLiteral("text")).toString(), QStringLiteral("Low battery"));
+    QCOMPARE(parser.events().count(), 1);
+    QCOMPARE(parser.events().first().toMap().value(QStringLiteral("type")).toString(), QStringLiteral("warning"));
+    QCOMPARE(parser.events().first().toMap().value(QStringLiteral("time")).toDouble(), 0.5);
+
+    // PX4 sends integer parameters bytewise
+    QCOMPARE(parser.parameters().count(), 2);
+    const QVariantMap floatParam = parser.parameters()[0].toMap();
+    QCOMPARE(floatParam.value(QStringLiteral("name")).toString(), QStringLiteral("MPC_XY_VEL_MAX"));
+    QCOMPARE(floatParam.value(QStringLiteral("value")).toDouble(), 12.5);
+    QVERIFY(floatParam.value(QStringLiteral("isFloat")).toBool());
+    const QVariantMap intParam = parser.parameters()[1].toMap();
+    QCOMPARE(intParam.value(QStringLiteral("name")).toString(), QStringLiteral("SYS_AUTOSTART"));
+    QCOMPARE(intParam.value(QStringLiteral("value")).toInt(), 42);
+    QVERIFY(!intParam.value(QStringLiteral("isFloat")).toBool());
+}
+
+void TlogIndexTest::_testNotTlog()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString textFile = dir.filePath(QStringLiteral("text.tlog"));
+    {
+        QFile file(textFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QVERIFY(file.write(QByteArray("This is not a telemetry log\n").repeated(100)) > 0);
+    }
+    TlogIndex index;
+    QVERIFY(!index.open(textFile));
+    QVERIFY(!index.errorString().isEmpty());
+
+    LogFileParser parser;
+    QVERIFY(!parser.parseFile(textFile));
+    QVERIFY(!parser.parseError().isEmpty());
+
+    const QString emptyFile = dir.filePath(QStringLiteral("empty.tlog"));
+    {
+        QFile file(emptyFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QVERIFY(!index.open(emptyFile));
+    QVERIFY(!parser.parseFile(emptyFile));
+}
+
+void TlogIndexTest::_benchmarkLargeTlog()
+{
+    // An hour long flight at the usual stream rates: 50 Hz attitude, 10 Hz position, 2 Hz system status, 1 Hz
+    // heartbeats from both ends
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("large.tlog"));
+    TlogBuilder tlog;
+    constexpr int kSeconds = 3600;
+    for (int tick = 0; tick < (kSeconds * 50); tick++) {
+        const quint64 timeUsec = kStartUsec + (static_cast<quint64>(tick) * 20000);
+        const uint32_t timeBootMs = static_cast<uint32_t>(tick * 20);
+        tlog.append(timeUsec, attitude(kVehicleSysId, timeBootMs, std::sin(tick * 0.01f)));
+        if ((tick % 5) == 0) {
+            tlog.append(timeUsec, globalPosition(timeBootMs, 473977418 + tick, 85455939, static_cast<uint16_t>(tick % 36000)));
+        }
+        if ((tick % 25) == 0) {
+            mavlink_message_t sysStatus;
+            (void) mavlink_msg_sys_status_pack_chan(kVehicleSysId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &sysStatus, 0, 0, 0, 500, 12000, 1500, 80,
+                                                    0, 0, 0, 0, 0, 0, 0, 0, 0);
+            tlog.append(timeUsec, sysStatus);
+        }
+        if ((tick % 50) == 0) {
+            tlog.append(timeUsec, heartbeat(kVehicleSysId, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4));
+            tlog.append(timeUsec, heartbeat(kGcsSysId, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID));
+        }
+    }
+    QVERIFY(tlog.write(file));
+    const qsizetype fileBytes = tlog.bytes.size();
+    tlog.bytes.clear();
+
+    // Replay and the MAVLink inspector see a tlog through the byte-wise parser
+    QFile tlogFile(file);
+    QVERIFY(tlogFile.open(QIODevice::ReadOnly));
+    const QByteArray bytes = tlogFile.readAll();
+    tlogFile.close();
+
+    auto scanBench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    scanBench.batch(fileBytes).unit("byte").relative(true);
+    scanBench.run("mavlink_parse_char over the file (previous behavior)", [&] {
+        mavlink_message_t rxMessage;
+        mavlink_status_t rxStatus{};
+        mavlink_message_t message;
+        mavlink_status_t status;
+        int messages = 0;
+        for (const char byte : bytes) {
+            if (mavlink_frame_char_buffer(&rxMessage, &rxStatus, static_cast<uint8_t>(byte), &message, &status) == MAVLINK_FRAMING_OK) {
+                messages++;
+            }
+        }
+        ankerl::nanobench::doNotOptimizeAway(messages);
+    });
+    scanBench.run("map and index", [&] {
+        TlogIndex index;
+        (void) index.open(file);
+        ankerl::nanobench::doNotOptimizeAway(index.frameCount());
+    });
+
+    TlogIndex index;
+    QVERIFY(index.open(file));
+    const QStringList plottable = index.fieldNames(true);
+    auto decodeBench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    decodeBench.batch(fileBytes).unit("byte");
+    decodeBench.run("decode every plottable field", [&] {
+        ankerl::nanobench::doNotOptimizeAway(index.decode(plottable, kVehicleSysId).count());
+    });
+
+    // The first plot needs the index and one column
+    auto plotBench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    plotBench.relative(true);
+    plotBench.run("time to first plot: LogFileParser::parseFile", [&] {
+        LogFileParser parser;
+        (void) parser.parseFile(file);
+        ankerl::nanobench::doNotOptimizeAway(parser.fieldSamples(QStringLiteral("ATTITUDE.roll")).count());
+    });
+    plotBench.run("time to first plot: index and decode one field", [&] {
+        TlogIndex firstPlotIndex;
+        (void) firstPlotIndex.open(file);
+        ankerl::nanobench::doNotOptimizeAway(firstPlotIndex.decode({ QStringLiteral("ATTITUDE.roll") }, firstPlotIndex.vehicleSystemId()).count());
+    });
+
+    QCOMPARE(index.decode({ QStringLiteral("ATTITUDE.roll") }, kVehicleSysId).first().samples.count(), kSeconds * 50);
+}
+
+UT_REGISTER_TEST(TlogIndexTest, TestLabel::Unit, TestLabel::AnalyzeView)
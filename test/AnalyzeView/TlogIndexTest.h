@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for TlogIndex and the .tlog support of LogFileParser
+class TlogIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testIndex();
+    void _testDecode();
+    void _testChecksum();
+    void _testParseFile();
+    void _testNotTlog();
+    void _benchmarkLargeTlog();
+};
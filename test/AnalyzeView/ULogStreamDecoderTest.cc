@@ -0,0 +1,209 @@
+#include "ULogStreamDecoderTest.h"
+
+#include "LogFileParser.h"
+#include "LogViewerULogParser.h"
+#include "ULogStreamDecoder.h"
+
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QPointF>
+#include <QtCore/QTemporaryFile>
+#include <QtTest/QSignalSpy>
+
+#include <ulog_cpp/messages.hpp>
+#include <ulog_cpp/writer.hpp>
+
+namespace {
+
+std::vector<uint8_t> makePayload64Float(uint64_t ts, float value)
+{
+    std::vector<uint8_t> buf(12);
+    memcpy(buf.data(),     &ts,    8);
+    memcpy(buf.data() + 8, &value, 4);
+    return buf;
+}
+
+std::vector<uint8_t> makePayload64Uint8(uint64_t ts, uint8_t value)
+{
+    std::vector<uint8_t> buf(9);
+    memcpy(buf.data(), &ts, 8);
+    buf[8] = value;
+    return buf;
+}
+
+// sensor_combined.gyro_rad_x at 100Hz for `samples` samples, vehicle_status.nav_state
+// switching from Manual to Position halfway through
+QByteArray buildFlightULog(int samples)
+{
+    std::vector<uint8_t> buffer;
+    ulog_cpp::Writer writer([&](const uint8_t *data, int length) {
+        buffer.insert(buffer.end(), data, data + length);
+    });
+
+    writer.fileHeader(ulog_cpp::FileHeader{});
+    writer.messageFormat(ulog_cpp::MessageFormat{
+        "sensor_combined",
+        {ulog_cpp::Field{"uint64_t", "timestamp"},
+         ulog_cpp::Field{"float", "gyro_rad_x"}}
+    });
+    writer.messageFormat(ulog_cpp::MessageFormat{
+        "vehicle_status",
+        {ulog_cpp::Field{"uint64_t", "timestamp"},
+         ulog_cpp::Field{"uint8_t", "nav_state"}}
+    });
+    writer.headerComplete();
+
+    writer.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "sensor_combined"});
+    writer.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 2, "vehicle_status"});
+    for (int i = 0; i < samples; i++) {
+        const uint64_t ts = 1000000ULL + (static_cast<uint64_t>(i) * 10000ULL);
+        writer.data(ulog_cpp::Data{1, makePayload64Float(ts, static_cast<float>(i))});
+        if ((i % 50) == 0) {
+            writer.data(ulog_cpp::Data{2, makePayload64Uint8(ts, (i < (samples / 2)) ? 0 : 2)});
+        }
+    }
+
+    return QByteArray(reinterpret_cast<const char *>(buffer.data()), static_cast<int>(buffer.size()));
+}
+
+// Feeds bytes[from, to) in uneven chunks so messages straddle the calls
+void feedChunked(ULogStreamDecoder &decoder, const QByteArray &bytes, qsizetype from, qsizetype to)
+{
+    static constexpr qsizetype chunkSizes[] = { 1, 7, 249, 3, 64, 1000 };
+    qsizetype chunk = 0;
+    while (from < to) {
+        const qsizetype size = qMin(chunkSizes[chunk++ % std::size(chunkSizes)], to - from);
+        decoder.feed(bytes.constData() + from, size);
+        from += size;
+    }
+}
+
+} // namespace
+
+void ULogStreamDecoderTest::_chunkedFeedMatchesFileParseTest()
+{
+    const QByteArray bytes = buildFlightULog(1000);
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/streamtest_XXXXXX.ulg"));
+    QVERIFY(tmp.open());
+    QCOMPARE(tmp.write(bytes), bytes.size());
+    tmp.close();
+
+    const LogParseResult expected = ULogParser::parseFile(tmp.fileName());
+    QVERIFY(expected.ok);
+
+    ULogStreamDecoder decoder;
+    decoder.setMaxSamplesPerField(0);
+    feedChunked(decoder, bytes, 0, bytes.size());
+    decoder.finish();
+
+    QVERIFY(decoder.finished());
+    QVERIFY(!decoder.hadFatalError());
+    QCOMPARE(decoder.bytesDecoded(), static_cast<qint64>(bytes.size()));
+
+    const LogParseResult &result = decoder.result();
+    QCOMPARE(result.availableFields, expected.availableFields);
+    QCOMPARE(result.plottableFields, expected.plottableFields);
+    QCOMPARE(result.fieldSamples, expected.fieldSamples);
+    QCOMPARE(result.modeSegments, expected.modeSegments);
+    QCOMPARE(result.minTimestamp, expected.minTimestamp);
+    QCOMPARE(result.maxTimestamp, expected.maxTimestamp);
+    QCOMPARE(result.sampleCount, expected.sampleCount);
+}
+
+void ULogStreamDecoderTest::_liveUpdatesTest()
+{
+    const QByteArray bytes = buildFlightULog(1000);
+    const QString field = QStringLiteral("sensor_combined.gyro_rad_x");
+
+    ULogStreamDecoder decoder;
+    QSignalSpy updatedSpy(&decoder, &ULogStreamDecoder::updated);
+
+    // First half of the log, as if the vehicle were still flying
+    feedChunked(decoder, bytes, 0, bytes.size() / 2);
+    QVERIFY(updatedSpy.wait(ULogStreamDecoder::kUpdateIntervalMs * 4));
+    QVERIFY(!decoder.finished());
+
+    const qsizetype partialCount = decoder.result().fieldSamples.value(field).size();
+    QVERIFY(partialCount > 0);
+    QVERIFY(partialCount < 1000);
+    QVERIFY(decoder.result().plottableFields.contains(field));
+    QVERIFY(!decoder.result().modeSegments.isEmpty());
+
+    // Rest of the log lands on the same columns
+    const QPointF firstSample = decoder.result().fieldSamples.value(field).constFirst();
+    feedChunked(decoder, bytes, bytes.size() / 2, bytes.size());
+    decoder.finish();
+
+    const QVector<QPointF> samples = decoder.result().fieldSamples.value(field);
+    QCOMPARE(samples.size(), 1000);
+    QCOMPARE(samples.constFirst(), firstSample);
+    QCOMPARE(decoder.result().modeSegments.size(), 2);
+}
+
+void ULogStreamDecoderTest::_maxSamplesPerFieldTest()
+{
+    const QByteArray bytes = buildFlightULog(5000);
+    const QString field = QStringLiteral("sensor_combined.gyro_rad_x");
+
+    ULogStreamDecoder decoder;
+    decoder.setMaxSamplesPerField(256);
+    feedChunked(decoder, bytes, 0, bytes.size());
+    decoder.finish();
+
+    const QVector<QPointF> samples = decoder.result().fieldSamples.value(field);
+    QVERIFY(samples.size() <= 256);
+    QVERIFY(samples.size() >= 128);
+
+    // Thinned evenly over the whole flight, in order
+    QCOMPARE(samples.constFirst().y(), 0.0);
+    QVERIFY(samples.constLast().y() >= (5000 - 64));
+    for (qsizetype i = 1; i < samples.size(); i++) {
+        QVERIFY(samples[i].x() > samples[i - 1].x());
+    }
+
+    // The time range is tracked independently of the thinning
+    QVERIFY(qAbs(decoder.result().maxTimestamp - (1.0 + (4999 * 0.01))) < 1e-6);
+}
+
+void ULogStreamDecoderTest::_attachToLogFileParserTest()
+{
+    const QByteArray bytes = buildFlightULog(1000);
+    const QString field = QStringLiteral("sensor_combined.gyro_rad_x");
+
+    ULogStreamDecoder *const decoder = new ULogStreamDecoder(this);
+    LogFileParser parser;
+    QSignalSpy liveSpy(&parser, &LogFileParser::liveChanged);
+    QSignalSpy dataSpy(&parser, &LogFileParser::liveDataUpdated);
+
+    parser.attachLiveLog(decoder);
+    QVERIFY(parser.live());
+    QCOMPARE(liveSpy.count(), 1);
+
+    feedChunked(*decoder, bytes, 0, bytes.size() / 2);
+    QVERIFY(dataSpy.wait(ULogStreamDecoder::kUpdateIntervalMs * 4));
+    QVERIFY(parser.parseComplete());
+    QVERIFY(parser.plottableFields().contains(field));
+    const qsizetype partialCount = parser.fieldSamples(field).size();
+    QVERIFY(partialCount > 0);
+    QVERIFY(partialCount < 1000);
+
+    // Samples are read in place, no re-parse needed for the parser to see new data
+    feedChunked(*decoder, bytes, bytes.size() / 2, bytes.size());
+    QCOMPARE(parser.fieldSamples(field).size(), 1000);
+
+    // Finishing detaches and keeps the log viewable after the decoder is gone
+    decoder->finish();
+    QVERIFY(!parser.live());
+    QCOMPARE(liveSpy.count(), 2);
+    delete decoder;
+    QCOMPARE(parser.fieldSamples(field).size(), 1000);
+    QCOMPARE(parser.modeNames().size(), 2);
+}
+
+UT_REGISTER_TEST(ULogStreamDecoderTest, TestLabel::Unit, TestLabel::AnalyzeView)
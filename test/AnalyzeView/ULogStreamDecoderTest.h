@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ULogStreamDecoderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _chunkedFeedMatchesFileParseTest();
+    void _liveUpdatesTest();
+    void _maxSamplesPerFieldTest();
+    void _attachToLogFileParserTest();
+};
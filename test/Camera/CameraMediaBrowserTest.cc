@@ -0,0 +1,346 @@
+#include "CameraMediaBrowserTest.h"
+#include "CameraMediaBrowser.h"
+#include "ExifUtility.h"
+#include "LinkManager.h"
+#include "LocalHttpTestServer.h"
+#include "MavlinkCameraControlInterface.h"
+#include "MockConfiguration.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "QGCCameraManager.h"
+#include "Vehicle.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+#include <QtTest/QSignalSpy>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+mavlink_camera_image_captured_t capturedImage(const QString &fileUrl, int imageIndex)
+{
+    mavlink_camera_image_captured_t imageCaptured{};
+    imageCaptured.image_index = imageIndex;
+    imageCaptured.capture_result = 1;
+    (void) qstrncpy(imageCaptured.file_url, fileUrl.toLatin1().constData(), sizeof(imageCaptured.file_url));
+    return imageCaptured;
+}
+
+int readyCount(const CameraMediaBrowser &browser)
+{
+    int ready = 0;
+    for (int row = 0; row < browser.count(); row++) {
+        if (browser.data(browser.index(row), CameraMediaBrowser::StateRole).toInt() == CameraMediaBrowser::Ready) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+CameraMediaBrowser::MediaState mediaState(const CameraMediaBrowser &browser, int row)
+{
+    return static_cast<CameraMediaBrowser::MediaState>(browser.data(browser.index(row), CameraMediaBrowser::StateRole).toInt());
+}
+
+QByteArray jpegImage(const QSize &size, Qt::GlobalColor color)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    QByteArray jpeg;
+    QBuffer buffer(&jpeg);
+    if (!buffer.open(QIODevice::WriteOnly) || !image.save(&buffer, "JPG")) {
+        return QByteArray();
+    }
+    return jpeg;
+}
+
+QImage thumbnail(const CameraMediaBrowser &browser, int row)
+{
+    return QImage(browser.data(browser.index(row), CameraMediaBrowser::ThumbnailUrlRole).toUrl().toLocalFile());
+}
+
+} // namespace
+
+void CameraMediaBrowserTest::init()
+{
+    UnitTest::init();
+    _mockLink = nullptr;
+    _vehicle = nullptr;
+    _tempDir = new QTemporaryDir();
+}
+
+void CameraMediaBrowserTest::cleanup()
+{
+    if (_mockLink) {
+        QSignalSpy spyDisconnect(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged);
+        _mockLink->disconnect();
+        _mockLink = nullptr;
+
+        if (_vehicle) {
+            UnitTest::waitForSignal(spyDisconnect, TestTimeout::longMs(), QStringLiteral("activeVehicleChanged"));
+        }
+        _vehicle = nullptr;
+
+        UnitTest::settleEventLoopForCleanup();
+    }
+
+    delete _tempDir;
+    _tempDir = nullptr;
+
+    dumpFailureContextIfTestFailed(QStringLiteral("cleanup"));
+    UnitTest::cleanup();
+}
+
+void CameraMediaBrowserTest::_connectCameraVehicle()
+{
+    auto *mockConfig = new MockConfiguration(QStringLiteral("CameraMediaBrowserTest"));
+    mockConfig->setFirmwareType(MAV_AUTOPILOT_PX4);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setDynamic(true);
+    mockConfig->setEnableCamera(true);
+
+    QSignalSpy spyVehicle(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged);
+    QVERIFY(spyVehicle.isValid());
+
+    SharedLinkConfigurationPtr linkConfig = LinkManager::instance()->addConfiguration(mockConfig);
+    QVERIFY(LinkManager::instance()->createConnectedLink(linkConfig));
+    QVERIFY2(UnitTest::waitForSignal(spyVehicle, TestTimeout::longMs(), QStringLiteral("activeVehicleChanged")),
+             "Timeout waiting for vehicle connection");
+
+    _vehicle = MultiVehicleManager::instance()->activeVehicle();
+    QVERIFY(_vehicle);
+    _mockLink = qobject_cast<MockLink*>(linkConfig->link());
+    QVERIFY(_mockLink);
+
+    if (!_vehicle->isInitialConnectComplete()) {
+        QSignalSpy spyConnect(_vehicle, &Vehicle::initialConnectComplete);
+        QVERIFY(spyConnect.isValid());
+        QVERIFY2(UnitTest::waitForSignal(spyConnect, TestTimeout::longMs(), QStringLiteral("initialConnectComplete")),
+                 "Timeout waiting for initial connect");
+    }
+}
+
+void CameraMediaBrowserTest::_useTemporaryDirectories(CameraMediaBrowser *browser)
+{
+    QVERIFY(_tempDir->isValid());
+    browser->setThumbnailCache(_tempDir->filePath(QStringLiteral("Thumbnails")), CameraMediaBrowser::kDefaultThumbnailCacheBytes);
+    browser->setDownloadDirectory(_tempDir->filePath(QStringLiteral("Photos")));
+}
+
+void CameraMediaBrowserTest::_testCapturedImagesEndToEnd()
+{
+    _connectCameraVehicle();
+    QGCCameraManager *const cameraManager = _vehicle->cameraManager();
+    QVERIFY(cameraManager);
+    CameraMediaBrowser *const browser = cameraManager->mediaBrowser();
+    QVERIFY(browser);
+    _useTemporaryDirectories(browser);
+
+    QVERIFY_TRUE_WAIT(cameraManager->cameras()->count() >= 2, TestTimeout::longMs());
+    MavlinkCameraControlInterface *camera1 = nullptr;
+    MavlinkCameraControlInterface *camera2 = nullptr;
+    for (int i = 0; i < cameraManager->cameras()->count(); i++) {
+        auto *const camera = qobject_cast<MavlinkCameraControlInterface*>(cameraManager->cameras()->get(i));
+        if (camera && (camera->compID() == MAV_COMP_ID_CAMERA)) {
+            camera1 = camera;
+        } else if (camera && (camera->compID() == MAV_COMP_ID_CAMERA2)) {
+            camera2 = camera;
+        }
+    }
+    QVERIFY(camera1);
+    QVERIFY(camera2);
+
+    browser->setActive(true);
+    browser->setVisibleRange(0, 9);
+
+    // MockLinkCamera reports the photos with mftp urls which MockLinkFTP serves as generated JPEGs
+    QSignalSpy thumbnailSpy(browser, &CameraMediaBrowser::thumbnailReady);
+    QVERIFY(camera1->takePhoto());
+    QVERIFY(camera2->takePhoto());
+    QCOMPARE_TRUE_WAIT(thumbnailSpy.count(), 2, TestTimeout::longMs());
+    QCOMPARE(browser->count(), 2);
+    QCOMPARE(readyCount(*browser), 2);
+    QCOMPARE(browser->thumbnailCache()->count(), 2);
+
+    int camera1Row = -1;
+    for (int row = 0; row < browser->count(); row++) {
+        const QImage image = thumbnail(*browser, row);
+        QCOMPARE(image.size(), QSize(CameraMediaBrowser::kThumbnailMaxEdge, CameraMediaBrowser::kThumbnailMaxEdge * 3 / 4));
+        if (browser->data(browser->index(row), CameraMediaBrowser::CompIdRole).toInt() == MAV_COMP_ID_CAMERA) {
+            camera1Row = row;
+        }
+    }
+    QVERIFY(camera1Row >= 0);
+
+    // The thumbnail transfer was not kept, the full resolution copy is transferred again
+    QSignalSpy fullResolutionSpy(browser, &CameraMediaBrowser::fullResolutionReady);
+    browser->downloadFullResolution(camera1Row);
+    QVERIFY(UnitTest::waitForSignal(fullResolutionSpy, TestTimeout::longMs(), QStringLiteral("fullResolutionReady")));
+    const QString localFile = browser->data(browser->index(camera1Row), CameraMediaBrowser::LocalFileRole).toString();
+    QVERIFY(localFile.endsWith(QStringLiteral("Photos/Camera1/IMG_0001.JPG")));
+    QCOMPARE(QImage(localFile).size(), QSize(1280, 960));
+}
+
+void CameraMediaBrowserTest::_testTransferOrderFollowsScreen()
+{
+    _connectCameraVehicle();
+    CameraMediaBrowser *const browser = _vehicle->cameraManager()->mediaBrowser();
+    QVERIFY(browser);
+    _useTemporaryDirectories(browser);
+
+    // Which rows start transferring, in order
+    QList<int> started;
+    (void) connect(browser, &CameraMediaBrowser::dataChanged, browser, [browser, &started](const QModelIndex &topLeft) {
+        if ((browser->data(topLeft, CameraMediaBrowser::StateRole).toInt() == CameraMediaBrowser::Transferring) && !started.contains(topLeft.row())) {
+            started.append(topLeft.row());
+        }
+    });
+
+    constexpr int kImages = 8;
+    for (int i = 0; i < kImages; i++) {
+        const QString url = QStringLiteral("mftp://[;comp=%1]DCIM/9/ORDER_%2.JPG").arg(MAV_COMP_ID_AUTOPILOT1).arg(i);
+        browser->addCapturedImage(MAV_COMP_ID_CAMERA, capturedImage(url, i));
+    }
+    QCOMPARE(browser->count(), kImages);
+
+    // Neither capturing nor opening the browser with nothing on screen transfers anything
+    browser->setActive(true);
+    QCOMPARE(browser->transfersInFlight(), 0);
+    QCOMPARE(browser->pendingTransfers(), kImages);
+    QVERIFY(browser->transferOrder().isEmpty());
+
+    // The full resolution copy of an off screen row is wanted, then rows 5 and 6 are shown
+    browser->downloadFullResolution(2);
+    browser->setVisibleRange(5, 6);
+
+    QCOMPARE_TRUE_WAIT(readyCount(*browser), 3, TestTimeout::longMs());
+    QCOMPARE(started, QList<int>({ 2, 5, 6 }));
+    QVERIFY(!browser->data(browser->index(2), CameraMediaBrowser::LocalFileRole).toString().isEmpty());
+    QVERIFY(browser->data(browser->index(5), CameraMediaBrowser::LocalFileRole).toString().isEmpty());
+    for (const int row : { 0, 1, 3, 4, 7 }) {
+        QCOMPARE(mediaState(*browser, row), CameraMediaBrowser::Queued);
+    }
+    QCOMPARE(browser->pendingTransfers(), kImages - 3);
+
+    // A closed browser fetches nothing
+    browser->setActive(false);
+    browser->setVisibleRange(0, 1);
+    QVERIFY(browser->transferOrder().isEmpty());
+    QCOMPARE(browser->transfersInFlight(), 0);
+}
+
+void CameraMediaBrowserTest::_testNoFtpThumbnailsWhileArmed()
+{
+    _connectCameraVehicle();
+    CameraMediaBrowser *const browser = _vehicle->cameraManager()->mediaBrowser();
+    QVERIFY(browser);
+    _useTemporaryDirectories(browser);
+    browser->setActive(true);
+    browser->setVisibleRange(0, 1);
+
+    _vehicle->setArmed(true, false /* showError */);
+    QVERIFY_TRUE_WAIT(_vehicle->armed(), TestTimeout::mediumMs());
+
+    for (int i = 0; i < 2; i++) {
+        const QString url = QStringLiteral("mftp://[;comp=%1]DCIM/9/ARMED_%2.JPG").arg(MAV_COMP_ID_AUTOPILOT1).arg(i);
+        browser->addCapturedImage(MAV_COMP_ID_CAMERA, capturedImage(url, i));
+    }
+    QVERIFY(browser->transferOrder().isEmpty());
+    QCOMPARE(browser->transfersInFlight(), 0);
+
+    // Asked for by the user, so it is transferred anyway
+    QSignalSpy fullResolutionSpy(browser, &CameraMediaBrowser::fullResolutionReady);
+    browser->downloadFullResolution(1);
+    QVERIFY(UnitTest::waitForSignal(fullResolutionSpy, TestTimeout::longMs(), QStringLiteral("fullResolutionReady")));
+    QCOMPARE(mediaState(*browser, 0), CameraMediaBrowser::Queued);
+
+    _vehicle->setArmed(false, false /* showError */);
+    QCOMPARE_TRUE_WAIT(readyCount(*browser), 2, TestTimeout::longMs());
+}
+
+void CameraMediaBrowserTest::_testHttpTransfersInFlight()
+{
+    const QByteArray jpeg = jpegImage(QSize(800, 600), Qt::darkCyan);
+    QVERIFY(!jpeg.isEmpty());
+
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(jpeg, 200, "image/jpeg");
+
+    CameraMediaBrowser browser(nullptr);
+    _useTemporaryDirectories(&browser);
+    browser.setMaxHttpTransfers(3);
+    browser.setActive(true);
+
+    constexpr int kImages = 6;
+    QSignalSpy thumbnailSpy(&browser, &CameraMediaBrowser::thumbnailReady);
+    for (int i = 0; i < kImages; i++) {
+        browser.addCapturedImage(MAV_COMP_ID_CAMERA, capturedImage(server.url(QStringLiteral("/IMG_%1.JPG").arg(i)), i));
+    }
+    QCOMPARE(browser.transfersInFlight(), 0);
+
+    // The server ignores the range request for the embedded thumbnail and sends the whole file
+    browser.setVisibleRange(0, kImages - 1);
+    QCOMPARE(browser.transfersInFlight(), 3);
+    QCOMPARE(browser.pendingTransfers(), kImages - 3);
+
+    QCOMPARE_TRUE_WAIT(thumbnailSpy.count(), kImages, TestTimeout::longMs());
+    QCOMPARE(readyCount(browser), kImages);
+    for (int row = 0; row < kImages; row++) {
+        QCOMPARE(thumbnail(browser, row).size(), QSize(CameraMediaBrowser::kThumbnailMaxEdge, CameraMediaBrowser::kThumbnailMaxEdge * 3 / 4));
+    }
+
+    // Known media comes straight from the thumbnail cache
+    browser.clear();
+    QCOMPARE(browser.count(), 0);
+    thumbnailSpy.clear();
+    for (int i = 0; i < kImages; i++) {
+        browser.addCapturedImage(MAV_COMP_ID_CAMERA, capturedImage(server.url(QStringLiteral("/IMG_%1.JPG").arg(i)), i));
+    }
+    QCOMPARE(thumbnailSpy.count(), kImages);
+    QCOMPARE(readyCount(browser), kImages);
+    QCOMPARE(browser.transfersInFlight(), 0);
+    QCOMPARE(browser.pendingTransfers(), 0);
+}
+
+void CameraMediaBrowserTest::_testEmbeddedThumbnail()
+{
+    // Photo carrying a smaller preview in its EXIF segment, as cameras write them
+    QByteArray jpeg = jpegImage(QSize(1600, 1200), Qt::darkCyan);
+    const QByteArray preview = jpegImage(QSize(160, 120), Qt::darkRed);
+    QVERIFY(!jpeg.isEmpty());
+    QVERIFY(!preview.isEmpty());
+    ExifData *const exifData = ExifUtility::createNew();
+    QVERIFY(exifData);
+    (void) ExifUtility::initTag(exifData, EXIF_IFD_1, EXIF_TAG_X_RESOLUTION);
+    exifData->data = static_cast<unsigned char*>(std::malloc(preview.size()));
+    std::memcpy(exifData->data, preview.constData(), preview.size());
+    exifData->size = static_cast<unsigned int>(preview.size());
+    const bool saved = ExifUtility::saveToBuffer(exifData, jpeg);
+    exif_data_unref(exifData);
+    QVERIFY(saved);
+
+    // Only the requested start of the file is sent
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(jpeg.left(CameraMediaBrowser::kEmbeddedThumbnailBytes), 206, "image/jpeg");
+
+    CameraMediaBrowser browser(nullptr);
+    _useTemporaryDirectories(&browser);
+    browser.setActive(true);
+    browser.setVisibleRange(0, 0);
+
+    QSignalSpy thumbnailSpy(&browser, &CameraMediaBrowser::thumbnailReady);
+    browser.addCapturedImage(MAV_COMP_ID_CAMERA, capturedImage(server.url(QStringLiteral("/IMG_0.JPG")), 0));
+    QVERIFY(UnitTest::waitForSignal(thumbnailSpy, TestTimeout::longMs(), QStringLiteral("thumbnailReady")));
+    QCOMPARE_TRUE_WAIT(readyCount(browser), 1, TestTimeout::mediumMs());
+
+    // The preview is smaller than the thumbnail size, so it is used as is
+    QCOMPARE(thumbnail(browser, 0).size(), QSize(160, 120));
+    QVERIFY(browser.data(browser.index(0), CameraMediaBrowser::LocalFileRole).toString().isEmpty());
+}
+
+UT_REGISTER_TEST(CameraMediaBrowserTest, TestLabel::Integration, TestLabel::Vehicle)
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class CameraMediaBrowser;
+class MockLink;
+class QTemporaryDir;
+class Vehicle;
+
+class CameraMediaBrowserTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _testCapturedImagesEndToEnd();
+    void _testTransferOrderFollowsScreen();
+    void _testNoFtpThumbnailsWhileArmed();
+    void _testHttpTransfersInFlight();
+    void _testEmbeddedThumbnail();
+
+private:
+    void _connectCameraVehicle();
+    void _useTemporaryDirectories(CameraMediaBrowser *browser);
+
+    MockLink *_mockLink = nullptr;
+    Vehicle *_vehicle = nullptr;
+    QTemporaryDir *_tempDir = nullptr;
+};
@@ -0,0 +1,110 @@
+#include "CameraThumbnailCacheTest.h"
+#include "CameraThumbnailCache.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+
+void CameraThumbnailCacheTest::_testInsertLookup()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    CameraThumbnailCache cache(dir.path(), 1024 * 1024);
+
+    const QString url = QStringLiteral("mftp://[;comp=1]DCIM/1/IMG_0001.JPG");
+    const QString key1 = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, url);
+    const QString key2 = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA2, url);
+    QVERIFY(key1 != key2);
+    QCOMPARE(CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, url), key1);
+
+    QVERIFY(cache.lookup(key1).isEmpty());
+
+    const QByteArray data(1000, 'a');
+    const QString path = cache.insert(key1, data);
+    QVERIFY(!path.isEmpty());
+    QCOMPARE(cache.lookup(key1), path);
+    QVERIFY(cache.lookup(key2).isEmpty());
+    QCOMPARE(cache.count(), 1);
+    QCOMPARE(cache.totalBytes(), static_cast<qint64>(data.size()));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), data);
+    file.close();
+
+    // Replacing an entry accounts for the new size only
+    (void) cache.insert(key1, QByteArray(400, 'b'));
+    QCOMPARE(cache.count(), 1);
+    QCOMPARE(cache.totalBytes(), static_cast<qint64>(400));
+
+    cache.remove(key1);
+    QCOMPARE(cache.count(), 0);
+    QVERIFY(!QFile::exists(path));
+}
+
+void CameraThumbnailCacheTest::_testEvictsLeastRecentlyUsed()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    CameraThumbnailCache cache(dir.path(), 3000);
+
+    const QByteArray data(1000, 'a');
+    const QString keyA = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("a"));
+    const QString keyB = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("b"));
+    const QString keyC = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("c"));
+    const QString keyD = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("d"));
+    QVERIFY(!cache.insert(keyA, data).isEmpty());
+    QVERIFY(!cache.insert(keyB, data).isEmpty());
+    QVERIFY(!cache.insert(keyC, data).isEmpty());
+
+    // A is used again, so B is now the oldest
+    QVERIFY(!cache.lookup(keyA).isEmpty());
+    QVERIFY(!cache.insert(keyD, data).isEmpty());
+
+    QCOMPARE(cache.count(), 3);
+    QVERIFY(cache.totalBytes() <= cache.maxBytes());
+    QVERIFY(cache.contains(keyA));
+    QVERIFY(!cache.contains(keyB));
+    QVERIFY(cache.contains(keyC));
+    QVERIFY(cache.contains(keyD));
+
+    cache.setMaxBytes(1000);
+    QCOMPARE(cache.count(), 1);
+    QVERIFY(cache.contains(keyD));
+
+    // An entry larger than the cap is not kept
+    QVERIFY(cache.insert(keyB, QByteArray(2000, 'b')).isEmpty());
+    QVERIFY(!cache.contains(keyB));
+}
+
+void CameraThumbnailCacheTest::_testReopen()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString keyA = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("a"));
+    const QString keyB = CameraThumbnailCache::key(MAV_COMP_ID_CAMERA, QStringLiteral("b"));
+    {
+        CameraThumbnailCache cache(dir.path(), 1024 * 1024);
+        QVERIFY(!cache.insert(keyA, QByteArray(100, 'a')).isEmpty());
+        QVERIFY(!cache.insert(keyB, QByteArray(200, 'b')).isEmpty());
+    }
+
+    {
+        CameraThumbnailCache cache(dir.path(), 1024 * 1024);
+        QCOMPARE(cache.count(), 2);
+        QCOMPARE(cache.totalBytes(), static_cast<qint64>(300));
+        QVERIFY(!cache.lookup(keyA).isEmpty());
+        QVERIFY(!cache.lookup(keyB).isEmpty());
+    }
+
+    // Opening with a smaller cap trims the existing entries
+    CameraThumbnailCache cache(dir.path(), 250);
+    QCOMPARE(cache.count(), 1);
+    QVERIFY(cache.totalBytes() <= 250);
+
+    cache.clear();
+    QCOMPARE(cache.count(), 0);
+}
+
+UT_REGISTER_TEST(CameraThumbnailCacheTest, TestLabel::Unit)
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class CameraThumbnailCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testInsertLookup();
+    void _testEvictsLeastRecentlyUsed();
+    void _testReopen();
+};
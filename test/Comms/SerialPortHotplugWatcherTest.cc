@@ -0,0 +1,197 @@
+#include "SerialPortHotplugWatcherTest.h"
+
+#include "SerialPortHotplugWatcher.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
+
+#include <algorithm>
+
+namespace {
+
+/// LinkManager's autoconnect poll period, the latency hotplug detection replaces
+constexpr int kPollPeriodMSecs = 1000;
+
+/// Stands in for devtmpfs creating the device node
+bool plug(const QTemporaryDir &dir, const QString &name)
+{
+    QFile file(dir.filePath(name));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.close();
+    return true;
+}
+
+bool unplug(const QTemporaryDir &dir, const QString &name)
+{
+    return QFile::remove(dir.filePath(name));
+}
+
+} // namespace
+
+void SerialPortHotplugWatcherTest::_testHotplugPortName()
+{
+    QVERIFY(SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyACM0")));
+    QVERIFY(SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyUSB12")));
+    QVERIFY(SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("rfcomm1")));
+    QVERIFY(SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyCH343USB0")));
+    QVERIFY(SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyXRUSB3")));
+
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyS0")));
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyACM")));
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyUSB0.lock")));
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("tty")));
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyAMA0")));
+    QVERIFY(!SerialPortHotplugWatcher::isHotplugPortName(QStringLiteral("ttyXRUSB")));
+}
+
+void SerialPortHotplugWatcherTest::_testInitialScan()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(plug(dir, QStringLiteral("ttyACM0")));
+    QVERIFY(plug(dir, QStringLiteral("ttyUSB1")));
+    QVERIFY(plug(dir, QStringLiteral("ttyS0")));
+
+    SerialPortHotplugWatcher watcher;
+    QSignalSpy addedSpy(&watcher, &SerialPortHotplugWatcher::portAdded);
+    QVERIFY(watcher.start(dir.path()));
+    QVERIFY(watcher.isActive());
+
+    // Ports already present are part of the table but were not plugged in
+    const QStringList expected = { dir.filePath(QStringLiteral("ttyACM0")), dir.filePath(QStringLiteral("ttyUSB1")) };
+    QCOMPARE(watcher.ports(), expected);
+    QCOMPARE(addedSpy.count(), 0);
+
+    watcher.stop();
+    QVERIFY(!watcher.isActive());
+    QVERIFY(watcher.ports().isEmpty());
+}
+
+void SerialPortHotplugWatcherTest::_testPlugUnplug()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    SerialPortHotplugWatcher watcher;
+    QSignalSpy addedSpy(&watcher, &SerialPortHotplugWatcher::portAdded);
+    QSignalSpy removedSpy(&watcher, &SerialPortHotplugWatcher::portRemoved);
+    QVERIFY(watcher.start(dir.path()));
+    QVERIFY(watcher.ports().isEmpty());
+
+    const QString location = dir.filePath(QStringLiteral("ttyACM0"));
+    QVERIFY(plug(dir, QStringLiteral("ttyACM0")));
+    QVERIFY_SIGNAL_WAIT(addedSpy, kPollPeriodMSecs);
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(addedSpy.takeFirst().at(0).toString(), location);
+    QCOMPARE(watcher.ports(), QStringList{ location });
+
+    QVERIFY(unplug(dir, QStringLiteral("ttyACM0")));
+    QVERIFY_SIGNAL_WAIT(removedSpy, kPollPeriodMSecs);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.takeFirst().at(0).toString(), location);
+    QVERIFY(watcher.ports().isEmpty());
+
+    // A node moved into place is a plug as well
+    QVERIFY(plug(dir, QStringLiteral("staging")));
+    QVERIFY(QFile::rename(dir.filePath(QStringLiteral("staging")), dir.filePath(QStringLiteral("ttyUSB0"))));
+    QVERIFY_SIGNAL_WAIT(addedSpy, kPollPeriodMSecs);
+    QCOMPARE(addedSpy.takeFirst().at(0).toString(), dir.filePath(QStringLiteral("ttyUSB0")));
+    QCOMPARE(removedSpy.count(), 0);
+}
+
+void SerialPortHotplugWatcherTest::_testIgnoresOtherNodes()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    SerialPortHotplugWatcher watcher;
+    QSignalSpy addedSpy(&watcher, &SerialPortHotplugWatcher::portAdded);
+    QVERIFY(watcher.start(dir.path()));
+
+    QVERIFY(plug(dir, QStringLiteral("ttyS4")));
+    QVERIFY(plug(dir, QStringLiteral("null")));
+    QVERIFY(QDir(dir.path()).mkdir(QStringLiteral("ttyACM9")));
+    QVERIFY_NO_SIGNAL_WAIT(addedSpy, 200);
+
+    // Events are still delivered after the ignored ones
+    QVERIFY(plug(dir, QStringLiteral("rfcomm0")));
+    QVERIFY_SIGNAL_WAIT(addedSpy, kPollPeriodMSecs);
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(watcher.ports(), QStringList{ dir.filePath(QStringLiteral("rfcomm0")) });
+}
+
+// Polling notices a new port up to a full poll period late, hotplug detection as soon as the event loop runs
+void SerialPortHotplugWatcherTest::_testPlugLatency()
+{
+    static constexpr int kPlugs = 20;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    SerialPortHotplugWatcher watcher;
+    QVERIFY(watcher.start(dir.path()));
+
+    QElapsedTimer plugTimer;
+    qint64 latencyMSecs = -1;
+    (void) connect(&watcher, &SerialPortHotplugWatcher::portAdded, this, [&plugTimer, &latencyMSecs]() {
+        latencyMSecs = plugTimer.elapsed();
+    });
+    QSignalSpy removedSpy(&watcher, &SerialPortHotplugWatcher::portRemoved);
+
+    qint64 maxLatencyMSecs = 0;
+    qint64 totalLatencyMSecs = 0;
+    for (int i = 0; i < kPlugs; i++) {
+        latencyMSecs = -1;
+        plugTimer.start();
+        QVERIFY(plug(dir, QStringLiteral("ttyACM0")));
+        QTRY_VERIFY_WITH_TIMEOUT(latencyMSecs >= 0, kPollPeriodMSecs);
+        maxLatencyMSecs = std::max(maxLatencyMSecs, latencyMSecs);
+        totalLatencyMSecs += latencyMSecs;
+
+        QVERIFY(unplug(dir, QStringLiteral("ttyACM0")));
+        QVERIFY_SIGNAL_WAIT(removedSpy, kPollPeriodMSecs);
+    }
+
+    qCDebug(UnitTestLog) << "Plug to portAdded msecs - max:" << maxLatencyMSecs << "mean:" << (static_cast<double>(totalLatencyMSecs) / kPlugs)
+                         << "polling worst case:" << kPollPeriodMSecs;
+    QCOMPARE_LT(maxLatencyMSecs, kPollPeriodMSecs / 4);
+}
+
+void SerialPortHotplugWatcherTest::_testDirectoryRemoved()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString deviceDirectory = dir.filePath(QStringLiteral("dev"));
+    QVERIFY(QDir().mkpath(deviceDirectory));
+
+    SerialPortHotplugWatcher watcher;
+    QSignalSpy stoppedSpy(&watcher, &SerialPortHotplugWatcher::stopped);
+    QVERIFY(watcher.start(deviceDirectory));
+
+    // LinkManager goes back to polling when this happens
+    expectLogMessage("Comms.SerialPortHotplugWatcher", QtWarningMsg, QRegularExpression("Lost watch on"));
+    QVERIFY(QDir(deviceDirectory).removeRecursively());
+    QVERIFY_SIGNAL_WAIT(stoppedSpy, kPollPeriodMSecs);
+    verifyExpectedLogMessage();
+    QVERIFY(!watcher.isActive());
+}
+
+void SerialPortHotplugWatcherTest::_testStartFailsWithoutDirectory()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    SerialPortHotplugWatcher watcher;
+    expectLogMessage("Comms.SerialPortHotplugWatcher", QtWarningMsg, QRegularExpression("inotify_add_watch failed"));
+    QVERIFY(!watcher.start(dir.filePath(QStringLiteral("missing"))));
+    verifyExpectedLogMessage();
+    QVERIFY(!watcher.isActive());
+}
+
+UT_REGISTER_TEST(SerialPortHotplugWatcherTest, TestLabel::Unit, TestLabel::Comms)
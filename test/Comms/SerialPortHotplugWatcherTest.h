@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class SerialPortHotplugWatcherTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testHotplugPortName();
+    void _testInitialScan();
+    void _testPlugUnplug();
+    void _testIgnoresOtherNodes();
+    void _testPlugLatency();
+    void _testDirectoryRemoved();
+    void _testStartFailsWithoutDirectory();
+};
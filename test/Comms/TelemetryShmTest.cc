@@ -0,0 +1,280 @@
+#include "TelemetryShmTest.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtNetwork/QUdpSocket>
+
+#include "Benchmarking.h"
+#include "MAVLinkLib.h"
+#include "TelemetryShmPublisher.h"
+#include "TelemetryShmReader.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+QString segmentName()
+{
+    return QStringLiteral("/qgc_telemetry_test_%1").arg(QCoreApplication::applicationPid());
+}
+
+QByteArray toFrame(const mavlink_message_t &message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+    return QByteArray(reinterpret_cast<const char *>(buffer), length);
+}
+
+mavlink_message_t heartbeat(uint8_t systemId, uint8_t type = MAV_TYPE_QUADROTOR,
+                            uint8_t autopilot = MAV_AUTOPILOT_PX4)
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_heartbeat_pack_chan(systemId, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, type, autopilot,
+                                           MAV_MODE_FLAG_SAFETY_ARMED | MAV_MODE_FLAG_CUSTOM_MODE_ENABLED, 65536,
+                                           MAV_STATE_ACTIVE);
+    return message;
+}
+
+void publish(TelemetryShmPublisher &publisher, const mavlink_message_t &message)
+{
+    const QByteArray frame = toFrame(message);
+    publisher.publish(MAVLINK_COMM_0, message, QByteArrayView(frame));
+}
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+/// Permission bits of the shared memory segment @p name, -1 if it can't be opened
+int segmentMode(const QString &name)
+{
+    const int fd = ::shm_open(name.toLocal8Bit().constData(), O_RDONLY, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat status{};
+    const int result = (::fstat(fd, &status) == 0) ? static_cast<int>(status.st_mode & 0777) : -1;
+    (void) ::close(fd);
+    return result;
+}
+#endif
+
+} // namespace
+
+void TelemetryShmTest::init()
+{
+    UnitTest::init();
+
+#if defined(Q_OS_WIN) || defined(Q_OS_ANDROID)
+    QSKIP("POSIX shared memory export is not available on this platform");
+#endif
+}
+
+void TelemetryShmTest::_frameRoundTripTest()
+{
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+    QVERIFY(reader.publisherAlive());
+
+    TelemetryShmReader::Frame frame;
+    QVERIFY(!reader.readFrame(frame));
+
+    QList<QByteArray> sent;
+    for (uint8_t systemId = 1; systemId <= 3; systemId++) {
+        const mavlink_message_t message = heartbeat(systemId);
+        sent.append(toFrame(message));
+        publish(publisher, message);
+    }
+
+    for (qsizetype i = 0; i < sent.size(); i++) {
+        QVERIFY(reader.readFrame(frame));
+        QCOMPARE(frame.index, static_cast<uint64_t>(i));
+        QCOMPARE(frame.channel, static_cast<uint8_t>(MAVLINK_COMM_0));
+        QCOMPARE(QByteArray(reinterpret_cast<const char *>(frame.bytes), frame.length), sent[i]);
+    }
+    QVERIFY(!reader.readFrame(frame));
+    QCOMPARE(reader.droppedFrames(), static_cast<uint64_t>(0));
+    QCOMPARE(publisher.publishedFrames(), static_cast<uint64_t>(3));
+}
+
+void TelemetryShmTest::_vehicleSnapshotTest()
+{
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+
+    // Telemetry ahead of the first heartbeat is not attributed to a vehicle
+    mavlink_message_t message{};
+    (void) mavlink_msg_attitude_pack_chan(42, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, 0, 0.5f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    publish(publisher, message);
+    TelemetryShm::VehicleState state;
+    QVERIFY(!reader.vehicleState(42, state));
+
+    publish(publisher, heartbeat(42));
+
+    (void) mavlink_msg_global_position_int_pack_chan(42, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, 1000,
+                                                     473977418, 85455939, 488000, 12500, 0, 0, 0, 9000);
+    publish(publisher, message);
+    (void) mavlink_msg_attitude_pack_chan(42, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, 1000, 0.1f, -0.2f, 1.5f,
+                                          0.01f, 0.02f, 0.03f);
+    publish(publisher, message);
+
+    QVERIFY(reader.vehicleState(42, state));
+    QCOMPARE(state.systemId, static_cast<uint8_t>(42));
+    QCOMPARE(state.autopilot, static_cast<uint8_t>(MAV_AUTOPILOT_PX4));
+    QCOMPARE(state.vehicleType, static_cast<uint8_t>(MAV_TYPE_QUADROTOR));
+    QCOMPARE(state.customMode, static_cast<uint32_t>(65536));
+    QCOMPARE(state.armed, static_cast<uint8_t>(1));
+    QCOMPARE(state.messageCount, static_cast<uint64_t>(3));
+    QVERIFY(qAbs(state.latitudeDeg - 47.3977418) < 1e-9);
+    QVERIFY(qAbs(state.longitudeDeg - 8.5455939) < 1e-9);
+    QCOMPARE(state.altitudeAmslM, 488.f);
+    QCOMPARE(state.altitudeRelativeM, 12.5f);
+    QCOMPARE(state.pitchRad, -0.2f);
+    QCOMPARE(state.yawRateRadS, 0.03f);
+    QCOMPARE(state.batteryRemainingPct, static_cast<int8_t>(-1));
+
+    QCOMPARE(reader.vehicles(), std::vector<uint8_t>{42});
+}
+
+void TelemetryShmTest::_gcsHeartbeatIgnoredTest()
+{
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+
+    publish(publisher, heartbeat(255, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID));
+    publish(publisher, heartbeat(7, MAV_TYPE_GIMBAL, MAV_AUTOPILOT_INVALID));
+
+    QVERIFY(reader.vehicles().empty());
+
+    TelemetryShmReader::Frame frame;
+    QVERIFY(reader.readFrame(frame));
+    QVERIFY(reader.readFrame(frame));
+}
+
+void TelemetryShmTest::_overrunTest()
+{
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+
+    constexpr uint64_t kOverrun = 10;
+    const mavlink_message_t message = heartbeat(1);
+    const QByteArray bytes = toFrame(message);
+    for (uint64_t i = 0; i < (TelemetryShm::kFrameSlotCount + kOverrun); i++) {
+        publisher.publish(MAVLINK_COMM_0, message, QByteArrayView(bytes));
+    }
+
+    TelemetryShmReader::Frame frame;
+    QVERIFY(reader.readFrame(frame));
+    QCOMPARE(frame.index, kOverrun);
+    QCOMPARE(reader.droppedFrames(), kOverrun);
+
+    uint64_t count = 1;
+    while (reader.readFrame(frame)) {
+        count++;
+    }
+    QCOMPARE(count, static_cast<uint64_t>(TelemetryShm::kFrameSlotCount));
+
+    publisher.publish(MAVLINK_COMM_0, message, QByteArrayView(bytes));
+    reader.seekToLatest();
+    QVERIFY(!reader.readFrame(frame));
+}
+
+void TelemetryShmTest::_closeUnlinksTest()
+{
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+    QVERIFY(publisher.isOpen());
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+
+    publisher.close();
+    QVERIFY(!publisher.isOpen());
+
+    // An existing mapping stays valid but reports the publisher gone, new readers can't attach
+    QVERIFY(!reader.publisherAlive());
+    TelemetryShmReader lateReader;
+    QVERIFY(!lateReader.open(segmentName().toLocal8Bit().constData()));
+
+    QVERIFY(!publisher.open(QStringLiteral("no_leading_slash")));
+}
+
+void TelemetryShmTest::_permissionsTest()
+{
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+    // Vehicle positions are private to the owner by default
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+    QVERIFY(!publisher.otherUsers());
+    QCOMPARE(segmentMode(segmentName()), 0600);
+
+    QVERIFY(publisher.open(segmentName(), true /* otherUsers */));
+    QVERIFY(publisher.otherUsers());
+    QCOMPARE(segmentMode(segmentName()), 0644);
+    publisher.close();
+#endif
+}
+
+void TelemetryShmTest::_benchmarkExportVsUdp()
+{
+    // Latency and CPU cost of handing one frame to a local consumer: publish and read back in the same thread, so the
+    // time per frame is the combined CPU cost of both sides without scheduling noise.
+    mavlink_message_t message{};
+    (void) mavlink_msg_global_position_int_pack_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, 1000,
+                                                     473977418, 85455939, 488000, 12500, 0, 0, 0, 9000);
+    const QByteArray bytes = toFrame(message);
+
+    TelemetryShmPublisher publisher;
+    QVERIFY(publisher.open(segmentName()));
+    publish(publisher, heartbeat(1));
+
+    TelemetryShmReader reader;
+    QVERIFY(reader.open(segmentName().toLocal8Bit().constData()));
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+    const quint16 port = receiver.localPort();
+
+    TelemetryShmReader::Frame frame;
+    QByteArray datagram(MAVLINK_MAX_PACKET_LEN, Qt::Uninitialized);
+
+    auto bench = qgc::bench::ciConfig();
+    bench.unit("frame").relative(true);
+    bench.run("UDP forward to localhost (baseline)", [&] {
+        (void) sender.writeDatagram(bytes, QHostAddress::LocalHost, port);
+        while (!receiver.hasPendingDatagrams()) {
+            (void) receiver.waitForReadyRead(100);
+        }
+        ankerl::nanobench::doNotOptimizeAway(receiver.readDatagram(datagram.data(), datagram.size()));
+    });
+    bench.run("shared memory publish + readFrame", [&] {
+        publisher.publish(MAVLINK_COMM_0, message, QByteArrayView(bytes));
+        ankerl::nanobench::doNotOptimizeAway(reader.readFrame(frame));
+    });
+    bench.run("shared memory publish + vehicleState", [&] {
+        publisher.publish(MAVLINK_COMM_0, message, QByteArrayView(bytes));
+        TelemetryShm::VehicleState state;
+        ankerl::nanobench::doNotOptimizeAway(reader.vehicleState(1, state));
+    });
+
+    QCOMPARE(reader.droppedFrames(), static_cast<uint64_t>(0));
+}
+
+UT_REGISTER_TEST(TelemetryShmTest, TestLabel::Unit, TestLabel::Comms)
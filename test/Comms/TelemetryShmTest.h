@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TelemetryShmTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() override;
+
+    void _frameRoundTripTest();
+    void _vehicleSnapshotTest();
+    void _gcsHeartbeatIgnoredTest();
+    void _overrunTest();
+    void _closeUnlinksTest();
+    void _permissionsTest();
+    void _benchmarkExportVsUdp();
+};
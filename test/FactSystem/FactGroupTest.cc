@@ -1,10 +1,18 @@
 #include "FactGroupTest.h"
+#include <QtCore/QFile>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QSignalSpy>
 
+#include <limits>
+#include <memory>
+#include <vector>
 
+#include "Benchmarking.h"
 #include "Fact.h"
 #include "FactGroup.h"
+#include "FactMetaDataRegistry.h"
+#include "TelemetryStore.h"
 
 /// Testable subclass exposing protected members
 class TestableFactGroup : public FactGroup
@@ -21,6 +29,34 @@ class TestableFactGroup : public FactGroup
     using FactGroup::_setTelemetryAvailable;
 };
 
+/// Rate limited group, values are published from the TelemetryStore tick
+class RateLimitedFactGroup : public FactGroup
+{
+    Q_OBJECT
+public:
+    explicit RateLimitedFactGroup(int updateRateMsecs, QObject *parent = nullptr)
+        : FactGroup(updateRateMsecs, parent, true /* ignoreCamelCase */)
+    {
+    }
+
+    using FactGroup::_addFact;
+};
+
+/// Group with metadata loaded from a json file, as the vehicle telemetry groups do
+class JsonFactGroup : public FactGroup
+{
+    Q_OBJECT
+public:
+    explicit JsonFactGroup(const QString &metaDataFile, QObject *parent = nullptr)
+        : FactGroup(0 /* immediate updates */, metaDataFile, parent)
+    {
+    }
+
+    using FactGroup::_addFact;
+
+    const FactMetaDataRegistry::MetaDataMap &metaDataMap() const { return *_sharedMetaData; }
+};
+
 void FactGroupTest::_addFactAndLookup_test()
 {
     TestableFactGroup group;
@@ -234,6 +270,284 @@ void FactGroupTest::_factGroupNames_test()
     QVERIFY(names.contains(QStringLiteral("sub2")));
 }
 
+void FactGroupTest::_telemetryStoreTypedValues_test()
+{
+    RateLimitedFactGroup group(1000);
+    Fact intFact(0, "int", FactMetaData::valueTypeInt32, &group);
+    Fact floatFact(0, "float", FactMetaData::valueTypeFloat, &group);
+    Fact uint64Fact(0, "uint64", FactMetaData::valueTypeUint64, &group);
+    Fact stringFact(0, "string", FactMetaData::valueTypeString, &group);
+
+    group._addFact(&intFact);
+    group._addFact(&floatFact);
+    group._addFact(&uint64Fact);
+    group._addFact(&stringFact);
+
+    QVERIFY(intFact.telemetrySlot() >= 0);
+    QVERIFY(stringFact.telemetrySlot() >= 0);
+
+    intFact.setRawValue(-42);
+    QCOMPARE(intFact.rawValue().typeId(), QMetaType::Int);
+    QCOMPARE(intFact.rawValue().toInt(), -42);
+
+    floatFact.setRawValue(1.5);
+    QCOMPARE(floatFact.rawValue().typeId(), QMetaType::Float);
+    QCOMPARE(floatFact.rawValue().toFloat(), 1.5f);
+
+    // Values above 2^53 must survive the 64 bit slot exactly
+    constexpr qulonglong bigValue = std::numeric_limits<qulonglong>::max() - 1;
+    uint64Fact.setRawValue(bigValue);
+    QCOMPARE(uint64Fact.rawValue().typeId(), QMetaType::ULongLong);
+    QCOMPARE(uint64Fact.rawValue().toULongLong(), bigValue);
+
+    // Strings keep their own QVariant
+    stringFact.setRawValue(QStringLiteral("hello"));
+    QCOMPARE(stringFact.rawValue().toString(), QStringLiteral("hello"));
+}
+
+void FactGroupTest::_telemetryStoreDeferredPublish_test()
+{
+    TelemetryStore *const store = TelemetryStore::instance();
+    RateLimitedFactGroup group(1000);
+    Fact fact(0, "speed", FactMetaData::valueTypeDouble, &group);
+    group._addFact(&fact);
+
+    QSignalSpy spy(&fact, &Fact::valueChanged);
+    QVERIFY(spy.isValid());
+
+    fact.setRawValue(12.5);
+    fact.setRawValue(13.5);
+    QCOMPARE(spy.count(), 0);
+    QVERIFY(store->isDirty(fact.telemetrySlot()));
+
+    // Ticks of other rates leave the fact alone
+    store->publish(100);
+    store->publish(999);
+    QCOMPARE(spy.count(), 0);
+    QVERIFY(store->isDirty(fact.telemetrySlot()));
+
+    // The 1000 msecs tick publishes once, coalesced to the latest value
+    store->publish(1000);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toDouble(), 13.5);
+    QVERIFY(!store->isDirty(fact.telemetrySlot()));
+
+    // Nothing changed: no further signals
+    store->publish(1000);
+    QCOMPARE(spy.count(), 1);
+
+    // Live updates bypass the store
+    group.setLiveUpdates(true);
+    fact.setRawValue(14.5);
+    QCOMPARE(spy.count(), 2);
+}
+
+void FactGroupTest::_telemetryStoreUnobservedFact_test()
+{
+    TelemetryStore *const store = TelemetryStore::instance();
+    RateLimitedFactGroup group(100);
+    Fact fact(0, "unobserved", FactMetaData::valueTypeDouble, &group);
+    group._addFact(&fact);
+
+    // No receivers: the tick clears the dirty bit without building the cooked value
+    fact.setRawValue(1.0);
+    QVERIFY(store->isDirty(fact.telemetrySlot()));
+    store->publish(100);
+    QVERIFY(!store->isDirty(fact.telemetrySlot()));
+    QCOMPARE(fact.rawValue().toDouble(), 1.0);
+}
+
+void FactGroupTest::_telemetryStoreSlotReuse_test()
+{
+    TelemetryStore *const store = TelemetryStore::instance();
+    RateLimitedFactGroup group(250);
+
+    int releasedSlot = -1;
+    {
+        RateLimitedFactGroup releasedGroup(250);
+        Fact fact(0, "released", FactMetaData::valueTypeDouble, &releasedGroup);
+        releasedGroup._addFact(&fact);
+        releasedSlot = fact.telemetrySlot();
+        QVERIFY(releasedSlot >= 0);
+    }
+
+    // A released slot is not handed out again before the next publish pass
+    Fact beforePublish(0, "beforePublish", FactMetaData::valueTypeDouble, &group);
+    group._addFact(&beforePublish);
+    QVERIFY(beforePublish.telemetrySlot() >= 0);
+    QVERIFY(beforePublish.telemetrySlot() != releasedSlot);
+
+    store->publish(250);
+    Fact afterPublish(0, "afterPublish", FactMetaData::valueTypeDouble, &group);
+    group._addFact(&afterPublish);
+    QCOMPARE(afterPublish.telemetrySlot(), releasedSlot);
+}
+
+void FactGroupTest::_benchmarkTelemetryStore()
+{
+    TelemetryStore *const store = TelemetryStore::instance();
+
+    TestableFactGroup immediateGroup;
+    Fact immediateFact(0, "immediate", FactMetaData::valueTypeDouble, &immediateGroup);
+    immediateGroup._addFact(&immediateFact);
+
+    RateLimitedFactGroup storeGroup(100);
+    Fact storeFact(0, "stored", FactMetaData::valueTypeDouble, &storeGroup);
+    storeGroup._addFact(&storeFact);
+    const int storeSlot = storeFact.telemetrySlot();
+    QVERIFY(storeSlot >= 0);
+
+    double value = 0;
+    auto setBench = qgc::bench::ciConfig();
+    setBench.relative(true);
+    setBench.run("set: Fact::setRawValue, QVariant storage (baseline)", [&] {
+        immediateFact.setRawValue(value += 0.5);
+    });
+    setBench.run("set: Fact::setRawValue, store backed", [&] {
+        storeFact.setRawValue(value += 0.5);
+    });
+    setBench.run("set: TelemetryStore::setValue", [&] {
+        ankerl::nanobench::doNotOptimizeAway(store->setValue(storeSlot, value += 0.5));
+    });
+
+    // 50 vehicles x 30 groups x 10 facts, every fact changed between ticks
+    constexpr int kGroupCount = 50 * 30;
+    constexpr int kFactsPerGroup = 10;
+    std::vector<std::unique_ptr<RateLimitedFactGroup>> groups;
+    std::vector<Fact*> facts;
+    groups.reserve(kGroupCount);
+    facts.reserve(kGroupCount * kFactsPerGroup);
+    for (int i = 0; i < kGroupCount; i++) {
+        groups.push_back(std::make_unique<RateLimitedFactGroup>(100));
+        for (int j = 0; j < kFactsPerGroup; j++) {
+            Fact *const fact = new Fact(0, QStringLiteral("f%1").arg(j), FactMetaData::valueTypeDouble, groups.back().get());
+            groups.back()->_addFact(fact);
+            facts.push_back(fact);
+        }
+    }
+
+    auto publishBench = qgc::bench::ciConfig();
+    publishBench.batch(facts.size());
+    publishBench.run("publish: 15000 dirty facts, unobserved", [&] {
+        for (Fact *fact : facts) {
+            store->markDirty(fact->telemetrySlot());
+        }
+        store->publish(100);
+    });
+
+    QVERIFY(store->registeredFactCount() >= static_cast<int>(facts.size()));
+}
+
+void FactGroupTest::_sharedMetaData_test()
+{
+    // Private copy of a telemetry metadata file, so no other live group shares it
+    const QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString metaDataFile = tempDir.filePath(QStringLiteral("BatteryFact.json"));
+    QVERIFY(QFile::copy(QStringLiteral(":/json/Vehicle/BatteryFact.json"), metaDataFile));
+
+    FactMetaDataRegistry *const registry = FactMetaDataRegistry::instance();
+    const int parseCount = registry->parseCount();
+    const int loadedFileCount = registry->loadedFileCount();
+
+    {
+        JsonFactGroup firstVehicle(metaDataFile);
+        JsonFactGroup secondVehicle(metaDataFile);
+        QVERIFY(!firstVehicle.metaDataMap().isEmpty());
+        QCOMPARE(registry->parseCount(), parseCount + 1);
+
+        // Same FactMetaData objects, not equal copies
+        QCOMPARE(secondVehicle.metaDataMap(), firstVehicle.metaDataMap());
+
+        Fact firstFact(0, QStringLiteral("batteryFunction"), FactMetaData::valueTypeUint8, &firstVehicle);
+        Fact secondFact(0, QStringLiteral("batteryFunction"), FactMetaData::valueTypeUint8, &secondVehicle);
+        firstVehicle._addFact(&firstFact);
+        secondVehicle._addFact(&secondFact);
+        const Fact &constFirstFact = firstFact;
+        const Fact &constSecondFact = secondFact;
+        QCOMPARE(constSecondFact.metaData(), constFirstFact.metaData());
+        QCOMPARE(constFirstFact.metaData(), firstVehicle.metaDataMap().value(QStringLiteral("batteryFunction")));
+
+        // Adjusting one vehicle's metadata (FirmwarePlugin::adjustMetaData) copies it instead of leaking to the other
+        const QString sharedDescription = constFirstFact.shortDescription();
+        secondFact.metaData()->setShortDescription(QStringLiteral("Adjusted"));
+        QVERIFY(constSecondFact.metaData() != constFirstFact.metaData());
+        QCOMPARE(secondFact.shortDescription(), QStringLiteral("Adjusted"));
+        QCOMPARE(firstFact.shortDescription(), sharedDescription);
+        QCOMPARE(firstVehicle.metaDataMap().value(QStringLiteral("batteryFunction"))->shortDescription(), sharedDescription);
+    }
+    QCOMPARE(registry->loadedFileCount(), loadedFileCount);
+
+    {
+        // ~QObject deletes child facts after the group has dropped its own reference, their metadata must still be alive
+        JsonFactGroup *const vehicle = new JsonFactGroup(metaDataFile);
+        Fact *const childFact = new Fact(0, QStringLiteral("batteryFunction"), FactMetaData::valueTypeUint8, vehicle);
+        vehicle->_addFact(childFact);
+        int loadedWhileChildAlive = -1;
+        (void) connect(vehicle, &QObject::destroyed, this, [registry, &loadedWhileChildAlive]() {
+            loadedWhileChildAlive = registry->loadedFileCount();
+        });
+        delete vehicle;
+        QCOMPARE(loadedWhileChildAlive, loadedFileCount + 1);
+        QCOMPARE(registry->loadedFileCount(), loadedFileCount);
+    }
+
+    // Metadata is released with the last group and parsed again on next use
+    JsonFactGroup reconnectedVehicle(metaDataFile);
+    QCOMPARE(registry->parseCount(), parseCount + 3);
+    QVERIFY(!reconnectedVehicle.metaDataMap().isEmpty());
+}
+
+void FactGroupTest::_benchmarkSharedMetaData()
+{
+    // Every connected vehicle creates the same set of json backed groups
+    static const QStringList metaDataFiles = {
+        QStringLiteral(":/json/Vehicle/VehicleFact.json"),
+        QStringLiteral(":/json/Vehicle/GPSFact.json"),
+        QStringLiteral(":/json/Vehicle/BatteryFact.json"),
+        QStringLiteral(":/json/Vehicle/WindFact.json"),
+        QStringLiteral(":/json/Vehicle/VibrationFact.json"),
+        QStringLiteral(":/json/Vehicle/EscStatusFactGroup.json"),
+    };
+    constexpr int kVehicleCount = 50;
+
+    auto connectBench = qgc::bench::ciConfig().epochs(10).minEpochIterations(1);
+    connectBench.relative(true);
+    connectBench.run("50 vehicles: createMapFromJsonFile per group (baseline)", [&] {
+        QObject vehicles;
+        for (int i = 0; i < kVehicleCount; i++) {
+            for (const QString &metaDataFile : metaDataFiles) {
+                ankerl::nanobench::doNotOptimizeAway(FactMetaData::createMapFromJsonFile(metaDataFile, &vehicles));
+            }
+        }
+    });
+    connectBench.run("50 vehicles: shared FactMetaDataRegistry", [&] {
+        std::vector<std::unique_ptr<JsonFactGroup>> groups;
+        groups.reserve(kVehicleCount * metaDataFiles.size());
+        for (int i = 0; i < kVehicleCount; i++) {
+            for (const QString &metaDataFile : metaDataFiles) {
+                groups.push_back(std::make_unique<JsonFactGroup>(metaDataFile));
+            }
+        }
+    });
+
+    // Memory: one FactMetaData per fact and file instead of one per fact, file and vehicle
+    std::vector<std::unique_ptr<JsonFactGroup>> groups;
+    qsizetype metaDataObjects = 0;
+    for (int i = 0; i < kVehicleCount; i++) {
+        for (const QString &metaDataFile : metaDataFiles) {
+            groups.push_back(std::make_unique<JsonFactGroup>(metaDataFile));
+            if (i == 0) {
+                metaDataObjects += groups.back()->metaDataMap().count();
+            }
+        }
+    }
+    qCDebug(UnitTestLog) << "FactMetaData objects for" << kVehicleCount << "vehicles:" << metaDataObjects
+                         << "shared, previously" << (metaDataObjects * kVehicleCount);
+    QVERIFY(metaDataObjects > 0);
+    QCOMPARE(groups[metaDataFiles.size()]->metaDataMap(), groups.front()->metaDataMap());
+}
+
 #include "FactGroupTest.moc"
 
 UT_REGISTER_TEST(FactGroupTest, TestLabel::Unit)
@@ -24,4 +24,11 @@ private slots:
     void _telemetryAvailable_test();
     void _factNames_test();
     void _factGroupNames_test();
+    void _telemetryStoreTypedValues_test();
+    void _telemetryStoreDeferredPublish_test();
+    void _telemetryStoreUnobservedFact_test();
+    void _telemetryStoreSlotReuse_test();
+    void _benchmarkTelemetryStore();
+    void _sharedMetaData_test();
+    void _benchmarkSharedMetaData();
 };
@@ -5,6 +5,7 @@
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
 
+#include "Fact.h"
 #include "ParameterEditorController.h"
 #include "QmlObjectListModel.h"
 #include "Fixtures/RAIIFixtures.h"
@@ -169,3 +170,50 @@ void ParameterEditorControllerTest::_buildDiffMPMissingParam()
     QCOMPARE(missingParams.count(), 1);
     QCOMPARE(missingParams.at(0), QStringLiteral("NONEXISTENT_PARAM_XYZ"));
 }
+
+void ParameterEditorControllerTest::_searchNarrowsWithRowDiffs()
+{
+    ParameterEditorController controller;
+
+    // The search runs after the typing debounce
+    QSignalSpy parametersSpy(&controller, &ParameterEditorController::parametersChanged);
+    controller.setProperty("searchText", QStringLiteral("SYS"));
+    QVERIFY(parametersSpy.wait(TestTimeout::mediumMs()));
+
+    auto* const parameters = qobject_cast<ParameterTableModel*>(controller.property("parameters").value<QAbstractTableModel*>());
+    QVERIFY(parameters);
+    const int sysRowCount = parameters->rowCount();
+    QVERIFY(sysRowCount > 1);
+
+    const auto searchFor = [&controller, parameters](const QString& searchText) {
+        QSignalSpy rowCountSpy(parameters, &ParameterTableModel::rowCountChanged);
+        controller.setProperty("searchText", searchText);
+        return rowCountSpy.wait(TestTimeout::mediumMs());
+    };
+
+    QSignalSpy resetSpy(parameters, &QAbstractItemModel::modelReset);
+    QSignalSpy removedSpy(parameters, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(parameters, &QAbstractItemModel::rowsInserted);
+
+    // Extending the query removes rows instead of resetting the model
+    QVERIFY(searchFor(QStringLiteral("SYS_AUTOS")));
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(removedSpy.count() > 0);
+    QCOMPARE(insertedSpy.count(), 0);
+    QVERIFY(parameters->rowCount() >= 1);
+    QVERIFY(parameters->rowCount() < sysRowCount);
+    for (int row = 0; row < parameters->rowCount(); row++) {
+        const Fact* fact = parameters->data(parameters->index(row, ParameterTableModel::ValueColumn), ParameterTableModel::FactRole).value<Fact*>();
+        QVERIFY(fact);
+        QVERIFY2(fact->name().contains(QStringLiteral("SYS_AUTOS")) || fact->shortDescription().contains(QStringLiteral("SYS_AUTOS"), Qt::CaseInsensitive)
+                     || fact->longDescription().contains(QStringLiteral("SYS_AUTOS"), Qt::CaseInsensitive),
+                 qPrintable(fact->name()));
+    }
+
+    // Going back inserts the rows again, still without a reset
+    removedSpy.clear();
+    QVERIFY(searchFor(QStringLiteral("SYS")));
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(insertedSpy.count() > 0);
+    QCOMPARE(parameters->rowCount(), sysRowCount);
+}
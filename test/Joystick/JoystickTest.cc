@@ -1,12 +1,14 @@
 #include "JoystickTest.h"
 
 #include "Joystick.h"
+#include "JoystickLatencyHistogram.h"
 #include "JoystickSDL.h"
 #include "MockJoystick.h"
 #include "SDLJoystick.h"
 
 #include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
+#include <QtTest/QSignalSpy>
 
 void JoystickTest::initTestCase()
 {
@@ -21,6 +23,12 @@ void JoystickTest::init()
 
 void JoystickTest::cleanup()
 {
+    if (_axisFrequencyFact) {
+        _axisFrequencyFact->setRawValue(_savedAxisFrequencyHz);
+    }
+    _axisFrequencyFact.clear();
+    _savedAxisFrequencyHz.clear();
+
     // Clear references before mock teardown — joysticks are managed by JoystickSDL::discover()'s
     // static 'previous' map and may be deleted when the mock device is removed.
     _discoveredJoysticks.clear();
@@ -821,4 +829,88 @@ void JoystickTest::_adjustRangeToRcOverridePwmTest()
     js->_close();
 }
 
+//-----------------------------------------------------------------------------
+// Control Loop Latency Tests
+//-----------------------------------------------------------------------------
+void JoystickTest::_latencyHistogramTest()
+{
+    JoystickLatencyHistogram histogram;
+    QCOMPARE(histogram.count(), 0ULL);
+    QCOMPARE(histogram.percentileUs(50.0), 0ULL);
+
+    // 90 samples in [512, 1024) us and 10 samples in [16384, 32768) us
+    for (int i = 0; i < 90; i++) {
+        histogram.record(600);
+    }
+    for (int i = 0; i < 10; i++) {
+        histogram.record(20000);
+    }
+
+    QCOMPARE(histogram.count(), 100ULL);
+    QCOMPARE(histogram.maxUs(), 20000ULL);
+    QCOMPARE(histogram.bucketCount(9), 90ULL);
+    QCOMPARE(histogram.bucketCount(14), 10ULL);
+    QCOMPARE(histogram.percentileUs(50.0), 1024ULL);
+    QCOMPARE(histogram.percentileUs(90.0), 1024ULL);
+    QCOMPARE(histogram.percentileUs(99.0), 20000ULL);
+    QCOMPARE_FUZZY(histogram.meanUs(), 2540.0, 0.001);
+
+    // Out of range samples land in the open-ended last bucket
+    histogram.record(100000000ULL);
+    QCOMPARE(histogram.bucketCount(JoystickLatencyHistogram::BucketCount - 1), 1ULL);
+
+    const QVariantMap stats = histogram.toVariantMap();
+    QCOMPARE(stats.value(QStringLiteral("count")).toULongLong(), 101ULL);
+    QCOMPARE(stats.value(QStringLiteral("buckets")).toList().count(), JoystickLatencyHistogram::BucketCount);
+
+    histogram.reset();
+    QCOMPARE(histogram.count(), 0ULL);
+    QCOMPARE(histogram.maxUs(), 0ULL);
+}
+
+void JoystickTest::_inputToWireLatencyTest()
+{
+    _mockJoystick = std::unique_ptr<MockJoystick>(MockJoystick::create(QStringLiteral("Latency Test"), 4, 4, 0));
+    QVERIFY(_mockJoystick->isValid());
+    _pumpEvents();
+    _discoveredJoysticks = JoystickSDL::discover();
+    JoystickSDL* js = _findJoystickByInstanceId(_mockJoystick->instanceId());
+    QVERIFY(js != nullptr);
+
+    // The rate is a persisted per-joystick setting, cleanup() puts it back
+    constexpr double kAxisFrequencyHz = 50.0;
+    _axisFrequencyFact = js->settings()->axisFrequencyHz();
+    _savedAxisFrequencyHz = _axisFrequencyFact->rawValue();
+    _axisFrequencyFact->setRawValue(kAxisFrequencyHz);
+    js->resetLatencyStatistics();
+
+    // Calibration polling sends nothing to a vehicle, so input must reach the channel values without being
+    // counted as input-to-wire latency
+    QSignalSpy channelSpy(js, &Joystick::rawChannelValuesChanged);
+    js->startConfiguration();
+    QVERIFY(js->isRunning());
+
+    constexpr int kSamples = 10;
+    for (int i = 0; i < kSamples; i++) {
+        QVERIFY(_mockJoystick->setAxis(0, (i % 2) ? 20000 : -20000));
+        _pumpEvents();
+        QTest::qWait(static_cast<int>(2000.0 / kAxisFrequencyHz));
+    }
+    QTRY_VERIFY_WITH_TIMEOUT(channelSpy.count() >= (kSamples / 2), TestTimeout::mediumMs());
+
+    js->stopConfiguration();
+    QVERIFY(!js->isRunning());
+    QCOMPARE(js->latencyHistogram().count(), 0ULL);
+
+    // A vehicle send consumes the oldest pending input timestamp exactly once
+    constexpr quint64 kInputAgeNs = 2000000;
+    js->_notifyInputEvent(js->_inputClockNs() - kInputAgeNs);
+    js->_notifyInputEvent(js->_inputClockNs());
+    js->_recordInputToWireLatency();
+    js->_recordInputToWireLatency();
+    QCOMPARE(js->latencyHistogram().count(), 1ULL);
+    QVERIFY(js->latencyHistogram().maxUs() >= (kInputAgeNs / 1000));
+    QCOMPARE(js->latencyStatistics().value(QStringLiteral("count")).toULongLong(), js->latencyHistogram().count());
+}
+
 UT_REGISTER_TEST(JoystickTest, TestLabel::Unit, TestLabel::Joystick)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtCore/QMap>
+#include <QtCore/QPointer>
+#include <QtCore/QVariant>
 
 #include <memory>
 
@@ -76,10 +78,16 @@ private slots:
     // Gamepad binding query tests
     void _gamepadBindingQueryTest();
 
+    // Control loop latency tests
+    void _latencyHistogramTest();
+    void _inputToWireLatencyTest();
+
 private:
     JoystickSDL* _findJoystickByInstanceId(int instanceId);
     void _pumpEvents();
 
     std::unique_ptr<MockJoystick> _mockJoystick;
     QMap<QString, Joystick*> _discoveredJoysticks;
+    QPointer<Fact> _axisFrequencyFact;
+    QVariant _savedAxisFrequencyHz;
 };
@@ -0,0 +1,279 @@
+#include "MAVLinkFrameTest.h"
+#include "MAVLinkFrame.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QList>
+#include <QtTest/QTest>
+
+#include <cmath>
+
+#include "Benchmarking.h"
+
+namespace {
+
+constexpr uint8_t kSystemId = 1;
+constexpr uint8_t kComponentId = MAV_COMP_ID_AUTOPILOT1;
+constexpr uint8_t kChannel = MAVLINK_COMM_0;
+
+void appendMessage(QByteArray &bytes, const mavlink_message_t &message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+    (void) bytes.append(reinterpret_cast<const char*>(buffer), len);
+}
+
+/// Telemetry at the usual stream rates: 50 Hz attitude, 10 Hz position and a 1 Hz heartbeat
+QByteArray telemetryStream(int seconds, QList<uint32_t> &msgIds)
+{
+    QByteArray bytes;
+    for (int tick = 0; tick < (seconds * 50); tick++) {
+        const uint32_t timeBootMs = static_cast<uint32_t>(tick * 20);
+        mavlink_message_t message;
+        (void) mavlink_msg_attitude_pack_chan(kSystemId, kComponentId, kChannel, &message, timeBootMs,
+                                              std::sin(tick * 0.01f), 0.1f, 0.2f, 0.f, 0.f, 0.f);
+        appendMessage(bytes, message);
+        msgIds.append(MAVLINK_MSG_ID_ATTITUDE);
+        if ((tick % 5) == 0) {
+            (void) mavlink_msg_global_position_int_pack_chan(kSystemId, kComponentId, kChannel, &message, timeBootMs,
+                                                             473977418 + tick, 85455939, 488000, 12500, 0, 0, 0, 9000);
+            appendMessage(bytes, message);
+            msgIds.append(MAVLINK_MSG_ID_GLOBAL_POSITION_INT);
+        }
+        if ((tick % 50) == 0) {
+            (void) mavlink_msg_heartbeat_pack_chan(kSystemId, kComponentId, kChannel, &message, MAV_TYPE_QUADROTOR,
+                                                   MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+            appendMessage(bytes, message);
+            msgIds.append(MAVLINK_MSG_ID_HEARTBEAT);
+        }
+    }
+    return bytes;
+}
+
+/// Stand-in for the previous Vehicle slot, which took the message by value
+Q_NEVER_INLINE uint32_t byValueHandler(mavlink_message_t message)
+{
+    return message.msgid + message.seq;
+}
+
+/// Stand-in for Vehicle::_mavlinkMessageReceived, which takes its own reference to the frame
+Q_NEVER_INLINE uint32_t frameHandler(const MAVLinkFrame &received)
+{
+    const MAVLinkFrame frame = received;
+    return frame->msgid + frame->seq;
+}
+
+/// Parses bytes the way MAVLinkProtocol::receiveBytes does, handing each frame to receiver
+template<typename Receiver>
+int parseIntoFrames(QByteArrayView bytes, Receiver receiver)
+{
+    mavlink_message_t rxMessage;
+    mavlink_status_t rxStatus{};
+    MAVLinkFrame frame = MAVLinkFrame::allocate();
+    mavlink_status_t status{};
+    int messages = 0;
+    for (const char byte : bytes) {
+        if (mavlink_frame_char_buffer(&rxMessage, &rxStatus, static_cast<uint8_t>(byte), &frame.detach(), &status) == MAVLINK_FRAMING_OK) {
+            receiver(frame);
+            messages++;
+            if (frame.isShared()) {
+                frame = MAVLinkFrame::allocate();
+            }
+        }
+    }
+    return messages;
+}
+
+} // namespace
+
+void MAVLinkFrameTest::_testPoolReuse()
+{
+    const mavlink_message_t *buffer = nullptr;
+    {
+        const MAVLinkFrame frame = MAVLinkFrame::allocate();
+        QVERIFY(!frame.isNull());
+        QVERIFY(!frame.isShared());
+        buffer = &frame.message();
+    }
+
+    // The released buffer is the first one handed out again
+    const MAVLinkFrame::Stats before = MAVLinkFrame::stats();
+    const MAVLinkFrame frame = MAVLinkFrame::allocate();
+    QCOMPARE(&frame.message(), buffer);
+    QCOMPARE(MAVLinkFrame::stats().allocations, before.allocations);
+    QCOMPARE(MAVLinkFrame::stats().reuses, before.reuses + 1);
+
+    const MAVLinkFrame null;
+    QVERIFY(null.isNull());
+    QVERIFY(!null.isShared());
+}
+
+void MAVLinkFrameTest::_testSharing()
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_heartbeat_pack_chan(kSystemId, kComponentId, kChannel, &message, MAV_TYPE_QUADROTOR,
+                                           MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+
+    const MAVLinkFrame::Stats before = MAVLinkFrame::stats();
+    MAVLinkFrame frame = MAVLinkFrame::fromMessage(message);
+    QCOMPARE(MAVLinkFrame::stats().bytesCopied, before.bytesCopied + sizeof(mavlink_message_t));
+    QCOMPARE(static_cast<uint32_t>(frame->msgid), static_cast<uint32_t>(MAVLINK_MSG_ID_HEARTBEAT));
+
+    // Copies, moves and assignments share the buffer without copying the message
+    MAVLinkFrame copy = frame;
+    QVERIFY(frame.isShared());
+    QVERIFY(copy.isShared());
+    QCOMPARE(&copy.message(), &frame.message());
+
+    MAVLinkFrame moved = std::move(copy);
+    QVERIFY(copy.isNull());
+    QCOMPARE(&moved.message(), &frame.message());
+
+    MAVLinkFrame assigned;
+    assigned = moved;
+    QCOMPARE(&assigned.message(), &frame.message());
+    QCOMPARE(MAVLinkFrame::stats().bytesCopied, before.bytesCopied + sizeof(mavlink_message_t));
+
+    moved = MAVLinkFrame();
+    assigned = MAVLinkFrame();
+    QVERIFY(!frame.isShared());
+}
+
+void MAVLinkFrameTest::_testDetach()
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_heartbeat_pack_chan(kSystemId, kComponentId, kChannel, &message, MAV_TYPE_QUADROTOR,
+                                           MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+    MAVLinkFrame frame = MAVLinkFrame::fromMessage(message);
+
+    // An unshared frame is written in place
+    MAVLinkFrame::Stats before = MAVLinkFrame::stats();
+    const mavlink_message_t *buffer = &frame.message();
+    QCOMPARE(&frame.detach(), buffer);
+    QCOMPARE(MAVLinkFrame::stats().bytesCopied, before.bytesCopied);
+
+    // A shared frame is copied first and the other reference keeps the original message
+    const MAVLinkFrame reader = frame;
+    before = MAVLinkFrame::stats();
+    mavlink_message_t &writable = frame.detach();
+    QVERIFY(&writable != buffer);
+    QCOMPARE(MAVLinkFrame::stats().bytesCopied, before.bytesCopied + sizeof(mavlink_message_t));
+    QVERIFY(!frame.isShared());
+    QVERIFY(!reader.isShared());
+
+    writable.compid = MAV_COMP_ID_CAMERA;
+    QCOMPARE(reader->compid, kComponentId);
+    QCOMPARE(frame->compid, static_cast<uint8_t>(MAV_COMP_ID_CAMERA));
+    QCOMPARE(static_cast<uint32_t>(frame->msgid), static_cast<uint32_t>(reader->msgid));
+    QCOMPARE(static_cast<uint16_t>(frame->checksum), static_cast<uint16_t>(reader->checksum));
+
+    // A null frame gets a buffer of its own
+    MAVLinkFrame null;
+    (void) null.detach();
+    QVERIFY(!null.isNull());
+}
+
+void MAVLinkFrameTest::_testParseIntoFrame()
+{
+    QList<uint32_t> msgIds;
+    const QByteArray bytes = telemetryStream(2, msgIds);
+
+    // Frames kept by a receiver must not be touched by the parser moving on to the next message
+    QList<MAVLinkFrame> kept;
+    const int messages = parseIntoFrames(bytes, [&kept](const MAVLinkFrame &frame) {
+        kept.append(frame);
+    });
+    QCOMPARE(messages, static_cast<int>(msgIds.count()));
+    QCOMPARE(kept.count(), msgIds.count());
+
+    for (qsizetype i = 0; i < kept.count(); i++) {
+        QCOMPARE(static_cast<uint32_t>(kept[i]->msgid), msgIds[i]);
+        QCOMPARE(kept[i]->sysid, kSystemId);
+        QVERIFY(!kept[i].isShared());
+        if (i > 0) {
+            QVERIFY(&kept[i].message() != &kept[i - 1].message());
+        }
+    }
+}
+
+void MAVLinkFrameTest::_benchmarkReceivePath()
+{
+    // A minute of telemetry through the parser and into one receiver
+    QList<uint32_t> msgIds;
+    const QByteArray bytes = telemetryStream(60, msgIds);
+    const int messageCount = static_cast<int>(msgIds.count());
+
+    const auto previousPath = [&bytes]() {
+        mavlink_message_t rxMessage;
+        mavlink_status_t rxStatus{};
+        uint32_t sum = 0;
+        for (const char byte : bytes) {
+            mavlink_message_t message{};
+            mavlink_status_t status{};
+            if (mavlink_frame_char_buffer(&rxMessage, &rxStatus, static_cast<uint8_t>(byte), &message, &status) == MAVLINK_FRAMING_OK) {
+                sum += byValueHandler(message);
+            }
+        }
+        return sum;
+    };
+
+    uint32_t frameSum = 0;
+    const auto framePath = [&bytes, &frameSum]() {
+        return parseIntoFrames(bytes, [&frameSum](const MAVLinkFrame &frame) {
+            frameSum += frameHandler(frame);
+        });
+    };
+
+    // Receivers such as queued handlers hold on to the most recent frames
+    QList<MAVLinkFrame> recent;
+    const auto keepingPath = [&bytes, &recent]() {
+        return parseIntoFrames(bytes, [&recent](const MAVLinkFrame &frame) {
+            recent.append(frame);
+            if (recent.count() > 16) {
+                recent.removeFirst();
+            }
+        });
+    };
+
+    // Warm the pool, after which neither receiver pattern allocates
+    QCOMPARE(keepingPath(), messageCount);
+    recent.clear();
+    MAVLinkFrame::resetStats();
+    QCOMPARE(framePath(), messageCount);
+    const MAVLinkFrame::Stats frameStats = MAVLinkFrame::stats();
+    MAVLinkFrame::resetStats();
+    QCOMPARE(keepingPath(), messageCount);
+    recent.clear();
+    const MAVLinkFrame::Stats keepingStats = MAVLinkFrame::stats();
+    QCOMPARE(frameStats.allocations, 0ULL);
+    QCOMPARE(frameStats.bytesCopied, 0ULL);
+    QCOMPARE(keepingStats.allocations, 0ULL);
+    QCOMPARE(keepingStats.bytesCopied, 0ULL);
+
+    // The parser's own copy out of its channel buffer happens once per message on every path
+    const qreal perMessage = 1.0 / messageCount;
+    qInfo().noquote() << QStringLiteral("previous path: 0 allocations, %1 bytes copied and %2 bytes zeroed per message")
+                             .arg(2 * sizeof(mavlink_message_t))
+                             .arg((sizeof(mavlink_message_t) + sizeof(mavlink_status_t)) * bytes.size() * perMessage, 0, 'f', 0);
+    qInfo().noquote() << QStringLiteral("frame path: %1 allocations, %2 bytes copied per message")
+                             .arg(frameStats.allocations * perMessage)
+                             .arg(sizeof(mavlink_message_t) + (frameStats.bytesCopied * perMessage));
+    qInfo().noquote() << QStringLiteral("frame path keeping 16 frames: %1 allocations, %2 bytes copied per message, %3 pool reuses")
+                             .arg(keepingStats.allocations * perMessage)
+                             .arg(sizeof(mavlink_message_t) + (keepingStats.bytesCopied * perMessage))
+                             .arg(keepingStats.reuses);
+
+    auto bench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    bench.batch(bytes.size()).unit("byte").relative(true);
+    bench.run("zeroed message per byte, handler by value (previous behavior)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(previousPath());
+    });
+    bench.run("pooled frame, handler by reference", [&] {
+        ankerl::nanobench::doNotOptimizeAway(framePath());
+    });
+    bench.run("pooled frame, receiver keeps the last 16 frames", [&] {
+        ankerl::nanobench::doNotOptimizeAway(keepingPath());
+    });
+    ankerl::nanobench::doNotOptimizeAway(frameSum);
+}
+
+UT_REGISTER_TEST(MAVLinkFrameTest, TestLabel::Unit)
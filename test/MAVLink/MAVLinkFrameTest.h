@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for MAVLinkFrame, the pooled message buffer shared along the receive path
+class MAVLinkFrameTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testPoolReuse();
+    void _testSharing();
+    void _testDetach();
+    void _testParseIntoFrame();
+    void _benchmarkReceivePath();
+};
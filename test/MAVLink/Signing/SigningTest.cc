@@ -4,6 +4,9 @@
 #include <QtCore/QRegularExpression>
 #include <QtTest/QTest>
 
+#include <vector>
+
+#include "Benchmarking.h"
 #include "MAVLinkLib.h"
 #include "MAVLinkSigning.h"
 #include "MAVLinkSigningKeys.h"
@@ -11,6 +14,38 @@
 #include "SigningChannel.h"
 #include "SigningController.h"
 
+namespace {
+
+QByteArray _benchKey()
+{
+    QByteArray rawKey(MAVLinkSigning::kSigningKeySize, '\0');
+    for (int i = 0; i < rawKey.size(); ++i) {
+        rawKey[i] = static_cast<char>(0x40 + i);
+    }
+    return rawKey;
+}
+
+/// Signed GLOBAL_POSITION_INT frames encoded through libmavlink's own signing path.
+std::vector<mavlink_message_t> _makeSignedBlock(QByteArrayView key, int count)
+{
+    std::vector<mavlink_message_t> messages(static_cast<size_t>(count));
+    SigningChannel ch;
+    if (!ch.init(MAVLINK_COMM_2, key, MAVLinkSigning::insecureConnectionAcceptUnsignedCallback)) {
+        return {};
+    }
+    for (int i = 0; i < count; ++i) {
+        mavlink_global_position_int_t position{};
+        position.time_boot_ms = static_cast<uint32_t>(i * 20);
+        position.lat = 473977420 + i;
+        position.lon = 85455940 - i;
+        (void)mavlink_msg_global_position_int_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_2, &messages[i], &position);
+    }
+    (void)ch.init(MAVLINK_COMM_2, QByteArrayView(), nullptr);
+    return messages;
+}
+
+}  // namespace
+
 void SigningTest::initTestCase()
 {
     UnitTest::initTestCase();
@@ -812,4 +847,58 @@ void SigningTest::_testKeyStorePersistRoundTrip()
     signingKeys->removeAllKeys();
 }
 
+void SigningTest::_testSignatureMatchesLibrary()
+{
+    const QByteArray rawKey = _benchKey();
+    const std::vector<mavlink_message_t> messages = _makeSignedBlock(rawKey, 4);
+    QCOMPARE(messages.size(), size_t{4});
+
+    for (const mavlink_message_t& message : messages) {
+        QVERIFY(MAVLinkSigning::isMessageSigned(message));
+        QVERIFY(MAVLinkSigning::verifySignature(rawKey, message));
+
+        // Re-signing with the same link_id/timestamp must reproduce libmavlink's signature byte for byte
+        uint64_t timestamp = 0;
+        memcpy(&timestamp, message.signature + 1, MAVLinkSigning::kSignaturePrefixBytes - 1);
+        mavlink_message_t resigned = message;
+        memset(resigned.signature, 0, sizeof(resigned.signature));
+        MAVLinkSigning::signMessage(rawKey, message.signature[0], timestamp, resigned);
+        QVERIFY(memcmp(resigned.signature, message.signature, MAVLINK_SIGNATURE_BLOCK_LEN) == 0);
+    }
+
+    QVERIFY(!MAVLinkSigning::verifySignature(QByteArray(MAVLinkSigning::kSigningKeySize, '\xFF'), messages.front()));
+    QVERIFY(!MAVLinkSigning::verifySignature(QByteArray(16, '\x01'), messages.front()));
+}
+
+void SigningTest::_testSerializeUnsignedMatchesCopy()
+{
+    const std::vector<mavlink_message_t> messages = _makeSignedBlock(_benchKey(), 1);
+    QCOMPARE(messages.size(), size_t{1});
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = MAVLinkSigning::serializeUnsigned(messages.front(), buffer);
+    const QByteArray copy = MAVLinkSigning::serializeUnsignedCopy(messages.front());
+    QCOMPARE(QByteArrayView(reinterpret_cast<const char*>(buffer), length), QByteArrayView(copy));
+}
+
+void SigningTest::_benchmarkSinkSerialization()
+{
+    const std::vector<mavlink_message_t> messages = _makeSignedBlock(_benchKey(), 1);
+    QCOMPARE(messages.size(), size_t{1});
+    const mavlink_message_t& message = messages.front();
+
+    // Forward + support-forward + log each re-serialized before; now one shared serialization
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true);
+    bench.run("3 sinks: serializeUnsignedCopy x3 (baseline)", [&] {
+        for (int i = 0; i < 3; ++i) {
+            ankerl::nanobench::doNotOptimizeAway(MAVLinkSigning::serializeUnsignedCopy(message));
+        }
+    });
+    bench.run("3 sinks: serializeUnsigned once", [&] {
+        ankerl::nanobench::doNotOptimizeAway(MAVLinkSigning::serializeUnsigned(message, buffer));
+    });
+}
+
 UT_REGISTER_TEST(SigningTest, TestLabel::Unit)
@@ -37,4 +37,9 @@ private slots:
     void _testRefreshOutgoingTimestamp();
     void _testSignOutgoingRefreshesCachedTimestamp();
     void _testKeyStorePersistRoundTrip();
+    void _testSignatureMatchesLibrary();
+    void _testSerializeUnsignedMatchesCopy();
+
+    // Benchmarks (nanobench)
+    void _benchmarkSinkSerialization();
 };
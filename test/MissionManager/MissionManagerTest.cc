@@ -1,5 +1,6 @@
 #include "MissionManagerTest.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QRegularExpression>
 #include <QtTest/QSignalSpy>
 #include <iterator>
@@ -303,6 +304,76 @@ void MissionManagerTest::_testErrorAckFailureStrings()
     }
 }
 
+void MissionManagerTest::_readWithWindow(int windowSize, int expectedCount, qint64& elapsedMSecs, int& requestCount)
+{
+    _missionManager->setReadWindowSize(windowSize);
+    _mockLink->clearReceivedMavlinkMessageCounts();
+    _multiSpyMissionManager->clearAllSignals();
+
+    QElapsedTimer transferTimer;
+    transferTimer.start();
+    _missionManager->loadFromVehicle();
+    QVERIFY(_missionManager->inProgress());
+    QVERIFY_WAIT_SIGNAL((*_multiSpyMissionManager), "newMissionItemsAvailable", _missionManagerSignalWaitTime);
+    elapsedMSecs = transferTimer.elapsed();
+    requestCount = _mockLink->receivedMavlinkMessageCount(MAVLINK_MSG_ID_MISSION_REQUEST_INT);
+
+    QVERIFY(!_multiSpyMissionManager->emitted("error"));
+    const QList<MissionItem*>& items = _missionManager->missionItems();
+    QCOMPARE(items.count(), expectedCount);
+    for (int i = 0; i < items.count(); i++) {
+        // Out of order arrival must still assemble in sequence order
+        QCOMPARE(items[i]->sequenceNumber(), i);
+        if (i > 0) {
+            QVERIFY(items[i]->param5() > items[i - 1]->param5());
+        }
+    }
+    _multiSpyMissionManager->clearAllSignals();
+}
+
+void MissionManagerTest::_testPipelinedReadLatencyAndLoss()
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    constexpr int kItemCount = 60;
+    constexpr int kLatencyMSecs = 15;
+    constexpr int kDropEveryNthItem = 13;
+    _mockLink->loadWaypointMission(kItemCount);
+    _mockLink->setMissionReadLinkConditions(kLatencyMSecs, kDropEveryNthItem);
+
+    qint64 sequentialMSecs = 0;
+    int sequentialRequests = 0;
+    _readWithWindow(1, kItemCount, sequentialMSecs, sequentialRequests);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    qint64 pipelinedMSecs = 0;
+    int pipelinedRequests = 0;
+    _readWithWindow(8, kItemCount, pipelinedMSecs, pipelinedRequests);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    qCDebug(UnitTestLog) << "Mission read" << kItemCount << "items, latency" << kLatencyMSecs << "ms, 1 in" << kDropEveryNthItem << "lost:"
+                         << "sequential" << sequentialMSecs << "ms" << sequentialRequests << "requests,"
+                         << "window 8" << pipelinedMSecs << "ms" << pipelinedRequests << "requests,"
+                         << "item timeout" << _missionManager->itemRequestTimeoutMSecs() << "ms";
+
+    // Every sequential round trip pays the full latency, so this holds regardless of machine speed
+    QVERIFY(sequentialMSecs >= kItemCount * kLatencyMSecs);
+    QVERIFY2(pipelinedMSecs < sequentialMSecs, qPrintable(QStringLiteral("%1 >= %2").arg(pipelinedMSecs).arg(sequentialMSecs)));
+
+    // Selective retries: only lost items are requested again, no restart of the whole sequence
+    QVERIFY(pipelinedRequests >= kItemCount);
+    QVERIFY(pipelinedRequests < (2 * kItemCount));
+
+    // The timeout adapted to the injected latency
+    QVERIFY(_missionManager->itemRequestTimeoutMSecs() >= kLatencyMSecs);
+
+    _missionManager->setReadWindowSize(0);
+}
+
 #include "UnitTest.h"
 
 UT_REGISTER_TEST(MissionManagerTest, TestLabel::Integration, TestLabel::MissionManager, TestLabel::Serial)
@@ -13,6 +13,7 @@ private slots:
     void _testReadFailureHandlingPX4();
     void _testReadFailureHandlingAPM();
     void _testErrorAckFailureStrings();
+    void _testPipelinedReadLatencyAndLoss();
 
 private:
     void _roundTripItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult,
@@ -21,6 +22,7 @@ private slots:
                      bool shouldFail);
     void _testWriteFailureHandlingWorker();
     void _testReadFailureHandlingWorker();
+    void _readWithWindow(int windowSize, int expectedCount, qint64& elapsedMSecs, int& requestCount);
 
     static const TestCase_t _rgTestCases[];
     static const size_t _cTestCases;
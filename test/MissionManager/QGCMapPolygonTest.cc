@@ -2,13 +2,18 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QRegularExpression>
+#include <QtPositioning/QGeoRectangle>
 
+#include "Benchmarking.h"
 #include "CoordFixtures.h"
 #include "UnitTestCoords.h"
 #include "MultiSignalSpy.h"
+#include "PlanViewSettings.h"
+#include "QGCGeo.h"
 #include "QGCMapPolygon.h"
 #include "QGCQGeoCoordinate.h"
 #include "QmlObjectListModel.h"
+#include "SettingsManager.h"
 
 QGCMapPolygonTest::QGCMapPolygonTest()
 {
@@ -158,7 +163,21 @@ void QGCMapPolygonTest::_testVertexManipulation()
 
 void QGCMapPolygonTest::_testKMLLoad()
 {
+    QVERIFY(_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonGood.kml"), 0 /* simplifyToleranceMeters */));
+    const int fullCount = _mapPolygon->count();
+    QVERIFY(_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonGood.kml"), 10000 /* simplifyToleranceMeters */));
+    QVERIFY(_mapPolygon->count() >= 3);
+    QVERIFY(_mapPolygon->count() <= fullCount);
+
+    // Without a tolerance the Plan View import setting is used
+    Fact* const toleranceFact = SettingsManager::instance()->planViewSettings()->importSimplifyTolerance();
+    const QVariant savedTolerance = toleranceFact->rawValue();
+    toleranceFact->setRawValue(10000);
     QVERIFY(_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonGood.kml")));
+    const int settingCount = _mapPolygon->count();
+    toleranceFact->setRawValue(savedTolerance);
+    QVERIFY(_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonGood.kml"), 10000 /* simplifyToleranceMeters */));
+    QCOMPARE(settingCount, _mapPolygon->count());
     expectAppMessage(QRegularExpression("KML file load failed.*PolygonBadXml"));
     QVERIFY(!_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonBadXml.kml")));
     verifyExpectedLogMessage();
@@ -313,6 +332,155 @@ void QGCMapPolygonTest::_testCenterDegenerate()
     QCOMPARE_COORDS(center, expectedCenter);
 }
 
+QList<QGeoCoordinate> QGCMapPolygonTest::_circle(int vertexCount, double radius)
+{
+    QList<QGeoCoordinate> circle;
+    circle.reserve(vertexCount);
+    for (int i = 0; i < vertexCount; i++) {
+        circle.append(TestFixtures::Coord::missionTestOrigin().atDistanceAndAzimuth(radius, (360.0 * i) / vertexCount));
+    }
+    return circle;
+}
+
+void QGCMapPolygonTest::_testLargePolygonHandles()
+{
+    const int vertexCount = QGCMapPolygon::maxVertexHandles * 4;
+    const QList<QGeoCoordinate> circle = _circle(vertexCount, 1000);
+    _mapPolygon->appendVertices(circle);
+    QCOMPARE(_mapPolygon->count(), vertexCount);
+    QCOMPARE(_mapPolygon->path().count(), vertexCount);
+    QCOMPARE(_mapPolygon->coordinateList(), circle);
+    QVERIFY(_mapPolygon->isValid());
+
+    // Too many vertices for a handle each and no region to pick them from yet
+    QCOMPARE(_pathModel->count(), 0);
+
+    // Only vertices inside the region get handles
+    const QGeoRectangle region(circle[0], 0.0005, 0.0005);
+    QList<int> expected;
+    for (int i = 0; i < circle.count(); i++) {
+        if (region.contains(circle[i])) {
+            expected.append(i);
+        }
+    }
+    QVERIFY(!expected.isEmpty());
+    QVERIFY(expected.count() < QGCMapPolygon::maxVertexHandles);
+
+    _mapPolygon->setDirty(false);
+    _multiSpyPolygon->clearAllSignals();
+    _mapPolygon->setHandleRegion(region);
+    QCoreApplication::processEvents();
+    QVERIFY2(_multiSpyPolygon->noneEmitted(), qPrintable(_multiSpyPolygon->summary()));
+    QVERIFY(!_mapPolygon->dirty());
+    QCOMPARE(_pathModel->count(), expected.count());
+    for (int i = 0; i < expected.count(); i++) {
+        QCOMPARE(_mapPolygon->handleVertex(i), expected[i]);
+        QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(i)->coordinate(), circle[expected[i]]);
+    }
+
+    // Edits go to the packed vertices and to the handle of the vertex
+    const int vertex = expected.last();
+    QGCQGeoCoordinate* handle = _pathModel->value<QGCQGeoCoordinate*>(expected.count() - 1);
+    const QGeoCoordinate moved = circle[vertex].atDistanceAndAzimuth(1, 90);
+    _mapPolygon->adjustVertex(vertex, moved);
+    QCOMPARE(handle->coordinate(), moved);
+    QCOMPARE(_mapPolygon->vertexCoordinate(vertex), moved);
+    QCOMPARE(_mapPolygon->path()[vertex].value<QGeoCoordinate>(), moved);
+    QVERIFY(_mapPolygon->dirty());
+    const int unhandledVertex = vertexCount / 2;
+    QVERIFY(!expected.contains(unhandledVertex));
+    _mapPolygon->adjustVertex(unhandledVertex, moved);
+    QCOMPARE(_mapPolygon->vertexCoordinate(unhandledVertex), moved);
+    QCOMPARE(_pathModel->count(), expected.count());
+
+    // Removing a vertex shifts the handles after it
+    _mapPolygon->removeVertex(0);
+    QCOMPARE(_mapPolygon->count(), vertexCount - 1);
+    QCOMPARE(_mapPolygon->path().count(), vertexCount - 1);
+    for (int i = 0; i < _pathModel->count(); i++) {
+        QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(i)->coordinate(), _mapPolygon->vertexCoordinate(_mapPolygon->handleVertex(i)));
+    }
+
+    // Splitting a segment outside the region keeps the existing handles, they are only renumbered
+    QList<QGCQGeoCoordinate*> handles;
+    QList<int> handleVertices;
+    for (int i = 0; i < _pathModel->count(); i++) {
+        handles.append(_pathModel->value<QGCQGeoCoordinate*>(i));
+        handleVertices.append(_mapPolygon->handleVertex(i));
+    }
+    const int splitVertex = _mapPolygon->count() / 2;
+    _mapPolygon->splitPolygonSegment(splitVertex);
+    QCOMPARE(_mapPolygon->count(), vertexCount);
+    QCOMPARE(_pathModel->count(), handles.count());
+    for (int i = 0; i < handles.count(); i++) {
+        QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(i), handles[i]);
+        QCOMPARE(_mapPolygon->handleVertex(i), handleVertices[i] + ((handleVertices[i] > splitVertex) ? 1 : 0));
+    }
+
+    // A vertex appended inside the region gets a handle of its own
+    const QGeoCoordinate inRegion = _mapPolygon->vertexCoordinate(_mapPolygon->handleVertex(0));
+    _mapPolygon->appendVertex(inRegion);
+    QCOMPARE(_mapPolygon->count(), vertexCount + 1);
+    QCOMPARE(_pathModel->count(), handles.count() + 1);
+    QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(0), handles[0]);
+    QCOMPARE(_mapPolygon->handleVertex(handles.count()), vertexCount);
+    QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(handles.count())->coordinate(), inRegion);
+
+    // Whole polygon in view is too dense to drag
+    _mapPolygon->setHandleRegion(QGeoRectangle(circle));
+    QCOMPARE(_pathModel->count(), 0);
+
+    // Small enough again, every vertex gets a handle
+    _mapPolygon->setPath(circle.mid(0, 100));
+    QCOMPARE(_mapPolygon->count(), 100);
+    QCOMPARE(_pathModel->count(), 100);
+    for (int i = 0; i < _pathModel->count(); i++) {
+        QCOMPARE(_mapPolygon->handleVertex(i), i);
+        QCOMPARE(_pathModel->value<QGCQGeoCoordinate*>(i)->coordinate(), circle[i]);
+    }
+}
+
+void QGCMapPolygonTest::_benchmarkLargePolygon()
+{
+    // Detailed survey boundary, 50k vertices about 0.6m apart
+    const QList<QGeoCoordinate> boundary = _circle(50000, 5000);
+
+    auto bench = qgc::bench::ciConfig().epochs(5).minEpochIterations(1);
+
+    bench.run("import 50k vertices", [&] {
+        _mapPolygon->beginReset();
+        _mapPolygon->clear();
+        _mapPolygon->appendVertices(boundary);
+        _mapPolygon->endReset();
+        QCoreApplication::processEvents();
+        ankerl::nanobench::doNotOptimizeAway(_mapPolygon->path().count());
+    });
+    QCOMPARE(_mapPolygon->count(), boundary.count());
+    QCOMPARE(_pathModel->count(), 0);
+
+    int vertex = 0;
+    bench.run("edit vertex of 50k", [&] {
+        _mapPolygon->adjustVertex(vertex, boundary[vertex].atDistanceAndAzimuth(1, 90));
+        QCoreApplication::processEvents();
+        ankerl::nanobench::doNotOptimizeAway(_mapPolygon->center());
+        vertex = (vertex + 7919) % boundary.count();
+    });
+
+    bench.run("handle region of 50k", [&] {
+        _mapPolygon->setHandleRegion(QGeoRectangle(boundary[vertex], 0.001, 0.001));
+        ankerl::nanobench::doNotOptimizeAway(_pathModel->count());
+        vertex = (vertex + 7919) % boundary.count();
+    });
+
+    QList<QGeoCoordinate> simplified;
+    bench.run("simplify 50k at 1m", [&] {
+        simplified = QGCGeo::simplifyPath(boundary, 1.0, true /* closed */);
+        ankerl::nanobench::doNotOptimizeAway(simplified.count());
+    });
+    QVERIFY(simplified.count() >= 3);
+    QVERIFY(simplified.count() < boundary.count() / 10);
+}
+
 #include "UnitTest.h"
 
 UT_REGISTER_TEST(QGCMapPolygonTest, TestLabel::Unit, TestLabel::MissionManager)
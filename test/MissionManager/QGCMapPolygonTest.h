@@ -28,8 +28,14 @@ private slots:
     void _testCenterRectangle();
     void _testCenterExtraVertex();
     void _testCenterDegenerate();
+    void _testLargePolygonHandles();
+
+    // Benchmarks (nanobench)
+    void _benchmarkLargePolygon();
 
 private:
+    static QList<QGeoCoordinate> _circle(int vertexCount, double radius);
+
     std::unique_ptr<MultiSignalSpy> _multiSpyPolygon;
     std::unique_ptr<MultiSignalSpy> _multiSpyModel;
     QGCMapPolygon* _mapPolygon = nullptr;
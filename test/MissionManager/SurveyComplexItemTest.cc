@@ -1,14 +1,18 @@
 #include "SurveyComplexItemTest.h"
 
+#include "Benchmarking.h"
 #include "CoordFixtures.h"
 #include "MultiSignalSpy.h"
 #include "PlanViewSettings.h"
 #include "SurveyComplexItem.h"
+#include "SurveyTransectGenerator.h"
 #include "TransectStyleComplexItem.h"
 
 #include <QtCore/QRegularExpression>
 #include <QtTest/QSignalSpy>
 
+#include <cmath>
+
 SurveyComplexItemTest::SurveyComplexItemTest()
 {
     // We use a 100m by 100m square test polygon
@@ -336,4 +340,109 @@ void SurveyComplexItemTest::_testMaxTransectCount()
     }
 }
 
+void SurveyComplexItemTest::_testTransectPreviewWhileDragging()
+{
+    // 1m spacing over the 100m square gives more transects than the preview cap
+    _surveyItem->cameraCalc()->adjustedFootprintSide()->setRawValue(1.0);
+    const int fullTransectCount = _surveyItem->_transectCount();
+    QVERIFY(fullTransectCount > SurveyComplexItem::previewTransectCount);
+
+    QSignalSpy visualSpy(_surveyItem, &TransectStyleComplexItem::visualTransectPointsChanged);
+    _mapPolygon->setVertexDrag(true);
+    _mapPolygon->adjustVertex(2, _polyVertices[2].atDistanceAndAzimuth(20, 135));
+    QTRY_VERIFY_WITH_TIMEOUT(visualSpy.count() > 0, TestTimeout::mediumMs());
+
+    // Preview only touches the visuals and is generated at the coarse spacing
+    QCOMPARE(_surveyItem->_transectCount(), fullTransectCount);
+    const int previewPointCount = _surveyItem->visualTransectPoints().count();
+    QVERIFY(previewPointCount > 0);
+    QVERIFY(previewPointCount <= 2 * SurveyComplexItem::previewTransectCount);
+
+    // Drag end rebuilds at full resolution synchronously
+    _mapPolygon->setVertexDrag(false);
+    QVERIFY(_surveyItem->_transectCount() > SurveyComplexItem::previewTransectCount);
+    QVERIFY(_surveyItem->visualTransectPoints().count() > previewPointCount);
+}
+
+void SurveyComplexItemTest::_testStaleTransectPreviewDropped()
+{
+    _surveyItem->cameraCalc()->adjustedFootprintSide()->setRawValue(1.0);
+
+    // Start a preview and end the drag before its result is delivered. The full rebuild bumps the
+    // generation so the in-flight preview must not overwrite the full resolution visuals.
+    _mapPolygon->setVertexDrag(true);
+    emit _mapPolygon->dragPathChanged();
+    _mapPolygon->setVertexDrag(false);
+    const QVariantList fullVisuals = _surveyItem->visualTransectPoints();
+
+    QSignalSpy visualSpy(_surveyItem, &TransectStyleComplexItem::visualTransectPointsChanged);
+    QTest::qWait(TestTimeout::shortMs());
+    QCOMPARE(visualSpy.count(), 0);
+    QCOMPARE(_surveyItem->visualTransectPoints(), fullVisuals);
+}
+
+void SurveyComplexItemTest::_testTransectGeneratorAllocationFree()
+{
+    SurveyTransectGenerator::Workspace workspace;
+    SurveyTransectGenerator::setPolygon(_polyVertices, workspace);
+    QVERIFY(SurveyTransectGenerator::generate(0, 5, TransectStyleComplexItem::maxTransectCount, workspace));
+    QVERIFY(workspace.transects.size() > 2);
+
+    // Same spacing/angle reuses the buffers: no reallocation and identical output
+    const std::vector<QLineF> firstPass = workspace.transects;
+    const QLineF* const buffer = workspace.transects.data();
+    const size_t capacity = workspace.transects.capacity();
+    QVERIFY(SurveyTransectGenerator::generate(0, 5, TransectStyleComplexItem::maxTransectCount, workspace));
+    QCOMPARE(workspace.transects.data(), buffer);
+    QCOMPARE(workspace.transects.capacity(), capacity);
+    QVERIFY(workspace.transects == firstPass);
+
+    // All transects point the same direction
+    for (const QLineF& line : workspace.transects) {
+        QVERIFY(qAbs(line.angle() - workspace.transects.front().angle()) <= 1.0);
+    }
+}
+
+void SurveyComplexItemTest::_benchmarkTransectGeneration()
+{
+    // 50 km² square survey area
+    const double edgeDistance = std::sqrt(50.0 * 1000.0 * 1000.0);
+    QList<QGeoCoordinate> vertices;
+    vertices.append(TestFixtures::Coord::missionTestOrigin());
+    vertices.append(vertices[0].atDistanceAndAzimuth(edgeDistance, 90));
+    vertices.append(vertices[1].atDistanceAndAzimuth(edgeDistance, 180));
+    vertices.append(vertices[2].atDistanceAndAzimuth(edgeDistance, -90.0));
+    const double gridSpacing = 12;  // ~830 sweep lines, just under maxTransectCount
+
+    SurveyTransectGenerator::Workspace workspace;
+    SurveyTransectGenerator::setPolygon(vertices, workspace);
+    QVERIFY(SurveyTransectGenerator::generate(30, gridSpacing, TransectStyleComplexItem::maxTransectCount, workspace));
+    QVERIFY(!workspace.spacingRaised);
+    const size_t fullCount = workspace.transects.size();
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true);
+
+    bench.run("generate: full spacing", [&] {
+        (void) SurveyTransectGenerator::generate(30, gridSpacing, TransectStyleComplexItem::maxTransectCount, workspace);
+        ankerl::nanobench::doNotOptimizeAway(workspace.transects.size());
+    });
+    bench.run("generate: drag preview spacing", [&] {
+        (void) SurveyTransectGenerator::generate(30, gridSpacing, SurveyComplexItem::previewTransectCount, workspace);
+        ankerl::nanobench::doNotOptimizeAway(workspace.transects.size());
+    });
+
+    _mapPolygon->clear();
+    _mapPolygon->appendVertices(vertices);
+    _surveyItem->cameraCalc()->adjustedFootprintSide()->setRawValue(gridSpacing);
+    double gridAngle = 30;
+    bench.run("SurveyComplexItem rebuild", [&] {
+        gridAngle = (gridAngle == 30) ? 31 : 30;
+        _surveyItem->gridAngle()->setRawValue(gridAngle);
+        ankerl::nanobench::doNotOptimizeAway(_surveyItem->_transectCount());
+    });
+
+    QVERIFY(fullCount > static_cast<size_t>(SurveyComplexItem::previewTransectCount));
+}
+
 UT_REGISTER_TEST(SurveyComplexItemTest, TestLabel::Unit, TestLabel::MissionManager)
@@ -30,6 +30,12 @@ private slots:
     void _testItemCount();
     void _testHoverCaptureItemGeneration();
     void _testMaxTransectCount();
+    void _testTransectPreviewWhileDragging();
+    void _testStaleTransectPreviewDropped();
+    void _testTransectGeneratorAllocationFree();
+
+    // Benchmarks (nanobench)
+    void _benchmarkTransectGeneration();
 
 private:
     double _clampGridAngle180(double gridAngle);
@@ -0,0 +1,336 @@
+#include "KMLOverlayIndexTest.h"
+#include "KMLOverlayIndex.h"
+#include "KMLOverlayManager.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/QGeoRectangle>
+#include <QtTest/QSignalSpy>
+
+#include <cmath>
+
+#include "Benchmarking.h"
+
+namespace {
+
+const QGeoCoordinate kOrigin(47.3977419, 8.5455938);
+
+QByteArray _kmlDocument(const QByteArray &placemarks)
+{
+    return QByteArrayLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                             "<kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document><Folder>\n") +
+           placemarks +
+           QByteArrayLiteral("</Folder></Document></kml>\n");
+}
+
+QByteArray _coordinates(const QList<QGeoCoordinate> &path)
+{
+    QByteArray text;
+    for (const QGeoCoordinate &coord : path) {
+        text += QByteArray::number(coord.longitude(), 'f', 7) + ',' + QByteArray::number(coord.latitude(), 'f', 7) + ",0 ";
+    }
+    return text;
+}
+
+/// Wiggly line starting at @p start heading east: 10 m steps with a small zig-zag every 4 points
+QList<QGeoCoordinate> _wiggle(const QGeoCoordinate &start, int count)
+{
+    QList<QGeoCoordinate> path;
+    path.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const double north = ((i / 4) % 2) ? 3.0 : 0.0;
+        path.append(start.atDistanceAndAzimuth(i * 10.0, 90.0).atDistanceAndAzimuth(north, 0.0));
+    }
+    return path;
+}
+
+/// Synthetic powerline style overlay: @p lineCount lines on a grid, 1 km apart, each with @p pointsPerLine points
+QByteArray _syntheticKml(int lineCount, int pointsPerLine)
+{
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(lineCount))));
+    QByteArray placemarks;
+    for (int i = 0; i < lineCount; i++) {
+        const QGeoCoordinate start = kOrigin.atDistanceAndAzimuth((i / columns) * 1000.0, 180.0).atDistanceAndAzimuth((i % columns) * 1000.0, 90.0);
+        placemarks += "<Placemark><name>Line " + QByteArray::number(i) + "</name><LineString><coordinates>" +
+                      _coordinates(_wiggle(start, pointsPerLine)) + "</coordinates></LineString></Placemark>\n";
+    }
+    return _kmlDocument(placemarks);
+}
+
+bool _loadKml(KMLOverlayIndex &index, const QByteArray &kml)
+{
+    QBuffer buffer;
+    buffer.setData(kml);
+    if (!buffer.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QString errorString;
+    const bool success = index.loadKml(&buffer, errorString);
+    index.build();
+    return success;
+}
+
+} // namespace
+
+void KMLOverlayIndexTest::_testStreamParse()
+{
+    const QGeoCoordinate pointA = kOrigin.atDistanceAndAzimuth(100, 0);
+    const QGeoCoordinate pointB = kOrigin.atDistanceAndAzimuth(100, 90);
+    const QGeoCoordinate pointC = kOrigin.atDistanceAndAzimuth(100, 180);
+    const QGeoCoordinate pointD = kOrigin.atDistanceAndAzimuth(100, 270);
+
+    const QByteArray kml = _kmlDocument(
+        "<Placemark><name>Line</name><LineString><coordinates>" + _coordinates({ pointA, pointB }) + "</coordinates></LineString></Placemark>\n"
+        "<Placemark><name>Area</name><Polygon>"
+            "<outerBoundaryIs><LinearRing><coordinates>" + _coordinates({ pointA, pointB, pointC, pointD, pointA }) + "</coordinates></LinearRing></outerBoundaryIs>"
+            "<innerBoundaryIs><LinearRing><coordinates>" + _coordinates({ kOrigin, pointB, pointC, kOrigin }) + "</coordinates></LinearRing></innerBoundaryIs>"
+        "</Polygon></Placemark>\n"
+        "<Placemark><name>Home</name><Point><coordinates>" + _coordinates({ kOrigin }) + "</coordinates></Point></Placemark>\n"
+        "<Placemark><Point><coordinates>" + _coordinates({ pointA }) + "</coordinates></Point></Placemark>\n"
+        "<Placemark><name>Pair</name><MultiGeometry>"
+            "<LineString><coordinates>" + _coordinates({ pointA, pointC }) + "</coordinates></LineString>"
+            "<LineString><coordinates>" + _coordinates({ pointB, pointD }) + "</coordinates></LineString>"
+        "</MultiGeometry></Placemark>\n");
+
+    KMLOverlayIndex index;
+    QVERIFY(_loadKml(index, kml));
+
+    // Unnamed point is not a label, inner boundary is ignored
+    QCOMPARE(index.count(), 5);
+    QCOMPARE(index.type(0), KMLOverlayIndex::FeatureType::Polyline);
+    QCOMPARE(index.path(0, 0).count(), 2);
+
+    QCOMPARE(index.type(1), KMLOverlayIndex::FeatureType::Polygon);
+    QCOMPARE(index.path(1, 0).count(), 4);
+    QVERIFY(index.path(1, 0).first().distanceTo(pointA) < 0.01);
+
+    QCOMPARE(index.type(2), KMLOverlayIndex::FeatureType::Label);
+    QCOMPARE(index.text(2), QStringLiteral("Home"));
+    QVERIFY(index.path(2, 0).first().distanceTo(kOrigin) < 0.01);
+
+    QCOMPARE(index.type(3), KMLOverlayIndex::FeatureType::Polyline);
+    QCOMPARE(index.type(4), KMLOverlayIndex::FeatureType::Polyline);
+    QCOMPARE(index.pointCount(), 2 + 4 + 1 + 2 + 2);
+}
+
+void KMLOverlayIndexTest::_testMalformed()
+{
+    const QByteArray kml = _kmlDocument("<Placemark><name>Line</name><LineString><coordinates>8.5,47.3,0 8.6,47.4,0</coordinates></LineString></Placemark>\n");
+
+    KMLOverlayIndex index;
+    QBuffer buffer;
+    buffer.setData(kml.left(kml.size() - 20));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QString errorString;
+    QVERIFY(!index.loadKml(&buffer, errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void KMLOverlayIndexTest::_testQueryMatchesBruteForce()
+{
+    // Enough features for a few levels of R-tree
+    constexpr int kLineCount = 1500;
+    KMLOverlayIndex index;
+    QVERIFY(_loadKml(index, _syntheticKml(kLineCount, 20)));
+    QCOMPARE(index.count(), kLineCount);
+
+    QCOMPARE(index.query(QGeoRectangle()).count(), kLineCount);
+
+    const QList<QGeoRectangle> viewports = {
+        QGeoRectangle(kOrigin.atDistanceAndAzimuth(100, 315), kOrigin.atDistanceAndAzimuth(2000, 135)),
+        QGeoRectangle(kOrigin.atDistanceAndAzimuth(15000, 160), kOrigin.atDistanceAndAzimuth(22000, 135)),
+        QGeoRectangle(kOrigin.atDistanceAndAzimuth(50000, 90), kOrigin.atDistanceAndAzimuth(60000, 100)),
+    };
+    for (const QGeoRectangle &viewport : viewports) {
+        // Same rule as the index: the viewport grown by half its size on every side
+        const QGeoRectangle grown(QGeoCoordinate(viewport.topLeft().latitude() + (viewport.height() / 2), viewport.topLeft().longitude() - (viewport.width() / 2)),
+                                  QGeoCoordinate(viewport.bottomRight().latitude() - (viewport.height() / 2), viewport.bottomRight().longitude() + (viewport.width() / 2)));
+        QList<int> expected;
+        for (int i = 0; i < index.count(); i++) {
+            QGeoRectangle bounds(index.path(i, 0));
+            if (grown.intersects(bounds)) {
+                expected.append(i);
+            }
+        }
+        QCOMPARE(index.query(viewport), expected);
+    }
+
+    // A viewport across the antimeridian sees features on both sides
+    KMLOverlayIndex dateLine;
+    dateLine.addFeature(KMLOverlayIndex::FeatureType::Label, { QGeoCoordinate(10, 179.9) }, QStringLiteral("East"));
+    dateLine.addFeature(KMLOverlayIndex::FeatureType::Label, { QGeoCoordinate(10, -179.9) }, QStringLiteral("West"));
+    dateLine.addFeature(KMLOverlayIndex::FeatureType::Label, { QGeoCoordinate(10, 0) }, QStringLiteral("Greenwich"));
+    dateLine.build();
+    QCOMPARE(dateLine.query(QGeoRectangle(QGeoCoordinate(11, 179.5), QGeoCoordinate(9, -179.5))), QList<int>({ 0, 1 }));
+}
+
+void KMLOverlayIndexTest::_testLevels()
+{
+    KMLOverlayIndex index;
+    index.addFeature(KMLOverlayIndex::FeatureType::Polyline, _wiggle(kOrigin, 2000));
+    index.addFeature(KMLOverlayIndex::FeatureType::Polygon, { kOrigin, kOrigin.atDistanceAndAzimuth(1, 0), kOrigin.atDistanceAndAzimuth(1, 90) });
+    index.build();
+
+    // Coarser levels never hold more points and keep both ends of the line
+    qsizetype previousCount = index.path(0, 0).count();
+    QCOMPARE(previousCount, 2000);
+    for (int level = 1; level < KMLOverlayIndex::kLevelCount; level++) {
+        const QList<QGeoCoordinate> &path = index.path(0, level);
+        QVERIFY(path.count() <= previousCount);
+        QCOMPARE(path.first(), index.path(0, 0).first());
+        QCOMPARE(path.last(), index.path(0, 0).last());
+        previousCount = path.count();
+    }
+    QVERIFY(index.path(0, KMLOverlayIndex::kLevelCount - 1).count() < 10);
+
+    // The 1 m triangle is below a pixel at coarse levels
+    QCOMPARE(index.query(QGeoRectangle(), 0), QList<int>({ 0, 1 }));
+    QCOMPARE(index.query(QGeoRectangle(), 1), QList<int>({ 0 }));
+
+    int previousLevel = KMLOverlayIndex::kLevelCount - 1;
+    for (double zoom = 0; zoom <= 22; zoom += 1) {
+        const int level = KMLOverlayIndex::levelForZoom(zoom, kOrigin.latitude());
+        QVERIFY(level <= previousLevel);
+        previousLevel = level;
+    }
+    QCOMPARE(KMLOverlayIndex::levelForZoom(20, kOrigin.latitude()), 0);
+    QCOMPARE(KMLOverlayIndex::levelForZoom(2, kOrigin.latitude()), KMLOverlayIndex::kLevelCount - 1);
+}
+
+void KMLOverlayIndexTest::_testManagerViewport()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("Overlay.kml"));
+    {
+        QFile kmlFile(file);
+        QVERIFY(kmlFile.open(QIODevice::WriteOnly));
+        QVERIFY(kmlFile.write(_syntheticKml(400, 50)) > 0);
+    }
+
+    KMLOverlayManager manager;
+    QSignalSpy loadSpy(&manager, &KMLOverlayManager::loadComplete);
+    QVERIFY(manager.loadKML(file));
+    QVERIFY(manager.loading());
+    QVERIFY(UnitTest::waitForSignal(loadSpy, TestTimeout::longMs(), QStringLiteral("loadComplete")));
+    QVERIFY(loadSpy.first().first().toBool());
+    QVERIFY(!manager.loading());
+
+    manager.setViewport(20, QGeoShape());
+    QCOMPARE(manager.polylines().count(), 400);
+    const int fullPointCount = manager.visiblePointCount();
+    QCOMPARE(fullPointCount, 400 * 50);
+
+    // Zoomed in on a corner only the nearby lines are handed to the map
+    const QGeoRectangle viewport(kOrigin.atDistanceAndAzimuth(200, 315), kOrigin.atDistanceAndAzimuth(1500, 135));
+    manager.setViewport(16, viewport);
+    QVERIFY(manager.polylines().count() > 0);
+    QVERIFY(manager.polylines().count() < 20);
+
+    // Panning a little keeps the same lines and does not rebuild the map items
+    QSignalSpy polylinesSpy(&manager, &KMLOverlayManager::polylinesChanged);
+    manager.setViewport(16, QGeoRectangle(viewport.topLeft().atDistanceAndAzimuth(10, 90), viewport.bottomRight().atDistanceAndAzimuth(10, 90)));
+    QCOMPARE(polylinesSpy.count(), 0);
+
+    // Zoomed out the lines are simplified
+    manager.setViewport(8, QGeoShape());
+    QCOMPARE(polylinesSpy.count(), 1);
+    QVERIFY(manager.visiblePointCount() < (fullPointCount / 4));
+
+    manager.clearAll();
+    QCOMPARE(manager.polylines().count(), 0);
+    QCOMPARE(manager.visiblePointCount(), 0);
+}
+
+void KMLOverlayIndexTest::_testManagerRejectsBadFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString textFile = dir.filePath(QStringLiteral("Overlay.txt"));
+    const QString shpFile = dir.filePath(QStringLiteral("Overlay.shp"));
+    for (const QString& file : { textFile, shpFile }) {
+        QFile badFile(file);
+        QVERIFY(badFile.open(QIODevice::WriteOnly));
+        QVERIFY(badFile.write("not a shape") > 0);
+    }
+
+    KMLOverlayManager manager;
+    QSignalSpy loadSpy(&manager, &KMLOverlayManager::loadComplete);
+
+    // Missing, unsupported and unusable SHP (no .prj) files fail right away and never start a load
+    expectLogMessage("QMLControls.KMLOverlayManager", QtWarningMsg, QRegularExpression("Not a readable KML/SHP file"));
+    QVERIFY(!manager.loadKML(dir.filePath(QStringLiteral("Missing.kml"))));
+    verifyExpectedLogMessage();
+    QVERIFY(!manager.loading());
+
+    expectLogMessage("QMLControls.KMLOverlayManager", QtWarningMsg, QRegularExpression("Not a readable KML/SHP file"));
+    QVERIFY(!manager.loadKML(textFile));
+    verifyExpectedLogMessage();
+    QVERIFY(!manager.loading());
+
+    expectLogMessage("QMLControls.KMLOverlayManager", QtWarningMsg, QRegularExpression("Failed to load"));
+    QVERIFY(!manager.loadKML(shpFile));
+    verifyExpectedLogMessage();
+    QVERIFY(!manager.loading());
+
+    QVERIFY_NO_SIGNAL_WAIT(loadSpy, 200);
+}
+
+void KMLOverlayIndexTest::_benchmarkLargeOverlay()
+{
+    // ~500k points, the size of a regional powerline overlay
+    const QByteArray kml = _syntheticKml(1000, 500);
+
+    auto loadBench = qgc::bench::ciConfig().epochs(3).minEpochIterations(1);
+    loadBench.run("stream parse, simplify and index 500k points", [&] {
+        KMLOverlayIndex index;
+        (void) _loadKml(index, kml);
+        ankerl::nanobench::doNotOptimizeAway(index.count());
+    });
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString file = dir.filePath(QStringLiteral("Large.kml"));
+    {
+        QFile kmlFile(file);
+        QVERIFY(kmlFile.open(QIODevice::WriteOnly));
+        QVERIFY(kmlFile.write(kml) > 0);
+    }
+    KMLOverlayManager manager;
+    QSignalSpy loadSpy(&manager, &KMLOverlayManager::loadComplete);
+    QVERIFY(manager.loadKML(file));
+    QVERIFY(UnitTest::waitForSignal(loadSpy, TestTimeout::longMs(), QStringLiteral("loadComplete")));
+
+    // Each setViewport() is one debounced map pan: a 3 x 2 km view moving east across the grid
+    int step = 0;
+    auto panViewport = [&step]() {
+        const QGeoCoordinate topLeft = kOrigin.atDistanceAndAzimuth((step % 300) * 100.0, 90.0).atDistanceAndAzimuth(((step / 300) % 30) * 1000.0, 180.0);
+        step++;
+        return QGeoRectangle(topLeft, topLeft.atDistanceAndAzimuth(3000, 90).atDistanceAndAzimuth(2000, 180));
+    };
+
+    // The previous implementation handed every feature at full detail to the map, the map items then had to be
+    // rebuilt and drawn for every frame of a pan
+    auto panBench = qgc::bench::ciConfig();
+    panBench.relative(true);
+    int zoom = 0;
+    panBench.run("whole overlay at full detail (previous behavior)", [&] {
+        manager.setViewport(20 + (zoom++ % 2), QGeoShape());
+        ankerl::nanobench::doNotOptimizeAway(manager.visiblePointCount());
+    });
+    const int fullPointCount = manager.visiblePointCount();
+    panBench.run("pan: viewport at zoom 16", [&] {
+        manager.setViewport(16, panViewport());
+        ankerl::nanobench::doNotOptimizeAway(manager.visiblePointCount());
+    });
+    QVERIFY(manager.visiblePointCount() < (fullPointCount / 20));
+    panBench.run("pan: viewport at zoom 12", [&] {
+        manager.setViewport(12, panViewport());
+        ankerl::nanobench::doNotOptimizeAway(manager.visiblePointCount());
+    });
+    QVERIFY(manager.visiblePointCount() < (fullPointCount / 20));
+}
+
+UT_REGISTER_TEST(KMLOverlayIndexTest, TestLabel::Unit)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for KMLOverlayIndex and the viewport culling of KMLOverlayManager
+class KMLOverlayIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testStreamParse();
+    void _testMalformed();
+    void _testQueryMatchesBruteForce();
+    void _testLevels();
+    void _testManagerViewport();
+    void _testManagerRejectsBadFile();
+    void _benchmarkLargeOverlay();
+};
@@ -0,0 +1,220 @@
+#include "ParameterSearchIndexTest.h"
+#include "Benchmarking.h"
+#include "Fact.h"
+#include "FactMetaData.h"
+#include "ParameterSearchIndex.h"
+
+#include <QtCore/QRegularExpression>
+#include <QtTest/QTest>
+
+#include <vector>
+
+namespace {
+
+struct SyntheticParameters
+{
+    QObject owner;
+    std::vector<Fact*> facts;
+    ParameterSearchIndex index;
+
+    Fact *add(const QString &name, const QString &shortDescription, const QString &longDescription = QString())
+    {
+        FactMetaData *const metaData = new FactMetaData(FactMetaData::valueTypeInt32, name, &owner);
+        metaData->setShortDescription(shortDescription);
+        metaData->setLongDescription(longDescription);
+
+        Fact *const fact = new Fact(1, name, FactMetaData::valueTypeInt32, &owner);
+        fact->setMetaData(metaData);
+        facts.push_back(fact);
+        (void) index.addFact(fact);
+        return fact;
+    }
+
+    /// Parameter set shaped like a large multi-component ArduPilot system
+    void addSynthetic(int count)
+    {
+        static const QStringList prefixes = { "BATT", "SERVO", "GPS", "EK3_SRC", "ATC_RAT_PIT", "INS_ACC", "COMPASS", "RC", "FLTMODE", "MOT_THST" };
+        static const QStringList subjects = { "battery monitor", "servo output", "GPS receiver", "EKF source", "pitch rate controller",
+                                              "accelerometer", "compass", "RC input channel", "flight mode", "motor thrust" };
+        static const QStringList suffixes = { "_P", "_I", "_D", "_MAX", "_MIN", "_ENABLE", "_TYPE", "_RATE", "_OFFSET", "_FUNCTION" };
+
+        for (int i = 0; i < count; i++) {
+            const int group = i % prefixes.size();
+            const QString name = QStringLiteral("%1%2%3").arg(prefixes[group]).arg(i / 100 + 1).arg(suffixes[(i / prefixes.size()) % suffixes.size()]);
+            (void) add(name,
+                       QStringLiteral("%1 %2 setting").arg(subjects[group]).arg(i / 100 + 1),
+                       QStringLiteral("Configures the %1. Values outside the documented range are clamped, changes take effect after a reboot.")
+                           .arg(subjects[group]));
+        }
+    }
+
+    QStringList names(const QList<int> &entries) const
+    {
+        QStringList result;
+        for (const int entry : entries) {
+            result.append(index.fact(entry)->name());
+        }
+        return result;
+    }
+};
+
+/// The search the parameter editor ran before the index: a regular expression per term over every fact
+QList<int> scanSearch(const std::vector<Fact*> &facts, const QStringList &terms)
+{
+    QList<QRegularExpression> regexList;
+    for (const QString &term : terms) {
+        regexList.append(QRegularExpression(term, QRegularExpression::CaseInsensitiveOption));
+    }
+
+    QList<int> result;
+    for (int entry = 0; entry < static_cast<int>(facts.size()); entry++) {
+        const Fact *const fact = facts[entry];
+        bool matched = true;
+        for (const QRegularExpression &re : std::as_const(regexList)) {
+            if (!fact->name().contains(re) && !fact->shortDescription().contains(re) && !fact->longDescription().contains(re)) {
+                matched = false;
+                break;
+            }
+        }
+        if (matched) {
+            result.append(entry);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void ParameterSearchIndexTest::_plainTextSearch()
+{
+    SyntheticParameters parameters;
+    (void) parameters.add(QStringLiteral("BATT_CAPACITY"), QStringLiteral("Battery capacity"));
+    (void) parameters.add(QStringLiteral("BATT_MONITOR"), QStringLiteral("Battery monitoring"), QStringLiteral("Controls enabling monitoring"));
+    (void) parameters.add(QStringLiteral("SERVO1_FUNCTION"), QStringLiteral("Servo output function"));
+
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("batt") })),
+             QStringList({ QStringLiteral("BATT_CAPACITY"), QStringLiteral("BATT_MONITOR") }));
+    // Case insensitive, matches descriptions, all terms must match
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("MONITORING"), QStringLiteral("battery") })),
+             QStringList({ QStringLiteral("BATT_MONITOR") }));
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("enabling") })), QStringList({ QStringLiteral("BATT_MONITOR") }));
+    // Shorter than a trigram
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("o1") })), QStringList({ QStringLiteral("SERVO1_FUNCTION") }));
+    QVERIFY(parameters.index.search({ QStringLiteral("xyz") }).isEmpty());
+    QCOMPARE(parameters.index.search({}).count(), 3);
+}
+
+void ParameterSearchIndexTest::_regexSearch()
+{
+    SyntheticParameters parameters;
+    (void) parameters.add(QStringLiteral("BATT_CAPACITY"), QStringLiteral("Battery capacity"));
+    (void) parameters.add(QStringLiteral("BATT2_CAPACITY"), QStringLiteral("Second battery capacity"));
+    (void) parameters.add(QStringLiteral("SERVO1_FUNCTION"), QStringLiteral("Servo output function"));
+
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("^batt_") })), QStringList({ QStringLiteral("BATT_CAPACITY") }));
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("batt\\d") })), QStringList({ QStringLiteral("BATT2_CAPACITY") }));
+    // Anchors apply per field, not to the whole indexed text
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("^second") })), QStringList({ QStringLiteral("BATT2_CAPACITY") }));
+    // An invalid expression is matched as plain text
+    QVERIFY(parameters.index.search({ QStringLiteral("batt(") }).isEmpty());
+}
+
+void ParameterSearchIndexTest::_enumAndBitmaskLabels()
+{
+    SyntheticParameters parameters;
+    Fact *const fact = parameters.add(QStringLiteral("FLTMODE1"), QStringLiteral("Flight mode 1"));
+    fact->metaData()->setEnumInfo({ QStringLiteral("Stabilize"), QStringLiteral("Loiter") }, { 0, 5 });
+    Fact *const bitmaskFact = parameters.add(QStringLiteral("LOG_BITMASK"), QStringLiteral("Log bitmask"));
+    bitmaskFact->metaData()->setBitmaskInfo({ QStringLiteral("Fast attitude"), QStringLiteral("PID") }, { 1, 2 });
+
+    // Labels are indexed when the fact is added, rebuild after changing the metadata
+    parameters.index.clear();
+    (void) parameters.index.addFact(fact);
+    (void) parameters.index.addFact(bitmaskFact);
+
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("loiter") })), QStringList({ QStringLiteral("FLTMODE1") }));
+    QCOMPARE(parameters.names(parameters.index.search({ QStringLiteral("attitude") })), QStringList({ QStringLiteral("LOG_BITMASK") }));
+}
+
+void ParameterSearchIndexTest::_narrowing()
+{
+    QVERIFY(ParameterSearchIndex::narrows({ QStringLiteral("batt_c") }, { QStringLiteral("batt") }));
+    QVERIFY(ParameterSearchIndex::narrows({ QStringLiteral("BATT"), QStringLiteral("cap") }, { QStringLiteral("batt") }));
+    QVERIFY(ParameterSearchIndex::narrows({ QStringLiteral("batt") }, {}));
+    QVERIFY(!ParameterSearchIndex::narrows({ QStringLiteral("bat") }, { QStringLiteral("batt") }));
+    QVERIFY(!ParameterSearchIndex::narrows({ QStringLiteral("cap") }, { QStringLiteral("batt") }));
+    // A longer expression can match more
+    QVERIFY(!ParameterSearchIndex::narrows({ QStringLiteral("batt|servo") }, { QStringLiteral("batt") }));
+    QVERIFY(!ParameterSearchIndex::narrows({ QStringLiteral("batt_") }, { QStringLiteral("^batt") }));
+
+    SyntheticParameters parameters;
+    parameters.addSynthetic(2000);
+
+    // Narrowing the previous result gives the same result as searching everything
+    QStringList previousTerms;
+    QList<int> previous = parameters.index.search(previousTerms);
+    for (const QString &query : { "b", "ba", "bat", "batt", "batt1", "batt12", "batt12_", "batt12_max" }) {
+        const QStringList terms = { QString::fromLatin1(query) };
+        QVERIFY(ParameterSearchIndex::narrows(terms, previousTerms));
+        const QList<int> narrowed = parameters.index.search(terms, &previous);
+        QCOMPARE(narrowed, parameters.index.search(terms));
+        QCOMPARE(narrowed, scanSearch(parameters.facts, terms));
+        previous = narrowed;
+        previousTerms = terms;
+    }
+    QCOMPARE(parameters.names(previous), QStringList({ QStringLiteral("BATT12_MAX") }));
+}
+
+void ParameterSearchIndexTest::_benchmarkSearch()
+{
+    SyntheticParameters parameters;
+    parameters.addSynthetic(5000);
+
+    // Each keystroke of typing "batt_max" and then a second term
+    const QList<QStringList> keystrokes = {
+        { "b" }, { "ba" }, { "bat" }, { "batt" }, { "batt_" }, { "batt_m" }, { "batt_ma" }, { "batt_max" },
+        { "batt_max", "m" }, { "batt_max", "mo" }, { "batt_max", "mon" }, { "batt_max", "moni" },
+    };
+
+    for (const QStringList &terms : keystrokes) {
+        QCOMPARE(parameters.index.search(terms), scanSearch(parameters.facts, terms));
+    }
+
+    auto bench = qgc::bench::ciConfig().epochs(10).minEpochIterations(1);
+    bench.relative(true);
+    bench.batch(keystrokes.size());
+    bench.run("5000 parameters, 12 keystrokes: regex scan (baseline)", [&] {
+        for (const QStringList &terms : keystrokes) {
+            ankerl::nanobench::doNotOptimizeAway(scanSearch(parameters.facts, terms));
+        }
+    });
+    bench.run("5000 parameters, 12 keystrokes: trigram index", [&] {
+        for (const QStringList &terms : keystrokes) {
+            ankerl::nanobench::doNotOptimizeAway(parameters.index.search(terms));
+        }
+    });
+    bench.run("5000 parameters, 12 keystrokes: trigram index, narrowing", [&] {
+        QStringList previousTerms;
+        QList<int> previous;
+        bool havePrevious = false;
+        for (const QStringList &terms : keystrokes) {
+            previous = (havePrevious && ParameterSearchIndex::narrows(terms, previousTerms))
+                           ? parameters.index.search(terms, &previous)
+                           : parameters.index.search(terms);
+            previousTerms = terms;
+            havePrevious = true;
+            ankerl::nanobench::doNotOptimizeAway(previous);
+        }
+    });
+
+    auto buildBench = qgc::bench::ciConfig().epochs(5).minEpochIterations(1);
+    buildBench.run("5000 parameters: build index", [&] {
+        ParameterSearchIndex index;
+        for (Fact *fact : parameters.facts) {
+            (void) index.addFact(fact);
+        }
+        ankerl::nanobench::doNotOptimizeAway(index.count());
+    });
+}
+
+UT_REGISTER_TEST(ParameterSearchIndexTest, TestLabel::Unit)
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterSearchIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _plainTextSearch();
+    void _regexSearch();
+    void _enumAndBitmaskLabels();
+    void _narrowing();
+    void _benchmarkSearch();
+};
@@ -0,0 +1,202 @@
+#include "TerrainProfileBlockTest.h"
+#include "TerrainProfileBlock.h"
+
+#include <cmath>
+#include <vector>
+
+#include "Benchmarking.h"
+
+namespace {
+
+/// Rolling terrain with small bumps, heights every 10 m along a segment of @p length meters starting at @p start
+QList<double> _terrainHeights(double start, double length)
+{
+    QList<double> heights;
+    const int count = static_cast<int>(length / 10.0) + 1;
+    for (int i = 0; i < count; i++) {
+        const double distance = start + (i * 10.0);
+        heights.append(100.0 + (30.0 * std::sin(distance / 200.0)) + (5.0 * std::sin(distance / 13.0)));
+    }
+    return heights;
+}
+
+TerrainProfileBlock _terrainFrameBlock(double start, double length, double heightAboveTerrain)
+{
+    const QList<double> heights = _terrainHeights(start, length);
+    return TerrainProfileBlock(FlightPathSegment::SegmentTypeTerrainFrame, heights.first() + heightAboveTerrain, heights.last() + heightAboveTerrain,
+                               heights, 10.0, 10.0, length, false);
+}
+
+} // namespace
+
+void TerrainProfileBlockTest::_testGenericSegment()
+{
+    // Heights 40 m apart, the last pair only 20 m
+    const QList<double> heights = { 10, 20, 15, 30 };
+    TerrainProfileBlock block(FlightPathSegment::SegmentTypeGeneric, 50, 60, heights, 40, 20, 100, false);
+    QCOMPARE(block.totalDistance(), 100.0);
+    QVERIFY(!block.missingTerrain());
+    QCOMPARE(block.terrainPointCount(), 4);
+    QCOMPARE(block.flightProfileSegmentCount(), 1);
+    QCOMPARE(block.minTerrainHeight(), 10.0);
+    QCOMPARE(block.maxTerrainHeight(), 30.0);
+
+    // Placed 1000 m into the mission, in feet
+    constexpr double kFeet = 3.28084;
+    TerrainProfileBlock::SeriesPoints points;
+    block.appendTo(points, 1000, 0, kFeet, kFeet, 0);
+    QCOMPARE(points.terrain, QList<QPointF>({ QPointF(1000 * kFeet, 10 * kFeet), QPointF(1040 * kFeet, 20 * kFeet),
+                                              QPointF(1060 * kFeet, 15 * kFeet), QPointF(1100 * kFeet, 30 * kFeet) }));
+    QCOMPARE(points.flight, QList<QPointF>({ QPointF(1000 * kFeet, 50 * kFeet), QPointF(1100 * kFeet, 60 * kFeet) }));
+    QVERIFY(points.missing.isEmpty());
+    QVERIFY(points.collision.isEmpty());
+}
+
+void TerrainProfileBlockTest::_testTerrainFrameSegment()
+{
+    TerrainProfileBlock block = _terrainFrameBlock(0, 500, 25);
+    QCOMPARE(block.terrainPointCount(), 51);
+    QCOMPARE(block.flightProfileSegmentCount(), 50);
+
+    TerrainProfileBlock::SeriesPoints points;
+    block.appendTo(points, 0, 0, 1, 1, 0);
+    QCOMPARE(points.flight.count(), points.terrain.count());
+    for (int i = 0; i < points.terrain.count(); i++) {
+        QCOMPARE(points.flight[i].x(), points.terrain[i].x());
+        QVERIFY(qAbs(points.flight[i].y() - points.terrain[i].y() - 25) < 1e-9);
+    }
+
+    // No flight profile until terrain heights arrive
+    TerrainProfileBlock pending(FlightPathSegment::SegmentTypeTerrainFrame, 100, 100, {}, 0, 0, 500, false);
+    QVERIFY(pending.missingTerrain());
+    QCOMPARE(pending.flightProfileSegmentCount(), 0);
+}
+
+void TerrainProfileBlockTest::_testSeriesGaps()
+{
+    TerrainProfileBlock first(FlightPathSegment::SegmentTypeGeneric, 50, 50, { 10, 10 }, 100, 100, 100, false);
+    TerrainProfileBlock missing(FlightPathSegment::SegmentTypeGeneric, qQNaN(), 50, {}, 0, 0, 200, false);
+    TerrainProfileBlock collision(FlightPathSegment::SegmentTypeGeneric, 5, 5, { 10, 10 }, 50, 50, 50, true);
+
+    TerrainProfileBlock::SeriesPoints points;
+    first.appendTo(points, 0, 0, 1, 1, -20);
+    missing.appendTo(points, 100, 0, 1, 1, -20);
+    collision.appendTo(points, 300, 0, 1, 1, -20);
+
+    // Missing terrain breaks the terrain series and is drawn along the chart minimum
+    QCOMPARE(points.terrain.count(), 5);
+    QVERIFY(qIsNaN(points.terrain[2].x()) && qIsNaN(points.terrain[2].y()));
+    QCOMPARE(points.terrain[3], QPointF(300, 10));
+    QCOMPARE(points.missing, QList<QPointF>({ QPointF(100, -20), QPointF(300, -20) }));
+
+    // Unknown altitude breaks the flight series at the segment start
+    QCOMPARE(points.flight.count(), 5);
+    QCOMPARE(points.flight[2].x(), 100.0);
+    QVERIFY(qIsNaN(points.flight[2].y()));
+
+    QCOMPARE(points.collision, QList<QPointF>({ QPointF(300, 5), QPointF(350, 5) }));
+}
+
+void TerrainProfileBlockTest::_testDecimate()
+{
+    QList<QPointF> points;
+    for (int i = 0; i < 10000; i++) {
+        points.append(QPointF(i * 0.5, std::sin(i * 0.37) * (1 + (i % 17))));
+    }
+    points[5123].setY(1000);
+    points[7777].setY(-1000);
+
+    QList<QPointF> decimated;
+    constexpr double kBucket = 16;
+    TerrainProfileBlock::decimate(points, kBucket, decimated);
+
+    const int buckets = static_cast<int>(std::ceil((points.last().x() + 1) / kBucket));
+    QVERIFY(decimated.count() <= (2 * buckets) + 2);
+    QCOMPARE(decimated.first(), points.first());
+    QCOMPARE(decimated.last(), points.last());
+    QVERIFY(decimated.contains(points[5123]));
+    QVERIFY(decimated.contains(points[7777]));
+    for (int i = 1; i < decimated.count(); i++) {
+        QVERIFY(decimated[i].x() > decimated[i - 1].x());
+    }
+
+    // No bucket width leaves the points alone
+    TerrainProfileBlock::decimate(points, 0, decimated);
+    QCOMPARE(decimated, points);
+}
+
+void TerrainProfileBlockTest::_testBucketMeters()
+{
+    QCOMPARE(TerrainProfileBlock::bucketMeters(0, 800), 0.0);
+    QCOMPARE(TerrainProfileBlock::bucketMeters(10000, 0), 0.0);
+
+    for (const double distance : { 50.0, 1234.0, 100000.0, 1000000.0 }) {
+        const double bucket = TerrainProfileBlock::bucketMeters(distance, 800);
+        const double metersPerPixel = distance / 800;
+        QVERIFY(bucket <= metersPerPixel);
+        QVERIFY(bucket > (metersPerPixel / 2));
+        QCOMPARE(std::exp2(std::round(std::log2(bucket))), bucket);
+    }
+
+    // Dragging a waypoint changes the mission length a little, the bucket stays the same
+    QCOMPARE(TerrainProfileBlock::bucketMeters(1000000, 800), TerrainProfileBlock::bucketMeters(1000150, 800));
+}
+
+void TerrainProfileBlockTest::_benchmarkLongMission()
+{
+    // Terrain following mission: 2000 segments of 500 m, terrain every 10 m, about 100k terrain points
+    constexpr int kSegmentCount = 2000;
+    constexpr double kSegmentLength = 500;
+    constexpr double kVisibleWidth = 1000;
+    const double missionDistance = kSegmentCount * kSegmentLength;
+
+    std::vector<QList<double>> heights;
+    heights.reserve(kSegmentCount);
+    for (int i = 0; i < kSegmentCount; i++) {
+        heights.push_back(_terrainHeights(i * kSegmentLength, kSegmentLength));
+    }
+
+    auto bench = qgc::bench::ciConfig().epochs(5).minEpochIterations(1);
+    bench.relative(true);
+
+    qsizetype fullCount = 0;
+    bench.run("rebuild every segment, all points (previous behavior)", [&] {
+        TerrainProfileBlock::SeriesPoints points;
+        for (int i = 0; i < kSegmentCount; i++) {
+            TerrainProfileBlock block(FlightPathSegment::SegmentTypeTerrainFrame, heights[i].first() + 30, heights[i].last() + 30,
+                                      heights[i], 10.0, 10.0, kSegmentLength, false);
+            block.appendTo(points, i * kSegmentLength, 0, 1, 1, 0);
+        }
+        fullCount = points.count();
+        ankerl::nanobench::doNotOptimizeAway(fullCount);
+    });
+
+    std::vector<TerrainProfileBlock> blocks;
+    blocks.reserve(kSegmentCount);
+    for (int i = 0; i < kSegmentCount; i++) {
+        blocks.push_back(_terrainFrameBlock(i * kSegmentLength, kSegmentLength, 30));
+    }
+
+    // Each iteration is one drag update: the two segments next to the waypoint change, everything is re-assembled
+    int waypoint = 1;
+    double heightAboveTerrain = 30;
+    qsizetype decimatedCount = 0;
+    const double bucketMeters = TerrainProfileBlock::bucketMeters(missionDistance, kVisibleWidth);
+    bench.run("drag a waypoint: rebuild 2 segments, decimated to 1000 px", [&] {
+        heightAboveTerrain += 0.5;
+        blocks[waypoint - 1] = _terrainFrameBlock((waypoint - 1) * kSegmentLength, kSegmentLength, heightAboveTerrain);
+        blocks[waypoint] = _terrainFrameBlock(waypoint * kSegmentLength, kSegmentLength, heightAboveTerrain);
+        waypoint = (waypoint % (kSegmentCount - 1)) + 1;
+
+        TerrainProfileBlock::SeriesPoints points;
+        for (int i = 0; i < kSegmentCount; i++) {
+            blocks[i].appendTo(points, i * kSegmentLength, bucketMeters, 1, 1, 0);
+        }
+        decimatedCount = points.count();
+        ankerl::nanobench::doNotOptimizeAway(decimatedCount);
+    });
+
+    QVERIFY(decimatedCount < (fullCount / 5));
+}
+
+UT_REGISTER_TEST(TerrainProfileBlockTest, TestLabel::Unit)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for TerrainProfileBlock: chart points per flight path segment and decimation
+class TerrainProfileBlockTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testGenericSegment();
+    void _testTerrainFrameSegment();
+    void _testSeriesGaps();
+    void _testDecimate();
+    void _testBucketMeters();
+    void _benchmarkLongMission();
+};
@@ -1,7 +1,13 @@
 #include "QGCCacheWorkerTest.h"
 
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QTemporaryDir>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
 #include <QtPositioning/QGeoCoordinate>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlQuery>
 #include <QtTest/QTest>
 #include <cmath>
 
@@ -11,7 +17,10 @@
 #include "QGCCachedTileSet.h"
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileCacheDatabase.h"
+#include "QGCTileCacheIndex.h"
 #include "QGCTileCacheWorker.h"
+#include "LocalHttpTestServer.h"
 #include "TerrainTile.h"
 #include "TerrainTileCopernicus.h"
 
@@ -428,4 +437,175 @@ void QGCCacheWorkerTest::_testStopWhileProcessing()
     QVERIFY(!worker.isRunning());
 }
 
+bool QGCCacheWorkerTest::_populateDatabase(const QString& path, int tileCount)
+{
+    QGCTileCacheDatabase db(path);
+    if (!db.init() || !db.connectDB()) {
+        return false;
+    }
+
+    const std::optional<quint64> defaultSet = db.findTileSetID(QStringLiteral("Default Tile Set"));
+    if (!defaultSet.has_value()) {
+        return false;
+    }
+
+    // Bulk insert in one transaction, saveTile() commits per tile which is far too slow for a large cache
+    QSqlDatabase sql = db.database();
+    if (!sql.transaction()) {
+        return false;
+    }
+    QSqlQuery tileQuery(sql);
+    QSqlQuery setQuery(sql);
+    if (!tileQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)") ||
+        !setQuery.prepare("INSERT INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
+        return false;
+    }
+    const QByteArray image(256, 'T');
+    const int type = UrlFactory::getQtMapIdFromProviderType(kTestProviderType);
+    // Older than anything saved during the test so pruning picks these first
+    const qint64 date = QDateTime::currentSecsSinceEpoch() - 3600;
+    const int side = static_cast<int>(std::ceil(std::sqrt(tileCount)));
+    for (int i = 0; i < tileCount; i++) {
+        tileQuery.addBindValue(UrlFactory::getTileHash(kTestProviderType, i % side, i / side, 17));
+        tileQuery.addBindValue(QStringLiteral("png"));
+        tileQuery.addBindValue(image);
+        tileQuery.addBindValue(image.size());
+        tileQuery.addBindValue(type);
+        tileQuery.addBindValue(date);
+        if (!tileQuery.exec()) {
+            return false;
+        }
+        setQuery.addBindValue(tileQuery.lastInsertId());
+        setQuery.addBindValue(defaultSet.value());
+        if (!setQuery.exec()) {
+            return false;
+        }
+    }
+    const bool ok = sql.commit();
+    db.disconnectDB();
+    return ok;
+}
+
+void QGCCacheWorkerTest::_testTileIndexTracksDatabase()
+{
+    QTemporaryDir tempDir;
+    const QString path = tempDir.filePath("index.db");
+    // More than one build step worth of tiles
+    constexpr int kTileCount = 10000;
+    QVERIFY(_populateDatabase(path, kTileCount));
+
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(path);
+    QVERIFY(_startWorker(worker));
+    QTRY_VERIFY_WITH_TIMEOUT(worker.tileIndex().isReady(), TestTimeout::longMs());
+    QCOMPARE(worker.tileIndex().count(), kTileCount);
+
+    const QString cached = UrlFactory::getTileHash(kTestProviderType, 0, 0, 17);
+    const QString uncached = UrlFactory::getTileHash(kTestProviderType, 0, 0, 18);
+    QCOMPARE(worker.tileIndex().lookup(cached), QGCTileCacheIndex::Lookup::Present);
+    QCOMPARE(worker.tileIndex().lookup(uncached), QGCTileCacheIndex::Lookup::Absent);
+
+    // Saved tiles show up right away
+    auto* tile = new QGCCacheTile(uncached, QByteArray("data"), QStringLiteral("png"), kTestProviderType);
+    QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
+    QTRY_COMPARE_WITH_TIMEOUT(worker.tileIndex().lookup(uncached), QGCTileCacheIndex::Lookup::Present, TestTimeout::mediumMs());
+
+    // Pruned tiles are dropped
+    auto* pruneTask = new QGCPruneCacheTask(256 * 100);
+    bool pruneDone = false;
+    (void) connect(pruneTask, &QGCPruneCacheTask::pruned, this, [&]() { pruneDone = true; }, Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(pruneTask));
+    QTRY_VERIFY_WITH_TIMEOUT(pruneDone, TestTimeout::mediumMs());
+    QCOMPARE(worker.tileIndex().count(), kTileCount + 1 - 100);
+
+    // Reset leaves an empty, ready index
+    auto* resetTask = new QGCResetTask();
+    bool resetDone = false;
+    (void) connect(resetTask, &QGCResetTask::resetCompleted, this, [&]() { resetDone = true; }, Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(resetTask));
+    QTRY_VERIFY_WITH_TIMEOUT(resetDone, TestTimeout::mediumMs());
+    QTRY_VERIFY_WITH_TIMEOUT(worker.tileIndex().isReady(), TestTimeout::mediumMs());
+    QCOMPARE(worker.tileIndex().lookup(cached), QGCTileCacheIndex::Lookup::Absent);
+
+    worker.stop();
+    worker.wait(TestTimeout::mediumMs());
+}
+
+void QGCCacheWorkerTest::_benchmarkTimeToFirstTile()
+{
+    // Time from "map wants a tile" to the first tile bytes arriving, browsing an area which is not in a large cache.
+    // The local HTTP server stands in for the tile server so only the cache path differs between the two runs.
+    QTemporaryDir tempDir;
+    const QString path = tempDir.filePath("ttft.db");
+    QVERIFY(_populateDatabase(path, 100000));
+
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(path);
+    QVERIFY(_startWorker(worker));
+    QTRY_VERIFY_WITH_TIMEOUT(worker.tileIndex().isReady(), TestTimeout::longMs() * 3);
+
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY(server.listen());
+    server.installHttpResponder(QByteArray(256, 'N'), 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    constexpr int kViewportTiles = 48;
+
+    auto fetchViewport = [&](int zoom, bool useIndex) -> qint64 {
+        QElapsedTimer timer;
+        qint64 firstTileNSecs = -1;
+        int finished = 0;
+
+        auto startDownload = [&]() {
+            QNetworkReply* const reply = networkManager.get(QNetworkRequest(QUrl(server.url(QStringLiteral("/tile")))));
+            (void) connect(reply, &QNetworkReply::finished, this, [&, reply]() {
+                if (firstTileNSecs < 0) {
+                    firstTileNSecs = timer.nsecsElapsed();
+                }
+                finished++;
+                reply->deleteLater();
+            });
+        };
+
+        timer.start();
+        for (int i = 0; i < kViewportTiles; i++) {
+            const QString hash = UrlFactory::getTileHash(kTestProviderType, i % 8, i / 8, zoom);
+            if (useIndex && (worker.tileIndex().lookup(hash) == QGCTileCacheIndex::Lookup::Absent)) {
+                startDownload();
+                continue;
+            }
+            // Under unit tests the synthetic tile generator answers database misses, either answer ends the cache
+            // round trip after which the reply would start its download
+            auto* task = new QGCFetchTileTask(hash);
+            (void) connect(task, &QGCMapTask::error, this, [&]() { startDownload(); }, Qt::QueuedConnection);
+            (void) connect(task, &QGCFetchTileTask::tileFetched, this, [&](QGCCacheTile* tile) {
+                delete tile;
+                startDownload();
+            }, Qt::QueuedConnection);
+            if (!worker.enqueueTask(task)) {
+                return -1;
+            }
+        }
+
+        if (!UnitTest::waitForCondition([&]() { return finished == kViewportTiles; }, TestTimeout::longMs(),
+                                        QStringLiteral("viewport tiles"))) {
+            return -1;
+        }
+        return firstTileNSecs;
+    };
+
+    // Different zoom levels so neither run benefits from the other
+    const qint64 databaseFirst = fetchViewport(12, false);
+    const qint64 indexFirst = fetchViewport(13, true);
+    QVERIFY(databaseFirst > 0);
+    QVERIFY(indexFirst > 0);
+
+    qCDebug(UnitTestLog) << "Time to first tile, uncached area, 100k tile cache:"
+                         << "database miss" << (databaseFirst / 1000) << "us,"
+                         << "index miss" << (indexFirst / 1000) << "us";
+
+    worker.stop();
+    worker.wait(TestTimeout::mediumMs());
+}
+
 UT_REGISTER_TEST(QGCCacheWorkerTest, TestLabel::Unit)
@@ -22,7 +22,10 @@ private slots:
     void _testPruneCache();
     void _testResetDatabase();
     void _testStopWhileProcessing();
+    void _testTileIndexTracksDatabase();
+    void _benchmarkTimeToFirstTile();
 
 private:
     bool _startWorker(QGCCacheWorker& worker, int timeoutMs = TestTimeout::mediumMs());
+    static bool _populateDatabase(const QString& path, int tileCount);
 };
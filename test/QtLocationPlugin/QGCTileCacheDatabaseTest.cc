@@ -147,6 +147,41 @@ void QGCTileCacheDatabaseTest::_testFindTile()
     QVERIFY(!missing.has_value());
 }
 
+void QGCTileCacheDatabaseTest::_testGetTileHashes()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+
+    QStringList saved;
+    for (int i = 0; i < 5; i++) {
+        saved.append(QStringLiteral("stream_%1").arg(i));
+        QVERIFY(db->saveTile(saved.last(), QStringLiteral("png"), QByteArray(10, 'S'), kFixedProviderType,
+                             QGCTileCacheDatabase::kInvalidTileSet));
+    }
+
+    // Stream in batches smaller than the table
+    QStringList streamed;
+    quint64 cursor = 0;
+    while (true) {
+        QStringList batch;
+        const auto last = db->getTileHashes(cursor, 2, batch);
+        QVERIFY(last.has_value());
+        streamed.append(batch);
+        cursor = last.value();
+        if (batch.size() < 2) {
+            break;
+        }
+    }
+    QCOMPARE(streamed, saved);
+
+    QStringList pruned;
+    QVERIFY(db->pruneCache(25, &pruned));
+    QCOMPARE(pruned.size(), 3);
+    for (const QString &hash : std::as_const(pruned)) {
+        QVERIFY(!db->findTile(hash).has_value());
+    }
+}
+
 void QGCTileCacheDatabaseTest::_testGetTileSetsMultiple()
 {
     QTemporaryDir tempDir;
@@ -18,6 +18,7 @@ private slots:
     void _testSaveTileAndGetTile();
     void _testGetTileNotFound();
     void _testFindTile();
+    void _testGetTileHashes();
     void _testGetTileSetsMultiple();
     void _testRenameTileSet();
     void _testFindTileSetID();
@@ -0,0 +1,111 @@
+#include "QGCTileCacheIndexTest.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSet>
+
+#include "QGCMapUrlEngine.h"
+#include "QGCTileCacheIndex.h"
+
+namespace {
+
+QString _hash(int x, int y, int z)
+{
+    return UrlFactory::getTileHash(QStringLiteral("Bing Road"), x, y, z);
+}
+
+} // namespace
+
+void QGCTileCacheIndexTest::_testUnknownUntilReady()
+{
+    QGCTileCacheIndex index;
+    index.insert(_hash(1, 2, 3));
+
+    QCOMPARE(index.lookup(_hash(1, 2, 3)), QGCTileCacheIndex::Lookup::Unknown);
+    QCOMPARE(index.lookup(_hash(4, 5, 6)), QGCTileCacheIndex::Lookup::Unknown);
+
+    index.setReady(true);
+    QCOMPARE(index.lookup(_hash(1, 2, 3)), QGCTileCacheIndex::Lookup::Present);
+    QCOMPARE(index.lookup(_hash(4, 5, 6)), QGCTileCacheIndex::Lookup::Absent);
+}
+
+void QGCTileCacheIndexTest::_testInsertLookupRemove()
+{
+    QGCTileCacheIndex index;
+    index.setReady(true);
+
+    index.insert(_hash(10, 20, 5));
+    index.insert(_hash(10, 20, 5));
+    QCOMPARE(index.count(), 1);
+    QCOMPARE(index.lookup(_hash(10, 20, 5)), QGCTileCacheIndex::Lookup::Present);
+
+    // Another cached tile could share the removed fingerprint, so the answer goes back to the database
+    index.remove(_hash(10, 20, 5));
+    QCOMPARE(index.count(), 0);
+    QCOMPARE(index.lookup(_hash(10, 20, 5)), QGCTileCacheIndex::Lookup::Unknown);
+
+    index.insert(_hash(10, 20, 5));
+    QCOMPARE(index.lookup(_hash(10, 20, 5)), QGCTileCacheIndex::Lookup::Present);
+
+    // Removing an unknown hash is a no-op
+    index.remove(_hash(11, 20, 5));
+    QCOMPARE(index.count(), 1);
+    QCOMPARE(index.lookup(_hash(11, 20, 5)), QGCTileCacheIndex::Lookup::Absent);
+}
+
+void QGCTileCacheIndexTest::_testGrowAndRemoveMatchesReferenceSet()
+{
+    QGCTileCacheIndex index;
+    index.setReady(true);
+    QSet<QString> reference;
+
+    // Enough entries to grow the table several times, removals exercise the probe run compaction
+    for (int x = 0; x < 100; x++) {
+        for (int y = 0; y < 100; y++) {
+            const QString hash = _hash(x, y, 14);
+            index.insert(hash);
+            reference.insert(hash);
+        }
+    }
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < 4000; i++) {
+        const QString hash = _hash(random.bounded(100), random.bounded(100), 14);
+        index.remove(hash);
+        reference.remove(hash);
+    }
+
+    QCOMPARE(index.count(), reference.count());
+    for (int x = 0; x < 100; x++) {
+        for (int y = 0; y < 100; y++) {
+            const QString hash = _hash(x, y, 14);
+            // Never answered Absent after a removal
+            const auto expected = reference.contains(hash) ? QGCTileCacheIndex::Lookup::Present : QGCTileCacheIndex::Lookup::Unknown;
+            QCOMPARE(index.lookup(hash), expected);
+        }
+    }
+
+    // Tiles at another zoom level were never inserted, every answer must be a definite miss
+    for (int x = 0; x < 100; x++) {
+        QCOMPARE(index.lookup(_hash(x, x, 15)), QGCTileCacheIndex::Lookup::Absent);
+    }
+}
+
+void QGCTileCacheIndexTest::_testClear()
+{
+    QGCTileCacheIndex index;
+    for (int i = 0; i < 2000; i++) {
+        index.insert(_hash(i, i, 10));
+    }
+    index.setReady(true);
+    QVERIFY(index.isReady());
+
+    index.clear();
+    QVERIFY(!index.isReady());
+    QCOMPARE(index.count(), 0);
+    QCOMPARE(index.lookup(_hash(1, 1, 10)), QGCTileCacheIndex::Lookup::Unknown);
+
+    index.setReady(true);
+    QCOMPARE(index.lookup(_hash(1, 1, 10)), QGCTileCacheIndex::Lookup::Absent);
+}
+
+UT_REGISTER_TEST(QGCTileCacheIndexTest, TestLabel::Unit)
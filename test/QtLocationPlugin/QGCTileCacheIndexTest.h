@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCTileCacheIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testUnknownUntilReady();
+    void _testInsertLookupRemove();
+    void _testGrowAndRemoveMatchesReferenceSet();
+    void _testClear();
+};
@@ -354,6 +354,64 @@ void GeoTest::_interpolateAtDistance_test()
     QCOMPARE(same, m_origin);
 }
 
+void GeoTest::_convertGeoToNedList_test()
+{
+    const QList<QGeoCoordinate> coords = {
+        m_origin,
+        QGeoCoordinate(47.364869, 8.594398, 0.0),
+        QGeoCoordinate(47.3801, 8.5401, 25.0),
+    };
+    const QList<QPointF> ned = QGCGeo::convertGeoToNed(coords, m_origin);
+    QCOMPARE(ned.count(), coords.count());
+    for (int i = 0; i < coords.count(); i++) {
+        double x, y, z;
+        QGCGeo::convertGeoToNed(coords[i], m_origin, x, y, z);
+        QVERIFY(compareDoubles(ned[i].x(), x));
+        QVERIFY(compareDoubles(ned[i].y(), y));
+    }
+    QVERIFY(QGCGeo::convertGeoToNed(QList<QGeoCoordinate>(), m_origin).isEmpty());
+}
+
+void GeoTest::_simplifyPath_test()
+{
+    const auto fromNorthEast = [this](double north, double east) {
+        QGeoCoordinate coord;
+        QGCGeo::convertNedToGeo(north, east, 0, m_origin, coord);
+        return coord;
+    };
+
+    // Zig zag of +-0.5m along a 1km line collapses to its ends
+    QList<QGeoCoordinate> zigZag;
+    for (int i = 0; i <= 100; i++) {
+        zigZag.append(fromNorthEast((i % 2) ? -0.5 : 0.5, i * 10.0));
+    }
+    QCOMPARE(QGCGeo::simplifyPath(zigZag, 0, false), zigZag);
+    const QList<QGeoCoordinate> line = QGCGeo::simplifyPath(zigZag, 1.0, false);
+    QCOMPARE(line.count(), 2);
+    QCOMPARE(line.first(), zigZag.first());
+    QCOMPARE(line.last(), zigZag.last());
+
+    // A 4m bump in the bottom edge is within tolerance, but dropping it would let the edge cross
+    // the prong which reaches down into the bump. So the bump stays and only the collinear vertices go.
+    const QList<QGeoCoordinate> polygon = {
+        fromNorthEast(0, 0), fromNorthEast(0, 40), fromNorthEast(-4, 50), fromNorthEast(0, 60),
+        fromNorthEast(0, 100), fromNorthEast(100, 100), fromNorthEast(100, 51), fromNorthEast(-2, 50),
+        fromNorthEast(100, 49), fromNorthEast(100, 0),
+    };
+    const QList<QGeoCoordinate> simplified = QGCGeo::simplifyPath(polygon, 5.0, true);
+    QCOMPARE(simplified.count(), 8);
+    QVERIFY(simplified.contains(polygon[2]));
+    QVERIFY(!simplified.contains(polygon[1]));
+    QVERIFY(!simplified.contains(polygon[3]));
+
+    // Polygons never drop below a triangle
+    QList<QGeoCoordinate> sliver;
+    for (int i = 0; i < 10; i++) {
+        sliver.append(fromNorthEast(0.01 * (i % 2), i * 10.0));
+    }
+    QCOMPARE(QGCGeo::simplifyPath(sliver, 50.0, true).count(), 3);
+}
+
 void GeoTest::_distanceProperties_test()
 {
     RC_QT_PROP("distance is always non-negative", [] {
@@ -38,6 +38,9 @@ private slots:
     void _interpolatePath_test();
     void _interpolateAtDistance_test();
 
+    void _convertGeoToNedList_test();
+    void _simplifyPath_test();
+
     // Property-based tests
     void _distanceProperties_test();
     void _nedRoundtripProperty_test();
@@ -0,0 +1,392 @@
+#include "QGCChunkedUploadTest.h"
+#include "QGCChunkedUpload.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtHttpServer/QHttpServer>
+#include <QtHttpServer/QHttpServerRequest>
+#include <QtHttpServer/QHttpServerResponse>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QTcpServer>
+#include <QtTest/QSignalSpy>
+
+namespace {
+
+/// Minimal tus 1.0.0 server (creation + concatenation extensions) with fault injection
+class TusTestServer
+{
+public:
+    TusTestServer()
+    {
+        _httpServer.route("/files", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
+            return _create(request);
+        });
+        _httpServer.route("/files/<arg>", QHttpServerRequest::Method::Head, [this](const QString &id, const QHttpServerRequest &) {
+            if (!_uploads.contains(id)) {
+                return QHttpServerResponse(QHttpServerResponse::StatusCode::NotFound);
+            }
+            const Upload &upload = _uploads[id];
+            return _response(QHttpServerResponse::StatusCode::Ok, {
+                { "Upload-Offset", QByteArray::number(upload.data.size()) },
+                { "Upload-Length", QByteArray::number(upload.length) }
+            });
+        });
+        _httpServer.route("/files/<arg>", QHttpServerRequest::Method::Patch, [this](const QString &id, const QHttpServerRequest &request) {
+            return _patch(id, request);
+        });
+    }
+
+    bool listen()
+    {
+        return _tcpServer.listen(QHostAddress::LocalHost) && _httpServer.bind(&_tcpServer);
+    }
+
+    QUrl endpoint() const
+    {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1/files").arg(_tcpServer.serverPort()));
+    }
+
+    QByteArray contents(const QUrl &uploadUrl) const
+    {
+        return _uploads.value(uploadUrl.path().section('/', -1)).data;
+    }
+
+    int createCount = 0;
+    int patchCount = 0;             ///< Accepted PATCH requests
+    int failedPatchCount = 0;
+    qint64 patchBytes = 0;
+    int failPatches = 0;            ///< Number of upcoming PATCH requests answered with 500
+    int conflictPatches = 0;        ///< Number of upcoming PATCH requests answered with 409, -1 is all of them
+    int conflictPatchCount = 0;
+    int acceptPatches = -1;         ///< PATCH requests accepted before the server starts failing all of them, -1 is unlimited
+
+private:
+    struct Upload {
+        QByteArray data;
+        qint64 length = 0;
+        bool partial = false;
+    };
+
+    static QHttpServerResponse _response(QHttpServerResponse::StatusCode status, const QList<QPair<QByteArray, QByteArray>> &headers = {})
+    {
+        QHttpServerResponse response(status);
+        QHttpHeaders responseHeaders = response.headers();
+        responseHeaders.append("Tus-Resumable", "1.0.0");
+        for (const auto &[name, value] : headers) {
+            responseHeaders.append(name, value);
+        }
+        response.setHeaders(std::move(responseHeaders));
+        return response;
+    }
+
+    QHttpServerResponse _create(const QHttpServerRequest &request)
+    {
+        if (request.headers().value("Tus-Resumable") != "1.0.0") {
+            return _response(QHttpServerResponse::StatusCode::PreconditionFailed);
+        }
+
+        Upload upload;
+        const QByteArray concat = request.headers().value("Upload-Concat").toByteArray();
+        if (concat.startsWith("final;")) {
+            for (const QByteArray &url : concat.mid(6).split(' ')) {
+                const QString partId = QUrl(QString::fromLatin1(url)).path().section('/', -1);
+                const Upload part = _uploads.value(partId);
+                if (!part.partial || (part.data.size() != part.length)) {
+                    return _response(QHttpServerResponse::StatusCode::BadRequest);
+                }
+                upload.data.append(part.data);
+            }
+            upload.length = upload.data.size();
+        } else {
+            bool ok = false;
+            upload.length = request.headers().value("Upload-Length").toByteArray().toLongLong(&ok);
+            if (!ok) {
+                return _response(QHttpServerResponse::StatusCode::BadRequest);
+            }
+            upload.partial = (concat == "partial");
+        }
+
+        const QString id = QString::number(++createCount);
+        _uploads.insert(id, upload);
+        return _response(QHttpServerResponse::StatusCode::Created, { { "Location", "/files/" + id.toLatin1() } });
+    }
+
+    QHttpServerResponse _patch(const QString &id, const QHttpServerRequest &request)
+    {
+        if (!_uploads.contains(id)) {
+            return _response(QHttpServerResponse::StatusCode::NotFound);
+        }
+        if ((acceptPatches == 0) || (failPatches > 0)) {
+            failPatches = qMax(0, failPatches - 1);
+            failedPatchCount++;
+            return _response(QHttpServerResponse::StatusCode::InternalServerError);
+        }
+        if (conflictPatches != 0) {
+            // Disagrees with the offset its own HEAD reports
+            if (conflictPatches > 0) {
+                conflictPatches--;
+            }
+            conflictPatchCount++;
+            return _response(QHttpServerResponse::StatusCode::Conflict);
+        }
+        if (request.headers().value(QHttpHeaders::WellKnownHeader::ContentType) != "application/offset+octet-stream") {
+            return _response(QHttpServerResponse::StatusCode::UnsupportedMediaType);
+        }
+
+        Upload &upload = _uploads[id];
+        const QByteArray body = request.body();
+        if (request.headers().value("Upload-Offset").toByteArray().toLongLong() != upload.data.size()) {
+            return _response(QHttpServerResponse::StatusCode::Conflict);
+        }
+        if ((upload.data.size() + body.size()) > upload.length) {
+            return _response(QHttpServerResponse::StatusCode::BadRequest);
+        }
+
+        upload.data.append(body);
+        patchCount++;
+        patchBytes += body.size();
+        if (acceptPatches > 0) {
+            acceptPatches--;
+        }
+        return _response(QHttpServerResponse::StatusCode::NoContent, { { "Upload-Offset", QByteArray::number(upload.data.size()) } });
+    }
+
+    QHttpServer _httpServer;
+    QTcpServer _tcpServer;
+    QHash<QString, Upload> _uploads;
+};
+
+QByteArray _testData(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; i++) {
+        data[i] = static_cast<char>((i * 31) % 251);
+    }
+    return data;
+}
+
+class SequentialBuffer : public QBuffer
+{
+public:
+    bool isSequential() const override { return true; }
+};
+
+} // namespace
+
+void QGCChunkedUploadTest::_testSingleStreamUpload()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+
+    const QByteArray data = _testData((10 * 1024) + 100);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1024);
+    upload.setMetadata(QStringLiteral("filename"), QStringLiteral("test.bin"));
+
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QSignalSpy chunkSpy(&upload, &QGCChunkedUpload::chunkUploaded);
+    QSignalSpy progressSpy(&upload, &QGCChunkedUpload::progress);
+
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY2(finishedSpy.first().at(0).toBool(), qPrintable(finishedSpy.first().at(2).toString()));
+
+    QCOMPARE(upload.state(), QGCChunkedUpload::State::Completed);
+    QCOMPARE(chunkSpy.count(), 11);
+    QCOMPARE(server.patchCount, 11);
+    QCOMPARE(chunkSpy.last().at(2).toLongLong(), 100);
+    QCOMPARE(progressSpy.last().at(0).toLongLong(), data.size());
+    QCOMPARE(upload.bytesUploaded(), data.size());
+    QCOMPARE(upload.bytesResumed(), 0);
+    QVERIFY(upload.throughput() > 0);
+    QCOMPARE(server.contents(upload.uploadUrl()), data);
+}
+
+void QGCChunkedUploadTest::_testParallelStreams()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+
+    const QByteArray data = _testData(10000);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1000);
+    upload.setParallelStreams(4);
+
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QSignalSpy chunkSpy(&upload, &QGCChunkedUpload::chunkUploaded);
+
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY2(finishedSpy.first().at(0).toBool(), qPrintable(finishedSpy.first().at(2).toString()));
+
+    QSet<int> streams;
+    for (const QList<QVariant> &chunk : chunkSpy) {
+        streams.insert(chunk.at(0).toInt());
+    }
+    QCOMPARE(streams.size(), 4);
+    QCOMPARE(chunkSpy.count(), 10);
+
+    // Four partial uploads plus the final concatenation
+    QCOMPARE(server.createCount, 5);
+    QCOMPARE(server.contents(upload.uploadUrl()), data);
+}
+
+void QGCChunkedUploadTest::_testResumeAfterInterruption()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+    server.acceptPatches = 3;
+
+    const QString resumeKey = QStringLiteral("QGCChunkedUploadTest/resume");
+    const QByteArray data = _testData(8000);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    {
+        QGCChunkedUpload upload(&networkManager);
+        upload.setEndpoint(server.endpoint());
+        upload.setChunkSize(1000);
+        upload.setMaxRetries(0);
+        upload.setResumeKey(resumeKey);
+
+        QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+        QVERIFY(upload.start(&buffer));
+        QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+        QVERIFY(!finishedSpy.first().at(0).toBool());
+        QCOMPARE(upload.state(), QGCChunkedUpload::State::Failed);
+        QCOMPARE(upload.bytesUploaded(), 3000);
+    }
+
+    server.acceptPatches = -1;
+    server.patchBytes = 0;
+
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1000);
+    upload.setResumeKey(resumeKey);
+
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY2(finishedSpy.first().at(0).toBool(), qPrintable(finishedSpy.first().at(2).toString()));
+
+    // Only the missing part was sent, to the upload created by the first session
+    QCOMPARE(server.createCount, 1);
+    QCOMPARE(server.patchBytes, 5000);
+    QCOMPARE(upload.bytesResumed(), 3000);
+    QCOMPARE(server.contents(upload.uploadUrl()), data);
+}
+
+void QGCChunkedUploadTest::_testRetryAfterServerError()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+    server.failPatches = 2;
+
+    const QByteArray data = _testData(3000);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1000);
+    upload.setMaxRetries(3);
+
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY2(finishedSpy.first().at(0).toBool(), qPrintable(finishedSpy.first().at(2).toString()));
+
+    QCOMPARE(server.failedPatchCount, 2);
+    QCOMPARE(server.patchCount, 3);
+    QCOMPARE(server.contents(upload.uploadUrl()), data);
+}
+
+void QGCChunkedUploadTest::_testConflictRetries()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+    server.conflictPatches = 1;
+
+    const QByteArray data = _testData(3000);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1000);
+    upload.setMaxRetries(2);
+
+    // A single conflict is resolved by asking the server for its offset
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY2(finishedSpy.first().at(0).toBool(), qPrintable(finishedSpy.first().at(2).toString()));
+    QCOMPARE(server.conflictPatchCount, 1);
+    QCOMPARE(server.contents(upload.uploadUrl()), data);
+}
+
+void QGCChunkedUploadTest::_testPersistentConflictFails()
+{
+    TusTestServer server;
+    QVERIFY(server.listen());
+    server.conflictPatches = -1;
+
+    const QByteArray data = _testData(3000);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(server.endpoint());
+    upload.setChunkSize(1000);
+    upload.setMaxRetries(2);
+
+    // HEAD keeps reporting the offset PATCH keeps rejecting, the retries run out instead of looping forever
+    QSignalSpy finishedSpy(&upload, &QGCChunkedUpload::finished);
+    QVERIFY(upload.start(&buffer));
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    QVERIFY(!finishedSpy.first().at(0).toBool());
+    QCOMPARE(upload.state(), QGCChunkedUpload::State::Failed);
+    QCOMPARE(server.conflictPatchCount, 3);
+    QCOMPARE(server.patchCount, 0);
+    QCOMPARE(upload.bytesUploaded(), 0);
+}
+
+void QGCChunkedUploadTest::_testRejectsSequentialDevice()
+{
+    SequentialBuffer buffer;
+    buffer.setData(_testData(100));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNetworkAccessManager networkManager;
+    QGCChunkedUpload upload(&networkManager);
+    upload.setEndpoint(QUrl(QStringLiteral("http://127.0.0.1/files")));
+
+    QVERIFY(!upload.start(&buffer));
+    QCOMPARE(upload.state(), QGCChunkedUpload::State::Idle);
+    QVERIFY(!upload.errorString().isEmpty());
+}
+
+UT_REGISTER_TEST(QGCChunkedUploadTest, TestLabel::Unit, TestLabel::Utilities, TestLabel::Network)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Tests for QGCChunkedUpload against a local tus stand-in server
+class QGCChunkedUploadTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testSingleStreamUpload();
+    void _testParallelStreams();
+    void _testResumeAfterInterruption();
+    void _testRetryAfterServerError();
+    void _testConflictRetries();
+    void _testPersistentConflictFails();
+    void _testRejectsSequentialDevice();
+};
@@ -0,0 +1,286 @@
+#include "BootloaderEmulator.h"
+#include "QGCMath.h"
+
+#include <QtCore/QtEndian>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint8_t kInSync        = 0x12;
+constexpr uint8_t kEOC           = 0x20;
+constexpr uint8_t kOK            = 0x10;
+constexpr uint8_t kFailed        = 0x11;
+constexpr uint8_t kInvalid       = 0x13;
+
+constexpr uint8_t kGetSync       = 0x21;
+constexpr uint8_t kGetDevice     = 0x22;
+constexpr uint8_t kChipErase     = 0x23;
+constexpr uint8_t kChipVerify    = 0x24;
+constexpr uint8_t kProgMulti     = 0x27;
+constexpr uint8_t kReadMulti     = 0x28;
+constexpr uint8_t kGetCRC        = 0x29;
+constexpr uint8_t kBoot          = 0x30;
+
+constexpr uint8_t kInfoBlRev     = 1;
+constexpr uint8_t kInfoBoardId   = 2;
+constexpr uint8_t kInfoBoardRev  = 3;
+constexpr uint8_t kInfoFlashSize = 4;
+
+constexpr uint32_t kBlRev        = 5;
+
+QByteArray le32(uint32_t value)
+{
+    QByteArray bytes(sizeof(value), Qt::Uninitialized);
+    qToLittleEndian(value, bytes.data());
+    return bytes;
+}
+
+} // namespace
+
+BootloaderEmulator::BootloaderEmulator(uint32_t boardId, uint32_t flashSize)
+    : _boardId(boardId)
+    , _flashSize(flashSize)
+    , _flash(static_cast<qsizetype>(flashSize), static_cast<char>(0xFF))
+{
+
+}
+
+BootloaderEmulator::~BootloaderEmulator()
+{
+    stop();
+}
+
+bool BootloaderEmulator::start()
+{
+    _masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (_masterFd < 0) {
+        return false;
+    }
+    if ((grantpt(_masterFd) != 0) || (unlockpt(_masterFd) != 0)) {
+        stop();
+        return false;
+    }
+
+    const char *const slaveName = ptsname(_masterFd);
+    if (!slaveName) {
+        stop();
+        return false;
+    }
+    _portName = QString::fromLocal8Bit(slaveName);
+
+    _slaveFd = ::open(slaveName, O_RDWR | O_NOCTTY);
+    if (_slaveFd < 0) {
+        stop();
+        return false;
+    }
+
+    // No echo or line discipline until Bootloader configures the port itself
+    struct termios attributes{};
+    if (tcgetattr(_slaveFd, &attributes) == 0) {
+        cfmakeraw(&attributes);
+        (void) tcsetattr(_slaveFd, TCSANOW, &attributes);
+    }
+
+    _clock.start();
+    _running = true;
+    _thread = std::thread(&BootloaderEmulator::_run, this);
+    return true;
+}
+
+void BootloaderEmulator::stop()
+{
+    _running = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_slaveFd >= 0) {
+        (void) ::close(_slaveFd);
+        _slaveFd = -1;
+    }
+    if (_masterFd >= 0) {
+        (void) ::close(_masterFd);
+        _masterFd = -1;
+    }
+}
+
+void BootloaderEmulator::_run()
+{
+    while (_running) {
+        _sendDueResponses();
+
+        int timeoutMsecs = 20;
+        if (!_responses.empty()) {
+            const qint64 waitUsecs = _responses.front().dueUsecs - (_clock.nsecsElapsed() / 1000);
+            timeoutMsecs = static_cast<int>(std::clamp<qint64>((waitUsecs + 999) / 1000, 0, timeoutMsecs));
+        }
+
+        struct pollfd pfd{ _masterFd, POLLIN, 0 };
+        if ((::poll(&pfd, 1, timeoutMsecs) > 0) && (pfd.revents & POLLIN)) {
+            char buffer[1024];
+            const ssize_t count = ::read(_masterFd, buffer, sizeof(buffer));
+            if (count > 0) {
+                _received.append(buffer, count);
+                _handleCommands();
+            }
+        }
+    }
+}
+
+void BootloaderEmulator::_sendDueResponses()
+{
+    const qint64 nowUsecs = _clock.nsecsElapsed() / 1000;
+    while (!_responses.empty() && (_responses.front().dueUsecs <= nowUsecs)) {
+        const Response &response = _responses.front();
+        qsizetype written = 0;
+        while (written < response.bytes.size()) {
+            const ssize_t count = ::write(_masterFd, response.bytes.constData() + written, response.bytes.size() - written);
+            if (count <= 0) {
+                break;
+            }
+            written += count;
+        }
+        if (response.programChunk) {
+            _programChunksInFlight--;
+        }
+        _responses.pop_front();
+    }
+}
+
+void BootloaderEmulator::_respond(const QByteArray &bytes, bool programChunk)
+{
+    _responses.push_back({ (_clock.nsecsElapsed() / 1000) + _latencyUsecs, bytes, programChunk });
+}
+
+void BootloaderEmulator::_respondInSync(uint8_t status, bool programChunk)
+{
+    const char bytes[2] = { static_cast<char>(kInSync), static_cast<char>(status) };
+    _respond(QByteArray(bytes, sizeof(bytes)), programChunk);
+}
+
+void BootloaderEmulator::_handleCommands()
+{
+    while (!_received.isEmpty()) {
+        const uint8_t command = static_cast<uint8_t>(_received.at(0));
+
+        qsizetype length = 2;
+        switch (command) {
+        case kGetDevice:
+            length = 3;
+            break;
+        case kReadMulti:
+            length = 3;
+            break;
+        case kProgMulti:
+            if (_received.size() < 2) {
+                return;
+            }
+            length = static_cast<uint8_t>(_received.at(1)) + 3;
+            break;
+        case kGetSync:
+        case kChipErase:
+        case kChipVerify:
+        case kGetCRC:
+        case kBoot:
+            break;
+        default:
+            // Out of sync, skip to the next byte which may start a command
+            _received.remove(0, 1);
+            continue;
+        }
+
+        if (_received.size() < length) {
+            return;
+        }
+
+        const QByteArray packet = _received.left(length);
+        _received.remove(0, length);
+        if (static_cast<uint8_t>(packet.back()) != kEOC) {
+            _respondInSync(kInvalid);
+            continue;
+        }
+
+        switch (command) {
+        case kGetSync:
+            _respondInSync(kOK);
+            break;
+        case kGetDevice:
+        {
+            uint32_t value = 0;
+            switch (static_cast<uint8_t>(packet.at(1))) {
+            case kInfoBlRev:
+                value = kBlRev;
+                break;
+            case kInfoBoardId:
+                value = _boardId;
+                break;
+            case kInfoBoardRev:
+                value = 0;
+                break;
+            case kInfoFlashSize:
+                value = _flashSize;
+                break;
+            default:
+                _respondInSync(kInvalid);
+                continue;
+            }
+            _respond(le32(value));
+            _respondInSync(kOK);
+            break;
+        }
+        case kChipErase:
+            _flash.fill(static_cast<char>(0xFF));
+            _address = 0;
+            _respondInSync(kOK);
+            break;
+        case kChipVerify:
+            _address = 0;
+            _respondInSync(kOK);
+            break;
+        case kProgMulti:
+        {
+            const int chunk = _programChunks++;
+            _maxChunksInFlight = std::max(_maxChunksInFlight, ++_programChunksInFlight);
+
+            const qsizetype count = packet.size() - 3;
+            if ((chunk == _failChunk) || ((_address + count) > _flashSize)) {
+                _respondInSync(kFailed, true);
+                break;
+            }
+            (void) _flash.replace(_address, count, packet.mid(2, count));
+            _address += count;
+            if (chunk == _dropChunk) {
+                _programChunksInFlight--;
+                break;
+            }
+            _respondInSync(kOK, true);
+            break;
+        }
+        case kReadMulti:
+        {
+            const qsizetype count = static_cast<uint8_t>(packet.at(1));
+            _respond(_flash.mid(_address, count));
+            _address += count;
+            _respondInSync(kOK);
+            break;
+        }
+        case kGetCRC:
+            _respond(le32(QGC::crc32(reinterpret_cast<const quint8*>(_flash.constData()), _flashSize, 0)));
+            _respondInSync(kOK);
+            break;
+        case kBoot:
+            _booted = true;
+            _respondInSync(kOK);
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QString>
+
+#include <atomic>
+#include <deque>
+#include <thread>
+
+/// Emulates a PX4 bootloader (protocol revision 5) on the master side of a pseudo terminal, so Bootloader talks to it
+/// through a real serial port. Responses are delayed by a fixed latency without holding back the commands which follow,
+/// the way a USB round trip delays them, which makes the cost of stop-and-wait programming measurable.
+///
+/// Configure before start(), read the results after stop().
+class BootloaderEmulator
+{
+public:
+    BootloaderEmulator(uint32_t boardId, uint32_t flashSize);
+    ~BootloaderEmulator();
+
+    bool start();
+    void stop();
+
+    /// Slave side of the pty, to be opened by Bootloader
+    QString portName() const { return _portName; }
+
+    void setResponseLatencyUsecs(int usecs) { _latencyUsecs = usecs; }
+
+    /// PROTO_PROG_MULTI chunk (0 based) answered with INSYNC/FAILED
+    void setFailProgramChunk(int index) { _failChunk = index; }
+
+    /// PROTO_PROG_MULTI chunk (0 based) which is written but never answered
+    void setDropProgramChunk(int index) { _dropChunk = index; }
+
+    const QByteArray &flash() const { return _flash; }
+    int programChunks() const { return _programChunks; }
+
+    /// Most PROTO_PROG_MULTI chunks received before the host had their responses
+    int maxChunksInFlight() const { return _maxChunksInFlight; }
+
+    bool booted() const { return _booted; }
+
+private:
+    struct Response {
+        qint64 dueUsecs;
+        QByteArray bytes;
+        bool programChunk;
+    };
+
+    void _run();
+    void _handleCommands();
+    void _respond(const QByteArray &bytes, bool programChunk = false);
+    void _respondInSync(uint8_t status, bool programChunk = false);
+    void _sendDueResponses();
+
+    const uint32_t _boardId;
+    const uint32_t _flashSize;
+
+    int _masterFd = -1;
+    int _slaveFd = -1;                  ///< Held open so the master does not hang up while Bootloader reopens the port
+    QString _portName;
+    std::thread _thread;
+    std::atomic<bool> _running = false;
+    QElapsedTimer _clock;
+
+    QByteArray _flash;
+    uint32_t _address = 0;
+    QByteArray _received;
+    std::deque<Response> _responses;
+    int _programChunksInFlight = 0;
+
+    int _latencyUsecs = 0;
+    int _failChunk = -1;
+    int _dropChunk = -1;
+    int _programChunks = 0;
+    int _maxChunksInFlight = 0;
+    std::atomic<bool> _booted = false;
+};
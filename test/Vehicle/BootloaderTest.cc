@@ -0,0 +1,164 @@
+#include "BootloaderTest.h"
+#include "Bootloader.h"
+#include "BootloaderEmulator.h"
+#include "FirmwareImage.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr uint32_t kBoardId = 50;
+constexpr uint32_t kFlashSize = 256 * 1024;
+constexpr int kChunkSize = 64;          ///< Bootloader's PROG_MULTI_MAX
+
+QByteArray writeImage(const QTemporaryDir &dir, int size)
+{
+    QByteArray bytes(size, Qt::Uninitialized);
+    QRandomGenerator generator(size);
+    for (char &byte : bytes) {
+        byte = static_cast<char>(generator.bounded(256));
+    }
+
+    QFile file(dir.filePath(QStringLiteral("firmware.bin")));
+    if (!file.open(QIODevice::WriteOnly) || (file.write(bytes) != bytes.size())) {
+        return QByteArray();
+    }
+    return bytes;
+}
+
+/// Connects, reads the board info and erases, as PX4FirmwareUpgradeThreadWorker does before programming
+bool prepare(Bootloader &bootloader, const BootloaderEmulator &emulator)
+{
+    uint32_t bootloaderVersion = 0;
+    uint32_t boardId = 0;
+    uint32_t flashSize = 0;
+    return bootloader.open(emulator.portName())
+        && bootloader.getBoardInfo(bootloaderVersion, boardId, flashSize)
+        && (boardId == kBoardId)
+        && bootloader.erase();
+}
+
+} // namespace
+
+void BootloaderTest::_programAndVerify_data()
+{
+    QTest::addColumn<int>("window");
+
+    QTest::newRow("stop-and-wait") << 1;
+    QTest::newRow("pipelined") << 8;
+}
+
+void BootloaderTest::_programAndVerify()
+{
+    QFETCH(int, window);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    // Not a multiple of the chunk size, the last chunk is short
+    const QByteArray bytes = writeImage(dir, (100 * kChunkSize) + 12);
+    QVERIFY(!bytes.isEmpty());
+    FirmwareImage image;
+    QVERIFY(image.load(dir.filePath(QStringLiteral("firmware.bin")), kBoardId));
+
+    BootloaderEmulator emulator(kBoardId, kFlashSize);
+    emulator.setResponseLatencyUsecs(500);
+    QVERIFY(emulator.start());
+
+    Bootloader bootloader(false /* sikRadio */);
+    bootloader.setProgramWindow(window);
+    QVERIFY2(prepare(bootloader, emulator), qPrintable(bootloader.errorString()));
+    QVERIFY2(bootloader.program(&image), qPrintable(bootloader.errorString()));
+    QVERIFY2(bootloader.verify(&image), qPrintable(bootloader.errorString()));
+    QVERIFY(bootloader.programMsecs() >= 0);
+    QVERIFY(bootloader.verifyMsecs() >= 0);
+    bootloader.close();
+    emulator.stop();
+
+    QVERIFY(emulator.booted());
+    QCOMPARE(emulator.flash().left(bytes.size()), bytes);
+    QCOMPARE(emulator.programChunks(), 101);
+    QVERIFY(emulator.maxChunksInFlight() <= window);
+}
+
+void BootloaderTest::_pipelineThroughput()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(!writeImage(dir, 64 * 1024).isEmpty());
+    FirmwareImage image;
+    QVERIFY(image.load(dir.filePath(QStringLiteral("firmware.bin")), kBoardId));
+
+    qint64 programMsecs[2] = {};
+    const int windows[2] = { 1, 8 };
+    for (int i = 0; i < 2; i++) {
+        // 1024 chunks with 2 msecs per round trip: over 2 s stop-and-wait
+        BootloaderEmulator emulator(kBoardId, kFlashSize);
+        emulator.setResponseLatencyUsecs(2000);
+        QVERIFY(emulator.start());
+
+        Bootloader bootloader(false /* sikRadio */);
+        bootloader.setProgramWindow(windows[i]);
+        QVERIFY2(prepare(bootloader, emulator), qPrintable(bootloader.errorString()));
+        QVERIFY2(bootloader.program(&image), qPrintable(bootloader.errorString()));
+        programMsecs[i] = bootloader.programMsecs();
+        bootloader.close();
+        emulator.stop();
+
+        QVERIFY(emulator.maxChunksInFlight() <= windows[i]);
+    }
+
+    qCDebug(UnitTestLog) << "Program msecs - stop-and-wait:" << programMsecs[0] << "pipelined:" << programMsecs[1];
+    QVERIFY(programMsecs[0] >= 2048);
+    QVERIFY((programMsecs[1] * 2) < programMsecs[0]);
+}
+
+void BootloaderTest::_programFailureKeepsSync()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(!writeImage(dir, 200 * kChunkSize).isEmpty());
+    FirmwareImage image;
+    QVERIFY(image.load(dir.filePath(QStringLiteral("firmware.bin")), kBoardId));
+
+    BootloaderEmulator emulator(kBoardId, kFlashSize);
+    emulator.setResponseLatencyUsecs(500);
+    emulator.setFailProgramChunk(100);
+    QVERIFY(emulator.start());
+
+    Bootloader bootloader(false /* sikRadio */);
+    QVERIFY2(prepare(bootloader, emulator), qPrintable(bootloader.errorString()));
+    QVERIFY(!bootloader.program(&image));
+
+    // The failure is reported for the chunk which failed, not for the last one sent
+    QVERIFY2(bootloader.errorString().contains(QStringLiteral("PROTO_FAILED")), qPrintable(bootloader.errorString()));
+    QVERIFY2(bootloader.errorString().contains(QStringLiteral("0x00001900")), qPrintable(bootloader.errorString()));
+
+    // Responses to the chunks which were already in flight must not be taken for the next command's
+    QVERIFY2(bootloader.erase(), qPrintable(bootloader.errorString()));
+    bootloader.close();
+}
+
+void BootloaderTest::_lostResponseTimesOut()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(!writeImage(dir, 50 * kChunkSize).isEmpty());
+    FirmwareImage image;
+    QVERIFY(image.load(dir.filePath(QStringLiteral("firmware.bin")), kBoardId));
+
+    BootloaderEmulator emulator(kBoardId, kFlashSize);
+    emulator.setDropProgramChunk(10);
+    QVERIFY(emulator.start());
+
+    Bootloader bootloader(false /* sikRadio */);
+    QVERIFY2(prepare(bootloader, emulator), qPrintable(bootloader.errorString()));
+    QVERIFY(!bootloader.program(&image));
+    QVERIFY2(bootloader.errorString().contains(QStringLiteral("Timeout")), qPrintable(bootloader.errorString()));
+    bootloader.close();
+}
+
+UT_REGISTER_TEST(BootloaderTest, TestLabel::Integration, TestLabel::Vehicle, TestLabel::Serial)
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Flashes Bootloader against BootloaderEmulator on a pseudo terminal
+class BootloaderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _programAndVerify_data();
+    void _programAndVerify();
+    void _pipelineThroughput();
+    void _programFailureKeepsSync();
+    void _lostResponseTimesOut();
+};
@@ -22,6 +22,8 @@
 #include "MavlinkSettings.h"
 #include "SettingsManager.h"
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
 #include <QtCore/qscopeguard.h>
 #include <QtTest/QTest>
@@ -533,4 +535,100 @@ void InitialConnectTest::_stateRunMatrix()
     _disconnectMockLink();
 }
 
+void InitialConnectTest::_connectMockLinkWithLatency(int latencyMSecs)
+{
+    LinkManager::instance()->setConnectionsAllowed();
+
+    auto* mvm = MultiVehicleManager::instance();
+    QSignalSpy activeVehicleSpy{mvm, &MultiVehicleManager::activeVehicleChanged};
+
+    auto* mockConfig = new MockConfiguration(QStringLiteral("LatencyMock"));
+    mockConfig->setFirmwareType(MAV_AUTOPILOT_PX4);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setResponseLatencyMSecs(latencyMSecs);
+    mockConfig->setDynamic(true);
+
+    SharedLinkConfigurationPtr linkConfig = LinkManager::instance()->addConfiguration(mockConfig);
+    QVERIFY(LinkManager::instance()->createConnectedLink(linkConfig));
+
+    _mockLink = qobject_cast<MockLink*>(linkConfig->link());
+    QVERIFY(_mockLink);
+
+    QVERIFY(activeVehicleSpy.wait(TestTimeout::longMs()));
+    _vehicle = mvm->activeVehicle();
+    QVERIFY(_vehicle);
+
+    QSignalSpy initialConnectCompleteSpy{_vehicle, &Vehicle::initialConnectComplete};
+    if (!_vehicle->isInitialConnectComplete()) {
+        QVERIFY(initialConnectCompleteSpy.wait(TestTimeout::longMs()));
+    }
+}
+
+void InitialConnectTest::_connectProfile()
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QVERIFY(_vehicle);
+
+    auto* initialConnectStateMachine = _vehicle->findChild<InitialConnectStateMachine*>();
+    QVERIFY(initialConnectStateMachine);
+
+    const InitialConnectProfile& profile = initialConnectStateMachine->profile();
+    QVERIFY(!profile.isRunning());
+    QVERIFY(profile.timeToReadyMs() >= 0);
+    QCOMPARE(profile.vehicleId(), _vehicle->id());
+    QCOMPARE(profile.phases().count(), static_cast<qsizetype>(InitialConnectStateMachine::PhaseCount));
+
+    for (const InitialConnectProfile::Phase& phase : profile.phases()) {
+        QVERIFY2(phase.startMs >= 0, qPrintable(phase.name));
+        QVERIFY2(phase.outcome != InitialConnectProfile::Outcome::Pending, qPrintable(phase.name));
+        QVERIFY2(phase.startMs + phase.durationMs <= profile.timeToReadyMs(), qPrintable(phase.name));
+    }
+
+    const InitialConnectProfile::Phase* autopilotVersion = profile.phase(QStringLiteral("AutopilotVersion"));
+    const InitialConnectProfile::Phase* parameters = profile.phase(QStringLiteral("Parameters"));
+    const InitialConnectProfile::Phase* mission = profile.phase(QStringLiteral("Mission"));
+    QVERIFY(autopilotVersion && parameters && mission);
+
+    QCOMPARE(autopilotVersion->outcome, InitialConnectProfile::Outcome::Completed);
+    QVERIFY(autopilotVersion->messagesReceived > 0);
+    QCOMPARE(parameters->outcome, InitialConnectProfile::Outcome::Completed);
+    QVERIFY(parameters->messagesReceived > 0);
+    QVERIFY(parameters->bytesReceived > parameters->messagesReceived);
+    QCOMPARE(mission->outcome, InitialConnectProfile::Outcome::Completed);
+
+    // Everything after AUTOPILOT_VERSION waits for it, the plan download overlaps the parameters
+    QVERIFY(mission->startMs >= autopilotVersion->startMs + autopilotVersion->durationMs);
+    QVERIFY(mission->startMs < parameters->startMs + parameters->durationMs);
+
+    const QJsonObject json = initialConnectStateMachine->profileJson();
+    QCOMPARE(json[QStringLiteral("timeToReadyMs")].toInteger(), profile.timeToReadyMs());
+    QCOMPARE(json[QStringLiteral("phases")].toArray().count(), static_cast<qsizetype>(InitialConnectStateMachine::PhaseCount));
+
+    _disconnectMockLink();
+}
+
+void InitialConnectTest::_timeToReadyWithLatency()
+{
+    // Not a nanobench benchmark: a single connect takes seconds, the profile is the measurement
+    for (const int latencyMSecs : { 0, 20 }) {
+        _connectMockLinkWithLatency(latencyMSecs);
+        QVERIFY(_vehicle);
+
+        auto* initialConnectStateMachine = _vehicle->findChild<InitialConnectStateMachine*>();
+        QVERIFY(initialConnectStateMachine);
+        const InitialConnectProfile& profile = initialConnectStateMachine->profile();
+
+        qCDebug(UnitTestLog).noquote() << "Response latency" << latencyMSecs << "ms:" << profile.summary();
+
+        QVERIFY(profile.timeToReadyMs() >= 0);
+        if (latencyMSecs > 0) {
+            // Each plan type takes several round trips, running them alongside the parameters must pay off
+            QVERIFY2(profile.timeToReadyMs() < profile.serialTimeMs(),
+                     qPrintable(QStringLiteral("%1 >= %2").arg(profile.timeToReadyMs()).arg(profile.serialTimeMs())));
+        }
+
+        _disconnectMockLink();
+    }
+}
+
 UT_REGISTER_TEST(InitialConnectTest, TestLabel::Integration, TestLabel::Vehicle)
@@ -20,4 +20,9 @@ private slots:
     void _stateTimeoutFallsThrough();
     void _stateRunMatrix_data();
     void _stateRunMatrix();
+    void _connectProfile();
+    void _timeToReadyWithLatency();
+
+private:
+    void _connectMockLinkWithLatency(int latencyMSecs);
 };
@@ -1,12 +1,58 @@
 #include "MAVLinkLogManagerTest.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
 
+#include <cstring>
+#include <vector>
+
+#include <ulog_cpp/messages.hpp>
+#include <ulog_cpp/writer.hpp>
+
+#include "AppSettings.h"
+#include "LogFileParser.h"
 #include "MAVLinkLogManager.h"
 #include "MultiVehicleManager.h"
+#include "QmlObjectListModel.h"
+#include "SettingsManager.h"
+#include "ULogStreamDecoder.h"
 #include "UnitTest.h"
 #include "Vehicle.h"
 
+namespace {
+
+QByteArray buildULog(int samples)
+{
+    std::vector<uint8_t> buffer;
+    ulog_cpp::Writer writer([&](const uint8_t *data, int length) {
+        buffer.insert(buffer.end(), data, data + length);
+    });
+
+    writer.fileHeader(ulog_cpp::FileHeader{});
+    writer.messageFormat(ulog_cpp::MessageFormat{
+        "sensor_combined",
+        {ulog_cpp::Field{"uint64_t", "timestamp"},
+         ulog_cpp::Field{"float", "gyro_rad_x"}}
+    });
+    writer.headerComplete();
+
+    writer.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "sensor_combined"});
+    for (int i = 0; i < samples; i++) {
+        const uint64_t ts = 1000000ULL + (static_cast<uint64_t>(i) * 10000ULL);
+        const float value = static_cast<float>(i);
+        std::vector<uint8_t> payload(12);
+        memcpy(payload.data(),     &ts,    8);
+        memcpy(payload.data() + 8, &value, 4);
+        writer.data(ulog_cpp::Data{1, std::move(payload)});
+    }
+
+    return QByteArray(reinterpret_cast<const char *>(buffer.data()), static_cast<int>(buffer.size()));
+}
+
+} // namespace
+
 void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
 {
     _connectMockLinkNoInitialConnectSequence();
@@ -16,4 +62,47 @@ void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
     QVERIFY(mavlinkLogManager);
 }
 
+void MAVLinkLogManagerTest::_testLiveDecode()
+{
+    const QTemporaryDir saveDir;
+    QVERIFY(saveDir.isValid());
+    AppSettings* const appSettings = SettingsManager::instance()->appSettings();
+    appSettings->savePath()->setRawValue(saveDir.path());
+    appSettings->disableAllPersistence()->setRawValue(false);
+    QVERIFY(QDir().mkpath(appSettings->logSavePath()));
+
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    const QByteArray ulog = buildULog(200);
+    _mockLink->setMavlinkLogStream(ulog);
+
+    MAVLinkLogManager* const mavlinkLogManager = new MAVLinkLogManager(_vehicle, this);
+    mavlinkLogManager->setEnableAutoUpload(false);
+    mavlinkLogManager->startLogging();
+    QVERIFY(mavlinkLogManager->logRunning());
+
+    ULogStreamDecoder* const liveLog = mavlinkLogManager->liveLog();
+    QVERIFY(liveLog);
+    LogFileParser parser;
+    parser.attachLiveLog(liveLog);
+
+    // MockLink replays the log as LOGGING_DATA, the decoder sees every byte written to the file
+    const QString field = QStringLiteral("sensor_combined.gyro_rad_x");
+    QTRY_COMPARE(liveLog->bytesDecoded(), static_cast<qint64>(ulog.size()));
+    QCOMPARE(parser.fieldSamples(field).size(), 200);
+    QTRY_VERIFY(parser.plottableFields().contains(field));
+    QVERIFY(parser.live());
+
+    mavlinkLogManager->stopLogging();
+    QVERIFY(liveLog->finished());
+    QVERIFY(!parser.live());
+    QCOMPARE(parser.fieldSamples(field).size(), 200);
+    QCOMPARE(parser.fieldSamples(field).constLast().toPointF().y(), 199.0);
+
+    QCOMPARE(mavlinkLogManager->logFiles()->count(), 1);
+    const MAVLinkLogFiles* const logFile = mavlinkLogManager->logFiles()->value<MAVLinkLogFiles*>(0);
+    QFile file(QDir(appSettings->logSavePath()).filePath(logFile->name() + mavlinkLogManager->logExtension()));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), ulog);
+}
+
 UT_REGISTER_TEST(MAVLinkLogManagerTest, TestLabel::Integration, TestLabel::Vehicle)
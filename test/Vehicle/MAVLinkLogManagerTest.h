@@ -8,4 +8,5 @@ class MAVLinkLogManagerTest : public VehicleTestManualConnect
 
 private slots:
     void _testInitMAVLinkLogManager();
+    void _testLiveDecode();
 };
@@ -0,0 +1,129 @@
+#include "MessageRateControllerTest.h"
+
+#include "MAVLinkLib.h"
+#include "MavlinkSettings.h"
+#include "MessageRateController.h"
+#include "MockLink.h"
+#include "SettingsManager.h"
+#include "Vehicle.h"
+
+#include <QtCore/QElapsedTimer>
+
+void MessageRateControllerTest::init()
+{
+    VehicleTestNoInitialConnect::init();
+
+    MavlinkSettings* settings = SettingsManager::instance()->mavlinkSettings();
+    QVERIFY(settings);
+    QVERIFY(vehicle());
+    QVERIFY(vehicle()->messageRateController());
+
+    _savedAdaptiveRateControl = settings->adaptiveRateControl()->rawValue();
+    _savedAdaptiveRateBudget = settings->adaptiveRateBudget()->rawValue();
+}
+
+void MessageRateControllerTest::cleanup()
+{
+    MavlinkSettings* settings = SettingsManager::instance()->mavlinkSettings();
+    QVERIFY(settings);
+
+    settings->adaptiveRateControl()->setRawValue(_savedAdaptiveRateControl);
+    settings->adaptiveRateBudget()->setRawValue(_savedAdaptiveRateBudget);
+
+    VehicleTestNoInitialConnect::cleanup();
+}
+
+// Nothing observes the LOCAL_POSITION_NED fact group, so its 10Hz default is renegotiated down to the display rate
+void MessageRateControllerTest::_unconsumedStreamsThrottled()
+{
+    MessageRateController* controller = vehicle()->messageRateController();
+    QVERIFY(!controller->enabled());
+
+    SettingsManager::instance()->mavlinkSettings()->adaptiveRateControl()->setRawValue(true);
+    QVERIFY(controller->enabled());
+
+    QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 2, 10000);
+    QTRY_COMPARE_WITH_TIMEOUT(mockLink()->messageInterval(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 500000, 10000);
+
+    // Disabling hands every stream back to the vehicle's default
+    SettingsManager::instance()->mavlinkSettings()->adaptiveRateControl()->setRawValue(false);
+    QCOMPARE(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 0);
+    QTRY_COMPARE_WITH_TIMEOUT(mockLink()->messageInterval(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 0, 10000);
+}
+
+// A consumer which needs every message, such as a chart, brings the stream back to its default rate
+void MessageRateControllerTest::_consumerRestoresDefault()
+{
+    MessageRateController* controller = vehicle()->messageRateController();
+    SettingsManager::instance()->mavlinkSettings()->adaptiveRateControl()->setRawValue(true);
+
+    QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 2, 10000);
+
+    {
+        QObject consumer;
+        controller->requestRate(&consumer, MAVLINK_MSG_ID_LOCAL_POSITION_NED, MessageRateController::kFullRateHz);
+        QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 0, 10000);
+        QTRY_COMPARE_WITH_TIMEOUT(mockLink()->messageInterval(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 0, 10000);
+    }
+
+    // The request goes away with its consumer
+    QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 2, 10000);
+}
+
+// A stream feeding an observed fact group is demanded at the group's update rate: the Vehicle group, which takes the
+// altitudes from GLOBAL_POSITION_INT, updates at 100 ms and so keeps MockLink's 10Hz default
+void MessageRateControllerTest::_observedFactGroupKeepsRate()
+{
+    MessageRateController* controller = vehicle()->messageRateController();
+    SettingsManager::instance()->mavlinkSettings()->adaptiveRateControl()->setRawValue(true);
+
+    QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 2, 10000);
+
+    {
+        QObject display;
+        (void) connect(vehicle()->altitudeRelative(), &Fact::valueChanged, &display, []() {});
+        QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 0, 10000);
+        QTRY_COMPARE_WITH_TIMEOUT(mockLink()->messageInterval(MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 0, 10000);
+
+        // Streams feeding groups nobody observes stay throttled
+        QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED), 2, 10000);
+    }
+
+    // The demand goes away with the display
+    QTRY_COMPARE_WITH_TIMEOUT(controller->commandedRate(MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 2, 10000);
+}
+
+// Behind a radio slower than the vehicle's default traffic the streams are throttled until nothing is dropped anymore
+void MessageRateControllerTest::_capacityLimitedLink()
+{
+    static constexpr int kCapacity = 3000;
+
+    MessageRateController* controller = vehicle()->messageRateController();
+    MavlinkSettings* settings = SettingsManager::instance()->mavlinkSettings();
+
+    mockLink()->setLinkCapacity(kCapacity);
+    QTRY_VERIFY_WITH_TIMEOUT(mockLink()->linkCapacityDroppedBytes() > 0, 10000);
+
+    settings->adaptiveRateBudget()->setRawValue(2000);
+    settings->adaptiveRateControl()->setRawValue(true);
+
+    QElapsedTimer settle;
+    settle.start();
+    quint64 droppedBytes = mockLink()->linkCapacityDroppedBytes();
+    int quietSeconds = 0;
+    while ((quietSeconds < 3) && !settle.hasExpired(30000)) {
+        QTest::qWait(1000);
+        const quint64 nowDropped = mockLink()->linkCapacityDroppedBytes();
+        quietSeconds = (nowDropped == droppedBytes) ? (quietSeconds + 1) : 0;
+        droppedBytes = nowDropped;
+    }
+    QCOMPARE_GE(quietSeconds, 3);
+
+    QVERIFY(controller->commandedRate(MAVLINK_MSG_ID_LOCAL_POSITION_NED) > 0);
+    QCOMPARE_LE(controller->_linkRate.bytesPerSec(), static_cast<double>(kCapacity));
+    QCOMPARE_LE(controller->_lossPercent, MessageRateController::kLossThresholdPercent);
+
+    mockLink()->setLinkCapacity(0);
+}
+
+UT_REGISTER_TEST(MessageRateControllerTest, TestLabel::Integration, TestLabel::Vehicle)
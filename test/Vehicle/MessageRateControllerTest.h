@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QtCore/QVariant>
+
+#include "BaseClasses/VehicleTest.h"
+
+class MessageRateControllerTest : public VehicleTestNoInitialConnect
+{
+    Q_OBJECT
+
+public:
+    explicit MessageRateControllerTest(QObject* parent = nullptr)
+        : VehicleTestNoInitialConnect(parent)
+    {
+    }
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _unconsumedStreamsThrottled();
+    void _consumerRestoresDefault();
+    void _observedFactGroupKeepsRate();
+    void _capacityLimitedLink();
+
+private:
+    QVariant _savedAdaptiveRateControl;
+    QVariant _savedAdaptiveRateBudget;
+};
@@ -0,0 +1,151 @@
+#include "TrailEngineTest.h"
+#include "TrailEngine.h"
+
+#include <QtPositioning/QGeoRectangle>
+
+#include <cmath>
+
+#include "Benchmarking.h"
+
+namespace {
+
+const QGeoCoordinate kStart(47.3977419, 8.5455938, 488.0);
+
+/// Zig-zag heading east: 10 m steps with a 25 m amplitude every 8 samples
+QGeoCoordinate _zigZag(int index)
+{
+    const double north = ((index / 8) % 2) ? 25.0 : 0.0;
+    return kStart.atDistanceAndAzimuth(index * 10.0, 90.0).atDistanceAndAzimuth(north, 0.0);
+}
+
+void _fill(TrailEngine &trail, int count)
+{
+    for (int i = 0; i < count; i++) {
+        trail.append(_zigZag(i), i * 100);
+    }
+}
+
+} // namespace
+
+void TrailEngineTest::_testMemoryCap()
+{
+    TrailEngine trail(4 * TrailEngine::kChunkSize);
+    QCOMPARE(trail.maxSamples(), 4 * TrailEngine::kChunkSize);
+
+    _fill(trail, 20 * TrailEngine::kChunkSize);
+
+    QVERIFY(trail.count() <= trail.maxSamples());
+    QVERIFY(trail.trimCount() > 0);
+    QVERIFY(trail.coordinates().count() == trail.count());
+    QVERIFY(trail.last().distanceTo(_zigZag((20 * TrailEngine::kChunkSize) - 1)) < 0.05);
+
+    trail.clear();
+    QVERIFY(trail.isEmpty());
+    QVERIFY(trail.coordinates().isEmpty());
+}
+
+void TrailEngineTest::_testReplaceLast()
+{
+    TrailEngine trail;
+    trail.append(kStart, 0);
+    trail.append(kStart.atDistanceAndAzimuth(10, 0), 100);
+
+    const QGeoCoordinate moved = kStart.atDistanceAndAzimuth(20, 0);
+    trail.replaceLast(moved, 200);
+
+    QCOMPARE(trail.count(), 2);
+    QVERIFY(trail.last().distanceTo(moved) < 0.05);
+    QCOMPARE(trail.last().altitude(), moved.altitude());
+}
+
+void TrailEngineTest::_testStraightLineCollapses()
+{
+    TrailEngine trail;
+    const int count = (3 * TrailEngine::kChunkSize) + 10;
+    for (int i = 0; i < count; i++) {
+        trail.append(kStart.atDistanceAndAzimuth(i * 5.0, 45.0), i * 100);
+    }
+
+    QCOMPARE(trail.coordinates().count(), count);
+
+    // Only chunk end points survive any tolerance
+    const int simplified = trail.geometryPointCount(14, QGeoRectangle());
+    QVERIFY2(simplified <= 8, qPrintable(QString::number(simplified)));
+}
+
+void TrailEngineTest::_testLevelsNested()
+{
+    TrailEngine trail;
+    _fill(trail, 5 * TrailEngine::kChunkSize);
+
+    QCOMPARE(TrailEngine::levelForZoom(21, kStart.latitude()), 0);
+    QCOMPARE(TrailEngine::levelForZoom(1, kStart.latitude()), TrailEngine::kLevelCount - 1);
+
+    int previousCount = trail.count();
+    for (double zoom = 21; zoom >= 1; zoom -= 1) {
+        const int count = trail.geometryPointCount(zoom, QGeoRectangle());
+        QVERIFY2(count <= previousCount, qPrintable(QStringLiteral("zoom %1: %2 > %3").arg(zoom).arg(count).arg(previousCount)));
+        previousCount = count;
+    }
+
+    // Zig-zag amplitude is 25 meters: kept at 16 m tolerance, gone at 64 m
+    QVERIFY(trail.geometryPointCount(14, QGeoRectangle()) > (trail.count() / 8));
+    QVERIFY(trail.geometryPointCount(8, QGeoRectangle()) < 20);
+}
+
+void TrailEngineTest::_testViewportKeepsVisibleDetail()
+{
+    TrailEngine trail;
+    _fill(trail, 5 * TrailEngine::kChunkSize);
+
+    // Small viewport around the start of a ~50 km trail
+    const QGeoRectangle viewport(kStart.atDistanceAndAzimuth(200, 315), kStart.atDistanceAndAzimuth(1500, 135));
+    const QVariantList full = trail.geometry(18, QGeoRectangle());
+    const QVariantList filtered = trail.geometry(18, viewport);
+    QVERIFY(filtered.count() < (full.count() / 4));
+
+    int fullInside = 0;
+    for (const QVariant &point : full) {
+        fullInside += viewport.contains(point.value<QGeoCoordinate>()) ? 1 : 0;
+    }
+    int filteredInside = 0;
+    for (const QVariant &point : filtered) {
+        filteredInside += viewport.contains(point.value<QGeoCoordinate>()) ? 1 : 0;
+    }
+    QVERIFY(fullInside > 0);
+    QCOMPARE(filteredInside, fullInside);
+
+    // Trail still ends at the vehicle
+    QVERIFY(filtered.last().value<QGeoCoordinate>().distanceTo(trail.last()) < 0.05);
+}
+
+void TrailEngineTest::_benchmarkTrailGeometry()
+{
+    TrailEngine trail;
+    _fill(trail, TrailEngine::kDefaultMaxSamples);
+    const QGeoRectangle viewport(kStart.atDistanceAndAzimuth(200, 315), kStart.atDistanceAndAzimuth(1500, 135));
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true);
+    bench.run("full trail: coordinates() (previous list() behavior)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(trail.coordinates());
+    });
+    bench.run("geometry: zoom 14, whole trail", [&] {
+        ankerl::nanobench::doNotOptimizeAway(trail.geometry(14, QGeoRectangle()));
+    });
+    bench.run("geometry: zoom 18, viewport", [&] {
+        ankerl::nanobench::doNotOptimizeAway(trail.geometry(18, viewport));
+    });
+
+    TrailEngine appendTrail;
+    int index = 0;
+    auto appendBench = qgc::bench::ciConfig();
+    appendBench.run("append (amortized chunk simplification)", [&] {
+        appendTrail.append(_zigZag(index), index * 100);
+        index++;
+    });
+
+    QVERIFY(appendTrail.count() <= appendTrail.maxSamples());
+}
+
+UT_REGISTER_TEST(TrailEngineTest, TestLabel::Unit, TestLabel::Vehicle)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit test for TrailEngine: bounded storage, nested zoom levels and viewport filtering
+class TrailEngineTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testMemoryCap();
+    void _testReplaceLast();
+    void _testStraightLineCollapses();
+    void _testLevelsNested();
+    void _testViewportKeepsVisibleDetail();
+    void _benchmarkTrailGeometry();
+};